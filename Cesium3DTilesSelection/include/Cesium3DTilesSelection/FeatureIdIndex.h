@@ -0,0 +1,161 @@
+#pragma once
+
+#include "Library.h"
+
+#include <gsl/span>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief A range of consecutive vertices, or of consecutive elements of an
+ * index accessor, from `begin` up to but not including `end`.
+ */
+struct FeatureIdRange {
+  /**
+   * @brief The first vertex or index in the range.
+   */
+  uint32_t begin;
+
+  /**
+   * @brief The vertex or index after the last one in the range.
+   */
+  uint32_t end;
+};
+
+/**
+ * @brief The vertices and indices of a primitive that belong to each feature
+ * of one of its `EXT_feature_metadata` feature ID attributes.
+ *
+ * The ranges of each feature are sorted and do not overlap. Adjacent vertices
+ * or indices of the same feature are merged into a single range.
+ */
+struct CESIUM3DTILESSELECTION_API PrimitiveFeatureIdIndex {
+  /**
+   * @brief The index of the mesh in {@link CesiumGltf::Model::meshes}.
+   */
+  int32_t meshIndex = -1;
+
+  /**
+   * @brief The index of the primitive in {@link CesiumGltf::Mesh::primitives}.
+   */
+  int32_t primitiveIndex = -1;
+
+  /**
+   * @brief The feature table that the feature IDs refer to.
+   */
+  std::string featureTable;
+
+  /**
+   * @brief The feature IDs of the primitive, in ascending order.
+   */
+  std::vector<int64_t> featureIds;
+
+  /**
+   * @brief For each of the {@link featureIds}, the index of its first range
+   * in {@link vertexRanges}, followed by the number of vertex ranges.
+   */
+  std::vector<uint32_t> vertexRangeOffsets;
+
+  /**
+   * @brief The vertex ranges of all features, grouped by feature.
+   */
+  std::vector<FeatureIdRange> vertexRanges;
+
+  /**
+   * @brief For each of the {@link featureIds}, the index of its first range
+   * in {@link indexRanges}, followed by the number of index ranges.
+   */
+  std::vector<uint32_t> indexRangeOffsets;
+
+  /**
+   * @brief The ranges of the index accessor whose vertices belong to each
+   * feature, grouped by feature.
+   *
+   * This is empty if the primitive does not have indices.
+   */
+  std::vector<FeatureIdRange> indexRanges;
+
+  /**
+   * @brief Gets the vertex ranges of a feature.
+   *
+   * @param featureId The ID of the feature.
+   * @return The vertex ranges, or an empty span if no vertex of the primitive
+   * belongs to the feature.
+   */
+  gsl::span<const FeatureIdRange>
+  getVertexRanges(int64_t featureId) const noexcept;
+
+  /**
+   * @brief Gets the ranges of the index accessor whose vertices belong to a
+   * feature.
+   *
+   * @param featureId The ID of the feature.
+   * @return The index ranges, or an empty span if no index of the primitive
+   * refers to a vertex of the feature.
+   */
+  gsl::span<const FeatureIdRange>
+  getIndexRanges(int64_t featureId) const noexcept;
+};
+
+/**
+ * @brief Finds the vertices and indices of the primitives of a glTF model
+ * that belong to a feature, without scanning the feature ID attributes.
+ *
+ * The index is created in a worker thread when
+ * {@link TilesetContentOptions::createFeatureIdIndex} is set, and is then
+ * available from {@link TileContentLoadResult::featureIdIndex}. It is useful
+ * to highlight, hide or recolor individual features.
+ */
+class CESIUM3DTILESSELECTION_API FeatureIdIndex {
+public:
+  /**
+   * @brief Creates the index of the feature ID attributes of all primitives
+   * of a model with the `EXT_feature_metadata` extension.
+   *
+   * Both feature ID attributes that refer to a vertex attribute and implicit
+   * feature IDs, given by a constant and a divisor, are indexed.
+   *
+   * @param model The model.
+   */
+  static FeatureIdIndex create(const CesiumGltf::Model& model);
+
+  /**
+   * @brief Gets the indices of all feature ID attributes of the model.
+   */
+  const std::vector<PrimitiveFeatureIdIndex>& getPrimitives() const noexcept {
+    return this->_primitives;
+  }
+
+  /**
+   * @brief Finds the index of the feature IDs of a primitive that refer to a
+   * feature table.
+   *
+   * @param meshIndex The index of the mesh.
+   * @param primitiveIndex The index of the primitive in the mesh.
+   * @param featureTable The feature table.
+   * @return The index, or `nullptr` if the primitive has no feature IDs for
+   * the feature table.
+   */
+  const PrimitiveFeatureIdIndex* findPrimitive(
+      int32_t meshIndex,
+      int32_t primitiveIndex,
+      const std::string& featureTable) const noexcept;
+
+  /**
+   * @brief Gets the number of bytes of memory used by this index.
+   */
+  int64_t getSizeBytes() const noexcept;
+
+private:
+  std::vector<PrimitiveFeatureIdIndex> _primitives;
+};
+
+} // namespace Cesium3DTilesSelection
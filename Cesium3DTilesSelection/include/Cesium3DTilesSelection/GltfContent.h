@@ -6,6 +6,7 @@
 #include "TileContentLoader.h"
 #include "TileID.h"
 #include "TileRefine.h"
+#include "TilesetOptions.h"
 
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/Future.h>
@@ -55,6 +56,7 @@ public:
    * @param pAssetAccessor The asset accessor to use to resolve external
    * content.
    * @param data The actual glTF data
+   * @param contentOptions The options for parsing the content.
    * @return The {@link TileContentLoadResult}
    */
   static CesiumAsync::Future<std::unique_ptr<TileContentLoadResult>> load(
@@ -63,7 +65,8 @@ public:
       const std::string& url,
       const CesiumAsync::HttpHeaders& headers,
       const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
-      const gsl::span<const std::byte>& data);
+      const gsl::span<const std::byte>& data,
+      const TilesetContentOptions& contentOptions = TilesetContentOptions());
 
   /**
    * @brief Creates texture coordinates for mapping {@link RasterOverlay} tiles
@@ -18,7 +18,9 @@ struct Model;
 namespace Cesium3DTilesSelection {
 
 class Tile;
+class RasterOverlay;
 class RasterOverlayTile;
+class RasterOverlayPageAtlas;
 
 /**
  * @brief When implemented for a rendering engine, allows renderer resources to
@@ -183,6 +185,42 @@ public:
       int32_t overlayTextureCoordinateID,
       const RasterOverlayTile& rasterTile,
       void* pMainThreadRendererResources) noexcept = 0;
+
+  /**
+   * @brief Stores the image of a quadtree tile in a page of a raster overlay
+   * page atlas.
+   *
+   * This is only called for overlays with
+   * {@link RasterOverlayOptions::enablePageAtlas} set. It is called from the
+   * thread that called {@link Tileset::updateView} whenever a page is
+   * allocated, including when it replaces an evicted page in the same slot.
+   * The default implementation does nothing.
+   *
+   * @param overlay The raster overlay that owns the atlas.
+   * @param atlas The atlas. The page's pixels belong at
+   * {@link RasterOverlayPageAtlas::getSlotPixelOffset}.
+   * @param slot The slot of the page within the atlas.
+   * @param image The image of the page. It is exactly one page in size.
+   */
+  virtual void updateRasterOverlayPage(
+      const RasterOverlay& /*overlay*/,
+      const RasterOverlayPageAtlas& /*atlas*/,
+      uint32_t /*slot*/,
+      const CesiumGltf::ImageCesium& /*image*/) {}
+
+  /**
+   * @brief Frees the renderer resources of a raster overlay page atlas.
+   *
+   * This is called from the thread that called {@link Tileset::updateView}
+   * or deleted the tileset when the atlas is destroyed. The default
+   * implementation does nothing.
+   *
+   * @param overlay The raster overlay that owns the atlas.
+   * @param atlas The atlas that is being destroyed.
+   */
+  virtual void freeRasterOverlayPageAtlas(
+      const RasterOverlay& /*overlay*/,
+      const RasterOverlayPageAtlas& /*atlas*/) noexcept {}
 };
 
 } // namespace Cesium3DTilesSelection
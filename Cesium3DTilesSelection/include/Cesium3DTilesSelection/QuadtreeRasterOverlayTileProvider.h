@@ -3,6 +3,7 @@
 #include "CreditSystem.h"
 #include "IPrepareRendererResources.h"
 #include "Library.h"
+#include "RasterOverlayPageAtlas.h"
 #include "RasterOverlayTileProvider.h"
 #include "TileID.h"
 
@@ -56,6 +57,8 @@ public:
       uint32_t imageWidth,
       uint32_t imageHeight) noexcept;
 
+  virtual ~QuadtreeRasterOverlayTileProvider() noexcept;
+
   /**
    * @brief Returns the minimum tile level of this instance.
    */
@@ -84,6 +87,16 @@ public:
     return this->_tilingScheme;
   }
 
+  /**
+   * @brief Returns the page atlas in which loaded quadtree tiles are kept.
+   *
+   * This is `nullptr` unless {@link RasterOverlayOptions::enablePageAtlas} is
+   * set for the owning overlay.
+   */
+  const RasterOverlayPageAtlas* getPageAtlas() const noexcept {
+    return this->_pPageAtlas.get();
+  }
+
   /**
    * @brief Computes the best quadtree level to use for an image intended to
    * cover a given projected rectangle when it is a given size on the screen.
@@ -115,6 +128,7 @@ private:
   struct LoadedQuadtreeImage {
     std::shared_ptr<LoadedRasterOverlayImage> pLoaded = nullptr;
     std::optional<CesiumGeometry::Rectangle> subset = std::nullopt;
+    CesiumGeometry::QuadtreeTileID tileID{0, 0, 0};
   };
 
   CesiumAsync::SharedFuture<LoadedQuadtreeImage>
@@ -126,6 +140,8 @@ private:
    * @param geometryRectangle The rectangle for which to load tiles.
    * @param targetGeometricError The geometric error controlling which quadtree
    * level to use to cover the rectangle.
+   * @param pTileIDs If not `nullptr`, receives the ID of the quadtree tile of
+   * each returned future, in the same order.
    * @return A vector of shared futures, each of which will resolve to image
    * data that is required to cover the rectangle with the given geometric
    * error.
@@ -133,7 +149,19 @@ private:
   std::vector<CesiumAsync::SharedFuture<LoadedQuadtreeImage>>
   mapRasterTilesToGeometryTile(
       const CesiumGeometry::Rectangle& geometryRectangle,
-      const glm::dvec2 targetScreenPixels);
+      const glm::dvec2 targetScreenPixels,
+      std::vector<CesiumGeometry::QuadtreeTileID>* pTileIDs = nullptr);
+
+  /**
+   * @brief Allocates atlas pages for loaded quadtree tiles and creates the
+   * page table window that covers them.
+   *
+   * @return The image with the window, or `std::nullopt` if the images cannot
+   * be kept in the atlas, in which case they need to be combined instead.
+   */
+  std::optional<LoadedRasterOverlayImage> mapImagesToPageAtlas(
+      const std::vector<CesiumGeometry::QuadtreeTileID>& tileIDs,
+      const std::vector<LoadedQuadtreeImage>& images);
 
   void unloadCachedTiles();
 
@@ -149,6 +177,14 @@ private:
       const CesiumGeometry::Rectangle& targetRectangle,
       const std::vector<LoadedQuadtreeImage>& images);
 
+  static bool
+  haveAnyUsefulImageData(const std::vector<LoadedQuadtreeImage>& images);
+
+  static LoadedRasterOverlayImage combineUsefulImages(
+      const CesiumGeometry::Rectangle& targetRectangle,
+      const CesiumGeospatial::Projection& projection,
+      std::vector<LoadedQuadtreeImage>&& images);
+
   static LoadedRasterOverlayImage combineImages(
       const CesiumGeometry::Rectangle& targetRectangle,
       const CesiumGeospatial::Projection& projection,
@@ -177,5 +213,7 @@ private:
       _tileLookup;
 
   std::atomic<int64_t> _cachedBytes;
+
+  std::unique_ptr<RasterOverlayPageAtlas> _pPageAtlas;
 };
 } // namespace Cesium3DTilesSelection
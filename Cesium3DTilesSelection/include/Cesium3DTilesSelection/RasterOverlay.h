@@ -1,8 +1,10 @@
 #pragma once
 
 #include "Library.h"
+#include "RasterOverlayMetadataCache.h"
 
 #include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumGltf/GpuCompressedPixelFormat.h>
 
 #include <spdlog/fwd.h>
 
@@ -54,6 +56,56 @@ struct CESIUM3DTILESSELECTION_API RasterOverlayOptions {
    */
   int32_t maximumTextureSize = 2048;
 
+  /**
+   * @brief Whether to generate mip levels for raster overlay tile images in a
+   * worker thread, before they are passed to
+   * {@link IPrepareRendererResources::prepareRasterInLoadThread}.
+   *
+   * See {@link CesiumGltfReader::ImageManipulation::generateMipMaps} for how the
+   * levels are stored. Pages of a {@link RasterOverlayPageAtlas} do not get
+   * mip levels.
+   */
+  bool generateMipMaps = false;
+
+  /**
+   * @brief The GPU block-compressed format to re-encode raster overlay tile
+   * images to in a worker thread, or
+   * {@link CesiumGltf::GpuCompressedPixelFormat::None} to keep them as 8-bit
+   * RGBA.
+   *
+   * Only {@link CesiumGltf::GpuCompressedPixelFormat::Bc1Rgb} and
+   * {@link CesiumGltf::GpuCompressedPixelFormat::Bc3Rgba} are supported, see
+   * {@link CesiumGltfReader::ImageManipulation::compressBlocks}. They reduce
+   * the memory and upload bandwidth of each tile to an eighth or a quarter,
+   * respectively. Mip levels are compressed as well. Pages of a
+   * {@link RasterOverlayPageAtlas} are not compressed.
+   */
+  CesiumGltf::GpuCompressedPixelFormat compressedPixelFormat =
+      CesiumGltf::GpuCompressedPixelFormat::None;
+
+  /**
+   * @brief Whether to keep the loaded tiles of a
+   * {@link QuadtreeRasterOverlayTileProvider} in a
+   * {@link RasterOverlayPageAtlas} instead of combining them into a new image
+   * for each geometry tile.
+   *
+   * When enabled, each loaded quadtree tile is given to the renderer only once,
+   * with {@link IPrepareRendererResources::updateRasterOverlayPage}, and raster
+   * overlay tiles carry a {@link RasterOverlayPageTableWindow} instead of an
+   * image. The renderer is responsible for sampling the atlas through the
+   * window. If the atlas has no room for the tiles of a geometry tile, a
+   * combined image is created as usual.
+   */
+  bool enablePageAtlas = false;
+
+  /**
+   * @brief The pixel size of the page atlas, in either direction.
+   *
+   * This is only used when {@link enablePageAtlas} is true. The atlas holds as
+   * many quadtree tiles as fit in an image of this size.
+   */
+  int32_t pageAtlasSize = 4096;
+
   /**
    * @brief The maximum number of pixels of error when rendering this overlay.
    * This is used to select an appropriate level-of-detail.
@@ -63,6 +115,19 @@ struct CESIUM3DTILESSELECTION_API RasterOverlayOptions {
    * the raster overlay maps to approximately 2x2 pixels on the screen.
    */
   double maximumScreenSpaceError = 2.0;
+
+  /**
+   * @brief The cache of parsed overlay metadata, such as a Bing Maps imagery
+   * metadata response or a Tile Map Service `tilemapresource.xml`.
+   *
+   * Overlays that share a cache create their tile providers without
+   * requesting or parsing the metadata again, as long as it has not expired.
+   * By default, all overlays in the process share
+   * {@link RasterOverlayMetadataCache::getDefault}. If this is `nullptr`, the
+   * metadata is requested every time a tile provider is created.
+   */
+  std::shared_ptr<RasterOverlayMetadataCache> pMetadataCache =
+      RasterOverlayMetadataCache::getDefault();
 };
 
 /**
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Library.h"
+
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief Options for a {@link RasterOverlayMetadataCache}.
+ */
+struct CESIUM3DTILESSELECTION_API RasterOverlayMetadataCacheOptions {
+  /**
+   * @brief The maximum number of entries in the cache.
+   *
+   * When the cache is full, the least recently used entry is removed to make
+   * room for a new one. If this is zero, nothing is cached.
+   */
+  size_t maximumEntries = 256;
+
+  /**
+   * @brief How long an entry may be used after it is added to the cache.
+   *
+   * Some metadata, such as the access token in a Cesium ion endpoint, is only
+   * valid for a limited time, so entries should not be kept forever.
+   */
+  std::chrono::steady_clock::duration timeToLive = std::chrono::minutes(10);
+};
+
+/**
+ * @brief A thread-safe cache of the metadata that raster overlays parse when
+ * they create their tile provider.
+ *
+ * Overlays such as {@link BingMapsRasterOverlay},
+ * {@link TileMapServiceRasterOverlay} and {@link IonRasterOverlay} download
+ * and parse a metadata document before they can create a tile provider. They
+ * store the parsed result here, keyed by the URL of the document, so another
+ * overlay created for the same service does not need a network round trip or
+ * a reparse. The cache is bounded in size, and entries expire after the
+ * {@link RasterOverlayMetadataCacheOptions::timeToLive}.
+ *
+ * Values are immutable and shared, so they may be used after they are evicted
+ * from the cache. Each value is stored with its type, and {@link get} returns
+ * `nullptr` if the requested type does not match.
+ *
+ * A cache may be shared between any number of overlays and tilesets with
+ * {@link RasterOverlayOptions::pMetadataCache}.
+ */
+class CESIUM3DTILESSELECTION_API RasterOverlayMetadataCache final {
+public:
+  /**
+   * @brief Creates a new, empty cache.
+   *
+   * @param options The {@link RasterOverlayMetadataCacheOptions} for this
+   * cache.
+   */
+  explicit RasterOverlayMetadataCache(
+      const RasterOverlayMetadataCacheOptions& options =
+          RasterOverlayMetadataCacheOptions());
+
+  /**
+   * @brief Gets the cache that is used by default by all raster overlays in
+   * the process.
+   */
+  static const std::shared_ptr<RasterOverlayMetadataCache>& getDefault();
+
+  /**
+   * @brief Gets the options of this cache.
+   */
+  const RasterOverlayMetadataCacheOptions& getOptions() const noexcept {
+    return this->_options;
+  }
+
+  /**
+   * @brief Gets a value from the cache.
+   *
+   * A value that is found becomes the most recently used one.
+   *
+   * @tparam T The type of the value.
+   * @param key The key of the value.
+   * @return The value, or `nullptr` if there is no value of type `T` for the
+   * key, or it has expired.
+   */
+  template <typename T> std::shared_ptr<const T> get(const std::string& key) {
+    return std::static_pointer_cast<const T>(
+        this->getEntry(key, std::type_index(typeid(T))));
+  }
+
+  /**
+   * @brief Adds a value to the cache, replacing any existing value for the
+   * key.
+   *
+   * @tparam T The type of the value.
+   * @param key The key of the value.
+   * @param pValue The value.
+   */
+  template <typename T>
+  void put(const std::string& key, std::shared_ptr<const T> pValue) {
+    this->putEntry(key, std::type_index(typeid(T)), std::move(pValue));
+  }
+
+  /**
+   * @brief Removes the value for a key from the cache, if there is one.
+   */
+  void remove(const std::string& key);
+
+  /**
+   * @brief Removes all values from the cache.
+   */
+  void clear();
+
+  /**
+   * @brief Gets the number of entries in the cache, including any that have
+   * expired but have not been removed yet.
+   */
+  size_t size() const;
+
+private:
+  struct Entry {
+    std::string key;
+    std::type_index type;
+    std::shared_ptr<const void> pValue;
+    std::chrono::steady_clock::time_point expiresAt;
+  };
+
+  std::shared_ptr<const void>
+  getEntry(const std::string& key, std::type_index type);
+
+  void putEntry(
+      const std::string& key,
+      std::type_index type,
+      std::shared_ptr<const void>&& pValue);
+
+  RasterOverlayMetadataCacheOptions _options;
+  mutable std::mutex _mutex;
+
+  // Ordered from the most to the least recently used.
+  std::list<Entry> _entries;
+  std::unordered_map<std::string, std::list<Entry>::iterator> _entriesByKey;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "Library.h"
+
+#include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumGeometry/Rectangle.h>
+
+#include <glm/vec2.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief A fixed-size atlas of equally-sized pages, each of which holds the
+ * image of one quadtree tile of a raster overlay.
+ *
+ * The atlas only manages the assignment of quadtree tiles to slots. The pixels
+ * themselves are owned by the renderer, which is told about new pages with
+ * {@link IPrepareRendererResources::updateRasterOverlayPage}. Slot `i` is
+ * located at column `i % getColumns()` and row `i / getColumns()` of the
+ * atlas, see {@link getSlotPixelOffset}. Pages always hold 8-bit RGBA pixels.
+ *
+ * Pages are shared with the {@link RasterOverlayPageTableWindow} instances
+ * that reference them. A page that is still referenced is never evicted; an
+ * unreferenced page stays in the atlas until its slot is needed for a new
+ * page, least recently used first.
+ *
+ * Instances of this class are not thread-safe and are only used from the
+ * main thread.
+ */
+class CESIUM3DTILESSELECTION_API RasterOverlayPageAtlas final {
+public:
+  /**
+   * @brief A page of the atlas.
+   */
+  struct Page {
+    /**
+     * @brief The ID of the quadtree tile whose image is stored in the page.
+     */
+    CesiumGeometry::QuadtreeTileID tileID;
+
+    /**
+     * @brief The projected rectangle covered by the image in the page.
+     */
+    CesiumGeometry::Rectangle rectangle;
+
+    /**
+     * @brief The slot of the atlas in which the page is stored.
+     */
+    uint32_t slot;
+  };
+
+  /**
+   * @brief Creates a new instance.
+   *
+   * @param pageWidth The width of each page, in pixels.
+   * @param pageHeight The height of each page, in pixels.
+   * @param columns The number of pages in each row of the atlas.
+   * @param rows The number of pages in each column of the atlas.
+   */
+  RasterOverlayPageAtlas(
+      uint32_t pageWidth,
+      uint32_t pageHeight,
+      uint32_t columns,
+      uint32_t rows);
+
+  /**
+   * @brief Returns the width of each page, in pixels.
+   */
+  uint32_t getPageWidth() const noexcept { return this->_pageWidth; }
+
+  /**
+   * @brief Returns the height of each page, in pixels.
+   */
+  uint32_t getPageHeight() const noexcept { return this->_pageHeight; }
+
+  /**
+   * @brief Returns the number of pages in each row of the atlas.
+   */
+  uint32_t getColumns() const noexcept { return this->_columns; }
+
+  /**
+   * @brief Returns the number of pages in each column of the atlas.
+   */
+  uint32_t getRows() const noexcept { return this->_rows; }
+
+  /**
+   * @brief Returns the maximum number of pages in the atlas.
+   */
+  uint32_t getCapacity() const noexcept {
+    return static_cast<uint32_t>(this->_slots.size());
+  }
+
+  /**
+   * @brief Returns the number of pages currently in the atlas.
+   */
+  size_t getPageCount() const noexcept { return this->_lookup.size(); }
+
+  /**
+   * @brief Returns the offset of a slot from the top-left corner of the atlas,
+   * in pixels.
+   */
+  glm::uvec2 getSlotPixelOffset(uint32_t slot) const noexcept {
+    return glm::uvec2(
+        (slot % this->_columns) * this->_pageWidth,
+        (slot / this->_columns) * this->_pageHeight);
+  }
+
+  /**
+   * @brief Finds the page of a quadtree tile and marks it as recently used.
+   *
+   * @param tileID The ID of the quadtree tile.
+   * @return The page, or `nullptr` if the tile is not in the atlas.
+   */
+  std::shared_ptr<const Page>
+  find(const CesiumGeometry::QuadtreeTileID& tileID) noexcept;
+
+  /**
+   * @brief Allocates a page for a quadtree tile that is not yet in the atlas.
+   *
+   * If there are no free slots, the least recently used page that is no
+   * longer referenced is evicted. The caller is responsible for supplying the
+   * pixels of the new page to the renderer.
+   *
+   * @param tileID The ID of the quadtree tile.
+   * @param rectangle The projected rectangle covered by the tile's image.
+   * @return The new page, or `nullptr` if every page of the atlas is still
+   * referenced.
+   */
+  std::shared_ptr<const Page> allocate(
+      const CesiumGeometry::QuadtreeTileID& tileID,
+      const CesiumGeometry::Rectangle& rectangle);
+
+private:
+  struct Slot {
+    std::shared_ptr<Page> pPage;
+    uint64_t lastUsed;
+  };
+
+  uint32_t _pageWidth;
+  uint32_t _pageHeight;
+  uint32_t _columns;
+  uint32_t _rows;
+  std::vector<Slot> _slots;
+  std::unordered_map<CesiumGeometry::QuadtreeTileID, uint32_t> _lookup;
+  uint64_t _useCounter;
+};
+
+/**
+ * @brief A window into the page table of a {@link RasterOverlayPageAtlas}
+ * that covers a geometry tile.
+ *
+ * The window is a grid of quadtree tiles of a single level. Each cell
+ * references the page that holds its imagery. When a tile is not available,
+ * the cell references the page of an ancestor tile instead, whose
+ * {@link RasterOverlayPageAtlas::Page::rectangle} is larger than the cell.
+ * To sample the overlay at a projected position, find the cell containing
+ * it, and then the position relative to the rectangle of the cell's page.
+ */
+struct CESIUM3DTILESSELECTION_API RasterOverlayPageTableWindow {
+  /**
+   * @brief The ID of the quadtree tile in the south-west corner of the window.
+   *
+   * All of the cells are tiles of this level.
+   */
+  CesiumGeometry::QuadtreeTileID southwest{0, 0, 0};
+
+  /**
+   * @brief The number of cells in the east-west direction.
+   */
+  uint32_t columns = 0;
+
+  /**
+   * @brief The number of cells in the north-south direction.
+   */
+  uint32_t rows = 0;
+
+  /**
+   * @brief The projected rectangle covered by all cells of the window.
+   */
+  CesiumGeometry::Rectangle rectangle{};
+
+  /**
+   * @brief The page of each cell, in row-major order starting at the
+   * south-west cell.
+   *
+   * A cell is `nullptr` if there is no imagery for it.
+   */
+  std::vector<std::shared_ptr<const RasterOverlayPageAtlas::Page>> pages{};
+};
+
+} // namespace Cesium3DTilesSelection
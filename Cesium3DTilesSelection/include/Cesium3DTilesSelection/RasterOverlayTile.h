@@ -1,10 +1,13 @@
 #pragma once
 
+#include "RasterOverlayPageAtlas.h"
+
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/IAssetRequest.h>
 #include <CesiumGeometry/Rectangle.h>
 #include <CesiumGltf/Model.h>
 
+#include <optional>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
@@ -172,6 +175,20 @@ public:
     return this->_image;
   }
 
+  /**
+   * @brief Returns the window into the page atlas of the tile provider that
+   * covers this tile.
+   *
+   * This is only set for tiles of overlays with
+   * {@link RasterOverlayOptions::enablePageAtlas}, and in that case the
+   * {@link getImage} of the tile is empty. The rectangle of the window is the
+   * {@link getRectangle} of this tile.
+   */
+  const std::optional<RasterOverlayPageTableWindow>&
+  getPageTableWindow() const noexcept {
+    return this->_pageTableWindow;
+  }
+
   /**
    * @brief Create the renderer resources for the loaded image.
    *
@@ -233,6 +250,7 @@ private:
   std::vector<Credit> _tileCredits;
   LoadState _state;
   CesiumGltf::ImageCesium _image;
+  std::optional<RasterOverlayPageTableWindow> _pageTableWindow;
   void* _pRendererResources;
   uint32_t _references;
   MoreDetailAvailable _moreDetailAvailable;
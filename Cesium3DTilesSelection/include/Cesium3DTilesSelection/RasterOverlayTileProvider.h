@@ -66,6 +66,15 @@ struct CESIUM3DTILESSELECTION_API LoadedRasterOverlayImage {
    * the bounds of this image.
    */
   bool moreDetailAvailable = false;
+
+  /**
+   * @brief The window into the page atlas of the tile provider that replaces
+   * the image.
+   *
+   * If this is set, {@link image} is not used and {@link rectangle} is the
+   * rectangle of the window.
+   */
+  std::optional<RasterOverlayPageTableWindow> pageTableWindow{};
 };
 
 /**
@@ -15,6 +15,7 @@
 
 #include <glm/common.hpp>
 #include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
 #include <gsl/span>
 
 #include <atomic>
@@ -248,6 +249,32 @@ public:
    */
   void setBoundingVolume(const BoundingVolume& value) noexcept {
     this->_boundingVolume = value;
+    this->_horizonOcclusionPoint.reset();
+  }
+
+  /**
+   * @brief Returns the horizon occlusion point of this tile, if it is known.
+   *
+   * The point is expressed in the ellipsoid-scaled space of the WGS84
+   * ellipsoid. If it is below the horizon of the ellipsoid, so is everything
+   * inside the {@link BoundingVolume} of this tile. It is used for horizon
+   * culling, see {@link TilesetOptions::enableHorizonCulling}.
+   */
+  const std::optional<glm::dvec3>& getHorizonOcclusionPoint() const noexcept {
+    return this->_horizonOcclusionPoint;
+  }
+
+  /**
+   * @brief Set the horizon occlusion point of this tile.
+   *
+   * This function is not supposed to be called by clients. Setting the
+   * {@link BoundingVolume} of this tile clears the horizon occlusion point.
+   *
+   * @param value The horizon occlusion point.
+   */
+  void
+  setHorizonOcclusionPoint(const std::optional<glm::dvec3>& value) noexcept {
+    this->_horizonOcclusionPoint = value;
   }
 
   /**
@@ -632,6 +659,7 @@ private:
   // These are immutable after the tile leaves TileState::Unloaded.
   BoundingVolume _boundingVolume;
   std::optional<BoundingVolume> _viewerRequestVolume;
+  std::optional<glm::dvec3> _horizonOcclusionPoint;
   double _geometricError;
   TileRefine _refine;
   glm::dmat4x4 _transform;
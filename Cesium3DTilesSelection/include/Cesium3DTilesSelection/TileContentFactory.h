@@ -17,7 +17,9 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace Cesium3DTilesSelection {
 class TileContent;
@@ -102,6 +104,14 @@ public:
   static CesiumAsync::Future<std::unique_ptr<TileContentLoadResult>>
   createContent(const TileContentLoadInput& input);
 
+  /**
+   * @brief Gets the magic headers and the content types that loaders are
+   * currently registered for.
+   *
+   * Content types are returned in lowercase, as they were registered.
+   */
+  static std::vector<std::string> getRegisteredTypes();
+
 private:
   static std::optional<std::string>
   getMagic(const gsl::span<const std::byte>& data);
@@ -19,6 +19,8 @@
 #include <memory>
 
 namespace Cesium3DTilesSelection {
+struct TilesetMetrics;
+
 /**
  * @brief The information that is passed to a {@link TileContentLoader} to
  * create a {@link TileContentLoadResult}.
@@ -146,5 +148,16 @@ struct CESIUM3DTILESSELECTION_API TileContentLoadInput {
    * @brief Options for parsing content and creating Gltf models.
    */
   TilesetContentOptions contentOptions;
+
+  /**
+   * @brief The metrics that receive the time taken to decode the content, or
+   * `nullptr` to not record it.
+   *
+   * When the input is created from a {@link Tile}, these are the
+   * {@link Tileset::getMetrics} of its tileset.
+   *
+   * Not supposed to be used by clients.
+   */
+  std::shared_ptr<TilesetMetrics> pMetrics;
 };
 } // namespace Cesium3DTilesSelection
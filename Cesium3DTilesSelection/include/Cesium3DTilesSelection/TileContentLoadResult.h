@@ -1,11 +1,14 @@
 #pragma once
 
+#include "FeatureIdIndex.h"
 #include "Tile.h"
 #include "TileContext.h"
 
 #include <CesiumGeometry/QuadtreeTileRectangularRange.h>
 #include <CesiumGeospatial/Projection.h>
 
+#include <glm/vec3.hpp>
+
 #include <memory>
 
 namespace Cesium3DTilesSelection {
@@ -103,6 +106,15 @@ struct TileContentLoadResult {
    */
   std::optional<BoundingVolume> updatedContentBoundingVolume{};
 
+  /**
+   * @brief The horizon occlusion point of this tile, if it is known.
+   *
+   * The point is expressed in the ellipsoid-scaled space of the WGS84
+   * ellipsoid. If it is below the horizon of the ellipsoid, so is the entire
+   * content of the tile. See {@link CesiumGeospatial::EllipsoidalOccluder}.
+   */
+  std::optional<glm::dvec3> horizonOcclusionPoint{};
+
   /**
    * @brief Available quadtree tiles discovered as a result of loading this
    * tile.
@@ -121,6 +133,14 @@ struct TileContentLoadResult {
    * If this tile does not have any overlays, this field will be std::nullopt.
    */
   std::optional<TileContentDetailsForOverlays> overlayDetails;
+
+  /**
+   * @brief The index of the feature IDs of the {@link model}.
+   *
+   * This is only created if {@link TilesetContentOptions::createFeatureIdIndex}
+   * is set.
+   */
+  std::optional<FeatureIdIndex> featureIdIndex;
 };
 
 } // namespace Cesium3DTilesSelection
@@ -13,8 +13,10 @@
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/IAssetRequest.h>
 #include <CesiumGeometry/Axis.h>
+#include <CesiumGeometry/BoundingVolumeBatch.h>
 #include <CesiumGeometry/QuadtreeRectangleAvailability.h>
 #include <CesiumGeometry/TileAvailabilityFlags.h>
+#include <CesiumGeospatial/EllipsoidalOccluder.h>
 
 #include <rapidjson/fwd.h>
 
@@ -22,9 +24,11 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
+struct TilesetMetrics;
 
 /**
  * @brief A <a
@@ -121,6 +125,16 @@ public:
   /** @copydoc Tileset::getOptions() */
   const TilesetOptions& getOptions() const noexcept { return this->_options; }
 
+  /**
+   * @brief Gets the metrics this tileset records, or `nullptr` if
+   * {@link TilesetExternals::pMetrics} is not set.
+   *
+   * Not supposed to be used by clients.
+   */
+  const std::shared_ptr<TilesetMetrics>& getMetrics() const noexcept {
+    return this->_pMetrics;
+  }
+
   /**
    * @brief Gets the {@link TilesetOptions} of this tileset.
    */
@@ -223,17 +237,6 @@ public:
   CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
   requestTileContent(Tile& tile);
 
-  /**
-   * @brief Request to load the availability subtree for the given tile.
-   *
-   * This function is not supposed to be called by client.
-   *
-   * @param tile The tile for which the subtree is requested.
-   * @return A future that resolves when the subtree response is received.
-   */
-  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
-  requestAvailabilitySubtree(Tile& tile);
-
   /**
    * @brief Add the given {@link TileContext} to this tile set.
    *
@@ -419,7 +422,9 @@ private:
    */
   struct FrameState {
     const std::vector<ViewState>& frustums;
+    std::vector<CullingVolume> cullingVolumes;
     std::vector<double> fogDensities;
+    std::vector<CesiumGeospatial::EllipsoidalOccluder> horizonOccluders;
     int32_t lastFrameNumber;
     int32_t currentFrameNumber;
   };
@@ -467,6 +472,7 @@ private:
       uint32_t depth,
       bool ancestorMeetsSse,
       Tile& tile,
+      std::optional<uint64_t> frustumVisibility,
       ViewUpdateResult& result);
   TraversalDetails _visitVisibleChildrenNearToFar(
       const FrameState& frameState,
@@ -475,6 +481,9 @@ private:
       bool ancestorMeetsSse,
       Tile& tile,
       ViewUpdateResult& result);
+  void _computeChildFrustumVisibility(
+      const FrameState& frameState,
+      gsl::span<const Tile> children);
 
   /**
    * @brief When called on an additive-refined tile, queues it for load and adds
@@ -531,17 +540,61 @@ private:
       const std::vector<double>& distances,
       bool culled) const noexcept;
 
+  /**
+   * @brief Reuses the remembered selection results of the subtree rooted at
+   * the given tile, if they are still valid for this frame.
+   *
+   * This is only used when {@link TilesetOptions::enableFrameCoherentSelection}
+   * is true. If the results can be reused, the selection state of every tile in
+   * the subtree is carried over into this frame, the subtree's tiles are added
+   * to the render list, and the remembered traversal details are returned.
+   *
+   * @param frameState The state of the current frame.
+   * @param ancestorMeetsSse Whether an ancestor of the tile meets the SSE.
+   * @param tile The root tile of the subtree.
+   * @param result The current view update result.
+   * @return The traversal details of the subtree, or `std::nullopt` if the
+   * subtree needs to be traversed.
+   */
+  std::optional<TraversalDetails> _reuseSubtreeSelection(
+      const FrameState& frameState,
+      bool ancestorMeetsSse,
+      Tile& tile,
+      ViewUpdateResult& result);
+
+  /**
+   * @brief Remembers the selection results of the largest subtrees whose
+   * selection did not change in this frame, so that they can be reused by
+   * {@link _reuseSubtreeSelection} in later frames.
+   */
+  void _updateSubtreeSelectionCache(
+      const FrameState& frameState,
+      const ViewUpdateResult& result);
+
+  /**
+   * @brief Forgets the remembered subtree selections if any of the options
+   * that affect the selection changed since they were remembered.
+   */
+  void _invalidateSubtreeSelectionCache();
+
   void _processLoadQueue();
   void _unloadCachedTiles() noexcept;
-  void _markTileVisited(Tile& tile) noexcept;
+  bool _evictTile(Tile& tile) noexcept;
+  void _markTileVisited(Tile& tile);
 
   std::string getResolvedContentUrl(const Tile& tile) const;
-  std::string getResolvedSubtreeUrl(const Tile& tile) const;
+  std::string getResolvedSubtreeUrl(
+      const TileContext& context,
+      const TileID& subtreeRootID) const;
 
   std::vector<std::unique_ptr<TileContext>> _contexts;
   TilesetExternals _externals;
   CesiumAsync::AsyncSystem _asyncSystem;
 
+  // Declared before the tiles so that it outlives them; tiles record their
+  // unloaded bytes while they are destroyed.
+  std::shared_ptr<TilesetMetrics> _pMetrics;
+
   // per-tileset credit passed in explicitly by the user through
   // `TilesetOptions`
   std::optional<Credit> _userCredit;
@@ -554,6 +607,7 @@ private:
   bool _isRefreshingIonToken;
 
   TilesetOptions _options;
+  std::shared_ptr<TilesetGroup> _pGroup;
 
   std::unique_ptr<Tile> _pRootTile;
 
@@ -604,10 +658,45 @@ private:
   std::vector<LoadRecord> _loadQueueLow;
   std::atomic<uint32_t> _loadsInProgress; // TODO: does this need to be atomic?
 
+  /**
+   * @brief A child subtree of an implicit tileset to load before the
+   * traversal reaches its root tile.
+   */
+  struct SubtreePrefetchRecord {
+    /**
+     * @brief The context of the implicit tileset.
+     */
+    TileContext* pContext;
+
+    /**
+     * @brief The ID of the root tile of the subtree to load.
+     */
+    TileID subtreeRootID;
+
+    /**
+     * @brief The loaded subtree node that the subtree is a child of.
+     */
+    CesiumGeometry::AvailabilityNode* pParentNode;
+
+    /**
+     * @brief The relative priority of loading this subtree.
+     *
+     * Lower priority values load sooner.
+     */
+    double priority;
+
+    bool operator<(const SubtreePrefetchRecord& rhs) const noexcept {
+      return this->priority < rhs.priority;
+    }
+  };
+
   std::vector<SubtreeLoadRecord> _subtreeLoadQueue;
   std::atomic<uint32_t>
       _subtreeLoadsInProgress; // TODO: does this need to be atomic?
 
+  std::vector<SubtreePrefetchRecord> _subtreePrefetchQueue;
+  std::atomic<uint32_t> _subtreePrefetchesInProgress;
+
   Tile::LoadedLinkedList _loadedTiles;
 
   RasterOverlayCollection _overlays;
@@ -633,6 +722,91 @@ private:
   std::vector<std::unique_ptr<std::vector<double>>> _distancesStack;
   size_t _nextDistancesVector;
 
+  // The bounding volumes of the children of a tile, which are culled against
+  // all frustums at once, and the resulting frustum visibility masks of the
+  // children of all tiles on the current traversal path.
+  CesiumGeometry::BoundingVolumeBatch _childBoundingVolumes;
+  std::vector<uint64_t> _childBoundingVolumeVisibility;
+  std::vector<uint64_t> _childFrustumVisibilityStack;
+
+  /**
+   * @brief A tile that was visited in the current frame, along with its
+   * selection result in the previous frame.
+   */
+  struct VisitedTile {
+    Tile* pTile;
+    TileSelectionState::Result lastResult;
+  };
+
+  /**
+   * @brief A subtree that was traversed (or reused) in the current frame
+   * without adding anything to the load queues.
+   *
+   * The ranges refer to {@link _visitedTiles} and to the render list of the
+   * current frame.
+   */
+  struct SubtreeSelectionRecord {
+    Tile* pTile;
+    size_t visitedBegin;
+    size_t visitedEnd;
+    size_t renderBegin;
+    size_t renderEnd;
+    bool ancestorMeetsSse;
+    bool reused;
+    TraversalDetails traversalDetails;
+    std::vector<double> distances;
+  };
+
+  /**
+   * @brief The selection result of a single tile of a remembered subtree.
+   */
+  struct SelectedTile {
+    Tile* pTile;
+    TileSelectionState::Result result;
+    Tile::LoadState loadState;
+  };
+
+  /**
+   * @brief The remembered selection results of a subtree, together with the
+   * view they were computed for.
+   */
+  struct SubtreeSelection {
+    int32_t frameNumber = 0;
+    std::shared_ptr<const std::vector<ViewState>> pFrustums;
+    std::vector<double> distances;
+    bool ancestorMeetsSse = false;
+    TraversalDetails traversalDetails;
+    std::vector<SelectedTile> tiles;
+    std::vector<Tile*> tilesToRender;
+  };
+
+  /**
+   * @brief The {@link TilesetOptions} that affect which tiles are selected,
+   * as they were when the remembered subtree selections were computed.
+   */
+  struct SelectionOptions {
+    double maximumScreenSpaceError = 0.0;
+    bool preloadAncestors = false;
+    bool preloadSiblings = false;
+    uint32_t loadingDescendantLimit = 0;
+    bool forbidHoles = false;
+    bool enableFrustumCulling = false;
+    bool enableFogCulling = false;
+    bool enableHorizonCulling = false;
+    bool enforceCulledScreenSpaceError = false;
+    double culledScreenSpaceError = 0.0;
+    std::vector<FogDensityAtHeight> fogDensityTable;
+    bool renderTilesUnderCamera = false;
+    std::vector<const ITileExcluder*> excluders;
+  };
+
+  // The state used for frame-coherent selection, see
+  // `TilesetOptions::enableFrameCoherentSelection`.
+  std::vector<VisitedTile> _visitedTiles;
+  std::vector<SubtreeSelectionRecord> _subtreeSelectionRecords;
+  std::unordered_map<const Tile*, SubtreeSelection> _subtreeSelectionCache;
+  SelectionOptions _subtreeSelectionOptions;
+
   CESIUM_TRACE_DECLARE_TRACK_SET(_loadingSlots, "Tileset Loading Slot");
 
   static double addTileToLoadQueue(
@@ -647,14 +821,29 @@ private:
       uint32_t maximumLoadsInProgress);
 
   void loadSubtree(const SubtreeLoadRecord& loadRecord);
+  void loadSubtree(
+      TileContext& context,
+      const TileID& subtreeRootID,
+      CesiumGeometry::AvailabilityNode* pParentNode,
+      std::atomic<uint32_t>& loadsInProgress);
   void addSubtreeToLoadQueue(
       Tile& tile,
       const ImplicitTraversalInfo& implicitInfo,
       double loadPriority);
   void processSubtreeQueue();
 
+  void addSubtreePrefetchesToQueue(
+      const FrameState& frameState,
+      const ImplicitTraversalInfo& implicitInfo,
+      Tile& tile,
+      const std::vector<double>& distances,
+      bool culled);
+  void processSubtreePrefetchQueue();
+
   Tileset(const Tileset& rhs) = delete;
   Tileset& operator=(const Tileset& rhs) = delete;
+
+  friend class TilesetGroup;
 };
 
 } // namespace Cesium3DTilesSelection
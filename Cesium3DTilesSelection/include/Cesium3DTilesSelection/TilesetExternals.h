@@ -9,9 +9,14 @@
 
 namespace CesiumAsync {
 class IAssetAccessor;
+class IDerivedDataCache;
 class ITaskProcessor;
 } // namespace CesiumAsync
 
+namespace CesiumUtility {
+class MetricsRegistry;
+} // namespace CesiumUtility
+
 namespace Cesium3DTilesSelection {
 class CreditSystem;
 class IPrepareRendererResources;
@@ -55,6 +60,27 @@ public:
    * If not specified, defaults to `spdlog::default_logger()`.
    */
   std::shared_ptr<spdlog::logger> pLogger = spdlog::default_logger();
+
+  /**
+   * @brief A registry that receives metrics about loading and unloading
+   * tiles, such as decode and preparation times, cache evictions and the
+   * number of bytes loaded.
+   *
+   * If not specified, no metrics are recorded. To also record request
+   * latencies, pass the same registry to the
+   * {@link CesiumAsync::CachingAssetAccessor}.
+   */
+  std::shared_ptr<CesiumUtility::MetricsRegistry> pMetrics;
+
+  /**
+   * @brief A cache of data derived from downloaded assets, such as parsed
+   * availability subtrees and processed tile content, that persists across
+   * sessions.
+   *
+   * If not specified, derived data is recomputed every time an asset is
+   * loaded.
+   */
+  std::shared_ptr<CesiumAsync::IDerivedDataCache> pDerivedDataCache;
 };
 
 } // namespace Cesium3DTilesSelection
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Library.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+class Tileset;
+
+/**
+ * @brief Options for configuring a {@link TilesetGroup}.
+ */
+struct CESIUM3DTILESSELECTION_API TilesetGroupOptions {
+  /**
+   * @brief The maximum number of tiles that may be loaded at once by all of
+   * the tilesets in the group together.
+   */
+  uint32_t maximumSimultaneousTileLoads = 20;
+
+  /**
+   * @brief The maximum number of bytes that may be cached by all of the
+   * tilesets in the group together.
+   *
+   * Note that this value, even if 0, will never cause tiles that are needed
+   * for rendering to be unloaded. However, if the total number of loaded bytes
+   * is greater than this value, tiles will be unloaded until the total is under
+   * this number or until only required tiles remain, whichever comes first.
+   */
+  int64_t maximumCachedBytes = 512 * 1024 * 1024;
+};
+
+/**
+ * @brief A group of {@link Tileset} instances that share one limit on the
+ * number of simultaneous tile loads and one budget for cached bytes.
+ *
+ * Without a group, every tileset enforces
+ * {@link TilesetOptions::maximumSimultaneousTileLoads} and
+ * {@link TilesetOptions::maximumCachedBytes} on its own, so a scene with
+ * several tilesets uses several times the configured limits, and an idle
+ * tileset cannot give its share to a busy one.
+ *
+ * A tileset joins a group when it is constructed with the group in
+ * {@link TilesetOptions::group}, and leaves it when it is destroyed. The
+ * per-tileset limits above are ignored for members of a group, and
+ * {@link Tileset::updateView} of a member neither loads nor unloads tiles.
+ * Instead, {@link update} must be called once per frame, after all members
+ * have been updated. It
+ *
+ *  - unloads tiles that were not used in the last frame of their tileset,
+ *    those that have not been used for the most frames first, across all
+ *    members, until the total size of all members is within the budget, and
+ *  - starts loading the tiles queued by all members, high priority tiles
+ *    first, comparing the load priority of tiles across all members, until
+ *    the shared load limit is reached.
+ *
+ * The load priorities of different tilesets are comparable because they are
+ * computed from the same views. Loads of implicit tiling subtrees are still
+ * limited per tileset.
+ *
+ * All functions of this class must be called from the thread that calls
+ * {@link Tileset::updateView}.
+ */
+class CESIUM3DTILESSELECTION_API TilesetGroup final {
+public:
+  /**
+   * @brief Creates a new instance.
+   *
+   * @param options The {@link TilesetGroupOptions} for the group.
+   */
+  TilesetGroup(const TilesetGroupOptions& options = TilesetGroupOptions());
+
+  /**
+   * @brief Gets the {@link TilesetGroupOptions} of this group.
+   */
+  const TilesetGroupOptions& getOptions() const noexcept {
+    return this->_options;
+  }
+
+  /**
+   * @brief Gets the {@link TilesetGroupOptions} of this group, which may be
+   * modified.
+   */
+  TilesetGroupOptions& getOptions() noexcept { return this->_options; }
+
+  /**
+   * @brief Gets the tilesets that are currently in this group.
+   */
+  const std::vector<Tileset*>& getTilesets() const noexcept {
+    return this->_tilesets;
+  }
+
+  /**
+   * @brief Gets the total number of bytes of tile and raster overlay data that
+   * are currently loaded by all tilesets in this group.
+   */
+  int64_t getTotalDataBytes() const noexcept;
+
+  /**
+   * @brief Gets the number of loads that are currently in progress in all
+   * tilesets in this group.
+   */
+  uint32_t getNumberOfLoadsInProgress() const noexcept;
+
+  /**
+   * @brief Unloads cached tiles and starts tile loads for all tilesets in
+   * this group.
+   *
+   * This must be called once per frame, after {@link Tileset::updateView} has
+   * been called for the members that are updated in that frame. Tiles queued
+   * by a member are only considered in the next call to this function.
+   */
+  void update();
+
+private:
+  friend class Tileset;
+
+  void addTileset(Tileset& tileset);
+  void removeTileset(Tileset& tileset) noexcept;
+
+  void unloadCachedTiles() noexcept;
+  void processLoadQueues();
+
+  TilesetGroupOptions _options;
+  std::vector<Tileset*> _tilesets;
+
+  TilesetGroup(const TilesetGroup& rhs) = delete;
+  TilesetGroup& operator=(const TilesetGroup& rhs) = delete;
+};
+
+} // namespace Cesium3DTilesSelection
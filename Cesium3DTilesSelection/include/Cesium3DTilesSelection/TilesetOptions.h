@@ -2,6 +2,8 @@
 
 #include "Library.h"
 
+#include <CesiumGltfReader/GltfReader.h>
+
 #include <memory>
 #include <optional>
 #include <string>
@@ -10,6 +12,7 @@
 namespace Cesium3DTilesSelection {
 
 class ITileExcluder;
+class TilesetGroup;
 
 /**
  * @brief Options for configuring the parsing of a {@link Tileset}'s content
@@ -35,6 +38,45 @@ struct CESIUM3DTILESSELECTION_API TilesetContentOptions {
    * normals.
    */
   bool generateMissingNormalsSmooth = false;
+
+  /**
+   * @brief Whether to decode the images embedded in glTF content while the
+   * content is loaded.
+   *
+   * Decoding images, especially JPEGs, often dominates the load time of
+   * textured tiles. If this is `false`, images are left encoded and the
+   * renderer can decode only those it needs, once it needs them, with
+   * {@link CesiumGltfReader::GltfReader::readEmbeddedImage} or
+   * {@link CesiumGltfReader::GltfReader::decodeEmbeddedImages}. Tiles that
+   * are never rendered then never pay for image decoding.
+   */
+  bool decodeEmbeddedImages = true;
+
+  /**
+   * @brief Whether to generate mip levels for the images of glTF content
+   * while the content is loaded.
+   *
+   * See {@link CesiumGltfReader::ReadModelOptions::generateMipMaps}.
+   */
+  bool generateMipMaps = false;
+
+  /**
+   * @brief Whether to create a {@link FeatureIdIndex} for glTF content with
+   * `EXT_feature_metadata` feature IDs while the content is loaded.
+   *
+   * The index is available from {@link TileContentLoadResult::featureIdIndex}
+   * and finds the vertices and indices of a feature without scanning its
+   * feature ID attribute.
+   */
+  bool createFeatureIdIndex = false;
+
+  /**
+   * @brief The GPU block-compressed formats that the renderer can use for
+   * KTX2 images of glTF content.
+   *
+   * See {@link CesiumGltfReader::Ktx2TranscodeTargets}.
+   */
+  CesiumGltfReader::Ktx2TranscodeTargets ktx2TranscodeTargets;
 };
 
 /**
@@ -83,6 +125,33 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   uint32_t maximumSimultaneousSubtreeLoads = 20;
 
+  /**
+   * @brief The maximum number of child subtrees of implicit tilesets that may
+   * simultaneously be prefetched, in addition to the loads counted by
+   * {@link maximumSimultaneousSubtreeLoads}.
+   *
+   * The child subtrees below a tile in the last level of a loaded subtree are
+   * prefetched as soon as that tile comes close to being refined, instead of
+   * when the traversal first reaches their root tiles. See
+   * {@link subtreePrefetchScreenSpaceErrorRatio} and
+   * {@link subtreePrefetchDistance}. Zero disables prefetching.
+   */
+  uint32_t maximumSimultaneousSubtreePrefetches = 10;
+
+  /**
+   * @brief The fraction of the {@link maximumScreenSpaceError} above which a
+   * visible tile is considered close to being refined, so that the child
+   * subtrees below it are prefetched.
+   */
+  double subtreePrefetchScreenSpaceErrorRatio = 0.5;
+
+  /**
+   * @brief The distance from the camera, in meters, within which the child
+   * subtrees below a tile are prefetched regardless of its screen-space error
+   * or visibility.
+   */
+  double subtreePrefetchDistance = 0.0;
+
   /**
    * @brief Indicates whether the ancestors of rendered tiles should be
    * preloaded. Setting this to true optimizes the zoom-out experience and
@@ -134,6 +203,19 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   bool enableFogCulling = true;
 
+  /**
+   * @brief Enable culling of tiles that are hidden behind the horizon of the
+   * WGS84 ellipsoid.
+   *
+   * Tiles are tested with their horizon occlusion point. Quantized-mesh
+   * terrain provides this point for each tile; for other tiles it is computed
+   * from the bounding volume. This is only suitable for tilesets whose content
+   * is not significantly below the surface of the ellipsoid, such as terrain
+   * and other global tilesets, so it is disabled by default. Tiles are never
+   * culled by the horizon of a frustum whose camera is inside the ellipsoid.
+   */
+  bool enableHorizonCulling = false;
+
   /**
    * @brief Whether culled tiles should be refined until they meet
    * culledScreenSpaceError.
@@ -205,6 +287,52 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   std::vector<std::shared_ptr<ITileExcluder>> excluders;
 
+  /**
+   * @brief The group that the tileset joins when it is constructed.
+   *
+   * The tilesets of a group share one limit on the number of simultaneous
+   * tile loads and one budget for cached bytes, see {@link TilesetGroup}. In
+   * that case, {@link maximumSimultaneousTileLoads} and
+   * {@link maximumCachedBytes} are ignored, and tiles are only loaded and
+   * unloaded by {@link TilesetGroup::update}. Changing this after the tileset
+   * is constructed has no effect.
+   */
+  std::shared_ptr<TilesetGroup> group;
+
+  /**
+   * @brief Whether to reuse the selection results of unchanged subtrees from
+   * previous frames.
+   *
+   * When true, the tileset remembers the selection results of subtrees in
+   * which every tile is done loading and in which the selection did not change
+   * from one frame to the next. As long as the view stays within
+   * {@link frameCoherentSelectionTolerance} of the view for which such a
+   * subtree was selected, and none of its tiles changes its load state, the
+   * remembered {@link TileSelectionState}s and render list of the subtree are
+   * reused instead of traversing it again. For static or slowly-moving cameras
+   * this makes selection nearly free, at the cost of tolerating a small error
+   * in the selection.
+   *
+   * The remembered selection results are discarded when any other option
+   * that affects the selection changes. Excluders are compared by identity,
+   * so an excluder whose results change should be replaced by a new instance
+   * rather than modified.
+   */
+  bool enableFrameCoherentSelection = false;
+
+  /**
+   * @brief The largest change of the view for which the selection results of
+   * a subtree are reused when {@link enableFrameCoherentSelection} is true.
+   *
+   * The camera may move by this fraction of its distance to the subtree's
+   * bounding volume, and its direction and up vectors may rotate by this
+   * angle in radians, before the subtree is traversed again. No tile in the
+   * subtree is closer to the camera than the subtree's bounding volume, so
+   * this also bounds the relative change of the screen-space error of every
+   * tile in the subtree.
+   */
+  double frameCoherentSelectionTolerance = 0.001;
+
   /**
    * @brief Options for configuring the parsing of a {@link Tileset}'s content
    * and construction of Gltf models.
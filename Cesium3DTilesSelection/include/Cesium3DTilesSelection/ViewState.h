@@ -100,6 +100,13 @@ public:
     return this->_verticalFieldOfView;
   }
 
+  /**
+   * @brief Gets the {@link CullingVolume} of the frustum of this camera.
+   */
+  const CullingVolume& getCullingVolume() const noexcept {
+    return this->_cullingVolume;
+  }
+
   /**
    * @brief Returns whether the given {@link BoundingVolume} is visible for this
    * camera
@@ -39,7 +39,9 @@ public:
   uint32_t tilesVisited = 0;
   uint32_t culledTilesVisited = 0;
   uint32_t tilesCulled = 0;
+  uint32_t tilesHorizonCulled = 0;
   uint32_t maxDepthVisited = 0;
+  uint32_t tilesReusedFromPreviousFrames = 0;
   //! @endcond
 };
 
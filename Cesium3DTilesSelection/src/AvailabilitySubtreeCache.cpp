@@ -0,0 +1,184 @@
+#include "AvailabilitySubtreeCache.h"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace CesiumGeometry;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+const char subtreeMagic[4] = {'C', 'S', 'U', 'B'};
+const uint32_t subtreeVersion = 1;
+
+struct CachedSubtreeHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t bufferCount;
+  uint32_t reserved;
+};
+
+enum class CachedViewType : uint32_t { Constant = 0, BufferView = 1 };
+
+struct CachedAvailabilityView {
+  CachedViewType type;
+  // The constant availability, or the byte offset of the buffer view.
+  uint32_t constantOrByteOffset;
+  uint32_t byteLength;
+  uint32_t buffer;
+};
+
+static_assert(sizeof(CachedSubtreeHeader) == 16, "Must not be padded");
+static_assert(sizeof(CachedAvailabilityView) == 16, "Must not be padded");
+
+const size_t viewsOffset = sizeof(CachedSubtreeHeader);
+const size_t bufferLengthsOffset =
+    viewsOffset + 3 * sizeof(CachedAvailabilityView);
+
+size_t alignTo8(size_t value) noexcept { return (value + 7) & ~size_t(7); }
+
+CachedAvailabilityView writeView(const AvailabilityView& view) noexcept {
+  const SubtreeBufferView* pBufferView = std::get_if<SubtreeBufferView>(&view);
+  if (pBufferView) {
+    return CachedAvailabilityView{
+        CachedViewType::BufferView,
+        pBufferView->byteOffset,
+        pBufferView->byteLength,
+        pBufferView->buffer};
+  }
+
+  const bool constant = std::get<ConstantAvailability>(view).constant;
+  return CachedAvailabilityView{
+      CachedViewType::Constant,
+      constant ? 1U : 0U,
+      0,
+      0};
+}
+
+std::optional<AvailabilityView>
+readView(const CachedAvailabilityView& view) noexcept {
+  switch (view.type) {
+  case CachedViewType::Constant:
+    return ConstantAvailability{view.constantOrByteOffset != 0};
+  case CachedViewType::BufferView:
+    if (view.buffer > UINT8_MAX) {
+      return std::nullopt;
+    }
+    return SubtreeBufferView{
+        view.constantOrByteOffset,
+        view.byteLength,
+        static_cast<uint8_t>(view.buffer)};
+  }
+  return std::nullopt;
+}
+} // namespace
+
+namespace AvailabilitySubtreeCache {
+
+std::string getKey(const std::string& url, const std::string& etag) {
+  return "availability-subtree:" + std::to_string(subtreeVersion) + ":" +
+         url + " " + etag;
+}
+
+std::vector<std::byte> write(const AvailabilitySubtree& subtree) {
+  const size_t bufferCount = subtree.buffers.size();
+
+  size_t size = bufferLengthsOffset + bufferCount * sizeof(uint64_t);
+  for (const std::vector<std::byte>& buffer : subtree.buffers) {
+    size = alignTo8(size) + buffer.size();
+  }
+
+  std::vector<std::byte> result(size);
+  std::byte* pData = result.data();
+
+  CachedSubtreeHeader header{};
+  std::memcpy(header.magic, subtreeMagic, sizeof(subtreeMagic));
+  header.version = subtreeVersion;
+  header.bufferCount = static_cast<uint32_t>(bufferCount);
+  std::memcpy(pData, &header, sizeof(header));
+
+  const CachedAvailabilityView views[3] = {
+      writeView(subtree.tileAvailability),
+      writeView(subtree.contentAvailability),
+      writeView(subtree.subtreeAvailability)};
+  std::memcpy(pData + viewsOffset, views, sizeof(views));
+
+  size_t offset = bufferLengthsOffset + bufferCount * sizeof(uint64_t);
+  for (size_t i = 0; i < bufferCount; ++i) {
+    const std::vector<std::byte>& buffer = subtree.buffers[i];
+
+    const uint64_t length = buffer.size();
+    std::memcpy(
+        pData + bufferLengthsOffset + i * sizeof(uint64_t),
+        &length,
+        sizeof(length));
+
+    offset = alignTo8(offset);
+    if (!buffer.empty()) {
+      std::memcpy(pData + offset, buffer.data(), buffer.size());
+    }
+    offset += buffer.size();
+  }
+
+  return result;
+}
+
+std::optional<AvailabilitySubtree>
+read(const gsl::span<const std::byte>& data) {
+  if (data.size() < bufferLengthsOffset) {
+    return std::nullopt;
+  }
+
+  CachedSubtreeHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (std::memcmp(header.magic, subtreeMagic, sizeof(subtreeMagic)) != 0 ||
+      header.version != subtreeVersion) {
+    return std::nullopt;
+  }
+
+  CachedAvailabilityView views[3];
+  std::memcpy(views, data.data() + viewsOffset, sizeof(views));
+
+  std::optional<AvailabilityView> tileAvailability = readView(views[0]);
+  std::optional<AvailabilityView> contentAvailability = readView(views[1]);
+  std::optional<AvailabilityView> subtreeAvailability = readView(views[2]);
+  if (!tileAvailability || !contentAvailability || !subtreeAvailability) {
+    return std::nullopt;
+  }
+
+  const size_t bufferCount = header.bufferCount;
+  if (bufferCount > (data.size() - bufferLengthsOffset) / sizeof(uint64_t)) {
+    return std::nullopt;
+  }
+
+  AvailabilitySubtree subtree{
+      *tileAvailability,
+      *contentAvailability,
+      *subtreeAvailability,
+      {}};
+  subtree.buffers.reserve(bufferCount);
+
+  size_t offset = bufferLengthsOffset + bufferCount * sizeof(uint64_t);
+  for (size_t i = 0; i < bufferCount; ++i) {
+    uint64_t length;
+    std::memcpy(
+        &length,
+        data.data() + bufferLengthsOffset + i * sizeof(uint64_t),
+        sizeof(length));
+
+    offset = alignTo8(offset);
+    if (offset > data.size() || length > data.size() - offset) {
+      return std::nullopt;
+    }
+
+    const std::byte* pBuffer = data.data() + offset;
+    subtree.buffers.emplace_back(pBuffer, pBuffer + length);
+    offset += static_cast<size_t>(length);
+  }
+
+  return subtree;
+}
+
+} // namespace AvailabilitySubtreeCache
+
+} // namespace Cesium3DTilesSelection
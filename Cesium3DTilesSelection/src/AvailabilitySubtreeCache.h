@@ -0,0 +1,52 @@
+#pragma once
+
+#include <CesiumGeometry/Availability.h>
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief Stores parsed availability subtrees in a compact binary form for a
+ * {@link CesiumAsync::IDerivedDataCache}, so that a subtree that was loaded
+ * before does not need to be parsed again.
+ *
+ * The form is a fixed-size header that describes the three availability
+ * views, followed by the lengths of the buffers and then the buffers
+ * themselves, each starting at a multiple of 8 bytes. All fields are in the
+ * byte order of the machine that wrote them and are read in place, without
+ * any parsing.
+ */
+namespace AvailabilitySubtreeCache {
+
+/**
+ * @brief Gets the key of a subtree in the cache.
+ *
+ * @param url The URL of the subtree.
+ * @param etag The ETag of the response that the subtree was loaded from.
+ */
+std::string getKey(const std::string& url, const std::string& etag);
+
+/**
+ * @brief Writes a subtree in the cached form.
+ */
+std::vector<std::byte>
+write(const CesiumGeometry::AvailabilitySubtree& subtree);
+
+/**
+ * @brief Reads a subtree from the cached form.
+ *
+ * @return The subtree, or `std::nullopt` if the data is not a subtree written
+ * by this version of {@link write}.
+ */
+std::optional<CesiumGeometry::AvailabilitySubtree>
+read(const gsl::span<const std::byte>& data);
+
+} // namespace AvailabilitySubtreeCache
+
+} // namespace Cesium3DTilesSelection
@@ -1,11 +1,15 @@
 
 #include "AvailabilitySubtreeContent.h"
 
+#include "AvailabilitySubtreeCache.h"
+
 #include <CesiumUtility/Uri.h>
 
 #include <gsl/span>
 #include <rapidjson/document.h>
 
+#include <algorithm>
+#include <cassert>
 #include <cstring>
 #include <optional>
 #include <string>
@@ -267,4 +271,69 @@ AvailabilitySubtreeContent::load(
           });
 }
 
+/*static*/
+CesiumAsync::Future<std::unique_ptr<AvailabilitySubtree>>
+AvailabilitySubtreeContent::load(
+    AsyncSystem asyncSystem,
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::shared_ptr<IAssetRequest>& pRequest,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<IDerivedDataCache>& pDerivedDataCache) {
+  const IAssetResponse* pResponse = pRequest->response();
+  assert(pResponse);
+
+  const HttpHeaders& responseHeaders = pResponse->headers();
+  HttpHeaders::const_iterator etagIt = responseHeaders.find("ETag");
+  if (!pDerivedDataCache || etagIt == responseHeaders.end()) {
+    return load(
+        asyncSystem,
+        pLogger,
+        pRequest->url(),
+        pResponse->data(),
+        pAssetAccessor,
+        pRequest->headers());
+  }
+
+  std::string key =
+      AvailabilitySubtreeCache::getKey(pRequest->url(), etagIt->second);
+
+  std::unique_ptr<IDerivedDataEntry> pEntry = pDerivedDataCache->getEntry(key);
+  if (pEntry) {
+    std::optional<AvailabilitySubtree> cachedSubtree =
+        AvailabilitySubtreeCache::read(pEntry->data());
+    if (cachedSubtree) {
+      return asyncSystem.createResolvedFuture(
+          std::make_unique<AvailabilitySubtree>(std::move(*cachedSubtree)));
+    }
+  }
+
+  return load(
+             asyncSystem,
+             pLogger,
+             pRequest->url(),
+             pResponse->data(),
+             pAssetAccessor,
+             pRequest->headers())
+      .thenImmediately(
+          [pDerivedDataCache, key = std::move(key)](
+              std::unique_ptr<AvailabilitySubtree>&& pSubtree) {
+            // An empty buffer means that an external buffer failed to load,
+            // so don't cache the subtree and try again next time.
+            const bool complete =
+                pSubtree &&
+                std::none_of(
+                    pSubtree->buffers.begin(),
+                    pSubtree->buffers.end(),
+                    [](const std::vector<std::byte>& buffer) {
+                      return buffer.empty();
+                    });
+            if (complete) {
+              pDerivedDataCache->storeEntry(
+                  key,
+                  AvailabilitySubtreeCache::write(*pSubtree));
+            }
+            return std::move(pSubtree);
+          });
+}
+
 } // namespace Cesium3DTilesSelection
@@ -7,6 +7,7 @@
 #include "CesiumAsync/IAssetAccessor.h"
 #include "CesiumAsync/IAssetRequest.h"
 #include "CesiumAsync/IAssetResponse.h"
+#include "CesiumAsync/IDerivedDataCache.h"
 #include "CesiumGeometry/Availability.h"
 
 #include <memory>
@@ -24,6 +25,30 @@ public:
       const gsl::span<const std::byte>& data,
       const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
       const CesiumAsync::HttpHeaders& headers);
+
+  /**
+   * @brief Loads a subtree from a response, using a derived data cache to
+   * skip parsing subtrees that were loaded before.
+   *
+   * Subtrees are only cached if the response has an `ETag` header, because
+   * the URL alone does not identify the version of the subtree.
+   *
+   * @param asyncSystem The async system.
+   * @param pLogger The logger that receives parsing errors.
+   * @param pRequest The completed request for the subtree.
+   * @param pAssetAccessor The asset accessor to load external buffers with.
+   * @param pDerivedDataCache The cache of parsed subtrees, or `nullptr` to
+   * always parse the subtree.
+   */
+  static CesiumAsync::Future<
+      std::unique_ptr<CesiumGeometry::AvailabilitySubtree>>
+  load(
+      CesiumAsync::AsyncSystem asyncSystem,
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      const std::shared_ptr<CesiumAsync::IAssetRequest>& pRequest,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<CesiumAsync::IDerivedDataCache>&
+          pDerivedDataCache);
 };
 
 } // namespace Cesium3DTilesSelection
@@ -189,7 +189,8 @@ Batched3DModelContent::load(const TileContentLoadInput& input) {
              url,
              headers,
              pAssetAccessor,
-             glbData)
+             glbData,
+             input.contentOptions)
       .thenInWorkerThread([header = std::move(header),
                            headerLength,
                            pLogger,
@@ -220,26 +221,11 @@ Batched3DModelContent::load(const TileContentLoadInput& input) {
                         batchTableStart + header.batchTableJsonByteLength),
                     header.batchTableBinaryByteLength);
 
-            rapidjson::Document batchTableJson;
-            batchTableJson.Parse(
-                reinterpret_cast<const char*>(batchTableJsonData.data()),
-                batchTableJsonData.size());
-            if (batchTableJson.HasParseError()) {
-              SPDLOG_LOGGER_WARN(
-                  pLogger,
-                  "Error when parsing batch table JSON, error code {} at byte "
-                  "offset "
-                  "{}. Skip parsing metadata",
-                  batchTableJson.GetParseError(),
-                  batchTableJson.GetErrorOffset());
-              return std::move(pResult);
-            }
-
             upgradeBatchTableToFeatureMetadata(
                 pLogger,
                 gltf,
                 featureTable,
-                batchTableJson,
+                batchTableJsonData,
                 batchTableBinaryData);
           }
         }
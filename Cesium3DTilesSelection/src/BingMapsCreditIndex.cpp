@@ -0,0 +1,226 @@
+#include "BingMapsCreditIndex.h"
+
+#include <CesiumUtility/Math.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+// Bing tiles are identified by 32-bit x and y coordinates, so no tile is
+// deeper than this. Coverage areas that extend further are indexed up to this
+// level, and deeper tiles are checked against that level's index.
+const uint32_t MAXIMUM_INDEXED_LEVEL = 33;
+
+const size_t NODE_CAPACITY = 16;
+
+/**
+ * @brief Sorts boxes in the order of the Sort-Tile-Recursive algorithm: into
+ * vertical slices by longitude, and then by latitude within each slice, so
+ * that consecutive runs of `NODE_CAPACITY` boxes are close together.
+ */
+template <typename T, typename GetBox>
+void sortTileRecursive(
+    typename std::vector<T>::iterator begin,
+    typename std::vector<T>::iterator end,
+    GetBox getBox) {
+  const size_t count = static_cast<size_t>(end - begin);
+  const size_t nodeCount = (count + NODE_CAPACITY - 1) / NODE_CAPACITY;
+  const size_t sliceCount = static_cast<size_t>(
+      std::ceil(std::sqrt(static_cast<double>(nodeCount))));
+  const size_t sliceSize = sliceCount * NODE_CAPACITY;
+
+  std::sort(begin, end, [&getBox](const T& a, const T& b) {
+    const auto& boxA = getBox(a);
+    const auto& boxB = getBox(b);
+    return boxA.west + boxA.east < boxB.west + boxB.east;
+  });
+
+  for (size_t sliceBegin = 0; sliceBegin < count; sliceBegin += sliceSize) {
+    const size_t sliceEnd = std::min(sliceBegin + sliceSize, count);
+    std::sort(
+        begin + static_cast<std::ptrdiff_t>(sliceBegin),
+        begin + static_cast<std::ptrdiff_t>(sliceEnd),
+        [&getBox](const T& a, const T& b) {
+          const auto& boxA = getBox(a);
+          const auto& boxB = getBox(b);
+          return boxA.south + boxA.north < boxB.south + boxB.north;
+        });
+  }
+}
+
+template <typename Box> void expand(Box& box, const Box& other) noexcept {
+  box.west = std::min(box.west, other.west);
+  box.south = std::min(box.south, other.south);
+  box.east = std::max(box.east, other.east);
+  box.north = std::max(box.north, other.north);
+}
+
+/**
+ * @brief Calls a function with each part of a rectangle on either side of the
+ * anti-meridian.
+ */
+template <typename Box, typename Function>
+void forEachBox(const GlobeRectangle& rectangle, Function&& f) {
+  const double west = rectangle.getWest();
+  const double south = rectangle.getSouth();
+  const double east = rectangle.getEast();
+  const double north = rectangle.getNorth();
+  if (west <= east) {
+    f(Box{west, south, east, north});
+  } else {
+    f(Box{west, south, Math::ONE_PI, north});
+    f(Box{-Math::ONE_PI, south, east, north});
+  }
+}
+} // namespace
+
+BingMapsCreditIndex::BingMapsCreditIndex(
+    std::vector<CreditAndCoverageAreas>&& credits)
+    : _credits(std::move(credits)), _levels() {
+  for (size_t i = 0; i < this->_credits.size(); ++i) {
+    const std::vector<CoverageArea>& areas = this->_credits[i].coverageAreas;
+    for (size_t j = 0; j < areas.size(); ++j) {
+      const CoverageArea& area = areas[j];
+      const uint32_t zoomMax = std::min(area.zoomMax, MAXIMUM_INDEXED_LEVEL);
+      if (area.zoomMin > zoomMax) {
+        continue;
+      }
+
+      if (this->_levels.size() <= zoomMax) {
+        this->_levels.resize(zoomMax + 1);
+      }
+
+      for (uint32_t level = area.zoomMin; level <= zoomMax; ++level) {
+        LevelTree& tree = this->_levels[level];
+        forEachBox<Box>(area.rectangle, [&tree, i, j](const Box& box) {
+          tree.entries.push_back(
+              {box, static_cast<uint32_t>(i), static_cast<uint32_t>(j)});
+        });
+      }
+    }
+  }
+
+  for (LevelTree& tree : this->_levels) {
+    buildTree(tree);
+  }
+}
+
+void BingMapsCreditIndex::buildTree(LevelTree& tree) {
+  if (tree.entries.empty()) {
+    return;
+  }
+
+  sortTileRecursive<Entry>(
+      tree.entries.begin(),
+      tree.entries.end(),
+      [](const Entry& entry) -> const Box& { return entry.box; });
+
+  // Create the leaves.
+  for (size_t begin = 0; begin < tree.entries.size(); begin += NODE_CAPACITY) {
+    const size_t end = std::min(begin + NODE_CAPACITY, tree.entries.size());
+    Node node{
+        tree.entries[begin].box,
+        static_cast<uint32_t>(begin),
+        static_cast<uint32_t>(end),
+        true};
+    for (size_t i = begin + 1; i < end; ++i) {
+      expand(node.box, tree.entries[i].box);
+    }
+    tree.nodes.push_back(node);
+  }
+
+  // Create the parents of each level of nodes, until there is a single root,
+  // which is the last node.
+  size_t levelBegin = 0;
+  size_t levelEnd = tree.nodes.size();
+  while (levelEnd - levelBegin > 1) {
+    sortTileRecursive<Node>(
+        tree.nodes.begin() + static_cast<std::ptrdiff_t>(levelBegin),
+        tree.nodes.begin() + static_cast<std::ptrdiff_t>(levelEnd),
+        [](const Node& node) -> const Box& { return node.box; });
+
+    for (size_t begin = levelBegin; begin < levelEnd; begin += NODE_CAPACITY) {
+      const size_t end = std::min(begin + NODE_CAPACITY, levelEnd);
+      Node node{
+          tree.nodes[begin].box,
+          static_cast<uint32_t>(begin),
+          static_cast<uint32_t>(end),
+          false};
+      for (size_t i = begin + 1; i < end; ++i) {
+        expand(node.box, tree.nodes[i].box);
+      }
+      tree.nodes.push_back(node);
+    }
+
+    levelBegin = levelEnd;
+    levelEnd = tree.nodes.size();
+  }
+}
+
+void BingMapsCreditIndex::findCredits(
+    uint32_t bingLevel,
+    const GlobeRectangle& rectangle,
+    std::vector<Credit>& credits) const {
+  const uint32_t treeLevel = std::min(bingLevel, MAXIMUM_INDEXED_LEVEL);
+  if (treeLevel >= this->_levels.size()) {
+    return;
+  }
+
+  const LevelTree& tree = this->_levels[treeLevel];
+  if (tree.nodes.empty()) {
+    return;
+  }
+
+  std::vector<uint32_t> creditIndices;
+  std::vector<uint32_t> stack;
+
+  forEachBox<Box>(rectangle, [&](const Box& box) {
+    stack.push_back(static_cast<uint32_t>(tree.nodes.size() - 1));
+    while (!stack.empty()) {
+      const Node& node = tree.nodes[stack.back()];
+      stack.pop_back();
+      if (!node.box.intersects(box)) {
+        continue;
+      }
+
+      if (!node.isLeaf) {
+        for (uint32_t i = node.begin; i < node.end; ++i) {
+          stack.push_back(i);
+        }
+        continue;
+      }
+
+      for (uint32_t i = node.begin; i < node.end; ++i) {
+        const Entry& entry = tree.entries[i];
+        if (!entry.box.intersects(box)) {
+          continue;
+        }
+
+        // The boxes only rule out areas that can't intersect; the exact test
+        // is the same as for an unindexed area.
+        const CoverageArea& area =
+            this->_credits[entry.creditIndex].coverageAreas[entry.areaIndex];
+        if (area.zoomMin <= bingLevel && bingLevel <= area.zoomMax &&
+            area.rectangle.computeIntersection(rectangle).has_value()) {
+          creditIndices.push_back(entry.creditIndex);
+        }
+      }
+    }
+  });
+
+  std::sort(creditIndices.begin(), creditIndices.end());
+  creditIndices.erase(
+      std::unique(creditIndices.begin(), creditIndices.end()),
+      creditIndices.end());
+
+  for (const uint32_t creditIndex : creditIndices) {
+    credits.push_back(this->_credits[creditIndex].credit);
+  }
+}
+
+} // namespace Cesium3DTilesSelection
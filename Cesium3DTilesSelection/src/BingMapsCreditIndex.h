@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Cesium3DTilesSelection/CreditSystem.h"
+
+#include <CesiumGeospatial/GlobeRectangle.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief An area in which a Bing Maps imagery provider must be credited,
+ * between two Bing zoom levels.
+ */
+struct CoverageArea {
+  CesiumGeospatial::GlobeRectangle rectangle;
+  uint32_t zoomMin;
+  uint32_t zoomMax;
+};
+
+/**
+ * @brief A Bing Maps imagery provider's credit and the areas it covers.
+ */
+struct CreditAndCoverageAreas {
+  Credit credit;
+  std::vector<CoverageArea> coverageAreas;
+};
+
+/**
+ * @brief Finds the credits for a Bing Maps tile without testing every
+ * coverage area.
+ *
+ * The coverage areas are indexed per Bing zoom level in a packed R-tree, so
+ * finding the areas that intersect a tile takes time logarithmic in the
+ * number of areas at that level. The credits found are the same, and in the
+ * same order, as those found by testing each area in turn.
+ */
+class BingMapsCreditIndex final {
+public:
+  /**
+   * @brief Creates an index without any credits.
+   */
+  BingMapsCreditIndex() = default;
+
+  /**
+   * @brief Creates an index of the given credits and their coverage areas.
+   */
+  explicit BingMapsCreditIndex(std::vector<CreditAndCoverageAreas>&& credits);
+
+  /**
+   * @brief Appends the credits whose coverage areas intersect a tile.
+   *
+   * Each credit is appended at most once, in the order that the credits were
+   * given to the constructor.
+   *
+   * @param bingLevel The Bing zoom level of the tile, which starts at 1.
+   * @param rectangle The rectangle covered by the tile.
+   * @param credits The vector to append the credits to.
+   */
+  void findCredits(
+      uint32_t bingLevel,
+      const CesiumGeospatial::GlobeRectangle& rectangle,
+      std::vector<Credit>& credits) const;
+
+private:
+  // A longitude / latitude box that does not cross the anti-meridian.
+  struct Box {
+    double west;
+    double south;
+    double east;
+    double north;
+
+    bool intersects(const Box& other) const noexcept {
+      return this->west <= other.east && other.west <= this->east &&
+             this->south <= other.north && other.south <= this->north;
+    }
+  };
+
+  struct Entry {
+    Box box;
+    uint32_t creditIndex;
+    uint32_t areaIndex;
+  };
+
+  // A node's children are either entries or other nodes of the same level,
+  // in the range [begin, end).
+  struct Node {
+    Box box;
+    uint32_t begin;
+    uint32_t end;
+    bool isLeaf;
+  };
+
+  struct LevelTree {
+    std::vector<Entry> entries;
+    std::vector<Node> nodes;
+  };
+
+  static void buildTree(LevelTree& tree);
+
+  std::vector<CreditAndCoverageAreas> _credits;
+  std::vector<LevelTree> _levels;
+};
+
+} // namespace Cesium3DTilesSelection
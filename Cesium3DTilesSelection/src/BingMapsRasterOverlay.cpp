@@ -1,7 +1,9 @@
 #include "Cesium3DTilesSelection/BingMapsRasterOverlay.h"
 
+#include "BingMapsCreditIndex.h"
 #include "Cesium3DTilesSelection/CreditSystem.h"
 #include "Cesium3DTilesSelection/QuadtreeRasterOverlayTileProvider.h"
+#include "Cesium3DTilesSelection/RasterOverlayMetadataCache.h"
 #include "Cesium3DTilesSelection/RasterOverlayTile.h"
 #include "Cesium3DTilesSelection/RasterOverlayTileProvider.h"
 #include "Cesium3DTilesSelection/TilesetExternals.h"
@@ -20,25 +22,9 @@
 #include <rapidjson/pointer.h>
 
 #include <optional>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
-namespace {
-struct CoverageArea {
-  CesiumGeospatial::GlobeRectangle rectangle;
-  uint32_t zoomMin;
-  uint32_t zoomMax;
-};
-
-struct CreditAndCoverageAreas {
-  Cesium3DTilesSelection::Credit credit;
-  std::vector<CoverageArea> coverageAreas;
-};
-
-std::unordered_map<std::string, std::vector<std::byte>> sessionCache;
-} // namespace
-
 using namespace CesiumAsync;
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -90,7 +76,7 @@ public:
       const CesiumAsync::AsyncSystem& asyncSystem,
       const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
       Credit bingCredit,
-      const std::vector<CreditAndCoverageAreas>& perTileCredits,
+      std::vector<CreditAndCoverageAreas>&& perTileCredits,
       const std::shared_ptr<IPrepareRendererResources>&
           pPrepareRendererResources,
       const std::shared_ptr<spdlog::logger>& pLogger,
@@ -121,7 +107,7 @@ public:
             maximumLevel,
             width,
             height),
-        _credits(perTileCredits),
+        _credits(std::move(perTileCredits)),
         _urlTemplate(urlTemplate),
         _subdomains(subdomains) {
     if (this->_urlTemplate.find("n=z") == std::string::npos) {
@@ -180,27 +166,16 @@ protected:
     // Cesium levels start at 0, Bing levels start at 1
     const unsigned int bingTileLevel = tileID.level + 1;
 
-    for (const CreditAndCoverageAreas& creditAndCoverageAreas : _credits) {
-      for (const CoverageArea& coverageArea :
-           creditAndCoverageAreas.coverageAreas) {
-        if (coverageArea.zoomMin <= bingTileLevel &&
-            bingTileLevel <= coverageArea.zoomMax &&
-            coverageArea.rectangle.computeIntersection(tileRectangle)
-                .has_value()) {
-          tileCredits.push_back(creditAndCoverageAreas.credit);
-          break;
-        }
-      }
-    }
+    this->_credits.findCredits(bingTileLevel, tileRectangle, tileCredits);
 
     return this->loadTileImageFromUrl(url, {}, std::move(options));
   }
 
 private:
   static std::string tileXYToQuadKey(uint32_t level, uint32_t x, uint32_t y) {
-    std::string quadkey;
-    for (int32_t i = static_cast<int32_t>(level); i >= 0; --i) {
-      const uint32_t bitmask = static_cast<uint32_t>(1 << i);
+    std::string quadkey(static_cast<size_t>(level) + 1, '0');
+    for (uint32_t i = 0; i <= level; ++i) {
+      const uint32_t bitmask = 1U << (level - i);
       uint32_t digit = 0;
 
       if ((x & bitmask) != 0) {
@@ -211,13 +186,13 @@ private:
         digit |= 2;
       }
 
-      quadkey += std::to_string(digit);
+      quadkey[i] = static_cast<char>('0' + digit);
     }
 
     return quadkey;
   }
 
-  std::vector<CreditAndCoverageAreas> _credits;
+  BingMapsCreditIndex _credits;
   std::string _urlTemplate;
   std::vector<std::string> _subdomains;
 };
@@ -241,6 +216,28 @@ BingMapsRasterOverlay::~BingMapsRasterOverlay() {}
 
 namespace {
 
+/**
+ * @brief The parts of a Bing Maps imagery metadata response that are needed
+ * to create a tile provider.
+ *
+ * This does not refer to a {@link CreditSystem}, so it can be shared by
+ * overlays with different credit systems through a
+ * {@link RasterOverlayMetadataCache}.
+ */
+struct BingMapsMetadata {
+  struct Attribution {
+    std::string html;
+    std::vector<CoverageArea> coverageAreas;
+  };
+
+  uint32_t width;
+  uint32_t height;
+  uint32_t maximumLevel;
+  std::vector<std::string> subdomains;
+  std::string urlTemplate;
+  std::vector<Attribution> attributions;
+};
+
 /**
  * @brief Collects credit information from an imagery metadata response.
  *
@@ -263,14 +260,11 @@ namespace {
  * \endcode
  *
  * @param pResource The JSON value for the resource
- * @param pCreditSystem The `CreditSystem` that will create one credit for
- * each attribution
- * @return The `CreditAndCoverageAreas` objects that have been parsed
+ * @return The attributions and their coverage areas that have been parsed
  */
-std::vector<CreditAndCoverageAreas> collectCredits(
-    const rapidjson::Value* pResource,
-    const std::shared_ptr<CreditSystem>& pCreditSystem) {
-  std::vector<CreditAndCoverageAreas> credits;
+std::vector<BingMapsMetadata::Attribution>
+collectAttributions(const rapidjson::Value* pResource) {
+  std::vector<BingMapsMetadata::Attribution> attributions;
   const auto attributionsIt = pResource->FindMember("imageryProviders");
   if (attributionsIt != pResource->MemberEnd() &&
       attributionsIt->value.IsArray()) {
@@ -316,13 +310,61 @@ std::vector<CreditAndCoverageAreas> collectCredits(
       const auto creditString = attribution.FindMember("attribution");
       if (creditString != attribution.MemberEnd() &&
           creditString->value.IsString()) {
-        credits.push_back(
-            {pCreditSystem->createCredit(creditString->value.GetString()),
-             coverageAreas});
+        attributions.push_back(
+            {creditString->value.GetString(), std::move(coverageAreas)});
       }
     }
   }
-  return credits;
+  return attributions;
+}
+
+std::shared_ptr<const BingMapsMetadata> parseMetadata(
+    const gsl::span<const std::byte>& data,
+    const std::shared_ptr<spdlog::logger>& pLogger) {
+  rapidjson::Document response;
+  response.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+
+  if (response.HasParseError()) {
+    SPDLOG_LOGGER_ERROR(
+        pLogger,
+        "Error when parsing Bing Maps imagery metadata, error code "
+        "{} at byte offset {}",
+        response.GetParseError(),
+        response.GetErrorOffset());
+    return nullptr;
+  }
+
+  rapidjson::Value* pResource =
+      rapidjson::Pointer("/resourceSets/0/resources/0").Get(response);
+  if (!pResource) {
+    SPDLOG_LOGGER_ERROR(
+        pLogger,
+        "Resources were not found in the Bing Maps imagery metadata "
+        "response.");
+    return nullptr;
+  }
+
+  auto pMetadata = std::make_shared<BingMapsMetadata>();
+  pMetadata->width =
+      JsonHelpers::getUint32OrDefault(*pResource, "imageWidth", 256U);
+  pMetadata->height =
+      JsonHelpers::getUint32OrDefault(*pResource, "imageHeight", 256U);
+  pMetadata->maximumLevel =
+      JsonHelpers::getUint32OrDefault(*pResource, "zoomMax", 30U);
+
+  pMetadata->subdomains =
+      JsonHelpers::getStrings(*pResource, "imageUrlSubdomains");
+  pMetadata->urlTemplate =
+      JsonHelpers::getStringOrDefault(*pResource, "imageUrl", std::string());
+  if (pMetadata->urlTemplate.empty()) {
+    SPDLOG_LOGGER_ERROR(
+        pLogger,
+        "Bing Maps tile imageUrl is missing or empty.");
+    return nullptr;
+  }
+
+  pMetadata->attributions = collectAttributions(pResource);
+  return pMetadata;
 }
 
 } // namespace
@@ -346,7 +388,7 @@ BingMapsRasterOverlay::createTileProvider(
 
   pOwner = pOwner ? pOwner : this;
 
-  auto handleResponse =
+  auto createProvider =
       [pOwner,
        asyncSystem,
        pAssetAccessor,
@@ -354,52 +396,16 @@ BingMapsRasterOverlay::createTileProvider(
        pPrepareRendererResources,
        pLogger,
        baseUrl = this->_url,
-       culture = this->_culture](
-          const std::byte* responseBuffer,
-          size_t responseSize) -> std::unique_ptr<RasterOverlayTileProvider> {
-    rapidjson::Document response;
-    response.Parse(reinterpret_cast<const char*>(responseBuffer), responseSize);
-
-    if (response.HasParseError()) {
-      SPDLOG_LOGGER_ERROR(
-          pLogger,
-          "Error when parsing Bing Maps imagery metadata, error code "
-          "{} at byte offset {}",
-          response.GetParseError(),
-          response.GetErrorOffset());
-      return nullptr;
+       culture = this->_culture](const BingMapsMetadata& metadata)
+      -> std::unique_ptr<RasterOverlayTileProvider> {
+    std::vector<CreditAndCoverageAreas> credits;
+    credits.reserve(metadata.attributions.size());
+    for (const BingMapsMetadata::Attribution& attribution :
+         metadata.attributions) {
+      credits.push_back(
+          {pCreditSystem->createCredit(attribution.html),
+           attribution.coverageAreas});
     }
-
-    rapidjson::Value* pResource =
-        rapidjson::Pointer("/resourceSets/0/resources/0").Get(response);
-    if (!pResource) {
-      SPDLOG_LOGGER_ERROR(
-          pLogger,
-          "Resources were not found in the Bing Maps imagery metadata "
-          "response.");
-      return nullptr;
-    }
-
-    uint32_t width =
-        JsonHelpers::getUint32OrDefault(*pResource, "imageWidth", 256U);
-    uint32_t height =
-        JsonHelpers::getUint32OrDefault(*pResource, "imageHeight", 256U);
-    uint32_t maximumLevel =
-        JsonHelpers::getUint32OrDefault(*pResource, "zoomMax", 30U);
-
-    std::vector<std::string> subdomains =
-        JsonHelpers::getStrings(*pResource, "imageUrlSubdomains");
-    std::string urlTemplate =
-        JsonHelpers::getStringOrDefault(*pResource, "imageUrl", std::string());
-    if (urlTemplate.empty()) {
-      SPDLOG_LOGGER_ERROR(
-          pLogger,
-          "Bing Maps tile imageUrl is missing or empty.");
-      return nullptr;
-    }
-
-    std::vector<CreditAndCoverageAreas> credits =
-        collectCredits(pResource, pCreditSystem);
     Credit bingCredit = pCreditSystem->createCredit(BING_LOGO_HTML);
 
     return std::make_unique<BingMapsTileProvider>(
@@ -407,29 +413,32 @@ BingMapsRasterOverlay::createTileProvider(
         asyncSystem,
         pAssetAccessor,
         bingCredit,
-        credits,
+        std::move(credits),
         pPrepareRendererResources,
         pLogger,
         baseUrl,
-        urlTemplate,
-        subdomains,
-        width,
-        height,
+        metadata.urlTemplate,
+        metadata.subdomains,
+        metadata.width,
+        metadata.height,
         0,
-        maximumLevel,
+        metadata.maximumLevel,
         culture);
   };
 
-  auto cacheResultIt = sessionCache.find(metadataUrl);
-  if (cacheResultIt != sessionCache.end()) {
-    return asyncSystem.createResolvedFuture(handleResponse(
-        cacheResultIt->second.data(),
-        cacheResultIt->second.size()));
+  const std::shared_ptr<RasterOverlayMetadataCache>& pMetadataCache =
+      this->getOptions().pMetadataCache;
+  if (pMetadataCache) {
+    std::shared_ptr<const BingMapsMetadata> pMetadata =
+        pMetadataCache->get<BingMapsMetadata>(metadataUrl);
+    if (pMetadata) {
+      return asyncSystem.createResolvedFuture(createProvider(*pMetadata));
+    }
   }
 
   return pAssetAccessor->requestAsset(asyncSystem, metadataUrl)
       .thenInMainThread(
-          [metadataUrl, pLogger, handleResponse](
+          [metadataUrl, pMetadataCache, pLogger, createProvider](
               const std::shared_ptr<IAssetRequest>& pRequest)
               -> std::unique_ptr<RasterOverlayTileProvider> {
             const IAssetResponse* pResponse = pRequest->response();
@@ -442,14 +451,17 @@ BingMapsRasterOverlay::createTileProvider(
               return nullptr;
             }
 
-            const std::byte* responseBuffer = pResponse->data().data();
-            const size_t responseSize = pResponse->data().size();
+            std::shared_ptr<const BingMapsMetadata> pMetadata =
+                parseMetadata(pResponse->data(), pLogger);
+            if (!pMetadata) {
+              return nullptr;
+            }
 
-            sessionCache[metadataUrl] = std::vector<std::byte>(
-                pResponse->data().begin(),
-                pResponse->data().end());
+            if (pMetadataCache) {
+              pMetadataCache->put(metadataUrl, pMetadata);
+            }
 
-            return handleResponse(responseBuffer, responseSize);
+            return createProvider(*pMetadata);
           });
 }
 
@@ -0,0 +1,283 @@
+#include "Cesium3DTilesSelection/FeatureIdIndex.h"
+
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/ExtensionMeshPrimitiveExtFeatureMetadata.h>
+#include <CesiumGltf/Model.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace CesiumGltf;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+struct FeatureRun {
+  int64_t featureId;
+  uint32_t begin;
+  uint32_t end;
+};
+
+// Extends the last run if the position continues it, or starts a new run.
+void addToRuns(
+    std::vector<FeatureRun>& runs,
+    int64_t featureId,
+    uint32_t position) {
+  if (!runs.empty() && runs.back().featureId == featureId &&
+      runs.back().end == position) {
+    ++runs.back().end;
+  } else {
+    runs.push_back(FeatureRun{featureId, position, position + 1});
+  }
+}
+
+int64_t getVertexCount(const Model& model, const MeshPrimitive& primitive) {
+  auto positionIt = primitive.attributes.find("POSITION");
+  if (positionIt == primitive.attributes.end()) {
+    return 0;
+  }
+
+  const Accessor* pPositions =
+      Model::getSafe(&model.accessors, positionIt->second);
+  return pPositions ? pPositions->count : 0;
+}
+
+// Gets the feature ID of each vertex, or an empty vector if the feature IDs
+// cannot be read.
+std::vector<int64_t> getVertexFeatureIds(
+    const Model& model,
+    const MeshPrimitive& primitive,
+    const FeatureIDs& featureIds) {
+  if (!featureIds.attribute) {
+    const int64_t vertexCount = getVertexCount(model, primitive);
+    std::vector<int64_t> result(static_cast<size_t>(vertexCount));
+    for (size_t i = 0; i < result.size(); ++i) {
+      result[i] = featureIds.divisor == 0
+                      ? featureIds.constant
+                      : featureIds.constant +
+                            static_cast<int64_t>(i) / featureIds.divisor;
+    }
+    return result;
+  }
+
+  auto attributeIt = primitive.attributes.find(*featureIds.attribute);
+  if (attributeIt == primitive.attributes.end()) {
+    return {};
+  }
+
+  return createAccessorView(
+      model,
+      attributeIt->second,
+      [](const auto& accessorView) {
+        std::vector<int64_t> result;
+        if (accessorView.status() != AccessorViewStatus::Valid) {
+          return result;
+        }
+
+        result.resize(static_cast<size_t>(accessorView.size()));
+        for (int64_t i = 0; i < accessorView.size(); ++i) {
+          result[static_cast<size_t>(i)] =
+              static_cast<int64_t>(accessorView[i].value[0]);
+        }
+        return result;
+      });
+}
+
+// Gets the runs of index accessor elements whose vertices belong to the same
+// feature.
+std::vector<FeatureRun> getIndexRuns(
+    const Model& model,
+    const MeshPrimitive& primitive,
+    const std::vector<int64_t>& vertexFeatureIds) {
+  if (primitive.indices < 0) {
+    return {};
+  }
+
+  return createAccessorView(
+      model,
+      primitive.indices,
+      [&vertexFeatureIds](const auto& accessorView) {
+        std::vector<FeatureRun> runs;
+        if (accessorView.status() != AccessorViewStatus::Valid ||
+            accessorView.size() > std::numeric_limits<uint32_t>::max()) {
+          return runs;
+        }
+
+        for (int64_t i = 0; i < accessorView.size(); ++i) {
+          const int64_t vertex = static_cast<int64_t>(accessorView[i].value[0]);
+          if (vertex >= 0 &&
+              static_cast<size_t>(vertex) < vertexFeatureIds.size()) {
+            addToRuns(
+                runs,
+                vertexFeatureIds[static_cast<size_t>(vertex)],
+                static_cast<uint32_t>(i));
+          }
+        }
+        return runs;
+      });
+}
+
+// Groups the runs by feature, so that the runs of each feature are
+// contiguous and remain sorted by position.
+void sortRuns(std::vector<FeatureRun>& runs) {
+  std::stable_sort(
+      runs.begin(),
+      runs.end(),
+      [](const FeatureRun& a, const FeatureRun& b) {
+        return a.featureId < b.featureId;
+      });
+}
+
+PrimitiveFeatureIdIndex createPrimitiveIndex(
+    const Model& model,
+    const MeshPrimitive& primitive,
+    const FeatureIDAttribute& attribute) {
+  PrimitiveFeatureIdIndex result;
+  result.featureTable = attribute.featureTable;
+
+  const std::vector<int64_t> vertexFeatureIds =
+      getVertexFeatureIds(model, primitive, attribute.featureIds);
+  if (vertexFeatureIds.size() > std::numeric_limits<uint32_t>::max()) {
+    return result;
+  }
+
+  std::vector<FeatureRun> vertexRuns;
+  for (size_t i = 0; i < vertexFeatureIds.size(); ++i) {
+    addToRuns(vertexRuns, vertexFeatureIds[i], static_cast<uint32_t>(i));
+  }
+  std::vector<FeatureRun> indexRuns =
+      getIndexRuns(model, primitive, vertexFeatureIds);
+
+  sortRuns(vertexRuns);
+  sortRuns(indexRuns);
+
+  result.vertexRanges.reserve(vertexRuns.size());
+  for (const FeatureRun& run : vertexRuns) {
+    if (result.featureIds.empty() ||
+        result.featureIds.back() != run.featureId) {
+      result.featureIds.push_back(run.featureId);
+      result.vertexRangeOffsets.push_back(
+          static_cast<uint32_t>(result.vertexRanges.size()));
+    }
+    result.vertexRanges.push_back(FeatureIdRange{run.begin, run.end});
+  }
+  result.vertexRangeOffsets.push_back(
+      static_cast<uint32_t>(result.vertexRanges.size()));
+
+  // Every index refers to a vertex, so the features of the index runs are a
+  // subset of the features of the vertex runs.
+  result.indexRanges.reserve(indexRuns.size());
+  result.indexRangeOffsets.reserve(result.featureIds.size() + 1);
+  size_t run = 0;
+  for (const int64_t featureId : result.featureIds) {
+    result.indexRangeOffsets.push_back(
+        static_cast<uint32_t>(result.indexRanges.size()));
+    for (; run < indexRuns.size() && indexRuns[run].featureId == featureId;
+         ++run) {
+      result.indexRanges.push_back(
+          FeatureIdRange{indexRuns[run].begin, indexRuns[run].end});
+    }
+  }
+  result.indexRangeOffsets.push_back(
+      static_cast<uint32_t>(result.indexRanges.size()));
+
+  result.featureIds.shrink_to_fit();
+  result.vertexRangeOffsets.shrink_to_fit();
+
+  return result;
+}
+
+template <typename T> int64_t getCapacityBytes(const std::vector<T>& vector) {
+  return static_cast<int64_t>(vector.capacity() * sizeof(T));
+}
+
+gsl::span<const FeatureIdRange> getRanges(
+    const std::vector<int64_t>& featureIds,
+    const std::vector<uint32_t>& offsets,
+    const std::vector<FeatureIdRange>& ranges,
+    int64_t featureId) noexcept {
+  auto it = std::lower_bound(featureIds.begin(), featureIds.end(), featureId);
+  if (it == featureIds.end() || *it != featureId) {
+    return {};
+  }
+
+  const size_t feature = static_cast<size_t>(it - featureIds.begin());
+  const uint32_t begin = offsets[feature];
+  const uint32_t end = offsets[feature + 1];
+  return gsl::span<const FeatureIdRange>(ranges.data() + begin, end - begin);
+}
+} // namespace
+
+gsl::span<const FeatureIdRange>
+PrimitiveFeatureIdIndex::getVertexRanges(int64_t featureId) const noexcept {
+  return getRanges(
+      this->featureIds,
+      this->vertexRangeOffsets,
+      this->vertexRanges,
+      featureId);
+}
+
+gsl::span<const FeatureIdRange>
+PrimitiveFeatureIdIndex::getIndexRanges(int64_t featureId) const noexcept {
+  return getRanges(
+      this->featureIds,
+      this->indexRangeOffsets,
+      this->indexRanges,
+      featureId);
+}
+
+/*static*/ FeatureIdIndex FeatureIdIndex::create(const Model& model) {
+  FeatureIdIndex result;
+
+  for (size_t i = 0; i < model.meshes.size(); ++i) {
+    const Mesh& mesh = model.meshes[i];
+    for (size_t j = 0; j < mesh.primitives.size(); ++j) {
+      const MeshPrimitive& primitive = mesh.primitives[j];
+      const ExtensionMeshPrimitiveExtFeatureMetadata* pMetadata =
+          primitive.getExtension<ExtensionMeshPrimitiveExtFeatureMetadata>();
+      if (!pMetadata) {
+        continue;
+      }
+
+      for (const FeatureIDAttribute& attribute :
+           pMetadata->featureIdAttributes) {
+        PrimitiveFeatureIdIndex& primitiveIndex =
+            result._primitives.emplace_back(
+                createPrimitiveIndex(model, primitive, attribute));
+        primitiveIndex.meshIndex = static_cast<int32_t>(i);
+        primitiveIndex.primitiveIndex = static_cast<int32_t>(j);
+      }
+    }
+  }
+
+  return result;
+}
+
+const PrimitiveFeatureIdIndex* FeatureIdIndex::findPrimitive(
+    int32_t meshIndex,
+    int32_t primitiveIndex,
+    const std::string& featureTable) const noexcept {
+  for (const PrimitiveFeatureIdIndex& primitive : this->_primitives) {
+    if (primitive.meshIndex == meshIndex &&
+        primitive.primitiveIndex == primitiveIndex &&
+        primitive.featureTable == featureTable) {
+      return &primitive;
+    }
+  }
+  return nullptr;
+}
+
+int64_t FeatureIdIndex::getSizeBytes() const noexcept {
+  int64_t bytes = getCapacityBytes(this->_primitives);
+  for (const PrimitiveFeatureIdIndex& primitive : this->_primitives) {
+    bytes += static_cast<int64_t>(primitive.featureTable.capacity());
+    bytes += getCapacityBytes(primitive.featureIds);
+    bytes += getCapacityBytes(primitive.vertexRangeOffsets);
+    bytes += getCapacityBytes(primitive.vertexRanges);
+    bytes += getCapacityBytes(primitive.indexRangeOffsets);
+    bytes += getCapacityBytes(primitive.indexRanges);
+  }
+  return bytes;
+}
+
+} // namespace Cesium3DTilesSelection
@@ -36,7 +36,8 @@ GltfContent::load(const TileContentLoadInput& input) {
       input.pRequest->url(),
       input.pRequest->headers(),
       input.pAssetAccessor,
-      input.pRequest->response()->data());
+      input.pRequest->response()->data(),
+      input.contentOptions);
 }
 
 /*static*/
@@ -46,11 +47,18 @@ Future<std::unique_ptr<TileContentLoadResult>> GltfContent::load(
     const std::string& url,
     const HttpHeaders& headers,
     const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
-    const gsl::span<const std::byte>& data) {
+    const gsl::span<const std::byte>& data,
+    const TilesetContentOptions& contentOptions) {
   CESIUM_TRACE("Cesium3DTilesSelection::GltfContent::load");
 
+  CesiumGltfReader::ReadModelOptions options;
+  options.decodeEmbeddedImages = contentOptions.decodeEmbeddedImages;
+  options.generateMipMaps = contentOptions.generateMipMaps;
+  options.ktx2TranscodeTargets = contentOptions.ktx2TranscodeTargets;
+  options.asyncSystem = asyncSystem;
+
   CesiumGltfReader::ModelReaderResult loadedModel =
-      GltfContent::_gltfReader.readModel(data);
+      GltfContent::_gltfReader.readModel(data, options);
   if (!loadedModel.errors.empty()) {
     SPDLOG_LOGGER_ERROR(
         pLogger,
@@ -75,7 +83,8 @@ Future<std::unique_ptr<TileContentLoadResult>> GltfContent::load(
              url,
              headers,
              pAssetAccessor,
-             std::move(loadedModel))
+             std::move(loadedModel),
+             contentOptions.ktx2TranscodeTargets)
       .thenInWorkerThread(
           [pLogger, url](CesiumGltfReader::ModelReaderResult&& resolvedModel) {
             std::unique_ptr<TileContentLoadResult> pResult =
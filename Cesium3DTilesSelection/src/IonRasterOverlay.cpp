@@ -1,6 +1,7 @@
 #include "Cesium3DTilesSelection/IonRasterOverlay.h"
 
 #include "Cesium3DTilesSelection/BingMapsRasterOverlay.h"
+#include "Cesium3DTilesSelection/RasterOverlayMetadataCache.h"
 #include "Cesium3DTilesSelection/RasterOverlayTile.h"
 #include "Cesium3DTilesSelection/RasterOverlayTileProvider.h"
 #include "Cesium3DTilesSelection/TileMapServiceRasterOverlay.h"
@@ -30,6 +31,106 @@ IonRasterOverlay::IonRasterOverlay(
 
 IonRasterOverlay::~IonRasterOverlay() {}
 
+namespace {
+
+/**
+ * @brief The parts of a Cesium ion asset endpoint response that are needed to
+ * create the overlay that it refers to.
+ */
+struct IonRasterOverlayEndpoint {
+  bool isBing;
+  std::string url;
+  std::string key;
+  std::string mapStyle;
+  std::string culture;
+  std::string accessToken;
+};
+
+std::shared_ptr<const IonRasterOverlayEndpoint> parseEndpoint(
+    const gsl::span<const std::byte>& data,
+    const std::shared_ptr<spdlog::logger>& pLogger) {
+  rapidjson::Document response;
+  response.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+
+  if (response.HasParseError()) {
+    SPDLOG_LOGGER_ERROR(
+        pLogger,
+        "Error when parsing ion raster overlay response, error code "
+        "{} at byte offset {}",
+        response.GetParseError(),
+        response.GetErrorOffset());
+    return nullptr;
+  }
+
+  std::string type =
+      JsonHelpers::getStringOrDefault(response, "type", "unknown");
+  if (type != "IMAGERY") {
+    SPDLOG_LOGGER_ERROR(
+        pLogger,
+        "Ion raster overlay metadata response type is not 'IMAGERY', "
+        "but {}",
+        type);
+    return nullptr;
+  }
+
+  auto pEndpoint = std::make_shared<IonRasterOverlayEndpoint>();
+
+  std::string externalType =
+      JsonHelpers::getStringOrDefault(response, "externalType", "unknown");
+  if (externalType == "BING") {
+    const auto optionsIt = response.FindMember("options");
+    if (optionsIt == response.MemberEnd() || !optionsIt->value.IsObject()) {
+      SPDLOG_LOGGER_ERROR(
+          pLogger,
+          "Cesium ion Bing Maps raster overlay metadata response "
+          "does not contain 'options' or it is not an object.");
+      return nullptr;
+    }
+
+    const auto& options = optionsIt->value;
+    pEndpoint->isBing = true;
+    pEndpoint->url = JsonHelpers::getStringOrDefault(options, "url", "");
+    pEndpoint->key = JsonHelpers::getStringOrDefault(options, "key", "");
+    pEndpoint->mapStyle =
+        JsonHelpers::getStringOrDefault(options, "mapStyle", "AERIAL");
+    pEndpoint->culture =
+        JsonHelpers::getStringOrDefault(options, "culture", "");
+  } else {
+    pEndpoint->isBing = false;
+    pEndpoint->url = JsonHelpers::getStringOrDefault(response, "url", "");
+    pEndpoint->accessToken =
+        JsonHelpers::getStringOrDefault(response, "accessToken", "");
+  }
+
+  return pEndpoint;
+}
+
+std::unique_ptr<RasterOverlay> createAggregatedOverlay(
+    const std::string& name,
+    const IonRasterOverlayEndpoint& endpoint,
+    const RasterOverlayOptions& overlayOptions) {
+  if (endpoint.isBing) {
+    return std::make_unique<BingMapsRasterOverlay>(
+        name,
+        endpoint.url,
+        endpoint.key,
+        endpoint.mapStyle,
+        endpoint.culture,
+        CesiumGeospatial::Ellipsoid::WGS84,
+        overlayOptions);
+  }
+
+  return std::make_unique<TileMapServiceRasterOverlay>(
+      name,
+      endpoint.url,
+      std::vector<CesiumAsync::IAssetAccessor::THeader>{
+          std::make_pair("Authorization", "Bearer " + endpoint.accessToken)},
+      TileMapServiceRasterOverlayOptions(),
+      overlayOptions);
+}
+
+} // namespace
+
 Future<std::unique_ptr<RasterOverlayTileProvider>>
 IonRasterOverlay::createTileProvider(
     const CesiumAsync::AsyncSystem& asyncSystem,
@@ -47,85 +148,57 @@ IonRasterOverlay::createTileProvider(
 
   pOwner = pOwner ? pOwner : this;
 
+  // The aggregated overlay shares this overlay's options, and so its metadata
+  // cache.
+  const std::shared_ptr<RasterOverlayMetadataCache>& pMetadataCache =
+      this->getOptions().pMetadataCache;
+  if (pMetadataCache) {
+    std::shared_ptr<const IonRasterOverlayEndpoint> pEndpoint =
+        pMetadataCache->get<IonRasterOverlayEndpoint>(ionUrl);
+    if (pEndpoint) {
+      std::unique_ptr<RasterOverlay> pAggregatedOverlay =
+          createAggregatedOverlay(
+              this->getName(),
+              *pEndpoint,
+              this->getOptions());
+      return pAggregatedOverlay->createTileProvider(
+          asyncSystem,
+          pAssetAccessor,
+          pCreditSystem,
+          pPrepareRendererResources,
+          pLogger,
+          pOwner);
+    }
+  }
+
   return pAssetAccessor->requestAsset(asyncSystem, ionUrl)
       .thenInWorkerThread(
           [name = this->getName(),
+           overlayOptions = this->getOptions(),
+           pMetadataCache,
+           ionUrl,
            pLogger](const std::shared_ptr<IAssetRequest>& pRequest)
               -> std::unique_ptr<RasterOverlay> {
             const IAssetResponse* pResponse = pRequest->response();
-
-            rapidjson::Document response;
-            response.Parse(
-                reinterpret_cast<const char*>(pResponse->data().data()),
-                pResponse->data().size());
-
-            if (response.HasParseError()) {
+            if (!pResponse) {
               SPDLOG_LOGGER_ERROR(
                   pLogger,
-                  "Error when parsing ion raster overlay response, error code "
-                  "{} at byte offset {}",
-                  response.GetParseError(),
-                  response.GetErrorOffset());
+                  "No response received from Cesium ion raster overlay "
+                  "endpoint.");
               return nullptr;
             }
 
-            std::string type =
-                JsonHelpers::getStringOrDefault(response, "type", "unknown");
-            if (type != "IMAGERY") {
-              SPDLOG_LOGGER_ERROR(
-                  pLogger,
-                  "Ion raster overlay metadata response type is not 'IMAGERY', "
-                  "but {}",
-                  type);
+            std::shared_ptr<const IonRasterOverlayEndpoint> pEndpoint =
+                parseEndpoint(pResponse->data(), pLogger);
+            if (!pEndpoint) {
               return nullptr;
             }
 
-            std::string externalType = JsonHelpers::getStringOrDefault(
-                response,
-                "externalType",
-                "unknown");
-            if (externalType == "BING") {
-              const auto optionsIt = response.FindMember("options");
-              if (optionsIt == response.MemberEnd() ||
-                  !optionsIt->value.IsObject()) {
-                SPDLOG_LOGGER_ERROR(
-                    pLogger,
-                    "Cesium ion Bing Maps raster overlay metadata response "
-                    "does not contain 'options' or it is not an object.");
-                return nullptr;
-              }
-
-              const auto& options = optionsIt->value;
-              std::string url =
-                  JsonHelpers::getStringOrDefault(options, "url", "");
-              std::string key =
-                  JsonHelpers::getStringOrDefault(options, "key", "");
-              std::string mapStyle = JsonHelpers::getStringOrDefault(
-                  options,
-                  "mapStyle",
-                  "AERIAL");
-              std::string culture =
-                  JsonHelpers::getStringOrDefault(options, "culture", "");
-
-              return std::make_unique<BingMapsRasterOverlay>(
-                  name,
-                  url,
-                  key,
-                  mapStyle,
-                  culture);
+            if (pMetadataCache) {
+              pMetadataCache->put(ionUrl, pEndpoint);
             }
-            std::string url =
-                JsonHelpers::getStringOrDefault(response, "url", "");
-            return std::make_unique<TileMapServiceRasterOverlay>(
-                name,
-                url,
-                std::vector<CesiumAsync::IAssetAccessor::THeader>{
-                    std::make_pair(
-                        "Authorization",
-                        "Bearer " + JsonHelpers::getStringOrDefault(
-                                        response,
-                                        "accessToken",
-                                        ""))});
+
+            return createAggregatedOverlay(name, *pEndpoint, overlayOptions);
           })
       .thenInMainThread(
           [asyncSystem,
@@ -1,5 +1,6 @@
 #include "Cesium3DTilesSelection/QuadtreeRasterOverlayTileProvider.h"
 
+#include "Cesium3DTilesSelection/IPrepareRendererResources.h"
 #include "Cesium3DTilesSelection/RasterOverlay.h"
 
 #include <CesiumGeometry/QuadtreeTilingScheme.h>
@@ -54,7 +55,33 @@ QuadtreeRasterOverlayTileProvider::QuadtreeRasterOverlayTileProvider(
       _tilingScheme(tilingScheme),
       _tilesOldToRecent(),
       _tileLookup(),
-      _cachedBytes(0) {}
+      _cachedBytes(0),
+      _pPageAtlas() {
+  const RasterOverlayOptions& options = owner.getOptions();
+  if (options.enablePageAtlas && imageWidth > 0 && imageHeight > 0) {
+    const uint32_t atlasSize = uint32_t(glm::max(options.pageAtlasSize, 0));
+    const uint32_t columns = atlasSize / imageWidth;
+    const uint32_t rows = atlasSize / imageHeight;
+    if (columns > 0 && rows > 0) {
+      this->_pPageAtlas = std::make_unique<RasterOverlayPageAtlas>(
+          imageWidth,
+          imageHeight,
+          columns,
+          rows);
+    }
+  }
+}
+
+QuadtreeRasterOverlayTileProvider::
+    ~QuadtreeRasterOverlayTileProvider() noexcept {
+  const std::shared_ptr<IPrepareRendererResources>& pPrepareRendererResources =
+      this->getPrepareRendererResources();
+  if (this->_pPageAtlas && pPrepareRendererResources) {
+    pPrepareRendererResources->freeRasterOverlayPageAtlas(
+        this->getOwner(),
+        *this->_pPageAtlas);
+  }
+}
 
 uint32_t QuadtreeRasterOverlayTileProvider::computeLevelFromTargetScreenPixels(
     const CesiumGeometry::Rectangle& rectangle,
@@ -99,7 +126,8 @@ std::vector<CesiumAsync::SharedFuture<
     QuadtreeRasterOverlayTileProvider::LoadedQuadtreeImage>>
 QuadtreeRasterOverlayTileProvider::mapRasterTilesToGeometryTile(
     const CesiumGeometry::Rectangle& geometryRectangle,
-    const glm::dvec2 targetScreenPixels) {
+    const glm::dvec2 targetScreenPixels,
+    std::vector<QuadtreeTileID>* pTileIDs) {
   std::vector<CesiumAsync::SharedFuture<LoadedQuadtreeImage>> result;
 
   const QuadtreeTilingScheme& imageryTilingScheme = this->getTilingScheme();
@@ -273,6 +301,9 @@ QuadtreeRasterOverlayTileProvider::mapRasterTilesToGeometryTile(
       CesiumAsync::SharedFuture<LoadedQuadtreeImage> pTile =
           this->getQuadtreeTile(QuadtreeTileID(level, i, j));
       result.emplace_back(std::move(pTile));
+      if (pTileIDs) {
+        pTileIDs->emplace_back(level, i, j);
+      }
     }
   }
 
@@ -309,7 +340,10 @@ QuadtreeRasterOverlayTileProvider::getQuadtreeTile(
         tileID.y >> 1);
     return this->getQuadtreeTile(parentID).thenImmediately(
         [rectangle](const LoadedQuadtreeImage& loaded) {
-          return LoadedQuadtreeImage{loaded.pLoaded, rectangle};
+          return LoadedQuadtreeImage{
+              loaded.pLoaded,
+              rectangle,
+              loaded.tileID};
         });
   };
 
@@ -322,6 +356,7 @@ QuadtreeRasterOverlayTileProvider::getQuadtreeTile(
             return result;
           })
           .thenImmediately([&cachedBytes = this->_cachedBytes,
+                            tileID,
                             currentLevel = tileID.level,
                             minimumLevel = this->getMinimumLevel(),
                             asyncSystem = this->getAsyncSystem(),
@@ -349,7 +384,8 @@ QuadtreeRasterOverlayTileProvider::getQuadtreeTile(
 
               return asyncSystem.createResolvedFuture(LoadedQuadtreeImage{
                   std::make_shared<LoadedRasterOverlayImage>(std::move(loaded)),
-                  std::nullopt});
+                  std::nullopt,
+                  tileID});
             }
 
             // Tile failed to load, try loading the parent tile instead.
@@ -361,7 +397,8 @@ QuadtreeRasterOverlayTileProvider::getQuadtreeTile(
               // No parent available, so return the original failed result.
               return asyncSystem.createResolvedFuture(LoadedQuadtreeImage{
                   std::make_shared<LoadedRasterOverlayImage>(std::move(loaded)),
-                  std::nullopt});
+                  std::nullopt,
+                  tileID});
             }
           });
 
@@ -444,48 +481,178 @@ QuadtreeRasterOverlayTileProvider::loadTileImage(
     RasterOverlayTile& overlayTile) {
   // Figure out which quadtree level we need, and which tiles from that level.
   // Load each needed tile (or pull it from cache).
+  std::vector<QuadtreeTileID> tileIDs;
   std::vector<CesiumAsync::SharedFuture<LoadedQuadtreeImage>> tiles =
       this->mapRasterTilesToGeometryTile(
           overlayTile.getRectangle(),
-          overlayTile.getTargetScreenPixels());
+          overlayTile.getTargetScreenPixels(),
+          this->_pPageAtlas ? &tileIDs : nullptr);
+
+  if (!this->_pPageAtlas) {
+    return this->getAsyncSystem()
+        .all(std::move(tiles))
+        .thenInWorkerThread([projection = this->getProjection(),
+                             rectangle = overlayTile.getRectangle()](
+                                std::vector<LoadedQuadtreeImage>&& images) {
+          return QuadtreeRasterOverlayTileProvider::combineUsefulImages(
+              rectangle,
+              projection,
+              std::move(images));
+        });
+  }
 
+  // Pages are allocated, and handed to the renderer, in the main thread.
   return this->getAsyncSystem()
       .all(std::move(tiles))
-      .thenInWorkerThread([projection = this->getProjection(),
-                           rectangle = overlayTile.getRectangle()](
-                              std::vector<LoadedQuadtreeImage>&& images) {
-        // This set of images is only "useful" if at least one actually has
-        // image data, and that image data is _not_ from an ancestor. We can
-        // identify ancestor images because they have a `subset`.
-        const bool haveAnyUsefulImageData = std::any_of(
-            images.begin(),
-            images.end(),
-            [](const LoadedQuadtreeImage& image) {
-              return image.pLoaded->image.has_value() &&
-                     !image.subset.has_value();
+      .thenInMainThread([this,
+                         tileIDs = std::move(tileIDs),
+                         projection = this->getProjection(),
+                         rectangle = overlayTile.getRectangle()](
+                            std::vector<LoadedQuadtreeImage>&& images) {
+        if (QuadtreeRasterOverlayTileProvider::haveAnyUsefulImageData(images)) {
+          std::optional<LoadedRasterOverlayImage> maybeWindow =
+              this->mapImagesToPageAtlas(tileIDs, images);
+          if (maybeWindow) {
+            return this->getAsyncSystem().createResolvedFuture(
+                std::move(*maybeWindow));
+          }
+        }
+
+        // Combine the images as usual if they can't be kept in the atlas.
+        return this->getAsyncSystem().runInWorkerThread(
+            [projection, rectangle, images = std::move(images)]() mutable {
+              return QuadtreeRasterOverlayTileProvider::combineUsefulImages(
+                  rectangle,
+                  projection,
+                  std::move(images));
             });
+      });
+}
 
-        if (!haveAnyUsefulImageData) {
-          // For non-useful sets of images, just return an empty image,
-          // signalling that the parent tile should be used instead.
-          // See https://github.com/CesiumGS/cesium-native/issues/316 for an
-          // edge case that is not yet handled.
-          return LoadedRasterOverlayImage{
-              ImageCesium(),
-              Rectangle(),
-              {},
-              {},
-              {},
-              false};
-        }
+std::optional<LoadedRasterOverlayImage>
+QuadtreeRasterOverlayTileProvider::mapImagesToPageAtlas(
+    const std::vector<QuadtreeTileID>& tileIDs,
+    const std::vector<LoadedQuadtreeImage>& images) {
+  assert(this->_pPageAtlas);
+  assert(tileIDs.size() == images.size());
+
+  if (tileIDs.empty()) {
+    return std::nullopt;
+  }
+
+  RasterOverlayPageAtlas& atlas = *this->_pPageAtlas;
+
+  // All tiles are from the same level.
+  QuadtreeTileID southwest = tileIDs.front();
+  QuadtreeTileID northeast = tileIDs.front();
+  for (const QuadtreeTileID& tileID : tileIDs) {
+    southwest.x = glm::min(southwest.x, tileID.x);
+    southwest.y = glm::min(southwest.y, tileID.y);
+    northeast.x = glm::max(northeast.x, tileID.x);
+    northeast.y = glm::max(northeast.y, tileID.y);
+  }
+
+  LoadedRasterOverlayImage result;
+  RasterOverlayPageTableWindow& window = result.pageTableWindow.emplace();
+  window.southwest = southwest;
+  window.columns = northeast.x - southwest.x + 1;
+  window.rows = northeast.y - southwest.y + 1;
+  window.rectangle =
+      this->getTilingScheme().tileToRectangle(southwest).computeUnion(
+          this->getTilingScheme().tileToRectangle(northeast));
+  window.pages.resize(size_t(window.columns) * size_t(window.rows));
+
+  result.rectangle = window.rectangle;
+  result.moreDetailAvailable = false;
 
-        return QuadtreeRasterOverlayTileProvider::combineImages(
-            rectangle,
-            projection,
-            std::move(images));
+  for (size_t i = 0; i < images.size(); ++i) {
+    const LoadedQuadtreeImage& image = images[i];
+    const LoadedRasterOverlayImage& loaded = *image.pLoaded;
+    if (!loaded.image || loaded.image->width <= 0 ||
+        loaded.image->height <= 0) {
+      continue;
+    }
+
+    std::shared_ptr<const RasterOverlayPageAtlas::Page> pPage =
+        atlas.find(image.tileID);
+    if (!pPage) {
+      const ImageCesium& pixels = *loaded.image;
+      if (uint32_t(pixels.width) != atlas.getPageWidth() ||
+          uint32_t(pixels.height) != atlas.getPageHeight() ||
+          pixels.channels != 4 || pixels.bytesPerChannel != 1) {
+        // This image doesn't fit in a page.
+        return std::nullopt;
+      }
+
+      pPage = atlas.allocate(image.tileID, loaded.rectangle);
+      if (!pPage) {
+        return std::nullopt;
+      }
+
+      const std::shared_ptr<IPrepareRendererResources>&
+          pPrepareRendererResources = this->getPrepareRendererResources();
+      if (pPrepareRendererResources) {
+        pPrepareRendererResources->updateRasterOverlayPage(
+            this->getOwner(),
+            atlas,
+            pPage->slot,
+            pixels);
+      }
+    }
+
+    const QuadtreeTileID& tileID = tileIDs[i];
+    const size_t cell = size_t(tileID.y - southwest.y) * window.columns +
+                        size_t(tileID.x - southwest.x);
+    window.pages[cell] = std::move(pPage);
+
+    result.moreDetailAvailable |= loaded.moreDetailAvailable;
+    result.credits.insert(
+        result.credits.end(),
+        loaded.credits.begin(),
+        loaded.credits.end());
+  }
+
+  return result;
+}
+
+/*static*/ bool QuadtreeRasterOverlayTileProvider::haveAnyUsefulImageData(
+    const std::vector<LoadedQuadtreeImage>& images) {
+  // This set of images is only "useful" if at least one actually has image
+  // data, and that image data is _not_ from an ancestor. We can identify
+  // ancestor images because they have a `subset`.
+  return std::any_of(
+      images.begin(),
+      images.end(),
+      [](const LoadedQuadtreeImage& image) {
+        return image.pLoaded->image.has_value() && !image.subset.has_value();
       });
 }
 
+/*static*/ LoadedRasterOverlayImage
+QuadtreeRasterOverlayTileProvider::combineUsefulImages(
+    const Rectangle& targetRectangle,
+    const Projection& projection,
+    std::vector<LoadedQuadtreeImage>&& images) {
+  if (!QuadtreeRasterOverlayTileProvider::haveAnyUsefulImageData(images)) {
+    // For non-useful sets of images, just return an empty image, signalling
+    // that the parent tile should be used instead.
+    // See https://github.com/CesiumGS/cesium-native/issues/316 for an edge
+    // case that is not yet handled.
+    return LoadedRasterOverlayImage{
+        ImageCesium(),
+        Rectangle(),
+        {},
+        {},
+        {},
+        false};
+  }
+
+  return QuadtreeRasterOverlayTileProvider::combineImages(
+      targetRectangle,
+      projection,
+      std::move(images));
+}
+
 void QuadtreeRasterOverlayTileProvider::unloadCachedTiles() {
   CESIUM_TRACE("QuadtreeRasterOverlayTileProvider::unloadCachedTiles");
 
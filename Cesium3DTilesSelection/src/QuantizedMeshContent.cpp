@@ -1172,6 +1172,12 @@ QuantizedMeshContent::load(const TileContentLoadInput& input) {
   pResult->updatedBoundingVolume =
       BoundingRegion(rectangle, minimumHeight, maximumHeight);
 
+  // Some tilesets leave the horizon occlusion point at the origin, which would
+  // mean that the tile is always below the horizon.
+  if (horizonOcclusionPoint != glm::dvec3(0.0)) {
+    pResult->horizonOcclusionPoint = horizonOcclusionPoint;
+  }
+
   if (pResult->model) {
     pResult->model.value().extras["Cesium3DTiles_TileUrl"] = url;
   }
@@ -0,0 +1,96 @@
+#include "Cesium3DTilesSelection/RasterOverlayMetadataCache.h"
+
+#include <utility>
+
+namespace Cesium3DTilesSelection {
+
+RasterOverlayMetadataCache::RasterOverlayMetadataCache(
+    const RasterOverlayMetadataCacheOptions& options)
+    : _options(options), _mutex(), _entries(), _entriesByKey() {}
+
+/*static*/ const std::shared_ptr<RasterOverlayMetadataCache>&
+RasterOverlayMetadataCache::getDefault() {
+  static const std::shared_ptr<RasterOverlayMetadataCache> pDefault =
+      std::make_shared<RasterOverlayMetadataCache>();
+  return pDefault;
+}
+
+void RasterOverlayMetadataCache::remove(const std::string& key) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+
+  auto it = this->_entriesByKey.find(key);
+  if (it != this->_entriesByKey.end()) {
+    this->_entries.erase(it->second);
+    this->_entriesByKey.erase(it);
+  }
+}
+
+void RasterOverlayMetadataCache::clear() {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->_entries.clear();
+  this->_entriesByKey.clear();
+}
+
+size_t RasterOverlayMetadataCache::size() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_entries.size();
+}
+
+std::shared_ptr<const void> RasterOverlayMetadataCache::getEntry(
+    const std::string& key,
+    std::type_index type) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+
+  auto it = this->_entriesByKey.find(key);
+  if (it == this->_entriesByKey.end()) {
+    return nullptr;
+  }
+
+  std::list<Entry>::iterator entryIt = it->second;
+  if (entryIt->expiresAt <= std::chrono::steady_clock::now()) {
+    this->_entries.erase(entryIt);
+    this->_entriesByKey.erase(it);
+    return nullptr;
+  }
+
+  if (entryIt->type != type) {
+    return nullptr;
+  }
+
+  this->_entries.splice(this->_entries.begin(), this->_entries, entryIt);
+  return entryIt->pValue;
+}
+
+void RasterOverlayMetadataCache::putEntry(
+    const std::string& key,
+    std::type_index type,
+    std::shared_ptr<const void>&& pValue) {
+  if (this->_options.maximumEntries == 0) {
+    return;
+  }
+
+  const std::chrono::steady_clock::time_point expiresAt =
+      std::chrono::steady_clock::now() + this->_options.timeToLive;
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+
+  auto it = this->_entriesByKey.find(key);
+  if (it != this->_entriesByKey.end()) {
+    std::list<Entry>::iterator entryIt = it->second;
+    entryIt->type = type;
+    entryIt->pValue = std::move(pValue);
+    entryIt->expiresAt = expiresAt;
+    this->_entries.splice(this->_entries.begin(), this->_entries, entryIt);
+    return;
+  }
+
+  while (this->_entries.size() >= this->_options.maximumEntries) {
+    this->_entriesByKey.erase(this->_entries.back().key);
+    this->_entries.pop_back();
+  }
+
+  this->_entries.push_front(Entry{key, type, std::move(pValue), expiresAt});
+  this->_entriesByKey.emplace(key, this->_entries.begin());
+}
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,71 @@
+#include "Cesium3DTilesSelection/RasterOverlayPageAtlas.h"
+
+#include <cassert>
+
+using namespace CesiumGeometry;
+
+namespace Cesium3DTilesSelection {
+
+RasterOverlayPageAtlas::RasterOverlayPageAtlas(
+    uint32_t pageWidth,
+    uint32_t pageHeight,
+    uint32_t columns,
+    uint32_t rows)
+    : _pageWidth(pageWidth),
+      _pageHeight(pageHeight),
+      _columns(columns),
+      _rows(rows),
+      _slots(size_t(columns) * size_t(rows), Slot{nullptr, 0}),
+      _lookup(),
+      _useCounter(0) {}
+
+std::shared_ptr<const RasterOverlayPageAtlas::Page>
+RasterOverlayPageAtlas::find(const QuadtreeTileID& tileID) noexcept {
+  auto it = this->_lookup.find(tileID);
+  if (it == this->_lookup.end()) {
+    return nullptr;
+  }
+
+  Slot& slot = this->_slots[it->second];
+  slot.lastUsed = ++this->_useCounter;
+  return slot.pPage;
+}
+
+std::shared_ptr<const RasterOverlayPageAtlas::Page>
+RasterOverlayPageAtlas::allocate(
+    const QuadtreeTileID& tileID,
+    const Rectangle& rectangle) {
+  assert(this->_lookup.find(tileID) == this->_lookup.end());
+
+  // Use a free slot if there is one, otherwise the least recently used slot
+  // whose page is only referenced by the atlas itself.
+  Slot* pBest = nullptr;
+  for (Slot& slot : this->_slots) {
+    if (!slot.pPage) {
+      pBest = &slot;
+      break;
+    }
+
+    if (slot.pPage.use_count() == 1 &&
+        (!pBest || slot.lastUsed < pBest->lastUsed)) {
+      pBest = &slot;
+    }
+  }
+
+  if (!pBest) {
+    return nullptr;
+  }
+
+  if (pBest->pPage) {
+    this->_lookup.erase(pBest->pPage->tileID);
+  }
+
+  const uint32_t index = static_cast<uint32_t>(pBest - this->_slots.data());
+  pBest->pPage = std::make_shared<Page>(Page{tileID, rectangle, index});
+  pBest->lastUsed = ++this->_useCounter;
+  this->_lookup.emplace(tileID, index);
+
+  return pBest->pPage;
+}
+
+} // namespace Cesium3DTilesSelection
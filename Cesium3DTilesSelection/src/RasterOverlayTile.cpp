@@ -20,6 +20,7 @@ RasterOverlayTile::RasterOverlayTile(RasterOverlay& overlay) noexcept
       _tileCredits(),
       _state(LoadState::Placeholder),
       _image(),
+      _pageTableWindow(),
       _pRendererResources(nullptr),
       _references(0),
       _moreDetailAvailable(MoreDetailAvailable::Unknown) {}
@@ -34,6 +35,7 @@ RasterOverlayTile::RasterOverlayTile(
       _tileCredits(),
       _state(LoadState::Unloaded),
       _image(),
+      _pageTableWindow(),
       _pRendererResources(nullptr),
       _references(0),
       _moreDetailAvailable(MoreDetailAvailable::Unknown) {}
@@ -9,6 +9,7 @@
 
 #include <CesiumAsync/IAssetResponse.h>
 #include <CesiumGltfReader/GltfReader.h>
+#include <CesiumGltfReader/ImageManipulation.h>
 #include <CesiumUtility/Tracing.h>
 #include <CesiumUtility/joinToString.h>
 
@@ -209,6 +210,7 @@ struct LoadResult {
   CesiumGltf::ImageCesium image = {};
   CesiumGeometry::Rectangle rectangle = {};
   std::vector<Credit> credits = {};
+  std::optional<RasterOverlayPageTableWindow> pageTableWindow = std::nullopt;
   void* pRendererResources = nullptr;
   bool moreDetailAvailable = true;
 };
@@ -223,21 +225,40 @@ struct LoadResult {
  * `LoadResult` with the state `RasterOverlayTile::LoadState::Failed` will be
  * returned.
  *
- * Otherwise, the image data will be passed to
- * `IPrepareRendererResources::prepareRasterInLoadThread`, and the function
- * will return a `LoadResult` with the image, the prepared renderer resources,
- * and the state `RasterOverlayTile::LoadState::Loaded`.
+ * If it contains a page table window, a `LoadResult` with the window and
+ * the state `RasterOverlayTile::LoadState::Loaded` will be returned. There is
+ * no image to prepare in this case.
+ *
+ * Otherwise, mip levels are generated if requested, and the image data will
+ * be passed to `IPrepareRendererResources::prepareRasterInLoadThread`, and the
+ * function will return a `LoadResult` with the image, the prepared renderer
+ * resources, and the state `RasterOverlayTile::LoadState::Loaded`.
  *
  * @param tileId The {@link TileID} - only used for logging
  * @param pPrepareRendererResources The `IPrepareRendererResources`
  * @param pLogger The logger
  * @param loadedImage The `LoadedRasterOverlayImage`
+ * @param generateMipMaps Whether to generate mip levels for the image
+ * @param compressedPixelFormat The block-compressed format to re-encode the
+ * image to, if any
  * @return The `LoadResult`
  */
 static LoadResult createLoadResultFromLoadedImage(
     const std::shared_ptr<IPrepareRendererResources>& pPrepareRendererResources,
     const std::shared_ptr<spdlog::logger>& pLogger,
-    LoadedRasterOverlayImage&& loadedImage) {
+    LoadedRasterOverlayImage&& loadedImage,
+    bool generateMipMaps,
+    CesiumGltf::GpuCompressedPixelFormat compressedPixelFormat) {
+  if (loadedImage.pageTableWindow) {
+    LoadResult result;
+    result.state = RasterOverlayTile::LoadState::Loaded;
+    result.rectangle = loadedImage.rectangle;
+    result.credits = std::move(loadedImage.credits);
+    result.pageTableWindow = std::move(loadedImage.pageTableWindow);
+    result.moreDetailAvailable = loadedImage.moreDetailAvailable;
+    return result;
+  }
+
   if (!loadedImage.image.has_value()) {
     SPDLOG_LOGGER_ERROR(
         pLogger,
@@ -266,10 +287,15 @@ static LoadResult createLoadResultFromLoadedImage(
       static_cast<int64_t>(image.width) * image.height * bytesPerPixel;
   if (image.width > 0 && image.height > 0 &&
       image.pixelData.size() >= static_cast<size_t>(requiredBytes)) {
-    CESIUM_TRACE(
-        "Prepare Raster " + std::to_string(image.width) + "x" +
-        std::to_string(image.height) + "x" + std::to_string(image.channels) +
-        "x" + std::to_string(image.bytesPerChannel));
+    CESIUM_TRACE("Prepare Raster");
+
+    if (generateMipMaps) {
+      ImageManipulation::generateMipMaps(image);
+    }
+
+    if (compressedPixelFormat != CesiumGltf::GpuCompressedPixelFormat::None) {
+      ImageManipulation::compressBlocks(image, compressedPixelFormat);
+    }
 
     void* pRendererResources = nullptr;
     if (pPrepareRendererResources) {
@@ -313,18 +339,24 @@ void RasterOverlayTileProvider::doLoad(
   this->loadTileImage(tile)
       .thenInWorkerThread(
           [pPrepareRendererResources = this->getPrepareRendererResources(),
-           pLogger =
-               this->getLogger()](LoadedRasterOverlayImage&& loadedImage) {
+           pLogger = this->getLogger(),
+           generateMipMaps = this->getOwner().getOptions().generateMipMaps,
+           compressedPixelFormat =
+               this->getOwner().getOptions().compressedPixelFormat](
+              LoadedRasterOverlayImage&& loadedImage) {
             return createLoadResultFromLoadedImage(
                 pPrepareRendererResources,
                 pLogger,
-                std::move(loadedImage));
+                std::move(loadedImage),
+                generateMipMaps,
+                compressedPixelFormat);
           })
       .thenInMainThread(
           [this, &tile, isThrottledLoad](LoadResult&& result) noexcept {
             tile._rectangle = result.rectangle;
             tile._pRendererResources = result.pRendererResources;
             tile._image = std::move(result.image);
+            tile._pageTableWindow = std::move(result.pageTableWindow);
             tile._tileCredits = std::move(result.credits);
             tile._moreDetailAvailable =
                 result.moreDetailAvailable
@@ -340,6 +372,7 @@ void RasterOverlayTileProvider::doLoad(
                              const std::exception& /*e*/) {
         tile._pRendererResources = nullptr;
         tile._image = {};
+        tile._pageTableWindow = std::nullopt;
         tile._tileCredits = {};
         tile._moreDetailAvailable = RasterOverlayTile::MoreDetailAvailable::No;
         tile.setState(RasterOverlayTile::LoadState::Failed);
@@ -1,16 +1,21 @@
 #include "Cesium3DTilesSelection/Tile.h"
 
+#include "Cesium3DTilesSelection/FeatureIdIndex.h"
 #include "Cesium3DTilesSelection/GltfContent.h"
 #include "Cesium3DTilesSelection/IPrepareRendererResources.h"
 #include "Cesium3DTilesSelection/TileContentFactory.h"
 #include "Cesium3DTilesSelection/Tileset.h"
 #include "CesiumGeometry/TileAvailabilityFlags.h"
+#include "TileContentCache.h"
 #include "TileUtilities.h"
+#include "TilesetMetrics.h"
 #include "upsampleGltfForRasterOverlays.h"
 
 #include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/HttpHeaders.h>
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/IDerivedDataCache.h>
 #include <CesiumAsync/ITaskProcessor.h>
 #include <CesiumGeometry/Axis.h>
 #include <CesiumGeometry/AxisTransforms.h>
@@ -20,6 +25,7 @@
 #include <CesiumUtility/JsonHelpers.h>
 #include <CesiumUtility/Tracing.h>
 
+#include <chrono>
 #include <cstddef>
 
 using namespace CesiumAsync;
@@ -36,6 +42,7 @@ Tile::Tile() noexcept
       _children(),
       _boundingVolume(OrientedBoundingBox(glm::dvec3(), glm::dmat3())),
       _viewerRequestVolume(),
+      _horizonOcclusionPoint(),
       _geometricError(0.0),
       _refine(TileRefine::Replace),
       _transform(1.0),
@@ -55,6 +62,7 @@ Tile::Tile(Tile&& rhs) noexcept
       _children(std::move(rhs._children)),
       _boundingVolume(rhs._boundingVolume),
       _viewerRequestVolume(rhs._viewerRequestVolume),
+      _horizonOcclusionPoint(rhs._horizonOcclusionPoint),
       _geometricError(rhs._geometricError),
       _refine(rhs._refine),
       _transform(rhs._transform),
@@ -74,6 +82,7 @@ Tile& Tile::operator=(Tile&& rhs) noexcept {
     this->_children = std::move(rhs._children);
     this->_boundingVolume = rhs._boundingVolume;
     this->_viewerRequestVolume = rhs._viewerRequestVolume;
+    this->_horizonOcclusionPoint = rhs._horizonOcclusionPoint;
     this->_geometricError = rhs._geometricError;
     this->_refine = rhs._refine;
     this->_transform = rhs._transform;
@@ -221,33 +230,31 @@ const BoundingVolume& getEffectiveContentBoundingVolume(
 }
 
 /**
- * @brief Called in a worker thread to prepare newly loaded or upsampled content
- * for use.
+ * @brief Called in a worker thread to process newly loaded or upsampled content
+ * before it is prepared for rendering.
  *
- * @param pPrepareRendererResources
  * @param pLogger
  * @param content
  * @param generateMissingNormalsSmooth
+ * @param createFeatureIdIndex
  * @param gltfUpAxis
  * @param tileTransform
  * @param contentBoundingVolume
  * @param boundingVolume
  * @param projections
- * @return The opaque pointer to the renderer resources as returned by
- * {@link IPrepareRendererResources::prepareInLoadThread}.
  */
-void* processNewTileContent(
-    const std::shared_ptr<IPrepareRendererResources>& pPrepareRendererResources,
+void processNewTileContent(
     const std::shared_ptr<spdlog::logger>& pLogger,
     TileContentLoadResult& content,
     bool generateMissingNormalsSmooth,
+    bool createFeatureIdIndex,
     CesiumGeometry::Axis gltfUpAxis,
     const glm::dmat4& tileTransform,
     const std::optional<BoundingVolume>& tileContentBoundingVolume,
     const BoundingVolume& tileBoundingVolume,
     std::vector<Projection>&& projections) {
   if (!content.model) {
-    return nullptr;
+    return;
   }
 
   CesiumGltf::Model& model = *content.model;
@@ -323,15 +330,32 @@ void* processNewTileContent(
     content.model->generateMissingNormalsSmooth();
   }
 
-  void* pRendererResources = nullptr;
+  if (createFeatureIdIndex) {
+    content.featureIdIndex = FeatureIdIndex::create(model);
+  }
+}
 
-  if (pPrepareRendererResources) {
-    CESIUM_TRACE("prepareInLoadThread");
-    pRendererResources =
-        pPrepareRendererResources->prepareInLoadThread(model, tileTransform);
+/**
+ * @brief Called in a worker thread to prepare processed content for rendering.
+ *
+ * @param pPrepareRendererResources
+ * @param content
+ * @param tileTransform
+ * @return The opaque pointer to the renderer resources as returned by
+ * {@link IPrepareRendererResources::prepareInLoadThread}.
+ */
+void* prepareNewTileContent(
+    const std::shared_ptr<IPrepareRendererResources>& pPrepareRendererResources,
+    TileContentLoadResult& content,
+    const glm::dmat4& tileTransform) {
+  if (!content.model || !pPrepareRendererResources) {
+    return nullptr;
   }
 
-  return pRendererResources;
+  CESIUM_TRACE("prepareInLoadThread");
+  return pPrepareRendererResources->prepareInLoadThread(
+      *content.model,
+      tileTransform);
 }
 
 } // namespace
@@ -387,13 +411,30 @@ void Tile::loadContent() {
 
   TileContentLoadInput loadInput(*this);
 
+  // The time the response is received, to measure how long the content waits
+  // for a worker thread.
+  const std::shared_ptr<TilesetMetrics>& pMetrics = tileset.getMetrics();
+  auto pResponseTime =
+      pMetrics ? std::make_shared<std::chrono::steady_clock::time_point>()
+               : nullptr;
+
   const CesiumGeometry::Axis gltfUpAxis = tileset.getGltfUpAxis();
   tileset.requestTileContent(*this)
+      .thenImmediately(
+          [pResponseTime](std::shared_ptr<IAssetRequest>&& pRequest) noexcept {
+            if (pResponseTime) {
+              *pResponseTime = std::chrono::steady_clock::now();
+            }
+            return std::move(pRequest);
+          })
       .thenInWorkerThread(
           [loadInput = std::move(loadInput),
+           pMetrics,
+           pResponseTime,
            asyncSystem = tileset.getAsyncSystem(),
            pLogger = tileset.getExternals().pLogger,
            pAssetAccessor = tileset.getExternals().pAssetAccessor,
+           pDerivedDataCache = tileset.getExternals().pDerivedDataCache,
            gltfUpAxis,
            projections = std::move(projections),
            generateMissingNormalsSmooth =
@@ -403,6 +444,11 @@ void Tile::loadContent() {
               std::shared_ptr<IAssetRequest>&& pRequest) mutable {
             CESIUM_TRACE("loadContent worker thread");
 
+            if (pMetrics) {
+              pMetrics->contentQueueWait.record(
+                  std::chrono::steady_clock::now() - *pResponseTime);
+            }
+
             const IAssetResponse* pResponse = pRequest->response();
             if (!pResponse) {
               SPDLOG_LOGGER_ERROR(
@@ -433,6 +479,55 @@ void Tile::loadContent() {
                   nullptr});
             }
 
+            // Processed content is cached by the ETag of its response, so
+            // an unchanged tile can skip decoding and processing entirely.
+            std::string cacheKey;
+            const HttpHeaders& responseHeaders = pResponse->headers();
+            HttpHeaders::const_iterator etagIt = responseHeaders.find("ETag");
+            if (pDerivedDataCache && etagIt != responseHeaders.end()) {
+              cacheKey = TileContentCache::getKey(
+                  pRequest->url(),
+                  etagIt->second,
+                  loadInput.contentOptions,
+                  projections,
+                  gltfUpAxis,
+                  loadInput.tileTransform,
+                  loadInput.tileBoundingVolume,
+                  loadInput.tileContentBoundingVolume);
+
+              std::unique_ptr<IDerivedDataEntry> pEntry =
+                  pDerivedDataCache->getEntry(cacheKey);
+              std::unique_ptr<TileContentLoadResult> pCachedContent =
+                  pEntry ? TileContentCache::read(
+                               pEntry->data(),
+                               std::vector<Projection>(projections))
+                         : nullptr;
+              if (pCachedContent) {
+                pCachedContent->httpStatusCode = pResponse->statusCode();
+
+                // The feature ID index is not cached, so create it again.
+                if (loadInput.contentOptions.createFeatureIdIndex) {
+                  pCachedContent->featureIdIndex =
+                      FeatureIdIndex::create(*pCachedContent->model);
+                }
+
+                const auto prepareStart = std::chrono::steady_clock::now();
+                void* pRendererResources = prepareNewTileContent(
+                    pPrepareRendererResources,
+                    *pCachedContent,
+                    loadInput.tileTransform);
+                if (pMetrics) {
+                  pMetrics->prepareInLoadThread.record(
+                      std::chrono::steady_clock::now() - prepareStart);
+                }
+
+                return asyncSystem.createResolvedFuture(LoadResult{
+                    LoadState::ContentLoaded,
+                    std::move(pCachedContent),
+                    pRendererResources});
+              }
+            }
+
             loadInput.asyncSystem = std::move(asyncSystem);
             loadInput.pLogger = std::move(pLogger);
             loadInput.pAssetAccessor = std::move(pAssetAccessor);
@@ -442,6 +537,10 @@ void Tile::loadContent() {
                 // Forward status code to the load result.
                 .thenInWorkerThread([statusCode = pResponse->statusCode(),
                                      loadInput = std::move(loadInput),
+                                     pMetrics = std::move(pMetrics),
+                                     pDerivedDataCache =
+                                         std::move(pDerivedDataCache),
+                                     cacheKey = std::move(cacheKey),
                                      gltfUpAxis,
                                      projections = std::move(projections),
                                      generateMissingNormalsSmooth,
@@ -461,16 +560,41 @@ void Tile::loadContent() {
                           nullptr};
                     }
 
-                    pRendererResources = processNewTileContent(
-                        pPrepareRendererResources,
+                    processNewTileContent(
                         loadInput.pLogger,
                         *pContent,
                         generateMissingNormalsSmooth,
+                        loadInput.contentOptions.createFeatureIdIndex,
                         gltfUpAxis,
                         loadInput.tileTransform,
                         loadInput.tileContentBoundingVolume,
                         loadInput.tileBoundingVolume,
                         std::move(projections));
+
+                    if (!cacheKey.empty()) {
+                      const auto cacheWriteStart =
+                          std::chrono::steady_clock::now();
+                      std::optional<std::vector<std::byte>> cachedContent =
+                          TileContentCache::write(*pContent);
+                      if (cachedContent) {
+                        pDerivedDataCache->storeEntry(cacheKey, *cachedContent);
+                      }
+                      if (pMetrics) {
+                        pMetrics->contentCacheWrite.record(
+                            std::chrono::steady_clock::now() -
+                            cacheWriteStart);
+                      }
+                    }
+
+                    const auto prepareStart = std::chrono::steady_clock::now();
+                    pRendererResources = prepareNewTileContent(
+                        pPrepareRendererResources,
+                        *pContent,
+                        loadInput.tileTransform);
+                    if (pMetrics) {
+                      pMetrics->prepareInLoadThread.record(
+                          std::chrono::steady_clock::now() - prepareStart);
+                    }
                   }
 
                   return LoadResult{
@@ -503,10 +627,18 @@ void Tile::processLoadedContent() {
 
   if (this->getState() == LoadState::ContentLoaded) {
     if (externals.pPrepareRendererResources) {
+      const auto prepareStart = std::chrono::steady_clock::now();
       this->_pRendererResources =
           externals.pPrepareRendererResources->prepareInMainThread(
               *this,
               this->getRendererResources());
+
+      const std::shared_ptr<TilesetMetrics>& pMetrics =
+          this->getTileset()->getMetrics();
+      if (pMetrics) {
+        pMetrics->prepareInMainThread.record(
+            std::chrono::steady_clock::now() - prepareStart);
+      }
     }
 
     if (this->_pContent) {
@@ -546,6 +678,10 @@ void Tile::processLoadedContent() {
         this->setBoundingVolume(this->_pContent->updatedBoundingVolume.value());
       }
 
+      if (this->_pContent->horizonOcclusionPoint) {
+        this->setHorizonOcclusionPoint(this->_pContent->horizonOcclusionPoint);
+      }
+
       if (this->getContext()->implicitContext) {
         ImplicitTilingContext& context = *this->getContext()->implicitContext;
         const QuadtreeTileID* pQuadtreeTileID =
@@ -913,6 +1049,10 @@ int64_t Tile::computeByteSize() const noexcept {
     }
   }
 
+  if (pContent && pContent->featureIdIndex) {
+    bytes += pContent->featureIdIndex->getSizeBytes();
+  }
+
   return bytes;
 }
 
@@ -963,6 +1103,8 @@ void Tile::upsampleParent(
            generateMissingNormalsSmooth =
                pTileset->getOptions()
                    .contentOptions.generateMissingNormalsSmooth,
+           createFeatureIdIndex =
+               pTileset->getOptions().contentOptions.createFeatureIdIndex,
            pLogger = pTileset->getExternals().pLogger,
            pPrepareRendererResources =
                pTileset->getExternals().pPrepareRendererResources]() mutable {
@@ -978,17 +1120,22 @@ void Tile::upsampleParent(
             pContent->updatedBoundingVolume =
                 GltfContent::computeBoundingRegion(*pContent->model, transform);
 
-            void* pRendererResources = processNewTileContent(
-                pPrepareRendererResources,
+            processNewTileContent(
                 pLogger,
                 *pContent,
                 generateMissingNormalsSmooth,
+                createFeatureIdIndex,
                 gltfUpAxis,
                 transform,
                 tileContentBoundingVolume,
                 tileBoundingVolume,
                 std::move(projections));
 
+            void* pRendererResources = prepareNewTileContent(
+                pPrepareRendererResources,
+                *pContent,
+                transform);
+
             return LoadResult{
                 LoadState::ContentLoaded,
                 std::move(pContent),
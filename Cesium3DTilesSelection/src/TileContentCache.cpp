@@ -0,0 +1,561 @@
+#include "TileContentCache.h"
+
+#include <CesiumGltfReader/GltfReader.h>
+#include <CesiumGltfWriter/Writer.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <variant>
+
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+const char contentMagic[4] = {'C', 'T', 'I', 'L'};
+const uint32_t contentVersion = 1;
+
+const uint32_t hasUpdatedBoundingVolume = 1;
+const uint32_t hasOverlayDetails = 2;
+
+/**
+ * @brief The header at the start of cached content.
+ *
+ * It is followed by two {@link CachedBoundingRegion}s, for the updated
+ * bounding volume and for the overlay details, the overlay rectangles, the
+ * lengths of the buffers, the {@link CachedImage}s, their mip positions and
+ * then the glTF JSON. The bytes of the buffers and of the images come last.
+ */
+struct CachedContentHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t flags;
+  uint32_t bufferCount;
+  uint32_t imageCount;
+  uint32_t mipPositionCount;
+  uint32_t rectangleCount;
+  uint32_t reserved;
+  uint64_t jsonByteLength;
+};
+
+struct CachedBoundingRegion {
+  double west;
+  double south;
+  double east;
+  double north;
+  double minimumHeight;
+  double maximumHeight;
+};
+
+struct CachedImage {
+  int32_t width;
+  int32_t height;
+  int32_t channels;
+  int32_t bytesPerChannel;
+  int32_t compressedPixelFormat;
+  uint32_t mipPositionCount;
+  uint64_t byteLength;
+};
+
+struct CachedMipPosition {
+  uint64_t byteOffset;
+  uint64_t byteSize;
+};
+
+static_assert(sizeof(CachedContentHeader) == 40, "Must not be padded");
+static_assert(sizeof(CachedBoundingRegion) == 48, "Must not be padded");
+static_assert(sizeof(Rectangle) == 32, "Must not be padded");
+static_assert(sizeof(CachedImage) == 32, "Must not be padded");
+static_assert(sizeof(CachedMipPosition) == 16, "Must not be padded");
+
+size_t alignTo8(size_t value) noexcept { return (value + 7) & ~size_t(7); }
+
+template <typename T>
+void append(std::vector<std::byte>& output, const T& value) {
+  const std::byte* pValue = reinterpret_cast<const std::byte*>(&value);
+  output.insert(output.end(), pValue, pValue + sizeof(T));
+}
+
+void appendAligned(
+    std::vector<std::byte>& output,
+    const gsl::span<const std::byte>& bytes) {
+  output.resize(alignTo8(output.size()));
+  output.insert(output.end(), bytes.begin(), bytes.end());
+}
+
+CachedBoundingRegion toCached(const BoundingRegion& region) noexcept {
+  const GlobeRectangle& rectangle = region.getRectangle();
+  return CachedBoundingRegion{
+      rectangle.getWest(),
+      rectangle.getSouth(),
+      rectangle.getEast(),
+      rectangle.getNorth(),
+      region.getMinimumHeight(),
+      region.getMaximumHeight()};
+}
+
+BoundingRegion fromCached(const CachedBoundingRegion& region) {
+  return BoundingRegion(
+      GlobeRectangle(region.west, region.south, region.east, region.north),
+      region.minimumHeight,
+      region.maximumHeight);
+}
+
+/**
+ * @brief Reads the fields of cached content in order, checking that each of
+ * them is within the data.
+ */
+class CachedContentReader {
+public:
+  explicit CachedContentReader(const gsl::span<const std::byte>& data) noexcept
+      : _data(data), _offset(0) {}
+
+  template <typename T> bool read(T& value) noexcept {
+    if (sizeof(T) > this->_data.size() - this->_offset) {
+      return false;
+    }
+    std::memcpy(&value, this->_data.data() + this->_offset, sizeof(T));
+    this->_offset += sizeof(T);
+    return true;
+  }
+
+  template <typename T> bool read(uint64_t count, std::vector<T>& values) {
+    if (count > (this->_data.size() - this->_offset) / sizeof(T)) {
+      return false;
+    }
+    values.resize(static_cast<size_t>(count));
+    if (!values.empty()) {
+      std::memcpy(
+          values.data(),
+          this->_data.data() + this->_offset,
+          values.size() * sizeof(T));
+    }
+    this->_offset += values.size() * sizeof(T);
+    return true;
+  }
+
+  bool readAligned(uint64_t length, gsl::span<const std::byte>& bytes) {
+    this->_offset = alignTo8(this->_offset);
+    if (this->_offset > this->_data.size() ||
+        length > this->_data.size() - this->_offset) {
+      return false;
+    }
+    bytes = this->_data.subspan(this->_offset, static_cast<size_t>(length));
+    this->_offset += static_cast<size_t>(length);
+    return true;
+  }
+
+private:
+  gsl::span<const std::byte> _data;
+  size_t _offset;
+};
+
+// Gets the size in bytes of an uncompressed image level, or std::nullopt if it
+// does not fit in 64 bits.
+std::optional<uint64_t> computeLevelByteSize(
+    uint64_t width,
+    uint64_t height,
+    uint64_t bytesPerPixel) noexcept {
+  const uint64_t max = std::numeric_limits<uint64_t>::max();
+  if (width != 0 && height > max / width) {
+    return std::nullopt;
+  }
+  const uint64_t pixelCount = width * height;
+  if (bytesPerPixel != 0 && pixelCount > max / bytesPerPixel) {
+    return std::nullopt;
+  }
+  return pixelCount * bytesPerPixel;
+}
+
+/**
+ * @brief Checks that the mip positions of a cached image lie within its pixel
+ * data and, if the image is not compressed, that its dimensions agree with the
+ * size of its pixel data and of each mip level.
+ */
+bool isConsistent(
+    const CachedImage& image,
+    const gsl::span<const CachedMipPosition>& mips) noexcept {
+  if (image.width < 0 || image.height < 0 || image.channels < 0 ||
+      image.bytesPerChannel < 0) {
+    return false;
+  }
+
+  for (const CachedMipPosition& mip : mips) {
+    if (mip.byteOffset > image.byteLength ||
+        mip.byteSize > image.byteLength - mip.byteOffset) {
+      return false;
+    }
+  }
+
+  if (image.compressedPixelFormat !=
+      static_cast<int32_t>(GpuCompressedPixelFormat::None)) {
+    return true;
+  }
+
+  const uint64_t bytesPerPixel =
+      uint64_t(image.channels) * uint64_t(image.bytesPerChannel);
+  uint64_t width = uint64_t(image.width);
+  uint64_t height = uint64_t(image.height);
+
+  if (mips.empty()) {
+    const std::optional<uint64_t> byteSize =
+        computeLevelByteSize(width, height, bytesPerPixel);
+    return byteSize && *byteSize == image.byteLength;
+  }
+
+  for (const CachedMipPosition& mip : mips) {
+    const std::optional<uint64_t> byteSize =
+        computeLevelByteSize(width, height, bytesPerPixel);
+    if (!byteSize || *byteSize != mip.byteSize) {
+      return false;
+    }
+    width = std::max(width / 2, uint64_t(1));
+    height = std::max(height / 2, uint64_t(1));
+  }
+
+  return true;
+}
+
+void appendHex(std::string& key, uint64_t value) {
+  static const char digits[] = "0123456789abcdef";
+  for (int shift = 60; shift >= 0; shift -= 4) {
+    key += digits[(value >> shift) & 0xf];
+  }
+}
+
+// Appends the exact bits of a double, so that keys never differ or collide
+// due to rounding.
+void appendDouble(std::string& key, double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  appendHex(key, bits);
+}
+
+// Appends the parts of a bounding volume that the processing of the content
+// depends on: its type, and the rectangle of a bounding region.
+void appendBoundingVolume(std::string& key, const BoundingVolume& volume) {
+  key += ' ';
+  key += std::to_string(volume.index());
+
+  const BoundingRegion* pRegion = getBoundingRegionFromBoundingVolume(volume);
+  if (pRegion) {
+    const GlobeRectangle& rectangle = pRegion->getRectangle();
+    appendDouble(key, rectangle.getWest());
+    appendDouble(key, rectangle.getSouth());
+    appendDouble(key, rectangle.getEast());
+    appendDouble(key, rectangle.getNorth());
+  }
+}
+
+const CesiumGltfReader::GltfReader& getGltfReader() {
+  static const CesiumGltfReader::GltfReader reader;
+  return reader;
+}
+} // namespace
+
+namespace TileContentCache {
+
+std::string getKey(
+    const std::string& url,
+    const std::string& etag,
+    const TilesetContentOptions& contentOptions,
+    const std::vector<Projection>& projections,
+    CesiumGeometry::Axis gltfUpAxis,
+    const glm::dmat4& tileTransform,
+    const BoundingVolume& tileBoundingVolume,
+    const std::optional<BoundingVolume>& tileContentBoundingVolume) {
+  std::string key = "tile-content:" + std::to_string(contentVersion) + ":" +
+                    url + " " + etag + " ";
+
+  const CesiumGltfReader::Ktx2TranscodeTargets& ktx2 =
+      contentOptions.ktx2TranscodeTargets;
+  for (const bool option :
+       {contentOptions.enableWaterMask,
+        contentOptions.generateMissingNormalsSmooth,
+        contentOptions.decodeEmbeddedImages,
+        contentOptions.generateMipMaps,
+        ktx2.etc2Rgb,
+        ktx2.etc2Rgba,
+        ktx2.bc1Rgb,
+        ktx2.bc3Rgba,
+        ktx2.bc4R,
+        ktx2.bc5Rg,
+        ktx2.bc7Rgba,
+        ktx2.astc4x4Rgba}) {
+    key += option ? '1' : '0';
+  }
+
+  key += ' ';
+  key += std::to_string(static_cast<int>(gltfUpAxis));
+
+  key += ' ';
+  for (glm::length_t column = 0; column < 4; ++column) {
+    for (glm::length_t row = 0; row < 4; ++row) {
+      appendDouble(key, tileTransform[column][row]);
+    }
+  }
+
+  appendBoundingVolume(key, tileBoundingVolume);
+  if (tileContentBoundingVolume) {
+    appendBoundingVolume(key, *tileContentBoundingVolume);
+  }
+
+  for (const Projection& projection : projections) {
+    key += ' ';
+    key += std::to_string(projection.index());
+    const glm::dvec3& radii = std::visit(
+        [](const auto& p) -> const glm::dvec3& {
+          return p.getEllipsoid().getRadii();
+        },
+        projection);
+    appendDouble(key, radii.x);
+    appendDouble(key, radii.y);
+    appendDouble(key, radii.z);
+  }
+
+  return key;
+}
+
+std::optional<std::vector<std::byte>>
+write(const TileContentLoadResult& content) {
+  if (!content.model || content.childTiles ||
+      !content.newTileContexts.empty() ||
+      content.updatedContentBoundingVolume || content.horizonOcclusionPoint ||
+      !content.availableTileRectangles.empty()) {
+    return std::nullopt;
+  }
+
+  const BoundingRegion* pUpdatedRegion = nullptr;
+  if (content.updatedBoundingVolume) {
+    pUpdatedRegion =
+        std::get_if<BoundingRegion>(&content.updatedBoundingVolume.value());
+    if (!pUpdatedRegion) {
+      return std::nullopt;
+    }
+  }
+
+  const Model& model = *content.model;
+
+  // Buffers and images without a URI are not written to the JSON, so only
+  // their bytes need to be stored next to it.
+  CesiumGltfWriter::WriteModelOptions options;
+  options.exportType = CesiumGltfWriter::GltfExportType::GLTF;
+  const CesiumGltfWriter::WriteModelResult json =
+      CesiumGltfWriter::writeModelAsEmbeddedBytes(model, options);
+  if (!json.errors.empty()) {
+    return std::nullopt;
+  }
+
+  size_t mipPositionCount = 0;
+  size_t byteLength = 0;
+  for (const Buffer& buffer : model.buffers) {
+    byteLength += alignTo8(buffer.cesium.data.size());
+  }
+  for (const Image& image : model.images) {
+    mipPositionCount += image.cesium.mipPositions.size();
+    byteLength += alignTo8(image.cesium.pixelData.size());
+  }
+
+  const std::optional<TileContentDetailsForOverlays>& overlayDetails =
+      content.overlayDetails;
+
+  CachedContentHeader header{};
+  std::memcpy(header.magic, contentMagic, sizeof(contentMagic));
+  header.version = contentVersion;
+  header.flags = (pUpdatedRegion ? hasUpdatedBoundingVolume : 0U) |
+                 (overlayDetails ? hasOverlayDetails : 0U);
+  header.bufferCount = static_cast<uint32_t>(model.buffers.size());
+  header.imageCount = static_cast<uint32_t>(model.images.size());
+  header.mipPositionCount = static_cast<uint32_t>(mipPositionCount);
+  header.rectangleCount =
+      overlayDetails ? static_cast<uint32_t>(
+                           overlayDetails->rasterOverlayRectangles.size())
+                     : 0U;
+  header.jsonByteLength = json.gltfAssetBytes.size();
+
+  std::vector<std::byte> result;
+  result.reserve(
+      sizeof(CachedContentHeader) + 2 * sizeof(CachedBoundingRegion) +
+      header.rectangleCount * sizeof(Rectangle) +
+      header.bufferCount * sizeof(uint64_t) +
+      header.imageCount * sizeof(CachedImage) +
+      mipPositionCount * sizeof(CachedMipPosition) +
+      alignTo8(json.gltfAssetBytes.size()) + byteLength);
+
+  append(result, header);
+  append(
+      result,
+      pUpdatedRegion ? toCached(*pUpdatedRegion) : CachedBoundingRegion{});
+  append(
+      result,
+      overlayDetails ? toCached(overlayDetails->boundingRegion)
+                     : CachedBoundingRegion{});
+
+  if (overlayDetails) {
+    for (const Rectangle& rectangle :
+         overlayDetails->rasterOverlayRectangles) {
+      append(result, rectangle);
+    }
+  }
+
+  for (const Buffer& buffer : model.buffers) {
+    append(result, uint64_t(buffer.cesium.data.size()));
+  }
+
+  for (const Image& image : model.images) {
+    const ImageCesium& pixels = image.cesium;
+    append(
+        result,
+        CachedImage{
+            pixels.width,
+            pixels.height,
+            pixels.channels,
+            pixels.bytesPerChannel,
+            static_cast<int32_t>(pixels.compressedPixelFormat),
+            static_cast<uint32_t>(pixels.mipPositions.size()),
+            pixels.pixelData.size()});
+  }
+
+  for (const Image& image : model.images) {
+    for (const ImageCesiumMipPosition& mip : image.cesium.mipPositions) {
+      append(result, CachedMipPosition{mip.byteOffset, mip.byteSize});
+    }
+  }
+
+  result.insert(
+      result.end(),
+      json.gltfAssetBytes.begin(),
+      json.gltfAssetBytes.end());
+
+  for (const Buffer& buffer : model.buffers) {
+    appendAligned(result, buffer.cesium.data);
+  }
+
+  for (const Image& image : model.images) {
+    appendAligned(result, image.cesium.pixelData);
+  }
+
+  return result;
+}
+
+std::unique_ptr<TileContentLoadResult> read(
+    const gsl::span<const std::byte>& data,
+    std::vector<Projection>&& projections) {
+  CachedContentReader reader(data);
+
+  CachedContentHeader header;
+  if (!reader.read(header) ||
+      std::memcmp(header.magic, contentMagic, sizeof(contentMagic)) != 0 ||
+      header.version != contentVersion) {
+    return nullptr;
+  }
+
+  const bool withOverlayDetails = (header.flags & hasOverlayDetails) != 0;
+  if (withOverlayDetails && header.rectangleCount != projections.size()) {
+    return nullptr;
+  }
+
+  CachedBoundingRegion updatedRegion;
+  CachedBoundingRegion overlayRegion;
+  std::vector<Rectangle> rectangles;
+  std::vector<uint64_t> bufferLengths;
+  std::vector<CachedImage> images;
+  std::vector<CachedMipPosition> mipPositions;
+  gsl::span<const std::byte> json;
+  if (!reader.read(updatedRegion) || !reader.read(overlayRegion) ||
+      !reader.read(header.rectangleCount, rectangles) ||
+      !reader.read(header.bufferCount, bufferLengths) ||
+      !reader.read(header.imageCount, images) ||
+      !reader.read(header.mipPositionCount, mipPositions) ||
+      !reader.readAligned(header.jsonByteLength, json)) {
+    return nullptr;
+  }
+
+  // The JSON describes content that was already decoded, so only parse it.
+  CesiumGltfReader::ReadModelOptions options;
+  options.decodeDataUrls = false;
+  options.decodeEmbeddedImages = false;
+  options.decodeDraco = false;
+  options.decodeMeshopt = false;
+  CesiumGltfReader::ModelReaderResult readResult =
+      getGltfReader().readModel(json, options);
+  if (!readResult.model ||
+      readResult.model->buffers.size() != bufferLengths.size() ||
+      readResult.model->images.size() != images.size()) {
+    return nullptr;
+  }
+
+  Model& model = *readResult.model;
+
+  for (size_t i = 0; i < bufferLengths.size(); ++i) {
+    gsl::span<const std::byte> bytes;
+    if (!reader.readAligned(bufferLengths[i], bytes)) {
+      return nullptr;
+    }
+
+    Buffer& buffer = model.buffers[i];
+    buffer.cesium.data.assign(bytes.begin(), bytes.end());
+    buffer.byteLength = static_cast<int64_t>(bytes.size());
+  }
+
+  size_t mipPosition = 0;
+  for (size_t i = 0; i < images.size(); ++i) {
+    const CachedImage& cachedImage = images[i];
+    gsl::span<const std::byte> bytes;
+    if (!reader.readAligned(cachedImage.byteLength, bytes) ||
+        cachedImage.mipPositionCount > mipPositions.size() - mipPosition ||
+        cachedImage.compressedPixelFormat < 0 ||
+        cachedImage.compressedPixelFormat >
+            static_cast<int32_t>(GpuCompressedPixelFormat::Astc4x4Rgba)) {
+      return nullptr;
+    }
+
+    const gsl::span<const CachedMipPosition> mips(
+        mipPositions.data() + mipPosition,
+        cachedImage.mipPositionCount);
+    if (!isConsistent(cachedImage, mips)) {
+      return nullptr;
+    }
+
+    ImageCesium& pixels = model.images[i].cesium;
+    pixels.width = cachedImage.width;
+    pixels.height = cachedImage.height;
+    pixels.channels = cachedImage.channels;
+    pixels.bytesPerChannel = cachedImage.bytesPerChannel;
+    pixels.compressedPixelFormat =
+        GpuCompressedPixelFormat(cachedImage.compressedPixelFormat);
+    pixels.pixelData.assign(bytes.begin(), bytes.end());
+
+    pixels.mipPositions.reserve(mips.size());
+    for (const CachedMipPosition& mip : mips) {
+      pixels.mipPositions.push_back(ImageCesiumMipPosition{
+          static_cast<size_t>(mip.byteOffset),
+          static_cast<size_t>(mip.byteSize)});
+    }
+    mipPosition += mips.size();
+  }
+
+  auto pContent = std::make_unique<TileContentLoadResult>();
+  pContent->model = std::move(model);
+
+  if ((header.flags & hasUpdatedBoundingVolume) != 0) {
+    pContent->updatedBoundingVolume = fromCached(updatedRegion);
+  }
+
+  if (withOverlayDetails) {
+    pContent->overlayDetails = TileContentDetailsForOverlays{
+        std::move(projections),
+        std::move(rectangles),
+        fromCached(overlayRegion)};
+  }
+
+  return pContent;
+}
+
+} // namespace TileContentCache
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Cesium3DTilesSelection/BoundingVolume.h"
+#include "Cesium3DTilesSelection/TileContentLoadResult.h"
+#include "Cesium3DTilesSelection/TilesetOptions.h"
+
+#include <CesiumGeometry/Axis.h>
+#include <CesiumGeospatial/Projection.h>
+
+#include <glm/mat4x4.hpp>
+#include <gsl/span>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief Stores the processed content of tiles in a
+ * {@link CesiumAsync::IDerivedDataCache}, so that a tile that was loaded
+ * before does not need to be decoded and processed again.
+ *
+ * The cached form holds the {@link TileContentLoadResult} as it is after
+ * {@link TileContentFactory::createContent} and the processing that follows
+ * it in the worker thread, including raster overlay texture coordinates and
+ * generated normals. The glTF JSON is stored as written by the glTF writer,
+ * while the buffers and the decoded images are stored as raw bytes, each
+ * starting at a multiple of 8 bytes, so reading an entry only parses the JSON
+ * and copies the bytes.
+ *
+ * Only content that is a single glTF model is cached. Content with child
+ * tiles, quantized-mesh availability or a horizon occlusion point is always
+ * loaded from the response.
+ */
+namespace TileContentCache {
+
+/**
+ * @brief Gets the key of a tile's content in the cache.
+ *
+ * Besides the URL and the ETag of the content, the key includes everything
+ * else that the processed content depends on, so a change to any of them
+ * leads to a cache miss rather than to stale content.
+ *
+ * @param url The URL of the content.
+ * @param etag The ETag of the response that the content was loaded from.
+ * @param contentOptions The options that the content was created with.
+ * @param projections The projections of the raster overlays for which texture
+ * coordinates were generated.
+ * @param gltfUpAxis The up axis of glTF content in the tileset.
+ * @param tileTransform The transform of the tile.
+ * @param tileBoundingVolume The bounding volume of the tile.
+ * @param tileContentBoundingVolume The bounding volume of the tile's content,
+ * if it has one.
+ */
+std::string getKey(
+    const std::string& url,
+    const std::string& etag,
+    const TilesetContentOptions& contentOptions,
+    const std::vector<CesiumGeospatial::Projection>& projections,
+    CesiumGeometry::Axis gltfUpAxis,
+    const glm::dmat4& tileTransform,
+    const BoundingVolume& tileBoundingVolume,
+    const std::optional<BoundingVolume>& tileContentBoundingVolume);
+
+/**
+ * @brief Writes processed content in the cached form.
+ *
+ * @return The cached form, or `std::nullopt` if this kind of content is not
+ * cached or its model cannot be written.
+ */
+std::optional<std::vector<std::byte>>
+write(const TileContentLoadResult& content);
+
+/**
+ * @brief Reads processed content from the cached form.
+ *
+ * @param data The cached form, as written by {@link write}.
+ * @param projections The projections that were used in the key of the entry.
+ * They become the raster overlay projections of the
+ * {@link TileContentLoadResult::overlayDetails}.
+ * @return The content, or `nullptr` if the data is not content written by
+ * this version of {@link write}, or if its images are inconsistent, such as
+ * a mip level outside of the pixel data or dimensions that do not match the
+ * size of uncompressed pixels.
+ */
+std::unique_ptr<TileContentLoadResult> read(
+    const gsl::span<const std::byte>& data,
+    std::vector<CesiumGeospatial::Projection>&& projections);
+
+} // namespace TileContentCache
+
+} // namespace Cesium3DTilesSelection
@@ -1,14 +1,45 @@
 #include "Cesium3DTilesSelection/TileContentFactory.h"
 
 #include "Cesium3DTilesSelection/spdlog-cesium.h"
+#include "TilesetMetrics.h"
 
 #include <CesiumAsync/IAssetResponse.h>
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 
 namespace Cesium3DTilesSelection {
 
+namespace {
+/**
+ * @brief Loads content with a loader and, if the input has metrics, records
+ * how long the loader takes to return, labeled with the magic or content type
+ * that selected the loader.
+ *
+ * Only the synchronous part of the load is measured. Loaders parse and decode
+ * the response before they return, while the work that they chain onto the
+ * returned future, such as requesting external buffers and images, would
+ * mostly measure network time.
+ */
+CesiumAsync::Future<std::unique_ptr<TileContentLoadResult>> loadAndMeasure(
+    TileContentLoader& loader,
+    const TileContentLoadInput& input,
+    const std::string& contentType) {
+  if (!input.pMetrics) {
+    return loader.load(input);
+  }
+
+  CesiumUtility::LatencyHistogram& decodeTime =
+      input.pMetrics->getDecodeTime(contentType);
+  const auto start = std::chrono::steady_clock::now();
+  CesiumAsync::Future<std::unique_ptr<TileContentLoadResult>> result =
+      loader.load(input);
+  decodeTime.record(std::chrono::steady_clock::now() - start);
+  return result;
+}
+} // namespace
+
 void TileContentFactory::registerMagic(
     const std::string& magic,
     const std::shared_ptr<TileContentLoader>& pLoader) {
@@ -40,7 +71,7 @@ TileContentFactory::createContent(const TileContentLoadInput& input) {
 
   auto itMagic = TileContentFactory::_loadersByMagic.find(magic);
   if (itMagic != TileContentFactory::_loadersByMagic.end()) {
-    return itMagic->second->load(input);
+    return loadAndMeasure(*itMagic->second, input, magic);
   }
 
   const std::string& contentType = input.pRequest->response()->contentType();
@@ -55,7 +86,7 @@ TileContentFactory::createContent(const TileContentLoadInput& input) {
   auto itContentType =
       TileContentFactory::_loadersByContentType.find(baseContentType);
   if (itContentType != TileContentFactory::_loadersByContentType.end()) {
-    return itContentType->second->load(input);
+    return loadAndMeasure(*itContentType->second, input, baseContentType);
   }
 
   // Determine if this is plausibly a JSON external tileset.
@@ -70,7 +101,7 @@ TileContentFactory::createContent(const TileContentLoadInput& input) {
     // Might be an external tileset, try loading it that way.
     itMagic = TileContentFactory::_loadersByMagic.find("json");
     if (itMagic != TileContentFactory::_loadersByMagic.end()) {
-      return itMagic->second->load(input);
+      return loadAndMeasure(*itMagic->second, input, "json");
     }
   }
 
@@ -85,6 +116,20 @@ TileContentFactory::createContent(const TileContentLoadInput& input) {
       .createResolvedFuture<std::unique_ptr<TileContentLoadResult>>(nullptr);
 }
 
+std::vector<std::string> TileContentFactory::getRegisteredTypes() {
+  std::vector<std::string> result;
+  result.reserve(
+      TileContentFactory::_loadersByMagic.size() +
+      TileContentFactory::_loadersByContentType.size());
+  for (const auto& entry : TileContentFactory::_loadersByMagic) {
+    result.push_back(entry.first);
+  }
+  for (const auto& entry : TileContentFactory::_loadersByContentType) {
+    result.push_back(entry.first);
+  }
+  return result;
+}
+
 /**
  * @brief Returns a string consisting of the first four ("magic") bytes of the
  * given data
@@ -24,7 +24,8 @@ TileContentLoadInput::TileContentLoadInput()
       tileRefine(TileRefine::Replace),
       tileGeometricError(0.0),
       tileTransform(glm::dmat4(1.0)),
-      contentOptions() {}
+      contentOptions(),
+      pMetrics(nullptr) {}
 
 TileContentLoadInput::TileContentLoadInput(const Tile& tile)
     : asyncSystem(nullptr),
@@ -37,8 +38,8 @@ TileContentLoadInput::TileContentLoadInput(const Tile& tile)
       tileRefine(tile.getRefine()),
       tileGeometricError(tile.getGeometricError()),
       tileTransform(tile.getTransform()),
-      contentOptions(tile.getContext()->pTileset->getOptions().contentOptions) {
-}
+      contentOptions(tile.getContext()->pTileset->getOptions().contentOptions),
+      pMetrics(tile.getContext()->pTileset->getMetrics()) {}
 
 TileContentLoadInput::TileContentLoadInput(
     const AsyncSystem& asyncSystem_,
@@ -56,8 +57,8 @@ TileContentLoadInput::TileContentLoadInput(
       tileRefine(tile.getRefine()),
       tileGeometricError(tile.getGeometricError()),
       tileTransform(tile.getTransform()),
-      contentOptions(tile.getContext()->pTileset->getOptions().contentOptions) {
-}
+      contentOptions(tile.getContext()->pTileset->getOptions().contentOptions),
+      pMetrics(tile.getContext()->pTileset->getMetrics()) {}
 
 TileContentLoadInput::TileContentLoadInput(
     const AsyncSystem& asyncSystem_,
@@ -81,4 +82,5 @@ TileContentLoadInput::TileContentLoadInput(
       tileRefine(tileRefine_),
       tileGeometricError(tileGeometricError_),
       tileTransform(tileTransform_),
-      contentOptions(contentOptions_) {}
+      contentOptions(contentOptions_),
+      pMetrics(nullptr) {}
@@ -2,6 +2,7 @@
 
 #include "Cesium3DTilesSelection/CreditSystem.h"
 #include "Cesium3DTilesSelection/QuadtreeRasterOverlayTileProvider.h"
+#include "Cesium3DTilesSelection/RasterOverlayMetadataCache.h"
 #include "Cesium3DTilesSelection/RasterOverlayTile.h"
 #include "Cesium3DTilesSelection/TilesetExternals.h"
 #include "Cesium3DTilesSelection/spdlog-cesium.h"
@@ -129,6 +130,103 @@ static std::optional<double> getAttributeDouble(
   return std::nullopt;
 }
 
+namespace {
+
+/**
+ * @brief The parts of a `tilemapresource.xml` that are needed to create a
+ * tile provider, before any {@link TileMapServiceRasterOverlayOptions} are
+ * applied.
+ */
+struct TileMapServiceMetadata {
+  std::optional<std::string> fileExtension;
+  std::optional<uint32_t> tileWidth;
+  std::optional<uint32_t> tileHeight;
+  uint32_t minimumLevel;
+  uint32_t maximumLevel;
+  std::optional<std::string> profile;
+  std::optional<double> west;
+  std::optional<double> south;
+  std::optional<double> east;
+  std::optional<double> north;
+};
+
+std::shared_ptr<const TileMapServiceMetadata> parseTileMapResource(
+    const gsl::span<const std::byte>& data,
+    const std::shared_ptr<spdlog::logger>& pLogger) {
+  tinyxml2::XMLDocument doc;
+  const tinyxml2::XMLError error =
+      doc.Parse(reinterpret_cast<const char*>(data.data()), data.size_bytes());
+  if (error != tinyxml2::XMLError::XML_SUCCESS) {
+    SPDLOG_LOGGER_ERROR(pLogger, "Could not parse tile map service XML.");
+    return nullptr;
+  }
+
+  tinyxml2::XMLElement* pRoot = doc.RootElement();
+  if (!pRoot) {
+    SPDLOG_LOGGER_ERROR(
+        pLogger,
+        "Tile map service XML document does not have a root "
+        "element.");
+    return nullptr;
+  }
+
+  auto pMetadata = std::make_shared<TileMapServiceMetadata>();
+
+  tinyxml2::XMLElement* pTileFormat = pRoot->FirstChildElement("TileFormat");
+  pMetadata->fileExtension = getAttributeString(pTileFormat, "extension");
+  pMetadata->tileWidth = getAttributeUint32(pTileFormat, "width");
+  pMetadata->tileHeight = getAttributeUint32(pTileFormat, "height");
+
+  uint32_t minimumLevel = std::numeric_limits<uint32_t>::max();
+  uint32_t maximumLevel = 0;
+
+  tinyxml2::XMLElement* pTilesets = pRoot->FirstChildElement("TileSets");
+  if (pTilesets) {
+    tinyxml2::XMLElement* pTileset = pTilesets->FirstChildElement("TileSet");
+    while (pTileset) {
+      const uint32_t level = getAttributeUint32(pTileset, "order").value_or(0);
+      minimumLevel = glm::min(minimumLevel, level);
+      maximumLevel = glm::max(maximumLevel, level);
+
+      pTileset = pTileset->NextSiblingElement("TileSet");
+    }
+  }
+
+  if (maximumLevel < minimumLevel && maximumLevel == 0) {
+    // Min and max levels unknown, so use defaults.
+    minimumLevel = 0;
+    maximumLevel = 25;
+  }
+
+  pMetadata->minimumLevel = minimumLevel;
+  pMetadata->maximumLevel = maximumLevel;
+  pMetadata->profile = getAttributeString(pTilesets, "profile");
+
+  tinyxml2::XMLElement* pBoundingBox = pRoot->FirstChildElement("BoundingBox");
+  pMetadata->west = getAttributeDouble(pBoundingBox, "minx");
+  pMetadata->south = getAttributeDouble(pBoundingBox, "miny");
+  pMetadata->east = getAttributeDouble(pBoundingBox, "maxx");
+  pMetadata->north = getAttributeDouble(pBoundingBox, "maxy");
+
+  return pMetadata;
+}
+
+std::string getMetadataCacheKey(
+    const std::string& xmlUrl,
+    const std::vector<IAssetAccessor::THeader>& headers) {
+  // The headers may include credentials that change the response.
+  std::string key = xmlUrl;
+  for (const IAssetAccessor::THeader& header : headers) {
+    key += '\n';
+    key += header.first;
+    key += ": ";
+    key += header.second;
+  }
+  return key;
+}
+
+} // namespace
+
 Future<std::unique_ptr<RasterOverlayTileProvider>>
 TileMapServiceRasterOverlay::createTileProvider(
     const CesiumAsync::AsyncSystem& asyncSystem,
@@ -147,18 +245,135 @@ TileMapServiceRasterOverlay::createTileProvider(
                                   this->_options.credit.value()))
                             : std::nullopt;
 
+  auto createProvider =
+      [pOwner,
+       asyncSystem,
+       pAssetAccessor,
+       credit,
+       pPrepareRendererResources,
+       pLogger,
+       options = this->_options,
+       url = this->_url,
+       headers = this->_headers](const TileMapServiceMetadata& metadata)
+      -> std::unique_ptr<RasterOverlayTileProvider> {
+    // CesiumGeospatial::Ellipsoid ellipsoid =
+    // this->_options.ellipsoid.value_or(CesiumGeospatial::Ellipsoid::WGS84);
+
+    std::string fileExtension = options.fileExtension.value_or(
+        metadata.fileExtension.value_or("png"));
+    uint32_t tileWidth =
+        options.tileWidth.value_or(metadata.tileWidth.value_or(256));
+    uint32_t tileHeight =
+        options.tileHeight.value_or(metadata.tileHeight.value_or(256));
+
+    uint32_t minimumLevel = metadata.minimumLevel;
+    uint32_t maximumLevel = metadata.maximumLevel;
+
+    CesiumGeospatial::GlobeRectangle tilingSchemeRectangle =
+        CesiumGeospatial::GeographicProjection::MAXIMUM_GLOBE_RECTANGLE;
+    CesiumGeospatial::Projection projection;
+    uint32_t rootTilesX = 1;
+    bool isRectangleInDegrees = false;
+
+    if (options.projection) {
+      projection = options.projection.value();
+    } else {
+      std::string projectionName = metadata.profile.value_or("mercator");
+
+      if (projectionName == "mercator" || projectionName == "global-mercator") {
+        projection = CesiumGeospatial::WebMercatorProjection();
+        tilingSchemeRectangle =
+            CesiumGeospatial::WebMercatorProjection::MAXIMUM_GLOBE_RECTANGLE;
+
+        // Determine based on the profile attribute if this tileset was
+        // generated by gdal2tiles.py, which uses 'mercator' and
+        // 'geodetic' profiles, or by a tool compliant with the TMS
+        // standard, which is 'global-mercator' and 'global-geodetic'
+        // profiles. In the gdal2Tiles case, X and Y are always in
+        // geodetic degrees.
+        isRectangleInDegrees = projectionName.find("global-") != 0;
+      } else if (
+          projectionName == "geodetic" || projectionName == "global-geodetic") {
+        projection = CesiumGeospatial::GeographicProjection();
+        tilingSchemeRectangle =
+            CesiumGeospatial::GeographicProjection::MAXIMUM_GLOBE_RECTANGLE;
+        rootTilesX = 2;
+
+        // The geodetic profile is always in degrees.
+        isRectangleInDegrees = true;
+      }
+    }
+
+    minimumLevel = glm::min(minimumLevel, maximumLevel);
+
+    minimumLevel = options.minimumLevel.value_or(minimumLevel);
+    maximumLevel = options.maximumLevel.value_or(maximumLevel);
+
+    CesiumGeometry::Rectangle coverageRectangle =
+        projectRectangleSimple(projection, tilingSchemeRectangle);
+
+    if (options.coverageRectangle) {
+      coverageRectangle = options.coverageRectangle.value();
+    } else if (
+        metadata.west && metadata.south && metadata.east && metadata.north) {
+      if (isRectangleInDegrees) {
+        coverageRectangle = projectRectangleSimple(
+            projection,
+            CesiumGeospatial::GlobeRectangle::fromDegrees(
+                metadata.west.value(),
+                metadata.south.value(),
+                metadata.east.value(),
+                metadata.north.value()));
+      } else {
+        coverageRectangle = CesiumGeometry::Rectangle(
+            metadata.west.value(),
+            metadata.south.value(),
+            metadata.east.value(),
+            metadata.north.value());
+      }
+    }
+
+    CesiumGeometry::QuadtreeTilingScheme tilingScheme(
+        projectRectangleSimple(projection, tilingSchemeRectangle),
+        rootTilesX,
+        1);
+
+    return std::make_unique<TileMapServiceTileProvider>(
+        *pOwner,
+        asyncSystem,
+        pAssetAccessor,
+        credit,
+        pPrepareRendererResources,
+        pLogger,
+        projection,
+        tilingScheme,
+        coverageRectangle,
+        url,
+        headers,
+        !fileExtension.empty() ? "." + fileExtension : fileExtension,
+        tileWidth,
+        tileHeight,
+        minimumLevel,
+        maximumLevel);
+  };
+
+  const std::shared_ptr<RasterOverlayMetadataCache>& pMetadataCache =
+      this->getOptions().pMetadataCache;
+  std::string cacheKey = getMetadataCacheKey(xmlUrl, this->_headers);
+  if (pMetadataCache) {
+    std::shared_ptr<const TileMapServiceMetadata> pMetadata =
+        pMetadataCache->get<TileMapServiceMetadata>(cacheKey);
+    if (pMetadata) {
+      return asyncSystem.createResolvedFuture(createProvider(*pMetadata));
+    }
+  }
+
   return pAssetAccessor->requestAsset(asyncSystem, xmlUrl, this->_headers)
       .thenInWorkerThread(
-          [pOwner,
-           asyncSystem,
-           pAssetAccessor,
-           credit,
-           pPrepareRendererResources,
-           pLogger,
-           options = this->_options,
-           url = this->_url,
-           headers =
-               this->_headers](const std::shared_ptr<IAssetRequest>& pRequest)
+          [pLogger,
+           pMetadataCache,
+           cacheKey = std::move(cacheKey),
+           createProvider](const std::shared_ptr<IAssetRequest>& pRequest)
               -> std::unique_ptr<RasterOverlayTileProvider> {
             const IAssetResponse* pResponse = pRequest->response();
             if (!pResponse) {
@@ -168,166 +383,17 @@ TileMapServiceRasterOverlay::createTileProvider(
               return nullptr;
             }
 
-            const gsl::span<const std::byte> data = pResponse->data();
-
-            tinyxml2::XMLDocument doc;
-            const tinyxml2::XMLError error = doc.Parse(
-                reinterpret_cast<const char*>(data.data()),
-                data.size_bytes());
-            if (error != tinyxml2::XMLError::XML_SUCCESS) {
-              SPDLOG_LOGGER_ERROR(
-                  pLogger,
-                  "Could not parse tile map service XML.");
+            std::shared_ptr<const TileMapServiceMetadata> pMetadata =
+                parseTileMapResource(pResponse->data(), pLogger);
+            if (!pMetadata) {
               return nullptr;
             }
 
-            tinyxml2::XMLElement* pRoot = doc.RootElement();
-            if (!pRoot) {
-              SPDLOG_LOGGER_ERROR(
-                  pLogger,
-                  "Tile map service XML document does not have a root "
-                  "element.");
-              return nullptr;
-            }
-
-            // CesiumGeospatial::Ellipsoid ellipsoid =
-            // this->_options.ellipsoid.value_or(CesiumGeospatial::Ellipsoid::WGS84);
-
-            tinyxml2::XMLElement* pTileFormat =
-                pRoot->FirstChildElement("TileFormat");
-            std::string fileExtension = options.fileExtension.value_or(
-                getAttributeString(pTileFormat, "extension").value_or("png"));
-            uint32_t tileWidth = options.tileWidth.value_or(
-                getAttributeUint32(pTileFormat, "width").value_or(256));
-            uint32_t tileHeight = options.tileHeight.value_or(
-                getAttributeUint32(pTileFormat, "height").value_or(256));
-
-            uint32_t minimumLevel = std::numeric_limits<uint32_t>::max();
-            uint32_t maximumLevel = 0;
-
-            tinyxml2::XMLElement* pTilesets =
-                pRoot->FirstChildElement("TileSets");
-            if (pTilesets) {
-              tinyxml2::XMLElement* pTileset =
-                  pTilesets->FirstChildElement("TileSet");
-              while (pTileset) {
-                const uint32_t level =
-                    getAttributeUint32(pTileset, "order").value_or(0);
-                minimumLevel = glm::min(minimumLevel, level);
-                maximumLevel = glm::max(maximumLevel, level);
-
-                pTileset = pTileset->NextSiblingElement("TileSet");
-              }
-            }
-
-            if (maximumLevel < minimumLevel && maximumLevel == 0) {
-              // Min and max levels unknown, so use defaults.
-              minimumLevel = 0;
-              maximumLevel = 25;
-            }
-
-            CesiumGeospatial::GlobeRectangle tilingSchemeRectangle =
-                CesiumGeospatial::GeographicProjection::MAXIMUM_GLOBE_RECTANGLE;
-            CesiumGeospatial::Projection projection;
-            uint32_t rootTilesX = 1;
-            bool isRectangleInDegrees = false;
-
-            if (options.projection) {
-              projection = options.projection.value();
-            } else {
-              std::string projectionName =
-                  getAttributeString(pTilesets, "profile").value_or("mercator");
-
-              if (projectionName == "mercator" ||
-                  projectionName == "global-mercator") {
-                projection = CesiumGeospatial::WebMercatorProjection();
-                tilingSchemeRectangle = CesiumGeospatial::
-                    WebMercatorProjection::MAXIMUM_GLOBE_RECTANGLE;
-
-                // Determine based on the profile attribute if this tileset was
-                // generated by gdal2tiles.py, which uses 'mercator' and
-                // 'geodetic' profiles, or by a tool compliant with the TMS
-                // standard, which is 'global-mercator' and 'global-geodetic'
-                // profiles. In the gdal2Tiles case, X and Y are always in
-                // geodetic degrees.
-                isRectangleInDegrees = projectionName.find("global-") != 0;
-              } else if (
-                  projectionName == "geodetic" ||
-                  projectionName == "global-geodetic") {
-                projection = CesiumGeospatial::GeographicProjection();
-                tilingSchemeRectangle = CesiumGeospatial::GeographicProjection::
-                    MAXIMUM_GLOBE_RECTANGLE;
-                rootTilesX = 2;
-
-                // The geodetic profile is always in degrees.
-                isRectangleInDegrees = true;
-              }
-            }
-
-            minimumLevel = glm::min(minimumLevel, maximumLevel);
-
-            minimumLevel = options.minimumLevel.value_or(minimumLevel);
-            maximumLevel = options.maximumLevel.value_or(maximumLevel);
-
-            CesiumGeometry::Rectangle coverageRectangle =
-                projectRectangleSimple(projection, tilingSchemeRectangle);
-
-            if (options.coverageRectangle) {
-              coverageRectangle = options.coverageRectangle.value();
-            } else {
-              tinyxml2::XMLElement* pBoundingBox =
-                  pRoot->FirstChildElement("BoundingBox");
-
-              std::optional<double> west =
-                  getAttributeDouble(pBoundingBox, "minx");
-              std::optional<double> south =
-                  getAttributeDouble(pBoundingBox, "miny");
-              std::optional<double> east =
-                  getAttributeDouble(pBoundingBox, "maxx");
-              std::optional<double> north =
-                  getAttributeDouble(pBoundingBox, "maxy");
-
-              if (west && south && east && north) {
-                if (isRectangleInDegrees) {
-                  coverageRectangle = projectRectangleSimple(
-                      projection,
-                      CesiumGeospatial::GlobeRectangle::fromDegrees(
-                          west.value(),
-                          south.value(),
-                          east.value(),
-                          north.value()));
-                } else {
-                  coverageRectangle = CesiumGeometry::Rectangle(
-                      west.value(),
-                      south.value(),
-                      east.value(),
-                      north.value());
-                }
-              }
+            if (pMetadataCache) {
+              pMetadataCache->put(cacheKey, pMetadata);
             }
 
-            CesiumGeometry::QuadtreeTilingScheme tilingScheme(
-                projectRectangleSimple(projection, tilingSchemeRectangle),
-                rootTilesX,
-                1);
-
-            return std::make_unique<TileMapServiceTileProvider>(
-                *pOwner,
-                asyncSystem,
-                pAssetAccessor,
-                credit,
-                pPrepareRendererResources,
-                pLogger,
-                projection,
-                tilingScheme,
-                coverageRectangle,
-                url,
-                headers,
-                !fileExtension.empty() ? "." + fileExtension : fileExtension,
-                tileWidth,
-                tileHeight,
-                minimumLevel,
-                maximumLevel);
+            return createProvider(*pMetadata);
           });
 }
 
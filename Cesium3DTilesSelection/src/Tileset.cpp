@@ -7,8 +7,10 @@
 #include "Cesium3DTilesSelection/RasterOverlayTile.h"
 #include "Cesium3DTilesSelection/RasterizedPolygonsOverlay.h"
 #include "Cesium3DTilesSelection/TileID.h"
+#include "Cesium3DTilesSelection/TilesetGroup.h"
 #include "Cesium3DTilesSelection/spdlog-cesium.h"
 #include "TileUtilities.h"
+#include "TilesetMetrics.h"
 #include "calcQuadtreeMaxGeometricError.h"
 
 #include <CesiumAsync/AsyncSystem.h>
@@ -16,12 +18,14 @@
 #include <CesiumAsync/IAssetResponse.h>
 #include <CesiumAsync/ITaskProcessor.h>
 #include <CesiumGeometry/Axis.h>
+#include <CesiumGeometry/OctreeAvailability.h>
 #include <CesiumGeometry/OctreeTilingScheme.h>
 #include <CesiumGeometry/QuadtreeAvailability.h>
 #include <CesiumGeometry/QuadtreeRectangleAvailability.h>
 #include <CesiumGeometry/QuadtreeTilingScheme.h>
 #include <CesiumGeometry/TileAvailabilityFlags.h>
 #include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/EllipsoidalOccluder.h>
 #include <CesiumGeospatial/GeographicProjection.h>
 #include <CesiumGeospatial/GlobeRectangle.h>
 #include <CesiumUtility/JsonHelpers.h>
@@ -30,9 +34,12 @@
 #include <CesiumUtility/Uri.h>
 
 #include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/trigonometric.hpp>
 #include <rapidjson/document.h>
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <limits>
 #include <optional>
@@ -51,6 +58,10 @@ Tileset::Tileset(
     const TilesetOptions& options)
     : _externals(externals),
       _asyncSystem(externals.asyncSystem),
+      _pMetrics(
+          externals.pMetrics
+              ? std::make_shared<TilesetMetrics>(externals.pMetrics)
+              : nullptr),
       _userCredit(
           (options.credit && externals.pCreditSystem)
               ? std::optional<Credit>(externals.pCreditSystem->createCredit(
@@ -59,10 +70,12 @@ Tileset::Tileset(
       _url(url),
       _isRefreshingIonToken(false),
       _options(options),
+      _pGroup(options.group),
       _pRootTile(),
       _previousFrameNumber(0),
       _loadsInProgress(0),
       _subtreeLoadsInProgress(0),
+      _subtreePrefetchesInProgress(0),
       _overlays(*this),
       _tileDataBytes(0),
       _supportsRasterOverlays(false),
@@ -70,6 +83,9 @@ Tileset::Tileset(
       _distancesStack(),
       _nextDistancesVector(0) {
   CESIUM_TRACE_USE_TRACK_SET(this->_loadingSlots);
+  if (this->_pGroup) {
+    this->_pGroup->addTileset(*this);
+  }
   ++this->_loadsInProgress;
   this->_loadTilesetJson(url);
 }
@@ -81,6 +97,10 @@ Tileset::Tileset(
     const TilesetOptions& options)
     : _externals(externals),
       _asyncSystem(externals.asyncSystem),
+      _pMetrics(
+          externals.pMetrics
+              ? std::make_shared<TilesetMetrics>(externals.pMetrics)
+              : nullptr),
       _userCredit(
           (options.credit && externals.pCreditSystem)
               ? std::optional<Credit>(externals.pCreditSystem->createCredit(
@@ -90,10 +110,12 @@ Tileset::Tileset(
       _ionAccessToken(ionAccessToken),
       _isRefreshingIonToken(false),
       _options(options),
+      _pGroup(options.group),
       _pRootTile(),
       _previousFrameNumber(0),
       _loadsInProgress(0),
       _subtreeLoadsInProgress(0),
+      _subtreePrefetchesInProgress(0),
       _overlays(*this),
       _tileDataBytes(0),
       _supportsRasterOverlays(false),
@@ -103,6 +125,10 @@ Tileset::Tileset(
   CESIUM_TRACE_USE_TRACK_SET(this->_loadingSlots);
   CESIUM_TRACE_BEGIN_IN_TRACK("Tileset from ion startup");
 
+  if (this->_pGroup) {
+    this->_pGroup->addTileset(*this);
+  }
+
   std::string ionUrl = "https://api.cesium.com/v1/assets/" +
                        std::to_string(ionAssetID) + "/endpoint";
   if (!ionAccessToken.empty()) {
@@ -128,12 +154,18 @@ Tileset::Tileset(
 }
 
 Tileset::~Tileset() {
+  if (this->_pGroup) {
+    this->_pGroup->removeTileset(*this);
+  }
+
   // Wait for all asynchronous loading to terminate.
   // If you're hanging here, it's most likely caused by _loadsInProgress not
   // being decremented correctly when an async load ends.
   while (this->_loadsInProgress.load(std::memory_order::memory_order_acquire) >
              0 ||
          this->_subtreeLoadsInProgress.load(
+             std::memory_order::memory_order_acquire) > 0 ||
+         this->_subtreePrefetchesInProgress.load(
              std::memory_order::memory_order_acquire) > 0) {
     this->_externals.pAssetAccessor->tick();
     this->_asyncSystem.dispatchMainThreadTasks();
@@ -150,6 +182,13 @@ Tileset::~Tileset() {
       tilesLoading += pOverlay->getTileProvider()->getNumberOfTilesLoading();
     }
   }
+
+  // The bytes of the tiles are removed from the metrics as the tiles are
+  // destroyed, but the overlays are not tracked individually.
+  if (this->_pMetrics) {
+    this->_pMetrics->rasterOverlayBytes.add(
+        -this->_pMetrics->reportedRasterOverlayBytes);
+  }
 }
 
 Future<void>
@@ -300,7 +339,8 @@ Tileset::updateViewOffline(const std::vector<ViewState>& frustums) {
       this->_updateResult.tilesToRenderThisFrame;
 
   this->updateView(frustums);
-  while (this->_loadsInProgress > 0 || this->_subtreeLoadsInProgress > 0) {
+  while (this->_loadsInProgress > 0 || this->_subtreeLoadsInProgress > 0 ||
+         this->_subtreePrefetchesInProgress > 0) {
     this->_externals.pAssetAccessor->tick();
     this->updateView(frustums);
   }
@@ -336,7 +376,9 @@ Tileset::updateView(const std::vector<ViewState>& frustums) {
   result.tilesVisited = 0;
   result.culledTilesVisited = 0;
   result.tilesCulled = 0;
+  result.tilesHorizonCulled = 0;
   result.maxDepthVisited = 0;
+  result.tilesReusedFromPreviousFrames = 0;
 
   Tile* pRootTile = this->getRootTile();
   if (!pRootTile) {
@@ -352,6 +394,15 @@ Tileset::updateView(const std::vector<ViewState>& frustums) {
   this->_loadQueueMedium.clear();
   this->_loadQueueLow.clear();
   this->_subtreeLoadQueue.clear();
+  this->_subtreePrefetchQueue.clear();
+
+  this->_visitedTiles.clear();
+  this->_subtreeSelectionRecords.clear();
+  if (this->_options.enableFrameCoherentSelection) {
+    this->_invalidateSubtreeSelectionCache();
+  } else {
+    this->_subtreeSelectionCache.clear();
+  }
 
   std::vector<double> fogDensities(frustums.size());
   std::transform(
@@ -363,9 +414,26 @@ Tileset::updateView(const std::vector<ViewState>& frustums) {
         return computeFogDensity(fogDensityTable, frustum);
       });
 
+  std::vector<CullingVolume> cullingVolumes(frustums.size());
+  std::transform(
+      frustums.begin(),
+      frustums.end(),
+      cullingVolumes.begin(),
+      [](const ViewState& frustum) { return frustum.getCullingVolume(); });
+
+  std::vector<EllipsoidalOccluder> horizonOccluders;
+  if (this->_options.enableHorizonCulling) {
+    horizonOccluders.reserve(frustums.size());
+    for (const ViewState& frustum : frustums) {
+      horizonOccluders.emplace_back(Ellipsoid::WGS84, frustum.getPosition());
+    }
+  }
+
   FrameState frameState{
       frustums,
+      std::move(cullingVolumes),
       std::move(fogDensities),
+      std::move(horizonOccluders),
       previousFrameNumber,
       currentFrameNumber};
 
@@ -376,7 +444,12 @@ Tileset::updateView(const std::vector<ViewState>& frustums) {
         0,
         false,
         *pRootTile,
+        std::nullopt,
         result);
+
+    if (this->_options.enableFrameCoherentSelection) {
+      this->_updateSubtreeSelectionCache(frameState, result);
+    }
   } else {
     result = ViewUpdateResult();
   }
@@ -388,8 +461,23 @@ Tileset::updateView(const std::vector<ViewState>& frustums) {
   result.tilesLoadingHighPriority =
       static_cast<uint32_t>(this->_loadQueueHigh.size());
 
-  this->_unloadCachedTiles();
-  this->_processLoadQueue();
+  if (this->_pGroup) {
+    // Tiles are loaded and unloaded by TilesetGroup::update, once all members
+    // of the group have been updated.
+    this->processSubtreeQueue();
+    this->processSubtreePrefetchQueue();
+  } else {
+    this->_unloadCachedTiles();
+    this->_processLoadQueue();
+  }
+
+  if (this->_pMetrics) {
+    const int64_t rasterOverlayBytes =
+        this->getTotalDataBytes() - this->_tileDataBytes;
+    this->_pMetrics->rasterOverlayBytes.add(
+        rasterOverlayBytes - this->_pMetrics->reportedRasterOverlayBytes);
+    this->_pMetrics->reportedRasterOverlayBytes = rasterOverlayBytes;
+  }
 
   // aggregate all the credits needed from this tileset for the current frame
   const std::shared_ptr<CreditSystem>& pCreditSystem =
@@ -439,8 +527,7 @@ void Tileset::notifyTileStartLoading(Tile* pTile) noexcept {
   ++this->_loadsInProgress;
 
   if (pTile) {
-    CESIUM_TRACE_BEGIN_IN_TRACK(
-        TileIdUtilities::createTileIdString(pTile->getTileID()).c_str());
+    CESIUM_TRACE_BEGIN_IN_TRACK("Load tile");
   }
 }
 
@@ -449,16 +536,23 @@ void Tileset::notifyTileDoneLoading(Tile* pTile) noexcept {
   --this->_loadsInProgress;
 
   if (pTile) {
-    this->_tileDataBytes += pTile->computeByteSize();
+    const int64_t bytes = pTile->computeByteSize();
+    this->_tileDataBytes += bytes;
+    if (this->_pMetrics) {
+      this->_pMetrics->tileContentBytes.add(bytes);
+    }
 
-    CESIUM_TRACE_END_IN_TRACK(
-        TileIdUtilities::createTileIdString(pTile->getTileID()).c_str());
+    CESIUM_TRACE_END_IN_TRACK("Load tile");
   }
 }
 
 void Tileset::notifyTileUnloading(Tile* pTile) noexcept {
   if (pTile) {
-    this->_tileDataBytes -= pTile->computeByteSize();
+    const int64_t bytes = pTile->computeByteSize();
+    this->_tileDataBytes -= bytes;
+    if (this->_pMetrics) {
+      this->_pMetrics->tileContentBytes.add(-bytes);
+    }
   }
 }
 
@@ -493,19 +587,6 @@ Tileset::requestTileContent(Tile& tile) {
       tile.getContext()->requestHeaders);
 }
 
-CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
-Tileset::requestAvailabilitySubtree(Tile& tile) {
-  std::string url = this->getResolvedSubtreeUrl(tile);
-  assert(!url.empty());
-
-  ++this->_subtreeLoadsInProgress;
-
-  return this->getExternals().pAssetAccessor->requestAsset(
-      this->getAsyncSystem(),
-      url,
-      tile.getContext()->requestHeaders);
-}
-
 void Tileset::addContext(std::unique_ptr<TileContext>&& pNewContext) {
   this->_contexts.push_back(std::move(pNewContext));
 }
@@ -1442,12 +1523,38 @@ static void markTileAndChildrenNonRendered(
   markChildrenNonRendered(lastFrameNumber, lastResult, tile, result);
 }
 
+/**
+ * @brief Returns whether the camera of the given {@link ViewState} is
+ * directly above or below the given bounding volume.
+ *
+ * @param viewState The {@link ViewState}
+ * @param boundingVolume The bounding volume of the tile
+ * @return Whether the camera is above or below the bounding volume
+ */
+static bool
+isUnderCamera(const ViewState& viewState, const BoundingVolume& boundingVolume) {
+  const std::optional<CesiumGeospatial::Cartographic>& position =
+      viewState.getPositionCartographic();
+
+  // TODO: it would be better to test a line pointing down (and up?) from the
+  // camera against the bounding volume itself, rather than transforming the
+  // bounding volume to a region.
+  std::optional<GlobeRectangle> maybeRectangle =
+      estimateGlobeRectangle(boundingVolume);
+  if (position && maybeRectangle) {
+    return maybeRectangle->contains(position.value());
+  }
+  return false;
+}
+
 /**
  * @brief Returns whether a tile with the given bounding volume is visible for
  * the camera.
  *
  * @param viewState The {@link ViewState}
  * @param boundingVolume The bounding volume of the tile
+ * @param isInFrustum Whether the bounding volume is at least partially
+ * contained in the frustum of the camera.
  * @param forceRenderTilesUnderCamera Whether tiles under the camera should
  * always be considered visible and rendered (see
  * {@link Cesium3DTilesSelection::TilesetOptions}).
@@ -1457,26 +1564,142 @@ static void markTileAndChildrenNonRendered(
 static bool isVisibleFromCamera(
     const ViewState& viewState,
     const BoundingVolume& boundingVolume,
+    bool isInFrustum,
     bool forceRenderTilesUnderCamera) {
-  if (viewState.isBoundingVolumeVisible(boundingVolume)) {
+  if (isInFrustum) {
     return true;
   }
   if (!forceRenderTilesUnderCamera) {
     return false;
   }
+  return isUnderCamera(viewState, boundingVolume);
+}
 
-  const std::optional<CesiumGeospatial::Cartographic>& position =
-      viewState.getPositionCartographic();
+/**
+ * @brief Adds a bounding volume to a batch of bounding volumes.
+ *
+ * Bounding regions are represented by their oriented bounding boxes, which is
+ * also what {@link ViewState::isBoundingVolumeVisible} tests them with. S2
+ * cells cannot be represented in a batch and are not added.
+ *
+ * @param boundingVolume The bounding volume
+ * @param batch The batch
+ */
+static void addToBatch(
+    const BoundingVolume& boundingVolume,
+    BoundingVolumeBatch& batch) {
+  struct Operation {
+    BoundingVolumeBatch& batch;
 
-  // TODO: it would be better to test a line pointing down (and up?) from the
-  // camera against the bounding volume itself, rather than transforming the
-  // bounding volume to a region.
-  std::optional<GlobeRectangle> maybeRectangle =
-      estimateGlobeRectangle(boundingVolume);
-  if (position && maybeRectangle) {
-    return maybeRectangle->contains(position.value());
+    void operator()(const OrientedBoundingBox& boundingBox) {
+      batch.add(boundingBox);
+    }
+
+    void operator()(const BoundingRegion& boundingRegion) {
+      batch.add(boundingRegion.getBoundingBox());
+    }
+
+    void operator()(const BoundingSphere& boundingSphere) {
+      batch.add(boundingSphere);
+    }
+
+    void operator()(
+        const BoundingRegionWithLooseFittingHeights& boundingRegion) {
+      batch.add(boundingRegion.getBoundingRegion().getBoundingBox());
+    }
+
+    void operator()(const S2CellBoundingVolume& /*s2Cell*/) {}
+  };
+
+  std::visit(Operation{batch}, boundingVolume);
+}
+
+/**
+ * @brief Computes a horizon occlusion point for everything inside of a
+ * bounding volume.
+ *
+ * @param boundingVolume The bounding volume
+ * @return The horizon occlusion point in the ellipsoid-scaled space of the
+ * WGS84 ellipsoid, or `std::nullopt` if there is none.
+ */
+static std::optional<glm::dvec3>
+computeHorizonOcclusionPoint(const BoundingVolume& boundingVolume) {
+  struct Operation {
+    std::optional<glm::dvec3>
+    operator()(const OrientedBoundingBox& boundingBox) {
+      const glm::dvec3& center = boundingBox.getCenter();
+      const glm::dmat3& halfAxes = boundingBox.getHalfAxes();
+      const std::array<glm::dvec3, 8> corners{
+          center - halfAxes[0] - halfAxes[1] - halfAxes[2],
+          center - halfAxes[0] - halfAxes[1] + halfAxes[2],
+          center - halfAxes[0] + halfAxes[1] - halfAxes[2],
+          center - halfAxes[0] + halfAxes[1] + halfAxes[2],
+          center + halfAxes[0] - halfAxes[1] - halfAxes[2],
+          center + halfAxes[0] - halfAxes[1] + halfAxes[2],
+          center + halfAxes[0] + halfAxes[1] - halfAxes[2],
+          center + halfAxes[0] + halfAxes[1] + halfAxes[2]};
+      return EllipsoidalOccluder::computeHorizonCullingPoint(
+          Ellipsoid::WGS84,
+          center,
+          corners);
+    }
+
+    std::optional<glm::dvec3>
+    operator()(const BoundingRegion& boundingRegion) {
+      return (*this)(boundingRegion.getBoundingBox());
+    }
+
+    std::optional<glm::dvec3>
+    operator()(const BoundingSphere& /*boundingSphere*/) {
+      return std::nullopt;
+    }
+
+    std::optional<glm::dvec3>
+    operator()(const BoundingRegionWithLooseFittingHeights& boundingRegion) {
+      return (*this)(boundingRegion.getBoundingRegion().getBoundingBox());
+    }
+
+    std::optional<glm::dvec3> operator()(const S2CellBoundingVolume& s2Cell) {
+      return EllipsoidalOccluder::computeHorizonCullingPoint(
+          Ellipsoid::WGS84,
+          s2Cell.getCenter(),
+          s2Cell.getVertices());
+    }
+  };
+
+  return std::visit(Operation{}, boundingVolume);
+}
+
+/**
+ * @brief Returns whether a tile is above the horizon for at least one of the
+ * given occluders.
+ *
+ * @param horizonOccluders The occluders of all frustums
+ * @param tile The tile. Its horizon occlusion point is computed and stored in
+ * the tile if it does not have one yet.
+ * @return Whether the tile may be visible
+ */
+static bool isVisibleAboveHorizon(
+    const std::vector<EllipsoidalOccluder>& horizonOccluders,
+    Tile& tile) {
+  std::optional<glm::dvec3> horizonOcclusionPoint =
+      tile.getHorizonOcclusionPoint();
+  if (!horizonOcclusionPoint) {
+    horizonOcclusionPoint =
+        computeHorizonOcclusionPoint(tile.getBoundingVolume());
+    if (!horizonOcclusionPoint) {
+      return true;
+    }
+    tile.setHorizonOcclusionPoint(horizonOcclusionPoint);
   }
-  return false;
+
+  return std::any_of(
+      horizonOccluders.begin(),
+      horizonOccluders.end(),
+      [&horizonOcclusionPoint](const EllipsoidalOccluder& occluder) {
+        return occluder.isCameraInsideEllipsoid() ||
+               occluder.isScaledSpacePointVisible(*horizonOcclusionPoint);
+      });
 }
 
 /**
@@ -1507,8 +1730,31 @@ Tileset::TraversalDetails Tileset::_visitTileIfNeeded(
     uint32_t depth,
     bool ancestorMeetsSse,
     Tile& tile,
+    std::optional<uint64_t> frustumVisibility,
     ViewUpdateResult& result) {
 
+  const bool frameCoherentSelection =
+      this->_options.enableFrameCoherentSelection;
+  if (frameCoherentSelection) {
+    std::optional<TraversalDetails> reusedDetails =
+        this->_reuseSubtreeSelection(
+            frameState,
+            ancestorMeetsSse,
+            tile,
+            result);
+    if (reusedDetails) {
+      return *reusedDetails;
+    }
+  }
+
+  const size_t visitedIndex = this->_visitedTiles.size();
+  const size_t renderIndex = result.tilesToRenderThisFrame.size();
+  const size_t loadIndexLow = this->_loadQueueLow.size();
+  const size_t loadIndexMedium = this->_loadQueueMedium.size();
+  const size_t loadIndexHigh = this->_loadQueueHigh.size();
+  const size_t subtreeLoadIndex = this->_subtreeLoadQueue.size();
+  const size_t subtreePrefetchIndex = this->_subtreePrefetchQueue.size();
+
   if (tile.getState() == Tile::LoadState::ContentLoaded) {
     tile.processLoadedContent();
     ImplicitTraversalUtilities::createImplicitChildrenIfNeeded(
@@ -1538,17 +1784,20 @@ Tileset::TraversalDetails Tileset::_visitTileIfNeeded(
   const std::vector<double>& fogDensities = frameState.fogDensities;
 
   const BoundingVolume& boundingVolume = tile.getBoundingVolume();
-  if (std::none_of(
-          frustums.begin(),
-          frustums.end(),
-          [boundingVolume,
-           renderTilesUnderCamera = this->_options.renderTilesUnderCamera](
-              const ViewState& frustum) {
-            return isVisibleFromCamera(
-                frustum,
-                boundingVolume,
-                renderTilesUnderCamera);
-          })) {
+  bool isVisible = false;
+  for (size_t i = 0; i < frustums.size() && !isVisible; ++i) {
+    // The frustum visibility is precomputed for all children of a tile at
+    // once, if possible.
+    const bool isInFrustum =
+        frustumVisibility ? ((*frustumVisibility >> i) & 1) != 0
+                          : frustums[i].isBoundingVolumeVisible(boundingVolume);
+    isVisible = isVisibleFromCamera(
+        frustums[i],
+        boundingVolume,
+        isInFrustum,
+        this->_options.renderTilesUnderCamera);
+  }
+  if (!isVisible) {
     // this tile is off-screen so it is a culled tile
     culled = true;
     if (this->_options.enableFrustumCulling) {
@@ -1613,6 +1862,24 @@ Tileset::TraversalDetails Tileset::_visitTileIfNeeded(
     }
   }
 
+  // if we are still considering visiting this tile, check whether it is
+  // hidden behind the horizon of the ellipsoid
+  if (shouldVisit && this->_options.enableHorizonCulling &&
+      !isVisibleAboveHorizon(frameState.horizonOccluders, tile)) {
+    culled = true;
+    shouldVisit = false;
+    ++result.tilesHorizonCulled;
+  }
+
+  this->addSubtreePrefetchesToQueue(
+      frameState,
+      implicitInfo,
+      tile,
+      distances,
+      culled);
+
+  TraversalDetails traversalDetails;
+
   if (!shouldVisit) {
     markTileAndChildrenNonRendered(frameState.lastFrameNumber, tile, result);
     tile.setLastSelectionState(TileSelectionState(
@@ -1630,19 +1897,39 @@ Tileset::TraversalDetails Tileset::_visitTileIfNeeded(
     }
 
     ++result.tilesCulled;
+  } else {
+    traversalDetails = this->_visitTile(
+        frameState,
+        implicitInfo,
+        depth,
+        ancestorMeetsSse,
+        tile,
+        distances,
+        culled,
+        result);
+  }
 
-    return TraversalDetails();
+  // Remember this subtree as a candidate for reuse in later frames, unless it
+  // is still waiting for something to load.
+  if (frameCoherentSelection &&
+      this->_loadQueueLow.size() == loadIndexLow &&
+      this->_loadQueueMedium.size() == loadIndexMedium &&
+      this->_loadQueueHigh.size() == loadIndexHigh &&
+      this->_subtreeLoadQueue.size() == subtreeLoadIndex &&
+      this->_subtreePrefetchQueue.size() == subtreePrefetchIndex) {
+    this->_subtreeSelectionRecords.push_back(SubtreeSelectionRecord{
+        &tile,
+        visitedIndex,
+        this->_visitedTiles.size(),
+        renderIndex,
+        result.tilesToRenderThisFrame.size(),
+        ancestorMeetsSse,
+        false,
+        traversalDetails,
+        distances});
   }
 
-  return this->_visitTile(
-      frameState,
-      implicitInfo,
-      depth,
-      ancestorMeetsSse,
-      tile,
-      distances,
-      culled,
-      result);
+  return traversalDetails;
 }
 
 static bool isLeaf(const Tile& tile) noexcept {
@@ -1890,6 +2177,14 @@ bool Tileset::_kickDescendantsAndRenderTile(
     }
   }
 
+  // The selection of any recorded subtree whose rendered tiles were just
+  // kicked can't be reused.
+  while (!this->_subtreeSelectionRecords.empty() &&
+         this->_subtreeSelectionRecords.back().renderEnd >
+             firstRenderedDescendantIndex) {
+    this->_subtreeSelectionRecords.pop_back();
+  }
+
   // Remove all descendants from the render list and add this tile.
   renderList.erase(
       renderList.begin() +
@@ -2131,15 +2426,31 @@ Tileset::TraversalDetails Tileset::_visitVisibleChildrenNearToFar(
     ViewUpdateResult& result) {
   TraversalDetails traversalDetails;
 
-  // TODO: actually visit near-to-far, rather than in order of occurrence.
   gsl::span<Tile> children = tile.getChildren();
-  for (Tile& child : children) {
+
+  // Cull all children against all frustums at once. The visibility masks are
+  // kept on a stack, because visiting a child computes the masks of its own
+  // children.
+  const size_t visibilityBegin = this->_childFrustumVisibilityStack.size();
+  const bool batchCulling =
+      frameState.cullingVolumes.size() <=
+      BoundingVolumeBatch::MaximumCullingVolumes;
+  if (batchCulling) {
+    this->_computeChildFrustumVisibility(frameState, children);
+  }
+
+  // TODO: actually visit near-to-far, rather than in order of occurrence.
+  for (size_t i = 0; i < children.size(); ++i) {
+    Tile& child = children[i];
     const TraversalDetails childTraversal = this->_visitTileIfNeeded(
         frameState,
         ImplicitTraversalInfo(&child, &implicitInfo),
         depth + 1,
         ancestorMeetsSse,
         child,
+        batchCulling ? std::optional<uint64_t>(
+                           this->_childFrustumVisibilityStack[visibilityBegin + i])
+                     : std::nullopt,
         result);
 
     traversalDetails.allAreRenderable &= childTraversal.allAreRenderable;
@@ -2149,9 +2460,43 @@ Tileset::TraversalDetails Tileset::_visitVisibleChildrenNearToFar(
         childTraversal.notYetRenderableCount;
   }
 
+  this->_childFrustumVisibilityStack.resize(visibilityBegin);
+
   return traversalDetails;
 }
 
+void Tileset::_computeChildFrustumVisibility(
+    const FrameState& frameState,
+    gsl::span<const Tile> children) {
+  BoundingVolumeBatch& batch = this->_childBoundingVolumes;
+  std::vector<uint64_t>& batchVisibility =
+      this->_childBoundingVolumeVisibility;
+  std::vector<uint64_t>& visibilityStack = this->_childFrustumVisibilityStack;
+
+  batch.clear();
+  for (const Tile& child : children) {
+    addToBatch(child.getBoundingVolume(), batch);
+  }
+  batch.computeVisibility(frameState.cullingVolumes, batchVisibility);
+
+  // S2 cells are not part of the batch, so test them one at a time.
+  size_t batchIndex = 0;
+  for (const Tile& child : children) {
+    const BoundingVolume& boundingVolume = child.getBoundingVolume();
+    if (std::holds_alternative<S2CellBoundingVolume>(boundingVolume)) {
+      uint64_t visibility = 0;
+      for (size_t i = 0; i < frameState.frustums.size(); ++i) {
+        if (frameState.frustums[i].isBoundingVolumeVisible(boundingVolume)) {
+          visibility |= uint64_t(1) << i;
+        }
+      }
+      visibilityStack.push_back(visibility);
+    } else {
+      visibilityStack.push_back(batchVisibility[batchIndex++]);
+    }
+  }
+}
+
 void Tileset::_processLoadQueue() {
   this->processQueue(
       this->_loadQueueHigh,
@@ -2166,6 +2511,7 @@ void Tileset::_processLoadQueue() {
       this->_loadsInProgress,
       this->_options.maximumSimultaneousTileLoads);
   this->processSubtreeQueue();
+  this->processSubtreePrefetchQueue();
 }
 
 void Tileset::_unloadCachedTiles() noexcept {
@@ -2183,17 +2529,322 @@ void Tileset::_unloadCachedTiles() noexcept {
 
     Tile* pNext = this->_loadedTiles.next(*pTile);
 
-    const bool removed = pTile->unloadContent();
-    if (removed) {
-      this->_loadedTiles.remove(*pTile);
-    }
+    this->_evictTile(*pTile);
 
     pTile = pNext;
   }
 }
 
-void Tileset::_markTileVisited(Tile& tile) noexcept {
+bool Tileset::_evictTile(Tile& tile) noexcept {
+  const int64_t bytes = this->_pMetrics ? tile.computeByteSize() : 0;
+
+  const bool removed = tile.unloadContent();
+  if (removed) {
+    this->_loadedTiles.remove(tile);
+
+    if (this->_pMetrics) {
+      this->_pMetrics->tilesEvicted.increment();
+      this->_pMetrics->bytesEvicted.increment(static_cast<uint64_t>(bytes));
+    }
+  }
+
+  return removed;
+}
+
+void Tileset::_markTileVisited(Tile& tile) {
   this->_loadedTiles.insertAtTail(tile);
+
+  if (this->_options.enableFrameCoherentSelection) {
+    this->_visitedTiles.push_back(VisitedTile{
+        &tile,
+        tile.getLastSelectionState().getResult(this->_previousFrameNumber)});
+  }
+}
+
+/**
+ * @brief Determines if nothing about this tile will change until something
+ * external, like the view or the tileset's overlays, changes.
+ *
+ * This is the case when the tile is done loading (or failed for good), and all
+ * raster overlay tiles mapped to it are attached.
+ */
+static bool isTileSettled(const Tile& tile) noexcept {
+  const Tile::LoadState state = tile.getState();
+  if (state != Tile::LoadState::Done && state != Tile::LoadState::Failed) {
+    return false;
+  }
+
+  return std::all_of(
+      tile.getMappedRasterTiles().begin(),
+      tile.getMappedRasterTiles().end(),
+      [](const RasterMappedTo3DTile& mapped) noexcept {
+        return mapped.getState() ==
+               RasterMappedTo3DTile::AttachmentState::Attached;
+      });
+}
+
+/**
+ * @brief Determines if the view has changed so little, compared to the view a
+ * subtree was selected for, that its selection results can be reused.
+ *
+ * @param previous The frustums the subtree was selected for.
+ * @param current The frustums of the current frame.
+ * @param distances The distances from the previous frustums to the bounding
+ * volume of the subtree's root tile.
+ * @param tolerance The tolerance, see
+ * {@link TilesetOptions::frameCoherentSelectionTolerance}.
+ */
+static bool isViewCoherent(
+    const std::vector<ViewState>& previous,
+    const std::vector<ViewState>& current,
+    const std::vector<double>& distances,
+    double tolerance) noexcept {
+  if (previous.size() != current.size() ||
+      previous.size() != distances.size()) {
+    return false;
+  }
+
+  const double minimumCosine = glm::cos(tolerance);
+
+  for (size_t i = 0; i < previous.size(); ++i) {
+    const ViewState& a = previous[i];
+    const ViewState& b = current[i];
+
+    if (a.getViewportSize() != b.getViewportSize() ||
+        a.getHorizontalFieldOfView() != b.getHorizontalFieldOfView() ||
+        a.getVerticalFieldOfView() != b.getVerticalFieldOfView()) {
+      return false;
+    }
+
+    if (glm::distance(a.getPosition(), b.getPosition()) >
+        tolerance * distances[i]) {
+      return false;
+    }
+
+    if (glm::dot(a.getDirection(), b.getDirection()) < minimumCosine ||
+        glm::dot(a.getUp(), b.getUp()) < minimumCosine) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::optional<Tileset::TraversalDetails> Tileset::_reuseSubtreeSelection(
+    const FrameState& frameState,
+    bool ancestorMeetsSse,
+    Tile& tile,
+    ViewUpdateResult& result) {
+  auto it = this->_subtreeSelectionCache.find(&tile);
+  if (it == this->_subtreeSelectionCache.end()) {
+    return std::nullopt;
+  }
+
+  const SubtreeSelection& cached = it->second;
+
+  bool canReuse =
+      cached.ancestorMeetsSse == ancestorMeetsSse &&
+      isViewCoherent(
+          *cached.pFrustums,
+          frameState.frustums,
+          cached.distances,
+          this->_options.frameCoherentSelectionTolerance);
+
+  // Every tile in the subtree must still be in the load state it was in when
+  // the subtree was selected.
+  for (size_t i = 0; canReuse && i < cached.tiles.size(); ++i) {
+    const SelectedTile& selected = cached.tiles[i];
+    canReuse = selected.pTile->getState() == selected.loadState &&
+               isTileSettled(*selected.pTile);
+  }
+
+  if (!canReuse) {
+    this->_subtreeSelectionCache.erase(it);
+    return std::nullopt;
+  }
+
+  const size_t visitedIndex = this->_visitedTiles.size();
+  const size_t renderIndex = result.tilesToRenderThisFrame.size();
+
+  for (const SelectedTile& selected : cached.tiles) {
+    selected.pTile->setLastSelectionState(
+        TileSelectionState(frameState.currentFrameNumber, selected.result));
+    this->_loadedTiles.insertAtTail(*selected.pTile);
+    this->_visitedTiles.push_back(VisitedTile{selected.pTile, selected.result});
+  }
+
+  result.tilesToRenderThisFrame.insert(
+      result.tilesToRenderThisFrame.end(),
+      cached.tilesToRender.begin(),
+      cached.tilesToRender.end());
+  result.tilesReusedFromPreviousFrames +=
+      static_cast<uint32_t>(cached.tiles.size());
+
+  this->_subtreeSelectionRecords.push_back(SubtreeSelectionRecord{
+      &tile,
+      visitedIndex,
+      this->_visitedTiles.size(),
+      renderIndex,
+      result.tilesToRenderThisFrame.size(),
+      ancestorMeetsSse,
+      true,
+      cached.traversalDetails,
+      cached.distances});
+
+  return cached.traversalDetails;
+}
+
+void Tileset::_updateSubtreeSelectionCache(
+    const FrameState& frameState,
+    const ViewUpdateResult& result) {
+  const int32_t currentFrameNumber = frameState.currentFrameNumber;
+  const std::vector<VisitedTile>& visitedTiles = this->_visitedTiles;
+
+  // A visited tile is steady if it is settled and its selection result is the
+  // same as in the previous frame. Count the tiles that are _not_ steady, so
+  // that we can quickly determine whether a whole subtree is steady.
+  std::vector<size_t> unsteadyBefore(visitedTiles.size() + 1, 0);
+  for (size_t i = 0; i < visitedTiles.size(); ++i) {
+    const VisitedTile& visited = visitedTiles[i];
+    const bool steady =
+        visited.pTile->getLastSelectionState().getResult(currentFrameNumber) ==
+            visited.lastResult &&
+        isTileSettled(*visited.pTile);
+    unsteadyBefore[i + 1] = unsteadyBefore[i] + (steady ? 0 : 1);
+  }
+
+  // The records are in the order in which the traversal of their subtrees
+  // completed, so every subtree comes before its ancestors. Walk them
+  // backwards and only remember the largest steady subtrees.
+  std::shared_ptr<const std::vector<ViewState>> pFrustums;
+  size_t rememberedBegin = std::numeric_limits<size_t>::max();
+
+  for (auto recordIt = this->_subtreeSelectionRecords.rbegin();
+       recordIt != this->_subtreeSelectionRecords.rend();
+       ++recordIt) {
+    const SubtreeSelectionRecord& record = *recordIt;
+    if (record.visitedBegin >= rememberedBegin) {
+      // Part of a larger subtree that is already remembered.
+      continue;
+    }
+
+    if (unsteadyBefore[record.visitedEnd] !=
+        unsteadyBefore[record.visitedBegin]) {
+      continue;
+    }
+
+    rememberedBegin = record.visitedBegin;
+
+    if (record.reused) {
+      auto cachedIt = this->_subtreeSelectionCache.find(record.pTile);
+      if (cachedIt != this->_subtreeSelectionCache.end()) {
+        cachedIt->second.frameNumber = currentFrameNumber;
+        continue;
+      }
+    }
+
+    if (!pFrustums) {
+      pFrustums =
+          std::make_shared<const std::vector<ViewState>>(frameState.frustums);
+    }
+
+    SubtreeSelection& cached = this->_subtreeSelectionCache[record.pTile];
+    cached.frameNumber = currentFrameNumber;
+    cached.pFrustums = pFrustums;
+    cached.distances = record.distances;
+    cached.ancestorMeetsSse = record.ancestorMeetsSse;
+    cached.traversalDetails = record.traversalDetails;
+
+    cached.tiles.clear();
+    for (size_t i = record.visitedBegin; i < record.visitedEnd; ++i) {
+      Tile* pTile = visitedTiles[i].pTile;
+      cached.tiles.push_back(SelectedTile{
+          pTile,
+          pTile->getLastSelectionState().getResult(currentFrameNumber),
+          pTile->getState()});
+    }
+
+    cached.tilesToRender.assign(
+        result.tilesToRenderThisFrame.begin() +
+            static_cast<std::vector<Tile*>::iterator::difference_type>(
+                record.renderBegin),
+        result.tilesToRenderThisFrame.begin() +
+            static_cast<std::vector<Tile*>::iterator::difference_type>(
+                record.renderEnd));
+  }
+
+  // Forget the subtrees that were neither reused nor remembered in this frame.
+  for (auto it = this->_subtreeSelectionCache.begin();
+       it != this->_subtreeSelectionCache.end();) {
+    if (it->second.frameNumber != currentFrameNumber) {
+      it = this->_subtreeSelectionCache.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void Tileset::_invalidateSubtreeSelectionCache() {
+  const TilesetOptions& options = this->_options;
+  SelectionOptions& remembered = this->_subtreeSelectionOptions;
+
+  const auto sameFogDensity = [](const FogDensityAtHeight& a,
+                                 const FogDensityAtHeight& b) {
+    return a.cameraHeight == b.cameraHeight && a.fogDensity == b.fogDensity;
+  };
+  const auto sameExcluder = [](const ITileExcluder* pA,
+                               const std::shared_ptr<ITileExcluder>& pB) {
+    return pA == pB.get();
+  };
+
+  const bool unchanged =
+      remembered.maximumScreenSpaceError == options.maximumScreenSpaceError &&
+      remembered.preloadAncestors == options.preloadAncestors &&
+      remembered.preloadSiblings == options.preloadSiblings &&
+      remembered.loadingDescendantLimit == options.loadingDescendantLimit &&
+      remembered.forbidHoles == options.forbidHoles &&
+      remembered.enableFrustumCulling == options.enableFrustumCulling &&
+      remembered.enableFogCulling == options.enableFogCulling &&
+      remembered.enableHorizonCulling == options.enableHorizonCulling &&
+      remembered.enforceCulledScreenSpaceError ==
+          options.enforceCulledScreenSpaceError &&
+      remembered.culledScreenSpaceError == options.culledScreenSpaceError &&
+      std::equal(
+          remembered.fogDensityTable.begin(),
+          remembered.fogDensityTable.end(),
+          options.fogDensityTable.begin(),
+          options.fogDensityTable.end(),
+          sameFogDensity) &&
+      remembered.renderTilesUnderCamera == options.renderTilesUnderCamera &&
+      std::equal(
+          remembered.excluders.begin(),
+          remembered.excluders.end(),
+          options.excluders.begin(),
+          options.excluders.end(),
+          sameExcluder);
+  if (unchanged) {
+    return;
+  }
+
+  this->_subtreeSelectionCache.clear();
+
+  remembered.maximumScreenSpaceError = options.maximumScreenSpaceError;
+  remembered.preloadAncestors = options.preloadAncestors;
+  remembered.preloadSiblings = options.preloadSiblings;
+  remembered.loadingDescendantLimit = options.loadingDescendantLimit;
+  remembered.forbidHoles = options.forbidHoles;
+  remembered.enableFrustumCulling = options.enableFrustumCulling;
+  remembered.enableFogCulling = options.enableFogCulling;
+  remembered.enableHorizonCulling = options.enableHorizonCulling;
+  remembered.enforceCulledScreenSpaceError =
+      options.enforceCulledScreenSpaceError;
+  remembered.culledScreenSpaceError = options.culledScreenSpaceError;
+  remembered.fogDensityTable = options.fogDensityTable;
+  remembered.renderTilesUnderCamera = options.renderTilesUnderCamera;
+  remembered.excluders.clear();
+  for (const std::shared_ptr<ITileExcluder>& pExcluder : options.excluders) {
+    remembered.excluders.emplace_back(pExcluder.get());
+  }
 }
 
 std::string Tileset::getResolvedContentUrl(const Tile& tile) const {
@@ -2269,7 +2920,9 @@ std::string Tileset::getResolvedContentUrl(const Tile& tile) const {
   return CesiumUtility::Uri::resolve(tile.getContext()->baseUrl, url, true);
 }
 
-std::string Tileset::getResolvedSubtreeUrl(const Tile& tile) const {
+std::string Tileset::getResolvedSubtreeUrl(
+    const TileContext& context,
+    const TileID& subtreeRootID) const {
   struct Operation {
     const TileContext& context;
 
@@ -2335,12 +2988,12 @@ std::string Tileset::getResolvedSubtreeUrl(const Tile& tile) const {
     }
   };
 
-  std::string url = std::visit(Operation{*tile.getContext()}, tile.getTileID());
+  std::string url = std::visit(Operation{context}, subtreeRootID);
   if (url.empty()) {
     return url;
   }
 
-  return CesiumUtility::Uri::resolve(tile.getContext()->baseUrl, url, true);
+  return CesiumUtility::Uri::resolve(context.baseUrl, url, true);
 }
 
 static bool anyRasterOverlaysNeedLoading(const Tile& tile) noexcept {
@@ -2355,6 +3008,38 @@ static bool anyRasterOverlaysNeedLoading(const Tile& tile) noexcept {
   return false;
 }
 
+// Computes the priority of loading a tile from the views. Tiles that are
+// closer to the camera and nearer to the center of the view have a lower
+// value and load sooner.
+static double computeLoadPriority(
+    const std::vector<ViewState>& frustums,
+    const Tile& tile,
+    const std::vector<double>& distances) {
+  double highestLoadPriority = std::numeric_limits<double>::max();
+
+  const glm::dvec3 boundingVolumeCenter =
+      getBoundingVolumeCenter(tile.getBoundingVolume());
+
+  for (size_t i = 0; i < frustums.size() && i < distances.size(); ++i) {
+    const ViewState& frustum = frustums[i];
+    const double distance = distances[i];
+
+    glm::dvec3 tileDirection = boundingVolumeCenter - frustum.getPosition();
+    const double magnitude = glm::length(tileDirection);
+
+    if (magnitude >= CesiumUtility::Math::EPSILON5) {
+      tileDirection /= magnitude;
+      const double loadPriority =
+          (1.0 - glm::dot(tileDirection, frustum.getDirection())) * distance;
+      if (loadPriority < highestLoadPriority) {
+        highestLoadPriority = loadPriority;
+      }
+    }
+  }
+
+  return highestLoadPriority;
+}
+
 // TODO The viewState is only needed to
 // compute the priority from the distance. So maybe this function should
 // receive a priority directly and be called with
@@ -2372,25 +3057,7 @@ static bool anyRasterOverlaysNeedLoading(const Tile& tile) noexcept {
   if (tile.getState() == Tile::LoadState::Unloaded ||
       anyRasterOverlaysNeedLoading(tile)) {
 
-    const glm::dvec3 boundingVolumeCenter =
-        getBoundingVolumeCenter(tile.getBoundingVolume());
-
-    for (size_t i = 0; i < frustums.size() && i < distances.size(); ++i) {
-      const ViewState& frustum = frustums[i];
-      const double distance = distances[i];
-
-      glm::dvec3 tileDirection = boundingVolumeCenter - frustum.getPosition();
-      const double magnitude = glm::length(tileDirection);
-
-      if (magnitude >= CesiumUtility::Math::EPSILON5) {
-        tileDirection /= magnitude;
-        const double loadPriority =
-            (1.0 - glm::dot(tileDirection, frustum.getDirection())) * distance;
-        if (loadPriority < highestLoadPriority) {
-          highestLoadPriority = loadPriority;
-        }
-      }
-    }
+    highestLoadPriority = computeLoadPriority(frustums, tile, distances);
 
     // Check if the tile has any content
     const std::string* pStringID = std::get_if<std::string>(&tile.getTileID());
@@ -2463,30 +3130,48 @@ void Tileset::loadSubtree(const SubtreeLoadRecord& loadRecord) {
     return;
   }
 
-  ImplicitTilingContext& implicitContext =
-      *loadRecord.pTile->getContext()->implicitContext;
+  this->loadSubtree(
+      *loadRecord.pTile->getContext(),
+      loadRecord.pTile->getTileID(),
+      loadRecord.implicitInfo.pParentNode,
+      this->_subtreeLoadsInProgress);
+}
 
-  const TileID& tileID = loadRecord.pTile->getTileID();
-  const QuadtreeTileID* pQuadtreeID = std::get_if<QuadtreeTileID>(&tileID);
-  const OctreeTileID* pOctreeID = std::get_if<OctreeTileID>(&tileID);
+void Tileset::loadSubtree(
+    TileContext& context,
+    const TileID& subtreeRootID,
+    AvailabilityNode* pParentNode,
+    std::atomic<uint32_t>& loadsInProgress) {
+  ImplicitTilingContext& implicitContext = *context.implicitContext;
+
+  const QuadtreeTileID* pQuadtreeID =
+      std::get_if<QuadtreeTileID>(&subtreeRootID);
+  const OctreeTileID* pOctreeID = std::get_if<OctreeTileID>(&subtreeRootID);
 
   AvailabilityNode* pNewNode = nullptr;
 
   if (pQuadtreeID && implicitContext.quadtreeAvailability) {
     pNewNode = implicitContext.quadtreeAvailability->addNode(
         *pQuadtreeID,
-        loadRecord.implicitInfo.pParentNode);
+        pParentNode);
   } else if (pOctreeID && implicitContext.octreeAvailability) {
-    pNewNode = implicitContext.octreeAvailability->addNode(
-        *pOctreeID,
-        loadRecord.implicitInfo.pParentNode);
+    pNewNode =
+        implicitContext.octreeAvailability->addNode(*pOctreeID, pParentNode);
   }
 
-  this->requestAvailabilitySubtree(*loadRecord.pTile)
+  std::string url = this->getResolvedSubtreeUrl(context, subtreeRootID);
+  assert(!url.empty());
+
+  ++loadsInProgress;
+
+  this->getExternals()
+      .pAssetAccessor
+      ->requestAsset(this->getAsyncSystem(), url, context.requestHeaders)
       .thenInWorkerThread(
           [asyncSystem = this->getAsyncSystem(),
            pLogger = this->getExternals().pLogger,
-           pAssetAccessor = this->getExternals().pAssetAccessor](
+           pAssetAccessor = this->getExternals().pAssetAccessor,
+           pDerivedDataCache = this->getExternals().pDerivedDataCache](
               std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
             const IAssetResponse* pResponse = pRequest->response();
 
@@ -2496,10 +3181,9 @@ void Tileset::loadSubtree(const SubtreeLoadRecord& loadRecord) {
                 return AvailabilitySubtreeContent::load(
                     asyncSystem,
                     pLogger,
-                    pRequest->url(),
-                    pResponse->data(),
+                    pRequest,
                     pAssetAccessor,
-                    pRequest->headers());
+                    pDerivedDataCache);
               }
             }
 
@@ -2507,34 +3191,37 @@ void Tileset::loadSubtree(const SubtreeLoadRecord& loadRecord) {
                 std::unique_ptr<AvailabilitySubtree>(nullptr));
           })
       .thenInMainThread(
-          [this, loadRecord, pNewNode](
-              std::unique_ptr<AvailabilitySubtree>&& pSubtree) mutable {
-            --this->_subtreeLoadsInProgress;
-            if (loadRecord.pTile && pNewNode) {
-              TileContext* pContext = loadRecord.pTile->getContext();
-              if (pContext && pContext->implicitContext) {
-                ImplicitTilingContext& implicitContext =
-                    *pContext->implicitContext;
-                if (loadRecord.implicitInfo.usingImplicitQuadtreeTiling) {
-                  implicitContext.quadtreeAvailability->addLoadedSubtree(
-                      pNewNode,
-                      std::move(*pSubtree.release()));
-                } else if (loadRecord.implicitInfo.usingImplicitOctreeTiling) {
-                  implicitContext.octreeAvailability->addLoadedSubtree(
-                      pNewNode,
-                      std::move(*pSubtree.release()));
-                }
+          [pContext = &context,
+           pNewNode,
+           usingQuadtree = pQuadtreeID != nullptr,
+           pLoadsInProgress = &loadsInProgress](
+              std::unique_ptr<AvailabilitySubtree>&& pSubtree) {
+            --*pLoadsInProgress;
+            if (pNewNode && pSubtree && pContext->implicitContext) {
+              ImplicitTilingContext& implicitContext =
+                  *pContext->implicitContext;
+              if (usingQuadtree && implicitContext.quadtreeAvailability) {
+                implicitContext.quadtreeAvailability->addLoadedSubtree(
+                    pNewNode,
+                    std::move(*pSubtree));
+              } else if (
+                  !usingQuadtree && implicitContext.octreeAvailability) {
+                implicitContext.octreeAvailability->addLoadedSubtree(
+                    pNewNode,
+                    std::move(*pSubtree));
               }
             }
           })
-      .catchInMainThread([this, &tileID](const std::exception& e) {
-        SPDLOG_LOGGER_ERROR(
-            this->_externals.pLogger,
-            "Unhandled error while loading the subtree for tile id {}: {}",
-            TileIdUtilities::createTileIdString(tileID),
-            e.what());
-        --this->_subtreeLoadsInProgress;
-      });
+      .catchInMainThread(
+          [this, subtreeRootID, pLoadsInProgress = &loadsInProgress](
+              const std::exception& e) {
+            SPDLOG_LOGGER_ERROR(
+                this->_externals.pLogger,
+                "Unhandled error while loading the subtree for tile id {}: {}",
+                TileIdUtilities::createTileIdString(subtreeRootID),
+                e.what());
+            --*pLoadsInProgress;
+          });
 }
 
 void Tileset::addSubtreeToLoadQueue(
@@ -2571,4 +3258,201 @@ void Tileset::processSubtreeQueue() {
   }
 }
 
+namespace {
+/**
+ * @brief Determines whether the parent subtree says that a child subtree is
+ * available.
+ */
+bool isChildSubtreeAvailable(
+    const ImplicitTilingContext& implicitContext,
+    const TileID& subtreeRootID,
+    const AvailabilityNode* pParentNode) {
+  const QuadtreeTileID* pQuadtreeID =
+      std::get_if<QuadtreeTileID>(&subtreeRootID);
+  if (pQuadtreeID && implicitContext.quadtreeAvailability) {
+    return implicitContext.quadtreeAvailability
+        ->findChildNodeIndex(*pQuadtreeID, pParentNode)
+        .has_value();
+  }
+
+  const OctreeTileID* pOctreeID = std::get_if<OctreeTileID>(&subtreeRootID);
+  if (pOctreeID && implicitContext.octreeAvailability) {
+    return implicitContext.octreeAvailability
+        ->findChildNodeIndex(*pOctreeID, pParentNode)
+        .has_value();
+  }
+
+  return false;
+}
+
+/**
+ * @brief Finds the node of a child subtree, which exists once the subtree has
+ * started loading.
+ */
+AvailabilityNode* findChildSubtreeNode(
+    const ImplicitTilingContext& implicitContext,
+    const TileID& subtreeRootID,
+    AvailabilityNode* pParentNode) {
+  const QuadtreeTileID* pQuadtreeID =
+      std::get_if<QuadtreeTileID>(&subtreeRootID);
+  if (pQuadtreeID && implicitContext.quadtreeAvailability) {
+    return implicitContext.quadtreeAvailability->findChildNode(
+        *pQuadtreeID,
+        pParentNode);
+  }
+
+  const OctreeTileID* pOctreeID = std::get_if<OctreeTileID>(&subtreeRootID);
+  if (pOctreeID && implicitContext.octreeAvailability) {
+    return implicitContext.octreeAvailability->findChildNode(
+        *pOctreeID,
+        pParentNode);
+  }
+
+  return nullptr;
+}
+} // namespace
+
+void Tileset::addSubtreePrefetchesToQueue(
+    const FrameState& frameState,
+    const ImplicitTraversalInfo& implicitInfo,
+    Tile& tile,
+    const std::vector<double>& distances,
+    bool culled) {
+  if (this->_options.maximumSimultaneousSubtreePrefetches == 0 ||
+      !implicitInfo.pCurrentNode || !implicitInfo.pCurrentNode->subtree) {
+    return;
+  }
+
+  TileContext* pContext = tile.getContext();
+  if (!pContext || !pContext->implicitContext) {
+    return;
+  }
+  const ImplicitTilingContext& implicitContext = *pContext->implicitContext;
+
+  // Only the tiles in the last level of a subtree have children that are the
+  // roots of child subtrees.
+  std::array<TileID, 8> childIDs;
+  size_t childCount = 0;
+
+  const TileID& tileID = tile.getTileID();
+  const QuadtreeTileID* pQuadtreeID = std::get_if<QuadtreeTileID>(&tileID);
+  const OctreeTileID* pOctreeID = std::get_if<OctreeTileID>(&tileID);
+  if (pQuadtreeID && implicitInfo.usingImplicitQuadtreeTiling &&
+      implicitContext.quadtreeAvailability) {
+    const QuadtreeAvailability& availability =
+        *implicitContext.quadtreeAvailability;
+    const uint32_t childLevel = pQuadtreeID->level + 1;
+    if (childLevel % availability.getSubtreeLevels() != 0 ||
+        childLevel > availability.getMaximumLevel()) {
+      return;
+    }
+
+    for (uint32_t i = 0; i < 4; ++i) {
+      childIDs[childCount++] = QuadtreeTileID(
+          childLevel,
+          pQuadtreeID->x * 2 + (i & 1),
+          pQuadtreeID->y * 2 + ((i & 2) >> 1));
+    }
+  } else if (
+      pOctreeID && implicitInfo.usingImplicitOctreeTiling &&
+      implicitContext.octreeAvailability) {
+    const OctreeAvailability& availability =
+        *implicitContext.octreeAvailability;
+    const uint32_t childLevel = pOctreeID->level + 1;
+    if (childLevel % availability.getSubtreeLevels() != 0 ||
+        childLevel > availability.getMaximumLevel()) {
+      return;
+    }
+
+    for (uint32_t i = 0; i < 8; ++i) {
+      childIDs[childCount++] = OctreeTileID(
+          childLevel,
+          pOctreeID->x * 2 + ((i & 4) >> 2),
+          pOctreeID->y * 2 + ((i & 2) >> 1),
+          pOctreeID->z * 2 + (i & 1));
+    }
+  } else {
+    return;
+  }
+
+  // Prefetch if the tile is close to being refined, or if the camera is close
+  // enough to it that it may soon be.
+  const std::vector<ViewState>& frustums = frameState.frustums;
+  double largestSse = 0.0;
+  bool nearCamera = false;
+  for (size_t i = 0; i < frustums.size() && i < distances.size(); ++i) {
+    largestSse = glm::max(
+        largestSse,
+        frustums[i].computeScreenSpaceError(
+            tile.getGeometricError(),
+            distances[i]));
+    nearCamera =
+        nearCamera || distances[i] <= this->_options.subtreePrefetchDistance;
+  }
+
+  const double prefetchSse =
+      this->_options.maximumScreenSpaceError *
+      this->_options.subtreePrefetchScreenSpaceErrorRatio;
+  const bool nearRefinement = !culled && largestSse >= prefetchSse;
+  if (!nearRefinement && !nearCamera) {
+    return;
+  }
+
+  std::optional<double> priority;
+  for (size_t i = 0; i < childCount; ++i) {
+    const TileID& childID = childIDs[i];
+
+    // Skip the child subtrees that are unavailable or already loading.
+    if (!isChildSubtreeAvailable(
+            implicitContext,
+            childID,
+            implicitInfo.pCurrentNode) ||
+        findChildSubtreeNode(
+            implicitContext,
+            childID,
+            implicitInfo.pCurrentNode)) {
+      continue;
+    }
+
+    if (!priority) {
+      priority = computeLoadPriority(frustums, tile, distances);
+    }
+
+    this->_subtreePrefetchQueue.push_back(
+        {pContext, childID, implicitInfo.pCurrentNode, *priority});
+  }
+}
+
+void Tileset::processSubtreePrefetchQueue() {
+  const uint32_t maximumPrefetches =
+      this->_options.maximumSimultaneousSubtreePrefetches;
+  if (this->_subtreePrefetchesInProgress >= maximumPrefetches) {
+    return;
+  }
+
+  std::sort(
+      this->_subtreePrefetchQueue.begin(),
+      this->_subtreePrefetchQueue.end());
+
+  for (const SubtreePrefetchRecord& record : this->_subtreePrefetchQueue) {
+    // The subtree may have started loading since it was queued, because the
+    // traversal reached its root tile or because it was queued twice.
+    if (findChildSubtreeNode(
+            *record.pContext->implicitContext,
+            record.subtreeRootID,
+            record.pParentNode)) {
+      continue;
+    }
+
+    this->loadSubtree(
+        *record.pContext,
+        record.subtreeRootID,
+        record.pParentNode,
+        this->_subtreePrefetchesInProgress);
+    if (this->_subtreePrefetchesInProgress >= maximumPrefetches) {
+      break;
+    }
+  }
+}
+
 } // namespace Cesium3DTilesSelection
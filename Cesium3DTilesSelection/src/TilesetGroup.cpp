@@ -0,0 +1,160 @@
+#include "Cesium3DTilesSelection/TilesetGroup.h"
+
+#include "Cesium3DTilesSelection/Tileset.h"
+
+#include <CesiumUtility/Tracing.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace Cesium3DTilesSelection {
+
+TilesetGroup::TilesetGroup(const TilesetGroupOptions& options)
+    : _options(options), _tilesets() {}
+
+int64_t TilesetGroup::getTotalDataBytes() const noexcept {
+  int64_t bytes = 0;
+  for (const Tileset* pTileset : this->_tilesets) {
+    bytes += pTileset->getTotalDataBytes();
+  }
+  return bytes;
+}
+
+uint32_t TilesetGroup::getNumberOfLoadsInProgress() const noexcept {
+  uint32_t loads = 0;
+  for (const Tileset* pTileset : this->_tilesets) {
+    loads += pTileset->_loadsInProgress;
+  }
+  return loads;
+}
+
+void TilesetGroup::addTileset(Tileset& tileset) {
+  this->_tilesets.emplace_back(&tileset);
+}
+
+void TilesetGroup::removeTileset(Tileset& tileset) noexcept {
+  this->_tilesets.erase(
+      std::remove(this->_tilesets.begin(), this->_tilesets.end(), &tileset),
+      this->_tilesets.end());
+}
+
+void TilesetGroup::update() {
+  CESIUM_TRACE("TilesetGroup::update");
+
+  this->unloadCachedTiles();
+  this->processLoadQueues();
+
+  // The queues have been consumed. A tileset that isn't updated next frame
+  // must not have its old tiles loaded again.
+  for (Tileset* pTileset : this->_tilesets) {
+    pTileset->_loadQueueHigh.clear();
+    pTileset->_loadQueueMedium.clear();
+    pTileset->_loadQueueLow.clear();
+  }
+}
+
+void TilesetGroup::unloadCachedTiles() noexcept {
+  CESIUM_TRACE("TilesetGroup::unloadCachedTiles");
+
+  const int64_t maxBytes = this->_options.maximumCachedBytes;
+  int64_t totalBytes = this->getTotalDataBytes();
+  if (totalBytes <= maxBytes) {
+    return;
+  }
+
+  // Each tileset's list of loaded tiles starts with the tiles that were not
+  // used in its last frame, least recently used first, followed by the root
+  // tile. Merge these lists by the number of frames since each tile was last
+  // used in its tileset, so that the stalest tiles of the whole group are
+  // unloaded first, whichever tileset they belong to.
+  std::vector<Tile*> nextTiles;
+  nextTiles.reserve(this->_tilesets.size());
+  for (Tileset* pTileset : this->_tilesets) {
+    nextTiles.emplace_back(pTileset->_loadedTiles.head());
+  }
+
+  while (totalBytes > maxBytes) {
+    size_t stalest = this->_tilesets.size();
+    int64_t stalestAge = std::numeric_limits<int64_t>::min();
+    for (size_t i = 0; i < this->_tilesets.size(); ++i) {
+      const Tileset& tileset = *this->_tilesets[i];
+      const Tile* pTile = nextTiles[i];
+      if (pTile == nullptr || pTile == tileset._pRootTile.get()) {
+        continue;
+      }
+
+      const int64_t age =
+          int64_t(tileset._previousFrameNumber) -
+          int64_t(pTile->getLastSelectionState().getFrameNumber());
+      if (age > stalestAge) {
+        stalest = i;
+        stalestAge = age;
+      }
+    }
+
+    if (stalest == this->_tilesets.size()) {
+      // Only tiles used in the last frame of their tileset remain.
+      break;
+    }
+
+    Tileset& tileset = *this->_tilesets[stalest];
+    Tile*& pTile = nextTiles[stalest];
+    Tile* pNext = tileset._loadedTiles.next(*pTile);
+
+    const int64_t bytesBefore = tileset.getTotalDataBytes();
+    tileset._evictTile(*pTile);
+    totalBytes -= bytesBefore - tileset.getTotalDataBytes();
+
+    pTile = pNext;
+  }
+}
+
+void TilesetGroup::processLoadQueues() {
+  CESIUM_TRACE("TilesetGroup::processLoadQueues");
+
+  const uint32_t maximumLoadsInProgress =
+      this->_options.maximumSimultaneousTileLoads;
+  uint32_t loadsInProgress = this->getNumberOfLoadsInProgress();
+  if (loadsInProgress >= maximumLoadsInProgress) {
+    return;
+  }
+
+  // Merge the queues of all tilesets, so that the most important tiles of the
+  // whole group are loaded first.
+  std::vector<Tileset::LoadRecord> queue;
+  const auto processQueue =
+      [this, maximumLoadsInProgress, &loadsInProgress, &queue](
+          std::vector<Tileset::LoadRecord> Tileset::*pQueue) {
+        queue.clear();
+        for (Tileset* pTileset : this->_tilesets) {
+          const std::vector<Tileset::LoadRecord>& tilesetQueue =
+              pTileset->*pQueue;
+          queue.insert(queue.end(), tilesetQueue.begin(), tilesetQueue.end());
+        }
+
+        std::sort(queue.begin(), queue.end());
+
+        for (Tileset::LoadRecord& record : queue) {
+          if (loadsInProgress >= maximumLoadsInProgress) {
+            return false;
+          }
+
+          // A tile that is already loading starts no load, and an upsampled
+          // tile may start loading its parent instead, so count the loads
+          // that were actually started.
+          const Tileset& tileset = *record.pTile->getTileset();
+          const uint32_t tilesetLoadsBefore = tileset._loadsInProgress;
+          record.pTile->loadContent();
+          loadsInProgress += tileset._loadsInProgress - tilesetLoadsBefore;
+        }
+
+        return true;
+      };
+
+  if (processQueue(&Tileset::_loadQueueHigh) &&
+      processQueue(&Tileset::_loadQueueMedium)) {
+    processQueue(&Tileset::_loadQueueLow);
+  }
+}
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Cesium3DTilesSelection/TileContentFactory.h"
+
+#include <CesiumUtility/Metrics.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief The metrics that a {@link Tileset} records about loading and
+ * unloading tiles, looked up once from the
+ * {@link TilesetExternals::pMetrics} registry.
+ *
+ * Several tilesets may share a registry, so they add to the same metrics.
+ */
+struct TilesetMetrics {
+  explicit TilesetMetrics(
+      const std::shared_ptr<CesiumUtility::MetricsRegistry>& pRegistry_)
+      : pRegistry(pRegistry_),
+        contentQueueWait(pRegistry->getHistogram(
+            "cesium_tile_content_queue_wait_seconds",
+            "Time from receiving tile content until a worker thread starts "
+            "to process it.")),
+        prepareInLoadThread(pRegistry->getHistogram(
+            "cesium_tile_prepare_seconds",
+            "Time spent preparing tile content for rendering.",
+            {{"thread", "load"}})),
+        prepareInMainThread(pRegistry->getHistogram(
+            "cesium_tile_prepare_seconds",
+            "Time spent preparing tile content for rendering.",
+            {{"thread", "main"}})),
+        contentCacheWrite(pRegistry->getHistogram(
+            "cesium_tile_content_cache_write_seconds",
+            "Time spent serializing processed tile content and storing it in "
+            "the derived data cache.")),
+        tilesEvicted(pRegistry->getCounter(
+            "cesium_tiles_evicted_total",
+            "Tiles unloaded to keep the tile cache within its maximum size.")),
+        bytesEvicted(pRegistry->getCounter(
+            "cesium_tile_evicted_bytes_total",
+            "Bytes of tile content unloaded to keep the tile cache within its "
+            "maximum size.")),
+        tileContentBytes(pRegistry->getGauge(
+            "cesium_tileset_bytes",
+            "Bytes of loaded data held by tilesets.",
+            {{"category", "tile_content"}})),
+        rasterOverlayBytes(pRegistry->getGauge(
+            "cesium_tileset_bytes",
+            "Bytes of loaded data held by tilesets.",
+            {{"category", "raster_overlay"}})),
+        reportedRasterOverlayBytes(0) {
+    for (const std::string& contentType :
+         TileContentFactory::getRegisteredTypes()) {
+      this->decodeTimes.emplace(
+          contentType,
+          &lookUpDecodeTime(*this->pRegistry, contentType));
+    }
+  }
+
+  /**
+   * @brief Gets the histogram of the time spent decoding content of the given
+   * magic or content type.
+   *
+   * The histograms of the loaders that were registered with the
+   * {@link TileContentFactory} when this instance was created are looked up
+   * only once, so getting them does not take the lock of the registry.
+   */
+  CesiumUtility::LatencyHistogram&
+  getDecodeTime(const std::string& contentType) const {
+    auto it = this->decodeTimes.find(contentType);
+    if (it != this->decodeTimes.end()) {
+      return *it->second;
+    }
+    return lookUpDecodeTime(*this->pRegistry, contentType);
+  }
+
+  /**
+   * @brief The registry that holds the metrics, which is kept alive for as
+   * long as loads that record into it are in flight.
+   */
+  std::shared_ptr<CesiumUtility::MetricsRegistry> pRegistry;
+
+  CesiumUtility::LatencyHistogram& contentQueueWait;
+  CesiumUtility::LatencyHistogram& prepareInLoadThread;
+  CesiumUtility::LatencyHistogram& prepareInMainThread;
+  CesiumUtility::LatencyHistogram& contentCacheWrite;
+  CesiumUtility::MetricsCounter& tilesEvicted;
+  CesiumUtility::MetricsCounter& bytesEvicted;
+  CesiumUtility::MetricsGauge& tileContentBytes;
+  CesiumUtility::MetricsGauge& rasterOverlayBytes;
+
+  /**
+   * @brief The decode time histograms by magic or content type. Not modified
+   * after construction, so it can be read from any thread.
+   */
+  std::unordered_map<std::string, CesiumUtility::LatencyHistogram*>
+      decodeTimes;
+
+  /**
+   * @brief The raster overlay bytes of this tileset that have been added to
+   * {@link rasterOverlayBytes}. Only used in the main thread.
+   */
+  int64_t reportedRasterOverlayBytes;
+
+private:
+  static CesiumUtility::LatencyHistogram& lookUpDecodeTime(
+      CesiumUtility::MetricsRegistry& registry,
+      const std::string& contentType) {
+    return registry.getHistogram(
+        "cesium_tile_decode_seconds",
+        "Time spent parsing and decoding tile content before the loader "
+        "returns, by content type. Does not include requests for external "
+        "buffers and images.",
+        {{"content_type", contentType}});
+  }
+};
+
+} // namespace Cesium3DTilesSelection
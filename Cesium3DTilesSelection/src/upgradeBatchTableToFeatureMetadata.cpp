@@ -6,41 +6,27 @@
 #include <CesiumGltf/ExtensionModelExtFeatureMetadata.h>
 #include <CesiumGltf/Model.h>
 #include <CesiumGltf/PropertyType.h>
-#include <CesiumGltf/PropertyTypeTraits.h>
 #include <CesiumUtility/Tracing.h>
 
-#include <glm/glm.hpp>
 #include <rapidjson/document.h>
+#include <rapidjson/encodedstream.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
 #include <rapidjson/writer.h>
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <map>
+#include <memory>
+#include <optional>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 using namespace CesiumGltf;
 
 namespace {
-struct MaskedType {
-  bool isInt8 = true;
-  bool isUint8 = true;
-  bool isInt16 = true;
-  bool isUint16 = true;
-  bool isInt32 = true;
-  bool isUint32 = true;
-  bool isInt64 = true;
-  bool isUint64 = true;
-  bool isFloat32 = true;
-  bool isFloat64 = true;
-  bool isBool = true;
-  bool isArray = true;
-};
-
-struct CompatibleTypes {
-  MaskedType type;
-  std::optional<MaskedType> componentType;
-  std::optional<uint32_t> minComponentCount;
-  std::optional<uint32_t> maxComponentCount;
-};
-
 struct BinaryProperty {
   int64_t b3dmByteOffset;
   int64_t gltfByteOffset;
@@ -86,1063 +72,1073 @@ bool isInRangeForUnsignedInteger(uint64_t value) noexcept {
          value <= static_cast<uint64_t>(std::numeric_limits<T>::max());
 }
 
-template <typename OffsetType>
-void copyStringBuffer(
-    const rapidjson::StringBuffer& rapidjsonStrBuffer,
-    const std::vector<uint64_t>& rapidjsonOffsets,
-    std::vector<std::byte>& buffer,
-    std::vector<std::byte>& offsetBuffer) {
-  buffer.resize(rapidjsonStrBuffer.GetLength());
-  std::memcpy(buffer.data(), rapidjsonStrBuffer.GetString(), buffer.size());
-
-  offsetBuffer.resize(sizeof(OffsetType) * rapidjsonOffsets.size());
-  OffsetType* offset = reinterpret_cast<OffsetType*>(offsetBuffer.data());
-  for (size_t i = 0; i < rapidjsonOffsets.size(); ++i) {
-    offset[i] = static_cast<OffsetType>(rapidjsonOffsets[i]);
-  }
-}
+// A set of numeric property types, with one bit per PropertyType.
+using NumericTypeMask = uint32_t;
 
-CompatibleTypes findCompatibleTypes(const rapidjson::Value& propertyValue) {
-  MaskedType type;
-  std::optional<MaskedType> componentType;
-  std::optional<uint32_t> minComponentCount;
-  std::optional<uint32_t> maxComponentCount;
-  for (auto it = propertyValue.Begin(); it != propertyValue.End(); ++it) {
-    if (it->IsBool()) {
-      // Should we allow conversion of bools to numeric 0 or 1? Nah.
-      type.isInt8 = type.isUint8 = false;
-      type.isInt16 = type.isUint16 = false;
-      type.isInt32 = type.isUint32 = false;
-      type.isInt64 = type.isUint64 = false;
-      type.isFloat32 = false;
-      type.isFloat64 = false;
-      type.isBool = true;
-      type.isArray = false;
-    } else if (it->IsInt64()) {
-      const int64_t value = it->GetInt64();
-      type.isInt8 &= isInRangeForSignedInteger<int8_t>(value);
-      type.isUint8 &= isInRangeForSignedInteger<uint8_t>(value);
-      type.isInt16 &= isInRangeForSignedInteger<int16_t>(value);
-      type.isUint16 &= isInRangeForSignedInteger<uint16_t>(value);
-      type.isInt32 &= isInRangeForSignedInteger<int32_t>(value);
-      type.isUint32 &= isInRangeForSignedInteger<uint32_t>(value);
-      type.isInt64 &= true;
-      type.isUint64 &= value >= 0;
-      type.isFloat32 &= it->IsLosslessFloat();
-      type.isFloat64 &= it->IsLosslessDouble();
-      type.isBool = false;
-      type.isArray = false;
-    } else if (it->IsUint64()) {
-      // Only uint64_t can represent a value that fits in a uint64_t but not in
-      // an int64_t.
-      type.isInt8 = type.isUint8 = false;
-      type.isInt16 = type.isUint16 = false;
-      type.isInt32 = type.isUint32 = false;
-      type.isInt64 = false;
-      type.isUint64 = true;
-      type.isFloat32 = false;
-      type.isFloat64 = false;
-      type.isBool = false;
-      type.isArray = false;
-    } else if (it->IsLosslessFloat()) {
-      type.isInt8 = type.isUint8 = false;
-      type.isInt16 = type.isUint16 = false;
-      type.isInt32 = type.isUint32 = false;
-      type.isInt64 = type.isUint64 = false;
-      type.isFloat32 = true;
-      type.isFloat64 = true;
-      type.isBool = false;
-      type.isArray = false;
-    } else if (it->IsDouble()) {
-      type.isInt8 = type.isUint8 = false;
-      type.isInt16 = type.isUint16 = false;
-      type.isInt32 = type.isUint32 = false;
-      type.isInt64 = type.isUint64 = false;
-      type.isFloat32 = false;
-      type.isFloat64 = true;
-      type.isBool = false;
-      type.isArray = false;
-    } else if (it->IsArray()) {
-      type.isInt8 = type.isUint8 = false;
-      type.isInt16 = type.isUint16 = false;
-      type.isInt32 = type.isUint32 = false;
-      type.isInt64 = type.isUint64 = false;
-      type.isFloat32 = false;
-      type.isFloat64 = false;
-      type.isBool = false;
-      type.isArray &= true;
-      CompatibleTypes currentComponentType = findCompatibleTypes(*it);
-      if (!componentType) {
-        componentType = currentComponentType.type;
-      } else {
-        componentType->isInt8 &= currentComponentType.type.isInt8;
-        componentType->isUint8 &= currentComponentType.type.isUint8;
-        componentType->isInt16 &= currentComponentType.type.isInt16;
-        componentType->isUint16 &= currentComponentType.type.isUint16;
-        componentType->isInt32 &= currentComponentType.type.isInt32;
-        componentType->isUint32 &= currentComponentType.type.isUint32;
-        componentType->isInt64 &= currentComponentType.type.isInt64;
-        componentType->isUint64 &= currentComponentType.type.isUint64;
-        componentType->isFloat32 &= currentComponentType.type.isFloat32;
-        componentType->isFloat64 &= currentComponentType.type.isFloat64;
-        componentType->isBool &= currentComponentType.type.isBool;
-        componentType->isArray &= currentComponentType.type.isArray;
-      }
+constexpr NumericTypeMask typeBit(PropertyType type) noexcept {
+  return NumericTypeMask(1) << static_cast<uint32_t>(type);
+}
 
-      maxComponentCount = maxComponentCount
-                              ? glm::max(*maxComponentCount, it->Size())
-                              : it->Size();
-      minComponentCount = minComponentCount
-                              ? glm::min(*minComponentCount, it->Size())
-                              : it->Size();
-    } else {
-      // A string, null, or something else.
-      type.isInt8 = type.isUint8 = false;
-      type.isInt16 = type.isUint16 = false;
-      type.isInt32 = type.isUint32 = false;
-      type.isInt64 = type.isUint64 = false;
-      type.isFloat32 = false;
-      type.isFloat64 = false;
-      type.isBool = false;
-      type.isArray = false;
+constexpr NumericTypeMask allNumericTypes =
+    typeBit(PropertyType::Int8) | typeBit(PropertyType::Uint8) |
+    typeBit(PropertyType::Int16) | typeBit(PropertyType::Uint16) |
+    typeBit(PropertyType::Int32) | typeBit(PropertyType::Uint32) |
+    typeBit(PropertyType::Int64) | typeBit(PropertyType::Uint64) |
+    typeBit(PropertyType::Float32) | typeBit(PropertyType::Float64);
+
+NumericTypeMask getCompatibleTypes(const rapidjson::Value& value) noexcept {
+  if (value.IsInt64()) {
+    const int64_t number = value.GetInt64();
+    NumericTypeMask mask = typeBit(PropertyType::Int64);
+    if (isInRangeForSignedInteger<int8_t>(number)) {
+      mask |= typeBit(PropertyType::Int8);
+    }
+    if (isInRangeForSignedInteger<uint8_t>(number)) {
+      mask |= typeBit(PropertyType::Uint8);
+    }
+    if (isInRangeForSignedInteger<int16_t>(number)) {
+      mask |= typeBit(PropertyType::Int16);
+    }
+    if (isInRangeForSignedInteger<uint16_t>(number)) {
+      mask |= typeBit(PropertyType::Uint16);
+    }
+    if (isInRangeForSignedInteger<int32_t>(number)) {
+      mask |= typeBit(PropertyType::Int32);
     }
+    if (isInRangeForSignedInteger<uint32_t>(number)) {
+      mask |= typeBit(PropertyType::Uint32);
+    }
+    if (number >= 0) {
+      mask |= typeBit(PropertyType::Uint64);
+    }
+    if (value.IsLosslessFloat()) {
+      mask |= typeBit(PropertyType::Float32);
+    }
+    if (value.IsLosslessDouble()) {
+      mask |= typeBit(PropertyType::Float64);
+    }
+    return mask;
   }
 
-  return {type, componentType, minComponentCount, maxComponentCount};
-}
-
-void updateExtensionWithJsonStringProperty(
-    Model& gltf,
-    ClassProperty& classProperty,
-    const FeatureTable& featureTable,
-    FeatureTableProperty& featureTableProperty,
-    const rapidjson::Value& propertyValue) {
-  assert(propertyValue.Size() >= featureTable.count);
+  if (value.IsUint64()) {
+    // Only uint64_t can represent a value that fits in a uint64_t but not in
+    // an int64_t.
+    return typeBit(PropertyType::Uint64);
+  }
 
-  rapidjson::StringBuffer rapidjsonStrBuffer;
-  std::vector<uint64_t> rapidjsonOffsets;
-  rapidjsonOffsets.reserve(static_cast<size_t>(featureTable.count + 1));
-  rapidjsonOffsets.emplace_back(0);
+  if (value.IsLosslessFloat()) {
+    return typeBit(PropertyType::Float32) | typeBit(PropertyType::Float64);
+  }
 
-  auto it = propertyValue.Begin();
-  for (int64_t i = 0; i < featureTable.count; ++i) {
-    if (!it->IsString()) {
-      // Everything else that is not string will be serialized by json
-      rapidjson::Writer<rapidjson::StringBuffer> writer(rapidjsonStrBuffer);
-      it->Accept(writer);
-    } else {
-      // Because serialized string json will add double quotations in the buffer
-      // which is not needed by us, we will manually add the string to the
-      // buffer
-      const auto& rapidjsonStr = it->GetString();
-      rapidjsonStrBuffer.Reserve(it->GetStringLength());
-      for (rapidjson::SizeType j = 0; j < it->GetStringLength(); ++j) {
-        rapidjsonStrBuffer.PutUnsafe(rapidjsonStr[j]);
-      }
-    }
+  if (value.IsDouble()) {
+    return typeBit(PropertyType::Float64);
+  }
 
-    rapidjsonOffsets.emplace_back(rapidjsonStrBuffer.GetLength());
-    ++it;
-  }
-
-  const uint64_t totalSize = rapidjsonOffsets.back();
-  std::vector<std::byte> buffer;
-  std::vector<std::byte> offsetBuffer;
-  if (isInRangeForUnsignedInteger<uint8_t>(totalSize)) {
-    copyStringBuffer<uint8_t>(
-        rapidjsonStrBuffer,
-        rapidjsonOffsets,
-        buffer,
-        offsetBuffer);
-    featureTableProperty.offsetType = "UINT8";
-  } else if (isInRangeForUnsignedInteger<uint16_t>(totalSize)) {
-    copyStringBuffer<uint16_t>(
-        rapidjsonStrBuffer,
-        rapidjsonOffsets,
-        buffer,
-        offsetBuffer);
-    featureTableProperty.offsetType = "UINT16";
-  } else if (isInRangeForUnsignedInteger<uint32_t>(totalSize)) {
-    copyStringBuffer<uint32_t>(
-        rapidjsonStrBuffer,
-        rapidjsonOffsets,
-        buffer,
-        offsetBuffer);
-    featureTableProperty.offsetType = "UINT32";
-  } else {
-    copyStringBuffer<uint64_t>(
-        rapidjsonStrBuffer,
-        rapidjsonOffsets,
-        buffer,
-        offsetBuffer);
-    featureTableProperty.offsetType = "UINT64";
-  }
-
-  Buffer& gltfBuffer = gltf.buffers.emplace_back();
-  gltfBuffer.byteLength = static_cast<int64_t>(buffer.size());
-  gltfBuffer.cesium.data = std::move(buffer);
-
-  BufferView& gltfBufferView = gltf.bufferViews.emplace_back();
-  gltfBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-  gltfBufferView.byteOffset = 0;
-  gltfBufferView.byteLength = static_cast<int64_t>(totalSize);
-  const int32_t valueBufferViewIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
+  // Should we allow conversion of bools to numeric 0 or 1? Nah.
+  return 0;
+}
 
-  Buffer& gltfOffsetBuffer = gltf.buffers.emplace_back();
-  gltfOffsetBuffer.byteLength = static_cast<int64_t>(offsetBuffer.size());
-  gltfOffsetBuffer.cesium.data = std::move(offsetBuffer);
+// Gets the smallest type of a mask, preferring signed to unsigned. The types
+// are declared in this order in PropertyType.
+PropertyType getSmallestType(NumericTypeMask mask) noexcept {
+  for (PropertyType type = PropertyType::Int8; type <= PropertyType::Float64;
+       type = static_cast<PropertyType>(static_cast<int>(type) + 1)) {
+    if (mask & typeBit(type)) {
+      return type;
+    }
+  }
+  return PropertyType::None;
+}
 
-  BufferView& gltfOffsetBufferView = gltf.bufferViews.emplace_back();
-  gltfOffsetBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-  gltfOffsetBufferView.byteOffset = 0;
-  gltfOffsetBufferView.byteLength =
-      static_cast<int64_t>(gltfOffsetBuffer.cesium.data.size());
-  const int32_t offsetBufferViewIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
+template <typename Callback>
+void visitNumericType(PropertyType type, Callback&& callback) {
+  switch (type) {
+  case PropertyType::Int8:
+    callback(int8_t());
+    break;
+  case PropertyType::Uint8:
+    callback(uint8_t());
+    break;
+  case PropertyType::Int16:
+    callback(int16_t());
+    break;
+  case PropertyType::Uint16:
+    callback(uint16_t());
+    break;
+  case PropertyType::Int32:
+    callback(int32_t());
+    break;
+  case PropertyType::Uint32:
+    callback(uint32_t());
+    break;
+  case PropertyType::Int64:
+    callback(int64_t());
+    break;
+  case PropertyType::Uint64:
+    callback(uint64_t());
+    break;
+  case PropertyType::Float32:
+    callback(float());
+    break;
+  case PropertyType::Float64:
+    callback(double());
+    break;
+  default:
+    assert(false && "Not a numeric type");
+    break;
+  }
+}
 
-  classProperty.type = "STRING";
+template <typename T> T getNumber(const rapidjson::Value& value) noexcept {
+  if (value.IsInt64()) {
+    return static_cast<T>(value.GetInt64());
+  }
+  if (value.IsUint64()) {
+    return static_cast<T>(value.GetUint64());
+  }
+  return static_cast<T>(value.GetDouble());
+}
 
-  featureTableProperty.bufferView = valueBufferViewIdx;
-  featureTableProperty.stringOffsetBufferView = offsetBufferViewIdx;
+template <typename From, typename To>
+void convertNumbers(
+    const std::vector<std::byte>& source,
+    std::vector<std::byte>& target,
+    size_t count) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    From from;
+    std::memcpy(&from, source.data() + i * sizeof(From), sizeof(From));
+    const To to = static_cast<To>(from);
+    std::memcpy(target.data() + i * sizeof(To), &to, sizeof(To));
+  }
 }
 
-template <typename T, typename TRapidJson = T>
-void updateExtensionWithJsonNumericProperty(
-    Model& gltf,
-    ClassProperty& classProperty,
-    const FeatureTable& featureTable,
-    FeatureTableProperty& featureTableProperty,
-    const rapidjson::Value& propertyValue,
-    const std::string& typeName) {
-  assert(propertyValue.Size() >= featureTable.count);
+void appendOffset(std::vector<std::byte>& offsets, uint64_t offset) {
+  const size_t size = offsets.size();
+  offsets.resize(size + sizeof(uint64_t));
+  std::memcpy(offsets.data() + size, &offset, sizeof(uint64_t));
+}
 
-  classProperty.type = typeName;
+uint64_t getLastOffset(const std::vector<std::byte>& offsets) noexcept {
+  uint64_t offset = 0;
+  std::memcpy(
+      &offset,
+      offsets.data() + offsets.size() - sizeof(uint64_t),
+      sizeof(uint64_t));
+  return offset;
+}
 
-  // Create a new buffer for this property.
-  const size_t bufferIndex = gltf.buffers.size();
-  Buffer& buffer = gltf.buffers.emplace_back();
-  buffer.byteLength =
-      static_cast<int64_t>(sizeof(T) * static_cast<size_t>(featureTable.count));
-  buffer.cesium.data.resize(static_cast<size_t>(buffer.byteLength));
+PropertyType getOffsetType(uint64_t maxOffset) noexcept {
+  if (isInRangeForUnsignedInteger<uint8_t>(maxOffset)) {
+    return PropertyType::Uint8;
+  }
+  if (isInRangeForUnsignedInteger<uint16_t>(maxOffset)) {
+    return PropertyType::Uint16;
+  }
+  if (isInRangeForUnsignedInteger<uint32_t>(maxOffset)) {
+    return PropertyType::Uint32;
+  }
+  return PropertyType::Uint64;
+}
 
-  const size_t bufferViewIndex = gltf.bufferViews.size();
-  BufferView& bufferView = gltf.bufferViews.emplace_back();
-  bufferView.buffer = int32_t(bufferIndex);
-  bufferView.byteOffset = 0;
-  bufferView.byteLength = buffer.byteLength;
+size_t getOffsetTypeSize(PropertyType offsetType) noexcept {
+  switch (offsetType) {
+  case PropertyType::Uint8:
+    return sizeof(uint8_t);
+  case PropertyType::Uint16:
+    return sizeof(uint16_t);
+  case PropertyType::Uint32:
+    return sizeof(uint32_t);
+  default:
+    return sizeof(uint64_t);
+  }
+}
 
-  featureTableProperty.bufferView = int32_t(bufferViewIndex);
+// Rewrites offsets stored as uint64_t in place as OffsetType, multiplied by
+// the given scale. Each offset is written at or before the position it is
+// read from, so no other buffer is needed.
+template <typename OffsetType>
+void narrowOffsets(std::vector<std::byte>& offsets, uint64_t scale) noexcept {
+  const size_t count = offsets.size() / sizeof(uint64_t);
+  for (size_t i = 0; i < count; ++i) {
+    uint64_t offset;
+    std::memcpy(
+        &offset,
+        offsets.data() + i * sizeof(uint64_t),
+        sizeof(uint64_t));
+    const OffsetType narrowed = static_cast<OffsetType>(offset * scale);
+    std::memcpy(
+        offsets.data() + i * sizeof(OffsetType),
+        &narrowed,
+        sizeof(OffsetType));
+  }
+  offsets.resize(count * sizeof(OffsetType));
+}
 
-  T* p = reinterpret_cast<T*>(buffer.cesium.data.data());
-  auto it = propertyValue.Begin();
-  for (int64_t i = 0; i < featureTable.count; ++i) {
-    *p = static_cast<T>(it->Get<TRapidJson>());
-    ++p;
-    ++it;
+void narrowOffsets(
+    std::vector<std::byte>& offsets,
+    PropertyType offsetType,
+    uint64_t scale) noexcept {
+  switch (offsetType) {
+  case PropertyType::Uint8:
+    narrowOffsets<uint8_t>(offsets, scale);
+    break;
+  case PropertyType::Uint16:
+    narrowOffsets<uint16_t>(offsets, scale);
+    break;
+  case PropertyType::Uint32:
+    narrowOffsets<uint32_t>(offsets, scale);
+    break;
+  default:
+    narrowOffsets<uint64_t>(offsets, scale);
+    break;
   }
 }
 
-void updateExtensionWithJsonBoolProperty(
-    Model& gltf,
-    ClassProperty& classProperty,
-    const FeatureTable& featureTable,
-    FeatureTableProperty& featureTableProperty,
-    const rapidjson::Value& propertyValue) {
-  assert(propertyValue.Size() >= featureTable.count);
-
-  std::vector<std::byte> data(static_cast<size_t>(
-      glm::ceil(static_cast<double>(featureTable.count) / 8.0)));
-  const auto& jsonArray = propertyValue.GetArray();
-  for (rapidjson::SizeType i = 0;
-       i < static_cast<rapidjson::SizeType>(featureTable.count);
-       ++i) {
-    const bool value = jsonArray[i].GetBool();
-    const size_t byteIndex = i / 8;
-    const size_t bitIndex = i % 8;
-    data[byteIndex] =
-        static_cast<std::byte>(value << bitIndex) | data[byteIndex];
-  }
-
-  const size_t bufferIndex = gltf.buffers.size();
+int32_t addBufferView(Model& gltf, std::vector<std::byte>&& data) {
   Buffer& buffer = gltf.buffers.emplace_back();
   buffer.byteLength = static_cast<int64_t>(data.size());
   buffer.cesium.data = std::move(data);
 
   BufferView& bufferView = gltf.bufferViews.emplace_back();
-  bufferView.buffer = static_cast<int32_t>(bufferIndex);
+  bufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
   bufferView.byteOffset = 0;
   bufferView.byteLength = buffer.byteLength;
+  return static_cast<int32_t>(gltf.bufferViews.size() - 1);
+}
 
-  featureTableProperty.bufferView =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
+// A rapidjson output stream that appends to a byte buffer, so that values can
+// be serialized without an intermediate string.
+struct ByteOutputStream {
+  typedef char Ch;
 
-  classProperty.type = "BOOLEAN";
-}
+  std::vector<std::byte>& bytes;
 
-template <typename TRapidjson, typename ValueType, typename OffsetType>
-void copyNumericDynamicArrayBuffers(
-    std::vector<std::byte>& valueBuffer,
-    std::vector<std::byte>& offsetBuffer,
-    size_t numOfElements,
-    const FeatureTable& featureTable,
-    const rapidjson::Value& propertyValue) {
-  valueBuffer.resize(sizeof(ValueType) * numOfElements);
-  offsetBuffer.resize(
-      sizeof(OffsetType) * static_cast<size_t>(featureTable.count + 1));
-  ValueType* value = reinterpret_cast<ValueType*>(valueBuffer.data());
-  OffsetType* offsetValue = reinterpret_cast<OffsetType*>(offsetBuffer.data());
-  OffsetType prevOffset = 0;
-  const auto& jsonOuterArray = propertyValue.GetArray();
-  for (int64_t i = 0; i < featureTable.count; ++i) {
-    const auto& jsonArrayMember =
-        jsonOuterArray[static_cast<rapidjson::SizeType>(i)];
-    *offsetValue = prevOffset;
-    ++offsetValue;
-    for (const auto& valueJson : jsonArrayMember.GetArray()) {
-      *value = static_cast<ValueType>(valueJson.Get<TRapidjson>());
-      ++value;
+  void Put(Ch c) { bytes.push_back(static_cast<std::byte>(c)); }
+  void Flush() noexcept {}
+};
+
+/**
+ * Appends JSON numbers to a buffer of the smallest type that can represent
+ * all of them. When a value needs a wider type, the values already in the
+ * buffer are converted to it, which is exact because the wider type can
+ * represent them too.
+ */
+class NumericColumn {
+public:
+  explicit NumericColumn(size_t capacity) noexcept : _capacity{capacity} {}
+
+  bool add(const rapidjson::Value& value) {
+    const NumericTypeMask mask = this->_mask & getCompatibleTypes(value);
+    const PropertyType type = getSmallestType(mask);
+    if (type == PropertyType::None) {
+      return false;
     }
 
-    prevOffset = static_cast<OffsetType>(
-        prevOffset + jsonArrayMember.Size() * sizeof(ValueType));
+    if (type != this->_type) {
+      this->widen(type);
+    }
+    this->_mask = mask;
+
+    visitNumericType(type, [this, &value](auto zero) {
+      using T = decltype(zero);
+      const T number = getNumber<T>(value);
+      const size_t byteOffset = this->_data.size();
+      this->_data.resize(byteOffset + sizeof(T));
+      std::memcpy(this->_data.data() + byteOffset, &number, sizeof(T));
+    });
+    ++this->_size;
+    return true;
   }
 
-  *offsetValue = prevOffset;
-}
+  PropertyType getType() const noexcept { return this->_type; }
 
-template <typename TRapidjson, typename ValueType>
-void updateNumericArrayProperty(
-    Model& gltf,
-    ClassProperty& classProperty,
-    FeatureTableProperty& featureTableProperty,
-    const FeatureTable& featureTable,
-    const CompatibleTypes& compatibleTypes,
-    const rapidjson::Value& propertyValue) {
-  assert(propertyValue.Size() >= featureTable.count);
-  const auto& jsonOuterArray = propertyValue.GetArray();
-
-  // check if it's a fixed array
-  if (compatibleTypes.minComponentCount == compatibleTypes.maxComponentCount) {
-    const size_t numOfValues = static_cast<size_t>(featureTable.count) *
-                               *compatibleTypes.minComponentCount;
-    std::vector<std::byte> valueBuffer(sizeof(ValueType) * numOfValues);
-    ValueType* value = reinterpret_cast<ValueType*>(valueBuffer.data());
-    for (int64_t i = 0; i < featureTable.count; ++i) {
-      const auto& jsonArrayMember =
-          jsonOuterArray[static_cast<rapidjson::SizeType>(i)];
-      for (const auto& valueJson : jsonArrayMember.GetArray()) {
-        *value = static_cast<ValueType>(valueJson.Get<TRapidjson>());
-        ++value;
+  size_t size() const noexcept { return this->_size; }
+
+  std::vector<std::byte>& getData() noexcept { return this->_data; }
+
+private:
+  void widen(PropertyType type) {
+    visitNumericType(type, [this](auto toZero) {
+      using To = decltype(toZero);
+      std::vector<std::byte> data;
+      data.reserve(std::max(this->_size, this->_capacity) * sizeof(To));
+      data.resize(this->_size * sizeof(To));
+      if (this->_size > 0) {
+        visitNumericType(this->_type, [this, &data](auto fromZero) {
+          using From = decltype(fromZero);
+          convertNumbers<From, To>(this->_data, data, this->_size);
+        });
       }
+      this->_data = std::move(data);
+    });
+    this->_type = type;
+  }
+
+  NumericTypeMask _mask = allNumericTypes;
+  PropertyType _type = PropertyType::None;
+  size_t _size = 0;
+  size_t _capacity;
+  std::vector<std::byte> _data;
+};
+
+class BooleanColumn {
+public:
+  explicit BooleanColumn(size_t capacity) { this->_data.reserve(capacity / 8); }
+
+  bool add(const rapidjson::Value& value) {
+    if (!value.IsBool()) {
+      return false;
     }
 
-    Buffer& gltfValueBuffer = gltf.buffers.emplace_back();
-    gltfValueBuffer.byteLength = static_cast<int64_t>(valueBuffer.size());
-    gltfValueBuffer.cesium.data = std::move(valueBuffer);
+    const size_t bitIndex = this->_size % 8;
+    if (bitIndex == 0) {
+      this->_data.emplace_back();
+    }
+    if (value.GetBool()) {
+      this->_data.back() |= static_cast<std::byte>(1 << bitIndex);
+    }
+    ++this->_size;
+    return true;
+  }
 
-    BufferView& gltfValueBufferView = gltf.bufferViews.emplace_back();
-    gltfValueBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-    gltfValueBufferView.byteOffset = 0;
-    gltfValueBufferView.byteLength =
-        static_cast<int64_t>(gltfValueBuffer.cesium.data.size());
+  size_t size() const noexcept { return this->_size; }
 
-    classProperty.type = "ARRAY";
-    classProperty.componentType = convertPropertyTypeToString(
-        static_cast<PropertyType>(TypeToPropertyType<ValueType>::value));
-    classProperty.componentCount = *compatibleTypes.minComponentCount;
+  std::vector<std::byte>& getData() noexcept { return this->_data; }
 
-    featureTableProperty.bufferView =
-        static_cast<int32_t>(gltf.bufferViews.size() - 1);
+private:
+  size_t _size = 0;
+  std::vector<std::byte> _data;
+};
 
-    return;
+/**
+ * Appends strings to a buffer, and their end offsets as uint64_t to an offset
+ * buffer. The offsets are narrowed to the smallest offset type once all of
+ * the strings are known.
+ */
+class StringColumn {
+public:
+  explicit StringColumn(size_t capacity) : _stream{_data}, _writer(_stream) {
+    this->_offsets.reserve((capacity + 1) * sizeof(uint64_t));
+    appendOffset(this->_offsets, 0);
   }
 
-  // total size of value buffer
-  size_t numOfElements = 0;
-  for (int64_t i = 0; i < featureTable.count; ++i) {
-    const auto& jsonArrayMember =
-        jsonOuterArray[static_cast<rapidjson::SizeType>(i)];
-    numOfElements += jsonArrayMember.Size();
+  // The writer refers to the data, so a column cannot be copied or moved.
+  StringColumn(const StringColumn&) = delete;
+  StringColumn(StringColumn&&) = delete;
+  StringColumn& operator=(const StringColumn&) = delete;
+  StringColumn& operator=(StringColumn&&) = delete;
+
+  void add(const rapidjson::Value& value) {
+    if (value.IsString()) {
+      const std::byte* pChars =
+          reinterpret_cast<const std::byte*>(value.GetString());
+      this->_data.insert(
+          this->_data.end(),
+          pChars,
+          pChars + value.GetStringLength());
+    } else {
+      // Everything else that is not string will be serialized by json
+      value.Accept(this->startJsonValue());
+    }
+    this->endValue();
   }
 
-  PropertyType offsetType = PropertyType::None;
-  std::vector<std::byte> valueBuffer;
-  std::vector<std::byte> offsetBuffer;
-  const uint64_t maxOffsetValue = numOfElements * sizeof(ValueType);
-  if (isInRangeForUnsignedInteger<uint8_t>(maxOffsetValue)) {
-    copyNumericDynamicArrayBuffers<TRapidjson, ValueType, uint8_t>(
-        valueBuffer,
-        offsetBuffer,
-        numOfElements,
-        featureTable,
-        propertyValue);
-    offsetType = PropertyType::Uint8;
-  } else if (isInRangeForUnsignedInteger<uint16_t>(maxOffsetValue)) {
-    copyNumericDynamicArrayBuffers<TRapidjson, ValueType, uint16_t>(
-        valueBuffer,
-        offsetBuffer,
-        numOfElements,
-        featureTable,
-        propertyValue);
-    offsetType = PropertyType::Uint16;
-  } else if (isInRangeForUnsignedInteger<uint32_t>(maxOffsetValue)) {
-    copyNumericDynamicArrayBuffers<TRapidjson, ValueType, uint32_t>(
-        valueBuffer,
-        offsetBuffer,
-        numOfElements,
-        featureTable,
-        propertyValue);
-    offsetType = PropertyType::Uint32;
-  } else if (isInRangeForUnsignedInteger<uint64_t>(maxOffsetValue)) {
-    copyNumericDynamicArrayBuffers<TRapidjson, ValueType, uint64_t>(
-        valueBuffer,
-        offsetBuffer,
-        numOfElements,
-        featureTable,
-        propertyValue);
-    offsetType = PropertyType::Uint64;
+  // Starts a value that is serialized as JSON by the events sent to the
+  // returned writer, up to the next call to endValue.
+  rapidjson::Writer<ByteOutputStream>& startJsonValue() {
+    this->_writer.Reset(this->_stream);
+    return this->_writer;
   }
 
-  Buffer& gltfValueBuffer = gltf.buffers.emplace_back();
-  gltfValueBuffer.byteLength = static_cast<int64_t>(valueBuffer.size());
-  gltfValueBuffer.cesium.data = std::move(valueBuffer);
+  void endValue() { appendOffset(this->_offsets, this->_data.size()); }
 
-  BufferView& gltfValueBufferView = gltf.bufferViews.emplace_back();
-  gltfValueBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-  gltfValueBufferView.byteOffset = 0;
-  gltfValueBufferView.byteLength =
-      static_cast<int64_t>(gltfValueBuffer.cesium.data.size());
-  const int32_t valueBufferIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
+  void addEmpty() { appendOffset(this->_offsets, this->_data.size()); }
 
-  Buffer& gltfOffsetBuffer = gltf.buffers.emplace_back();
-  gltfOffsetBuffer.byteLength = static_cast<int64_t>(offsetBuffer.size());
-  gltfOffsetBuffer.cesium.data = std::move(offsetBuffer);
+  size_t size() const noexcept {
+    return this->_offsets.size() / sizeof(uint64_t) - 1;
+  }
 
-  BufferView& gltfOffsetBufferView = gltf.bufferViews.emplace_back();
-  gltfOffsetBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-  gltfOffsetBufferView.byteOffset = 0;
-  gltfOffsetBufferView.byteLength =
-      static_cast<int64_t>(gltfOffsetBuffer.cesium.data.size());
-  const int32_t offsetBufferIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
+  std::vector<std::byte>& getData() noexcept { return this->_data; }
 
-  classProperty.type = "ARRAY";
-  classProperty.componentType = convertPropertyTypeToString(
-      static_cast<PropertyType>(TypeToPropertyType<ValueType>::value));
+  std::vector<std::byte>& getOffsets() noexcept { return this->_offsets; }
 
-  featureTableProperty.bufferView = valueBufferIdx;
-  featureTableProperty.arrayOffsetBufferView = offsetBufferIdx;
-  featureTableProperty.offsetType = convertPropertyTypeToString(offsetType);
-}
+private:
+  std::vector<std::byte> _data;
+  std::vector<std::byte> _offsets;
+  ByteOutputStream _stream;
+  rapidjson::Writer<ByteOutputStream> _writer;
+};
 
-template <typename OffsetType>
-void copyStringArrayBuffers(
-    std::vector<std::byte>& valueBuffer,
-    std::vector<std::byte>& offsetBuffer,
-    size_t totalByteLength,
-    size_t numOfString,
-    const FeatureTable& featureTable,
-    const rapidjson::Value& propertyValue) {
-  valueBuffer.resize(totalByteLength);
-  offsetBuffer.resize((numOfString + 1) * sizeof(OffsetType));
-  OffsetType offset = 0;
-  size_t offsetIndex = 0;
-  const auto& jsonOuterArray = propertyValue.GetArray();
-  for (int64_t i = 0; i < featureTable.count; ++i) {
-    const auto& arrayMember =
-        jsonOuterArray[static_cast<rapidjson::SizeType>(i)];
-    for (const auto& str : arrayMember.GetArray()) {
-      OffsetType byteLength = static_cast<OffsetType>(
-          str.GetStringLength() * sizeof(rapidjson::Value::Ch));
-      std::memcpy(valueBuffer.data() + offset, str.GetString(), byteLength);
-      std::memcpy(
-          offsetBuffer.data() + offsetIndex * sizeof(OffsetType),
-          &offset,
-          sizeof(OffsetType));
-      offset = static_cast<OffsetType>(offset + byteLength);
-      ++offsetIndex;
+/**
+ * Appends JSON arrays of numbers, booleans or strings to the column of their
+ * components, and the offset of the end of each array, counted in components,
+ * to an offset buffer. The type of the components is given by the first
+ * component.
+ */
+class ArrayColumn {
+public:
+  enum class ComponentType { Unknown, Boolean, Numeric, String };
+
+  explicit ArrayColumn(size_t capacity)
+      : _numbers(0), _booleans(0), _strings(0) {
+    this->_arrayOffsets.reserve((capacity + 1) * sizeof(uint64_t));
+    appendOffset(this->_arrayOffsets, 0);
+  }
+
+  // Adds a component of the current array, and returns false if it does not
+  // fit the column.
+  bool addComponent(const rapidjson::Value& component) {
+    if (this->_componentType == ComponentType::Unknown) {
+      if (component.IsBool()) {
+        this->_componentType = ComponentType::Boolean;
+      } else if (component.IsNumber()) {
+        this->_componentType = ComponentType::Numeric;
+      } else if (component.IsString()) {
+        this->_componentType = ComponentType::String;
+      } else {
+        return false;
+      }
+    }
+
+    switch (this->_componentType) {
+    case ComponentType::Boolean:
+      return this->_booleans.add(component);
+    case ComponentType::Numeric:
+      return this->_numbers.add(component);
+    case ComponentType::String:
+      if (!component.IsString()) {
+        return false;
+      }
+      this->_strings.add(component);
+      return true;
+    default:
+      return false;
     }
   }
 
-  std::memcpy(
-      offsetBuffer.data() + offsetIndex * sizeof(OffsetType),
-      &offset,
-      sizeof(OffsetType));
-}
+  // Ends the current array, which has the given number of components.
+  void endArray(size_t componentCount) {
+    this->_minComponentCount =
+        std::min(this->_minComponentCount, componentCount);
+    this->_maxComponentCount =
+        std::max(this->_maxComponentCount, componentCount);
+    this->_totalComponentCount += componentCount;
+    appendOffset(this->_arrayOffsets, this->_totalComponentCount);
+  }
 
-template <typename OffsetType>
-void copyArrayOffsetBufferForStringArrayProperty(
-    std::vector<std::byte>& offsetBuffer,
-    const FeatureTable& featureTable,
-    const rapidjson::Value& propertyValue) {
-  OffsetType prevOffset = 0;
-  offsetBuffer.resize(
-      static_cast<size_t>(featureTable.count + 1) * sizeof(OffsetType));
-  OffsetType* offset = reinterpret_cast<OffsetType*>(offsetBuffer.data());
-  const auto& jsonOuterArray = propertyValue.GetArray();
-  for (int64_t i = 0; i < featureTable.count; ++i) {
-    const auto& arrayMember =
-        jsonOuterArray[static_cast<rapidjson::SizeType>(i)];
-    *offset = prevOffset;
-    prevOffset = static_cast<OffsetType>(
-        prevOffset + arrayMember.Size() * sizeof(OffsetType));
-    ++offset;
-  }
-
-  *offset = prevOffset;
-}
+  bool isFixedSize() const noexcept {
+    return this->_minComponentCount == this->_maxComponentCount;
+  }
 
-void updateStringArrayProperty(
-    Model& gltf,
-    ClassProperty& classProperty,
-    FeatureTableProperty& featureTableProperty,
-    const FeatureTable& featureTable,
-    const CompatibleTypes& compatibleTypes,
-    const rapidjson::Value& propertyValue) {
-  assert(propertyValue.Size() >= featureTable.count);
-
-  size_t numOfString = 0;
-  size_t totalChars = 0;
-  const auto& jsonOuterArray = propertyValue.GetArray();
-  for (int64_t i = 0; i < featureTable.count; ++i) {
-    const auto& arrayMember =
-        jsonOuterArray[static_cast<rapidjson::SizeType>(i)];
-    numOfString += arrayMember.Size();
-    for (const auto& str : arrayMember.GetArray()) {
-      totalChars += str.GetStringLength();
+  size_t getComponentCount() const noexcept {
+    return this->_minComponentCount;
+  }
+
+  ComponentType getComponentType() const noexcept {
+    return this->_componentType;
+  }
+
+  NumericColumn& getNumbers() noexcept { return this->_numbers; }
+
+  BooleanColumn& getBooleans() noexcept { return this->_booleans; }
+
+  StringColumn& getStrings() noexcept { return this->_strings; }
+
+  std::vector<std::byte>& getArrayOffsets() noexcept {
+    return this->_arrayOffsets;
+  }
+
+private:
+  ComponentType _componentType = ComponentType::Unknown;
+  size_t _minComponentCount = std::numeric_limits<size_t>::max();
+  size_t _maxComponentCount = 0;
+  uint64_t _totalComponentCount = 0;
+  NumericColumn _numbers;
+  BooleanColumn _booleans;
+  StringColumn _strings;
+  std::vector<std::byte> _arrayOffsets;
+};
+
+/**
+ * Receives the SAX events of a JSON property of the batch table, starting
+ * with the array that holds its values, and adds the first count values to a
+ * column of the type of the first value.
+ *
+ * When a value does not fit that column, or there are fewer values than
+ * features, the column becomes invalid and the values have to be read again
+ * by a handler that stores all of them as strings.
+ */
+class JsonPropertyHandler
+    : public rapidjson::
+          BaseReaderHandler<rapidjson::UTF8<>, JsonPropertyHandler> {
+public:
+  enum class ColumnType { Unknown, Boolean, Numeric, Array, String, Invalid };
+
+  JsonPropertyHandler(size_t count, bool stringsOnly) : _count{count} {
+    if (stringsOnly) {
+      this->setType(ColumnType::String);
     }
   }
 
-  const uint64_t totalByteLength = totalChars * sizeof(rapidjson::Value::Ch);
-  std::vector<std::byte> valueBuffer;
-  std::vector<std::byte> offsetBuffer;
-  PropertyType offsetType = PropertyType::None;
-  if (isInRangeForUnsignedInteger<uint8_t>(totalByteLength)) {
-    copyStringArrayBuffers<uint8_t>(
-        valueBuffer,
-        offsetBuffer,
-        totalByteLength,
-        numOfString,
-        featureTable,
-        propertyValue);
-    offsetType = PropertyType::Uint8;
-  } else if (isInRangeForUnsignedInteger<uint16_t>(totalByteLength)) {
-    copyStringArrayBuffers<uint16_t>(
-        valueBuffer,
-        offsetBuffer,
-        totalByteLength,
-        numOfString,
-        featureTable,
-        propertyValue);
-    offsetType = PropertyType::Uint16;
-  } else if (isInRangeForUnsignedInteger<uint32_t>(totalByteLength)) {
-    copyStringArrayBuffers<uint32_t>(
-        valueBuffer,
-        offsetBuffer,
-        totalByteLength,
-        numOfString,
-        featureTable,
-        propertyValue);
-    offsetType = PropertyType::Uint32;
-  } else if (isInRangeForUnsignedInteger<uint64_t>(totalByteLength)) {
-    copyStringArrayBuffers<uint64_t>(
-        valueBuffer,
-        offsetBuffer,
-        totalByteLength,
-        numOfString,
-        featureTable,
-        propertyValue);
-    offsetType = PropertyType::Uint64;
+  bool Null() { return this->addScalar(rapidjson::Value()); }
+  bool Bool(bool b) { return this->addScalar(rapidjson::Value(b)); }
+  bool Int(int i) { return this->addScalar(rapidjson::Value(i)); }
+  bool Uint(unsigned i) { return this->addScalar(rapidjson::Value(i)); }
+  bool Int64(int64_t i) { return this->addScalar(rapidjson::Value(i)); }
+  bool Uint64(uint64_t i) { return this->addScalar(rapidjson::Value(i)); }
+  bool Double(double d) { return this->addScalar(rapidjson::Value(d)); }
+
+  bool String(const char* str, rapidjson::SizeType length, bool) {
+    return this->addScalar(rapidjson::Value(str, length));
   }
 
-  // create gltf value buffer view
-  Buffer& gltfValueBuffer = gltf.buffers.emplace_back();
-  gltfValueBuffer.byteLength = static_cast<int64_t>(valueBuffer.size());
-  gltfValueBuffer.cesium.data = std::move(valueBuffer);
+  bool Key(const char* str, rapidjson::SizeType length, bool) {
+    if (this->_pWriter) {
+      this->_pWriter->Key(str, length);
+    }
+    return true;
+  }
 
-  BufferView& gltfValueBufferView = gltf.bufferViews.emplace_back();
-  gltfValueBufferView.buffer =
-      static_cast<std::int32_t>(gltf.buffers.size() - 1);
-  gltfValueBufferView.byteOffset = 0;
-  gltfValueBufferView.byteLength = gltfValueBuffer.byteLength;
-  const int32_t valueBufferViewIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
+  bool StartObject() { return this->startContainer(false); }
 
-  // create gltf string offset buffer view
-  Buffer& gltfOffsetBuffer = gltf.buffers.emplace_back();
-  gltfOffsetBuffer.byteLength = static_cast<int64_t>(offsetBuffer.size());
-  gltfOffsetBuffer.cesium.data = std::move(offsetBuffer);
+  bool EndObject(rapidjson::SizeType memberCount) {
+    return this->endContainer(false, memberCount);
+  }
 
-  BufferView& gltfOffsetBufferView = gltf.bufferViews.emplace_back();
-  gltfOffsetBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-  gltfOffsetBufferView.byteOffset = 0;
-  gltfOffsetBufferView.byteLength = gltfOffsetBuffer.byteLength;
-  const int32_t offsetBufferViewIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
+  bool StartArray() { return this->startContainer(true); }
 
-  // fixed array of string
-  if (compatibleTypes.minComponentCount == compatibleTypes.maxComponentCount) {
-    classProperty.type = "ARRAY";
-    classProperty.componentCount = compatibleTypes.minComponentCount;
-    classProperty.componentType = "STRING";
+  bool EndArray(rapidjson::SizeType elementCount) {
+    return this->endContainer(true, elementCount);
+  }
 
-    featureTableProperty.bufferView = valueBufferViewIdx;
-    featureTableProperty.stringOffsetBufferView = offsetBufferViewIdx;
-    featureTableProperty.offsetType = convertPropertyTypeToString(offsetType);
-    return;
+  bool addScalar(const rapidjson::Value& value) {
+    if (this->_depth == 1) {
+      if (this->beginValue()) {
+        this->addValue(value);
+      }
+    } else if (this->_pWriter) {
+      value.Accept(*this->_pWriter);
+    } else if (this->_depth == 2 && !this->_skipping) {
+      // Only array values are added to the column with their contents, so
+      // this is a component of an array.
+      if (!this->_arrays->addComponent(value)) {
+        this->invalidate();
+      }
+    }
+    return true;
   }
 
-  // dynamic array of string needs array offset buffer
-  std::vector<std::byte> arrayOffsetBuffer;
-  switch (offsetType) {
-  case PropertyType::Uint8:
-    copyArrayOffsetBufferForStringArrayProperty<uint8_t>(
-        arrayOffsetBuffer,
-        featureTable,
-        propertyValue);
-    break;
-  case PropertyType::Uint16:
-    copyArrayOffsetBufferForStringArrayProperty<uint16_t>(
-        arrayOffsetBuffer,
-        featureTable,
-        propertyValue);
-    break;
-  case PropertyType::Uint32:
-    copyArrayOffsetBufferForStringArrayProperty<uint32_t>(
-        arrayOffsetBuffer,
-        featureTable,
-        propertyValue);
-    break;
-  case PropertyType::Uint64:
-    copyArrayOffsetBufferForStringArrayProperty<uint64_t>(
-        arrayOffsetBuffer,
-        featureTable,
-        propertyValue);
-    break;
-  default:
-    break;
+  // Whether all events of the property, up to the end of its array, have been
+  // received.
+  bool isDone() const noexcept { return this->_depth == 0; }
+
+  bool needsStrings() const noexcept {
+    switch (this->_type) {
+    case ColumnType::Unknown:
+    case ColumnType::String:
+      return false;
+    case ColumnType::Invalid:
+      return true;
+    default:
+      return this->_valueCount < this->_count;
+    }
   }
 
-  // create gltf array offset buffer view
-  Buffer& gltfArrayOffsetBuffer = gltf.buffers.emplace_back();
-  gltfArrayOffsetBuffer.byteLength =
-      static_cast<int64_t>(arrayOffsetBuffer.size());
-  gltfArrayOffsetBuffer.cesium.data = std::move(arrayOffsetBuffer);
+  ColumnType getType() const noexcept { return this->_type; }
 
-  BufferView& gltfArrayOffsetBufferView = gltf.bufferViews.emplace_back();
-  gltfArrayOffsetBufferView.buffer =
-      static_cast<int32_t>(gltf.buffers.size() - 1);
-  gltfArrayOffsetBufferView.byteOffset = 0;
-  gltfArrayOffsetBufferView.byteLength = gltfArrayOffsetBuffer.byteLength;
-  const int32_t arrayOffsetBufferViewIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
+  BooleanColumn& getBooleans() noexcept { return *this->_booleans; }
 
-  classProperty.type = "ARRAY";
-  classProperty.componentType = "STRING";
+  NumericColumn& getNumbers() noexcept { return *this->_numbers; }
 
-  featureTableProperty.bufferView = valueBufferViewIdx;
-  featureTableProperty.arrayOffsetBufferView = arrayOffsetBufferViewIdx;
-  featureTableProperty.stringOffsetBufferView = offsetBufferViewIdx;
-  featureTableProperty.offsetType = convertPropertyTypeToString(offsetType);
-}
+  ArrayColumn& getArrays() noexcept { return *this->_arrays; }
 
-template <typename OffsetType>
-void copyBooleanArrayBuffers(
-    std::vector<std::byte>& valueBuffer,
-    std::vector<std::byte>& offsetBuffer,
-    size_t numOfElements,
-    const FeatureTable& featureTable,
-    const rapidjson::Value& propertyValue) {
-  size_t currentIndex = 0;
-  const size_t totalByteLength =
-      static_cast<size_t>(glm::ceil(static_cast<double>(numOfElements) / 8.0));
-  valueBuffer.resize(totalByteLength);
-  offsetBuffer.resize(
-      static_cast<size_t>(featureTable.count + 1) * sizeof(OffsetType));
-  OffsetType* offset = reinterpret_cast<OffsetType*>(offsetBuffer.data());
-  OffsetType prevOffset = 0;
-  const auto& jsonOuterArray = propertyValue.GetArray();
-  for (int64_t i = 0; i < featureTable.count; ++i) {
-    const auto& arrayMember =
-        jsonOuterArray[static_cast<rapidjson::SizeType>(i)];
-
-    *offset = prevOffset;
-    ++offset;
-    prevOffset = static_cast<OffsetType>(prevOffset + arrayMember.Size());
-    for (const auto& data : arrayMember.GetArray()) {
-      const bool value = data.GetBool();
-      const size_t byteIndex = currentIndex / 8;
-      const size_t bitIndex = currentIndex % 8;
-      valueBuffer[byteIndex] =
-          static_cast<std::byte>(value << bitIndex) | valueBuffer[byteIndex];
-      ++currentIndex;
+  StringColumn& getStrings() {
+    if (!this->_strings) {
+      this->_strings.emplace(this->_count);
     }
+    return *this->_strings;
   }
 
-  *offset = prevOffset;
-}
+private:
+  void setType(ColumnType type) {
+    this->_type = type;
+    switch (type) {
+    case ColumnType::Boolean:
+      this->_booleans.emplace(this->_count);
+      break;
+    case ColumnType::Numeric:
+      this->_numbers.emplace(this->_count);
+      break;
+    case ColumnType::Array:
+      this->_arrays.emplace(this->_count);
+      break;
+    case ColumnType::String:
+      this->_strings.emplace(this->_count);
+      break;
+    default:
+      break;
+    }
+  }
 
-void updateBooleanArrayProperty(
-    Model& gltf,
-    ClassProperty& classProperty,
-    FeatureTableProperty& featureTableProperty,
-    const FeatureTable& featureTable,
-    const CompatibleTypes& compatibleTypes,
-    const rapidjson::Value& propertyValue) {
-  assert(propertyValue.Size() >= featureTable.count);
-
-  // fixed array of boolean
-  if (compatibleTypes.minComponentCount == compatibleTypes.maxComponentCount) {
-    const size_t numOfElements = static_cast<size_t>(
-        featureTable.count * compatibleTypes.minComponentCount.value());
-    const size_t totalByteLength = static_cast<size_t>(
-        glm::ceil(static_cast<double>(numOfElements) / 8.0));
-    std::vector<std::byte> valueBuffer(totalByteLength);
-    size_t currentIndex = 0;
-    const auto& jsonOuterArray = propertyValue.GetArray();
-    for (int64_t i = 0; i < featureTable.count; ++i) {
-      const auto& arrayMember =
-          jsonOuterArray[static_cast<rapidjson::SizeType>(i)];
-      for (const auto& data : arrayMember.GetArray()) {
-        const bool value = data.GetBool();
-        const size_t byteIndex = currentIndex / 8;
-        const size_t bitIndex = currentIndex % 8;
-        valueBuffer[byteIndex] =
-            static_cast<std::byte>(value << bitIndex) | valueBuffer[byteIndex];
-        ++currentIndex;
+  void invalidate() {
+    this->_type = ColumnType::Invalid;
+    this->_skipping = true;
+    this->_booleans.reset();
+    this->_numbers.reset();
+    this->_arrays.reset();
+  }
+
+  // Starts the next value of the property, and returns whether it is added to
+  // the column.
+  bool beginValue() noexcept {
+    this->_skipping = this->_valueCount++ >= this->_count ||
+                      this->_type == ColumnType::Invalid;
+    return !this->_skipping;
+  }
+
+  void addValue(const rapidjson::Value& value) {
+    if (this->_type == ColumnType::Unknown) {
+      if (value.IsBool()) {
+        this->setType(ColumnType::Boolean);
+      } else if (value.IsNumber()) {
+        this->setType(ColumnType::Numeric);
+      } else {
+        this->setType(ColumnType::String);
       }
     }
 
-    Buffer& gltfValueBuffer = gltf.buffers.emplace_back();
-    gltfValueBuffer.byteLength = static_cast<int64_t>(valueBuffer.size());
-    gltfValueBuffer.cesium.data = std::move(valueBuffer);
+    bool added = true;
+    switch (this->_type) {
+    case ColumnType::Boolean:
+      added = this->_booleans->add(value);
+      break;
+    case ColumnType::Numeric:
+      added = this->_numbers->add(value);
+      break;
+    case ColumnType::String:
+      this->_strings->add(value);
+      break;
+    default:
+      added = false;
+      break;
+    }
 
-    BufferView& gltfValueBufferView = gltf.bufferViews.emplace_back();
-    gltfValueBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-    gltfValueBufferView.byteOffset = 0;
-    gltfValueBufferView.byteLength = gltfValueBuffer.byteLength;
+    if (!added) {
+      this->invalidate();
+    }
+  }
 
-    classProperty.type = "ARRAY";
-    classProperty.componentCount = compatibleTypes.minComponentCount;
-    classProperty.componentType = "BOOLEAN";
+  bool startContainer(bool isArray) {
+    if (this->_depth == 1 && this->beginValue()) {
+      if (this->_type == ColumnType::Unknown) {
+        this->setType(isArray ? ColumnType::Array : ColumnType::String);
+      }
+      if (this->_type == ColumnType::String) {
+        this->_pWriter = &this->_strings->startJsonValue();
+      } else if (this->_type != ColumnType::Array || !isArray) {
+        this->invalidate();
+      }
+    } else if (this->_depth == 2 && !this->_skipping && !this->_pWriter) {
+      // The components of an array can only be numbers, booleans or strings.
+      this->invalidate();
+    }
 
-    featureTableProperty.bufferView =
-        static_cast<int32_t>(gltf.bufferViews.size() - 1);
+    ++this->_depth;
+    if (this->_pWriter) {
+      if (isArray) {
+        this->_pWriter->StartArray();
+      } else {
+        this->_pWriter->StartObject();
+      }
+    }
+    return true;
+  }
 
-    return;
+  bool endContainer(bool isArray, rapidjson::SizeType count) {
+    --this->_depth;
+    if (this->_pWriter) {
+      if (isArray) {
+        this->_pWriter->EndArray(count);
+      } else {
+        this->_pWriter->EndObject(count);
+      }
+      if (this->_depth == 1) {
+        this->_strings->endValue();
+        this->_pWriter = nullptr;
+      }
+    } else if (this->_depth == 1 && !this->_skipping) {
+      this->_arrays->endArray(count);
+    }
+    return true;
   }
 
-  // dynamic array of boolean
-  size_t numOfElements = 0;
-  const auto& jsonOuterArray = propertyValue.GetArray();
-  for (int64_t i = 0; i < featureTable.count; ++i) {
-    const auto& arrayMember =
-        jsonOuterArray[static_cast<rapidjson::SizeType>(i)];
-    numOfElements += arrayMember.Size();
+  size_t _count;
+  ColumnType _type = ColumnType::Unknown;
+
+  // 0 outside of the array of the property, 1 in between its values, and
+  // more within a value.
+  size_t _depth = 0;
+  size_t _valueCount = 0;
+  bool _skipping = false;
+  rapidjson::Writer<ByteOutputStream>* _pWriter = nullptr;
+
+  std::optional<BooleanColumn> _booleans;
+  std::optional<NumericColumn> _numbers;
+  std::optional<ArrayColumn> _arrays;
+  std::optional<StringColumn> _strings;
+};
+
+// A property of the batch table, as it is read from the JSON. JSON properties
+// have their values, and binary properties the fields of their descriptor
+// that are valid.
+struct BatchTableProperty {
+  std::string name;
+  std::unique_ptr<JsonPropertyHandler> pJsonProperty;
+  std::optional<int64_t> byteOffset;
+  std::optional<std::string> componentType;
+  std::optional<std::string> type;
+};
+
+/**
+ * Reads the batch table JSON in a single pass. The values of each JSON
+ * property are added to a column as they are read, and the descriptors of
+ * binary properties are recorded, so no document is built.
+ *
+ * The values of a JSON property that has to be stored as strings after all
+ * are read again from the part of the JSON that holds its array.
+ */
+class BatchTableHandler
+    : public rapidjson::
+          BaseReaderHandler<rapidjson::UTF8<>, BatchTableHandler> {
+public:
+  BatchTableHandler(
+      const gsl::span<const std::byte>& json,
+      const rapidjson::MemoryStream& stream,
+      size_t count) noexcept
+      : _json{json}, _stream{stream}, _count{count} {}
+
+  bool Null() { return this->addScalar(rapidjson::Value()); }
+  bool Bool(bool b) { return this->addScalar(rapidjson::Value(b)); }
+  bool Int(int i) { return this->addScalar(rapidjson::Value(i)); }
+  bool Uint(unsigned i) { return this->addScalar(rapidjson::Value(i)); }
+  bool Int64(int64_t i) { return this->addScalar(rapidjson::Value(i)); }
+  bool Uint64(uint64_t i) { return this->addScalar(rapidjson::Value(i)); }
+  bool Double(double d) { return this->addScalar(rapidjson::Value(d)); }
+
+  bool String(const char* str, rapidjson::SizeType length, bool) {
+    return this->addScalar(rapidjson::Value(str, length));
   }
 
-  std::vector<std::byte> valueBuffer;
-  std::vector<std::byte> offsetBuffer;
-  PropertyType offsetType = PropertyType::None;
-  if (isInRangeForUnsignedInteger<uint8_t>(numOfElements)) {
-    copyBooleanArrayBuffers<uint8_t>(
-        valueBuffer,
-        offsetBuffer,
-        numOfElements,
-        featureTable,
-        propertyValue);
-    offsetType = PropertyType::Uint8;
-  } else if (isInRangeForUnsignedInteger<uint16_t>(numOfElements)) {
-    copyBooleanArrayBuffers<uint16_t>(
-        valueBuffer,
-        offsetBuffer,
-        numOfElements,
-        featureTable,
-        propertyValue);
-    offsetType = PropertyType::Uint16;
-  } else if (isInRangeForUnsignedInteger<uint32_t>(numOfElements)) {
-    copyBooleanArrayBuffers<uint32_t>(
-        valueBuffer,
-        offsetBuffer,
-        numOfElements,
-        featureTable,
-        propertyValue);
-    offsetType = PropertyType::Uint32;
-  } else {
-    copyBooleanArrayBuffers<uint64_t>(
-        valueBuffer,
-        offsetBuffer,
-        numOfElements,
-        featureTable,
-        propertyValue);
-    offsetType = PropertyType::Uint64;
+  bool Key(const char* str, rapidjson::SizeType length, bool copy) {
+    if (this->_depth == 1 ||
+        (this->_depth == 2 && this->_mode == Mode::Binary)) {
+      this->_key.assign(str, length);
+    } else if (this->_mode == Mode::Json) {
+      this->_pJsonProperty->Key(str, length, copy);
+    }
+    return true;
   }
 
-  Buffer& gltfValueBuffer = gltf.buffers.emplace_back();
-  gltfValueBuffer.byteLength = static_cast<int64_t>(valueBuffer.size());
-  gltfValueBuffer.cesium.data = std::move(valueBuffer);
+  bool StartObject() { return this->startContainer(false); }
 
-  BufferView& gltfValueBufferView = gltf.bufferViews.emplace_back();
-  gltfValueBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-  gltfValueBufferView.byteOffset = 0;
-  gltfValueBufferView.byteLength =
-      static_cast<int64_t>(gltfValueBuffer.cesium.data.size());
-  const int32_t valueBufferIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
+  bool EndObject(rapidjson::SizeType memberCount) {
+    return this->endContainer(false, memberCount);
+  }
 
-  Buffer& gltfOffsetBuffer = gltf.buffers.emplace_back();
-  gltfOffsetBuffer.byteLength = static_cast<int64_t>(offsetBuffer.size());
-  gltfOffsetBuffer.cesium.data = std::move(offsetBuffer);
+  bool StartArray() { return this->startContainer(true); }
 
-  BufferView& gltfOffsetBufferView = gltf.bufferViews.emplace_back();
-  gltfOffsetBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-  gltfOffsetBufferView.byteOffset = 0;
-  gltfOffsetBufferView.byteLength =
-      static_cast<int64_t>(gltfOffsetBuffer.cesium.data.size());
-  const int32_t offsetBufferIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
+  bool EndArray(rapidjson::SizeType elementCount) {
+    return this->endContainer(true, elementCount);
+  }
 
-  classProperty.type = "ARRAY";
-  classProperty.componentType = "BOOLEAN";
+  std::vector<BatchTableProperty>& getProperties() noexcept {
+    return this->_properties;
+  }
+
+private:
+  enum class Mode { Skip, Binary, Json };
+
+  // Starts the property named by the last key.
+  void beginProperty(Mode mode) {
+    // Don't interpret extensions or extras as a property.
+    if (this->_key == "extensions" || this->_key == "extras") {
+      this->_mode = Mode::Skip;
+      return;
+    }
+
+    BatchTableProperty& property = this->_properties.emplace_back();
+    property.name = this->_key;
+    if (mode == Mode::Json) {
+      property.pJsonProperty =
+          std::make_unique<JsonPropertyHandler>(this->_count, false);
+      this->_pJsonProperty = property.pJsonProperty.get();
+
+      // The stream is just past the opening bracket of the array.
+      this->_propertyStart = this->_stream.Tell() - 1;
+    }
+    this->_mode = mode;
+  }
+
+  void endJsonProperty() {
+    if (this->_pJsonProperty->needsStrings()) {
+      const size_t propertyEnd = this->_stream.Tell();
+      rapidjson::MemoryStream stream(
+          reinterpret_cast<const char*>(this->_json.data()) +
+              this->_propertyStart,
+          propertyEnd - this->_propertyStart);
+      std::unique_ptr<JsonPropertyHandler> pStrings =
+          std::make_unique<JsonPropertyHandler>(this->_count, true);
+      rapidjson::Reader reader;
+      reader.Parse(stream, *pStrings);
+      this->_properties.back().pJsonProperty = std::move(pStrings);
+    }
+    this->_pJsonProperty = nullptr;
+  }
+
+  void addBinaryPropertyField(const rapidjson::Value& value) {
+    BatchTableProperty& property = this->_properties.back();
+    if (this->_key == "byteOffset" && value.IsInt64()) {
+      property.byteOffset = value.GetInt64();
+    } else if (this->_key == "componentType" && value.IsString()) {
+      property.componentType.emplace(
+          value.GetString(),
+          value.GetStringLength());
+    } else if (this->_key == "type" && value.IsString()) {
+      property.type.emplace(value.GetString(), value.GetStringLength());
+    }
+  }
+
+  bool addScalar(const rapidjson::Value& value) {
+    if (this->_depth == 0) {
+      // The batch table is not an object.
+      return false;
+    }
+
+    if (this->_depth == 1) {
+      // A property that is neither an array nor an object is a binary
+      // property without a descriptor.
+      this->beginProperty(Mode::Binary);
+    } else if (this->_mode == Mode::Json) {
+      this->_pJsonProperty->addScalar(value);
+    } else if (this->_mode == Mode::Binary && this->_depth == 2) {
+      this->addBinaryPropertyField(value);
+    }
+    return true;
+  }
+
+  bool startContainer(bool isArray) {
+    if (this->_depth == 0 && isArray) {
+      // The batch table is not an object.
+      return false;
+    }
+
+    if (this->_depth == 1) {
+      this->beginProperty(isArray ? Mode::Json : Mode::Binary);
+    }
+    if (this->_depth >= 1 && this->_mode == Mode::Json) {
+      if (isArray) {
+        this->_pJsonProperty->StartArray();
+      } else {
+        this->_pJsonProperty->StartObject();
+      }
+    }
+    ++this->_depth;
+    return true;
+  }
 
-  featureTableProperty.bufferView = valueBufferIdx;
-  featureTableProperty.arrayOffsetBufferView = offsetBufferIdx;
+  bool endContainer(bool isArray, rapidjson::SizeType count) {
+    --this->_depth;
+    if (this->_depth >= 1 && this->_mode == Mode::Json) {
+      if (isArray) {
+        this->_pJsonProperty->EndArray(count);
+      } else {
+        this->_pJsonProperty->EndObject(count);
+      }
+      if (this->_pJsonProperty->isDone()) {
+        this->endJsonProperty();
+        this->_mode = Mode::Skip;
+      }
+    }
+    return true;
+  }
+
+  gsl::span<const std::byte> _json;
+  const rapidjson::MemoryStream& _stream;
+  size_t _count;
+
+  // 0 outside of the batch table, 1 in between its properties, and more
+  // within a property.
+  size_t _depth = 0;
+  Mode _mode = Mode::Skip;
+  std::string _key;
+  JsonPropertyHandler* _pJsonProperty = nullptr;
+  size_t _propertyStart = 0;
+  std::vector<BatchTableProperty> _properties;
+};
+
+void updateExtensionWithJsonStringProperty(
+    Model& gltf,
+    ClassProperty& classProperty,
+    const FeatureTable& featureTable,
+    FeatureTableProperty& featureTableProperty,
+    StringColumn& column) {
+  // Features without a value get an empty string.
+  while (static_cast<int64_t>(column.size()) < featureTable.count) {
+    column.addEmpty();
+  }
+
+  const PropertyType offsetType = getOffsetType(column.getData().size());
+  narrowOffsets(column.getOffsets(), offsetType, 1);
+
+  classProperty.type = "STRING";
+
+  featureTableProperty.bufferView =
+      addBufferView(gltf, std::move(column.getData()));
+  featureTableProperty.stringOffsetBufferView =
+      addBufferView(gltf, std::move(column.getOffsets()));
   featureTableProperty.offsetType = convertPropertyTypeToString(offsetType);
 }
 
-void updateExtensionWithArrayProperty(
+void updateExtensionWithNumericColumn(
     Model& gltf,
     ClassProperty& classProperty,
-    const FeatureTable& featureTable,
     FeatureTableProperty& featureTableProperty,
-    const CompatibleTypes& compatibleTypes,
-    const rapidjson::Value& propertyValue) {
-  assert(propertyValue.Size() >= featureTable.count);
+    NumericColumn& column) {
+  classProperty.type = convertPropertyTypeToString(column.getType());
 
-  if (compatibleTypes.componentType->isBool) {
-    updateBooleanArrayProperty(
-        gltf,
-        classProperty,
-        featureTableProperty,
-        featureTable,
-        compatibleTypes,
-        propertyValue);
-  } else if (compatibleTypes.componentType->isInt8) {
-    updateNumericArrayProperty<int32_t, int8_t>(
-        gltf,
-        classProperty,
-        featureTableProperty,
-        featureTable,
-        compatibleTypes,
-        propertyValue);
-  } else if (compatibleTypes.componentType->isUint8) {
-    updateNumericArrayProperty<uint32_t, uint8_t>(
-        gltf,
-        classProperty,
-        featureTableProperty,
-        featureTable,
-        compatibleTypes,
-        propertyValue);
-  } else if (compatibleTypes.componentType->isInt16) {
-    updateNumericArrayProperty<int32_t, int16_t>(
-        gltf,
-        classProperty,
-        featureTableProperty,
-        featureTable,
-        compatibleTypes,
-        propertyValue);
-  } else if (compatibleTypes.componentType->isUint16) {
-    updateNumericArrayProperty<uint32_t, uint16_t>(
-        gltf,
-        classProperty,
-        featureTableProperty,
-        featureTable,
-        compatibleTypes,
-        propertyValue);
-  } else if (compatibleTypes.componentType->isInt32) {
-    updateNumericArrayProperty<int32_t, int32_t>(
-        gltf,
-        classProperty,
-        featureTableProperty,
-        featureTable,
-        compatibleTypes,
-        propertyValue);
-  } else if (compatibleTypes.componentType->isUint32) {
-    updateNumericArrayProperty<uint32_t, uint32_t>(
-        gltf,
-        classProperty,
-        featureTableProperty,
-        featureTable,
-        compatibleTypes,
-        propertyValue);
-  } else if (compatibleTypes.componentType->isInt64) {
-    updateNumericArrayProperty<int64_t, int64_t>(
-        gltf,
-        classProperty,
-        featureTableProperty,
-        featureTable,
-        compatibleTypes,
-        propertyValue);
-  } else if (compatibleTypes.componentType->isUint64) {
-    updateNumericArrayProperty<uint64_t, uint64_t>(
-        gltf,
-        classProperty,
-        featureTableProperty,
-        featureTable,
-        compatibleTypes,
-        propertyValue);
-  } else if (compatibleTypes.componentType->isFloat32) {
-    updateNumericArrayProperty<float, float>(
-        gltf,
-        classProperty,
-        featureTableProperty,
-        featureTable,
-        compatibleTypes,
-        propertyValue);
-  } else if (compatibleTypes.componentType->isFloat64) {
-    updateNumericArrayProperty<double, double>(
-        gltf,
-        classProperty,
-        featureTableProperty,
-        featureTable,
-        compatibleTypes,
-        propertyValue);
-  } else {
-    updateStringArrayProperty(
-        gltf,
-        classProperty,
-        featureTableProperty,
-        featureTable,
-        compatibleTypes,
-        propertyValue);
-  }
+  featureTableProperty.bufferView =
+      addBufferView(gltf, std::move(column.getData()));
 }
 
-void updateExtensionWithJsonProperty(
+void updateExtensionWithBooleanColumn(
     Model& gltf,
     ClassProperty& classProperty,
-    const FeatureTable& featureTable,
     FeatureTableProperty& featureTableProperty,
-    const rapidjson::Value& propertyValue) {
+    BooleanColumn& column) {
+  classProperty.type = "BOOLEAN";
 
-  if (propertyValue.Empty() || propertyValue.Size() < featureTable.count) {
-    // No property to infer the type from, so assume string.
-    updateExtensionWithJsonStringProperty(
-        gltf,
-        classProperty,
-        featureTable,
-        featureTableProperty,
-        propertyValue);
+  featureTableProperty.bufferView =
+      addBufferView(gltf, std::move(column.getData()));
+}
+
+void updateExtensionWithArrayColumn(
+    Model& gltf,
+    ClassProperty& classProperty,
+    FeatureTableProperty& featureTableProperty,
+    ArrayColumn& column) {
+  classProperty.type = "ARRAY";
+  if (column.isFixedSize()) {
+    classProperty.componentCount =
+        static_cast<int64_t>(column.getComponentCount());
+  }
+
+  const uint64_t totalComponentCount =
+      getLastOffset(column.getArrayOffsets());
+  PropertyType offsetType = PropertyType::None;
+  uint64_t arrayOffsetScale = 1;
+
+  switch (column.getComponentType()) {
+  case ArrayColumn::ComponentType::Numeric: {
+    NumericColumn& numbers = column.getNumbers();
+    classProperty.componentType =
+        convertPropertyTypeToString(numbers.getType());
+    visitNumericType(numbers.getType(), [&arrayOffsetScale](auto zero) {
+      arrayOffsetScale = sizeof(zero);
+    });
+    featureTableProperty.bufferView =
+        addBufferView(gltf, std::move(numbers.getData()));
+    offsetType = getOffsetType(totalComponentCount * arrayOffsetScale);
+    break;
+  }
+  case ArrayColumn::ComponentType::String: {
+    StringColumn& strings = column.getStrings();
+    classProperty.componentType = "STRING";
+
+    // The same offset type is used for the string offsets, which are byte
+    // offsets, and for the array offsets, which are offsets into the string
+    // offset buffer.
+    offsetType = getOffsetType(strings.getData().size());
+    if (!column.isFixedSize()) {
+      PropertyType arrayOffsetType = offsetType;
+      do {
+        offsetType = arrayOffsetType;
+        arrayOffsetType = std::max(
+            offsetType,
+            getOffsetType(
+                totalComponentCount * getOffsetTypeSize(offsetType)));
+      } while (arrayOffsetType != offsetType);
+    }
+    arrayOffsetScale = getOffsetTypeSize(offsetType);
+
+    narrowOffsets(strings.getOffsets(), offsetType, 1);
+    featureTableProperty.bufferView =
+        addBufferView(gltf, std::move(strings.getData()));
+    featureTableProperty.stringOffsetBufferView =
+        addBufferView(gltf, std::move(strings.getOffsets()));
+    featureTableProperty.offsetType = convertPropertyTypeToString(offsetType);
+    break;
+  }
+  default:
+    // Arrays that are all empty have no components to infer the type from,
+    // so they are treated as boolean arrays.
+    classProperty.componentType = "BOOLEAN";
+    featureTableProperty.bufferView =
+        addBufferView(gltf, std::move(column.getBooleans().getData()));
+    offsetType = getOffsetType(totalComponentCount);
+    break;
+  }
+
+  if (column.isFixedSize()) {
     return;
   }
 
-  // Figure out which types we can use for this data.
-  // Use the smallest type we can, and prefer signed to unsigned.
-  const CompatibleTypes compatibleTypes = findCompatibleTypes(propertyValue);
-  if (compatibleTypes.type.isBool) {
-    updateExtensionWithJsonBoolProperty(
-        gltf,
-        classProperty,
-        featureTable,
-        featureTableProperty,
-        propertyValue);
-  } else if (compatibleTypes.type.isInt8) {
-    updateExtensionWithJsonNumericProperty<int8_t, int32_t>(
-        gltf,
-        classProperty,
-        featureTable,
-        featureTableProperty,
-        propertyValue,
-        "INT8");
-  } else if (compatibleTypes.type.isUint8) {
-    updateExtensionWithJsonNumericProperty<uint8_t, uint32_t>(
-        gltf,
-        classProperty,
-        featureTable,
-        featureTableProperty,
-        propertyValue,
-        "UINT8");
-  } else if (compatibleTypes.type.isInt16) {
-    updateExtensionWithJsonNumericProperty<int16_t, int32_t>(
-        gltf,
-        classProperty,
-        featureTable,
-        featureTableProperty,
-        propertyValue,
-        "INT16");
-  } else if (compatibleTypes.type.isUint16) {
-    updateExtensionWithJsonNumericProperty<uint16_t, uint32_t>(
-        gltf,
-        classProperty,
-        featureTable,
-        featureTableProperty,
-        propertyValue,
-        "UINT16");
-  } else if (compatibleTypes.type.isInt32) {
-    updateExtensionWithJsonNumericProperty<int32_t>(
-        gltf,
-        classProperty,
-        featureTable,
-        featureTableProperty,
-        propertyValue,
-        "INT32");
-  } else if (compatibleTypes.type.isUint32) {
-    updateExtensionWithJsonNumericProperty<uint32_t>(
-        gltf,
-        classProperty,
-        featureTable,
-        featureTableProperty,
-        propertyValue,
-        "UINT32");
-  } else if (compatibleTypes.type.isInt64) {
-    updateExtensionWithJsonNumericProperty<int64_t>(
-        gltf,
-        classProperty,
-        featureTable,
-        featureTableProperty,
-        propertyValue,
-        "INT64");
-  } else if (compatibleTypes.type.isUint64) {
-    updateExtensionWithJsonNumericProperty<uint64_t>(
-        gltf,
-        classProperty,
-        featureTable,
-        featureTableProperty,
-        propertyValue,
-        "UINT64");
-  } else if (compatibleTypes.type.isFloat32) {
-    updateExtensionWithJsonNumericProperty<float>(
+  narrowOffsets(column.getArrayOffsets(), offsetType, arrayOffsetScale);
+  featureTableProperty.arrayOffsetBufferView =
+      addBufferView(gltf, std::move(column.getArrayOffsets()));
+  featureTableProperty.offsetType = convertPropertyTypeToString(offsetType);
+}
+
+void updateExtensionWithJsonProperty(
+    Model& gltf,
+    ClassProperty& classProperty,
+    const FeatureTable& featureTable,
+    FeatureTableProperty& featureTableProperty,
+    JsonPropertyHandler& property) {
+  // The type was inferred from the first value while the values were read.
+  // If a later value did not fit, the values were read again as strings.
+  switch (property.getType()) {
+  case JsonPropertyHandler::ColumnType::Boolean:
+    updateExtensionWithBooleanColumn(
         gltf,
         classProperty,
-        featureTable,
         featureTableProperty,
-        propertyValue,
-        "FLOAT32");
-  } else if (compatibleTypes.type.isFloat64) {
-    updateExtensionWithJsonNumericProperty<double>(
+        property.getBooleans());
+    break;
+  case JsonPropertyHandler::ColumnType::Numeric:
+    updateExtensionWithNumericColumn(
         gltf,
         classProperty,
-        featureTable,
         featureTableProperty,
-        propertyValue,
-        "FLOAT64");
-  } else if (compatibleTypes.type.isArray) {
-    updateExtensionWithArrayProperty(
+        property.getNumbers());
+    break;
+  case JsonPropertyHandler::ColumnType::Array:
+    updateExtensionWithArrayColumn(
         gltf,
         classProperty,
-        featureTable,
         featureTableProperty,
-        compatibleTypes,
-        propertyValue);
-  } else {
+        property.getArrays());
+    break;
+  default:
+    assert(
+        property.getType() != JsonPropertyHandler::ColumnType::Invalid &&
+        "The values of an invalid column must be read again as strings");
     updateExtensionWithJsonStringProperty(
         gltf,
         classProperty,
         featureTable,
         featureTableProperty,
-        propertyValue);
+        property.getStrings());
+    break;
   }
 }
 
@@ -1154,49 +1150,43 @@ void updateExtensionWithBinaryProperty(
     ClassProperty& classProperty,
     const FeatureTable& featureTable,
     FeatureTableProperty& featureTableProperty,
-    const std::string& propertyName,
-    const rapidjson::Value& propertyValue,
+    const BatchTableProperty& property,
     const std::shared_ptr<spdlog::logger>& pLogger) {
   assert(
       gltfBufferIndex >= 0 &&
       "gltfBufferIndex is negative. Need to allocate buffer before "
       "convert the binary property");
 
-  const auto& byteOffsetIt = propertyValue.FindMember("byteOffset");
-  if (byteOffsetIt == propertyValue.MemberEnd() ||
-      !byteOffsetIt->value.IsInt64()) {
+  if (!property.byteOffset) {
     SPDLOG_LOGGER_WARN(
         pLogger,
         "Skip convert {}. The binary property doesn't have required "
         "byteOffset.",
-        propertyName);
+        property.name);
     return;
   }
 
-  const auto& componentTypeIt = propertyValue.FindMember("componentType");
-  if (componentTypeIt == propertyValue.MemberEnd() ||
-      !componentTypeIt->value.IsString()) {
+  if (!property.componentType) {
     SPDLOG_LOGGER_WARN(
         pLogger,
         "Skip convert {}. The binary property doesn't have required "
         "componentType.",
-        propertyName);
+        property.name);
     return;
   }
 
-  const auto& typeIt = propertyValue.FindMember("type");
-  if (typeIt == propertyValue.MemberEnd() || !typeIt->value.IsString()) {
+  if (!property.type) {
     SPDLOG_LOGGER_WARN(
         pLogger,
         "Skip convert {}. The binary property doesn't have required type.",
-        propertyName);
+        property.name);
     return;
   }
 
   // convert class property
-  const int64_t byteOffset = byteOffsetIt->value.GetInt64();
-  const std::string& componentType = componentTypeIt->value.GetString();
-  const std::string& type = typeIt->value.GetString();
+  const int64_t byteOffset = *property.byteOffset;
+  const std::string& componentType = *property.componentType;
+  const std::string& type = *property.type;
 
   auto convertedTypeIt = b3dmComponentTypeToGltfType.find(componentType);
   if (convertedTypeIt == b3dmComponentTypeToGltfType.end()) {
@@ -1249,7 +1239,7 @@ void upgradeBatchTableToFeatureMetadata(
     const std::shared_ptr<spdlog::logger>& pLogger,
     CesiumGltf::Model& gltf,
     const rapidjson::Document& featureTableJson,
-    const rapidjson::Document& batchTableJson,
+    const gsl::span<const std::byte>& batchTableJson,
     const gsl::span<const std::byte>& batchTableBinaryData) {
 
   CESIUM_TRACE("upgradeBatchTableToFeatureMetadata");
@@ -1277,6 +1267,29 @@ void upgradeBatchTableToFeatureMetadata(
 
   const int64_t batchLength = batchLengthIt->value.GetInt64();
 
+  // Read the batch table JSON in a single pass, which copies the values of the
+  // JSON properties to their columns.
+  rapidjson::MemoryStream memoryStream(
+      reinterpret_cast<const char*>(batchTableJson.data()),
+      batchTableJson.size());
+  rapidjson::EncodedInputStream<rapidjson::UTF8<>, rapidjson::MemoryStream>
+      stream(memoryStream);
+  BatchTableHandler handler(
+      batchTableJson,
+      memoryStream,
+      static_cast<size_t>(std::max(batchLength, int64_t(0))));
+  rapidjson::Reader reader;
+  const rapidjson::ParseResult result = reader.Parse(stream, handler);
+  if (result.IsError()) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "Error when parsing batch table JSON, error code {} at byte offset "
+        "{}. Skip parsing metadata",
+        result.Code(),
+        result.Offset());
+    return;
+  }
+
   // Add the binary part of the batch table - if any - to the glTF as a buffer.
   // We will reallign this buffer later on
   int32_t gltfBufferIndex = -1;
@@ -1301,16 +1314,8 @@ void upgradeBatchTableToFeatureMetadata(
   featureTable.classProperty = "default";
 
   // Convert each regular property in the batch table
-  for (auto propertyIt = batchTableJson.MemberBegin();
-       propertyIt != batchTableJson.MemberEnd();
-       ++propertyIt) {
-    std::string name = propertyIt->name.GetString();
-
-    // Don't interpret extensions or extras as a property.
-    if (name == "extensions" || name == "extras") {
-      continue;
-    }
-
+  for (BatchTableProperty& property : handler.getProperties()) {
+    const std::string& name = property.name;
     ClassProperty& classProperty =
         classDefinition.properties.emplace(name, ClassProperty()).first->second;
     classProperty.name = name;
@@ -1318,14 +1323,13 @@ void upgradeBatchTableToFeatureMetadata(
     FeatureTableProperty& featureTableProperty =
         featureTable.properties.emplace(name, FeatureTableProperty())
             .first->second;
-    const rapidjson::Value& propertyValue = propertyIt->value;
-    if (propertyValue.IsArray()) {
+    if (property.pJsonProperty) {
       updateExtensionWithJsonProperty(
           gltf,
           classProperty,
           featureTable,
           featureTableProperty,
-          propertyValue);
+          *property.pJsonProperty);
     } else {
       BinaryProperty& binaryProperty = binaryProperties.emplace_back();
       updateExtensionWithBinaryProperty(
@@ -1336,8 +1340,7 @@ void upgradeBatchTableToFeatureMetadata(
           classProperty,
           featureTable,
           featureTableProperty,
-          name,
-          propertyValue,
+          property,
           pLogger);
       gltfBufferOffset += roundUp(binaryProperty.byteLength, 8);
     }
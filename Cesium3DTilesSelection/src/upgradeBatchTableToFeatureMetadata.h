@@ -4,6 +4,7 @@
 #include <rapidjson/fwd.h>
 #include <spdlog/fwd.h>
 
+#include <cstddef>
 #include <memory>
 
 namespace CesiumGltf {
@@ -16,17 +17,20 @@ namespace Cesium3DTilesSelection {
  * @brief Parses the provided B3DM batch table and adds an equivalent
  * EXT_feature_metadata extension to the provided glTF.
  *
+ * The batch table JSON is read in a single pass, without building a document.
+ * If it cannot be parsed, a warning is logged and no extension is added.
+ *
  * @param pLogger
  * @param gltf
  * @param featureTable
- * @param batchTableJson
+ * @param batchTableJson The JSON part of the batch table.
  * @param batchTableBinaryData
  */
 void upgradeBatchTableToFeatureMetadata(
     const std::shared_ptr<spdlog::logger>& pLogger,
     CesiumGltf::Model& gltf,
     const rapidjson::Document& featureTable,
-    const rapidjson::Document& batchTableJson,
+    const gsl::span<const std::byte>& batchTableJson,
     const gsl::span<const std::byte>& batchTableBinaryData);
 
 } // namespace Cesium3DTilesSelection
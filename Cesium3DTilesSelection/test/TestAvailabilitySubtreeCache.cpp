@@ -0,0 +1,84 @@
+#include "AvailabilitySubtreeCache.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+
+namespace {
+std::vector<std::byte> createBuffer(size_t size, uint8_t seed) {
+  std::vector<std::byte> buffer(size);
+  for (size_t i = 0; i < size; ++i) {
+    buffer[i] = std::byte(static_cast<uint8_t>(seed * i));
+  }
+  return buffer;
+}
+} // namespace
+
+TEST_CASE("Test availability subtree cache") {
+  AvailabilitySubtree subtree{
+      ConstantAvailability{true},
+      SubtreeBufferView{3, 5, 1},
+      SubtreeBufferView{0, 4, 0},
+      {createBuffer(13, 3), createBuffer(21, 5), {}}};
+
+  SECTION("Subtrees survive a round trip") {
+    const std::vector<std::byte> data =
+        AvailabilitySubtreeCache::write(subtree);
+    std::optional<AvailabilitySubtree> result =
+        AvailabilitySubtreeCache::read(data);
+    REQUIRE(result);
+
+    const ConstantAvailability* pTile =
+        std::get_if<ConstantAvailability>(&result->tileAvailability);
+    REQUIRE(pTile);
+    CHECK(pTile->constant);
+
+    const SubtreeBufferView* pContent =
+        std::get_if<SubtreeBufferView>(&result->contentAvailability);
+    REQUIRE(pContent);
+    CHECK(pContent->byteOffset == 3);
+    CHECK(pContent->byteLength == 5);
+    CHECK(pContent->buffer == 1);
+
+    const SubtreeBufferView* pSubtree =
+        std::get_if<SubtreeBufferView>(&result->subtreeAvailability);
+    REQUIRE(pSubtree);
+    CHECK(pSubtree->byteOffset == 0);
+    CHECK(pSubtree->byteLength == 4);
+    CHECK(pSubtree->buffer == 0);
+
+    CHECK(result->buffers == subtree.buffers);
+  }
+
+  SECTION("Truncated data is rejected") {
+    std::vector<std::byte> data = AvailabilitySubtreeCache::write(subtree);
+    while (!data.empty()) {
+      data.pop_back();
+      CHECK(!AvailabilitySubtreeCache::read(data));
+    }
+  }
+
+  SECTION("Data in another format is rejected") {
+    std::vector<std::byte> data = AvailabilitySubtreeCache::write(subtree);
+    data[0] = std::byte('X');
+    CHECK(!AvailabilitySubtreeCache::read(data));
+  }
+
+  SECTION("Keys depend on the URL and the ETag") {
+    const std::string key =
+        AvailabilitySubtreeCache::getKey("https://example.com/0.subtree", "a");
+    CHECK(
+        key != AvailabilitySubtreeCache::getKey(
+                   "https://example.com/1.subtree",
+                   "a"));
+    CHECK(
+        key != AvailabilitySubtreeCache::getKey(
+                   "https://example.com/0.subtree",
+                   "b"));
+  }
+}
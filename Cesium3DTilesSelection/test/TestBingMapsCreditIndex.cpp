@@ -0,0 +1,130 @@
+#include "BingMapsCreditIndex.h"
+#include "Cesium3DTilesSelection/CreditSystem.h"
+
+#include <CesiumGeospatial/GlobeRectangle.h>
+
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeospatial;
+
+namespace {
+std::vector<Credit> findCreditsByTestingEveryArea(
+    const std::vector<CreditAndCoverageAreas>& credits,
+    uint32_t bingLevel,
+    const GlobeRectangle& rectangle) {
+  std::vector<Credit> result;
+  for (const CreditAndCoverageAreas& creditAndCoverageAreas : credits) {
+    for (const CoverageArea& coverageArea :
+         creditAndCoverageAreas.coverageAreas) {
+      if (coverageArea.zoomMin <= bingLevel &&
+          bingLevel <= coverageArea.zoomMax &&
+          coverageArea.rectangle.computeIntersection(rectangle).has_value()) {
+        result.push_back(creditAndCoverageAreas.credit);
+        break;
+      }
+    }
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("BingMapsCreditIndex") {
+  CreditSystem creditSystem;
+  const Credit world = creditSystem.createCredit("world");
+  const Credit europe = creditSystem.createCredit("europe");
+  const Credit pacific = creditSystem.createCredit("pacific");
+
+  std::vector<CreditAndCoverageAreas> credits{
+      {world,
+       {{GlobeRectangle::fromDegrees(-180.0, -90.0, 180.0, 90.0), 1, 9}}},
+      {europe,
+       {{GlobeRectangle::fromDegrees(-10.0, 35.0, 30.0, 70.0), 5, 21},
+        {GlobeRectangle::fromDegrees(-25.0, 63.0, -13.0, 67.0), 10, 19}}},
+      // Crosses the anti-meridian.
+      {pacific,
+       {{GlobeRectangle::fromDegrees(170.0, -30.0, -170.0, 0.0), 3, 15}}}};
+  const BingMapsCreditIndex index{std::vector<CreditAndCoverageAreas>(credits)};
+
+  const auto find = [&index](uint32_t level, const GlobeRectangle& rectangle) {
+    std::vector<Credit> result;
+    index.findCredits(level, rectangle, result);
+    return result;
+  };
+
+  SECTION("finds the credits of the areas that intersect a tile") {
+    const GlobeRectangle paris =
+        GlobeRectangle::fromDegrees(2.0, 48.0, 3.0, 49.0);
+    CHECK(find(1, paris) == std::vector<Credit>{world});
+    CHECK(find(6, paris) == std::vector<Credit>{world, europe});
+    CHECK(find(12, paris) == std::vector<Credit>{europe});
+    CHECK(find(22, paris).empty());
+
+    const GlobeRectangle iceland =
+        GlobeRectangle::fromDegrees(-20.0, 64.0, -19.0, 65.0);
+    CHECK(find(12, iceland) == std::vector<Credit>{europe});
+  }
+
+  SECTION("finds areas on both sides of the anti-meridian") {
+    CHECK(
+        find(12, GlobeRectangle::fromDegrees(175.0, -10.0, 176.0, -9.0)) ==
+        std::vector<Credit>{pacific});
+    CHECK(
+        find(12, GlobeRectangle::fromDegrees(-176.0, -10.0, -175.0, -9.0)) ==
+        std::vector<Credit>{pacific});
+    CHECK(find(12, GlobeRectangle::fromDegrees(0.0, -10.0, 1.0, -9.0)).empty());
+  }
+
+  SECTION("finds the same credits as testing every area") {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> longitude(-180.0, 180.0);
+    std::uniform_real_distribution<double> latitude(-85.0, 85.0);
+    std::uniform_real_distribution<double> size(0.01, 40.0);
+    std::uniform_int_distribution<uint32_t> zoom(1, 21);
+
+    std::vector<CreditAndCoverageAreas> manyCredits;
+    for (int i = 0; i < 50; ++i) {
+      CreditAndCoverageAreas creditAndCoverageAreas{
+          creditSystem.createCredit("credit " + std::to_string(i)),
+          {}};
+      for (int j = 0; j < 20; ++j) {
+        const double west = longitude(random);
+        const double south = latitude(random);
+        double east = west + size(random);
+        if (east > 180.0) {
+          east -= 360.0;
+        }
+        const double north = std::min(south + size(random), 90.0);
+        const uint32_t zoomMin = zoom(random);
+        const uint32_t zoomMax = std::max(zoomMin, zoom(random));
+        creditAndCoverageAreas.coverageAreas.push_back(
+            {GlobeRectangle::fromDegrees(west, south, east, north),
+             zoomMin,
+             zoomMax});
+      }
+      manyCredits.push_back(std::move(creditAndCoverageAreas));
+    }
+
+    const BingMapsCreditIndex manyIndex{
+        std::vector<CreditAndCoverageAreas>(manyCredits)};
+
+    for (int i = 0; i < 2000; ++i) {
+      const uint32_t level = zoom(random);
+      const double west = longitude(random);
+      const double south = latitude(random);
+      const GlobeRectangle tile = GlobeRectangle::fromDegrees(
+          west,
+          south,
+          std::min(west + size(random) / 4.0, 180.0),
+          std::min(south + size(random) / 4.0, 90.0));
+
+      std::vector<Credit> found;
+      manyIndex.findCredits(level, tile, found);
+      REQUIRE(found == findCreditsByTestingEveryArea(manyCredits, level, tile));
+    }
+  }
+}
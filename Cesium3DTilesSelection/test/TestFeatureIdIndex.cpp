@@ -0,0 +1,124 @@
+#include "Cesium3DTilesSelection/FeatureIdIndex.h"
+
+#include <CesiumGltf/ExtensionMeshPrimitiveExtFeatureMetadata.h>
+#include <CesiumGltf/Model.h>
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGltf;
+
+namespace {
+template <typename T>
+int32_t addAccessor(
+    Model& model,
+    const std::vector<T>& values,
+    int32_t componentType) {
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(values.size() * sizeof(T));
+  std::memcpy(
+      buffer.cesium.data.data(),
+      values.data(),
+      buffer.cesium.data.size());
+  buffer.byteLength = static_cast<int64_t>(buffer.cesium.data.size());
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
+  bufferView.byteLength = buffer.byteLength;
+
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = static_cast<int32_t>(model.bufferViews.size() - 1);
+  accessor.componentType = componentType;
+  accessor.type = Accessor::Type::SCALAR;
+  accessor.count = static_cast<int64_t>(values.size());
+
+  return static_cast<int32_t>(model.accessors.size() - 1);
+}
+
+void checkRanges(
+    const gsl::span<const FeatureIdRange>& ranges,
+    const std::vector<std::pair<uint32_t, uint32_t>>& expected) {
+  REQUIRE(ranges.size() == expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    CHECK(ranges[i].begin == expected[i].first);
+    CHECK(ranges[i].end == expected[i].second);
+  }
+}
+} // namespace
+
+TEST_CASE("Test FeatureIdIndex") {
+  Model model;
+  MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+
+  const std::vector<float> featureIds{3, 3, 1, 1, 3, 2, 2, 1};
+  primitive.attributes["_FEATURE_ID_0"] =
+      addAccessor(model, featureIds, Accessor::ComponentType::FLOAT);
+
+  const std::vector<uint16_t> indices{0, 1, 4, 2, 3, 7, 5, 6, 6, 0, 1, 4};
+  primitive.indices =
+      addAccessor(model, indices, Accessor::ComponentType::UNSIGNED_SHORT);
+
+  ExtensionMeshPrimitiveExtFeatureMetadata& metadata =
+      primitive.addExtension<ExtensionMeshPrimitiveExtFeatureMetadata>();
+  FeatureIDAttribute& attribute = metadata.featureIdAttributes.emplace_back();
+  attribute.featureTable = "buildings";
+  attribute.featureIds.attribute = "_FEATURE_ID_0";
+
+  SECTION("Vertex and index ranges are found for each feature") {
+    const FeatureIdIndex index = FeatureIdIndex::create(model);
+    REQUIRE(index.getPrimitives().size() == 1);
+
+    const PrimitiveFeatureIdIndex* pPrimitive =
+        index.findPrimitive(0, 0, "buildings");
+    REQUIRE(pPrimitive);
+    CHECK(pPrimitive->featureIds == std::vector<int64_t>{1, 2, 3});
+
+    checkRanges(pPrimitive->getVertexRanges(1), {{2, 4}, {7, 8}});
+    checkRanges(pPrimitive->getVertexRanges(2), {{5, 7}});
+    checkRanges(pPrimitive->getVertexRanges(3), {{0, 2}, {4, 5}});
+    CHECK(pPrimitive->getVertexRanges(0).empty());
+    CHECK(pPrimitive->getVertexRanges(4).empty());
+
+    checkRanges(pPrimitive->getIndexRanges(1), {{3, 6}});
+    checkRanges(pPrimitive->getIndexRanges(2), {{6, 9}});
+    checkRanges(pPrimitive->getIndexRanges(3), {{0, 3}, {9, 12}});
+
+    CHECK(!index.findPrimitive(0, 0, "trees"));
+    CHECK(!index.findPrimitive(0, 1, "buildings"));
+    CHECK(index.getSizeBytes() > 0);
+  }
+
+  SECTION("Implicit feature IDs are indexed") {
+    primitive.attributes["POSITION"] = addAccessor(
+        model,
+        std::vector<float>(7),
+        Accessor::ComponentType::FLOAT);
+    attribute.featureIds.attribute.reset();
+    attribute.featureIds.constant = 10;
+    attribute.featureIds.divisor = 3;
+
+    const FeatureIdIndex index = FeatureIdIndex::create(model);
+    const PrimitiveFeatureIdIndex* pPrimitive =
+        index.findPrimitive(0, 0, "buildings");
+    REQUIRE(pPrimitive);
+    CHECK(pPrimitive->featureIds == std::vector<int64_t>{10, 11, 12});
+    checkRanges(pPrimitive->getVertexRanges(11), {{3, 6}});
+    checkRanges(pPrimitive->getVertexRanges(12), {{6, 7}});
+  }
+
+  SECTION("Primitives without indices have no index ranges") {
+    primitive.indices = -1;
+
+    const FeatureIdIndex index = FeatureIdIndex::create(model);
+    const PrimitiveFeatureIdIndex* pPrimitive =
+        index.findPrimitive(0, 0, "buildings");
+    REQUIRE(pPrimitive);
+    checkRanges(pPrimitive->getVertexRanges(2), {{5, 7}});
+    CHECK(pPrimitive->getIndexRanges(2).empty());
+  }
+}
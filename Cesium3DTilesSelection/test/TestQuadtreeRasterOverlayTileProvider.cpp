@@ -233,3 +233,102 @@ TEST_CASE("QuadtreeRasterOverlayTileProvider getTile") {
         [](std::byte b) { return b == std::byte(8); }));
   }
 }
+
+TEST_CASE("QuadtreeRasterOverlayTileProvider with a page atlas") {
+  auto pTaskProcessor = std::make_shared<MockTaskProcessor>();
+  auto pAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>());
+
+  AsyncSystem asyncSystem(pTaskProcessor);
+
+  RasterOverlayOptions options;
+  options.enablePageAtlas = true;
+  options.pageAtlasSize = 1024;
+  TestRasterOverlay overlay("Test", options);
+
+  overlay.loadTileProvider(
+      asyncSystem,
+      pAssetAccessor,
+      nullptr,
+      nullptr,
+      spdlog::default_logger());
+
+  asyncSystem.dispatchMainThreadTasks();
+
+  TestTileProvider* pProvider =
+      static_cast<TestTileProvider*>(overlay.getTileProvider());
+  REQUIRE(pProvider);
+  REQUIRE(!pProvider->isPlaceholder());
+
+  const RasterOverlayPageAtlas* pAtlas = pProvider->getPageAtlas();
+  REQUIRE(pAtlas);
+  CHECK(pAtlas->getCapacity() == 16);
+
+  // Select a rectangle that spans four tiles at tile level 8, and let the
+  // tile in the southeast corner fail to load.
+  const uint32_t expectedLevel = 8;
+  std::optional<QuadtreeTileID> centerTileID =
+      pProvider->getTilingScheme().positionToTile(
+          glm::dvec2(0.1, 0.2),
+          expectedLevel);
+  REQUIRE(centerTileID);
+
+  Rectangle centerRectangle =
+      pProvider->getTilingScheme().tileToRectangle(*centerTileID);
+  Rectangle tileRectangle(
+      centerRectangle.minimumX - centerRectangle.computeWidth() * 0.5,
+      centerRectangle.minimumY - centerRectangle.computeHeight() * 0.5,
+      centerRectangle.maximumX + centerRectangle.computeWidth() * 0.5,
+      centerRectangle.maximumY + centerRectangle.computeHeight() * 0.5);
+
+  uint32_t rasterSSE = 2;
+  glm::dvec2 targetScreenPixels = glm::dvec2(
+      pProvider->getWidth() * 2 * rasterSSE,
+      pProvider->getHeight() * 2 * rasterSSE);
+
+  std::optional<QuadtreeTileID> southeastID =
+      pProvider->getTilingScheme().positionToTile(
+          tileRectangle.getLowerRight(),
+          expectedLevel);
+  REQUIRE(southeastID);
+  pProvider->errorTiles.emplace_back(*southeastID);
+
+  IntrusivePointer<RasterOverlayTile> pTile =
+      pProvider->getTile(tileRectangle, targetScreenPixels);
+  pProvider->loadTile(*pTile);
+
+  while (pTile->getState() != RasterOverlayTile::LoadState::Loaded) {
+    asyncSystem.dispatchMainThreadTasks();
+  }
+
+  CHECK(pTile->getImage().pixelData.empty());
+
+  const std::optional<RasterOverlayPageTableWindow>& window =
+      pTile->getPageTableWindow();
+  REQUIRE(window);
+  CHECK(window->southwest.level == expectedLevel);
+  CHECK(window->columns == 2);
+  CHECK(window->rows == 2);
+  CHECK(window->rectangle.minimumX == Approx(tileRectangle.minimumX));
+  CHECK(window->rectangle.maximumY == Approx(tileRectangle.maximumY));
+  REQUIRE(window->pages.size() == 4);
+
+  // Three level 8 pages plus the level 7 page used for the failed tile.
+  CHECK(pAtlas->getPageCount() == 4);
+  for (uint32_t row = 0; row < window->rows; ++row) {
+    for (uint32_t column = 0; column < window->columns; ++column) {
+      const auto& pPage = window->pages[row * window->columns + column];
+      REQUIRE(pPage);
+
+      const QuadtreeTileID cellID(
+          expectedLevel,
+          window->southwest.x + column,
+          window->southwest.y + row);
+      if (cellID == *southeastID) {
+        CHECK(pPage->tileID == cellID.getParent());
+      } else {
+        CHECK(pPage->tileID == cellID);
+      }
+    }
+  }
+}
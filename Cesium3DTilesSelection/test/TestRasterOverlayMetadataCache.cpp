@@ -0,0 +1,195 @@
+#include "Cesium3DTilesSelection/CreditSystem.h"
+#include "Cesium3DTilesSelection/QuadtreeRasterOverlayTileProvider.h"
+#include "Cesium3DTilesSelection/RasterOverlayMetadataCache.h"
+#include "Cesium3DTilesSelection/RasterOverlayTileProvider.h"
+#include "Cesium3DTilesSelection/TileMapServiceRasterOverlay.h"
+#include "SimpleAssetAccessor.h"
+#include "SimpleAssetRequest.h"
+#include "SimpleAssetResponse.h"
+#include "SimpleTaskProcessor.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumAsync;
+
+namespace {
+struct TestMetadata {
+  int value;
+};
+
+struct OtherMetadata {
+  int value;
+};
+
+std::shared_ptr<const TestMetadata> makeMetadata(int value) {
+  return std::make_shared<const TestMetadata>(TestMetadata{value});
+}
+} // namespace
+
+TEST_CASE("RasterOverlayMetadataCache") {
+  SECTION("returns the value put for a key") {
+    RasterOverlayMetadataCache cache;
+    CHECK(cache.get<TestMetadata>("a") == nullptr);
+
+    std::shared_ptr<const TestMetadata> pA = makeMetadata(1);
+    cache.put("a", pA);
+    CHECK(cache.get<TestMetadata>("a") == pA);
+    CHECK(cache.size() == 1);
+
+    std::shared_ptr<const TestMetadata> pB = makeMetadata(2);
+    cache.put("a", pB);
+    CHECK(cache.get<TestMetadata>("a") == pB);
+    CHECK(cache.size() == 1);
+  }
+
+  SECTION("does not return a value of a different type") {
+    RasterOverlayMetadataCache cache;
+    cache.put("a", makeMetadata(1));
+    CHECK(cache.get<OtherMetadata>("a") == nullptr);
+    CHECK(cache.get<TestMetadata>("a") != nullptr);
+  }
+
+  SECTION("evicts the least recently used entry when full") {
+    RasterOverlayMetadataCacheOptions options;
+    options.maximumEntries = 2;
+    RasterOverlayMetadataCache cache(options);
+
+    cache.put("a", makeMetadata(1));
+    cache.put("b", makeMetadata(2));
+    REQUIRE(cache.get<TestMetadata>("a") != nullptr);
+
+    cache.put("c", makeMetadata(3));
+    CHECK(cache.size() == 2);
+    CHECK(cache.get<TestMetadata>("a") != nullptr);
+    CHECK(cache.get<TestMetadata>("b") == nullptr);
+    CHECK(cache.get<TestMetadata>("c") != nullptr);
+  }
+
+  SECTION("does not return expired entries") {
+    RasterOverlayMetadataCacheOptions options;
+    options.timeToLive = std::chrono::milliseconds(1);
+    RasterOverlayMetadataCache cache(options);
+
+    cache.put("a", makeMetadata(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    CHECK(cache.get<TestMetadata>("a") == nullptr);
+    CHECK(cache.size() == 0);
+  }
+
+  SECTION("caches nothing when the maximum number of entries is zero") {
+    RasterOverlayMetadataCacheOptions options;
+    options.maximumEntries = 0;
+    RasterOverlayMetadataCache cache(options);
+
+    cache.put("a", makeMetadata(1));
+    CHECK(cache.get<TestMetadata>("a") == nullptr);
+    CHECK(cache.size() == 0);
+  }
+
+  SECTION("removes entries") {
+    RasterOverlayMetadataCache cache;
+    cache.put("a", makeMetadata(1));
+    cache.put("b", makeMetadata(2));
+
+    cache.remove("a");
+    CHECK(cache.get<TestMetadata>("a") == nullptr);
+    CHECK(cache.get<TestMetadata>("b") != nullptr);
+
+    cache.clear();
+    CHECK(cache.size() == 0);
+  }
+}
+
+TEST_CASE("TileMapServiceRasterOverlay uses the metadata cache") {
+  const std::string xml =
+      "<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+      "<TileMap version=\"1.0.0\">"
+      "<BoundingBox minx=\"-10\" miny=\"-20\" maxx=\"30\" maxy=\"40\"/>"
+      "<TileFormat width=\"512\" height=\"512\" extension=\"jpg\"/>"
+      "<TileSets profile=\"geodetic\">"
+      "<TileSet href=\"2\" order=\"2\"/>"
+      "<TileSet href=\"7\" order=\"7\"/>"
+      "</TileSets>"
+      "</TileMap>";
+  std::vector<std::byte> xmlBytes(xml.size());
+  std::memcpy(xmlBytes.data(), xml.data(), xml.size());
+
+  const std::string xmlUrl = "https://example.com/tms/tilemapresource.xml";
+  auto pAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>{
+          {xmlUrl,
+           std::make_shared<SimpleAssetRequest>(
+               "GET",
+               xmlUrl,
+               HttpHeaders{},
+               std::make_unique<SimpleAssetResponse>(
+                   static_cast<uint16_t>(200),
+                   "application/xml",
+                   HttpHeaders{},
+                   std::move(xmlBytes)))}});
+
+  AsyncSystem asyncSystem(std::make_shared<SimpleTaskProcessor>());
+  auto pCreditSystem = std::make_shared<CreditSystem>();
+
+  RasterOverlayOptions overlayOptions;
+  overlayOptions.pMetadataCache =
+      std::make_shared<RasterOverlayMetadataCache>();
+
+  TileMapServiceRasterOverlay first(
+      "First",
+      "https://example.com/tms/",
+      {},
+      {},
+      overlayOptions);
+  TileMapServiceRasterOverlay second(
+      "Second",
+      "https://example.com/tms/",
+      {},
+      {},
+      overlayOptions);
+
+  const auto createProvider = [&](RasterOverlay& overlay) {
+    return overlay
+        .createTileProvider(
+            asyncSystem,
+            pAssetAccessor,
+            pCreditSystem,
+            nullptr,
+            spdlog::default_logger(),
+            nullptr)
+        .wait();
+  };
+
+  std::unique_ptr<RasterOverlayTileProvider> pFirst = createProvider(first);
+  REQUIRE(pFirst);
+  CHECK(overlayOptions.pMetadataCache->size() == 1);
+
+  // Without the cache, the second overlay would not get the metadata.
+  pAssetAccessor->mockCompletedRequests.clear();
+
+  std::unique_ptr<RasterOverlayTileProvider> pSecond = createProvider(second);
+  REQUIRE(pSecond);
+
+  const auto& quadtreeProvider =
+      static_cast<const QuadtreeRasterOverlayTileProvider&>(*pSecond);
+  CHECK(quadtreeProvider.getWidth() == 512);
+  CHECK(quadtreeProvider.getMaximumLevel() == 7);
+  CHECK(pSecond->getProjection() == pFirst->getProjection());
+  CHECK(
+      pSecond->getCoverageRectangle().minimumX ==
+      pFirst->getCoverageRectangle().minimumX);
+  CHECK(
+      pSecond->getCoverageRectangle().maximumY ==
+      pFirst->getCoverageRectangle().maximumY);
+}
@@ -0,0 +1,47 @@
+#include "Cesium3DTilesSelection/RasterOverlayPageAtlas.h"
+
+#include <catch2/catch.hpp>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+
+TEST_CASE("RasterOverlayPageAtlas") {
+  RasterOverlayPageAtlas atlas(256, 128, 2, 2);
+  REQUIRE(atlas.getCapacity() == 4);
+  CHECK(atlas.getSlotPixelOffset(0) == glm::uvec2(0, 0));
+  CHECK(atlas.getSlotPixelOffset(1) == glm::uvec2(256, 0));
+  CHECK(atlas.getSlotPixelOffset(3) == glm::uvec2(256, 128));
+
+  const Rectangle rectangle(0.0, 0.0, 1.0, 1.0);
+
+  std::vector<std::shared_ptr<const RasterOverlayPageAtlas::Page>> pages;
+  for (uint32_t i = 0; i < 4; ++i) {
+    pages.emplace_back(atlas.allocate(QuadtreeTileID(1, i, 0), rectangle));
+    REQUIRE(pages.back());
+    CHECK(pages.back()->slot == i);
+  }
+  CHECK(atlas.getPageCount() == 4);
+
+  SECTION("finds pages by tile ID") {
+    CHECK(atlas.find(QuadtreeTileID(1, 2, 0)) == pages[2]);
+    CHECK(!atlas.find(QuadtreeTileID(1, 2, 1)));
+  }
+
+  SECTION("does not evict referenced pages") {
+    CHECK(!atlas.allocate(QuadtreeTileID(2, 0, 0), rectangle));
+  }
+
+  SECTION("evicts the least recently used unreferenced page") {
+    pages.clear();
+    atlas.find(QuadtreeTileID(1, 0, 0));
+
+    std::shared_ptr<const RasterOverlayPageAtlas::Page> pPage =
+        atlas.allocate(QuadtreeTileID(2, 0, 0), rectangle);
+    REQUIRE(pPage);
+    CHECK(pPage->slot == 1);
+    CHECK(atlas.getPageCount() == 4);
+    CHECK(!atlas.find(QuadtreeTileID(1, 1, 0)));
+    CHECK(atlas.find(QuadtreeTileID(1, 0, 0)));
+    CHECK(atlas.find(QuadtreeTileID(2, 0, 0)) == pPage);
+  }
+}
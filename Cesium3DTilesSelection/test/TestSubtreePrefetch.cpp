@@ -0,0 +1,320 @@
+#include "Cesium3DTilesSelection/Tileset.h"
+#include "Cesium3DTilesSelection/ViewState.h"
+#include "Cesium3DTilesSelection/registerAllTileContentTypes.h"
+#include "SimpleAssetRequest.h"
+#include "SimpleAssetResponse.h"
+#include "SimplePrepareRendererResource.h"
+#include "SimpleTaskProcessor.h"
+
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/Promise.h>
+#include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+namespace {
+
+// A quadtree with two subtree levels and a maximum level of three, so the
+// root subtree at level zero has sixteen child subtrees at level two.
+const std::string tilesetJson = R"({
+  "asset": { "version": "1.0" },
+  "geometricError": 2000,
+  "root": {
+    "boundingVolume": {
+      "region": [
+        2.058615852727312,
+        0.5576326960121882,
+        2.060361181979306,
+        0.5593780252641826,
+        0,
+        100
+      ]
+    },
+    "geometricError": 1000,
+    "refine": "REPLACE",
+    "content": { "uri": "content/{level}.{x}.{y}.b3dm" },
+    "extensions": {
+      "3DTILES_implicit_tiling": {
+        "subdivisionScheme": "QUADTREE",
+        "subtreeLevels": 2,
+        "maximumLevel": 3,
+        "subtrees": { "uri": "subtrees/{level}.{x}.{y}.subtree" }
+      }
+    }
+  }
+})";
+
+std::string getSubtreeUrl(const QuadtreeTileID& id) {
+  return "subtrees/" + std::to_string(id.level) + "." + std::to_string(id.x) +
+         "." + std::to_string(id.y) + ".subtree";
+}
+
+/**
+ * @brief Creates a binary subtree in which all tiles are available and have
+ * no content.
+ */
+std::vector<std::byte> createSubtree(bool childSubtreesAvailable) {
+  const std::string json =
+      std::string(R"({"tileAvailability":{"constant":1},)") +
+      R"("contentAvailability":{"constant":0},)" +
+      R"("childSubtreeAvailability":{"constant":)" +
+      (childSubtreesAvailable ? "1" : "0") + "}}";
+
+  const uint32_t version = 1;
+  const uint64_t jsonByteLength = json.size();
+  const uint64_t binaryByteLength = 0;
+
+  std::vector<std::byte> subtree(24 + json.size());
+  std::memcpy(subtree.data(), "subt", 4);
+  std::memcpy(subtree.data() + 4, &version, sizeof(version));
+  std::memcpy(subtree.data() + 8, &jsonByteLength, sizeof(jsonByteLength));
+  std::memcpy(subtree.data() + 16, &binaryByteLength, sizeof(binaryByteLength));
+  std::memcpy(subtree.data() + 24, json.data(), json.size());
+  return subtree;
+}
+
+std::vector<std::byte> toBytes(const std::string& s) {
+  std::vector<std::byte> bytes(s.size());
+  std::memcpy(bytes.data(), s.data(), s.size());
+  return bytes;
+}
+
+/**
+ * @brief Serves the implicit tileset, and records when each URL is requested.
+ *
+ * The requests for the child subtrees can be held back, so that they stay in
+ * flight until {@link releaseHeldRequests} is called.
+ */
+class ImplicitTilesetAssetAccessor : public IAssetAccessor {
+public:
+  ImplicitTilesetAssetAccessor() {
+    this->_data.emplace("tileset.json", toBytes(tilesetJson));
+    this->_data.emplace(
+        getSubtreeUrl(QuadtreeTileID(0, 0, 0)),
+        createSubtree(true));
+    for (uint32_t y = 0; y < 4; ++y) {
+      for (uint32_t x = 0; x < 4; ++x) {
+        this->_data.emplace(
+            getSubtreeUrl(QuadtreeTileID(2, x, y)),
+            createSubtree(false));
+      }
+    }
+  }
+
+  virtual Future<std::shared_ptr<IAssetRequest>> requestAsset(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>&) override {
+    ++this->requestCounts[url];
+    this->requestFrames.emplace(url, this->frame);
+
+    auto dataIt = this->_data.find(url);
+    std::shared_ptr<IAssetRequest> pRequest =
+        std::make_shared<SimpleAssetRequest>(
+            "GET",
+            url,
+            HttpHeaders{},
+            std::make_unique<SimpleAssetResponse>(
+                static_cast<uint16_t>(dataIt != this->_data.end() ? 200 : 404),
+                "application/octet-stream",
+                HttpHeaders{},
+                dataIt != this->_data.end() ? dataIt->second
+                                            : std::vector<std::byte>()));
+
+    const bool isChildSubtree =
+        url != "tileset.json" && url != getSubtreeUrl(QuadtreeTileID(0, 0, 0));
+    if (this->holdChildSubtrees && isChildSubtree) {
+      Promise<std::shared_ptr<IAssetRequest>> promise =
+          asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>();
+      Future<std::shared_ptr<IAssetRequest>> future = promise.getFuture();
+      this->_heldRequests.emplace_back(std::move(promise), std::move(pRequest));
+      return future;
+    }
+
+    return asyncSystem.createResolvedFuture(std::move(pRequest));
+  }
+
+  virtual Future<std::shared_ptr<IAssetRequest>> post(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>&) override {
+    return this->requestAsset(asyncSystem, url, headers);
+  }
+
+  virtual void tick() noexcept override {}
+
+  size_t getNumberOfHeldRequests() const noexcept {
+    return this->_heldRequests.size();
+  }
+
+  void releaseHeldRequests() {
+    this->holdChildSubtrees = false;
+    std::vector<std::pair<
+        Promise<std::shared_ptr<IAssetRequest>>,
+        std::shared_ptr<IAssetRequest>>>
+        heldRequests = std::move(this->_heldRequests);
+    this->_heldRequests.clear();
+    for (auto& heldRequest : heldRequests) {
+      heldRequest.first.resolve(std::move(heldRequest.second));
+    }
+  }
+
+  bool holdChildSubtrees = false;
+  int32_t frame = 0;
+  std::map<std::string, size_t> requestCounts;
+  std::map<std::string, int32_t> requestFrames;
+
+private:
+  std::map<std::string, std::vector<std::byte>> _data;
+  std::vector<std::pair<
+      Promise<std::shared_ptr<IAssetRequest>>,
+      std::shared_ptr<IAssetRequest>>>
+      _heldRequests;
+};
+
+ViewState createViewState() {
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  Cartographic viewPositionCartographic{
+      Math::degreesToRadians(118.0),
+      Math::degreesToRadians(32.0),
+      200.0};
+  Cartographic viewFocusCartographic{
+      viewPositionCartographic.longitude + Math::degreesToRadians(0.5),
+      viewPositionCartographic.latitude + Math::degreesToRadians(0.5),
+      0.0};
+  glm::dvec3 viewPosition =
+      ellipsoid.cartographicToCartesian(viewPositionCartographic);
+  glm::dvec3 viewFocus =
+      ellipsoid.cartographicToCartesian(viewFocusCartographic);
+  return ViewState::create(
+      viewPosition,
+      glm::normalize(viewFocus - viewPosition),
+      glm::dvec3(0.0, 0.0, 1.0),
+      glm::dvec2(500.0, 500.0),
+      Math::degreesToRadians(60.0),
+      Math::degreesToRadians(60.0));
+}
+
+/**
+ * @brief Records the frame in which each tile that is the root of a child
+ * subtree was first created.
+ */
+void recordChildSubtreeRoots(
+    const Tile& tile,
+    int32_t frame,
+    std::map<std::string, int32_t>& firstFrames) {
+  const QuadtreeTileID* pID = std::get_if<QuadtreeTileID>(&tile.getTileID());
+  if (pID && pID->level == 2) {
+    firstFrames.emplace(getSubtreeUrl(*pID), frame);
+  }
+
+  for (const Tile& child : tile.getChildren()) {
+    recordChildSubtreeRoots(child, frame, firstFrames);
+  }
+}
+
+} // namespace
+
+TEST_CASE("Child subtrees of implicit tilesets are prefetched") {
+  Cesium3DTilesSelection::registerAllTileContentTypes();
+
+  std::shared_ptr<ImplicitTilesetAssetAccessor> pAccessor =
+      std::make_shared<ImplicitTilesetAssetAccessor>();
+  TilesetExternals externals{
+      pAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  const ViewState viewState = createViewState();
+
+  // Every visible tile is close enough to the camera to prefetch.
+  TilesetOptions options;
+  options.subtreePrefetchDistance = 1.0e7;
+
+  // The frame in which the root tile of each child subtree was created, which
+  // is also the first frame in which the traversal can reach it.
+  std::map<std::string, int32_t> firstFrames;
+
+  SECTION("before the traversal reaches their root tiles") {
+    options.maximumSimultaneousSubtreePrefetches = 16;
+    Tileset tileset(externals, "tileset.json", options);
+
+    for (int32_t frame = 1; frame <= 10; ++frame) {
+      pAccessor->frame = frame;
+      tileset.updateView({viewState});
+      if (tileset.getRootTile()) {
+        recordChildSubtreeRoots(*tileset.getRootTile(), frame, firstFrames);
+      }
+    }
+
+    REQUIRE(!firstFrames.empty());
+    for (const auto& firstFrame : firstFrames) {
+      auto requestIt = pAccessor->requestFrames.find(firstFrame.first);
+      REQUIRE(requestIt != pAccessor->requestFrames.end());
+      CHECK(requestIt->second < firstFrame.second);
+    }
+
+    // Only the tileset and the subtrees were requested, each of them once.
+    CHECK(pAccessor->requestCounts.size() == 18);
+    for (const auto& requestCount : pAccessor->requestCounts) {
+      CHECK(requestCount.second == 1);
+    }
+  }
+
+  SECTION("no more than the maximum at once") {
+    options.maximumSimultaneousSubtreePrefetches = 2;
+    pAccessor->holdChildSubtrees = true;
+    Tileset tileset(externals, "tileset.json", options);
+
+    // Until the traversal creates the root tiles of the child subtrees, all
+    // requests for them are prefetches.
+    size_t prefetchesInFlight = 0;
+    for (int32_t frame = 1; frame <= 10 && firstFrames.empty(); ++frame) {
+      pAccessor->frame = frame;
+      tileset.updateView({viewState});
+      if (tileset.getRootTile()) {
+        recordChildSubtreeRoots(*tileset.getRootTile(), frame, firstFrames);
+      }
+
+      if (firstFrames.empty()) {
+        prefetchesInFlight = pAccessor->getNumberOfHeldRequests();
+        CHECK(prefetchesInFlight <= 2);
+      }
+    }
+
+    // Subtrees that are already being prefetched are not requested again when
+    // the traversal reaches their root tiles.
+    pAccessor->releaseHeldRequests();
+    for (int32_t frame = 11; frame <= 20; ++frame) {
+      pAccessor->frame = frame;
+      tileset.updateView({viewState});
+    }
+
+    REQUIRE(!firstFrames.empty());
+    CHECK(prefetchesInFlight == 2);
+    CHECK(pAccessor->requestCounts.size() == 18);
+    for (const auto& requestCount : pAccessor->requestCounts) {
+      CHECK(requestCount.second == 1);
+    }
+  }
+}
@@ -0,0 +1,473 @@
+#include "Cesium3DTilesSelection/Tileset.h"
+#include "Cesium3DTilesSelection/registerAllTileContentTypes.h"
+#include "SimpleAssetAccessor.h"
+#include "SimpleAssetRequest.h"
+#include "SimpleAssetResponse.h"
+#include "SimplePrepareRendererResource.h"
+#include "SimpleTaskProcessor.h"
+#include "TileContentCache.h"
+#include "readFile.h"
+
+#include <CesiumAsync/IDerivedDataCache.h>
+#include <CesiumGeometry/BoundingSphere.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
+#include <CesiumGltf/ExtensionKhrTextureBasisu.h>
+#include <CesiumGltf/Model.h>
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+
+namespace {
+TileContentLoadResult createContent() {
+  Model model;
+
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(13);
+  for (size_t i = 0; i < buffer.cesium.data.size(); ++i) {
+    buffer.cesium.data[i] = std::byte(static_cast<uint8_t>(3 * i));
+  }
+  buffer.byteLength = 13;
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteOffset = 4;
+  bufferView.byteLength = 8;
+
+  // A 2x2 RGBA image followed by its 1x1 mip level.
+  Image& image = model.images.emplace_back();
+  image.mimeType = Image::MimeType::image_png;
+  image.cesium.width = 2;
+  image.cesium.height = 2;
+  image.cesium.channels = 4;
+  image.cesium.bytesPerChannel = 1;
+  image.cesium.pixelData.resize(20);
+  for (size_t i = 0; i < image.cesium.pixelData.size(); ++i) {
+    image.cesium.pixelData[i] = std::byte(static_cast<uint8_t>(5 * i));
+  }
+  image.cesium.mipPositions = {{0, 16}, {16, 4}};
+
+  model.extras["gltfUpAxis"] = 1;
+
+  const BoundingRegion region(
+      GlobeRectangle(0.1, 0.2, 0.3, 0.4),
+      -10.0,
+      20.0);
+
+  TileContentLoadResult content;
+  content.model = std::move(model);
+  content.updatedBoundingVolume = region;
+  content.overlayDetails = TileContentDetailsForOverlays{
+      {GeographicProjection()},
+      {Rectangle(0.1, 0.2, 0.3, 0.4)},
+      region};
+  return content;
+}
+
+class MemoryDerivedDataEntry : public IDerivedDataEntry {
+public:
+  explicit MemoryDerivedDataEntry(const std::vector<std::byte>& data)
+      : _data(data) {}
+
+  virtual gsl::span<const std::byte> data() const override {
+    return this->_data;
+  }
+
+private:
+  std::vector<std::byte> _data;
+};
+
+class MemoryDerivedDataCache : public IDerivedDataCache {
+public:
+  virtual std::unique_ptr<IDerivedDataEntry>
+  getEntry(const std::string& key) const override {
+    auto it = this->entries.find(key);
+    if (it == this->entries.end()) {
+      return nullptr;
+    }
+    return std::make_unique<MemoryDerivedDataEntry>(it->second);
+  }
+
+  virtual bool storeEntry(
+      const std::string& key,
+      const gsl::span<const std::byte>& data) override {
+    ++this->storeCount;
+    this->entries[key].assign(data.begin(), data.end());
+    return true;
+  }
+
+  std::map<std::string, std::vector<std::byte>> entries;
+  size_t storeCount = 0;
+};
+
+std::filesystem::path getReplaceTilesetPath() {
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  return testDataPath / "ReplaceTileset";
+}
+
+// Creates a tileset whose root content, parent.b3dm, is served with the given
+// ETag and bytes, and waits until the content of its root tile is loaded.
+std::unique_ptr<Tileset> loadRootTile(
+    const std::shared_ptr<IDerivedDataCache>& pCache,
+    const std::string& etag,
+    const std::vector<std::byte>& rootContent) {
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  mockCompletedRequests.insert(
+      {"tileset.json",
+       std::make_shared<SimpleAssetRequest>(
+           "GET",
+           "tileset.json",
+           HttpHeaders{},
+           std::make_unique<SimpleAssetResponse>(
+               static_cast<uint16_t>(200),
+               "doesn't matter",
+               HttpHeaders{},
+               readFile(getReplaceTilesetPath() / "tileset.json")))});
+  mockCompletedRequests.insert(
+      {"parent.b3dm",
+       std::make_shared<SimpleAssetRequest>(
+           "GET",
+           "parent.b3dm",
+           HttpHeaders{},
+           std::make_unique<SimpleAssetResponse>(
+               static_cast<uint16_t>(200),
+               "doesn't matter",
+               HttpHeaders{{"ETag", etag}},
+               rootContent))});
+
+  TilesetExternals externals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+  externals.pDerivedDataCache = pCache;
+
+  auto pTileset = std::make_unique<Tileset>(externals, "tileset.json");
+  while (!pTileset->getRootTile()) {
+    externals.asyncSystem.dispatchMainThreadTasks();
+  }
+
+  Tile* pRoot = pTileset->getRootTile();
+  pRoot->loadContent();
+  while (pRoot->getState() == Tile::LoadState::ContentLoading) {
+    externals.asyncSystem.dispatchMainThreadTasks();
+  }
+
+  return pTileset;
+}
+} // namespace
+
+TEST_CASE("Test tile content cache") {
+  const TileContentLoadResult content = createContent();
+  const std::vector<Projection> projections{GeographicProjection()};
+
+  SECTION("Content survives a round trip") {
+    std::optional<std::vector<std::byte>> data =
+        TileContentCache::write(content);
+    REQUIRE(data);
+
+    std::unique_ptr<TileContentLoadResult> pResult =
+        TileContentCache::read(*data, std::vector<Projection>(projections));
+    REQUIRE(pResult);
+    REQUIRE(pResult->model);
+
+    const Model& model = *pResult->model;
+    REQUIRE(model.buffers.size() == 1);
+    CHECK(
+        model.buffers[0].cesium.data == content.model->buffers[0].cesium.data);
+    CHECK(model.buffers[0].byteLength == 13);
+
+    REQUIRE(model.bufferViews.size() == 1);
+    CHECK(model.bufferViews[0].byteOffset == 4);
+    CHECK(model.bufferViews[0].byteLength == 8);
+
+    REQUIRE(model.images.size() == 1);
+    const ImageCesium& pixels = model.images[0].cesium;
+    CHECK(pixels.width == 2);
+    CHECK(pixels.height == 2);
+    CHECK(pixels.channels == 4);
+    CHECK(pixels.bytesPerChannel == 1);
+    CHECK(pixels.pixelData == content.model->images[0].cesium.pixelData);
+    REQUIRE(pixels.mipPositions.size() == 2);
+    CHECK(pixels.mipPositions[1].byteOffset == 16);
+    CHECK(pixels.mipPositions[1].byteSize == 4);
+
+    auto upAxisIt = model.extras.find("gltfUpAxis");
+    REQUIRE(upAxisIt != model.extras.end());
+    CHECK(upAxisIt->second.getSafeNumberOrDefault<int64_t>(0) == 1);
+
+    REQUIRE(pResult->updatedBoundingVolume);
+    const BoundingRegion* pRegion =
+        std::get_if<BoundingRegion>(&*pResult->updatedBoundingVolume);
+    REQUIRE(pRegion);
+    CHECK(pRegion->getRectangle().getWest() == 0.1);
+    CHECK(pRegion->getMinimumHeight() == -10.0);
+    CHECK(pRegion->getMaximumHeight() == 20.0);
+
+    REQUIRE(pResult->overlayDetails);
+    CHECK(pResult->overlayDetails->rasterOverlayProjections.size() == 1);
+    REQUIRE(pResult->overlayDetails->rasterOverlayRectangles.size() == 1);
+    CHECK(
+        pResult->overlayDetails->rasterOverlayRectangles[0].maximumY == 0.4);
+    CHECK(
+        pResult->overlayDetails->boundingRegion.getRectangle().getNorth() ==
+        0.4);
+  }
+
+  SECTION("Extensions survive the glTF JSON round trip") {
+    TileContentLoadResult withExtensions = createContent();
+    Model& model = *withExtensions.model;
+
+    MeshPrimitive& primitive =
+        model.meshes.emplace_back().primitives.emplace_back();
+    primitive.attributes["POSITION"] = 0;
+    ExtensionKhrDracoMeshCompression& draco =
+        primitive.addExtension<ExtensionKhrDracoMeshCompression>();
+    draco.bufferView = 0;
+    draco.attributes["POSITION"] = 1;
+
+    Texture& texture = model.textures.emplace_back();
+    texture.addExtension<ExtensionKhrTextureBasisu>().source = 0;
+
+    model.extensions.emplace(
+        "EXT_unknown",
+        JsonValue(JsonValue::Object{{"value", JsonValue(3.0)}}));
+
+    std::optional<std::vector<std::byte>> data =
+        TileContentCache::write(withExtensions);
+    REQUIRE(data);
+
+    std::unique_ptr<TileContentLoadResult> pResult =
+        TileContentCache::read(*data, std::vector<Projection>(projections));
+    REQUIRE(pResult);
+    REQUIRE(pResult->model);
+
+    const Model& result = *pResult->model;
+    REQUIRE(result.meshes.size() == 1);
+    REQUIRE(result.meshes[0].primitives.size() == 1);
+    const ExtensionKhrDracoMeshCompression* pDraco =
+        result.meshes[0]
+            .primitives[0]
+            .getExtension<ExtensionKhrDracoMeshCompression>();
+    REQUIRE(pDraco);
+    CHECK(pDraco->bufferView == 0);
+    CHECK(pDraco->attributes.at("POSITION") == 1);
+
+    REQUIRE(result.textures.size() == 1);
+    const ExtensionKhrTextureBasisu* pBasisu =
+        result.textures[0].getExtension<ExtensionKhrTextureBasisu>();
+    REQUIRE(pBasisu);
+    CHECK(pBasisu->source == 0);
+
+    const JsonValue* pUnknown = result.getGenericExtension("EXT_unknown");
+    REQUIRE(pUnknown);
+    CHECK(pUnknown->getSafeNumericalValueForKey<double>("value") == 3.0);
+  }
+
+  SECTION("Content that is not a single model is not cached") {
+    CHECK(!TileContentCache::write(TileContentLoadResult()));
+
+    TileContentLoadResult withChildren = createContent();
+    withChildren.childTiles.emplace();
+    CHECK(!TileContentCache::write(withChildren));
+
+    TileContentLoadResult withOcclusionPoint = createContent();
+    withOcclusionPoint.horizonOcclusionPoint = glm::dvec3(1.0, 2.0, 3.0);
+    CHECK(!TileContentCache::write(withOcclusionPoint));
+  }
+
+  SECTION("Entries for other projections are rejected") {
+    std::optional<std::vector<std::byte>> data =
+        TileContentCache::write(content);
+    REQUIRE(data);
+    CHECK(!TileContentCache::read(*data, {}));
+  }
+
+  SECTION("Truncated data is rejected") {
+    std::optional<std::vector<std::byte>> data =
+        TileContentCache::write(content);
+    REQUIRE(data);
+    while (!data->empty()) {
+      data->pop_back();
+      CHECK(
+          !TileContentCache::read(*data, std::vector<Projection>(projections)));
+    }
+  }
+
+  SECTION("Inconsistent images are rejected") {
+    TileContentLoadResult inconsistent = createContent();
+    ImageCesium& pixels = inconsistent.model->images[0].cesium;
+
+    SECTION("a mip level past the end of the pixels") {
+      pixels.mipPositions[1].byteSize = 5;
+    }
+
+    SECTION("a mip level whose end overflows") {
+      pixels.mipPositions[1].byteOffset = std::numeric_limits<size_t>::max();
+    }
+
+    SECTION("mip levels that don't match the dimensions") {
+      pixels.mipPositions = {{0, 12}, {12, 8}};
+    }
+
+    SECTION("dimensions that don't match the pixels") {
+      pixels.mipPositions.clear();
+      pixels.width = 3;
+    }
+
+    SECTION("dimensions that overflow") {
+      pixels.mipPositions.clear();
+      pixels.width = std::numeric_limits<int32_t>::max();
+      pixels.height = std::numeric_limits<int32_t>::max();
+      pixels.channels = std::numeric_limits<int32_t>::max();
+      pixels.bytesPerChannel = std::numeric_limits<int32_t>::max();
+    }
+
+    SECTION("negative dimensions") { pixels.height = -2; }
+
+    std::optional<std::vector<std::byte>> data =
+        TileContentCache::write(inconsistent);
+    REQUIRE(data);
+    CHECK(!TileContentCache::read(*data, std::vector<Projection>(projections)));
+  }
+
+  SECTION("Keys depend on everything the content depends on") {
+    const TilesetContentOptions options;
+    const glm::dmat4 transform(1.0);
+    const BoundingVolume volume =
+        BoundingSphere(glm::dvec3(1.0, 2.0, 3.0), 4.0);
+
+    const std::string key = TileContentCache::getKey(
+        "https://example.com/0.b3dm",
+        "a",
+        options,
+        projections,
+        Axis::Y,
+        transform,
+        volume,
+        std::nullopt);
+
+    CHECK(
+        key != TileContentCache::getKey(
+                   "https://example.com/0.b3dm",
+                   "b",
+                   options,
+                   projections,
+                   Axis::Y,
+                   transform,
+                   volume,
+                   std::nullopt));
+
+    TilesetContentOptions normalsOptions;
+    normalsOptions.generateMissingNormalsSmooth = true;
+    CHECK(
+        key != TileContentCache::getKey(
+                   "https://example.com/0.b3dm",
+                   "a",
+                   normalsOptions,
+                   projections,
+                   Axis::Y,
+                   transform,
+                   volume,
+                   std::nullopt));
+
+    CHECK(
+        key != TileContentCache::getKey(
+                   "https://example.com/0.b3dm",
+                   "a",
+                   options,
+                   {},
+                   Axis::Y,
+                   transform,
+                   volume,
+                   std::nullopt));
+
+    CHECK(
+        key != TileContentCache::getKey(
+                   "https://example.com/0.b3dm",
+                   "a",
+                   options,
+                   projections,
+                   Axis::Z,
+                   transform,
+                   volume,
+                   std::nullopt));
+
+    CHECK(
+        key != TileContentCache::getKey(
+                   "https://example.com/0.b3dm",
+                   "a",
+                   options,
+                   projections,
+                   Axis::Y,
+                   glm::dmat4(2.0),
+                   volume,
+                   std::nullopt));
+  }
+}
+
+TEST_CASE("Tiles load processed content from the derived data cache") {
+  Cesium3DTilesSelection::registerAllTileContentTypes();
+
+  std::shared_ptr<MemoryDerivedDataCache> pCache =
+      std::make_shared<MemoryDerivedDataCache>();
+
+  std::unique_ptr<Tileset> pFirst = loadRootTile(
+      pCache,
+      "\"parent\"",
+      readFile(getReplaceTilesetPath() / "parent.b3dm"));
+  const Tile* pFirstRoot = pFirst->getRootTile();
+  REQUIRE(pFirstRoot->getState() == Tile::LoadState::ContentLoaded);
+  REQUIRE(pFirstRoot->getContent());
+  REQUIRE(pFirstRoot->getContent()->model);
+  CHECK(pCache->storeCount == 1);
+  CHECK(pCache->entries.size() == 1);
+
+  const Model& loaded = *pFirstRoot->getContent()->model;
+
+  SECTION("a response with the same ETag is not decoded again") {
+    // The body of the response is not a tile at all, so the content can only
+    // come from the cache.
+    std::unique_ptr<Tileset> pSecond =
+        loadRootTile(pCache, "\"parent\"", std::vector<std::byte>(16));
+    const Tile* pSecondRoot = pSecond->getRootTile();
+    REQUIRE(pSecondRoot->getState() == Tile::LoadState::ContentLoaded);
+    REQUIRE(pSecondRoot->getContent());
+    REQUIRE(pSecondRoot->getContent()->model);
+    CHECK(pSecondRoot->getRendererResources() != nullptr);
+    CHECK(pCache->storeCount == 1);
+
+    const Model& cached = *pSecondRoot->getContent()->model;
+    CHECK(cached.meshes.size() == loaded.meshes.size());
+    CHECK(cached.accessors.size() == loaded.accessors.size());
+    REQUIRE(cached.buffers.size() == loaded.buffers.size());
+    for (size_t i = 0; i < cached.buffers.size(); ++i) {
+      CHECK(cached.buffers[i].cesium.data == loaded.buffers[i].cesium.data);
+    }
+  }
+
+  SECTION("a response with another ETag misses the cache") {
+    std::unique_ptr<Tileset> pSecond =
+        loadRootTile(pCache, "\"changed\"", std::vector<std::byte>(16));
+    const Tile* pSecondRoot = pSecond->getRootTile();
+    CHECK(
+        (!pSecondRoot->getContent() || !pSecondRoot->getContent()->model));
+    CHECK(pCache->storeCount == 1);
+  }
+}
@@ -0,0 +1,266 @@
+#include "Cesium3DTilesSelection/Tileset.h"
+#include "Cesium3DTilesSelection/TilesetGroup.h"
+#include "Cesium3DTilesSelection/ViewState.h"
+#include "Cesium3DTilesSelection/registerAllTileContentTypes.h"
+#include "SimpleAssetAccessor.h"
+#include "SimpleAssetRequest.h"
+#include "SimpleAssetResponse.h"
+#include "SimplePrepareRendererResource.h"
+#include "SimpleTaskProcessor.h"
+#include "readFile.h"
+
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <variant>
+
+using namespace CesiumAsync;
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+namespace {
+
+TilesetExternals createExternals() {
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  return TilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+}
+
+ViewState createViewState() {
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  Cartographic viewPositionCartographic{
+      Math::degreesToRadians(118.0),
+      Math::degreesToRadians(32.0),
+      200.0};
+  Cartographic viewFocusCartographic{
+      viewPositionCartographic.longitude + Math::degreesToRadians(0.5),
+      viewPositionCartographic.latitude + Math::degreesToRadians(0.5),
+      0.0};
+  glm::dvec3 viewPosition =
+      ellipsoid.cartographicToCartesian(viewPositionCartographic);
+  glm::dvec3 viewFocus =
+      ellipsoid.cartographicToCartesian(viewFocusCartographic);
+  return ViewState::create(
+      viewPosition,
+      glm::normalize(viewFocus - viewPosition),
+      glm::dvec3(0.0, 0.0, 1.0),
+      glm::dvec2(500.0, 500.0),
+      Math::degreesToRadians(60.0),
+      Math::degreesToRadians(60.0));
+}
+
+ViewState zoomToTileset(const Tileset& tileset) {
+  const Tile* pRoot = tileset.getRootTile();
+  REQUIRE(pRoot != nullptr);
+
+  const BoundingRegion* pRegion =
+      std::get_if<BoundingRegion>(&pRoot->getBoundingVolume());
+  REQUIRE(pRegion != nullptr);
+
+  const GlobeRectangle& rectangle = pRegion->getRectangle();
+  Cartographic corner = rectangle.getNorthwest();
+  corner.height = pRegion->getMaximumHeight();
+
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  glm::dvec3 viewPosition = ellipsoid.cartographicToCartesian(corner);
+  glm::dvec3 viewFocus =
+      ellipsoid.cartographicToCartesian(rectangle.computeCenter());
+  return ViewState::create(
+      viewPosition,
+      glm::normalize(viewFocus - viewPosition),
+      glm::dvec3(0.0, 0.0, 1.0),
+      glm::dvec2(500.0, 500.0),
+      Math::degreesToRadians(60.0),
+      Math::degreesToRadians(60.0));
+}
+
+// Moves the camera back far enough for the root tile of the test tileset to
+// meet the SSE.
+ViewState zoomOut(const ViewState& viewState) {
+  return ViewState::create(
+      viewState.getPosition() - viewState.getDirection() * 2500.0,
+      viewState.getDirection(),
+      viewState.getUp(),
+      viewState.getViewportSize(),
+      viewState.getHorizontalFieldOfView(),
+      viewState.getVerticalFieldOfView());
+}
+
+bool areChildrenDone(const Tileset& tileset) {
+  const Tile* pRoot = tileset.getRootTile();
+  if (!pRoot || pRoot->getChildren().empty()) {
+    return false;
+  }
+
+  for (const Tile& child : pRoot->getChildren()) {
+    if (child.getState() != Tile::LoadState::Done) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int64_t computeChildrenByteSize(const Tileset& tileset) {
+  int64_t bytes = 0;
+  for (const Tile& child : tileset.getRootTile()->getChildren()) {
+    bytes += child.computeByteSize();
+  }
+  return bytes;
+}
+
+} // namespace
+
+TEST_CASE("TilesetGroup") {
+  Cesium3DTilesSelection::registerAllTileContentTypes();
+
+  const ViewState viewState = createViewState();
+
+  TilesetGroupOptions groupOptions;
+  groupOptions.maximumSimultaneousTileLoads = 1;
+  std::shared_ptr<TilesetGroup> pGroup =
+      std::make_shared<TilesetGroup>(groupOptions);
+
+  TilesetOptions options;
+  options.group = pGroup;
+
+  SECTION("tilesets join and leave the group") {
+    {
+      Tileset tileset(createExternals(), "tileset.json", options);
+      REQUIRE(pGroup->getTilesets().size() == 1);
+      CHECK(pGroup->getTilesets()[0] == &tileset);
+    }
+    CHECK(pGroup->getTilesets().empty());
+  }
+
+  SECTION("the load limit is shared by all tilesets") {
+    Tileset first(createExternals(), "tileset.json", options);
+    Tileset second(createExternals(), "tileset.json", options);
+    REQUIRE(pGroup->getTilesets().size() == 2);
+
+    // Members don't load tiles themselves.
+    first.updateView({viewState});
+    second.updateView({viewState});
+    CHECK(pGroup->getNumberOfLoadsInProgress() == 0);
+
+    // Only one of the root tiles may start loading, because the group allows
+    // only one load at a time.
+    pGroup->update();
+    REQUIRE(first.getRootTile());
+    REQUIRE(second.getRootTile());
+    const bool firstLoading =
+        first.getRootTile()->getState() == Tile::LoadState::ContentLoading;
+    const bool secondLoading =
+        second.getRootTile()->getState() == Tile::LoadState::ContentLoading;
+    CHECK(firstLoading != secondLoading);
+    CHECK(pGroup->getNumberOfLoadsInProgress() == 1);
+
+    // The other tileset gets its turn once the first load is done.
+    Tile* pWaiting = firstLoading ? second.getRootTile() : first.getRootTile();
+    for (int frame = 0;
+         frame < 10 && pWaiting->getState() == Tile::LoadState::Unloaded;
+         ++frame) {
+      first.updateView({viewState});
+      second.updateView({viewState});
+      pGroup->update();
+      CHECK(pGroup->getNumberOfLoadsInProgress() <= 1);
+    }
+    CHECK(pWaiting->getState() != Tile::LoadState::Unloaded);
+
+    CHECK(
+        pGroup->getTotalDataBytes() ==
+        first.getTotalDataBytes() + second.getTotalDataBytes());
+  }
+
+  SECTION("the tiles unused for the most frames are unloaded first") {
+    pGroup->getOptions().maximumSimultaneousTileLoads = 20;
+
+    Tileset first(createExternals(), "tileset.json", options);
+    Tileset second(createExternals(), "tileset.json", options);
+
+    // Load the root tiles, and then their children.
+    first.updateView({viewState});
+    second.updateView({viewState});
+    pGroup->update();
+
+    const ViewState nearView = zoomToTileset(first);
+    for (int frame = 0;
+         frame < 20 && !(areChildrenDone(first) && areChildrenDone(second));
+         ++frame) {
+      first.updateView({nearView});
+      second.updateView({nearView});
+      pGroup->update();
+    }
+    REQUIRE(areChildrenDone(first));
+    REQUIRE(areChildrenDone(second));
+
+    // The first tileset stops using the children three frames before the end
+    // of this loop, the second only in the last frame.
+    const ViewState farView = zoomOut(nearView);
+    for (int frame = 0; frame < 3; ++frame) {
+      first.updateView({farView});
+      second.updateView({frame < 2 ? nearView : farView});
+      pGroup->update();
+    }
+    REQUIRE(areChildrenDone(first));
+    REQUIRE(areChildrenDone(second));
+
+    // Only leave room for the children of one tileset.
+    const int64_t firstChildrenBytes = computeChildrenByteSize(first);
+    const int64_t secondChildrenBytes = computeChildrenByteSize(second);
+    REQUIRE(firstChildrenBytes > 0);
+    REQUIRE(secondChildrenBytes > 0);
+    pGroup->getOptions().maximumCachedBytes =
+        pGroup->getTotalDataBytes() - firstChildrenBytes;
+
+    first.updateView({farView});
+    second.updateView({farView});
+    pGroup->update();
+
+    CHECK(
+        pGroup->getTotalDataBytes() <=
+        pGroup->getOptions().maximumCachedBytes);
+    for (const Tile& child : first.getRootTile()->getChildren()) {
+      CHECK(child.getState() == Tile::LoadState::Unloaded);
+    }
+    CHECK(areChildrenDone(second));
+    CHECK(computeChildrenByteSize(second) == secondChildrenBytes);
+  }
+}
@@ -1,3 +1,4 @@
+#include "Cesium3DTilesSelection/ITileExcluder.h"
 #include "Cesium3DTilesSelection/Tileset.h"
 #include "Cesium3DTilesSelection/ViewState.h"
 #include "Cesium3DTilesSelection/registerAllTileContentTypes.h"
@@ -17,6 +18,7 @@
 #include <cstddef>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 
 using namespace CesiumAsync;
 using namespace Cesium3DTilesSelection;
@@ -115,6 +117,35 @@ static ViewState zoomToTileset(const Tileset& tileset) {
   return zoomToTile(*root);
 }
 
+static void requireTraversedAfterChange(
+    Tileset& tileset,
+    const ViewState& viewState,
+    const std::function<void(TilesetOptions&)>& change) {
+  {
+    ViewUpdateResult result = tileset.updateView({viewState});
+    REQUIRE(result.tilesVisited == 0);
+    REQUIRE(result.tilesReusedFromPreviousFrames == 5);
+  }
+
+  change(tileset.getOptions());
+
+  {
+    ViewUpdateResult result = tileset.updateView({viewState});
+    REQUIRE(result.tilesToRenderThisFrame.size() == 4);
+    REQUIRE(result.tilesVisited == 5);
+    REQUIRE(result.tilesReusedFromPreviousFrames == 0);
+  }
+}
+
+namespace {
+class ExcludeNothing : public ITileExcluder {
+public:
+  virtual bool shouldExclude(const Tile&) const noexcept override {
+    return false;
+  }
+};
+} // namespace
+
 TEST_CASE("Test replace refinement for render") {
   Cesium3DTilesSelection::registerAllTileContentTypes();
 
@@ -517,6 +548,140 @@ TEST_CASE("Test replace refinement for render") {
       REQUIRE(result.culledTilesVisited == 0);
     }
   }
+
+  SECTION("Unchanged subtrees are reused with frame-coherent selection") {
+    tileset.getOptions().enableFrameCoherentSelection = true;
+
+    ViewState viewState = zoomToTileset(tileset);
+
+    // 1st and 2nd frame. The children load and replace the root.
+    tileset.updateView({viewState});
+    tileset.updateView({viewState});
+
+    // 3rd frame. Nothing changed since the last frame, so the whole tree is
+    // traversed one more time and its selection is remembered.
+    std::vector<Tile*> tilesToRender;
+    {
+      ViewUpdateResult result = tileset.updateView({viewState});
+      REQUIRE(result.tilesToRenderThisFrame.size() == 4);
+      REQUIRE(result.tilesToNoLongerRenderThisFrame.size() == 0);
+      REQUIRE(result.tilesVisited == 5);
+      REQUIRE(result.tilesReusedFromPreviousFrames == 0);
+      tilesToRender = result.tilesToRenderThisFrame;
+    }
+
+    // 4th frame. The view didn't change, so the remembered selection is
+    // reused without visiting any tile.
+    {
+      ViewUpdateResult result = tileset.updateView({viewState});
+      REQUIRE(result.tilesToRenderThisFrame == tilesToRender);
+      REQUIRE(result.tilesToNoLongerRenderThisFrame.size() == 0);
+      REQUIRE(result.tilesVisited == 0);
+      REQUIRE(result.tilesReusedFromPreviousFrames == 5);
+
+      for (const Tile* pTile : tilesToRender) {
+        REQUIRE(
+            pTile->getLastSelectionState().getResult(
+                root->getLastSelectionState().getFrameNumber()) ==
+            TileSelectionState::Result::Rendered);
+      }
+    }
+
+    // 5th frame. The camera zoomed out far enough for the root to meet the
+    // SSE, so the tree has to be traversed again.
+    {
+      glm::dvec3 zoomOutPosition =
+          viewState.getPosition() - viewState.getDirection() * 2500.0;
+      ViewState zoomOutViewState = ViewState::create(
+          zoomOutPosition,
+          viewState.getDirection(),
+          viewState.getUp(),
+          viewState.getViewportSize(),
+          viewState.getHorizontalFieldOfView(),
+          viewState.getVerticalFieldOfView());
+
+      ViewUpdateResult result = tileset.updateView({zoomOutViewState});
+      REQUIRE(result.tilesToRenderThisFrame.size() == 1);
+      REQUIRE(result.tilesToRenderThisFrame.front() == root);
+      REQUIRE(result.tilesToNoLongerRenderThisFrame.size() == 4);
+      REQUIRE(result.tilesVisited == 1);
+      REQUIRE(result.tilesReusedFromPreviousFrames == 0);
+    }
+  }
+
+  SECTION("Remembered subtrees are forgotten when a selection option "
+          "changes") {
+    tileset.getOptions().enableFrameCoherentSelection = true;
+
+    ViewState viewState = zoomToTileset(tileset);
+
+    // The children load and replace the root in the 1st and 2nd frame, and
+    // the selection is remembered in the 3rd.
+    for (int32_t frame = 0; frame < 3; ++frame) {
+      tileset.updateView({viewState});
+    }
+
+    requireTraversedAfterChange(
+        tileset,
+        viewState,
+        [](TilesetOptions& options) { options.forbidHoles = true; });
+    requireTraversedAfterChange(
+        tileset,
+        viewState,
+        [](TilesetOptions& options) { options.enableFogCulling = false; });
+    requireTraversedAfterChange(
+        tileset,
+        viewState,
+        [](TilesetOptions& options) { options.enableFrustumCulling = false; });
+    requireTraversedAfterChange(
+        tileset,
+        viewState,
+        [](TilesetOptions& options) {
+          options.excluders.emplace_back(std::make_shared<ExcludeNothing>());
+        });
+  }
+
+  SECTION("Tiles behind the horizon are culled with horizon culling") {
+    tileset.getOptions().enableFogCulling = false;
+
+    // Look at the tileset through the globe, from high above the other side.
+    const BoundingRegion* pRegion =
+        std::get_if<BoundingRegion>(&root->getBoundingVolume());
+    REQUIRE(pRegion != nullptr);
+    Cartographic center = pRegion->getRectangle().computeCenter();
+    Cartographic antipode{
+        center.longitude + Math::ONE_PI,
+        -center.latitude,
+        1000000.0};
+
+    const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+    glm::dvec3 viewPosition = ellipsoid.cartographicToCartesian(antipode);
+    glm::dvec3 viewFocus = ellipsoid.cartographicToCartesian(center);
+    ViewState viewState = ViewState::create(
+        viewPosition,
+        glm::normalize(viewFocus - viewPosition),
+        glm::dvec3(0.0, 0.0, 1.0),
+        glm::dvec2(500.0, 500.0),
+        Math::degreesToRadians(60.0),
+        Math::degreesToRadians(60.0));
+
+    {
+      ViewUpdateResult result = tileset.updateView({viewState});
+      REQUIRE(result.tilesCulled == 0);
+      REQUIRE(result.tilesHorizonCulled == 0);
+    }
+
+    tileset.getOptions().enableHorizonCulling = true;
+
+    {
+      ViewUpdateResult result = tileset.updateView({viewState});
+      REQUIRE(result.tilesToRenderThisFrame.size() == 0);
+      REQUIRE(result.tilesVisited == 0);
+      REQUIRE(result.tilesCulled == 1);
+      REQUIRE(result.tilesHorizonCulled == 1);
+      REQUIRE(root->getHorizonOcclusionPoint());
+    }
+  }
 }
 
 TEST_CASE("Test additive refinement") {
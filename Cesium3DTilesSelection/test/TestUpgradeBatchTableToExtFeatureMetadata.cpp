@@ -15,14 +15,30 @@
 
 #include <catch2/catch.hpp>
 #include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 #include <spdlog/spdlog.h>
 
+#include <cstring>
 #include <filesystem>
 #include <set>
 
 using namespace CesiumGltf;
 using namespace Cesium3DTilesSelection;
 
+static std::vector<std::byte> toBytes(const std::string& json) {
+  std::vector<std::byte> bytes(json.size());
+  std::memcpy(bytes.data(), json.data(), json.size());
+  return bytes;
+}
+
+static std::vector<std::byte> writeJson(const rapidjson::Document& document) {
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  return toBytes(std::string(buffer.GetString(), buffer.GetSize()));
+}
+
 template <typename ExpectedType, typename PropertyViewType = ExpectedType>
 static void checkScalarProperty(
     const Model& model,
@@ -144,7 +160,7 @@ static void createTestForScalarJson(
       spdlog::default_logger(),
       model,
       featureTableJson,
-      batchTableJson,
+      writeJson(batchTableJson),
       gsl::span<const std::byte>());
 
   ExtensionModelExtFeatureMetadata* metadata =
@@ -221,7 +237,7 @@ static void createTestForArrayJson(
       spdlog::default_logger(),
       model,
       featureTableJson,
-      batchTableJson,
+      writeJson(batchTableJson),
       gsl::span<const std::byte>());
 
   ExtensionModelExtFeatureMetadata* metadata =
@@ -708,7 +724,7 @@ TEST_CASE("Upgrade bool json to boolean binary") {
       spdlog::default_logger(),
       model,
       featureTableJson,
-      batchTableJson,
+      writeJson(batchTableJson),
       gsl::span<const std::byte>());
 
   ExtensionModelExtFeatureMetadata* metadata =
@@ -1191,3 +1207,157 @@ TEST_CASE("Cannot write pass batch length table") {
         2);
   }
 }
+
+TEST_CASE("Upgrade json values that need a wider type") {
+  Model model;
+
+  rapidjson::Document featureTableJson;
+  featureTableJson.Parse(R"({"BATCH_LENGTH": 4})");
+
+  const std::string batchTableJson = R"({
+    "widened": [1, -1, 300, 70000],
+    "float": [1, 2, 0.5, 100],
+    "mixed": [1, "a", true, null],
+    "widenedArray": [[1, 2], [-1], [300, 70000], []],
+    "mixedArray": [[1, 2], ["a"], [true], []]
+  })";
+
+  upgradeBatchTableToFeatureMetadata(
+      spdlog::default_logger(),
+      model,
+      featureTableJson,
+      toBytes(batchTableJson),
+      gsl::span<const std::byte>());
+
+  ExtensionModelExtFeatureMetadata* metadata =
+      model.getExtension<ExtensionModelExtFeatureMetadata>();
+  REQUIRE(metadata != nullptr);
+
+  const Class& defaultClass = metadata->schema->classes.at("default");
+  const FeatureTable& featureTable = metadata->featureTables["default"];
+  REQUIRE(defaultClass.properties.size() == 5);
+
+  checkScalarProperty<int32_t>(
+      model,
+      featureTable,
+      defaultClass,
+      "widened",
+      "INT32",
+      {1, -1, 300, 70000},
+      4);
+
+  checkScalarProperty<float>(
+      model,
+      featureTable,
+      defaultClass,
+      "float",
+      "FLOAT32",
+      {1.0f, 2.0f, 0.5f, 100.0f},
+      4);
+
+  checkScalarProperty<std::string, std::string_view>(
+      model,
+      featureTable,
+      defaultClass,
+      "mixed",
+      "STRING",
+      {"1", "a", "true", "null"},
+      4);
+
+  checkArrayProperty<int32_t>(
+      model,
+      featureTable,
+      defaultClass,
+      "widenedArray",
+      0,
+      "INT32",
+      {{1, 2}, {-1}, {300, 70000}, {}},
+      4);
+
+  checkScalarProperty<std::string, std::string_view>(
+      model,
+      featureTable,
+      defaultClass,
+      "mixedArray",
+      "STRING",
+      {"[1,2]", "[\"a\"]", "[true]", "[]"},
+      4);
+}
+
+TEST_CASE("Upgrade json values that do not fit the first value to strings") {
+  Model model;
+
+  rapidjson::Document featureTableJson;
+  featureTableJson.Parse(R"({"BATCH_LENGTH": 3})");
+
+  const std::string batchTableJson = R"({
+    "extensions": { "3DTILES_batch_table_hierarchy": { "classes": [] } },
+    "extras": [1, 2, 3],
+    "short": [1, 2],
+    "late": [ 1, 2, { "a": [1, "b"] } ],
+    "nested": [ { "a": 1 }, [1, [2]], "c", 4 ]
+  })";
+
+  upgradeBatchTableToFeatureMetadata(
+      spdlog::default_logger(),
+      model,
+      featureTableJson,
+      toBytes(batchTableJson),
+      gsl::span<const std::byte>());
+
+  ExtensionModelExtFeatureMetadata* metadata =
+      model.getExtension<ExtensionModelExtFeatureMetadata>();
+  REQUIRE(metadata != nullptr);
+
+  const Class& defaultClass = metadata->schema->classes.at("default");
+  const FeatureTable& featureTable = metadata->featureTables["default"];
+  REQUIRE(defaultClass.properties.size() == 3);
+
+  checkScalarProperty<std::string, std::string_view>(
+      model,
+      featureTable,
+      defaultClass,
+      "short",
+      "STRING",
+      {"1", "2", ""},
+      3);
+
+  checkScalarProperty<std::string, std::string_view>(
+      model,
+      featureTable,
+      defaultClass,
+      "late",
+      "STRING",
+      {"1", "2", R"({"a":[1,"b"]})"},
+      3);
+
+  checkScalarProperty<std::string, std::string_view>(
+      model,
+      featureTable,
+      defaultClass,
+      "nested",
+      "STRING",
+      {R"({"a":1})", "[1,[2]]", "c"},
+      3);
+}
+
+TEST_CASE("Batch table JSON that cannot be read is ignored") {
+  Model model;
+
+  rapidjson::Document featureTableJson;
+  featureTableJson.Parse(R"({"BATCH_LENGTH": 2})");
+
+  const std::string batchTableJson = GENERATE(
+      std::string(R"({"a": [1, 2])"),
+      std::string(R"([{"a": [1, 2]}])"),
+      std::string("1"));
+
+  upgradeBatchTableToFeatureMetadata(
+      spdlog::default_logger(),
+      model,
+      featureTableJson,
+      toBytes(batchTableJson),
+      gsl::span<const std::byte>());
+
+  CHECK(model.getExtension<ExtensionModelExtFeatureMetadata>() == nullptr);
+}
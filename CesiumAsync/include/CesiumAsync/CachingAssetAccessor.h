@@ -5,6 +5,8 @@
 #include "ICacheDatabase.h"
 #include "ThreadPool.h"
 
+#include <CesiumUtility/Metrics.h>
+
 #include <spdlog/fwd.h>
 
 #include <atomic>
@@ -35,12 +37,17 @@ public:
    * responses.
    * @param requestsPerCachePrune The number of requests to handle before each
    * {@link ICacheDatabase::prune} of old cached results from the database.
+   * @param pMetrics The registry that receives the latency of each request,
+   * labeled by whether it was a cache hit, a cache miss, or a stale cache
+   * entry that had to be revalidated. If `nullptr`, no metrics are recorded.
    */
   CachingAssetAccessor(
       const std::shared_ptr<spdlog::logger>& pLogger,
       const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
       const std::shared_ptr<ICacheDatabase>& pCacheDatabase,
-      int32_t requestsPerCachePrune = 10000);
+      int32_t requestsPerCachePrune = 10000,
+      const std::shared_ptr<CesiumUtility::MetricsRegistry>& pMetrics =
+          nullptr);
 
   virtual ~CachingAssetAccessor() noexcept override;
 
@@ -66,6 +73,10 @@ private:
   std::shared_ptr<IAssetAccessor> _pAssetAccessor;
   std::shared_ptr<ICacheDatabase> _pCacheDatabase;
   ThreadPool _cacheThreadPool;
+  std::shared_ptr<CesiumUtility::MetricsRegistry> _pMetrics;
+  CesiumUtility::LatencyHistogram* _pCacheHitLatency;
+  CesiumUtility::LatencyHistogram* _pCacheMissLatency;
+  CesiumUtility::LatencyHistogram* _pCacheRevalidateLatency;
   CESIUM_TRACE_DECLARE_TRACK_SET(_pruneSlots, "Prune cache database");
 };
 } // namespace CesiumAsync
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "IDerivedDataCache.h"
+#include "Library.h"
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace CesiumAsync {
+
+/**
+ * @brief An {@link IDerivedDataCache} that stores each entry in its own file
+ * in a directory, and memory-maps the file when the entry is read.
+ *
+ * The name of each file is a hash of its key. The file also holds the key
+ * itself, so that entries whose keys have the same hash are told apart.
+ * Entries are written to a temporary file first and then renamed, so a
+ * reader never sees a partially written entry.
+ *
+ * When the entries known to an instance take more than its maximum number of
+ * bytes, it deletes the least recently used ones. An instance knows about the
+ * entries that were in the directory when it was created, which it treats as
+ * used in the order they were written, and the entries it reads or stores
+ * itself. To clear the cache, delete the directory while no instance uses it.
+ */
+class CESIUMASYNC_API FileDerivedDataCache final : public IDerivedDataCache {
+public:
+  /**
+   * @brief Creates a cache that stores its entries in the given directory.
+   *
+   * The directory is created if it does not exist, but its parent must. If
+   * the entries already in the directory take more than `maximumBytes`, the
+   * oldest ones are deleted.
+   *
+   * @param directory The directory.
+   * @param maximumBytes The maximum number of bytes of the entry files, after
+   * which the least recently used entries are deleted.
+   */
+  explicit FileDerivedDataCache(
+      const std::string& directory,
+      uint64_t maximumBytes = 1024 * 1024 * 1024);
+
+  /** @copydoc IDerivedDataCache::getEntry */
+  virtual std::unique_ptr<IDerivedDataEntry>
+  getEntry(const std::string& key) const override;
+
+  /** @copydoc IDerivedDataCache::storeEntry */
+  virtual bool storeEntry(
+      const std::string& key,
+      const gsl::span<const std::byte>& data) override;
+
+private:
+  struct IndexEntry {
+    uint64_t hash;
+    uint64_t bytes;
+  };
+
+  std::string getEntryPath(uint64_t hash) const;
+
+  // Must be called with _indexLock held.
+  void markUsed(uint64_t hash, uint64_t bytes) const;
+  void prune(std::optional<uint64_t> keepHash) const;
+
+  std::string _directory;
+  uint64_t _maximumBytes;
+  std::string _temporaryFileSuffix;
+  std::atomic<uint64_t> _nextTemporaryFile;
+
+  // The entries known to this instance, from least to most recently used,
+  // indexed by the hash of their key.
+  mutable std::mutex _indexLock;
+  mutable std::list<IndexEntry> _entries;
+  mutable std::unordered_map<uint64_t, std::list<IndexEntry>::iterator> _index;
+  mutable uint64_t _totalBytes;
+};
+
+} // namespace CesiumAsync
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Library.h"
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace CesiumAsync {
+
+/**
+ * @brief The bytes of an entry in an {@link IDerivedDataCache}.
+ *
+ * The bytes may be mapped directly from the storage of the cache, so they
+ * are only valid as long as this instance exists.
+ */
+class CESIUMASYNC_API IDerivedDataEntry {
+public:
+  virtual ~IDerivedDataEntry() noexcept = default;
+
+  /**
+   * @brief Gets the bytes of the entry.
+   *
+   * The first byte is aligned to at least 8 bytes, so formats made of
+   * naturally aligned fixed-size fields can be read in place.
+   */
+  virtual gsl::span<const std::byte> data() const = 0;
+};
+
+/**
+ * @brief Stores data that was derived from downloaded assets, such as parsed
+ * or decoded content, so that it does not need to be derived again when the
+ * same asset is loaded later.
+ *
+ * Unlike an {@link ICacheDatabase}, which stores responses as they were
+ * received, this cache stores the output of processing a response, in a
+ * format chosen by its user. The key must identify both the asset, e.g. with
+ * its URL and ETag, and the version of that format.
+ *
+ * Implementations must be safe to use from multiple threads at once.
+ */
+class CESIUMASYNC_API IDerivedDataCache {
+public:
+  virtual ~IDerivedDataCache() noexcept = default;
+
+  /**
+   * @brief Gets an entry from the cache.
+   *
+   * @param key The unique key of the entry.
+   * @return The entry, or `nullptr` if the key does not exist in the cache or
+   * an error occurred.
+   */
+  virtual std::unique_ptr<IDerivedDataEntry>
+  getEntry(const std::string& key) const = 0;
+
+  /**
+   * @brief Stores an entry in the cache, replacing any entry with the same
+   * key.
+   *
+   * @param key The unique key of the entry.
+   * @param data The bytes to store.
+   * @return `true` if the entry was stored, or `false` if it could not be
+   * stored due to an error.
+   */
+  virtual bool storeEntry(
+      const std::string& key,
+      const gsl::span<const std::byte>& data) = 0;
+};
+
+} // namespace CesiumAsync
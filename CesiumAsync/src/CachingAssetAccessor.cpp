@@ -9,6 +9,7 @@
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <iomanip>
 #include <sstream>
@@ -90,17 +91,30 @@ static std::time_t calculateExpiryTime(
 static std::unique_ptr<IAssetRequest>
 updateCacheItem(CacheItem&& cacheItem, const IAssetRequest& request);
 
+static CesiumUtility::LatencyHistogram* getRequestLatency(
+    const std::shared_ptr<CesiumUtility::MetricsRegistry>& pMetrics,
+    const std::string& cacheResult);
+
+static void recordLatency(
+    CesiumUtility::LatencyHistogram* pHistogram,
+    std::chrono::steady_clock::time_point start) noexcept;
+
 CachingAssetAccessor::CachingAssetAccessor(
     const std::shared_ptr<spdlog::logger>& pLogger,
     const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
     const std::shared_ptr<ICacheDatabase>& pCacheDatabase,
-    int32_t requestsPerCachePrune)
+    int32_t requestsPerCachePrune,
+    const std::shared_ptr<CesiumUtility::MetricsRegistry>& pMetrics)
     : _requestsPerCachePrune(requestsPerCachePrune),
       _requestSinceLastPrune(0),
       _pLogger(pLogger),
       _pAssetAccessor(pAssetAccessor),
       _pCacheDatabase(pCacheDatabase),
-      _cacheThreadPool(1) {}
+      _cacheThreadPool(1),
+      _pMetrics(pMetrics),
+      _pCacheHitLatency(getRequestLatency(pMetrics, "hit")),
+      _pCacheMissLatency(getRequestLatency(pMetrics, "miss")),
+      _pCacheRevalidateLatency(getRequestLatency(pMetrics, "revalidate")) {}
 
 CachingAssetAccessor::~CachingAssetAccessor() noexcept {}
 
@@ -123,6 +137,8 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::requestAsset(
   CESIUM_TRACE_BEGIN_IN_TRACK("requestAsset (cached)");
 
   const ThreadPool& threadPool = this->_cacheThreadPool;
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
 
   return asyncSystem
       .runInThreadPool(
@@ -133,7 +149,12 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::requestAsset(
            pLogger = this->_pLogger,
            url,
            headers,
-           threadPool]() -> Future<std::shared_ptr<IAssetRequest>> {
+           threadPool,
+           pMetrics = this->_pMetrics,
+           pHitLatency = this->_pCacheHitLatency,
+           pMissLatency = this->_pCacheMissLatency,
+           pRevalidateLatency = this->_pCacheRevalidateLatency,
+           start]() -> Future<std::shared_ptr<IAssetRequest>> {
             std::optional<CacheItem> cacheLookup =
                 pCacheDatabase->getEntry(url);
             if (!cacheLookup) {
@@ -141,8 +162,10 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::requestAsset(
               return pAssetAccessor->requestAsset(asyncSystem, url, headers)
                   .thenInThreadPool(
                       threadPool,
-                      [pCacheDatabase, pLogger](
+                      [pCacheDatabase, pLogger, pMetrics, pMissLatency, start](
                           std::shared_ptr<IAssetRequest>&& pCompletedRequest) {
+                        recordLatency(pMissLatency, start);
+
                         const IAssetResponse* pResponse =
                             pCompletedRequest->response();
                         if (!pResponse) {
@@ -197,8 +220,13 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::requestAsset(
                       threadPool,
                       [cacheItem = std::move(cacheItem),
                        pCacheDatabase,
-                       pLogger](std::shared_ptr<IAssetRequest>&&
-                                    pCompletedRequest) mutable {
+                       pLogger,
+                       pMetrics,
+                       pRevalidateLatency,
+                       start](std::shared_ptr<IAssetRequest>&&
+                                  pCompletedRequest) mutable {
+                        recordLatency(pRevalidateLatency, start);
+
                         if (!pCompletedRequest) {
                           return std::move(pCompletedRequest);
                         }
@@ -244,6 +272,7 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::requestAsset(
             // it.
             std::shared_ptr<IAssetRequest> pRequest =
                 std::make_shared<CacheAssetRequest>(std::move(cacheItem));
+            recordLatency(pHitLatency, start);
             return asyncSystem.createResolvedFuture(std::move(pRequest));
           })
       .thenImmediately([](std::shared_ptr<IAssetRequest>&& pRequest) noexcept {
@@ -262,6 +291,27 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::post(
 
 void CachingAssetAccessor::tick() noexcept { _pAssetAccessor->tick(); }
 
+CesiumUtility::LatencyHistogram* getRequestLatency(
+    const std::shared_ptr<CesiumUtility::MetricsRegistry>& pMetrics,
+    const std::string& cacheResult) {
+  if (!pMetrics) {
+    return nullptr;
+  }
+
+  return &pMetrics->getHistogram(
+      "cesium_asset_request_seconds",
+      "Time to complete an asset request, by the result of the cache lookup.",
+      {{"cache", cacheResult}});
+}
+
+void recordLatency(
+    CesiumUtility::LatencyHistogram* pHistogram,
+    std::chrono::steady_clock::time_point start) noexcept {
+  if (pHistogram) {
+    pHistogram->record(std::chrono::steady_clock::now() - start);
+  }
+}
+
 bool shouldRevalidateCache(const CacheItem& cacheItem) {
   std::optional<ResponseCacheControl> cacheControl =
       ResponseCacheControl::parseFromResponseHeaders(
@@ -0,0 +1,465 @@
+#include "CesiumAsync/FileDerivedDataCache.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace CesiumAsync {
+
+namespace {
+/**
+ * @brief The header at the start of every entry file.
+ *
+ * It is followed by the key, padded to a multiple of 8 bytes, and then the
+ * data.
+ */
+struct EntryHeader {
+  char magic[4];
+  uint32_t version;
+  uint64_t keyLength;
+  uint64_t dataLength;
+};
+
+static_assert(sizeof(EntryHeader) == 24, "EntryHeader must not be padded");
+
+const char entryMagic[4] = {'C', 'D', 'D', 'C'};
+const uint32_t entryVersion = 1;
+
+uint64_t alignTo8(uint64_t value) noexcept { return (value + 7) & ~7ULL; }
+
+// The 64-bit FNV-1a hash, which unlike std::hash is the same on every
+// platform and in every run.
+uint64_t hashKey(const std::string& key) noexcept {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const char c : key) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+std::string toHex(uint64_t value) {
+  static const char digits[] = "0123456789abcdef";
+  std::string result(16, '0');
+  for (size_t i = 0; i < 16; ++i) {
+    result[15 - i] = digits[value & 0xf];
+    value >>= 4;
+  }
+  return result;
+}
+
+// Parses the hash from the name of an entry file, which is the hash in
+// hexadecimal followed by ".entry".
+bool parseEntryFileName(const std::string& name, uint64_t& hash) noexcept {
+  if (name.size() != 22 || name.compare(16, 6, ".entry") != 0) {
+    return false;
+  }
+
+  hash = 0;
+  for (size_t i = 0; i < 16; ++i) {
+    const char c = name[i];
+    uint64_t digit;
+    if (c >= '0' && c <= '9') {
+      digit = static_cast<uint64_t>(c - '0');
+    } else if (c >= 'a' && c <= 'f') {
+      digit = static_cast<uint64_t>(c - 'a' + 10);
+    } else {
+      return false;
+    }
+    hash = (hash << 4) | digit;
+  }
+  return true;
+}
+
+// An entry file found in the directory when the cache was created.
+struct ExistingEntry {
+  uint64_t hash;
+  uint64_t bytes;
+  int64_t lastWriteTime;
+};
+
+#ifdef _WIN32
+std::wstring toWide(const std::string& path) {
+  const int length = MultiByteToWideChar(
+      CP_UTF8,
+      0,
+      path.data(),
+      static_cast<int>(path.size()),
+      nullptr,
+      0);
+  std::wstring result(static_cast<size_t>(length), L'\0');
+  MultiByteToWideChar(
+      CP_UTF8,
+      0,
+      path.data(),
+      static_cast<int>(path.size()),
+      result.data(),
+      length);
+  return result;
+}
+
+// Maps a whole file into memory, or returns nullptr.
+const std::byte* mapFile(const std::string& path, uint64_t& size) {
+  HANDLE file = CreateFileW(
+      toWide(path).c_str(),
+      GENERIC_READ,
+      FILE_SHARE_READ | FILE_SHARE_DELETE,
+      nullptr,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL,
+      nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return nullptr;
+  }
+
+  LARGE_INTEGER fileSize;
+  const void* pView = nullptr;
+  if (GetFileSizeEx(file, &fileSize) &&
+      fileSize.QuadPart >= static_cast<LONGLONG>(sizeof(EntryHeader))) {
+    HANDLE mapping =
+        CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping) {
+      pView = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      CloseHandle(mapping);
+    }
+  }
+  CloseHandle(file);
+
+  size = pView ? static_cast<uint64_t>(fileSize.QuadPart) : 0;
+  return static_cast<const std::byte*>(pView);
+}
+
+void unmapFile(const std::byte* pView, uint64_t /*size*/) {
+  UnmapViewOfFile(pView);
+}
+
+bool replaceFile(const std::string& from, const std::string& to) {
+  return MoveFileExW(
+             toWide(from).c_str(),
+             toWide(to).c_str(),
+             MOVEFILE_REPLACE_EXISTING) != 0;
+}
+
+void createDirectory(const std::string& path) {
+  CreateDirectoryW(toWide(path).c_str(), nullptr);
+}
+
+// Deletes a file, and returns whether it no longer exists.
+bool deleteFile(const std::string& path) {
+  return DeleteFileW(toWide(path).c_str()) != 0 ||
+         GetLastError() == ERROR_FILE_NOT_FOUND;
+}
+
+std::vector<ExistingEntry> listEntries(const std::string& directory) {
+  std::vector<ExistingEntry> entries;
+
+  WIN32_FIND_DATAW findData;
+  HANDLE find =
+      FindFirstFileW(toWide(directory + "/*.entry").c_str(), &findData);
+  if (find == INVALID_HANDLE_VALUE) {
+    return entries;
+  }
+
+  do {
+    // The names of entry files only contain ASCII characters.
+    std::string name;
+    for (const wchar_t* pC = findData.cFileName; *pC != L'\0'; ++pC) {
+      name += *pC < 0x80 ? static_cast<char>(*pC) : '?';
+    }
+
+    uint64_t hash;
+    if (parseEntryFileName(name, hash)) {
+      entries.push_back(ExistingEntry{
+          hash,
+          (static_cast<uint64_t>(findData.nFileSizeHigh) << 32) |
+              findData.nFileSizeLow,
+          static_cast<int64_t>(
+              (static_cast<uint64_t>(findData.ftLastWriteTime.dwHighDateTime)
+               << 32) |
+              findData.ftLastWriteTime.dwLowDateTime)});
+    }
+  } while (FindNextFileW(find, &findData));
+  FindClose(find);
+
+  return entries;
+}
+
+uint64_t getProcessID() { return GetCurrentProcessId(); }
+#else
+// Maps a whole file into memory, or returns nullptr.
+const std::byte* mapFile(const std::string& path, uint64_t& size) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  struct stat fileStat;
+  void* pView = MAP_FAILED;
+  if (fstat(fd, &fileStat) == 0 &&
+      fileStat.st_size >= static_cast<off_t>(sizeof(EntryHeader))) {
+    size = static_cast<uint64_t>(fileStat.st_size);
+    pView = mmap(
+        nullptr,
+        static_cast<size_t>(size),
+        PROT_READ,
+        MAP_PRIVATE,
+        fd,
+        0);
+  }
+  close(fd);
+
+  if (pView == MAP_FAILED) {
+    size = 0;
+    return nullptr;
+  }
+  return static_cast<const std::byte*>(pView);
+}
+
+void unmapFile(const std::byte* pView, uint64_t size) {
+  munmap(const_cast<std::byte*>(pView), static_cast<size_t>(size));
+}
+
+bool replaceFile(const std::string& from, const std::string& to) {
+  return std::rename(from.c_str(), to.c_str()) == 0;
+}
+
+void createDirectory(const std::string& path) { mkdir(path.c_str(), 0755); }
+
+// Deletes a file, and returns whether it no longer exists.
+bool deleteFile(const std::string& path) {
+  return unlink(path.c_str()) == 0 || errno == ENOENT;
+}
+
+std::vector<ExistingEntry> listEntries(const std::string& directory) {
+  std::vector<ExistingEntry> entries;
+
+  DIR* pDirectory = opendir(directory.c_str());
+  if (!pDirectory) {
+    return entries;
+  }
+
+  while (const dirent* pFile = readdir(pDirectory)) {
+    const std::string name = pFile->d_name;
+    uint64_t hash;
+    struct stat fileStat;
+    if (parseEntryFileName(name, hash) &&
+        stat((directory + "/" + name).c_str(), &fileStat) == 0) {
+      entries.push_back(ExistingEntry{
+          hash,
+          static_cast<uint64_t>(fileStat.st_size),
+          static_cast<int64_t>(fileStat.st_mtime)});
+    }
+  }
+  closedir(pDirectory);
+
+  return entries;
+}
+
+uint64_t getProcessID() { return static_cast<uint64_t>(getpid()); }
+#endif
+
+class MappedEntry : public IDerivedDataEntry {
+public:
+  MappedEntry(
+      const std::byte* pView,
+      uint64_t size,
+      gsl::span<const std::byte> data) noexcept
+      : _pView(pView), _size(size), _data(data) {}
+
+  virtual ~MappedEntry() noexcept override {
+    unmapFile(this->_pView, this->_size);
+  }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return this->_data;
+  }
+
+private:
+  const std::byte* _pView;
+  uint64_t _size;
+  gsl::span<const std::byte> _data;
+};
+} // namespace
+
+FileDerivedDataCache::FileDerivedDataCache(
+    const std::string& directory,
+    uint64_t maximumBytes)
+    : _directory(directory),
+      _maximumBytes(maximumBytes),
+      _temporaryFileSuffix(),
+      _nextTemporaryFile(0),
+      _indexLock(),
+      _entries(),
+      _index(),
+      _totalBytes(0) {
+  while (!this->_directory.empty() &&
+         (this->_directory.back() == '/' || this->_directory.back() == '\\')) {
+    this->_directory.pop_back();
+  }
+  createDirectory(this->_directory);
+
+  // Other instances may write to the same directory, in this process or in
+  // others, so their temporary files must have different names.
+  std::random_device randomDevice;
+  const uint64_t token =
+      (static_cast<uint64_t>(randomDevice()) << 32) ^ randomDevice() ^
+      static_cast<uint64_t>(reinterpret_cast<uintptr_t>(this));
+  this->_temporaryFileSuffix =
+      "." + std::to_string(getProcessID()) + "." + toHex(token) + ".";
+
+  std::vector<ExistingEntry> existingEntries = listEntries(this->_directory);
+  std::sort(
+      existingEntries.begin(),
+      existingEntries.end(),
+      [](const ExistingEntry& a, const ExistingEntry& b) {
+        return a.lastWriteTime < b.lastWriteTime;
+      });
+
+  std::lock_guard<std::mutex> lock(this->_indexLock);
+  for (const ExistingEntry& entry : existingEntries) {
+    this->markUsed(entry.hash, entry.bytes);
+  }
+  this->prune(std::nullopt);
+}
+
+std::unique_ptr<IDerivedDataEntry>
+FileDerivedDataCache::getEntry(const std::string& key) const {
+  const uint64_t hash = hashKey(key);
+
+  uint64_t size = 0;
+  const std::byte* pView = mapFile(this->getEntryPath(hash), size);
+  if (!pView) {
+    return nullptr;
+  }
+
+  EntryHeader header;
+  std::memcpy(&header, pView, sizeof(header));
+
+  const uint64_t dataOffset = sizeof(EntryHeader) + alignTo8(header.keyLength);
+  const bool valid =
+      std::memcmp(header.magic, entryMagic, sizeof(entryMagic)) == 0 &&
+      header.version == entryVersion && header.keyLength == key.size() &&
+      dataOffset <= size && header.dataLength == size - dataOffset &&
+      std::memcmp(pView + sizeof(EntryHeader), key.data(), key.size()) == 0;
+  if (!valid) {
+    unmapFile(pView, size);
+    return nullptr;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->_indexLock);
+    this->markUsed(hash, size);
+  }
+
+  return std::make_unique<MappedEntry>(
+      pView,
+      size,
+      gsl::span<const std::byte>(
+          pView + dataOffset,
+          static_cast<size_t>(header.dataLength)));
+}
+
+bool FileDerivedDataCache::storeEntry(
+    const std::string& key,
+    const gsl::span<const std::byte>& data) {
+  const uint64_t hash = hashKey(key);
+  const std::string path = this->getEntryPath(hash);
+  const std::string temporaryPath =
+      path + this->_temporaryFileSuffix +
+      std::to_string(this->_nextTemporaryFile++) + ".tmp";
+
+  EntryHeader header;
+  std::memcpy(header.magic, entryMagic, sizeof(entryMagic));
+  header.version = entryVersion;
+  header.keyLength = key.size();
+  header.dataLength = data.size();
+
+  const char padding[8] = {};
+  const uint64_t paddingLength = alignTo8(key.size()) - key.size();
+
+  {
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(key.data(), static_cast<std::streamsize>(key.size()));
+    file.write(padding, static_cast<std::streamsize>(paddingLength));
+    file.write(
+        reinterpret_cast<const char*>(data.data()),
+        static_cast<std::streamsize>(data.size()));
+    file.close();
+    if (!file) {
+      std::remove(temporaryPath.c_str());
+      return false;
+    }
+  }
+
+  // Replace the file while holding the lock, so that pruning cannot delete
+  // the new file based on the size and use of the old one.
+  std::lock_guard<std::mutex> lock(this->_indexLock);
+
+  if (!replaceFile(temporaryPath, path)) {
+    std::remove(temporaryPath.c_str());
+    return false;
+  }
+
+  this->markUsed(
+      hash,
+      sizeof(EntryHeader) + alignTo8(key.size()) + data.size());
+  this->prune(hash);
+
+  return true;
+}
+
+std::string FileDerivedDataCache::getEntryPath(uint64_t hash) const {
+  return this->_directory + "/" + toHex(hash) + ".entry";
+}
+
+void FileDerivedDataCache::markUsed(uint64_t hash, uint64_t bytes) const {
+  auto it = this->_index.find(hash);
+  if (it == this->_index.end()) {
+    this->_entries.push_back(IndexEntry{hash, bytes});
+    this->_index.emplace(hash, std::prev(this->_entries.end()));
+    this->_totalBytes += bytes;
+    return;
+  }
+
+  std::list<IndexEntry>::iterator entryIt = it->second;
+  this->_totalBytes = this->_totalBytes - entryIt->bytes + bytes;
+  entryIt->bytes = bytes;
+  this->_entries.splice(this->_entries.end(), this->_entries, entryIt);
+}
+
+void FileDerivedDataCache::prune(std::optional<uint64_t> keepHash) const {
+  auto it = this->_entries.begin();
+  while (this->_totalBytes > this->_maximumBytes &&
+         it != this->_entries.end()) {
+    // An entry that is mapped cannot be deleted on Windows, so skip entries
+    // that fail to delete.
+    if (it->hash == keepHash || !deleteFile(this->getEntryPath(it->hash))) {
+      ++it;
+      continue;
+    }
+
+    this->_totalBytes -= it->bytes;
+    this->_index.erase(it->hash);
+    it = this->_entries.erase(it);
+  }
+}
+
+} // namespace CesiumAsync
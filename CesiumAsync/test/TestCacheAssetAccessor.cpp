@@ -6,6 +6,7 @@
 #include "MockAssetResponse.h"
 #include "ResponseCacheControl.h"
 
+#include <CesiumUtility/Metrics.h>
 #include <catch2/catch.hpp>
 #include <spdlog/spdlog.h>
 
@@ -843,3 +844,65 @@ TEST_CASE("Test serving cache item") {
         .wait();
   }
 }
+
+TEST_CASE("Test recording request latency metrics") {
+  std::shared_ptr<IAssetRequest> mockRequest =
+      std::make_shared<MockAssetRequest>(
+          "GET",
+          "test.com",
+          HttpHeaders{},
+          std::make_unique<MockAssetResponse>(
+              static_cast<uint16_t>(200),
+              "app/json",
+              HttpHeaders{{"Cache-Control", "max-age=100"}},
+              std::vector<std::byte>()));
+
+  auto pMetrics = std::make_shared<CesiumUtility::MetricsRegistry>();
+  std::unique_ptr<MockStoreCacheDatabase> pMockCacheDatabase =
+      std::make_unique<MockStoreCacheDatabase>();
+  MockStoreCacheDatabase& mockCacheDatabase = *pMockCacheDatabase;
+
+  std::shared_ptr<CachingAssetAccessor> cacheAssetAccessor =
+      std::make_shared<CachingAssetAccessor>(
+          spdlog::default_logger(),
+          std::make_unique<MockAssetAccessor>(mockRequest),
+          std::move(pMockCacheDatabase),
+          10000,
+          pMetrics);
+
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+  const auto request = [&]() {
+    cacheAssetAccessor
+        ->requestAsset(
+            asyncSystem,
+            "test.com",
+            std::vector<IAssetAccessor::THeader>{})
+        .wait();
+  };
+
+  CesiumUtility::LatencyHistogram& hits = pMetrics->getHistogram(
+      "cesium_asset_request_seconds",
+      "",
+      {{"cache", "hit"}});
+  CesiumUtility::LatencyHistogram& misses = pMetrics->getHistogram(
+      "cesium_asset_request_seconds",
+      "",
+      {{"cache", "miss"}});
+
+  request();
+  CHECK(misses.getCount() == 1);
+  CHECK(hits.getCount() == 0);
+
+  mockCacheDatabase.cacheItem = CacheItem(
+      std::time(nullptr) + 100,
+      CacheRequest(HttpHeaders{}, "GET", "test.com"),
+      CacheResponse(
+          static_cast<uint16_t>(200),
+          HttpHeaders{{"Cache-Control", "max-age=100"}},
+          std::vector<std::byte>()));
+
+  request();
+  request();
+  CHECK(misses.getCount() == 1);
+  CHECK(hits.getCount() == 2);
+}
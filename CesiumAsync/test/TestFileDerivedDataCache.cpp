@@ -0,0 +1,160 @@
+#include "CesiumAsync/FileDerivedDataCache.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace {
+std::vector<std::byte> createData(size_t size, uint8_t seed) {
+  std::vector<std::byte> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = std::byte(static_cast<uint8_t>(seed + i));
+  }
+  return data;
+}
+
+std::vector<std::byte> getData(const IDerivedDataEntry& entry) {
+  gsl::span<const std::byte> data = entry.data();
+  return std::vector<std::byte>(data.begin(), data.end());
+}
+} // namespace
+
+TEST_CASE("Test derived data cache with files") {
+  FileDerivedDataCache cache("test-derived-data-cache");
+
+  SECTION("Stored entries can be read back") {
+    const std::vector<std::byte> data = createData(1000, 7);
+    REQUIRE(cache.storeEntry("first-key", data));
+
+    std::unique_ptr<IDerivedDataEntry> pEntry = cache.getEntry("first-key");
+    REQUIRE(pEntry);
+    CHECK(getData(*pEntry) == data);
+    CHECK(reinterpret_cast<uintptr_t>(pEntry->data().data()) % 8 == 0);
+  }
+
+  SECTION("Unknown keys are not found") {
+    CHECK(!cache.getEntry("a key that was never stored"));
+  }
+
+  SECTION("Storing an entry replaces the previous one") {
+    REQUIRE(cache.storeEntry("replaced-key", createData(100, 1)));
+
+    // Keep the old entry mapped while it is replaced.
+    std::unique_ptr<IDerivedDataEntry> pOld = cache.getEntry("replaced-key");
+    REQUIRE(pOld);
+
+    const std::vector<std::byte> newData = createData(37, 2);
+    REQUIRE(cache.storeEntry("replaced-key", newData));
+
+    std::unique_ptr<IDerivedDataEntry> pNew = cache.getEntry("replaced-key");
+    REQUIRE(pNew);
+    CHECK(getData(*pNew) == newData);
+    CHECK(getData(*pOld) == createData(100, 1));
+  }
+
+  SECTION("Empty entries can be stored") {
+    REQUIRE(cache.storeEntry("empty-key", std::vector<std::byte>()));
+
+    std::unique_ptr<IDerivedDataEntry> pEntry = cache.getEntry("empty-key");
+    REQUIRE(pEntry);
+    CHECK(pEntry->data().empty());
+  }
+
+  SECTION("Entries persist across instances") {
+    const std::vector<std::byte> data = createData(64, 3);
+    REQUIRE(cache.storeEntry("persistent-key", data));
+
+    FileDerivedDataCache otherCache("test-derived-data-cache/");
+    std::unique_ptr<IDerivedDataEntry> pEntry =
+        otherCache.getEntry("persistent-key");
+    REQUIRE(pEntry);
+    CHECK(getData(*pEntry) == data);
+  }
+}
+
+TEST_CASE("Test derived data cache size limit") {
+  const std::string directory = "test-derived-data-cache-limit";
+  std::filesystem::remove_all(directory);
+
+  // Each entry of 1000 bytes with a key of up to 8 bytes takes 1032 bytes.
+  const uint64_t entryBytes = 1032;
+
+  SECTION("The least recently used entries are deleted") {
+    FileDerivedDataCache cache(directory, 3 * entryBytes);
+    REQUIRE(cache.storeEntry("first", createData(1000, 1)));
+    REQUIRE(cache.storeEntry("second", createData(1000, 2)));
+    REQUIRE(cache.storeEntry("third", createData(1000, 3)));
+
+    // Reading the first entry makes the second the least recently used.
+    CHECK(cache.getEntry("first"));
+
+    REQUIRE(cache.storeEntry("fourth", createData(1000, 4)));
+    CHECK(cache.getEntry("first"));
+    CHECK(!cache.getEntry("second"));
+    CHECK(cache.getEntry("third"));
+    CHECK(cache.getEntry("fourth"));
+  }
+
+  SECTION("Replacing an entry does not count it twice") {
+    FileDerivedDataCache cache(directory, 2 * entryBytes);
+    REQUIRE(cache.storeEntry("first", createData(1000, 1)));
+    REQUIRE(cache.storeEntry("second", createData(1000, 2)));
+    REQUIRE(cache.storeEntry("second", createData(1000, 3)));
+    CHECK(cache.getEntry("first"));
+    CHECK(cache.getEntry("second"));
+  }
+
+  SECTION("An entry larger than the limit is kept until the next one") {
+    FileDerivedDataCache cache(directory, entryBytes / 2);
+    REQUIRE(cache.storeEntry("first", createData(1000, 1)));
+    CHECK(cache.getEntry("first"));
+
+    REQUIRE(cache.storeEntry("second", createData(1000, 2)));
+    CHECK(!cache.getEntry("first"));
+    CHECK(cache.getEntry("second"));
+  }
+
+  SECTION("Existing entries are pruned when the cache is created") {
+    {
+      FileDerivedDataCache cache(directory, 4 * entryBytes);
+      REQUIRE(cache.storeEntry("first", createData(1000, 1)));
+      REQUIRE(cache.storeEntry("second", createData(1000, 2)));
+      REQUIRE(cache.storeEntry("third", createData(1000, 3)));
+    }
+
+    FileDerivedDataCache cache(directory, 2 * entryBytes);
+    const int found = (cache.getEntry("first") ? 1 : 0) +
+                      (cache.getEntry("second") ? 1 : 0) +
+                      (cache.getEntry("third") ? 1 : 0);
+    CHECK(found == 2);
+  }
+
+  SECTION("Instances on the same directory can store the same key") {
+    FileDerivedDataCache cache(directory);
+    FileDerivedDataCache otherCache(directory);
+    REQUIRE(cache.storeEntry("shared-key", createData(100, 1)));
+    REQUIRE(otherCache.storeEntry("shared-key", createData(100, 2)));
+
+    size_t temporaryFiles = 0;
+    for (const std::filesystem::directory_entry& entry :
+         std::filesystem::directory_iterator(directory)) {
+      if (entry.path().extension() == ".tmp") {
+        ++temporaryFiles;
+      }
+    }
+    CHECK(temporaryFiles == 0);
+
+    std::unique_ptr<IDerivedDataEntry> pEntry = cache.getEntry("shared-key");
+    REQUIRE(pEntry);
+    CHECK(getData(*pEntry) == createData(100, 2));
+  }
+
+  std::filesystem::remove_all(directory);
+}
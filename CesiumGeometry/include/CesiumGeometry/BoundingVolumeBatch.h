@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CullingVolume.h"
+#include "Library.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace CesiumGeometry {
+
+class BoundingSphere;
+class OrientedBoundingBox;
+
+/**
+ * @brief A batch of oriented bounding boxes and bounding spheres that can be
+ * tested against several {@link Cesium3DTilesSelection::CullingVolume}s at
+ * once.
+ *
+ * The bounding volumes are stored as a structure of arrays, so that the plane
+ * tests of {@link computeVisibility} run over contiguous arrays of doubles
+ * without branches, which allows the compiler to vectorize them. Both kinds
+ * of volumes share the same representation: a box is stored with a radius of
+ * zero, and a sphere is stored with half axes of zero.
+ */
+class CESIUMGEOMETRY_API BoundingVolumeBatch final {
+public:
+  /**
+   * @brief The maximum number of culling volumes that can be passed to
+   * {@link computeVisibility} at once.
+   */
+  static constexpr size_t MaximumCullingVolumes = 64;
+
+  /**
+   * @brief Gets the number of bounding volumes in this batch.
+   */
+  size_t size() const noexcept { return this->_centerX.size(); }
+
+  /**
+   * @brief Returns whether this batch contains no bounding volumes.
+   */
+  bool empty() const noexcept { return this->_centerX.empty(); }
+
+  /**
+   * @brief Removes all bounding volumes from this batch, without releasing
+   * its memory.
+   */
+  void clear() noexcept;
+
+  /**
+   * @brief Reserves space for the given number of bounding volumes.
+   *
+   * @param capacity The number of bounding volumes.
+   */
+  void reserve(size_t capacity);
+
+  /**
+   * @brief Adds an oriented bounding box to the end of this batch.
+   *
+   * @param boundingBox The bounding box.
+   * @return The index of the bounding box within this batch.
+   */
+  size_t add(const OrientedBoundingBox& boundingBox);
+
+  /**
+   * @brief Adds a bounding sphere to the end of this batch.
+   *
+   * @param boundingSphere The bounding sphere.
+   * @return The index of the bounding sphere within this batch.
+   */
+  size_t add(const BoundingSphere& boundingSphere);
+
+  /**
+   * @brief Determines which bounding volumes of this batch are visible in
+   * which culling volumes.
+   *
+   * After this call, `visibility` contains one entry per bounding volume.
+   * Bit `j` of the entry is set if the bounding volume is at least partially
+   * on the inner side of all four planes of `cullingVolumes[j]`.
+   *
+   * The results agree with testing the bounding volumes against each plane
+   * with `intersectPlane`, except that a bounding volume that just touches a
+   * plane from the outside is always considered visible.
+   *
+   * @param cullingVolumes The culling volumes to test against. Only the first
+   * {@link MaximumCullingVolumes} culling volumes are tested.
+   * @param visibility Receives the visibility bitmask of each bounding volume.
+   */
+  void computeVisibility(
+      const std::vector<Cesium3DTilesSelection::CullingVolume>& cullingVolumes,
+      std::vector<uint64_t>& visibility) const;
+
+private:
+  std::vector<double> _centerX;
+  std::vector<double> _centerY;
+  std::vector<double> _centerZ;
+  std::vector<double> _halfAxisXX;
+  std::vector<double> _halfAxisXY;
+  std::vector<double> _halfAxisXZ;
+  std::vector<double> _halfAxisYX;
+  std::vector<double> _halfAxisYY;
+  std::vector<double> _halfAxisYZ;
+  std::vector<double> _halfAxisZX;
+  std::vector<double> _halfAxisZY;
+  std::vector<double> _halfAxisZZ;
+  std::vector<double> _radius;
+};
+
+} // namespace CesiumGeometry
@@ -0,0 +1,174 @@
+#include "CesiumGeometry/BoundingVolumeBatch.h"
+
+#include "CesiumGeometry/BoundingSphere.h"
+#include "CesiumGeometry/OrientedBoundingBox.h"
+#include "CesiumGeometry/Plane.h"
+
+#include <glm/common.hpp>
+
+#include <algorithm>
+
+using namespace Cesium3DTilesSelection;
+
+namespace CesiumGeometry {
+
+namespace {
+
+struct PlaneCoefficients {
+  double x;
+  double y;
+  double z;
+  double w;
+};
+
+PlaneCoefficients getCoefficients(const Plane& plane) noexcept {
+  const glm::dvec3& normal = plane.getNormal();
+  return {normal.x, normal.y, normal.z, plane.getDistance()};
+}
+
+} // namespace
+
+void BoundingVolumeBatch::clear() noexcept {
+  this->_centerX.clear();
+  this->_centerY.clear();
+  this->_centerZ.clear();
+  this->_halfAxisXX.clear();
+  this->_halfAxisXY.clear();
+  this->_halfAxisXZ.clear();
+  this->_halfAxisYX.clear();
+  this->_halfAxisYY.clear();
+  this->_halfAxisYZ.clear();
+  this->_halfAxisZX.clear();
+  this->_halfAxisZY.clear();
+  this->_halfAxisZZ.clear();
+  this->_radius.clear();
+}
+
+void BoundingVolumeBatch::reserve(size_t capacity) {
+  this->_centerX.reserve(capacity);
+  this->_centerY.reserve(capacity);
+  this->_centerZ.reserve(capacity);
+  this->_halfAxisXX.reserve(capacity);
+  this->_halfAxisXY.reserve(capacity);
+  this->_halfAxisXZ.reserve(capacity);
+  this->_halfAxisYX.reserve(capacity);
+  this->_halfAxisYY.reserve(capacity);
+  this->_halfAxisYZ.reserve(capacity);
+  this->_halfAxisZX.reserve(capacity);
+  this->_halfAxisZY.reserve(capacity);
+  this->_halfAxisZZ.reserve(capacity);
+  this->_radius.reserve(capacity);
+}
+
+size_t BoundingVolumeBatch::add(const OrientedBoundingBox& boundingBox) {
+  const size_t index = this->size();
+
+  const glm::dvec3& center = boundingBox.getCenter();
+  this->_centerX.push_back(center.x);
+  this->_centerY.push_back(center.y);
+  this->_centerZ.push_back(center.z);
+
+  const glm::dmat3& halfAxes = boundingBox.getHalfAxes();
+  this->_halfAxisXX.push_back(halfAxes[0].x);
+  this->_halfAxisXY.push_back(halfAxes[0].y);
+  this->_halfAxisXZ.push_back(halfAxes[0].z);
+  this->_halfAxisYX.push_back(halfAxes[1].x);
+  this->_halfAxisYY.push_back(halfAxes[1].y);
+  this->_halfAxisYZ.push_back(halfAxes[1].z);
+  this->_halfAxisZX.push_back(halfAxes[2].x);
+  this->_halfAxisZY.push_back(halfAxes[2].y);
+  this->_halfAxisZZ.push_back(halfAxes[2].z);
+
+  this->_radius.push_back(0.0);
+
+  return index;
+}
+
+size_t BoundingVolumeBatch::add(const BoundingSphere& boundingSphere) {
+  const size_t index = this->size();
+
+  const glm::dvec3& center = boundingSphere.getCenter();
+  this->_centerX.push_back(center.x);
+  this->_centerY.push_back(center.y);
+  this->_centerZ.push_back(center.z);
+
+  this->_halfAxisXX.push_back(0.0);
+  this->_halfAxisXY.push_back(0.0);
+  this->_halfAxisXZ.push_back(0.0);
+  this->_halfAxisYX.push_back(0.0);
+  this->_halfAxisYY.push_back(0.0);
+  this->_halfAxisYZ.push_back(0.0);
+  this->_halfAxisZX.push_back(0.0);
+  this->_halfAxisZY.push_back(0.0);
+  this->_halfAxisZZ.push_back(0.0);
+
+  this->_radius.push_back(boundingSphere.getRadius());
+
+  return index;
+}
+
+void BoundingVolumeBatch::computeVisibility(
+    const std::vector<CullingVolume>& cullingVolumes,
+    std::vector<uint64_t>& visibility) const {
+  const size_t count = this->size();
+  visibility.assign(count, 0);
+
+  const double* pCenterX = this->_centerX.data();
+  const double* pCenterY = this->_centerY.data();
+  const double* pCenterZ = this->_centerZ.data();
+  const double* pHalfAxisXX = this->_halfAxisXX.data();
+  const double* pHalfAxisXY = this->_halfAxisXY.data();
+  const double* pHalfAxisXZ = this->_halfAxisXZ.data();
+  const double* pHalfAxisYX = this->_halfAxisYX.data();
+  const double* pHalfAxisYY = this->_halfAxisYY.data();
+  const double* pHalfAxisYZ = this->_halfAxisYZ.data();
+  const double* pHalfAxisZX = this->_halfAxisZX.data();
+  const double* pHalfAxisZY = this->_halfAxisZY.data();
+  const double* pHalfAxisZZ = this->_halfAxisZZ.data();
+  const double* pRadius = this->_radius.data();
+  uint64_t* pVisibility = visibility.data();
+
+  // A volume is outside of a plane if its center is further behind the plane
+  // than its effective radius along the plane normal. For a box that is the
+  // sum of the projections of its half axes on the normal; for a sphere it is
+  // the radius. Since unused half axes and radii are zero, a single expression
+  // handles both.
+  const auto isInFront = [&](const PlaneCoefficients& p, size_t i) noexcept {
+    const double distance = p.x * pCenterX[i] + p.y * pCenterY[i] +
+                            p.z * pCenterZ[i] + p.w;
+    const double radius =
+        glm::abs(
+            p.x * pHalfAxisXX[i] + p.y * pHalfAxisXY[i] +
+            p.z * pHalfAxisXZ[i]) +
+        glm::abs(
+            p.x * pHalfAxisYX[i] + p.y * pHalfAxisYY[i] +
+            p.z * pHalfAxisYZ[i]) +
+        glm::abs(
+            p.x * pHalfAxisZX[i] + p.y * pHalfAxisZY[i] +
+            p.z * pHalfAxisZZ[i]) +
+        pRadius[i];
+    return distance + radius >= 0.0;
+  };
+
+  const size_t cullingVolumeCount =
+      std::min(cullingVolumes.size(), MaximumCullingVolumes);
+  for (size_t j = 0; j < cullingVolumeCount; ++j) {
+    const CullingVolume& cullingVolume = cullingVolumes[j];
+    const PlaneCoefficients left = getCoefficients(cullingVolume.leftPlane);
+    const PlaneCoefficients right = getCoefficients(cullingVolume.rightPlane);
+    const PlaneCoefficients top = getCoefficients(cullingVolume.topPlane);
+    const PlaneCoefficients bottom =
+        getCoefficients(cullingVolume.bottomPlane);
+    const uint64_t bit = uint64_t(1) << j;
+
+    for (size_t i = 0; i < count; ++i) {
+      // Deliberately use the non-short-circuiting operator so that the loop
+      // body stays free of branches.
+      const bool visible = isInFront(left, i) & isInFront(right, i) &
+                           isInFront(top, i) & isInFront(bottom, i);
+      pVisibility[i] |= visible ? bit : uint64_t(0);
+    }
+  }
+}
+
+} // namespace CesiumGeometry
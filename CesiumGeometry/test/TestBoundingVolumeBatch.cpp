@@ -0,0 +1,103 @@
+#include "CesiumGeometry/BoundingSphere.h"
+#include "CesiumGeometry/BoundingVolumeBatch.h"
+#include "CesiumGeometry/CullingVolume.h"
+#include "CesiumGeometry/OrientedBoundingBox.h"
+
+#include <catch2/catch.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/trigonometric.hpp>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+
+namespace {
+
+template <class T>
+bool isVisible(const T& boundingVolume, const CullingVolume& cullingVolume) {
+  return boundingVolume.intersectPlane(cullingVolume.leftPlane) !=
+             CullingResult::Outside &&
+         boundingVolume.intersectPlane(cullingVolume.rightPlane) !=
+             CullingResult::Outside &&
+         boundingVolume.intersectPlane(cullingVolume.topPlane) !=
+             CullingResult::Outside &&
+         boundingVolume.intersectPlane(cullingVolume.bottomPlane) !=
+             CullingResult::Outside;
+}
+
+} // namespace
+
+TEST_CASE("BoundingVolumeBatch::computeVisibility") {
+  // Two cameras at the origin, one looking down +X and one looking down -X.
+  std::vector<CullingVolume> cullingVolumes{
+      createCullingVolume(
+          glm::dvec3(0.0),
+          glm::dvec3(1.0, 0.0, 0.0),
+          glm::dvec3(0.0, 0.0, 1.0),
+          glm::radians(60.0),
+          glm::radians(45.0)),
+      createCullingVolume(
+          glm::dvec3(0.0),
+          glm::dvec3(-1.0, 0.0, 0.0),
+          glm::dvec3(0.0, 0.0, 1.0),
+          glm::radians(60.0),
+          glm::radians(45.0))};
+
+  std::vector<OrientedBoundingBox> boxes;
+  std::vector<BoundingSphere> spheres;
+  for (int x = -3; x <= 3; ++x) {
+    for (int y = -3; y <= 3; ++y) {
+      for (int z = -2; z <= 2; ++z) {
+        const glm::dvec3 center(x * 10.0, y * 10.0, z * 10.0);
+        boxes.emplace_back(
+            center,
+            glm::dmat3(
+                glm::dvec3(2.0, 1.0, 0.0),
+                glm::dvec3(-0.5, 1.0, 0.0),
+                glm::dvec3(0.0, 0.0, 3.0)));
+        spheres.emplace_back(center, 4.0);
+      }
+    }
+  }
+
+  BoundingVolumeBatch batch;
+  batch.reserve(boxes.size() + spheres.size());
+  for (const OrientedBoundingBox& box : boxes) {
+    batch.add(box);
+  }
+  for (const BoundingSphere& sphere : spheres) {
+    batch.add(sphere);
+  }
+  REQUIRE(batch.size() == boxes.size() + spheres.size());
+
+  std::vector<uint64_t> visibility;
+  batch.computeVisibility(cullingVolumes, visibility);
+  REQUIRE(visibility.size() == batch.size());
+
+  size_t visibleCount = 0;
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    for (size_t j = 0; j < cullingVolumes.size(); ++j) {
+      const bool expected = isVisible(boxes[i], cullingVolumes[j]);
+      CHECK(((visibility[i] >> j) & 1) == (expected ? 1 : 0));
+      visibleCount += expected ? 1 : 0;
+    }
+  }
+  for (size_t i = 0; i < spheres.size(); ++i) {
+    const uint64_t mask = visibility[boxes.size() + i];
+    for (size_t j = 0; j < cullingVolumes.size(); ++j) {
+      const bool expected = isVisible(spheres[i], cullingVolumes[j]);
+      CHECK(((mask >> j) & 1) == (expected ? 1 : 0));
+      visibleCount += expected ? 1 : 0;
+    }
+  }
+
+  // Make sure the test actually covers both outcomes.
+  CHECK(visibleCount > 0);
+  CHECK(visibleCount < 2 * batch.size() * cullingVolumes.size());
+
+  SECTION("clear removes all bounding volumes") {
+    batch.clear();
+    CHECK(batch.empty());
+    batch.computeVisibility(cullingVolumes, visibility);
+    CHECK(visibility.empty());
+  }
+}
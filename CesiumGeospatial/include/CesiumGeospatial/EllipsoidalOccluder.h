@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Ellipsoid.h"
+#include "Library.h"
+
+#include <glm/vec3.hpp>
+#include <gsl/span>
+
+#include <optional>
+
+namespace CesiumGeospatial {
+
+/**
+ * @brief Determines whether points are hidden from a camera by the horizon of
+ * an {@link Ellipsoid}.
+ *
+ * The occluder works in the "ellipsoid-scaled" space, in which the ellipsoid
+ * is a unit sphere. This is the space in which the `HorizonOcclusionPoint` of
+ * a quantized-mesh tile is given. A horizon occlusion point (also called a
+ * horizon culling point) of a set of positions has the property that, if it
+ * is below the horizon, all of the positions are below the horizon, too.
+ */
+class CESIUMGEOSPATIAL_API EllipsoidalOccluder final {
+public:
+  /**
+   * @brief Creates a new instance.
+   *
+   * @param ellipsoid The ellipsoid that occludes points.
+   * @param cameraPosition The position of the camera, in cartesian
+   * coordinates.
+   */
+  EllipsoidalOccluder(
+      const Ellipsoid& ellipsoid,
+      const glm::dvec3& cameraPosition) noexcept;
+
+  /**
+   * @brief Returns the {@link Ellipsoid}.
+   */
+  const Ellipsoid& getEllipsoid() const noexcept { return this->_ellipsoid; }
+
+  /**
+   * @brief Returns the position of the camera, in cartesian coordinates.
+   */
+  const glm::dvec3& getCameraPosition() const noexcept {
+    return this->_cameraPosition;
+  }
+
+  /**
+   * @brief Returns whether the camera is inside of the ellipsoid.
+   *
+   * In this case, every point in the direction of the center of the ellipsoid
+   * is considered to be occluded.
+   */
+  bool isCameraInsideEllipsoid() const noexcept {
+    return this->_distanceToLimbInScaledSpaceSquared < 0.0;
+  }
+
+  /**
+   * @brief Determines whether a point is hidden from the camera by the
+   * ellipsoid.
+   *
+   * @param occludee The point, in cartesian coordinates.
+   * @return Whether the point is visible.
+   */
+  bool isPointVisible(const glm::dvec3& occludee) const noexcept;
+
+  /**
+   * @brief Determines whether a point, expressed in the ellipsoid-scaled
+   * space, is hidden from the camera by the ellipsoid.
+   *
+   * @param occludeeScaledSpacePosition The point, in the ellipsoid-scaled
+   * space.
+   * @return Whether the point is visible.
+   */
+  bool isScaledSpacePointVisible(
+      const glm::dvec3& occludeeScaledSpacePosition) const noexcept;
+
+  /**
+   * @brief Computes a horizon occlusion point, in the ellipsoid-scaled space,
+   * for a set of positions.
+   *
+   * The horizon occlusion point is placed along the given direction from the
+   * center of the ellipsoid, usually the direction to the center of the
+   * bounding volume of the positions.
+   *
+   * @param ellipsoid The ellipsoid.
+   * @param directionToPoint The direction, from the center of the ellipsoid,
+   * along which the horizon occlusion point is placed.
+   * @param positions The positions, in cartesian coordinates.
+   * @return The horizon occlusion point, or `std::nullopt` if there is no
+   * such point along the given direction, for example because the positions
+   * span more than a hemisphere of the ellipsoid.
+   */
+  static std::optional<glm::dvec3> computeHorizonCullingPoint(
+      const Ellipsoid& ellipsoid,
+      const glm::dvec3& directionToPoint,
+      gsl::span<const glm::dvec3> positions) noexcept;
+
+private:
+  Ellipsoid _ellipsoid;
+  glm::dvec3 _cameraPosition;
+  glm::dvec3 _cameraPositionInScaledSpace;
+  double _distanceToLimbInScaledSpaceSquared;
+};
+
+} // namespace CesiumGeospatial
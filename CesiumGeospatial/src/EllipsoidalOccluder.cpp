@@ -0,0 +1,117 @@
+#include "CesiumGeospatial/EllipsoidalOccluder.h"
+
+#include <glm/common.hpp>
+#include <glm/exponential.hpp>
+#include <glm/geometric.hpp>
+
+#include <cmath>
+
+namespace CesiumGeospatial {
+
+namespace {
+
+glm::dvec3 transformPositionToScaledSpace(
+    const Ellipsoid& ellipsoid,
+    const glm::dvec3& position) noexcept {
+  return position / ellipsoid.getRadii();
+}
+
+double computeMagnitude(
+    const Ellipsoid& ellipsoid,
+    const glm::dvec3& position,
+    const glm::dvec3& scaledSpaceDirectionToPoint) noexcept {
+  const glm::dvec3 scaledSpacePosition =
+      transformPositionToScaledSpace(ellipsoid, position);
+  double magnitudeSquared = glm::dot(scaledSpacePosition, scaledSpacePosition);
+  double magnitude = glm::sqrt(magnitudeSquared);
+  const glm::dvec3 direction = scaledSpacePosition / magnitude;
+
+  // For the purpose of this computation, points below the ellipsoid are
+  // considered to be on it instead.
+  magnitudeSquared = glm::max(1.0, magnitudeSquared);
+  magnitude = glm::max(1.0, magnitude);
+
+  const double cosAlpha = glm::dot(direction, scaledSpaceDirectionToPoint);
+  const double sinAlpha =
+      glm::length(glm::cross(direction, scaledSpaceDirectionToPoint));
+  const double cosBeta = 1.0 / magnitude;
+  const double sinBeta = glm::sqrt(magnitudeSquared - 1.0) * cosBeta;
+
+  return 1.0 / (cosAlpha * cosBeta - sinAlpha * sinBeta);
+}
+
+} // namespace
+
+EllipsoidalOccluder::EllipsoidalOccluder(
+    const Ellipsoid& ellipsoid,
+    const glm::dvec3& cameraPosition) noexcept
+    : _ellipsoid(ellipsoid),
+      _cameraPosition(cameraPosition),
+      _cameraPositionInScaledSpace(
+          transformPositionToScaledSpace(ellipsoid, cameraPosition)),
+      _distanceToLimbInScaledSpaceSquared(
+          glm::dot(
+              this->_cameraPositionInScaledSpace,
+              this->_cameraPositionInScaledSpace) -
+          1.0) {}
+
+bool EllipsoidalOccluder::isPointVisible(
+    const glm::dvec3& occludee) const noexcept {
+  return this->isScaledSpacePointVisible(
+      transformPositionToScaledSpace(this->_ellipsoid, occludee));
+}
+
+bool EllipsoidalOccluder::isScaledSpacePointVisible(
+    const glm::dvec3& occludeeScaledSpacePosition) const noexcept {
+  // See https://cesium.com/blog/2013/04/25/horizon-culling/
+  const glm::dvec3& cv = this->_cameraPositionInScaledSpace;
+  const double vhMagnitudeSquared = this->_distanceToLimbInScaledSpaceSquared;
+  const glm::dvec3 vt = occludeeScaledSpacePosition - cv;
+  const double vtDotVc = -glm::dot(vt, cv);
+
+  // If the camera is inside the ellipsoid, all points in the direction of
+  // the ellipsoid are occluded. Otherwise, a point is occluded if it is
+  // further away than the horizon plane and inside the horizon cone.
+  const bool isOccluded =
+      vhMagnitudeSquared < 0.0
+          ? vtDotVc > 0.0
+          : (vtDotVc > vhMagnitudeSquared &&
+             vtDotVc * vtDotVc / glm::dot(vt, vt) > vhMagnitudeSquared);
+
+  return !isOccluded;
+}
+
+/*static*/ std::optional<glm::dvec3>
+EllipsoidalOccluder::computeHorizonCullingPoint(
+    const Ellipsoid& ellipsoid,
+    const glm::dvec3& directionToPoint,
+    gsl::span<const glm::dvec3> positions) noexcept {
+  const glm::dvec3 scaledSpaceDirection =
+      transformPositionToScaledSpace(ellipsoid, directionToPoint);
+  const double scaledSpaceDirectionLength = glm::length(scaledSpaceDirection);
+  if (scaledSpaceDirectionLength == 0.0) {
+    return std::nullopt;
+  }
+  const glm::dvec3 scaledSpaceDirectionToPoint =
+      scaledSpaceDirection / scaledSpaceDirectionLength;
+
+  double resultMagnitude = 0.0;
+  for (const glm::dvec3& position : positions) {
+    const double candidateMagnitude =
+        computeMagnitude(ellipsoid, position, scaledSpaceDirectionToPoint);
+    if (candidateMagnitude < 0.0) {
+      // This position faces away from the direction, so there is no horizon
+      // occlusion point in that direction.
+      return std::nullopt;
+    }
+    resultMagnitude = glm::max(resultMagnitude, candidateMagnitude);
+  }
+
+  if (resultMagnitude <= 0.0 || !std::isfinite(resultMagnitude)) {
+    return std::nullopt;
+  }
+
+  return scaledSpaceDirectionToPoint * resultMagnitude;
+}
+
+} // namespace CesiumGeospatial
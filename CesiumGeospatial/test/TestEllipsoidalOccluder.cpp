@@ -0,0 +1,108 @@
+#include "CesiumGeospatial/Ellipsoid.h"
+#include "CesiumGeospatial/EllipsoidalOccluder.h"
+
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+using namespace CesiumUtility;
+using namespace CesiumGeospatial;
+
+TEST_CASE("EllipsoidalOccluder") {
+  SECTION("isPointVisible") {
+    EllipsoidalOccluder occluder(
+        Ellipsoid(1.0, 1.1, 0.9),
+        glm::dvec3(0.0, 0.0, 2.5));
+    CHECK(!occluder.isCameraInsideEllipsoid());
+    CHECK(occluder.isPointVisible(glm::dvec3(0.0, -3.0, -3.0)));
+    CHECK(!occluder.isPointVisible(glm::dvec3(0.0, 0.0, -3.0)));
+  }
+
+  SECTION("reports not visible when point is directly behind ellipsoid") {
+    EllipsoidalOccluder occluder(
+        Ellipsoid::WGS84,
+        glm::dvec3(7000000.0, 0.0, 0.0));
+    CHECK(!occluder.isPointVisible(glm::dvec3(-7000000.0, 0.0, 0.0)));
+    CHECK(occluder.isPointVisible(glm::dvec3(6500000.0, 0.0, 0.0)));
+  }
+
+  SECTION("occludes everything behind the camera when it is inside") {
+    EllipsoidalOccluder occluder(
+        Ellipsoid::WGS84,
+        glm::dvec3(6000000.0, 0.0, 0.0));
+    CHECK(occluder.isCameraInsideEllipsoid());
+    CHECK(!occluder.isPointVisible(glm::dvec3(0.0, 0.0, 0.0)));
+    CHECK(occluder.isPointVisible(glm::dvec3(7000000.0, 0.0, 0.0)));
+  }
+
+  SECTION("computeHorizonCullingPoint") {
+    const Ellipsoid ellipsoid(12345.0, 12345.0, 12345.0);
+
+    SECTION("returns the point when it is on the center line") {
+      const std::vector<glm::dvec3> positions{glm::dvec3(24690.0, 0.0, 0.0)};
+      const std::optional<glm::dvec3> result =
+          EllipsoidalOccluder::computeHorizonCullingPoint(
+              ellipsoid,
+              glm::dvec3(1.0, 0.0, 0.0),
+              positions);
+      REQUIRE(result);
+      CHECK(Math::equalsEpsilon(result->x, 2.0, Math::EPSILON14));
+      CHECK(Math::equalsEpsilon(result->y, 0.0, Math::EPSILON14));
+      CHECK(Math::equalsEpsilon(result->z, 0.0, Math::EPSILON14));
+    }
+
+    SECTION("returns nothing when a position is on the horizon of the center "
+            "line") {
+      const std::vector<glm::dvec3> positions{glm::dvec3(0.0, 12345.0, 0.0)};
+      CHECK(!EllipsoidalOccluder::computeHorizonCullingPoint(
+          ellipsoid,
+          glm::dvec3(1.0, 0.0, 0.0),
+          positions));
+    }
+
+    SECTION("returns nothing when a position faces away") {
+      const std::vector<glm::dvec3> positions{
+          glm::dvec3(12345.0, 0.0, 0.0),
+          glm::dvec3(-12345.0, 0.0, 0.0)};
+      CHECK(!EllipsoidalOccluder::computeHorizonCullingPoint(
+          ellipsoid,
+          glm::dvec3(1.0, 0.0, 0.0),
+          positions));
+    }
+
+    SECTION("is occluded only if all positions are occluded") {
+      const std::vector<glm::dvec3> positions{
+          glm::dvec3(12345.0, 1000.0, 0.0),
+          glm::dvec3(12345.0, -1000.0, 0.0),
+          glm::dvec3(12345.0, 0.0, 1000.0),
+          glm::dvec3(12345.0, 0.0, -1000.0)};
+      const std::optional<glm::dvec3> result =
+          EllipsoidalOccluder::computeHorizonCullingPoint(
+              ellipsoid,
+              glm::dvec3(1.0, 0.0, 0.0),
+              positions);
+      REQUIRE(result);
+
+      const std::vector<glm::dvec3> cameraPositions{
+          glm::dvec3(20000.0, 0.0, 0.0),
+          glm::dvec3(0.0, 20000.0, 0.0),
+          glm::dvec3(-20000.0, 0.0, 0.0),
+          glm::dvec3(0.0, 0.0, -20000.0)};
+      for (const glm::dvec3& cameraPosition : cameraPositions) {
+        EllipsoidalOccluder occluder(ellipsoid, cameraPosition);
+        if (!occluder.isScaledSpacePointVisible(*result)) {
+          for (const glm::dvec3& position : positions) {
+            CHECK(!occluder.isPointVisible(position));
+          }
+        }
+      }
+
+      EllipsoidalOccluder front(ellipsoid, glm::dvec3(20000.0, 0.0, 0.0));
+      CHECK(front.isScaledSpacePointVisible(*result));
+      EllipsoidalOccluder back(ellipsoid, glm::dvec3(-20000.0, 0.0, 0.0));
+      CHECK(!back.isScaledSpacePointVisible(*result));
+    }
+  }
+}
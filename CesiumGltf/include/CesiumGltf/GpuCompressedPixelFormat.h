@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+
+namespace CesiumGltf {
+
+/**
+ * @brief The block-compressed format of the pixels of an {@link ImageCesium},
+ * which a GPU can sample without decompressing them first.
+ *
+ * All of these formats store the pixels in blocks of 4x4 pixels. Images whose
+ * size is not a multiple of 4 are padded to whole blocks.
+ */
+enum class GpuCompressedPixelFormat {
+  /**
+   * @brief The pixels are not compressed.
+   */
+  None,
+
+  /**
+   * @brief ETC2 with RGB channels, 8 bytes per block.
+   */
+  Etc2Rgb,
+
+  /**
+   * @brief ETC2 with RGB channels and EAC alpha, 16 bytes per block.
+   */
+  Etc2Rgba,
+
+  /**
+   * @brief BC1 (DXT1) with RGB channels, 8 bytes per block.
+   */
+  Bc1Rgb,
+
+  /**
+   * @brief BC3 (DXT5) with RGBA channels, 16 bytes per block.
+   */
+  Bc3Rgba,
+
+  /**
+   * @brief BC4 with a single red channel, 8 bytes per block.
+   */
+  Bc4R,
+
+  /**
+   * @brief BC5 with red and green channels, 16 bytes per block.
+   */
+  Bc5Rg,
+
+  /**
+   * @brief BC7 with RGBA channels, 16 bytes per block.
+   */
+  Bc7Rgba,
+
+  /**
+   * @brief ASTC with RGBA channels and 4x4 pixel blocks, 16 bytes per block.
+   */
+  Astc4x4Rgba
+};
+
+/**
+ * @brief Returns the number of bytes of each 4x4 pixel block of a
+ * block-compressed format, or 0 for {@link GpuCompressedPixelFormat::None}.
+ */
+constexpr size_t
+getBytesPerBlock(GpuCompressedPixelFormat format) noexcept {
+  switch (format) {
+  case GpuCompressedPixelFormat::Etc2Rgb:
+  case GpuCompressedPixelFormat::Bc1Rgb:
+  case GpuCompressedPixelFormat::Bc4R:
+    return 8;
+  case GpuCompressedPixelFormat::Etc2Rgba:
+  case GpuCompressedPixelFormat::Bc3Rgba:
+  case GpuCompressedPixelFormat::Bc5Rg:
+  case GpuCompressedPixelFormat::Bc7Rgba:
+  case GpuCompressedPixelFormat::Astc4x4Rgba:
+    return 16;
+  case GpuCompressedPixelFormat::None:
+  default:
+    return 0;
+  }
+}
+
+/**
+ * @brief Returns the number of bytes of an image of the given size in a
+ * block-compressed format, or 0 for {@link GpuCompressedPixelFormat::None}.
+ */
+constexpr size_t computeCompressedByteSize(
+    GpuCompressedPixelFormat format,
+    size_t width,
+    size_t height) noexcept {
+  return ((width + 3) / 4) * ((height + 3) / 4) * getBytesPerBlock(format);
+}
+
+} // namespace CesiumGltf
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "CesiumGltf/GpuCompressedPixelFormat.h"
 #include "CesiumGltf/Library.h"
 
 #include <cstddef>
@@ -7,6 +8,24 @@
 #include <vector>
 
 namespace CesiumGltf {
+
+/**
+ * @brief The byte range within {@link ImageCesium::pixelData} of one mip
+ * level of the image.
+ */
+struct CESIUMGLTF_API ImageCesiumMipPosition final {
+  /**
+   * @brief The offset of the mip level's pixels from the start of
+   * {@link ImageCesium::pixelData}, in bytes.
+   */
+  size_t byteOffset = 0;
+
+  /**
+   * @brief The size of the mip level's pixels, in bytes.
+   */
+  size_t byteSize = 0;
+};
+
 /**
  * @brief Holds {@link Image} properties that are specific to the glTF loader
  * rather than part of the glTF spec.
@@ -50,7 +69,33 @@ struct CESIUMGLTF_API ImageCesium final {
    * | 2                  | grey, alpha               |
    * | 3                  | red, green, blue          |
    * | 4                  | red, green, blue, alpha   |
+   *
+   * If {@link compressedPixelFormat} is not
+   * {@link GpuCompressedPixelFormat::None}, the pixel data is instead a
+   * sequence of 4x4 pixel blocks in that format, in row-major order, and
+   * {@link channels} and {@link bytesPerChannel} describe the pixels after
+   * decompression.
    */
   std::vector<std::byte> pixelData;
+
+  /**
+   * @brief The block-compressed format of {@link pixelData}, or
+   * {@link GpuCompressedPixelFormat::None} if the pixels are not compressed.
+   */
+  GpuCompressedPixelFormat compressedPixelFormat =
+      GpuCompressedPixelFormat::None;
+
+  /**
+   * @brief The byte range of each mip level within {@link pixelData}, starting
+   * with the full-size image.
+   *
+   * If this is empty, {@link pixelData} holds only the full-size image.
+   * Otherwise, the full-size image is still at the start of
+   * {@link pixelData}, and each following level is half the size of the
+   * previous one in each direction, rounded down, but at least one pixel.
+   * Generated levels are tightly packed, down to a level of 1x1 pixels.
+   * Levels read from a KTX2 file may stop at a larger size.
+   */
+  std::vector<ImageCesiumMipPosition> mipPositions;
 };
 } // namespace CesiumGltf
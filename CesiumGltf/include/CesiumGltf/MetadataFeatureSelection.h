@@ -0,0 +1,122 @@
+#pragma once
+
+#include <gsl/span>
+
+#include <cstdint>
+#include <vector>
+
+namespace CesiumGltf {
+/**
+ * @brief The comparison between the values of a property and a single value
+ * that {@link MetadataPropertyView::select} evaluates.
+ */
+enum class MetadataComparison {
+  Equal,
+  NotEqual,
+  Less,
+  LessOrEqual,
+  Greater,
+  GreaterOrEqual
+};
+
+/**
+ * @brief A set of the instances of a FeatureTable, with one bit per instance.
+ *
+ * Selections are created by {@link MetadataPropertyView::select} and can be
+ * combined to evaluate a predicate over several properties, for example:
+ *
+ * ```
+ * MetadataFeatureSelection selection =
+ *     height.select(MetadataComparison::Greater, 50.0f);
+ * selection &= type.select(MetadataComparison::Equal, "building");
+ * ```
+ *
+ * Bit `i % 64` of word `i / 64` is set if instance `i` is selected. The bits
+ * after the last instance are always zero.
+ */
+class MetadataFeatureSelection {
+public:
+  /**
+   * @brief Constructs an empty selection of no instances.
+   */
+  MetadataFeatureSelection() noexcept : _words{}, _size{0} {}
+
+  /**
+   * @brief Constructs a selection of the given number of instances.
+   *
+   * @param size The number of instances.
+   * @param selected Whether all instances are selected or none of them are.
+   */
+  MetadataFeatureSelection(int64_t size, bool selected);
+
+  /**
+   * @brief Gets the number of instances, whether selected or not.
+   */
+  int64_t size() const noexcept { return _size; }
+
+  /**
+   * @brief Determines whether an instance is selected.
+   */
+  bool isSelected(int64_t instance) const noexcept {
+    const uint64_t word = _words[static_cast<size_t>(instance / 64)];
+    return ((word >> (instance % 64)) & 1) != 0;
+  }
+
+  /**
+   * @brief Selects or deselects an instance.
+   */
+  void setSelected(int64_t instance, bool selected) noexcept {
+    uint64_t& word = _words[static_cast<size_t>(instance / 64)];
+    const uint64_t bit = uint64_t(1) << (instance % 64);
+    word = selected ? (word | bit) : (word & ~bit);
+  }
+
+  /**
+   * @brief Counts the selected instances.
+   */
+  int64_t count() const noexcept;
+
+  /**
+   * @brief Gets the indices of the selected instances in ascending order.
+   */
+  std::vector<int64_t> getSelectedInstances() const;
+
+  /**
+   * @brief Deselects the instances that are not selected in another selection
+   * of the same size.
+   */
+  MetadataFeatureSelection&
+  operator&=(const MetadataFeatureSelection& other) noexcept;
+
+  /**
+   * @brief Selects the instances that are selected in another selection of the
+   * same size.
+   */
+  MetadataFeatureSelection&
+  operator|=(const MetadataFeatureSelection& other) noexcept;
+
+  /**
+   * @brief Selects the instances that are not selected, and deselects the
+   * others.
+   */
+  void invert() noexcept;
+
+  /**
+   * @brief Gets the words that hold the bits of the instances.
+   */
+  gsl::span<const uint64_t> getWords() const noexcept { return _words; }
+
+  /**
+   * @copydoc getWords
+   *
+   * The bits after the last instance must be left zero.
+   */
+  gsl::span<uint64_t> getWords() noexcept { return _words; }
+
+private:
+  void clearUnusedBits() noexcept;
+
+  std::vector<uint64_t> _words;
+  int64_t _size;
+};
+} // namespace CesiumGltf
@@ -1,14 +1,18 @@
 #pragma once
 
 #include "CesiumGltf/MetadataArrayView.h"
+#include "CesiumGltf/MetadataFeatureSelection.h"
 #include "CesiumGltf/PropertyType.h"
 #include "CesiumGltf/PropertyTypeTraits.h"
 
 #include <gsl/span>
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <functional>
 #include <string_view>
 #include <type_traits>
 
@@ -230,7 +234,257 @@ public:
    */
   int64_t size() const noexcept { return _instanceCount; }
 
+  /**
+   * @brief Selects the instances whose value compares to the given value in
+   * the given way.
+   *
+   * Unlike calling {@link get} for each instance, this evaluates the
+   * comparison over the whole property at once. Numeric values are compared
+   * in blocks of 64 without branches, so that the compiler can vectorize the
+   * loop, booleans are compared 64 instances at a time, and strings are
+   * compared in a single scan of the offset buffer. ElementType must be a
+   * numeric type, bool or std::string_view.
+   *
+   * @param comparison How the value of each instance is compared with the
+   * given value.
+   * @param value The value to compare with.
+   * @return The selection of the instances whose value satisfies the
+   * comparison.
+   */
+  MetadataFeatureSelection
+  select(MetadataComparison comparison, ElementType value) const {
+    static_assert(
+        IsMetadataNumeric<ElementType>::value ||
+            IsMetadataBoolean<ElementType>::value ||
+            IsMetadataString<ElementType>::value,
+        "Only numeric, boolean and string properties can be selected from");
+    assert(
+        _status == MetadataPropertyViewStatus::Valid &&
+        "Check the status() first to make sure view is valid");
+
+    MetadataFeatureSelection selection(_instanceCount, false);
+    const gsl::span<uint64_t> words = selection.getWords();
+
+    if constexpr (IsMetadataBoolean<ElementType>::value) {
+      selectBooleans(comparison, value, words);
+    } else {
+      dispatchComparison(comparison, [this, value, words](auto compare) {
+        if constexpr (IsMetadataNumeric<ElementType>::value) {
+          selectNumerics(value, compare, words);
+        } else {
+          switch (_offsetType) {
+          case PropertyType::Uint8:
+            selectStrings<uint8_t>(value, compare, words);
+            break;
+          case PropertyType::Uint16:
+            selectStrings<uint16_t>(value, compare, words);
+            break;
+          case PropertyType::Uint32:
+            selectStrings<uint32_t>(value, compare, words);
+            break;
+          case PropertyType::Uint64:
+            selectStrings<uint64_t>(value, compare, words);
+            break;
+          default:
+            assert(false && "Offset type has unknown type");
+            break;
+          }
+        }
+      });
+    }
+
+    return selection;
+  }
+
+  /**
+   * @brief Copies the values of all instances into a dense array, converting
+   * them to another numeric type.
+   *
+   * ElementType must be a numeric type.
+   *
+   * @param output The array to copy to, with room for at least {@link size}
+   * values.
+   */
+  template <typename T> void copyValues(gsl::span<T> output) const noexcept {
+    static_assert(
+        IsMetadataNumeric<ElementType>::value,
+        "Only numeric properties can be copied");
+    assert(output.size() >= static_cast<size_t>(_instanceCount));
+
+    const ElementType* pValues =
+        reinterpret_cast<const ElementType*>(_valueBuffer.data());
+    const size_t count = static_cast<size_t>(_instanceCount);
+    for (size_t i = 0; i < count; ++i) {
+      output[i] = static_cast<T>(pValues[i]);
+    }
+  }
+
+  /**
+   * @brief Copies the values of the selected instances into a dense array,
+   * converting them to another numeric type.
+   *
+   * ElementType must be a numeric type.
+   *
+   * @param selection The selection of instances, of the same size as this
+   * view.
+   * @param output The array to copy to, with room for at least
+   * {@link MetadataFeatureSelection::count} values.
+   * @return The number of values copied.
+   */
+  template <typename T>
+  int64_t copyValues(
+      const MetadataFeatureSelection& selection,
+      gsl::span<T> output) const noexcept {
+    static_assert(
+        IsMetadataNumeric<ElementType>::value,
+        "Only numeric properties can be copied");
+    assert(selection.size() == _instanceCount);
+    assert(output.size() >= static_cast<size_t>(selection.count()));
+
+    const ElementType* pValues =
+        reinterpret_cast<const ElementType*>(_valueBuffer.data());
+    const gsl::span<const uint64_t> words = selection.getWords();
+
+    size_t copied = 0;
+    for (size_t i = 0; i < words.size(); ++i) {
+      const ElementType* pBlock = pValues + i * 64;
+      uint64_t word = words[i];
+      if (word == ~uint64_t(0)) {
+        for (size_t j = 0; j < 64; ++j) {
+          output[copied + j] = static_cast<T>(pBlock[j]);
+        }
+        copied += 64;
+        continue;
+      }
+
+      for (size_t j = 0; word != 0; ++j, word >>= 1) {
+        if ((word & 1) != 0) {
+          output[copied++] = static_cast<T>(pBlock[j]);
+        }
+      }
+    }
+
+    return static_cast<int64_t>(copied);
+  }
+
 private:
+  template <typename Kernel>
+  static void
+  dispatchComparison(MetadataComparison comparison, Kernel&& kernel) {
+    switch (comparison) {
+    case MetadataComparison::Equal:
+      kernel(std::equal_to<ElementType>());
+      break;
+    case MetadataComparison::NotEqual:
+      kernel(std::not_equal_to<ElementType>());
+      break;
+    case MetadataComparison::Less:
+      kernel(std::less<ElementType>());
+      break;
+    case MetadataComparison::LessOrEqual:
+      kernel(std::less_equal<ElementType>());
+      break;
+    case MetadataComparison::Greater:
+      kernel(std::greater<ElementType>());
+      break;
+    case MetadataComparison::GreaterOrEqual:
+      kernel(std::greater_equal<ElementType>());
+      break;
+    }
+  }
+
+  template <typename Compare>
+  void selectNumerics(
+      ElementType value,
+      Compare compare,
+      const gsl::span<uint64_t>& words) const noexcept {
+    const ElementType* pValues =
+        reinterpret_cast<const ElementType*>(_valueBuffer.data());
+    const size_t count = static_cast<size_t>(_instanceCount);
+
+    for (size_t i = 0; i < words.size(); ++i) {
+      const ElementType* pBlock = pValues + i * 64;
+      const size_t blockSize = std::min(count - i * 64, size_t(64));
+
+      uint64_t bits = 0;
+      if (blockSize == 64) {
+        // A constant trip count and no branches let the compiler vectorize
+        // this loop.
+        for (size_t j = 0; j < 64; ++j) {
+          bits |= uint64_t(compare(pBlock[j], value)) << j;
+        }
+      } else {
+        for (size_t j = 0; j < blockSize; ++j) {
+          bits |= uint64_t(compare(pBlock[j], value)) << j;
+        }
+      }
+      words[i] = bits;
+    }
+  }
+
+  void selectBooleans(
+      MetadataComparison comparison,
+      bool value,
+      const gsl::span<uint64_t>& words) const noexcept {
+    // The bits of the value buffer are in the same order as the bits of the
+    // selection, so each word of the selection is computed from 8 bytes.
+    const size_t byteCount = static_cast<size_t>((_instanceCount + 7) / 8);
+    for (size_t i = 0; i < words.size(); ++i) {
+      uint64_t bits = 0;
+      std::memcpy(
+          &bits,
+          _valueBuffer.data() + i * 8,
+          std::min(byteCount - i * 8, sizeof(bits)));
+      words[i] = compareBooleans(comparison, value, bits);
+    }
+
+    const int64_t usedBits = _instanceCount % 64;
+    if (usedBits != 0) {
+      words[words.size() - 1] &= (uint64_t(1) << usedBits) - 1;
+    }
+  }
+
+  static uint64_t compareBooleans(
+      MetadataComparison comparison,
+      bool value,
+      uint64_t bits) noexcept {
+    const uint64_t all = ~uint64_t(0);
+    switch (comparison) {
+    case MetadataComparison::Equal:
+      return value ? bits : ~bits;
+    case MetadataComparison::NotEqual:
+      return value ? ~bits : bits;
+    case MetadataComparison::Less:
+      return value ? ~bits : 0;
+    case MetadataComparison::LessOrEqual:
+      return value ? all : ~bits;
+    case MetadataComparison::Greater:
+      return value ? 0 : bits;
+    case MetadataComparison::GreaterOrEqual:
+      return value ? bits : all;
+    }
+    return 0;
+  }
+
+  template <typename OffsetType, typename Compare>
+  void selectStrings(
+      std::string_view value,
+      Compare compare,
+      const gsl::span<uint64_t>& words) const noexcept {
+    const OffsetType* pOffsets =
+        reinterpret_cast<const OffsetType*>(_stringOffsetBuffer.data());
+    const char* pChars = reinterpret_cast<const char*>(_valueBuffer.data());
+    const size_t count = static_cast<size_t>(_instanceCount);
+
+    size_t begin = static_cast<size_t>(pOffsets[0]);
+    for (size_t i = 0; i < count; ++i) {
+      const size_t end = static_cast<size_t>(pOffsets[i + 1]);
+      const std::string_view instance(pChars + begin, end - begin);
+      words[i / 64] |= uint64_t(compare(instance, value)) << (i % 64);
+      begin = end;
+    }
+  }
+
   ElementType getNumeric(int64_t instance) const noexcept {
     return reinterpret_cast<const ElementType*>(_valueBuffer.data())[instance];
   }
@@ -0,0 +1,81 @@
+#include "CesiumGltf/MetadataFeatureSelection.h"
+
+#include <cassert>
+
+namespace CesiumGltf {
+namespace {
+int64_t countBits(uint64_t word) noexcept {
+  word = word - ((word >> 1) & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  return static_cast<int64_t>((word * 0x0101010101010101ULL) >> 56);
+}
+} // namespace
+
+MetadataFeatureSelection::MetadataFeatureSelection(int64_t size, bool selected)
+    : _words(
+          static_cast<size_t>((size + 63) / 64),
+          selected ? ~uint64_t(0) : uint64_t(0)),
+      _size{size} {
+  assert(size >= 0);
+  this->clearUnusedBits();
+}
+
+int64_t MetadataFeatureSelection::count() const noexcept {
+  int64_t result = 0;
+  for (const uint64_t word : this->_words) {
+    result += countBits(word);
+  }
+  return result;
+}
+
+std::vector<int64_t> MetadataFeatureSelection::getSelectedInstances() const {
+  std::vector<int64_t> result;
+  result.reserve(static_cast<size_t>(this->count()));
+
+  for (size_t i = 0; i < this->_words.size(); ++i) {
+    uint64_t word = this->_words[i];
+    while (word != 0) {
+      // The lowest set bit, and the number of zeros below it.
+      const uint64_t lowest = word & (~word + 1);
+      const int64_t bit = countBits(lowest - 1);
+      result.push_back(static_cast<int64_t>(i) * 64 + bit);
+      word ^= lowest;
+    }
+  }
+
+  return result;
+}
+
+MetadataFeatureSelection& MetadataFeatureSelection::operator&=(
+    const MetadataFeatureSelection& other) noexcept {
+  assert(this->_size == other._size);
+  for (size_t i = 0; i < this->_words.size(); ++i) {
+    this->_words[i] &= other._words[i];
+  }
+  return *this;
+}
+
+MetadataFeatureSelection& MetadataFeatureSelection::operator|=(
+    const MetadataFeatureSelection& other) noexcept {
+  assert(this->_size == other._size);
+  for (size_t i = 0; i < this->_words.size(); ++i) {
+    this->_words[i] |= other._words[i];
+  }
+  return *this;
+}
+
+void MetadataFeatureSelection::invert() noexcept {
+  for (uint64_t& word : this->_words) {
+    word = ~word;
+  }
+  this->clearUnusedBits();
+}
+
+void MetadataFeatureSelection::clearUnusedBits() noexcept {
+  const int64_t usedBits = this->_size % 64;
+  if (usedBits != 0) {
+    this->_words.back() &= (uint64_t(1) << usedBits) - 1;
+  }
+}
+} // namespace CesiumGltf
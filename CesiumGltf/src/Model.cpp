@@ -1,7 +1,9 @@
 #include "CesiumGltf/Model.h"
 
 #include "CesiumGltf/AccessorView.h"
+#include "CesiumGltf/ExtensionBufferViewExtMeshoptCompression.h"
 #include "CesiumGltf/ExtensionKhrDracoMeshCompression.h"
+#include "CesiumGltf/ExtensionKhrTextureBasisu.h"
 
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/norm.hpp>
@@ -93,6 +95,12 @@ void Model::merge(Model&& rhs) {
   for (size_t i = firstBufferView; i < this->bufferViews.size(); ++i) {
     BufferView& bufferView = this->bufferViews[i];
     updateIndex(bufferView.buffer, firstBuffer);
+
+    ExtensionBufferViewExtMeshoptCompression* pMeshopt =
+        bufferView.getExtension<ExtensionBufferViewExtMeshoptCompression>();
+    if (pMeshopt) {
+      updateIndex(pMeshopt->buffer, firstBuffer);
+    }
   }
 
   for (size_t i = firstImage; i < this->images.size(); ++i) {
@@ -160,6 +168,12 @@ void Model::merge(Model&& rhs) {
 
     updateIndex(texture.sampler, firstSampler);
     updateIndex(texture.source, firstImage);
+
+    ExtensionKhrTextureBasisu* pBasisu =
+        texture.getExtension<ExtensionKhrTextureBasisu>();
+    if (pBasisu) {
+      updateIndex(pBasisu->source, firstImage);
+    }
   }
 
   for (size_t i = firstMaterial; i < this->materials.size(); ++i) {
@@ -0,0 +1,216 @@
+#include "CesiumGltf/MetadataFeatureSelection.h"
+#include "CesiumGltf/MetadataPropertyView.h"
+
+#include <catch2/catch.hpp>
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace {
+template <typename T>
+MetadataPropertyView<T>
+createNumericView(const std::vector<T>& values, std::vector<std::byte>& data) {
+  data.resize(values.size() * sizeof(T));
+  std::memcpy(data.data(), values.data(), data.size());
+  return MetadataPropertyView<T>(
+      MetadataPropertyViewStatus::Valid,
+      gsl::span<const std::byte>(data.data(), data.size()),
+      gsl::span<const std::byte>(),
+      gsl::span<const std::byte>(),
+      PropertyType::None,
+      0,
+      static_cast<int64_t>(values.size()));
+}
+
+template <typename T, typename Predicate>
+void checkSelection(
+    const MetadataFeatureSelection& selection,
+    const std::vector<T>& values,
+    Predicate predicate) {
+  REQUIRE(selection.size() == static_cast<int64_t>(values.size()));
+  int64_t expectedCount = 0;
+  for (size_t i = 0; i < values.size(); ++i) {
+    const bool expected = predicate(values[i]);
+    REQUIRE(selection.isSelected(static_cast<int64_t>(i)) == expected);
+    expectedCount += expected ? 1 : 0;
+  }
+  REQUIRE(selection.count() == expectedCount);
+}
+} // namespace
+
+TEST_CASE("Test MetadataFeatureSelection") {
+  SECTION("Selections of all or no instances") {
+    MetadataFeatureSelection all(100, true);
+    CHECK(all.size() == 100);
+    CHECK(all.count() == 100);
+    CHECK(all.getWords()[1] == (uint64_t(1) << 36) - 1);
+
+    MetadataFeatureSelection none(100, false);
+    CHECK(none.count() == 0);
+
+    all.invert();
+    CHECK(all.count() == 0);
+  }
+
+  SECTION("Selections can be combined") {
+    MetadataFeatureSelection even(130, false);
+    MetadataFeatureSelection small(130, false);
+    for (int64_t i = 0; i < 130; ++i) {
+      even.setSelected(i, i % 2 == 0);
+      small.setSelected(i, i < 10);
+    }
+
+    MetadataFeatureSelection both = even;
+    both &= small;
+    CHECK(
+        both.getSelectedInstances() == std::vector<int64_t>{0, 2, 4, 6, 8});
+
+    MetadataFeatureSelection either = even;
+    either |= small;
+    CHECK(either.count() == 65 + 5);
+
+    even.invert();
+    CHECK(even.count() == 65);
+    CHECK(!even.isSelected(128));
+    CHECK(even.isSelected(129));
+  }
+}
+
+TEST_CASE("Select instances of a numeric property") {
+  std::vector<float> values(150);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<float>((i * 37) % 100);
+  }
+
+  std::vector<std::byte> data;
+  MetadataPropertyView<float> property = createNumericView(values, data);
+
+  checkSelection(
+      property.select(MetadataComparison::Greater, 50.0f),
+      values,
+      [](float value) { return value > 50.0f; });
+  checkSelection(
+      property.select(MetadataComparison::LessOrEqual, 50.0f),
+      values,
+      [](float value) { return value <= 50.0f; });
+  checkSelection(
+      property.select(MetadataComparison::Equal, 74.0f),
+      values,
+      [](float value) { return value == 74.0f; });
+  checkSelection(
+      property.select(MetadataComparison::NotEqual, 74.0f),
+      values,
+      [](float value) { return value != 74.0f; });
+
+  SECTION("Values are copied into dense arrays") {
+    std::vector<double> all(values.size());
+    property.copyValues<double>(all);
+    for (size_t i = 0; i < values.size(); ++i) {
+      REQUIRE(all[i] == static_cast<double>(values[i]));
+    }
+
+    const MetadataFeatureSelection selection =
+        property.select(MetadataComparison::GreaterOrEqual, 90.0f);
+    std::vector<double> selected(static_cast<size_t>(selection.count()));
+    CHECK(
+        property.copyValues<double>(selection, selected) ==
+        selection.count());
+
+    const std::vector<int64_t> instances = selection.getSelectedInstances();
+    REQUIRE(instances.size() == selected.size());
+    for (size_t i = 0; i < instances.size(); ++i) {
+      REQUIRE(
+          selected[i] ==
+          static_cast<double>(values[static_cast<size_t>(instances[i])]));
+    }
+  }
+
+  SECTION("A selection of all instances copies every value") {
+    const MetadataFeatureSelection selection(property.size(), true);
+    std::vector<int32_t> selected(values.size());
+    CHECK(property.copyValues<int32_t>(selection, selected) == property.size());
+    CHECK(selected[149] == static_cast<int32_t>(values[149]));
+  }
+}
+
+TEST_CASE("Select instances of a boolean property") {
+  std::vector<bool> values(70);
+  std::vector<std::byte> data(9);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = i % 3 == 0;
+    if (values[i]) {
+      data[i / 8] |= std::byte(1 << (i % 8));
+    }
+  }
+
+  MetadataPropertyView<bool> property(
+      MetadataPropertyViewStatus::Valid,
+      gsl::span<const std::byte>(data.data(), data.size()),
+      gsl::span<const std::byte>(),
+      gsl::span<const std::byte>(),
+      PropertyType::None,
+      0,
+      static_cast<int64_t>(values.size()));
+
+  checkSelection(
+      property.select(MetadataComparison::Equal, true),
+      values,
+      [](bool value) { return value; });
+  checkSelection(
+      property.select(MetadataComparison::Equal, false),
+      values,
+      [](bool value) { return !value; });
+  checkSelection(
+      property.select(MetadataComparison::Less, true),
+      values,
+      [](bool value) { return !value; });
+  checkSelection(
+      property.select(MetadataComparison::GreaterOrEqual, false),
+      values,
+      [](bool) { return true; });
+}
+
+TEST_CASE("Select instances of a string property") {
+  std::vector<std::string> values;
+  for (size_t i = 0; i < 100; ++i) {
+    values.push_back(i % 4 == 0 ? "building" : "tree" + std::to_string(i));
+  }
+
+  std::vector<std::byte> buffer;
+  std::vector<std::byte> offsetBuffer(sizeof(uint16_t));
+  for (const std::string& value : values) {
+    const std::byte* pChars = reinterpret_cast<const std::byte*>(value.data());
+    buffer.insert(buffer.end(), pChars, pChars + value.size());
+
+    const uint16_t offset = static_cast<uint16_t>(buffer.size());
+    offsetBuffer.resize(offsetBuffer.size() + sizeof(uint16_t));
+    std::memcpy(
+        offsetBuffer.data() + offsetBuffer.size() - sizeof(uint16_t),
+        &offset,
+        sizeof(uint16_t));
+  }
+
+  MetadataPropertyView<std::string_view> property(
+      MetadataPropertyViewStatus::Valid,
+      gsl::span<const std::byte>(buffer.data(), buffer.size()),
+      gsl::span<const std::byte>(),
+      gsl::span<const std::byte>(offsetBuffer.data(), offsetBuffer.size()),
+      PropertyType::Uint16,
+      0,
+      static_cast<int64_t>(values.size()));
+
+  checkSelection(
+      property.select(MetadataComparison::Equal, "building"),
+      values,
+      [](const std::string& value) { return value == "building"; });
+  checkSelection(
+      property.select(MetadataComparison::Less, "tree5"),
+      values,
+      [](const std::string& value) { return value < "tree5"; });
+}
@@ -219,6 +219,213 @@ ExtensionMeshPrimitiveExtFeatureMetadataJsonHandler::
   return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
 }
 
+} // namespace CesiumGltfReader
+// This file was generated by generate-classes.
+// DO NOT EDIT THIS FILE!
+#include "ExtensionKhrTextureBasisuJsonHandler.h"
+
+#include <CesiumGltf/ExtensionKhrTextureBasisu.h>
+
+#include <cassert>
+#include <string>
+
+namespace CesiumGltfReader {
+
+ExtensionKhrTextureBasisuJsonHandler::ExtensionKhrTextureBasisuJsonHandler(
+    const CesiumJsonReader::ExtensionReaderContext& context) noexcept
+    : CesiumJsonReader::ExtensibleObjectJsonHandler(context), _source() {}
+
+void ExtensionKhrTextureBasisuJsonHandler::reset(
+    CesiumJsonReader::IJsonHandler* pParentHandler,
+    CesiumGltf::ExtensionKhrTextureBasisu* pObject) {
+  CesiumJsonReader::ExtensibleObjectJsonHandler::reset(pParentHandler, pObject);
+  this->_pObject = pObject;
+}
+
+CesiumJsonReader::IJsonHandler*
+ExtensionKhrTextureBasisuJsonHandler::readObjectKey(
+    const std::string_view& str) {
+  assert(this->_pObject);
+  return this->readObjectKeyExtensionKhrTextureBasisu(
+      CesiumGltf::ExtensionKhrTextureBasisu::TypeName,
+      str,
+      *this->_pObject);
+}
+
+void ExtensionKhrTextureBasisuJsonHandler::reset(
+    CesiumJsonReader::IJsonHandler* pParentHandler,
+    CesiumUtility::ExtensibleObject& o,
+    const std::string_view& extensionName) {
+  std::any& value =
+      o.extensions
+          .emplace(extensionName, CesiumGltf::ExtensionKhrTextureBasisu())
+          .first->second;
+  this->reset(
+      pParentHandler,
+      &std::any_cast<CesiumGltf::ExtensionKhrTextureBasisu&>(value));
+}
+
+CesiumJsonReader::IJsonHandler* ExtensionKhrTextureBasisuJsonHandler::
+    readObjectKeyExtensionKhrTextureBasisu(
+        const std::string& objectType,
+        const std::string_view& str,
+        CesiumGltf::ExtensionKhrTextureBasisu& o) {
+  using namespace std::string_literals;
+
+  if ("source"s == str)
+    return property("source", this->_source, o.source);
+
+  return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
+}
+
+} // namespace CesiumGltfReader
+// This file was generated by generate-classes.
+// DO NOT EDIT THIS FILE!
+#include "ExtensionBufferViewExtMeshoptCompressionJsonHandler.h"
+
+#include <CesiumGltf/ExtensionBufferViewExtMeshoptCompression.h>
+
+#include <cassert>
+#include <string>
+
+namespace CesiumGltfReader {
+
+ExtensionBufferViewExtMeshoptCompressionJsonHandler::
+    ExtensionBufferViewExtMeshoptCompressionJsonHandler(
+        const CesiumJsonReader::ExtensionReaderContext& context) noexcept
+    : CesiumJsonReader::ExtensibleObjectJsonHandler(context),
+      _buffer(),
+      _byteOffset(),
+      _byteLength(),
+      _byteStride(),
+      _count(),
+      _mode(),
+      _filter() {}
+
+void ExtensionBufferViewExtMeshoptCompressionJsonHandler::reset(
+    CesiumJsonReader::IJsonHandler* pParentHandler,
+    CesiumGltf::ExtensionBufferViewExtMeshoptCompression* pObject) {
+  CesiumJsonReader::ExtensibleObjectJsonHandler::reset(pParentHandler, pObject);
+  this->_pObject = pObject;
+}
+
+CesiumJsonReader::IJsonHandler*
+ExtensionBufferViewExtMeshoptCompressionJsonHandler::readObjectKey(
+    const std::string_view& str) {
+  assert(this->_pObject);
+  return this->readObjectKeyExtensionBufferViewExtMeshoptCompression(
+      CesiumGltf::ExtensionBufferViewExtMeshoptCompression::TypeName,
+      str,
+      *this->_pObject);
+}
+
+void ExtensionBufferViewExtMeshoptCompressionJsonHandler::reset(
+    CesiumJsonReader::IJsonHandler* pParentHandler,
+    CesiumUtility::ExtensibleObject& o,
+    const std::string_view& extensionName) {
+  std::any& value =
+      o.extensions
+          .emplace(
+              extensionName,
+              CesiumGltf::ExtensionBufferViewExtMeshoptCompression())
+          .first->second;
+  this->reset(
+      pParentHandler,
+      &std::any_cast<CesiumGltf::ExtensionBufferViewExtMeshoptCompression&>(
+          value));
+}
+
+CesiumJsonReader::IJsonHandler*
+ExtensionBufferViewExtMeshoptCompressionJsonHandler::
+    readObjectKeyExtensionBufferViewExtMeshoptCompression(
+        const std::string& objectType,
+        const std::string_view& str,
+        CesiumGltf::ExtensionBufferViewExtMeshoptCompression& o) {
+  using namespace std::string_literals;
+
+  if ("buffer"s == str)
+    return property("buffer", this->_buffer, o.buffer);
+  if ("byteOffset"s == str)
+    return property("byteOffset", this->_byteOffset, o.byteOffset);
+  if ("byteLength"s == str)
+    return property("byteLength", this->_byteLength, o.byteLength);
+  if ("byteStride"s == str)
+    return property("byteStride", this->_byteStride, o.byteStride);
+  if ("count"s == str)
+    return property("count", this->_count, o.count);
+  if ("mode"s == str)
+    return property("mode", this->_mode, o.mode);
+  if ("filter"s == str)
+    return property("filter", this->_filter, o.filter);
+
+  return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
+}
+
+} // namespace CesiumGltfReader
+// This file was generated by generate-classes.
+// DO NOT EDIT THIS FILE!
+#include "ExtensionBufferExtMeshoptCompressionJsonHandler.h"
+
+#include <CesiumGltf/ExtensionBufferExtMeshoptCompression.h>
+
+#include <cassert>
+#include <string>
+
+namespace CesiumGltfReader {
+
+ExtensionBufferExtMeshoptCompressionJsonHandler::
+    ExtensionBufferExtMeshoptCompressionJsonHandler(
+        const CesiumJsonReader::ExtensionReaderContext& context) noexcept
+    : CesiumJsonReader::ExtensibleObjectJsonHandler(context),
+      _fallback() {}
+
+void ExtensionBufferExtMeshoptCompressionJsonHandler::reset(
+    CesiumJsonReader::IJsonHandler* pParentHandler,
+    CesiumGltf::ExtensionBufferExtMeshoptCompression* pObject) {
+  CesiumJsonReader::ExtensibleObjectJsonHandler::reset(pParentHandler, pObject);
+  this->_pObject = pObject;
+}
+
+CesiumJsonReader::IJsonHandler*
+ExtensionBufferExtMeshoptCompressionJsonHandler::readObjectKey(
+    const std::string_view& str) {
+  assert(this->_pObject);
+  return this->readObjectKeyExtensionBufferExtMeshoptCompression(
+      CesiumGltf::ExtensionBufferExtMeshoptCompression::TypeName,
+      str,
+      *this->_pObject);
+}
+
+void ExtensionBufferExtMeshoptCompressionJsonHandler::reset(
+    CesiumJsonReader::IJsonHandler* pParentHandler,
+    CesiumUtility::ExtensibleObject& o,
+    const std::string_view& extensionName) {
+  std::any& value =
+      o.extensions
+          .emplace(
+              extensionName,
+              CesiumGltf::ExtensionBufferExtMeshoptCompression())
+          .first->second;
+  this->reset(
+      pParentHandler,
+      &std::any_cast<CesiumGltf::ExtensionBufferExtMeshoptCompression&>(
+          value));
+}
+
+CesiumJsonReader::IJsonHandler*
+ExtensionBufferExtMeshoptCompressionJsonHandler::
+    readObjectKeyExtensionBufferExtMeshoptCompression(
+        const std::string& objectType,
+        const std::string_view& str,
+        CesiumGltf::ExtensionBufferExtMeshoptCompression& o) {
+  using namespace std::string_literals;
+
+  if ("fallback"s == str)
+    return property("fallback", this->_fallback, o.fallback);
+
+  return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
+}
+
 } // namespace CesiumGltfReader
 // This file was generated by generate-classes.
 // DO NOT EDIT THIS FILE!
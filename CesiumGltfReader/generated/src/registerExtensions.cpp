@@ -3,12 +3,18 @@
 
 #include "registerExtensions.h"
 
+#include "ExtensionBufferExtMeshoptCompressionJsonHandler.h"
+#include "ExtensionBufferViewExtMeshoptCompressionJsonHandler.h"
 #include "ExtensionKhrDracoMeshCompressionJsonHandler.h"
+#include "ExtensionKhrTextureBasisuJsonHandler.h"
 #include "ExtensionMeshPrimitiveExtFeatureMetadataJsonHandler.h"
 #include "ExtensionModelExtFeatureMetadataJsonHandler.h"
 
+#include <CesiumGltf/Buffer.h>
+#include <CesiumGltf/BufferView.h>
 #include <CesiumGltf/MeshPrimitive.h>
 #include <CesiumGltf/Model.h>
+#include <CesiumGltf/Texture.h>
 #include <CesiumJsonReader/ExtensionReaderContext.h>
 
 namespace CesiumGltfReader {
@@ -24,5 +30,14 @@ void registerExtensions(CesiumJsonReader::ExtensionReaderContext& context) {
   context.registerExtension<
       CesiumGltf::Model,
       ExtensionModelExtFeatureMetadataJsonHandler>();
+  context.registerExtension<
+      CesiumGltf::Texture,
+      ExtensionKhrTextureBasisuJsonHandler>();
+  context.registerExtension<
+      CesiumGltf::BufferView,
+      ExtensionBufferViewExtMeshoptCompressionJsonHandler>();
+  context.registerExtension<
+      CesiumGltf::Buffer,
+      ExtensionBufferExtMeshoptCompressionJsonHandler>();
 }
 } // namespace CesiumGltfReader
@@ -65,6 +65,71 @@ struct CESIUMGLTFREADER_API ImageReaderResult {
   std::vector<std::string> warnings;
 };
 
+/**
+ * @brief The block-compressed formats that the renderer can use directly for
+ * images read from KTX2 files.
+ *
+ * KTX2 images that are already block-compressed in a supported format are
+ * passed through unchanged, with all of their mip levels. Images in an
+ * unsupported BC1, BC3, BC4 or BC5 format are decoded to 8-bit RGBA instead,
+ * and images in any other unsupported format fail to load.
+ *
+ * Basis Universal images, as used by `KHR_texture_basisu`, are transcoded to
+ * the best supported format: ASTC 4x4 for UASTC images and ETC2 for ETC1S
+ * images if available, then BC7, then ETC2 or BC1/BC3, and 8-bit RGBA if none
+ * of these is supported. See
+ * {@link CesiumGltf::ImageCesium::compressedPixelFormat}.
+ */
+struct CESIUMGLTFREADER_API Ktx2TranscodeTargets {
+  /**
+   * @brief Whether {@link CesiumGltf::GpuCompressedPixelFormat::Etc2Rgb} is
+   * supported.
+   */
+  bool etc2Rgb = false;
+
+  /**
+   * @brief Whether {@link CesiumGltf::GpuCompressedPixelFormat::Etc2Rgba} is
+   * supported.
+   */
+  bool etc2Rgba = false;
+
+  /**
+   * @brief Whether {@link CesiumGltf::GpuCompressedPixelFormat::Bc1Rgb} is
+   * supported.
+   */
+  bool bc1Rgb = false;
+
+  /**
+   * @brief Whether {@link CesiumGltf::GpuCompressedPixelFormat::Bc3Rgba} is
+   * supported.
+   */
+  bool bc3Rgba = false;
+
+  /**
+   * @brief Whether {@link CesiumGltf::GpuCompressedPixelFormat::Bc4R} is
+   * supported.
+   */
+  bool bc4R = false;
+
+  /**
+   * @brief Whether {@link CesiumGltf::GpuCompressedPixelFormat::Bc5Rg} is
+   * supported.
+   */
+  bool bc5Rg = false;
+
+  /**
+   * @brief Whether {@link CesiumGltf::GpuCompressedPixelFormat::Bc7Rgba} is
+   * supported.
+   */
+  bool bc7Rgba = false;
+
+  /**
+   * @brief Whether {@link CesiumGltf::GpuCompressedPixelFormat::Astc4x4Rgba}
+   * is supported.
+   */
+  bool astc4x4Rgba = false;
+};
+
 /**
  * @brief Options for how to read a glTF.
  */
@@ -90,14 +155,59 @@ struct CESIUMGLTFREADER_API ReadModelOptions {
    * The {@link ImageSpec::mimeType} property is ignored, and instead the
    * [stb_image](https://github.com/nothings/stb) library is used to decode
    * images in `JPG`, `PNG`, `TGA`, `BMP`, `PSD`, `GIF`, `HDR`, or `PIC` format.
+   *
+   * If this is `false`, the images can be decoded later, only when they are
+   * actually needed, with {@link GltfReader::decodeEmbeddedImages} or
+   * {@link GltfReader::readEmbeddedImage}.
    */
   bool decodeEmbeddedImages = true;
 
+  /**
+   * @brief Whether to generate mip levels for the images decoded as part of
+   * the load process.
+   *
+   * The mip levels are stored in the {@link CesiumGltf::ImageCesium::pixelData}
+   * of each image, after the full-size image, and described by
+   * {@link CesiumGltf::ImageCesium::mipPositions}. This lets a renderer upload
+   * the whole mip chain with a single copy instead of generating it on its
+   * render thread. Only 8-bit RGBA images, which is what the load process
+   * decodes, are supported. See {@link ImageManipulation::generateMipMaps}.
+   */
+  bool generateMipMaps = false;
+
+  /**
+   * @brief The block-compressed formats that KTX2 images, such as those used
+   * by the `KHR_texture_basisu` extension, may be kept in.
+   */
+  Ktx2TranscodeTargets ktx2TranscodeTargets;
+
   /**
    * @brief Whether geometry compressed using the `KHR_draco_mesh_compression`
    * extension should be automatically decoded as part of the load process.
    */
   bool decodeDraco = true;
+
+  /**
+   * @brief Whether buffer views compressed using the
+   * `EXT_meshopt_compression` extension should be automatically decoded as
+   * part of the load process.
+   *
+   * The data is decoded straight into the buffers that the buffer views refer
+   * to, so accessors can use it without any changes. Compressed data in
+   * external buffers is only available after
+   * {@link GltfReader::resolveExternalData}, so it is not decoded.
+   */
+  bool decodeMeshopt = true;
+
+  /**
+   * @brief The async system whose worker threads may be used to decode the
+   * images and Draco-compressed geometry of the model in parallel.
+   *
+   * If this is `std::nullopt`, the model is decoded entirely on the calling
+   * thread. Otherwise, the calling thread still takes part in the work and
+   * the read function only returns once decoding is complete.
+   */
+  std::optional<CesiumAsync::AsyncSystem> asyncSystem;
 };
 
 /**
@@ -143,13 +253,17 @@ public:
    * @param pAssetAccessor The asset accessor to use to request the external
    * buffers and images.
    * @param result The result of the synchronous readModel invocation.
+   * @param ktx2TranscodeTargets The block-compressed formats that external
+   * KTX2 images may be kept in.
    */
   static CesiumAsync::Future<ModelReaderResult> resolveExternalData(
       CesiumAsync::AsyncSystem asyncSystem,
       const std::string& baseUrl,
       const CesiumAsync::HttpHeaders& headers,
       std::shared_ptr<CesiumAsync::IAssetAccessor> pAssetAccessor,
-      ModelReaderResult&& result);
+      ModelReaderResult&& result,
+      const Ktx2TranscodeTargets& ktx2TranscodeTargets =
+          Ktx2TranscodeTargets());
 
   /**
    * @brief Reads an image from a buffer.
@@ -157,10 +271,60 @@ public:
    * The [stb_image](https://github.com/nothings/stb) library is used to decode
    * images in `JPG`, `PNG`, `TGA`, `BMP`, `PSD`, `GIF`, `HDR`, or `PIC` format.
    *
+   * Images in `KTX2` format are read without stb_image. They may be 8-bit
+   * RGBA, block-compressed, or compressed with Basis Universal, in which case
+   * they are transcoded with the
+   * [Basis Universal](https://github.com/BinomialLLC/basis_universal)
+   * transcoder. See {@link Ktx2TranscodeTargets}.
+   *
    * @param data The buffer from which to read the image.
+   * @param ktx2TranscodeTargets The block-compressed formats that a `KTX2`
+   * image may be kept in.
+   * @return The result of reading the image.
+   */
+  static ImageReaderResult readImage(
+      const gsl::span<const std::byte>& data,
+      const Ktx2TranscodeTargets& ktx2TranscodeTargets =
+          Ktx2TranscodeTargets());
+
+  /**
+   * @brief Decodes the images embedded in the buffers of a model that was read
+   * with {@link ReadModelOptions::decodeEmbeddedImages} set to `false`.
+   *
+   * Images that already have pixel data are left unchanged. Errors and
+   * warnings are added to the given result.
+   *
+   * @param readModel The result of reading the model.
+   * @param asyncSystem The async system whose worker threads may be used to
+   * decode the images in parallel, or `std::nullopt` to decode them on the
+   * calling thread.
+   * @param ktx2TranscodeTargets The block-compressed formats that `KTX2`
+   * images may be kept in.
+   */
+  static void decodeEmbeddedImages(
+      ModelReaderResult& readModel,
+      const std::optional<CesiumAsync::AsyncSystem>& asyncSystem = std::nullopt,
+      const Ktx2TranscodeTargets& ktx2TranscodeTargets =
+          Ktx2TranscodeTargets());
+
+  /**
+   * @brief Decodes a single image embedded in a buffer of a model, without
+   * modifying the model.
+   *
+   * This allows a renderer to decode only the images that it actually uses,
+   * at the time it needs them.
+   *
+   * @param model The model that contains the image.
+   * @param image The image to decode.
+   * @param ktx2TranscodeTargets The block-compressed formats that a `KTX2`
+   * image may be kept in.
    * @return The result of reading the image.
    */
-  static ImageReaderResult readImage(const gsl::span<const std::byte>& data);
+  static ImageReaderResult readEmbeddedImage(
+      const CesiumGltf::Model& model,
+      const CesiumGltf::Image& image,
+      const Ktx2TranscodeTargets& ktx2TranscodeTargets =
+          Ktx2TranscodeTargets());
 
 private:
   CesiumJsonReader::ExtensionReaderContext _context;
@@ -2,6 +2,8 @@
 
 #include "CesiumGltfReader/Library.h"
 
+#include <CesiumGltf/GpuCompressedPixelFormat.h>
+
 #include <cstddef>
 #include <cstdint>
 
@@ -63,6 +65,133 @@ public:
       size_t sourceHeight,
       size_t bytesPerPixel);
 
+  /**
+   * @brief Halves an 8-bit RGBA image in both directions with a 2x2 box
+   * filter, without validating the provided pointers or ranges.
+   *
+   * The target is `max(1, sourceWidth / 2)` by `max(1, sourceHeight / 2)`
+   * pixels. When a source dimension is odd, its last row or column is ignored.
+   *
+   * @param pTarget The pointer at which to start writing pixels.
+   * @param targetRowStride The number of bytes between rows in the target
+   * image.
+   * @param pSource The pointer at which to start reading pixels.
+   * @param sourceRowStride The number of bytes between rows in the source
+   * image.
+   * @param sourceWidth The width of the source image, in pixels.
+   * @param sourceHeight The height of the source image, in pixels.
+   */
+  static void unsafeDownsampleRgba8(
+      std::byte* pTarget,
+      size_t targetRowStride,
+      const std::byte* pSource,
+      size_t sourceRowStride,
+      size_t sourceWidth,
+      size_t sourceHeight);
+
+  /**
+   * @brief Resamples an 8-bit RGBA image to a new size with bilinear
+   * filtering, without validating the provided pointers or ranges.
+   *
+   * Bilinear filtering is only a good choice for enlarging images or for
+   * reducing them by no more than half, because it ignores the source pixels
+   * between the four nearest ones.
+   *
+   * @param pTarget The pointer at which to start writing pixels.
+   * @param targetRowStride The number of bytes between rows in the target
+   * image.
+   * @param targetWidth The number of pixels to write in the horizontal
+   * direction.
+   * @param targetHeight The number of pixels to write in the vertical
+   * direction.
+   * @param pSource The pointer at which to start reading pixels.
+   * @param sourceRowStride The number of bytes between rows in the source
+   * image.
+   * @param sourceWidth The number of pixels to read in the horizontal
+   * direction.
+   * @param sourceHeight The number of pixels to read in the vertical
+   * direction.
+   */
+  static void unsafeResampleRgba8(
+      std::byte* pTarget,
+      size_t targetRowStride,
+      size_t targetWidth,
+      size_t targetHeight,
+      const std::byte* pSource,
+      size_t sourceRowStride,
+      size_t sourceWidth,
+      size_t sourceHeight);
+
+  /**
+   * @brief Computes the number of bytes needed for an image and all of its mip
+   * levels, down to 1x1 pixels.
+   *
+   * Each mip level is half the size of the previous one in each direction,
+   * rounded down, but at least one pixel. The levels are tightly packed.
+   *
+   * @param width The width of the image, in pixels.
+   * @param height The height of the image, in pixels.
+   * @param bytesPerPixel The number of bytes used to represent each pixel.
+   * @return The number of bytes, or 0 if the image has no pixels.
+   */
+  static size_t computeMipChainByteSize(
+      size_t width,
+      size_t height,
+      size_t bytesPerPixel) noexcept;
+
+  /**
+   * @brief Generates all mip levels of an 8-bit RGBA image with a 2x2 box
+   * filter, without validating the provided pointers or ranges.
+   *
+   * The tightly-packed image must be at the start of `pPixels`, and there
+   * must be room for {@link computeMipChainByteSize} bytes in total. Each
+   * level is written directly after the previous one.
+   *
+   * @param pPixels The image, followed by room for its mip levels.
+   * @param width The width of the image, in pixels.
+   * @param height The height of the image, in pixels.
+   */
+  static void
+  unsafeGenerateMipChainRgba8(std::byte* pPixels, size_t width, size_t height);
+
+  /**
+   * @brief Generates all mip levels of an image and stores them in its
+   * {@link CesiumGltf::ImageCesium::pixelData}, after the full-size image.
+   *
+   * The byte range of each level is recorded in
+   * {@link CesiumGltf::ImageCesium::mipPositions}. Only uncompressed images
+   * with 4 channels of 1 byte each are supported.
+   *
+   * @param image The image.
+   * @returns True if the image now has mip levels, or false if the image
+   * already had mip levels, has an unsupported format, or has too little
+   * pixel data. In that case the image is left unchanged.
+   */
+  static bool generateMipMaps(CesiumGltf::ImageCesium& image);
+
+  /**
+   * @brief Compresses an 8-bit RGBA image, including any mip levels, to a
+   * GPU block-compressed format.
+   *
+   * This uses the [stb_dxt](https://github.com/nothings/stb) encoder, so only
+   * {@link CesiumGltf::GpuCompressedPixelFormat::Bc1Rgb} and
+   * {@link CesiumGltf::GpuCompressedPixelFormat::Bc3Rgba} are supported. BC1
+   * discards the alpha channel and needs an eighth of the memory of the
+   * uncompressed image, BC3 keeps it and needs a quarter. Mip levels should be
+   * generated before compressing, because compressed images can't be
+   * resampled.
+   *
+   * @param image The image, whose pixels and mip positions are replaced with
+   * the compressed ones.
+   * @param format The block-compressed format.
+   * @returns True if the image was compressed, or false if the format is not
+   * supported or the image is not an uncompressed 8-bit RGBA image with
+   * enough pixel data. In that case the image is left unchanged.
+   */
+  static bool compressBlocks(
+      CesiumGltf::ImageCesium& image,
+      CesiumGltf::GpuCompressedPixelFormat format);
+
   /**
    * @brief Copies pixels from a source image to a target image.
    *
@@ -71,12 +200,15 @@ public:
    * the target rectangle.
    *
    * The filtering algorithm for scaling is not specified, but can be assumed
-   * to provide reasonably good quality.
+   * to provide reasonably good quality. 8-bit RGBA images that are enlarged,
+   * or reduced by no more than half, use the SIMD kernels of
+   * {@link unsafeDownsampleRgba8} and {@link unsafeResampleRgba8}.
    *
-   * The source and target images must have the same number of channels and same
-   * bytes per channel. If scaling is required, they must also use exactly 1
-   * byte per channel. If any of these requirements are violated, this function
-   * will return false and will not change any target pixels.
+   * The source and target images must not be block-compressed, and must have
+   * the same number of channels and same bytes per channel. If scaling is
+   * required, they must also use exactly 1 byte per channel. If any of these
+   * requirements are violated, this function will return false and will not
+   * change any target pixels.
    *
    * The provided rectangles are validated to ensure that they fall within the
    * range of the images. If they do not, this function will return false and
@@ -1,8 +1,13 @@
 #include "CesiumGltfReader/GltfReader.h"
 
+#include "CesiumGltfReader/ImageManipulation.h"
+
 #include "ModelJsonHandler.h"
 #include "decodeDataUrls.h"
 #include "decodeDraco.h"
+#include "decodeMeshopt.h"
+#include "parallelFor.h"
+#include "readKtx2.h"
 #include "registerExtensions.h"
 
 #include <CesiumAsync/IAssetRequest.h>
@@ -213,68 +218,144 @@ ModelReaderResult readBinaryModel(
   return result;
 }
 
+std::optional<gsl::span<const std::byte>> getEmbeddedImageData(
+    const Model& model,
+    const Image& image,
+    std::vector<std::string>& warnings) {
+  // Ignore external images for now, as well as images that were decoded from
+  // a data URL and therefore have no buffer view.
+  if (image.uri || image.bufferView < 0) {
+    return std::nullopt;
+  }
+
+  const BufferView& bufferView =
+      Model::getSafe(model.bufferViews, image.bufferView);
+  const Buffer& buffer = Model::getSafe(model.buffers, bufferView.buffer);
+
+  if (bufferView.byteOffset + bufferView.byteLength >
+      static_cast<int64_t>(buffer.cesium.data.size())) {
+    warnings.emplace_back(
+        "Image bufferView's byte offset is " +
+        std::to_string(bufferView.byteOffset) + " and the byteLength is " +
+        std::to_string(bufferView.byteLength) + ", the result is " +
+        std::to_string(bufferView.byteOffset + bufferView.byteLength) +
+        ", which is more than the available " +
+        std::to_string(buffer.cesium.data.size()) + " bytes.");
+    return std::nullopt;
+  }
+
+  const gsl::span<const std::byte> bufferSpan(buffer.cesium.data);
+  return bufferSpan.subspan(
+      static_cast<size_t>(bufferView.byteOffset),
+      static_cast<size_t>(bufferView.byteLength));
+}
+
+void addImageResult(
+    ModelReaderResult& readModel,
+    Image& image,
+    ImageReaderResult&& imageResult) {
+  readModel.warnings.insert(
+      readModel.warnings.end(),
+      imageResult.warnings.begin(),
+      imageResult.warnings.end());
+  readModel.errors.insert(
+      readModel.errors.end(),
+      imageResult.errors.begin(),
+      imageResult.errors.end());
+  if (imageResult.image) {
+    image.cesium = std::move(imageResult.image.value());
+  } else {
+    if (image.mimeType) {
+      readModel.errors.emplace_back(
+          "Declared image MIME Type: " + image.mimeType.value());
+    } else {
+      readModel.errors.emplace_back("Image does not declare a MIME Type");
+    }
+  }
+}
+
+void decodeEmbeddedImages(
+    ModelReaderResult& readModel,
+    const std::optional<AsyncSystem>& asyncSystem,
+    const Ktx2TranscodeTargets& ktx2TranscodeTargets) {
+  Model& model = readModel.model.value();
+
+  CESIUM_TRACE("CesiumGltf::decodeEmbeddedImages");
+
+  // Find the image data serially, then decode all images at once.
+  std::vector<Image*> images;
+  std::vector<gsl::span<const std::byte>> imageData;
+  for (Image& image : model.images) {
+    if (!image.cesium.pixelData.empty()) {
+      continue;
+    }
+
+    std::optional<gsl::span<const std::byte>> data =
+        getEmbeddedImageData(model, image, readModel.warnings);
+    if (data) {
+      images.emplace_back(&image);
+      imageData.emplace_back(*data);
+    }
+  }
+
+  std::vector<ImageReaderResult> imageResults(images.size());
+  parallelFor(
+      asyncSystem,
+      images.size(),
+      [&imageData, &imageResults, &ktx2TranscodeTargets](size_t i) {
+        imageResults[i] =
+            GltfReader::readImage(imageData[i], ktx2TranscodeTargets);
+      });
+
+  for (size_t i = 0; i < images.size(); ++i) {
+    addImageResult(readModel, *images[i], std::move(imageResults[i]));
+  }
+}
+
+void generateMipMaps(
+    ModelReaderResult& readModel,
+    const std::optional<AsyncSystem>& asyncSystem) {
+  Model& model = readModel.model.value();
+
+  CESIUM_TRACE("CesiumGltf::generateMipMaps");
+
+  parallelFor(asyncSystem, model.images.size(), [&model](size_t i) {
+    ImageCesium& image = model.images[i].cesium;
+    if (!image.pixelData.empty()) {
+      ImageManipulation::generateMipMaps(image);
+    }
+  });
+}
+
 void postprocess(
     const GltfReader& reader,
     ModelReaderResult& readModel,
     const ReadModelOptions& options) {
-  CesiumGltf::Model& model = readModel.model.value();
-
   if (options.decodeDataUrls) {
-    decodeDataUrls(reader, readModel, options.clearDecodedDataUrls);
+    decodeDataUrls(
+        reader,
+        readModel,
+        options.clearDecodedDataUrls,
+        options.ktx2TranscodeTargets);
   }
 
   if (options.decodeEmbeddedImages) {
-    CESIUM_TRACE("CesiumGltf::decodeEmbeddedImages");
-    for (Image& image : model.images) {
-      // Ignore external images for now.
-      if (image.uri) {
-        continue;
-      }
-
-      const BufferView& bufferView =
-          Model::getSafe(model.bufferViews, image.bufferView);
-      const Buffer& buffer = Model::getSafe(model.buffers, bufferView.buffer);
-
-      if (bufferView.byteOffset + bufferView.byteLength >
-          static_cast<int64_t>(buffer.cesium.data.size())) {
-        readModel.warnings.emplace_back(
-            "Image bufferView's byte offset is " +
-            std::to_string(bufferView.byteOffset) + " and the byteLength is " +
-            std::to_string(bufferView.byteLength) + ", the result is " +
-            std::to_string(bufferView.byteOffset + bufferView.byteLength) +
-            ", which is more than the available " +
-            std::to_string(buffer.cesium.data.size()) + " bytes.");
-        continue;
-      }
-
-      const gsl::span<const std::byte> bufferSpan(buffer.cesium.data);
-      const gsl::span<const std::byte> bufferViewSpan = bufferSpan.subspan(
-          static_cast<size_t>(bufferView.byteOffset),
-          static_cast<size_t>(bufferView.byteLength));
-      ImageReaderResult imageResult = reader.readImage(bufferViewSpan);
-      readModel.warnings.insert(
-          readModel.warnings.end(),
-          imageResult.warnings.begin(),
-          imageResult.warnings.end());
-      readModel.errors.insert(
-          readModel.errors.end(),
-          imageResult.errors.begin(),
-          imageResult.errors.end());
-      if (imageResult.image) {
-        image.cesium = std::move(imageResult.image.value());
-      } else {
-        if (image.mimeType) {
-          readModel.errors.emplace_back(
-              "Declared image MIME Type: " + image.mimeType.value());
-        } else {
-          readModel.errors.emplace_back("Image does not declare a MIME Type");
-        }
-      }
-    }
+    decodeEmbeddedImages(
+        readModel,
+        options.asyncSystem,
+        options.ktx2TranscodeTargets);
+  }
+
+  if (options.generateMipMaps) {
+    generateMipMaps(readModel, options.asyncSystem);
+  }
+
+  if (options.decodeMeshopt) {
+    decodeMeshopt(readModel, options.asyncSystem);
   }
 
   if (options.decodeDraco) {
-    decodeDraco(readModel);
+    decodeDraco(readModel, options.asyncSystem);
   }
 }
 
@@ -313,7 +394,8 @@ Future<ModelReaderResult> GltfReader::resolveExternalData(
     const std::string& baseUrl,
     const HttpHeaders& headers,
     std::shared_ptr<IAssetAccessor> pAssetAccessor,
-    ModelReaderResult&& result) {
+    ModelReaderResult&& result,
+    const Ktx2TranscodeTargets& ktx2TranscodeTargets) {
 
   // TODO: Can we avoid this copy conversion?
   std::vector<IAssetAccessor::THeader> tHeaders(headers.begin(), headers.end());
@@ -392,7 +474,8 @@ Future<ModelReaderResult> GltfReader::resolveExternalData(
                   Uri::resolve(baseUrl, *image.uri),
                   tHeaders)
               .thenInWorkerThread(
-                  [pImage = &image](std::shared_ptr<IAssetRequest>&& pRequest) {
+                  [pImage = &image, ktx2TranscodeTargets](
+                      std::shared_ptr<IAssetRequest>&& pRequest) {
                     const IAssetResponse* pResponse = pRequest->response();
 
                     std::string imageUri = *pImage->uri;
@@ -401,7 +484,7 @@ Future<ModelReaderResult> GltfReader::resolveExternalData(
                       pImage->uri = std::nullopt;
 
                       ImageReaderResult imageResult =
-                          readImage(pResponse->data());
+                          readImage(pResponse->data(), ktx2TranscodeTargets);
                       if (imageResult.image) {
                         pImage->cesium = std::move(*imageResult.image);
                         return ExternalBufferLoadResult{true, imageUri};
@@ -428,11 +511,42 @@ Future<ModelReaderResult> GltfReader::resolveExternalData(
           });
 }
 
+/*static*/ void GltfReader::decodeEmbeddedImages(
+    ModelReaderResult& readModel,
+    const std::optional<CesiumAsync::AsyncSystem>& asyncSystem,
+    const Ktx2TranscodeTargets& ktx2TranscodeTargets) {
+  if (!readModel.model) {
+    return;
+  }
+
+  ::decodeEmbeddedImages(readModel, asyncSystem, ktx2TranscodeTargets);
+}
+
+/*static*/ ImageReaderResult GltfReader::readEmbeddedImage(
+    const CesiumGltf::Model& model,
+    const CesiumGltf::Image& image,
+    const Ktx2TranscodeTargets& ktx2TranscodeTargets) {
+  ImageReaderResult result;
+  std::optional<gsl::span<const std::byte>> data =
+      getEmbeddedImageData(model, image, result.warnings);
+  if (!data) {
+    result.errors.emplace_back("Image is not embedded in a buffer view.");
+    return result;
+  }
+
+  return readImage(*data, ktx2TranscodeTargets);
+}
+
 /*static*/
-ImageReaderResult
-GltfReader::readImage(const gsl::span<const std::byte>& data) {
+ImageReaderResult GltfReader::readImage(
+    const gsl::span<const std::byte>& data,
+    const Ktx2TranscodeTargets& ktx2TranscodeTargets) {
   CESIUM_TRACE("CesiumGltfReader::readImage");
 
+  if (isKtx2(data)) {
+    return readKtx2(data, ktx2TranscodeTargets);
+  }
+
   ImageReaderResult result;
 
   result.image.emplace();
@@ -450,18 +564,14 @@ GltfReader::readImage(const gsl::span<const std::byte>& data) {
       &channelsInFile,
       image.channels);
   if (pImage) {
-    CESIUM_TRACE(
-        "copy image " + std::to_string(image.width) + "x" +
-        std::to_string(image.height) + "x" + std::to_string(image.channels) +
-        "x" + std::to_string(image.bytesPerChannel));
+    CESIUM_TRACE("copy image");
     // std::uint8_t is not implicitly convertible to std::byte, so we must use
-    // reinterpret_cast to (safely) force the conversion.
+    // reinterpret_cast to (safely) force the conversion. Assigning the range
+    // directly avoids zero-filling the pixel data before copying into it.
     const auto lastByte =
         image.width * image.height * image.channels * image.bytesPerChannel;
-    image.pixelData.resize(static_cast<std::size_t>(lastByte));
-    std::uint8_t* u8Pointer =
-        reinterpret_cast<std::uint8_t*>(image.pixelData.data());
-    std::copy(pImage, pImage + lastByte, u8Pointer);
+    const std::byte* pBytes = reinterpret_cast<const std::byte*>(pImage);
+    image.pixelData.assign(pBytes, pBytes + lastByte);
     stbi_image_free(pImage);
   } else {
     result.image.reset();
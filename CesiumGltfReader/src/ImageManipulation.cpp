@@ -2,14 +2,358 @@
 
 #include <CesiumGltf/ImageCesium.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+// SSE2 is part of x86-64, AVX2 is detected at runtime.
+#define CESIUM_IMAGE_MANIPULATION_X64
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define CESIUM_TARGET_AVX2
+#else
+#define CESIUM_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
 
 #define STB_IMAGE_RESIZE_IMPLEMENTATION
 #include <stb_image_resize.h>
 
+#define STB_DXT_IMPLEMENTATION
+#include <stb_dxt.h>
+
 namespace CesiumGltfReader {
 
+namespace {
+
+constexpr size_t rgba8BytesPerPixel = 4;
+
+// Bilinear weights are fixed-point numbers with 8 fractional bits.
+constexpr uint32_t weightOne = 256;
+
+// Each kernel below processes pixels starting at index `i`, and returns the
+// index of the first pixel it did not process. The SIMD kernels leave the
+// remainder that doesn't fill a register to the scalar ones.
+
+size_t downsampleRowScalar(
+    const uint8_t* pRow0,
+    const uint8_t* pRow1,
+    uint8_t* pTarget,
+    size_t i,
+    size_t targetWidth) {
+  for (; i < targetWidth; ++i) {
+    const uint8_t* pTop = pRow0 + 2 * rgba8BytesPerPixel * i;
+    const uint8_t* pBottom = pRow1 + 2 * rgba8BytesPerPixel * i;
+    uint8_t* pOut = pTarget + rgba8BytesPerPixel * i;
+    for (size_t c = 0; c < rgba8BytesPerPixel; ++c) {
+      const uint32_t sum = uint32_t(pTop[c]) + uint32_t(pTop[c + 4]) +
+                           uint32_t(pBottom[c]) + uint32_t(pBottom[c + 4]);
+      pOut[c] = uint8_t((sum + 2) >> 2);
+    }
+  }
+  return i;
+}
+
+size_t blendRowsScalar(
+    const uint8_t* pRow0,
+    const uint8_t* pRow1,
+    uint32_t weight,
+    uint16_t* pTarget,
+    size_t i,
+    size_t count) {
+  const uint32_t inverseWeight = weightOne - weight;
+  for (; i < count; ++i) {
+    pTarget[i] = uint16_t(
+        (uint32_t(pRow0[i]) * inverseWeight + uint32_t(pRow1[i]) * weight +
+         weightOne / 2) >>
+        8);
+  }
+  return i;
+}
+
+#ifdef CESIUM_IMAGE_MANIPULATION_X64
+
+bool hasAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7) {
+    return false;
+  }
+
+  // AVX2 also needs the OS to save the YMM registers.
+  __cpuid(info, 1);
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const bool avx = (info[2] & (1 << 28)) != 0;
+  if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) {
+    return false;
+  }
+
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+
+const bool cpuHasAvx2 = hasAvx2();
+
+// Sums each 2x2 block of the four pixels in each of two rows. Returns the two
+// sums as 16-bit channels.
+inline __m128i sumBlocksSse2(__m128i row0, __m128i row1, __m128i zero) {
+  const __m128i left = _mm_add_epi16(
+      _mm_unpacklo_epi8(row0, zero),
+      _mm_unpacklo_epi8(row1, zero));
+  const __m128i right = _mm_add_epi16(
+      _mm_unpackhi_epi8(row0, zero),
+      _mm_unpackhi_epi8(row1, zero));
+  return _mm_unpacklo_epi64(
+      _mm_add_epi16(left, _mm_srli_si128(left, 8)),
+      _mm_add_epi16(right, _mm_srli_si128(right, 8)));
+}
+
+size_t downsampleRowSse2(
+    const uint8_t* pRow0,
+    const uint8_t* pRow1,
+    uint8_t* pTarget,
+    size_t i,
+    size_t targetWidth) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i two = _mm_set1_epi16(2);
+  for (; i + 4 <= targetWidth; i += 4) {
+    const uint8_t* pTop = pRow0 + 2 * rgba8BytesPerPixel * i;
+    const uint8_t* pBottom = pRow1 + 2 * rgba8BytesPerPixel * i;
+    const __m128i first = sumBlocksSse2(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pTop)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBottom)),
+        zero);
+    const __m128i second = sumBlocksSse2(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pTop + 16)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBottom + 16)),
+        zero);
+    const __m128i result = _mm_packus_epi16(
+        _mm_srli_epi16(_mm_add_epi16(first, two), 2),
+        _mm_srli_epi16(_mm_add_epi16(second, two), 2));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(pTarget + rgba8BytesPerPixel * i),
+        result);
+  }
+  return i;
+}
+
+CESIUM_TARGET_AVX2 inline __m256i
+sumBlocksAvx2(__m256i row0, __m256i row1, __m256i zero) {
+  const __m256i left = _mm256_add_epi16(
+      _mm256_unpacklo_epi8(row0, zero),
+      _mm256_unpacklo_epi8(row1, zero));
+  const __m256i right = _mm256_add_epi16(
+      _mm256_unpackhi_epi8(row0, zero),
+      _mm256_unpackhi_epi8(row1, zero));
+  return _mm256_unpacklo_epi64(
+      _mm256_add_epi16(left, _mm256_srli_si256(left, 8)),
+      _mm256_add_epi16(right, _mm256_srli_si256(right, 8)));
+}
+
+CESIUM_TARGET_AVX2 size_t downsampleRowAvx2(
+    const uint8_t* pRow0,
+    const uint8_t* pRow1,
+    uint8_t* pTarget,
+    size_t i,
+    size_t targetWidth) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i two = _mm256_set1_epi16(2);
+  for (; i + 8 <= targetWidth; i += 8) {
+    const uint8_t* pTop = pRow0 + 2 * rgba8BytesPerPixel * i;
+    const uint8_t* pBottom = pRow1 + 2 * rgba8BytesPerPixel * i;
+    const __m256i first = sumBlocksAvx2(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pTop)),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBottom)),
+        zero);
+    const __m256i second = sumBlocksAvx2(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pTop + 32)),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBottom + 32)),
+        zero);
+    // Packing works within each 128-bit lane, so the pixels come out as
+    // 0 1 4 5 2 3 6 7 and need to be put back in order.
+    const __m256i packed = _mm256_packus_epi16(
+        _mm256_srli_epi16(_mm256_add_epi16(first, two), 2),
+        _mm256_srli_epi16(_mm256_add_epi16(second, two), 2));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(pTarget + rgba8BytesPerPixel * i),
+        _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+  }
+  return i;
+}
+
+size_t blendRowsSse2(
+    const uint8_t* pRow0,
+    const uint8_t* pRow1,
+    uint32_t weight,
+    uint16_t* pTarget,
+    size_t i,
+    size_t count) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i half = _mm_set1_epi16(int16_t(weightOne / 2));
+  const __m128i weight0 = _mm_set1_epi16(int16_t(weightOne - weight));
+  const __m128i weight1 = _mm_set1_epi16(int16_t(weight));
+  for (; i + 16 <= count; i += 16) {
+    const __m128i top =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow0 + i));
+    const __m128i bottom =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow1 + i));
+    const __m128i low = _mm_add_epi16(
+        _mm_add_epi16(
+            _mm_mullo_epi16(_mm_unpacklo_epi8(top, zero), weight0),
+            _mm_mullo_epi16(_mm_unpacklo_epi8(bottom, zero), weight1)),
+        half);
+    const __m128i high = _mm_add_epi16(
+        _mm_add_epi16(
+            _mm_mullo_epi16(_mm_unpackhi_epi8(top, zero), weight0),
+            _mm_mullo_epi16(_mm_unpackhi_epi8(bottom, zero), weight1)),
+        half);
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(pTarget + i),
+        _mm_srli_epi16(low, 8));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(pTarget + i + 8),
+        _mm_srli_epi16(high, 8));
+  }
+  return i;
+}
+
+CESIUM_TARGET_AVX2 size_t blendRowsAvx2(
+    const uint8_t* pRow0,
+    const uint8_t* pRow1,
+    uint32_t weight,
+    uint16_t* pTarget,
+    size_t i,
+    size_t count) {
+  const __m256i half = _mm256_set1_epi16(int16_t(weightOne / 2));
+  const __m256i weight0 = _mm256_set1_epi16(int16_t(weightOne - weight));
+  const __m256i weight1 = _mm256_set1_epi16(int16_t(weight));
+  for (; i + 16 <= count; i += 16) {
+    const __m256i top = _mm256_cvtepu8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow0 + i)));
+    const __m256i bottom = _mm256_cvtepu8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow1 + i)));
+    const __m256i sum = _mm256_add_epi16(
+        _mm256_add_epi16(
+            _mm256_mullo_epi16(top, weight0),
+            _mm256_mullo_epi16(bottom, weight1)),
+        half);
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(pTarget + i),
+        _mm256_srli_epi16(sum, 8));
+  }
+  return i;
+}
+
+#endif
+
+void downsampleRow(
+    const uint8_t* pRow0,
+    const uint8_t* pRow1,
+    uint8_t* pTarget,
+    size_t targetWidth) {
+  size_t i = 0;
+#ifdef CESIUM_IMAGE_MANIPULATION_X64
+  if (cpuHasAvx2) {
+    i = downsampleRowAvx2(pRow0, pRow1, pTarget, i, targetWidth);
+  }
+  i = downsampleRowSse2(pRow0, pRow1, pTarget, i, targetWidth);
+#endif
+  downsampleRowScalar(pRow0, pRow1, pTarget, i, targetWidth);
+}
+
+void blendRows(
+    const uint8_t* pRow0,
+    const uint8_t* pRow1,
+    uint32_t weight,
+    uint16_t* pTarget,
+    size_t count) {
+  size_t i = 0;
+#ifdef CESIUM_IMAGE_MANIPULATION_X64
+  if (cpuHasAvx2) {
+    i = blendRowsAvx2(pRow0, pRow1, weight, pTarget, i, count);
+  }
+  i = blendRowsSse2(pRow0, pRow1, weight, pTarget, i, count);
+#endif
+  blendRowsScalar(pRow0, pRow1, weight, pTarget, i, count);
+}
+
+// The two source pixels and the weight of the second one for a target pixel
+// along one axis.
+struct BilinearTap {
+  size_t index0;
+  size_t index1;
+  uint32_t weight;
+};
+
+std::vector<BilinearTap>
+computeBilinearTaps(size_t targetCount, size_t sourceCount) {
+  std::vector<BilinearTap> taps(targetCount);
+  const double scale = double(sourceCount) / double(targetCount);
+  const double maximum = double(sourceCount - 1);
+  for (size_t i = 0; i < targetCount; ++i) {
+    // Align the pixel centers of the source and target.
+    const double position =
+        std::clamp((double(i) + 0.5) * scale - 0.5, 0.0, maximum);
+    const double index = std::floor(position);
+    BilinearTap& tap = taps[i];
+    tap.index0 = size_t(index);
+    tap.index1 = std::min(tap.index0 + 1, sourceCount - 1);
+    tap.weight = uint32_t(std::lround((position - index) * weightOne));
+  }
+  return taps;
+}
+
+void interpolateRow(
+    const uint16_t* pBlended,
+    const std::vector<BilinearTap>& taps,
+    uint8_t* pTarget) {
+#ifdef CESIUM_IMAGE_MANIPULATION_X64
+  const __m128i half = _mm_set1_epi32(int32_t(weightOne / 2));
+  for (const BilinearTap& tap : taps) {
+    // Interleave the channels of the two pixels to multiply each by its weight
+    // and add them in one step.
+    const __m128i pixels = _mm_unpacklo_epi16(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(
+            pBlended + rgba8BytesPerPixel * tap.index0)),
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(
+            pBlended + rgba8BytesPerPixel * tap.index1)));
+    const __m128i weights =
+        _mm_set1_epi32(int32_t((weightOne - tap.weight) | (tap.weight << 16)));
+    __m128i result = _mm_srli_epi32(
+        _mm_add_epi32(_mm_madd_epi16(pixels, weights), half),
+        8);
+    result = _mm_packs_epi32(result, result);
+    result = _mm_packus_epi16(result, result);
+    const int32_t packed = _mm_cvtsi128_si32(result);
+    std::memcpy(pTarget, &packed, sizeof(packed));
+    pTarget += rgba8BytesPerPixel;
+  }
+#else
+  for (const BilinearTap& tap : taps) {
+    const uint16_t* p0 = pBlended + rgba8BytesPerPixel * tap.index0;
+    const uint16_t* p1 = pBlended + rgba8BytesPerPixel * tap.index1;
+    for (size_t c = 0; c < rgba8BytesPerPixel; ++c) {
+      pTarget[c] = uint8_t(
+          (uint32_t(p0[c]) * (weightOne - tap.weight) +
+           uint32_t(p1[c]) * tap.weight + weightOne / 2) >>
+          8);
+    }
+    pTarget += rgba8BytesPerPixel;
+  }
+#endif
+}
+
+} // namespace
+
 void ImageManipulation::unsafeBlitImage(
     std::byte* pTarget,
     size_t targetRowStride,
@@ -34,12 +378,259 @@ void ImageManipulation::unsafeBlitImage(
   }
 }
 
+void ImageManipulation::unsafeDownsampleRgba8(
+    std::byte* pTarget,
+    size_t targetRowStride,
+    const std::byte* pSource,
+    size_t sourceRowStride,
+    size_t sourceWidth,
+    size_t sourceHeight) {
+  const size_t targetWidth = std::max(sourceWidth / 2, size_t(1));
+  const size_t targetHeight = std::max(sourceHeight / 2, size_t(1));
+
+  for (size_t j = 0; j < targetHeight; ++j) {
+    const size_t row0 = 2 * j;
+    const size_t row1 = std::min(row0 + 1, sourceHeight - 1);
+    const uint8_t* pRow0 =
+        reinterpret_cast<const uint8_t*>(pSource + row0 * sourceRowStride);
+    const uint8_t* pRow1 =
+        reinterpret_cast<const uint8_t*>(pSource + row1 * sourceRowStride);
+    uint8_t* pOut = reinterpret_cast<uint8_t*>(pTarget + j * targetRowStride);
+
+    if (sourceWidth == 1) {
+      // There is no second column to average.
+      for (size_t c = 0; c < rgba8BytesPerPixel; ++c) {
+        pOut[c] = uint8_t((uint32_t(pRow0[c]) + uint32_t(pRow1[c]) + 1) >> 1);
+      }
+    } else {
+      downsampleRow(pRow0, pRow1, pOut, targetWidth);
+    }
+  }
+}
+
+void ImageManipulation::unsafeResampleRgba8(
+    std::byte* pTarget,
+    size_t targetRowStride,
+    size_t targetWidth,
+    size_t targetHeight,
+    const std::byte* pSource,
+    size_t sourceRowStride,
+    size_t sourceWidth,
+    size_t sourceHeight) {
+  if (targetWidth == 0 || targetHeight == 0 || sourceWidth == 0 ||
+      sourceHeight == 0) {
+    return;
+  }
+
+  const std::vector<BilinearTap> columns =
+      computeBilinearTaps(targetWidth, sourceWidth);
+  const std::vector<BilinearTap> rows =
+      computeBilinearTaps(targetHeight, sourceHeight);
+
+  // Blend the two source rows of each target row first, and then blend the
+  // two pixels of each target pixel within that row.
+  const size_t sourceRowBytes = sourceWidth * rgba8BytesPerPixel;
+  std::vector<uint16_t> blended(sourceRowBytes);
+  for (size_t j = 0; j < targetHeight; ++j) {
+    const BilinearTap& row = rows[j];
+    blendRows(
+        reinterpret_cast<const uint8_t*>(
+            pSource + row.index0 * sourceRowStride),
+        reinterpret_cast<const uint8_t*>(
+            pSource + row.index1 * sourceRowStride),
+        row.weight,
+        blended.data(),
+        sourceRowBytes);
+    interpolateRow(
+        blended.data(),
+        columns,
+        reinterpret_cast<uint8_t*>(pTarget + j * targetRowStride));
+  }
+}
+
+size_t ImageManipulation::computeMipChainByteSize(
+    size_t width,
+    size_t height,
+    size_t bytesPerPixel) noexcept {
+  if (width == 0 || height == 0) {
+    return 0;
+  }
+
+  size_t result = width * height * bytesPerPixel;
+  while (width > 1 || height > 1) {
+    width = std::max(width / 2, size_t(1));
+    height = std::max(height / 2, size_t(1));
+    result += width * height * bytesPerPixel;
+  }
+
+  return result;
+}
+
+void ImageManipulation::unsafeGenerateMipChainRgba8(
+    std::byte* pPixels,
+    size_t width,
+    size_t height) {
+  if (width == 0 || height == 0) {
+    return;
+  }
+
+  std::byte* pSource = pPixels;
+  while (width > 1 || height > 1) {
+    const size_t targetWidth = std::max(width / 2, size_t(1));
+    const size_t targetHeight = std::max(height / 2, size_t(1));
+    std::byte* pTarget = pSource + width * height * rgba8BytesPerPixel;
+    unsafeDownsampleRgba8(
+        pTarget,
+        targetWidth * rgba8BytesPerPixel,
+        pSource,
+        width * rgba8BytesPerPixel,
+        width,
+        height);
+    pSource = pTarget;
+    width = targetWidth;
+    height = targetHeight;
+  }
+}
+
+bool ImageManipulation::generateMipMaps(CesiumGltf::ImageCesium& image) {
+  if (!image.mipPositions.empty() ||
+      image.compressedPixelFormat !=
+          CesiumGltf::GpuCompressedPixelFormat::None ||
+      image.channels != 4 || image.bytesPerChannel != 1 || image.width <= 0 ||
+      image.height <= 0) {
+    return false;
+  }
+
+  size_t width = size_t(image.width);
+  size_t height = size_t(image.height);
+  const size_t baseByteSize = width * height * rgba8BytesPerPixel;
+  if (image.pixelData.size() < baseByteSize) {
+    return false;
+  }
+
+  image.pixelData.resize(
+      computeMipChainByteSize(width, height, rgba8BytesPerPixel));
+  unsafeGenerateMipChainRgba8(image.pixelData.data(), width, height);
+
+  size_t byteOffset = 0;
+  for (;;) {
+    const size_t byteSize = width * height * rgba8BytesPerPixel;
+    image.mipPositions.push_back({byteOffset, byteSize});
+    byteOffset += byteSize;
+
+    if (width == 1 && height == 1) {
+      break;
+    }
+    width = std::max(width / 2, size_t(1));
+    height = std::max(height / 2, size_t(1));
+  }
+
+  return true;
+}
+
+bool ImageManipulation::compressBlocks(
+    CesiumGltf::ImageCesium& image,
+    CesiumGltf::GpuCompressedPixelFormat format) {
+  using CesiumGltf::GpuCompressedPixelFormat;
+
+  if ((format != GpuCompressedPixelFormat::Bc1Rgb &&
+       format != GpuCompressedPixelFormat::Bc3Rgba) ||
+      image.compressedPixelFormat != GpuCompressedPixelFormat::None ||
+      image.channels != 4 || image.bytesPerChannel != 1 || image.width <= 0 ||
+      image.height <= 0) {
+    return false;
+  }
+
+  // Treat an image without mip levels as a single level.
+  std::vector<CesiumGltf::ImageCesiumMipPosition> levels = image.mipPositions;
+  if (levels.empty()) {
+    levels.push_back(
+        {0,
+         size_t(image.width) * size_t(image.height) * rgba8BytesPerPixel});
+  }
+
+  size_t width = size_t(image.width);
+  size_t height = size_t(image.height);
+  size_t compressedByteSize = 0;
+  for (const CesiumGltf::ImageCesiumMipPosition& level : levels) {
+    if (level.byteSize < width * height * rgba8BytesPerPixel ||
+        level.byteOffset > image.pixelData.size() ||
+        level.byteSize > image.pixelData.size() - level.byteOffset) {
+      return false;
+    }
+    compressedByteSize +=
+        CesiumGltf::computeCompressedByteSize(format, width, height);
+    width = std::max(width / 2, size_t(1));
+    height = std::max(height / 2, size_t(1));
+  }
+
+  const bool alpha = format == GpuCompressedPixelFormat::Bc3Rgba;
+  const size_t bytesPerBlock = CesiumGltf::getBytesPerBlock(format);
+
+  std::vector<std::byte> compressed(compressedByteSize);
+  std::vector<CesiumGltf::ImageCesiumMipPosition> compressedPositions;
+  unsigned char block[16 * rgba8BytesPerPixel];
+  unsigned char* pTarget = reinterpret_cast<unsigned char*>(compressed.data());
+
+  width = size_t(image.width);
+  height = size_t(image.height);
+  for (const CesiumGltf::ImageCesiumMipPosition& level : levels) {
+    const uint8_t* pLevel =
+        reinterpret_cast<const uint8_t*>(image.pixelData.data()) +
+        level.byteOffset;
+    const size_t byteOffset =
+        size_t(pTarget - reinterpret_cast<unsigned char*>(compressed.data()));
+
+    for (size_t blockY = 0; blockY < height; blockY += 4) {
+      for (size_t blockX = 0; blockX < width; blockX += 4) {
+        // Blocks on the right and bottom edges that are partially outside of
+        // the image repeat the edge pixels.
+        for (size_t y = 0; y < 4; ++y) {
+          const size_t sourceY = std::min(blockY + y, height - 1);
+          for (size_t x = 0; x < 4; ++x) {
+            const size_t sourceX = std::min(blockX + x, width - 1);
+            std::memcpy(
+                block + (y * 4 + x) * rgba8BytesPerPixel,
+                pLevel + (sourceY * width + sourceX) * rgba8BytesPerPixel,
+                rgba8BytesPerPixel);
+          }
+        }
+
+        stb_compress_dxt_block(pTarget, block, alpha ? 1 : 0, STB_DXT_NORMAL);
+        pTarget += bytesPerBlock;
+      }
+    }
+
+    compressedPositions.push_back(
+        {byteOffset,
+         CesiumGltf::computeCompressedByteSize(format, width, height)});
+    width = std::max(width / 2, size_t(1));
+    height = std::max(height / 2, size_t(1));
+  }
+
+  image.pixelData = std::move(compressed);
+  image.compressedPixelFormat = format;
+  if (!image.mipPositions.empty()) {
+    image.mipPositions = std::move(compressedPositions);
+  }
+
+  return true;
+}
+
 bool ImageManipulation::blitImage(
     CesiumGltf::ImageCesium& target,
     const PixelRectangle& targetPixels,
     const CesiumGltf::ImageCesium& source,
     const PixelRectangle& sourcePixels) {
 
+  if (target.compressedPixelFormat !=
+          CesiumGltf::GpuCompressedPixelFormat::None ||
+      source.compressedPixelFormat !=
+          CesiumGltf::GpuCompressedPixelFormat::None) {
+    // Block-compressed images can't be blitted.
+    return false;
+  }
+
   if (sourcePixels.x < 0 || sourcePixels.y < 0 || sourcePixels.width < 0 ||
       sourcePixels.height < 0 ||
       (sourcePixels.x + sourcePixels.width) > source.width ||
@@ -99,6 +690,34 @@ bool ImageManipulation::blitImage(
       return false;
     }
 
+    if (target.channels == 4) {
+      if (sourcePixels.width == 2 * targetPixels.width &&
+          sourcePixels.height == 2 * targetPixels.height) {
+        unsafeDownsampleRgba8(
+            pTarget,
+            bytesPerTargetRow,
+            pSource,
+            bytesPerSourceRow,
+            size_t(sourcePixels.width),
+            size_t(sourcePixels.height));
+        return true;
+      }
+
+      if (sourcePixels.width <= 2 * targetPixels.width &&
+          sourcePixels.height <= 2 * targetPixels.height) {
+        unsafeResampleRgba8(
+            pTarget,
+            bytesPerTargetRow,
+            size_t(targetPixels.width),
+            size_t(targetPixels.height),
+            pSource,
+            bytesPerSourceRow,
+            size_t(sourcePixels.width),
+            size_t(sourcePixels.height));
+        return true;
+      }
+    }
+
     // Use STB to do the copy / scale
     stbir_resize_uint8(
         reinterpret_cast<const unsigned char*>(pSource),
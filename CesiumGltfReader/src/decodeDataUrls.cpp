@@ -89,7 +89,8 @@ std::optional<DecodeResult> tryDecode(const std::string& uri) {
 void decodeDataUrls(
     const GltfReader& reader,
     ModelReaderResult& readModel,
-    bool clearDecodedDataUrls) {
+    bool clearDecodedDataUrls,
+    const Ktx2TranscodeTargets& ktx2TranscodeTargets) {
   CESIUM_TRACE("CesiumGltfReader::decodeDataUrls");
   if (!readModel.model) {
     return;
@@ -124,7 +125,8 @@ void decodeDataUrls(
       continue;
     }
 
-    ImageReaderResult imageResult = reader.readImage(decoded.value().data);
+    ImageReaderResult imageResult =
+        reader.readImage(decoded.value().data, ktx2TranscodeTargets);
     if (imageResult.image) {
       image.cesium = std::move(imageResult.image.value());
     }
@@ -3,10 +3,12 @@
 namespace CesiumGltfReader {
 
 struct ModelReaderResult;
+struct Ktx2TranscodeTargets;
 class GltfReader;
 
 void decodeDataUrls(
     const GltfReader& reader,
     ModelReaderResult& readModel,
-    bool clearDecodedDataUrls);
+    bool clearDecodedDataUrls,
+    const Ktx2TranscodeTargets& ktx2TranscodeTargets);
 } // namespace CesiumGltfReader
@@ -1,13 +1,19 @@
 #include "decodeDraco.h"
 
+#include "parallelFor.h"
+
 #include "CesiumGltfReader/GltfReader.h"
 
 #include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
 #include <CesiumGltf/Model.h>
 #include <CesiumUtility/Tracing.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -24,18 +30,35 @@
 namespace CesiumGltfReader {
 
 namespace {
-std::unique_ptr<draco::Mesh> decodeBufferViewToDracoMesh(
+
+// A Draco-compressed buffer view, which may be used by several primitives.
+struct DracoBufferView {
+  gsl::span<const std::byte> data;
+  std::unique_ptr<draco::Mesh> pMesh;
+  std::string error;
+};
+
+// A copy of one decoded attribute, or of the decoded indices if pAttribute is
+// nullptr, into the output buffer.
+struct CopyJob {
+  const draco::Mesh* pMesh;
+  const draco::PointAttribute* pAttribute;
+  int32_t componentType;
+  int8_t numberOfComponents;
+  int64_t count;
+  size_t byteOffset;
+};
+
+std::optional<gsl::span<const std::byte>> getDracoBufferViewData(
     ModelReaderResult& readModel,
-    CesiumGltf::MeshPrimitive& /* primitive */,
     const CesiumGltf::ExtensionKhrDracoMeshCompression& draco) {
-  CESIUM_TRACE("CesiumGltfReader::decodeBufferViewToDracoMesh");
   CesiumGltf::Model& model = readModel.model.value();
 
   CesiumGltf::BufferView* pBufferView =
       CesiumGltf::Model::getSafe(&model.bufferViews, draco.bufferView);
   if (!pBufferView) {
     readModel.warnings.emplace_back("Draco bufferView index is invalid.");
-    return nullptr;
+    return std::nullopt;
   }
 
   const CesiumGltf::BufferView& bufferView = *pBufferView;
@@ -45,7 +68,7 @@ std::unique_ptr<draco::Mesh> decodeBufferViewToDracoMesh(
   if (!pBuffer) {
     readModel.warnings.emplace_back(
         "Draco bufferView has an invalid buffer index.");
-    return nullptr;
+    return std::nullopt;
   }
 
   CesiumGltf::Buffer& buffer = *pBuffer;
@@ -55,28 +78,57 @@ std::unique_ptr<draco::Mesh> decodeBufferViewToDracoMesh(
           static_cast<int64_t>(buffer.cesium.data.size())) {
     readModel.warnings.emplace_back(
         "Draco bufferView extends beyond its buffer.");
-    return nullptr;
+    return std::nullopt;
   }
 
-  const gsl::span<const std::byte> data(
+  return gsl::span<const std::byte>(
       buffer.cesium.data.data() + bufferView.byteOffset,
       static_cast<uint64_t>(bufferView.byteLength));
+}
+
+void decodeBufferViewToDracoMesh(DracoBufferView& dracoBufferView) {
+  CESIUM_TRACE("CesiumGltfReader::decodeBufferViewToDracoMesh");
 
   draco::DecoderBuffer decodeBuffer;
-  decodeBuffer.Init(reinterpret_cast<const char*>(data.data()), data.size());
+  decodeBuffer.Init(
+      reinterpret_cast<const char*>(dracoBufferView.data.data()),
+      dracoBufferView.data.size());
 
   draco::Decoder decoder;
-  draco::Mesh mesh;
   draco::StatusOr<std::unique_ptr<draco::Mesh>> result =
       decoder.DecodeMeshFromBuffer(&decodeBuffer);
   if (!result.ok()) {
-    readModel.warnings.emplace_back(
-        std::string("Draco decoding failed: ") +
-        result.status().error_msg_string());
-    return nullptr;
+    dracoBufferView.error = std::string("Draco decoding failed: ") +
+                            result.status().error_msg_string();
+    return;
+  }
+
+  dracoBufferView.pMesh = std::move(result).value();
+}
+
+// Returns the Draco data type that has the same representation as the given
+// accessor component type, or DT_INVALID if there is none.
+draco::DataType getDracoDataType(int32_t componentType) noexcept {
+  switch (componentType) {
+  case CesiumGltf::Accessor::ComponentType::BYTE:
+    return draco::DT_INT8;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_BYTE:
+    return draco::DT_UINT8;
+  case CesiumGltf::Accessor::ComponentType::SHORT:
+    return draco::DT_INT16;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT:
+    return draco::DT_UINT16;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_INT:
+    return draco::DT_UINT32;
+  case CesiumGltf::Accessor::ComponentType::FLOAT:
+    return draco::DT_FLOAT32;
+  default:
+    return draco::DT_INVALID;
   }
+}
 
-  return std::move(result).value();
+bool isSupportedComponentType(int32_t componentType) noexcept {
+  return getDracoDataType(componentType) != draco::DT_INVALID;
 }
 
 template <typename TSource, typename TDestination>
@@ -94,11 +146,129 @@ void copyData(const T* pSource, T* pDestination, int64_t length) {
   std::copy(pSource, pSource + length, pDestination);
 }
 
-void copyDecodedIndices(
+void copyDecodedIndices(const CopyJob& job, std::byte* pOutput) {
+  CESIUM_TRACE("CesiumGltfReader::copyDecodedIndices");
+
+  static_assert(sizeof(draco::PointIndex) == sizeof(uint32_t));
+
+  const uint32_t* pSourceIndices = reinterpret_cast<const uint32_t*>(
+      &job.pMesh->face(draco::FaceIndex(0))[0]);
+
+  switch (job.componentType) {
+  case CesiumGltf::Accessor::ComponentType::BYTE:
+    copyData(pSourceIndices, reinterpret_cast<int8_t*>(pOutput), job.count);
+    break;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_BYTE:
+    copyData(pSourceIndices, reinterpret_cast<uint8_t*>(pOutput), job.count);
+    break;
+  case CesiumGltf::Accessor::ComponentType::SHORT:
+    copyData(pSourceIndices, reinterpret_cast<int16_t*>(pOutput), job.count);
+    break;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT:
+    copyData(pSourceIndices, reinterpret_cast<uint16_t*>(pOutput), job.count);
+    break;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_INT:
+    copyData(pSourceIndices, reinterpret_cast<uint32_t*>(pOutput), job.count);
+    break;
+  case CesiumGltf::Accessor::ComponentType::FLOAT:
+    copyData(pSourceIndices, reinterpret_cast<float*>(pOutput), job.count);
+    break;
+  }
+}
+
+void copyDecodedAttribute(const CopyJob& job, std::byte* pOutput) {
+  CESIUM_TRACE("CesiumGltfReader::copyDecodedAttribute");
+
+  const draco::Mesh* pMesh = job.pMesh;
+  const draco::PointAttribute* pAttribute = job.pAttribute;
+  const int8_t numberOfComponents = job.numberOfComponents;
+
+  // If the decoded values are already laid out the way the accessor expects
+  // them, copy them all at once.
+  const int64_t stride = numberOfComponents *
+                         draco::DataTypeLength(
+                             getDracoDataType(job.componentType));
+  if (pAttribute->is_mapping_identity() &&
+      pAttribute->data_type() == getDracoDataType(job.componentType) &&
+      pAttribute->num_components() == numberOfComponents &&
+      pAttribute->byte_stride() == stride &&
+      static_cast<int64_t>(pAttribute->size()) >= job.count) {
+    std::memcpy(
+        pOutput,
+        pAttribute->GetAddress(draco::AttributeValueIndex(0)),
+        static_cast<size_t>(job.count * stride));
+    return;
+  }
+
+  const auto doCopy = [pMesh, pAttribute, numberOfComponents](auto pOut) {
+    for (draco::PointIndex i(0); i < pMesh->num_points(); ++i) {
+      const draco::AttributeValueIndex valueIndex = pAttribute->mapped_index(i);
+      pAttribute->ConvertValue(valueIndex, numberOfComponents, pOut);
+      pOut += numberOfComponents;
+    }
+  };
+
+  switch (job.componentType) {
+  case CesiumGltf::Accessor::ComponentType::BYTE:
+    doCopy(reinterpret_cast<int8_t*>(pOutput));
+    break;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_BYTE:
+    doCopy(reinterpret_cast<uint8_t*>(pOutput));
+    break;
+  case CesiumGltf::Accessor::ComponentType::SHORT:
+    doCopy(reinterpret_cast<int16_t*>(pOutput));
+    break;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT:
+    doCopy(reinterpret_cast<uint16_t*>(pOutput));
+    break;
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_INT:
+    doCopy(reinterpret_cast<uint32_t*>(pOutput));
+    break;
+  case CesiumGltf::Accessor::ComponentType::FLOAT:
+    doCopy(reinterpret_cast<float*>(pOutput));
+    break;
+  }
+}
+
+// Lays out the decoded data of the given accessor in the output buffer and
+// points the accessor at it.
+void addOutputBufferView(
+    CesiumGltf::Model& model,
+    CesiumGltf::Accessor& accessor,
+    int32_t outputBuffer,
+    int64_t stride,
+    std::optional<int32_t> target,
+    size_t& outputSize,
+    CopyJob& job) {
+  // Keep every buffer view aligned for the largest component type.
+  outputSize = (outputSize + 3) & ~size_t(3);
+
+  const int64_t sizeBytes = accessor.count * stride;
+
+  accessor.bufferView = static_cast<int32_t>(model.bufferViews.size());
+  accessor.byteOffset = 0;
+
+  CesiumGltf::BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = outputBuffer;
+  bufferView.byteOffset = static_cast<int64_t>(outputSize);
+  bufferView.byteLength = sizeBytes;
+  bufferView.byteStride = stride;
+  if (target) {
+    bufferView.target = *target;
+  }
+
+  job.count = accessor.count;
+  job.byteOffset = outputSize;
+  outputSize += static_cast<size_t>(sizeBytes);
+}
+
+void addDecodedIndices(
     ModelReaderResult& readModel,
     const CesiumGltf::MeshPrimitive& primitive,
-    draco::Mesh* pMesh) {
-  CESIUM_TRACE("CesiumGltfReader::copyDecodedIndices");
+    const draco::Mesh* pMesh,
+    int32_t outputBuffer,
+    size_t& outputSize,
+    std::vector<CopyJob>& jobs) {
   CesiumGltf::Model& model = readModel.model.value();
 
   if (primitive.indices < 0) {
@@ -137,154 +307,88 @@ void copyDecodedIndices(
     pIndicesAccessor->componentType = supposedComponentType;
   }
 
-  pIndicesAccessor->bufferView = static_cast<int32_t>(model.bufferViews.size());
-  CesiumGltf::BufferView& indicesBufferView = model.bufferViews.emplace_back();
-
-  indicesBufferView.buffer = static_cast<int32_t>(model.buffers.size());
-  CesiumGltf::Buffer& indicesBuffer = model.buffers.emplace_back();
-
-  int64_t indexBytes = pIndicesAccessor->computeByteSizeOfComponent();
-  const int64_t indicesBytes = pIndicesAccessor->count * indexBytes;
-
-  indicesBuffer.cesium.data.resize(static_cast<size_t>(indicesBytes));
-  indicesBuffer.byteLength = indicesBytes;
-  indicesBufferView.byteLength = indicesBytes;
-  indicesBufferView.byteStride = indexBytes;
-  indicesBufferView.byteOffset = 0;
-  indicesBufferView.target =
-      CesiumGltf::BufferView::Target::ELEMENT_ARRAY_BUFFER;
   pIndicesAccessor->type = CesiumGltf::Accessor::Type::SCALAR;
-  pIndicesAccessor->byteOffset = 0;
-
-  static_assert(sizeof(draco::PointIndex) == sizeof(uint32_t));
-
-  const uint32_t* pSourceIndices =
-      reinterpret_cast<const uint32_t*>(&pMesh->face(draco::FaceIndex(0))[0]);
 
-  switch (pIndicesAccessor->componentType) {
-  case CesiumGltf::Accessor::ComponentType::BYTE:
-    copyData(
-        pSourceIndices,
-        reinterpret_cast<int8_t*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
-    break;
-  case CesiumGltf::Accessor::ComponentType::UNSIGNED_BYTE:
-    copyData(
-        pSourceIndices,
-        reinterpret_cast<uint8_t*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
-    break;
-  case CesiumGltf::Accessor::ComponentType::SHORT:
-    copyData(
-        pSourceIndices,
-        reinterpret_cast<int16_t*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
-    break;
-  case CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT:
-    copyData(
-        pSourceIndices,
-        reinterpret_cast<uint16_t*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
-    break;
-  case CesiumGltf::Accessor::ComponentType::UNSIGNED_INT:
-    copyData(
-        pSourceIndices,
-        reinterpret_cast<uint32_t*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
-    break;
-  case CesiumGltf::Accessor::ComponentType::FLOAT:
-    copyData(
-        pSourceIndices,
-        reinterpret_cast<float*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
-    break;
-  }
+  CopyJob& job = jobs.emplace_back(
+      CopyJob{pMesh, nullptr, pIndicesAccessor->componentType, 1, 0, 0});
+  addOutputBufferView(
+      model,
+      *pIndicesAccessor,
+      outputBuffer,
+      pIndicesAccessor->computeByteSizeOfComponent(),
+      CesiumGltf::BufferView::Target::ELEMENT_ARRAY_BUFFER,
+      outputSize,
+      job);
 }
 
-void copyDecodedAttribute(
+void addDecodedAttribute(
     ModelReaderResult& readModel,
-    CesiumGltf::MeshPrimitive& /* primitive */,
-    CesiumGltf::Accessor* pAccessor,
+    CesiumGltf::Accessor& accessor,
     const draco::Mesh* pMesh,
-    const draco::PointAttribute* pAttribute) {
-  CESIUM_TRACE("CesiumGltfReader::copyDecodedAttribute");
+    const draco::PointAttribute* pAttribute,
+    int32_t outputBuffer,
+    size_t& outputSize,
+    std::vector<CopyJob>& jobs) {
   CesiumGltf::Model& model = readModel.model.value();
 
-  if (pAccessor->count != pMesh->num_points()) {
+  if (!isSupportedComponentType(accessor.componentType)) {
+    readModel.warnings.emplace_back(
+        "Accessor uses an unknown componentType: " +
+        std::to_string(int32_t(accessor.componentType)));
+    return;
+  }
+
+  if (accessor.count != pMesh->num_points()) {
     readModel.warnings.emplace_back("Attribute accessor.count doesn't match "
                                     "with number of decoded Draco vertices.");
 
-    pAccessor->count = pMesh->num_points();
+    accessor.count = pMesh->num_points();
   }
 
-  pAccessor->bufferView = static_cast<int32_t>(model.bufferViews.size());
-  CesiumGltf::BufferView& bufferView = model.bufferViews.emplace_back();
-
-  bufferView.buffer = static_cast<int32_t>(model.buffers.size());
-  CesiumGltf::Buffer& buffer = model.buffers.emplace_back();
-
-  const int8_t numberOfComponents = pAccessor->computeNumberOfComponents();
+  const int8_t numberOfComponents = accessor.computeNumberOfComponents();
   const int64_t stride =
-      numberOfComponents * pAccessor->computeByteSizeOfComponent();
-  const int64_t sizeBytes = pAccessor->count * stride;
-
-  buffer.cesium.data.resize(static_cast<size_t>(sizeBytes));
-  buffer.byteLength = sizeBytes;
-  bufferView.byteLength = sizeBytes;
-  bufferView.byteStride = stride;
-  bufferView.byteOffset = 0;
-  pAccessor->byteOffset = 0;
-
-  const auto doCopy = [pMesh, pAttribute, numberOfComponents](auto pOut) {
-    for (draco::PointIndex i(0); i < pMesh->num_points(); ++i) {
-      const draco::AttributeValueIndex valueIndex = pAttribute->mapped_index(i);
-      pAttribute->ConvertValue(valueIndex, numberOfComponents, pOut);
-      pOut += pAttribute->num_components();
-    }
-  };
-
-  switch (pAccessor->componentType) {
-  case CesiumGltf::Accessor::ComponentType::BYTE:
-    doCopy(reinterpret_cast<int8_t*>(buffer.cesium.data.data()));
-    break;
-  case CesiumGltf::Accessor::ComponentType::UNSIGNED_BYTE:
-    doCopy(reinterpret_cast<uint8_t*>(buffer.cesium.data.data()));
-    break;
-  case CesiumGltf::Accessor::ComponentType::SHORT:
-    doCopy(reinterpret_cast<int16_t*>(buffer.cesium.data.data()));
-    break;
-  case CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT:
-    doCopy(reinterpret_cast<uint16_t*>(buffer.cesium.data.data()));
-    break;
-  case CesiumGltf::Accessor::ComponentType::UNSIGNED_INT:
-    doCopy(reinterpret_cast<uint32_t*>(buffer.cesium.data.data()));
-    break;
-  case CesiumGltf::Accessor::ComponentType::FLOAT:
-    doCopy(reinterpret_cast<float*>(buffer.cesium.data.data()));
-    break;
-  default:
-    readModel.warnings.emplace_back(
-        "Accessor uses an unknown componentType: " +
-        std::to_string(int32_t(pAccessor->componentType)));
-    break;
-  }
+      numberOfComponents * accessor.computeByteSizeOfComponent();
+
+  CopyJob& job = jobs.emplace_back(CopyJob{
+      pMesh,
+      pAttribute,
+      accessor.componentType,
+      numberOfComponents,
+      0,
+      0});
+  addOutputBufferView(
+      model,
+      accessor,
+      outputBuffer,
+      stride,
+      std::nullopt,
+      outputSize,
+      job);
 }
 
-void decodePrimitive(
+void addDecodedPrimitive(
     ModelReaderResult& readModel,
     CesiumGltf::MeshPrimitive& primitive,
-    CesiumGltf::ExtensionKhrDracoMeshCompression& draco) {
-  CESIUM_TRACE("CesiumGltfReader::decodePrimitive");
+    const CesiumGltf::ExtensionKhrDracoMeshCompression& draco,
+    const draco::Mesh* pMesh,
+    int32_t outputBuffer,
+    std::unordered_set<int32_t>& decodedAccessors,
+    size_t& outputSize,
+    std::vector<CopyJob>& jobs) {
   CesiumGltf::Model& model = readModel.model.value();
 
-  std::unique_ptr<draco::Mesh> pMesh =
-      decodeBufferViewToDracoMesh(readModel, primitive, draco);
-  if (!pMesh) {
-    return;
+  // Primitives that share their accessors with a primitive that was already
+  // decoded don't need to decode them again.
+  if (decodedAccessors.insert(primitive.indices).second) {
+    addDecodedIndices(
+        readModel,
+        primitive,
+        pMesh,
+        outputBuffer,
+        outputSize,
+        jobs);
   }
 
-  copyDecodedIndices(readModel, primitive, pMesh.get());
-
   for (const std::pair<const std::string, int32_t>& attribute :
        draco.attributes) {
     auto primitiveAttrIt = primitive.attributes.find(attribute.first);
@@ -306,6 +410,10 @@ void decodePrimitive(
       continue;
     }
 
+    if (decodedAccessors.find(primitiveAttrIndex) != decodedAccessors.end()) {
+      continue;
+    }
+
     const int32_t dracoAttrIndex = attribute.second;
     const draco::PointAttribute* pAttribute =
         pMesh->GetAttributeByUniqueId(static_cast<uint32_t>(dracoAttrIndex));
@@ -316,17 +424,22 @@ void decodePrimitive(
       continue;
     }
 
-    copyDecodedAttribute(
+    decodedAccessors.insert(primitiveAttrIndex);
+    addDecodedAttribute(
         readModel,
-        primitive,
-        pAccessor,
-        pMesh.get(),
-        pAttribute);
+        *pAccessor,
+        pMesh,
+        pAttribute,
+        outputBuffer,
+        outputSize,
+        jobs);
   }
 }
 } // namespace
 
-void decodeDraco(CesiumGltfReader::ModelReaderResult& readModel) {
+void decodeDraco(
+    CesiumGltfReader::ModelReaderResult& readModel,
+    const std::optional<CesiumAsync::AsyncSystem>& asyncSystem) {
   CESIUM_TRACE("CesiumGltfReader::decodeDraco");
   if (!readModel.model) {
     return;
@@ -334,6 +447,18 @@ void decodeDraco(CesiumGltfReader::ModelReaderResult& readModel) {
 
   CesiumGltf::Model& model = readModel.model.value();
 
+  // Find the distinct Draco buffer views, so that each one is decoded only
+  // once even if several primitives use it.
+  struct DracoPrimitive {
+    CesiumGltf::MeshPrimitive* pPrimitive;
+    CesiumGltf::ExtensionKhrDracoMeshCompression* pDraco;
+    size_t dracoBufferViewIndex;
+  };
+
+  std::vector<DracoPrimitive> dracoPrimitives;
+  std::vector<DracoBufferView> dracoBufferViews;
+  std::unordered_map<int32_t, size_t> dracoBufferViewIndices;
+
   for (CesiumGltf::Mesh& mesh : model.meshes) {
     for (CesiumGltf::MeshPrimitive& primitive : mesh.primitives) {
       CesiumGltf::ExtensionKhrDracoMeshCompression* pDraco =
@@ -343,9 +468,81 @@ void decodeDraco(CesiumGltfReader::ModelReaderResult& readModel) {
         continue;
       }
 
-      decodePrimitive(readModel, primitive, *pDraco);
+      auto it = dracoBufferViewIndices.find(pDraco->bufferView);
+      if (it == dracoBufferViewIndices.end()) {
+        std::optional<gsl::span<const std::byte>> data =
+            getDracoBufferViewData(readModel, *pDraco);
+        if (!data) {
+          continue;
+        }
+
+        it = dracoBufferViewIndices
+                 .emplace(pDraco->bufferView, dracoBufferViews.size())
+                 .first;
+        dracoBufferViews.emplace_back(DracoBufferView{*data, nullptr, ""});
+      }
+
+      dracoPrimitives.emplace_back(DracoPrimitive{&primitive, pDraco, it->second});
     }
   }
+
+  if (dracoPrimitives.empty()) {
+    return;
+  }
+
+  // Decode the buffer views concurrently.
+  parallelFor(asyncSystem, dracoBufferViews.size(), [&dracoBufferViews](size_t i) {
+    decodeBufferViewToDracoMesh(dracoBufferViews[i]);
+  });
+
+  for (const DracoBufferView& dracoBufferView : dracoBufferViews) {
+    if (!dracoBufferView.error.empty()) {
+      readModel.warnings.emplace_back(dracoBufferView.error);
+    }
+  }
+
+  // Lay out all decoded data in a single new buffer, then copy the decoded
+  // data straight into it.
+  const int32_t outputBufferIndex = static_cast<int32_t>(model.buffers.size());
+  size_t outputSize = 0;
+  std::vector<CopyJob> jobs;
+  std::unordered_set<int32_t> decodedAccessors;
+
+  for (const DracoPrimitive& dracoPrimitive : dracoPrimitives) {
+    const draco::Mesh* pMesh =
+        dracoBufferViews[dracoPrimitive.dracoBufferViewIndex].pMesh.get();
+    if (!pMesh) {
+      continue;
+    }
+
+    addDecodedPrimitive(
+        readModel,
+        *dracoPrimitive.pPrimitive,
+        *dracoPrimitive.pDraco,
+        pMesh,
+        outputBufferIndex,
+        decodedAccessors,
+        outputSize,
+        jobs);
+  }
+
+  if (jobs.empty()) {
+    return;
+  }
+
+  CesiumGltf::Buffer& outputBuffer = model.buffers.emplace_back();
+  outputBuffer.byteLength = static_cast<int64_t>(outputSize);
+  outputBuffer.cesium.data.resize(outputSize);
+  std::byte* pOutput = outputBuffer.cesium.data.data();
+
+  parallelFor(asyncSystem, jobs.size(), [&jobs, pOutput](size_t i) {
+    const CopyJob& job = jobs[i];
+    if (job.pAttribute) {
+      copyDecodedAttribute(job, pOutput + job.byteOffset);
+    } else {
+      copyDecodedIndices(job, pOutput + job.byteOffset);
+    }
+  });
 }
 
 } // namespace CesiumGltfReader
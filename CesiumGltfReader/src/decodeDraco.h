@@ -1,7 +1,13 @@
 #pragma once
 
+#include <CesiumAsync/AsyncSystem.h>
+
+#include <optional>
+
 namespace CesiumGltfReader {
 struct ModelReaderResult;
 
-void decodeDraco(ModelReaderResult& readModel);
+void decodeDraco(
+    ModelReaderResult& readModel,
+    const std::optional<CesiumAsync::AsyncSystem>& asyncSystem);
 } // namespace CesiumGltfReader
@@ -0,0 +1,743 @@
+#include "decodeMeshopt.h"
+
+#include "parallelFor.h"
+
+#include "CesiumGltfReader/GltfReader.h"
+
+#include <CesiumGltf/ExtensionBufferExtMeshoptCompression.h>
+#include <CesiumGltf/ExtensionBufferViewExtMeshoptCompression.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumUtility/Tracing.h>
+
+#include <gsl/span>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using CesiumGltf::ExtensionBufferViewExtMeshoptCompression;
+
+namespace CesiumGltfReader {
+
+namespace {
+
+// The decoders below implement the bitstreams described in the
+// EXT_meshopt_compression specification. Like the reference decoder, they
+// rely on the padding that encoders put at the end of the data, so each value
+// only needs a bounds check per group of values.
+
+constexpr uint8_t vertexHeader = 0xA0;
+constexpr uint8_t indexHeader = 0xE0;
+constexpr uint8_t sequenceHeader = 0xD0;
+
+constexpr size_t vertexBlockSizeBytes = 8192;
+constexpr size_t vertexBlockMaxSize = 256;
+constexpr size_t byteGroupSize = 16;
+constexpr size_t byteGroupDecodeLimit = 24;
+constexpr size_t vertexTailMaxSize = 32;
+
+size_t getVertexBlockSize(size_t vertexSize) noexcept {
+  const size_t result =
+      (vertexBlockSizeBytes / vertexSize) & ~(byteGroupSize - 1);
+  return std::min(result, vertexBlockMaxSize);
+}
+
+uint8_t unzigzag8(uint8_t v) noexcept {
+  return static_cast<uint8_t>(-(v & 1) ^ (v >> 1));
+}
+
+// Decodes 16 bytes that are stored with 0, 2, 4 or 8 bits each. Values that
+// don't fit in 2 or 4 bits are escaped and stored in full after the packed
+// bits.
+const uint8_t* decodeBytesGroup(
+    const uint8_t* pData,
+    uint8_t* pBuffer,
+    uint32_t bitsLog2) noexcept {
+  switch (bitsLog2) {
+  case 0:
+    std::memset(pBuffer, 0, byteGroupSize);
+    return pData;
+  case 1:
+  case 2: {
+    const uint32_t bits = 1U << bitsLog2;
+    const uint32_t escape = (1U << bits) - 1;
+    const size_t valuesPerByte = 8 / bits;
+    const uint8_t* pVariable = pData + byteGroupSize / valuesPerByte;
+    for (size_t i = 0; i < byteGroupSize; ++i) {
+      const uint32_t shift =
+          8 - bits * (static_cast<uint32_t>(i % valuesPerByte) + 1);
+      const uint32_t value =
+          (static_cast<uint32_t>(pData[i / valuesPerByte]) >> shift) & escape;
+      pBuffer[i] = value == escape ? *pVariable++ : static_cast<uint8_t>(value);
+    }
+    return pVariable;
+  }
+  default:
+    std::memcpy(pBuffer, pData, byteGroupSize);
+    return pData + byteGroupSize;
+  }
+}
+
+const uint8_t* decodeBytes(
+    const uint8_t* pData,
+    const uint8_t* pDataEnd,
+    uint8_t* pBuffer,
+    size_t bufferSize) noexcept {
+  // Two bits per group select its encoding.
+  const uint8_t* pHeader = pData;
+  const size_t headerSize = (bufferSize / byteGroupSize + 3) / 4;
+  if (static_cast<size_t>(pDataEnd - pData) < headerSize) {
+    return nullptr;
+  }
+
+  pData += headerSize;
+
+  for (size_t i = 0; i < bufferSize; i += byteGroupSize) {
+    if (static_cast<size_t>(pDataEnd - pData) < byteGroupDecodeLimit) {
+      return nullptr;
+    }
+
+    const size_t group = i / byteGroupSize;
+    const uint32_t bitsLog2 =
+        (static_cast<uint32_t>(pHeader[group / 4]) >> ((group % 4) * 2)) & 3;
+    pData = decodeBytesGroup(pData, pBuffer + i, bitsLog2);
+  }
+
+  return pData;
+}
+
+// Decodes vertices that are stored as blocks of byte-wise deltas. Each byte
+// of a vertex is decoded straight into its place in the output, without
+// going through a transposed copy of the block.
+bool decodeVertexBuffer(
+    const gsl::span<const std::byte>& source,
+    std::byte* pDestination,
+    size_t count,
+    size_t stride) noexcept {
+  const uint8_t* pData = reinterpret_cast<const uint8_t*>(source.data());
+  const uint8_t* pDataEnd = pData + source.size();
+
+  if (source.size() < 1 + stride || *pData++ != vertexHeader) {
+    return false;
+  }
+
+  // The encoder stores the first vertex at the end of the data, as the
+  // baseline for the first deltas.
+  uint8_t lastVertex[vertexBlockMaxSize];
+  std::memcpy(lastVertex, pDataEnd - stride, stride);
+
+  uint8_t deltas[vertexBlockMaxSize];
+  uint8_t* pOutput = reinterpret_cast<uint8_t*>(pDestination);
+  const size_t blockSize = getVertexBlockSize(stride);
+
+  for (size_t offset = 0; offset < count; offset += blockSize) {
+    const size_t blockCount = std::min(blockSize, count - offset);
+    const size_t alignedCount =
+        (blockCount + byteGroupSize - 1) & ~(byteGroupSize - 1);
+    uint8_t* pBlock = pOutput + offset * stride;
+
+    for (size_t k = 0; k < stride; ++k) {
+      pData = decodeBytes(pData, pDataEnd, deltas, alignedCount);
+      if (!pData) {
+        return false;
+      }
+
+      uint8_t previous = lastVertex[k];
+      for (size_t i = 0; i < blockCount; ++i) {
+        previous = static_cast<uint8_t>(previous + unzigzag8(deltas[i]));
+        pBlock[i * stride + k] = previous;
+      }
+      lastVertex[k] = previous;
+    }
+  }
+
+  const size_t tailSize = std::max(stride, vertexTailMaxSize);
+  return static_cast<size_t>(pDataEnd - pData) == tailSize;
+}
+
+uint32_t decodeVByte(const uint8_t*& pData) noexcept {
+  const uint8_t lead = *pData++;
+  if (lead < 128) {
+    return lead;
+  }
+
+  uint32_t result = lead & 127U;
+  uint32_t shift = 7;
+  for (size_t i = 0; i < 4; ++i) {
+    const uint8_t group = *pData++;
+    result |= static_cast<uint32_t>(group & 127U) << shift;
+    shift += 7;
+    if (group < 128) {
+      break;
+    }
+  }
+
+  return result;
+}
+
+uint32_t decodeIndex(const uint8_t*& pData, uint32_t last) noexcept {
+  const uint32_t v = decodeVByte(pData);
+  const uint32_t delta = (v >> 1) ^ (0U - (v & 1));
+  return last + delta;
+}
+
+void writeIndex(
+    std::byte* pDestination,
+    size_t i,
+    size_t indexSize,
+    uint32_t index) noexcept {
+  if (indexSize == 2) {
+    const uint16_t index16 = static_cast<uint16_t>(index);
+    std::memcpy(pDestination + i * 2, &index16, sizeof(index16));
+  } else {
+    std::memcpy(pDestination + i * 4, &index, sizeof(index));
+  }
+}
+
+void writeTriangle(
+    std::byte* pDestination,
+    size_t i,
+    size_t indexSize,
+    uint32_t a,
+    uint32_t b,
+    uint32_t c) noexcept {
+  writeIndex(pDestination, i, indexSize, a);
+  writeIndex(pDestination, i + 1, indexSize, b);
+  writeIndex(pDestination, i + 2, indexSize, c);
+}
+
+// A FIFO of the most recently seen edges or vertices. Reads are relative to
+// the most recent entry.
+template <typename T> struct Fifo {
+  T entries[16];
+  size_t offset = 0;
+
+  Fifo() noexcept { std::memset(entries, 0xFF, sizeof(entries)); }
+
+  const T& get(size_t distance) const noexcept {
+    return entries[(offset - distance) & 15];
+  }
+
+  void push(const T& value, bool advance = true) noexcept {
+    entries[offset] = value;
+    offset = (offset + (advance ? 1 : 0)) & 15;
+  }
+};
+
+struct Edge {
+  uint32_t a;
+  uint32_t b;
+};
+
+// Decodes triangles that are stored as one code byte per triangle, which
+// refers to recently seen edges and vertices, followed by the indices that
+// couldn't be encoded that way.
+bool decodeIndexBuffer(
+    const gsl::span<const std::byte>& source,
+    std::byte* pDestination,
+    size_t count,
+    size_t indexSize) noexcept {
+  if (count % 3 != 0 || source.size() < 1 + count / 3 + 16) {
+    return false;
+  }
+
+  const uint8_t* pBuffer = reinterpret_cast<const uint8_t*>(source.data());
+  if ((pBuffer[0] & 0xF0) != indexHeader) {
+    return false;
+  }
+
+  const uint32_t version = pBuffer[0] & 0x0FU;
+  if (version > 1) {
+    return false;
+  }
+
+  Fifo<Edge> edgeFifo;
+  Fifo<uint32_t> vertexFifo;
+  uint32_t next = 0;
+  uint32_t last = 0;
+  const uint32_t maxFifoVertex = version >= 1 ? 13 : 15;
+
+  // The data ends with a table of 16 frequently used auxiliary codes.
+  const uint8_t* pCode = pBuffer + 1;
+  const uint8_t* pData = pCode + count / 3;
+  const uint8_t* pDataSafeEnd = pBuffer + source.size() - 16;
+  const uint8_t* pCodeAuxTable = pDataSafeEnd;
+
+  for (size_t i = 0; i < count; i += 3) {
+    // Each triangle reads at most 16 bytes: one auxiliary code and up to
+    // five bytes for each index.
+    if (pData > pDataSafeEnd) {
+      return false;
+    }
+
+    const uint8_t codeTri = *pCode++;
+
+    if (codeTri < 0xF0) {
+      // The triangle shares an edge with a recent triangle.
+      const Edge edge = edgeFifo.get(1U + (codeTri >> 4));
+      const uint32_t fec = codeTri & 15U;
+
+      uint32_t c;
+      if (fec < maxFifoVertex) {
+        const bool isNext = fec == 0;
+        c = isNext ? next : vertexFifo.get(1U + fec);
+        next += isNext ? 1 : 0;
+        vertexFifo.push(c, isNext);
+      } else {
+        // Codes 13 and 14 are the last free index minus or plus one.
+        if (fec == 15) {
+          c = decodeIndex(pData, last);
+        } else {
+          c = fec == 13 ? last - 1 : last + 1;
+        }
+        last = c;
+        vertexFifo.push(c);
+      }
+
+      writeTriangle(pDestination, i, indexSize, edge.a, edge.b, c);
+      edgeFifo.push(Edge{c, edge.b});
+      edgeFifo.push(Edge{edge.a, c});
+    } else if (codeTri < 0xFE) {
+      // A new triangle whose auxiliary code is in the table.
+      const uint8_t codeAux = pCodeAuxTable[codeTri & 15];
+      const uint32_t feb = static_cast<uint32_t>(codeAux >> 4);
+      const uint32_t fec = codeAux & 15U;
+
+      const uint32_t a = next++;
+      const bool bIsNext = feb == 0;
+      const uint32_t b = bIsNext ? next : vertexFifo.get(feb);
+      next += bIsNext ? 1 : 0;
+      const bool cIsNext = fec == 0;
+      const uint32_t c = cIsNext ? next : vertexFifo.get(fec);
+      next += cIsNext ? 1 : 0;
+
+      writeTriangle(pDestination, i, indexSize, a, b, c);
+      vertexFifo.push(a);
+      vertexFifo.push(b, bIsNext);
+      vertexFifo.push(c, cIsNext);
+      edgeFifo.push(Edge{b, a});
+      edgeFifo.push(Edge{c, b});
+      edgeFifo.push(Edge{a, c});
+    } else {
+      // A new triangle whose auxiliary code follows in the data.
+      const uint8_t codeAux = *pData++;
+      const uint32_t fea = codeTri == 0xFE ? 0 : 15;
+      const uint32_t feb = static_cast<uint32_t>(codeAux >> 4);
+      const uint32_t fec = codeAux & 15U;
+
+      if (codeAux == 0) {
+        next = 0;
+      }
+
+      uint32_t a = fea == 0 ? next++ : 0;
+      uint32_t b = feb == 0 ? next++ : vertexFifo.get(feb);
+      uint32_t c = fec == 0 ? next++ : vertexFifo.get(fec);
+
+      if (fea == 15) {
+        last = a = decodeIndex(pData, last);
+      }
+      if (feb == 15) {
+        last = b = decodeIndex(pData, last);
+      }
+      if (fec == 15) {
+        last = c = decodeIndex(pData, last);
+      }
+
+      writeTriangle(pDestination, i, indexSize, a, b, c);
+      vertexFifo.push(a);
+      vertexFifo.push(b, feb == 0 || feb == 15);
+      vertexFifo.push(c, fec == 0 || fec == 15);
+      edgeFifo.push(Edge{b, a});
+      edgeFifo.push(Edge{c, b});
+      edgeFifo.push(Edge{a, c});
+    }
+  }
+
+  return pData == pDataSafeEnd;
+}
+
+// Decodes indices that are stored as deltas from one of two baselines.
+bool decodeIndexSequence(
+    const gsl::span<const std::byte>& source,
+    std::byte* pDestination,
+    size_t count,
+    size_t indexSize) noexcept {
+  if (source.size() < 1 + count + 4) {
+    return false;
+  }
+
+  const uint8_t* pBuffer = reinterpret_cast<const uint8_t*>(source.data());
+  if ((pBuffer[0] & 0xF0) != sequenceHeader || (pBuffer[0] & 0x0F) > 1) {
+    return false;
+  }
+
+  const uint8_t* pData = pBuffer + 1;
+  const uint8_t* pDataSafeEnd = pBuffer + source.size() - 4;
+  uint32_t last[2] = {0, 0};
+
+  for (size_t i = 0; i < count; ++i) {
+    // Each index reads at most five bytes, which the four byte tail covers.
+    if (pData >= pDataSafeEnd) {
+      return false;
+    }
+
+    uint32_t v = decodeVByte(pData);
+    const uint32_t baseline = v & 1;
+    v >>= 1;
+    const uint32_t delta = (v >> 1) ^ (0U - (v & 1));
+    last[baseline] += delta;
+    writeIndex(pDestination, i, indexSize, last[baseline]);
+  }
+
+  return pData == pDataSafeEnd;
+}
+
+int32_t roundToInt(float value) noexcept {
+  return static_cast<int32_t>(value + (value >= 0.0f ? 0.5f : -0.5f));
+}
+
+// Reconstructs unit vectors from octahedral encoding. The third component
+// holds the value that represents 1.0 and the fourth is left as it is.
+template <typename T>
+void decodeOctahedralFilter(std::byte* pData, size_t count) noexcept {
+  const float max = float((1 << (sizeof(T) * 8 - 1)) - 1);
+
+  for (size_t i = 0; i < count; ++i) {
+    T values[4];
+    std::memcpy(values, pData + i * sizeof(values), sizeof(values));
+
+    float x = float(values[0]);
+    float y = float(values[1]);
+    const float z = float(values[2]) - std::fabs(x) - std::fabs(y);
+
+    const float t = z >= 0.0f ? 0.0f : z;
+    x += x >= 0.0f ? t : -t;
+    y += y >= 0.0f ? t : -t;
+
+    const float scale = max / std::sqrt(x * x + y * y + z * z);
+    values[0] = static_cast<T>(roundToInt(x * scale));
+    values[1] = static_cast<T>(roundToInt(y * scale));
+    values[2] = static_cast<T>(roundToInt(z * scale));
+
+    std::memcpy(pData + i * sizeof(values), values, sizeof(values));
+  }
+}
+
+// Reconstructs unit quaternions from their three smallest components. The
+// fourth value holds the scale of the other three and the index of the
+// component that was dropped.
+void decodeQuaternionFilter(std::byte* pData, size_t count) noexcept {
+  const float scale = 1.0f / std::sqrt(2.0f);
+
+  for (size_t i = 0; i < count; ++i) {
+    int16_t values[4];
+    std::memcpy(values, pData + i * sizeof(values), sizeof(values));
+
+    const int32_t sf = values[3] | 3;
+    const float ss = scale / float(sf);
+
+    const float x = float(values[0]) * ss;
+    const float y = float(values[1]) * ss;
+    const float z = float(values[2]) * ss;
+    const float ww = 1.0f - x * x - y * y - z * z;
+    const float w = std::sqrt(ww >= 0.0f ? ww : 0.0f);
+
+    const size_t qc = static_cast<size_t>(values[3] & 3);
+    values[(qc + 1) & 3] = static_cast<int16_t>(roundToInt(x * 32767.0f));
+    values[(qc + 2) & 3] = static_cast<int16_t>(roundToInt(y * 32767.0f));
+    values[(qc + 3) & 3] = static_cast<int16_t>(roundToInt(z * 32767.0f));
+    values[qc] = static_cast<int16_t>(roundToInt(w * 32767.0f));
+
+    std::memcpy(pData + i * sizeof(values), values, sizeof(values));
+  }
+}
+
+// Reconstructs floats from a 24-bit signed mantissa and an 8-bit signed
+// exponent.
+void decodeExponentialFilter(std::byte* pData, size_t count) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    uint32_t value;
+    std::memcpy(&value, pData + i * sizeof(value), sizeof(value));
+
+    const int32_t mantissa = static_cast<int32_t>(value << 8) >> 8;
+    const int32_t exponent = static_cast<int32_t>(value) >> 24;
+    const float result = std::ldexp(float(mantissa), exponent);
+
+    std::memcpy(pData + i * sizeof(result), &result, sizeof(result));
+  }
+}
+
+// A compressed buffer view and where its data is decoded to.
+struct MeshoptBufferView {
+  CesiumGltf::BufferView* pBufferView;
+  const ExtensionBufferViewExtMeshoptCompression* pMeshopt;
+  size_t count;
+  size_t stride;
+  gsl::span<const std::byte> source;
+  std::byte* pDestination;
+  std::string error;
+};
+
+bool isValidMode(
+    const ExtensionBufferViewExtMeshoptCompression& meshopt) noexcept {
+  const int64_t stride = meshopt.byteStride;
+  if (meshopt.mode == ExtensionBufferViewExtMeshoptCompression::Mode::
+                          ATTRIBUTES) {
+    return stride % 4 == 0 && stride <= 256;
+  }
+  if (meshopt.mode ==
+      ExtensionBufferViewExtMeshoptCompression::Mode::TRIANGLES) {
+    return meshopt.count % 3 == 0 && (stride == 2 || stride == 4);
+  }
+  if (meshopt.mode == ExtensionBufferViewExtMeshoptCompression::Mode::INDICES) {
+    return stride == 2 || stride == 4;
+  }
+  return false;
+}
+
+bool isValidFilter(
+    const ExtensionBufferViewExtMeshoptCompression& meshopt) noexcept {
+  using Filter = ExtensionBufferViewExtMeshoptCompression::Filter;
+
+  if (meshopt.filter == Filter::NONE) {
+    return true;
+  }
+  if (meshopt.mode !=
+      ExtensionBufferViewExtMeshoptCompression::Mode::ATTRIBUTES) {
+    return false;
+  }
+  if (meshopt.filter == Filter::OCTAHEDRAL) {
+    return meshopt.byteStride == 4 || meshopt.byteStride == 8;
+  }
+  if (meshopt.filter == Filter::QUATERNION) {
+    return meshopt.byteStride == 8;
+  }
+  return meshopt.filter == Filter::EXPONENTIAL;
+}
+
+void decodeBufferView(MeshoptBufferView& view) {
+  CESIUM_TRACE("CesiumGltfReader::decodeMeshoptBufferView");
+
+  using Filter = ExtensionBufferViewExtMeshoptCompression::Filter;
+  using Mode = ExtensionBufferViewExtMeshoptCompression::Mode;
+
+  const ExtensionBufferViewExtMeshoptCompression& meshopt = *view.pMeshopt;
+
+  bool success;
+  if (meshopt.mode == Mode::ATTRIBUTES) {
+    success = decodeVertexBuffer(
+        view.source,
+        view.pDestination,
+        view.count,
+        view.stride);
+  } else if (meshopt.mode == Mode::TRIANGLES) {
+    success = decodeIndexBuffer(
+        view.source,
+        view.pDestination,
+        view.count,
+        view.stride);
+  } else {
+    success = decodeIndexSequence(
+        view.source,
+        view.pDestination,
+        view.count,
+        view.stride);
+  }
+
+  if (!success) {
+    view.error = "EXT_meshopt_compression data of a bufferView with mode " +
+                 meshopt.mode + " could not be decoded.";
+    return;
+  }
+
+  if (meshopt.filter == Filter::OCTAHEDRAL) {
+    if (view.stride == 4) {
+      decodeOctahedralFilter<int8_t>(view.pDestination, view.count);
+    } else {
+      decodeOctahedralFilter<int16_t>(view.pDestination, view.count);
+    }
+  } else if (meshopt.filter == Filter::QUATERNION) {
+    decodeQuaternionFilter(view.pDestination, view.count);
+  } else if (meshopt.filter == Filter::EXPONENTIAL) {
+    decodeExponentialFilter(
+        view.pDestination,
+        view.count * view.stride / sizeof(uint32_t));
+  }
+}
+
+// Adds a compressed buffer view to the ones to decode, if its data is loaded
+// and it can be decoded into its buffer.
+void addMeshoptBufferView(
+    ModelReaderResult& readModel,
+    CesiumGltf::BufferView& bufferView,
+    const ExtensionBufferViewExtMeshoptCompression& meshopt,
+    std::vector<MeshoptBufferView>& views) {
+  CesiumGltf::Model& model = readModel.model.value();
+
+  const CesiumGltf::Buffer* pSourceBuffer =
+      CesiumGltf::Model::getSafe(&model.buffers, meshopt.buffer);
+  if (!pSourceBuffer) {
+    readModel.warnings.emplace_back(
+        "EXT_meshopt_compression buffer index is invalid.");
+    return;
+  }
+
+  const CesiumGltf::Buffer* pDestinationBuffer =
+      CesiumGltf::Model::getSafe(&model.buffers, bufferView.buffer);
+  if (!pDestinationBuffer) {
+    readModel.warnings.emplace_back(
+        "EXT_meshopt_compression bufferView has an invalid buffer index.");
+    return;
+  }
+
+  if (meshopt.buffer == bufferView.buffer) {
+    readModel.warnings.emplace_back(
+        "EXT_meshopt_compression bufferView decodes into the buffer that "
+        "holds its compressed data.");
+    return;
+  }
+
+  if (!isValidMode(meshopt) || !isValidFilter(meshopt)) {
+    readModel.warnings.emplace_back(
+        "EXT_meshopt_compression mode " + meshopt.mode + " with filter " +
+        meshopt.filter + " and byteStride " +
+        std::to_string(meshopt.byteStride) + " is not supported.");
+    return;
+  }
+
+  if (meshopt.byteStride <= 0 || meshopt.count < 0 ||
+      meshopt.count > std::numeric_limits<int64_t>::max() /
+                          meshopt.byteStride ||
+      bufferView.byteOffset < 0 ||
+      meshopt.count * meshopt.byteStride > bufferView.byteLength ||
+      bufferView.byteOffset + bufferView.byteLength >
+          pDestinationBuffer->byteLength) {
+    readModel.warnings.emplace_back(
+        "EXT_meshopt_compression decoded data doesn't fit in its bufferView.");
+    return;
+  }
+
+  // Compressed data in external buffers isn't loaded yet.
+  const int64_t sourceSize =
+      static_cast<int64_t>(pSourceBuffer->cesium.data.size());
+  if (sourceSize == 0) {
+    return;
+  }
+
+  if (meshopt.byteOffset < 0 || meshopt.byteLength < 0 ||
+      meshopt.byteOffset + meshopt.byteLength > sourceSize) {
+    readModel.warnings.emplace_back(
+        "EXT_meshopt_compression data extends beyond its buffer.");
+    return;
+  }
+
+  views.emplace_back(MeshoptBufferView{
+      &bufferView,
+      &meshopt,
+      static_cast<size_t>(meshopt.count),
+      static_cast<size_t>(meshopt.byteStride),
+      gsl::span<const std::byte>(),
+      nullptr,
+      ""});
+}
+} // namespace
+
+void decodeMeshopt(
+    ModelReaderResult& readModel,
+    const std::optional<CesiumAsync::AsyncSystem>& asyncSystem) {
+  CESIUM_TRACE("CesiumGltfReader::decodeMeshopt");
+  if (!readModel.model) {
+    return;
+  }
+
+  CesiumGltf::Model& model = readModel.model.value();
+
+  std::vector<MeshoptBufferView> views;
+  for (CesiumGltf::BufferView& bufferView : model.bufferViews) {
+    const ExtensionBufferViewExtMeshoptCompression* pMeshopt =
+        bufferView.getExtension<ExtensionBufferViewExtMeshoptCompression>();
+    if (pMeshopt) {
+      addMeshoptBufferView(readModel, bufferView, *pMeshopt, views);
+    }
+  }
+
+  if (views.empty()) {
+    return;
+  }
+
+  // Buffers that only exist as a fallback for compressed buffer views are
+  // allocated here and filled in by the decoders. Whether each of them may
+  // drop its URI depends on all of its buffer views decoding successfully.
+  std::unordered_map<int32_t, bool> allocatedBuffers;
+  for (MeshoptBufferView& view : views) {
+    CesiumGltf::Buffer& buffer =
+        model.buffers[size_t(view.pBufferView->buffer)];
+    const size_t byteLength = static_cast<size_t>(buffer.byteLength);
+    if (buffer.cesium.data.empty()) {
+      buffer.cesium.data.resize(byteLength);
+      allocatedBuffers.emplace(view.pBufferView->buffer, true);
+    } else if (buffer.cesium.data.size() < byteLength) {
+      view.error = "EXT_meshopt_compression bufferView decodes into a buffer "
+                   "that is smaller than its byteLength.";
+    }
+  }
+
+  // Only take pointers into the buffers once none of them is resized anymore.
+  for (MeshoptBufferView& view : views) {
+    const CesiumGltf::BufferView& bufferView = *view.pBufferView;
+    const ExtensionBufferViewExtMeshoptCompression& meshopt = *view.pMeshopt;
+    view.source = gsl::span<const std::byte>(
+        model.buffers[size_t(meshopt.buffer)].cesium.data.data() +
+            meshopt.byteOffset,
+        static_cast<size_t>(meshopt.byteLength));
+    view.pDestination =
+        model.buffers[size_t(bufferView.buffer)].cesium.data.data() +
+        bufferView.byteOffset;
+  }
+
+  parallelFor(asyncSystem, views.size(), [&views](size_t i) {
+    if (views[i].error.empty()) {
+      decodeBufferView(views[i]);
+    }
+  });
+
+  for (const MeshoptBufferView& view : views) {
+    if (!view.error.empty()) {
+      readModel.warnings.emplace_back(view.error);
+      auto it = allocatedBuffers.find(view.pBufferView->buffer);
+      if (it != allocatedBuffers.end()) {
+        it->second = false;
+      }
+    }
+  }
+
+  for (const MeshoptBufferView& view : views) {
+    auto it = allocatedBuffers.find(view.pBufferView->buffer);
+    if (view.error.empty() &&
+        (it == allocatedBuffers.end() || it->second)) {
+      view.pBufferView->extensions.erase(
+          ExtensionBufferViewExtMeshoptCompression::ExtensionName);
+    }
+  }
+
+  for (const std::pair<const int32_t, bool>& allocated : allocatedBuffers) {
+    CesiumGltf::Buffer& buffer = model.buffers[size_t(allocated.first)];
+    if (allocated.second) {
+      buffer.uri = std::nullopt;
+      buffer.extensions.erase(
+          CesiumGltf::ExtensionBufferExtMeshoptCompression::ExtensionName);
+    } else {
+      // Leave the buffer to be loaded from its URI, if it has one.
+      buffer.cesium.data.clear();
+      buffer.cesium.data.shrink_to_fit();
+    }
+  }
+}
+
+} // namespace CesiumGltfReader
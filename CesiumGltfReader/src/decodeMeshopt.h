@@ -0,0 +1,22 @@
+#pragma once
+
+#include <CesiumAsync/AsyncSystem.h>
+
+#include <optional>
+
+namespace CesiumGltfReader {
+struct ModelReaderResult;
+
+/**
+ * @brief Decodes the buffer views compressed with `EXT_meshopt_compression`
+ * straight into the buffers they refer to.
+ *
+ * Buffers that only exist as a fallback for compressed buffer views are
+ * allocated and filled in, and their `uri`, if any, is cleared so that they
+ * aren't loaded later. Buffer views whose compressed data isn't loaded yet are
+ * left alone.
+ */
+void decodeMeshopt(
+    ModelReaderResult& readModel,
+    const std::optional<CesiumAsync::AsyncSystem>& asyncSystem);
+} // namespace CesiumGltfReader
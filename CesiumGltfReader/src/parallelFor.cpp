@@ -0,0 +1,89 @@
+#include "parallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace CesiumAsync;
+
+namespace CesiumGltfReader {
+
+namespace {
+
+struct ParallelForState {
+  ParallelForState(size_t count_, const std::function<void(size_t)>& f_)
+      : count(count_), f(f_) {}
+
+  const size_t count;
+  const std::function<void(size_t)> f;
+
+  std::atomic<size_t> next{0};
+
+  std::mutex mutex;
+  std::condition_variable finishedCondition;
+  size_t finished = 0;
+  std::exception_ptr pException;
+
+  // Invokes the function for unclaimed indices until there are none left.
+  void work() {
+    for (size_t i = this->next++; i < this->count; i = this->next++) {
+      std::exception_ptr pCaught;
+      try {
+        this->f(i);
+      } catch (...) {
+        pCaught = std::current_exception();
+      }
+
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (pCaught && !this->pException) {
+        this->pException = pCaught;
+      }
+      if (++this->finished == this->count) {
+        this->finishedCondition.notify_all();
+      }
+    }
+  }
+};
+
+} // namespace
+
+void parallelFor(
+    const std::optional<AsyncSystem>& asyncSystem,
+    size_t count,
+    const std::function<void(size_t)>& f) {
+  if (!asyncSystem || count <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      f(i);
+    }
+    return;
+  }
+
+  // The state is shared with the worker tasks, because a task may only start
+  // after all of the work is done and this function has returned.
+  std::shared_ptr<ParallelForState> pState =
+      std::make_shared<ParallelForState>(count, f);
+
+  const size_t hardwareThreads =
+      std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+  const size_t workerTasks = std::min(count - 1, hardwareThreads - 1);
+  for (size_t i = 0; i < workerTasks; ++i) {
+    asyncSystem->runInWorkerThread([pState]() { pState->work(); });
+  }
+
+  pState->work();
+
+  std::unique_lock<std::mutex> lock(pState->mutex);
+  pState->finishedCondition.wait(lock, [&pState]() {
+    return pState->finished == pState->count;
+  });
+
+  if (pState->pException) {
+    std::rethrow_exception(pState->pException);
+  }
+}
+
+} // namespace CesiumGltfReader
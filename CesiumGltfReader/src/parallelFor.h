@@ -0,0 +1,34 @@
+#pragma once
+
+#include <CesiumAsync/AsyncSystem.h>
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+
+namespace CesiumGltfReader {
+
+/**
+ * @brief Invokes a function once for each index in `[0, count)`, using worker
+ * threads of the given async system in addition to the calling thread.
+ *
+ * The calling thread takes part in the work and only waits for invocations
+ * that a worker thread has already started, so this does not deadlock even if
+ * it is called from a worker thread and no other worker thread is available.
+ * If `asyncSystem` is `std::nullopt`, all invocations happen on the calling
+ * thread, in order.
+ *
+ * If an invocation throws, the remaining indices are still processed and the
+ * first exception is rethrown once all invocations are done.
+ *
+ * @param asyncSystem The async system whose worker threads may be used.
+ * @param count The number of indices.
+ * @param f The function to invoke with each index. It must be safe to invoke
+ * concurrently for different indices.
+ */
+void parallelFor(
+    const std::optional<CesiumAsync::AsyncSystem>& asyncSystem,
+    size_t count,
+    const std::function<void(size_t)>& f);
+
+} // namespace CesiumGltfReader
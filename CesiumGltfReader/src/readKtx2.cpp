@@ -0,0 +1,589 @@
+#include "readKtx2.h"
+
+#include "CesiumGltfReader/GltfReader.h"
+
+#include <CesiumGltf/GpuCompressedPixelFormat.h>
+#include <CesiumGltf/ImageCesium.h>
+#include <CesiumUtility/Tracing.h>
+
+#include <basisu_transcoder.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+
+using namespace CesiumGltf;
+
+namespace CesiumGltfReader {
+
+namespace {
+
+constexpr std::array<uint8_t, 12> ktx2Identifier{
+    0xAB,
+    0x4B,
+    0x54,
+    0x58,
+    0x20,
+    0x32,
+    0x30,
+    0xBB,
+    0x0D,
+    0x0A,
+    0x1A,
+    0x0A};
+
+#pragma pack(push, 1)
+struct Ktx2Header {
+  uint8_t identifier[12];
+  uint32_t vkFormat;
+  uint32_t typeSize;
+  uint32_t pixelWidth;
+  uint32_t pixelHeight;
+  uint32_t pixelDepth;
+  uint32_t layerCount;
+  uint32_t faceCount;
+  uint32_t levelCount;
+  uint32_t supercompressionScheme;
+  uint32_t dfdByteOffset;
+  uint32_t dfdByteLength;
+  uint32_t kvdByteOffset;
+  uint32_t kvdByteLength;
+  uint64_t sgdByteOffset;
+  uint64_t sgdByteLength;
+};
+
+struct Ktx2LevelIndex {
+  uint64_t byteOffset;
+  uint64_t byteLength;
+  uint64_t uncompressedByteLength;
+};
+#pragma pack(pop)
+
+constexpr uint32_t supercompressionNone = 0;
+constexpr uint32_t vkFormatUndefined = 0;
+constexpr size_t rgba8BytesPerPixel = 4;
+
+// Larger than any GPU can sample, and small enough that the number of pixels
+// of a level fits in the 32-bit sizes of the Basis Universal transcoder.
+constexpr uint32_t maximumDimension = 32768;
+
+std::optional<size_t> multiply(size_t a, size_t b) noexcept {
+  if (a != 0 && b > std::numeric_limits<size_t>::max() / a) {
+    return std::nullopt;
+  }
+  return a * b;
+}
+
+// Computes the number of bytes of a level without overflowing, or returns
+// std::nullopt if it doesn't fit in a size_t.
+std::optional<size_t> computeLevelByteSize(
+    GpuCompressedPixelFormat format,
+    size_t width,
+    size_t height) noexcept {
+  if (format == GpuCompressedPixelFormat::None) {
+    const std::optional<size_t> pixels = multiply(width, height);
+    return pixels ? multiply(*pixels, rgba8BytesPerPixel) : std::nullopt;
+  }
+
+  const std::optional<size_t> blocks =
+      multiply((width + 3) / 4, (height + 3) / 4);
+  return blocks ? multiply(*blocks, getBytesPerBlock(format)) : std::nullopt;
+}
+
+// Maps the Vulkan formats that can be read to a pixel format. 8-bit RGBA
+// images are not compressed.
+std::optional<GpuCompressedPixelFormat>
+getPixelFormat(uint32_t vkFormat) noexcept {
+  switch (vkFormat) {
+  case 37: // VK_FORMAT_R8G8B8A8_UNORM
+  case 43: // VK_FORMAT_R8G8B8A8_SRGB
+    return GpuCompressedPixelFormat::None;
+  case 131: // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+  case 132: // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+    return GpuCompressedPixelFormat::Bc1Rgb;
+  case 137: // VK_FORMAT_BC3_UNORM_BLOCK
+  case 138: // VK_FORMAT_BC3_SRGB_BLOCK
+    return GpuCompressedPixelFormat::Bc3Rgba;
+  case 139: // VK_FORMAT_BC4_UNORM_BLOCK
+    return GpuCompressedPixelFormat::Bc4R;
+  case 141: // VK_FORMAT_BC5_UNORM_BLOCK
+    return GpuCompressedPixelFormat::Bc5Rg;
+  case 145: // VK_FORMAT_BC7_UNORM_BLOCK
+  case 146: // VK_FORMAT_BC7_SRGB_BLOCK
+    return GpuCompressedPixelFormat::Bc7Rgba;
+  case 147: // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+  case 148: // VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK
+    return GpuCompressedPixelFormat::Etc2Rgb;
+  case 151: // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+  case 152: // VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK
+    return GpuCompressedPixelFormat::Etc2Rgba;
+  case 157: // VK_FORMAT_ASTC_4x4_UNORM_BLOCK
+  case 158: // VK_FORMAT_ASTC_4x4_SRGB_BLOCK
+    return GpuCompressedPixelFormat::Astc4x4Rgba;
+  default:
+    return std::nullopt;
+  }
+}
+
+bool isSupported(
+    const Ktx2TranscodeTargets& targets,
+    GpuCompressedPixelFormat format) noexcept {
+  switch (format) {
+  case GpuCompressedPixelFormat::Etc2Rgb:
+    return targets.etc2Rgb;
+  case GpuCompressedPixelFormat::Etc2Rgba:
+    return targets.etc2Rgba;
+  case GpuCompressedPixelFormat::Bc1Rgb:
+    return targets.bc1Rgb;
+  case GpuCompressedPixelFormat::Bc3Rgba:
+    return targets.bc3Rgba;
+  case GpuCompressedPixelFormat::Bc4R:
+    return targets.bc4R;
+  case GpuCompressedPixelFormat::Bc5Rg:
+    return targets.bc5Rg;
+  case GpuCompressedPixelFormat::Bc7Rgba:
+    return targets.bc7Rgba;
+  case GpuCompressedPixelFormat::Astc4x4Rgba:
+    return targets.astc4x4Rgba;
+  case GpuCompressedPixelFormat::None:
+  default:
+    return true;
+  }
+}
+
+bool canDecode(GpuCompressedPixelFormat format) noexcept {
+  return format == GpuCompressedPixelFormat::Bc1Rgb ||
+         format == GpuCompressedPixelFormat::Bc3Rgba ||
+         format == GpuCompressedPixelFormat::Bc4R ||
+         format == GpuCompressedPixelFormat::Bc5Rg;
+}
+
+uint8_t expand5(uint32_t value) noexcept {
+  return static_cast<uint8_t>((value << 3) | (value >> 2));
+}
+
+uint8_t expand6(uint32_t value) noexcept {
+  return static_cast<uint8_t>((value << 2) | (value >> 4));
+}
+
+// Decodes the 8-byte color part of a BC1, BC2 or BC3 block into 16 RGBA
+// pixels. Only BC1 uses the three-color mode with transparent black.
+void decodeBc1Block(
+    const uint8_t* pBlock,
+    bool allowThreeColorMode,
+    uint8_t* pPixels) noexcept {
+  const uint32_t c0 = uint32_t(pBlock[0]) | (uint32_t(pBlock[1]) << 8);
+  const uint32_t c1 = uint32_t(pBlock[2]) | (uint32_t(pBlock[3]) << 8);
+
+  uint8_t colors[4][4];
+  colors[0][0] = expand5(c0 >> 11);
+  colors[0][1] = expand6((c0 >> 5) & 0x3F);
+  colors[0][2] = expand5(c0 & 0x1F);
+  colors[0][3] = 255;
+  colors[1][0] = expand5(c1 >> 11);
+  colors[1][1] = expand6((c1 >> 5) & 0x3F);
+  colors[1][2] = expand5(c1 & 0x1F);
+  colors[1][3] = 255;
+
+  if (c0 > c1 || !allowThreeColorMode) {
+    for (size_t c = 0; c < 3; ++c) {
+      const uint32_t a = colors[0][c];
+      const uint32_t b = colors[1][c];
+      colors[2][c] = static_cast<uint8_t>((2 * a + b) / 3);
+      colors[3][c] = static_cast<uint8_t>((a + 2 * b) / 3);
+    }
+    colors[2][3] = 255;
+    colors[3][3] = 255;
+  } else {
+    for (size_t c = 0; c < 3; ++c) {
+      const uint32_t a = colors[0][c];
+      const uint32_t b = colors[1][c];
+      colors[2][c] = static_cast<uint8_t>((a + b) / 2);
+      colors[3][c] = 0;
+    }
+    colors[2][3] = 255;
+    colors[3][3] = 0;
+  }
+
+  const uint32_t indices = uint32_t(pBlock[4]) | (uint32_t(pBlock[5]) << 8) |
+                           (uint32_t(pBlock[6]) << 16) |
+                           (uint32_t(pBlock[7]) << 24);
+  for (size_t i = 0; i < 16; ++i) {
+    const uint32_t index = (indices >> (2 * i)) & 3;
+    std::memcpy(pPixels + i * rgba8BytesPerPixel, colors[index], 4);
+  }
+}
+
+// Decodes an 8-byte BC4 block, which is also the alpha part of a BC3 block,
+// into one channel of 16 RGBA pixels.
+void decodeBc4Block(const uint8_t* pBlock, uint8_t* pChannel) noexcept {
+  const uint32_t r0 = pBlock[0];
+  const uint32_t r1 = pBlock[1];
+
+  uint8_t values[8];
+  values[0] = static_cast<uint8_t>(r0);
+  values[1] = static_cast<uint8_t>(r1);
+  if (r0 > r1) {
+    for (uint32_t i = 1; i < 7; ++i) {
+      values[i + 1] = static_cast<uint8_t>(((7 - i) * r0 + i * r1) / 7);
+    }
+  } else {
+    for (uint32_t i = 1; i < 5; ++i) {
+      values[i + 1] = static_cast<uint8_t>(((5 - i) * r0 + i * r1) / 5);
+    }
+    values[6] = 0;
+    values[7] = 255;
+  }
+
+  uint64_t indices = 0;
+  for (size_t i = 0; i < 6; ++i) {
+    indices |= uint64_t(pBlock[2 + i]) << (8 * i);
+  }
+  for (size_t i = 0; i < 16; ++i) {
+    pChannel[i * rgba8BytesPerPixel] = values[(indices >> (3 * i)) & 7];
+  }
+}
+
+// Decodes a BC1, BC3, BC4 or BC5 image into tightly-packed 8-bit RGBA pixels.
+void decodeBlocks(
+    GpuCompressedPixelFormat format,
+    const uint8_t* pSource,
+    size_t width,
+    size_t height,
+    uint8_t* pTarget) noexcept {
+  const size_t bytesPerBlock = getBytesPerBlock(format);
+  uint8_t block[16 * rgba8BytesPerPixel];
+
+  for (size_t blockY = 0; blockY < height; blockY += 4) {
+    for (size_t blockX = 0; blockX < width; blockX += 4) {
+      switch (format) {
+      case GpuCompressedPixelFormat::Bc1Rgb:
+        decodeBc1Block(pSource, true, block);
+        break;
+      case GpuCompressedPixelFormat::Bc3Rgba:
+        decodeBc1Block(pSource + 8, false, block);
+        decodeBc4Block(pSource, block + 3);
+        break;
+      case GpuCompressedPixelFormat::Bc4R:
+      case GpuCompressedPixelFormat::Bc5Rg:
+        for (size_t i = 0; i < 16; ++i) {
+          uint8_t* pPixel = block + i * rgba8BytesPerPixel;
+          pPixel[1] = 0;
+          pPixel[2] = 0;
+          pPixel[3] = 255;
+        }
+        decodeBc4Block(pSource, block);
+        if (format == GpuCompressedPixelFormat::Bc5Rg) {
+          decodeBc4Block(pSource + 8, block + 1);
+        }
+        break;
+      default:
+        assert(false);
+        return;
+      }
+      pSource += bytesPerBlock;
+
+      // Blocks on the right and bottom edges may be partially outside of the
+      // image.
+      const size_t columns = std::min(width - blockX, size_t(4));
+      const size_t rows = std::min(height - blockY, size_t(4));
+      for (size_t y = 0; y < rows; ++y) {
+        std::memcpy(
+            pTarget + ((blockY + y) * width + blockX) * rgba8BytesPerPixel,
+            block + y * 4 * rgba8BytesPerPixel,
+            columns * rgba8BytesPerPixel);
+      }
+    }
+  }
+}
+
+ImageReaderResult failed(std::string&& error) {
+  ImageReaderResult result;
+  result.errors.emplace_back(std::move(error));
+  return result;
+}
+
+// Chooses the format to transcode a Basis Universal image to. ETC1S images
+// transcode to ETC1, which is a subset of ETC2, without any loss, and UASTC
+// images transcode to ASTC 4x4 without any loss, so those are preferred.
+// BC7 is next, because it is close in quality to both. 8-bit RGBA is used if
+// the renderer supports none of the candidates.
+GpuCompressedPixelFormat chooseTranscodeTarget(
+    const Ktx2TranscodeTargets& targets,
+    bool isUastc,
+    bool hasAlpha) noexcept {
+  using Format = GpuCompressedPixelFormat;
+  const Format etc2 = hasAlpha ? Format::Etc2Rgba : Format::Etc2Rgb;
+  const Format bc = hasAlpha ? Format::Bc3Rgba : Format::Bc1Rgb;
+  const std::array<Format, 4> candidates =
+      isUastc ? std::array{Format::Astc4x4Rgba, Format::Bc7Rgba, etc2, bc}
+              : std::array{etc2, Format::Bc7Rgba, bc, Format::Astc4x4Rgba};
+
+  for (Format candidate : candidates) {
+    if (isSupported(targets, candidate)) {
+      return candidate;
+    }
+  }
+  return GpuCompressedPixelFormat::None;
+}
+
+basist::transcoder_texture_format
+getBasisFormat(GpuCompressedPixelFormat format) noexcept {
+  switch (format) {
+  case GpuCompressedPixelFormat::Etc2Rgb:
+    return basist::transcoder_texture_format::cTFETC1_RGB;
+  case GpuCompressedPixelFormat::Etc2Rgba:
+    return basist::transcoder_texture_format::cTFETC2_RGBA;
+  case GpuCompressedPixelFormat::Bc1Rgb:
+    return basist::transcoder_texture_format::cTFBC1_RGB;
+  case GpuCompressedPixelFormat::Bc3Rgba:
+    return basist::transcoder_texture_format::cTFBC3_RGBA;
+  case GpuCompressedPixelFormat::Bc4R:
+    return basist::transcoder_texture_format::cTFBC4_R;
+  case GpuCompressedPixelFormat::Bc5Rg:
+    return basist::transcoder_texture_format::cTFBC5_RG;
+  case GpuCompressedPixelFormat::Bc7Rgba:
+    return basist::transcoder_texture_format::cTFBC7_RGBA;
+  case GpuCompressedPixelFormat::Astc4x4Rgba:
+    return basist::transcoder_texture_format::cTFASTC_4x4_RGBA;
+  case GpuCompressedPixelFormat::None:
+  default:
+    return basist::transcoder_texture_format::cTFRGBA32;
+  }
+}
+
+// Transcodes an ETC1S (BasisLZ) or UASTC image, including all of its mip
+// levels, with the Basis Universal transcoder.
+ImageReaderResult transcodeBasisUniversal(
+    const gsl::span<const std::byte>& data,
+    const Ktx2TranscodeTargets& ktx2TranscodeTargets) {
+  CESIUM_TRACE("CesiumGltfReader::transcodeBasisUniversal");
+
+  // The transcoder's tables only need to be initialized once per process.
+  static const bool initialized = []() {
+    basist::basisu_transcoder_init();
+    return true;
+  }();
+  (void)initialized;
+
+  basist::ktx2_transcoder transcoder;
+  if (data.size() > std::numeric_limits<uint32_t>::max() ||
+      !transcoder.init(data.data(), static_cast<uint32_t>(data.size())) ||
+      !transcoder.start_transcoding()) {
+    return failed("KTX2 image could not be read by the Basis Universal "
+                  "transcoder.");
+  }
+
+  if (transcoder.get_faces() != 1 || transcoder.get_layers() > 1) {
+    return failed("Only 2D KTX2 images are supported.");
+  }
+
+  const GpuCompressedPixelFormat format = chooseTranscodeTarget(
+      ktx2TranscodeTargets,
+      transcoder.is_uastc(),
+      transcoder.get_has_alpha());
+  const basist::transcoder_texture_format basisFormat = getBasisFormat(format);
+
+  ImageReaderResult result;
+  ImageCesium& image = result.image.emplace();
+  image.width = static_cast<int32_t>(transcoder.get_width());
+  image.height = static_cast<int32_t>(transcoder.get_height());
+  image.channels = 4;
+  image.bytesPerChannel = 1;
+  image.compressedPixelFormat = format;
+
+  const uint32_t levelCount = std::max(transcoder.get_levels(), uint32_t(1));
+  for (uint32_t level = 0; level < levelCount; ++level) {
+    basist::ktx2_image_level_info levelInfo;
+    if (!transcoder.get_image_level_info(levelInfo, level, 0, 0)) {
+      result.image.reset();
+      result.errors.emplace_back(
+          "KTX2 image level " + std::to_string(level) + " is invalid.");
+      return result;
+    }
+
+    // Uncompressed output is sized in pixels, and compressed output in blocks.
+    const uint32_t outputSize =
+        format == GpuCompressedPixelFormat::None
+            ? levelInfo.m_orig_width * levelInfo.m_orig_height
+            : levelInfo.m_total_blocks;
+    const std::optional<size_t> byteSize = computeLevelByteSize(
+        format,
+        levelInfo.m_orig_width,
+        levelInfo.m_orig_height);
+    if (!byteSize) {
+      result.image.reset();
+      result.errors.emplace_back(
+          "KTX2 image level " + std::to_string(level) + " is too large.");
+      return result;
+    }
+
+    const size_t byteOffset = image.pixelData.size();
+    image.pixelData.resize(byteOffset + *byteSize);
+    if (!transcoder.transcode_image_level(
+            level,
+            0,
+            0,
+            image.pixelData.data() + byteOffset,
+            outputSize,
+            basisFormat)) {
+      result.image.reset();
+      result.errors.emplace_back(
+          "KTX2 image level " + std::to_string(level) +
+          " could not be transcoded.");
+      return result;
+    }
+
+    if (levelCount > 1) {
+      image.mipPositions.push_back({byteOffset, *byteSize});
+    }
+  }
+
+  return result;
+}
+
+} // namespace
+
+bool isKtx2(const gsl::span<const std::byte>& data) noexcept {
+  return data.size() >= ktx2Identifier.size() &&
+         std::memcmp(
+             data.data(),
+             ktx2Identifier.data(),
+             ktx2Identifier.size()) == 0;
+}
+
+ImageReaderResult readKtx2(
+    const gsl::span<const std::byte>& data,
+    const Ktx2TranscodeTargets& ktx2TranscodeTargets) {
+  CESIUM_TRACE("CesiumGltfReader::readKtx2");
+
+  Ktx2Header header;
+  if (data.size() < sizeof(header)) {
+    return failed("KTX2 image is too short to hold its header.");
+  }
+  std::memcpy(&header, data.data(), sizeof(header));
+
+  if (header.pixelWidth == 0 || header.pixelHeight == 0 ||
+      header.pixelDepth != 0 || header.layerCount > 1 ||
+      header.faceCount != 1) {
+    return failed("Only 2D KTX2 images are supported.");
+  }
+
+  if (header.pixelWidth > maximumDimension ||
+      header.pixelHeight > maximumDimension) {
+    return failed(
+        "KTX2 image is " + std::to_string(header.pixelWidth) + "x" +
+        std::to_string(header.pixelHeight) +
+        " pixels, which is larger than the maximum of " +
+        std::to_string(maximumDimension) + " pixels in each direction.");
+  }
+
+  // Basis Universal images, either ETC1S with BasisLZ supercompression or
+  // UASTC with optional Zstandard supercompression, have no Vulkan format.
+  if (header.vkFormat == vkFormatUndefined) {
+    return transcodeBasisUniversal(data, ktx2TranscodeTargets);
+  }
+
+  if (header.supercompressionScheme != supercompressionNone) {
+    return failed(
+        "KTX2 image uses supercompression scheme " +
+        std::to_string(header.supercompressionScheme) +
+        ", which is only supported for Basis Universal images.");
+  }
+
+  const std::optional<GpuCompressedPixelFormat> maybeFormat =
+      getPixelFormat(header.vkFormat);
+  if (!maybeFormat) {
+    return failed(
+        "KTX2 image has Vulkan format " + std::to_string(header.vkFormat) +
+        ", which is not supported.");
+  }
+
+  const GpuCompressedPixelFormat format = *maybeFormat;
+  const bool decode = !isSupported(ktx2TranscodeTargets, format);
+  if (decode && !canDecode(format)) {
+    return failed(
+        "KTX2 image has Vulkan format " + std::to_string(header.vkFormat) +
+        ", which is not supported by the renderer and cannot be decoded.");
+  }
+
+  // A level count of 0 asks the reader to generate the mip levels, which
+  // isn't done here.
+  const size_t levelCount = std::max(header.levelCount, uint32_t(1));
+  const size_t levelIndexEnd =
+      sizeof(header) + levelCount * sizeof(Ktx2LevelIndex);
+  if (levelCount > 32 || data.size() < levelIndexEnd) {
+    return failed("KTX2 image has an invalid level index.");
+  }
+
+  ImageReaderResult result;
+  ImageCesium& image = result.image.emplace();
+  image.width = static_cast<int32_t>(header.pixelWidth);
+  image.height = static_cast<int32_t>(header.pixelHeight);
+  image.channels = 4;
+  image.bytesPerChannel = 1;
+  image.compressedPixelFormat =
+      decode ? GpuCompressedPixelFormat::None : format;
+
+  size_t width = header.pixelWidth;
+  size_t height = header.pixelHeight;
+  for (size_t level = 0; level < levelCount; ++level) {
+    Ktx2LevelIndex index;
+    std::memcpy(
+        &index,
+        data.data() + sizeof(header) + level * sizeof(Ktx2LevelIndex),
+        sizeof(index));
+
+    const std::optional<size_t> expectedByteLength =
+        computeLevelByteSize(format, width, height);
+    const std::optional<size_t> decodedByteLength =
+        decode ? computeLevelByteSize(
+                     GpuCompressedPixelFormat::None,
+                     width,
+                     height)
+               : expectedByteLength;
+    if (!expectedByteLength || !decodedByteLength ||
+        index.byteLength != *expectedByteLength ||
+        index.byteOffset > data.size() ||
+        index.byteLength > data.size() - index.byteOffset) {
+      result.image.reset();
+      result.errors.emplace_back(
+          "KTX2 image level " + std::to_string(level) + " is invalid.");
+      return result;
+    }
+
+    const std::byte* pLevel = data.data() + index.byteOffset;
+    const size_t byteOffset = image.pixelData.size();
+    if (decode) {
+      image.pixelData.resize(byteOffset + *decodedByteLength);
+      decodeBlocks(
+          format,
+          reinterpret_cast<const uint8_t*>(pLevel),
+          width,
+          height,
+          reinterpret_cast<uint8_t*>(image.pixelData.data() + byteOffset));
+    } else {
+      image.pixelData.insert(
+          image.pixelData.end(),
+          pLevel,
+          pLevel + *expectedByteLength);
+    }
+
+    if (levelCount > 1) {
+      image.mipPositions.push_back(
+          {byteOffset, image.pixelData.size() - byteOffset});
+    }
+
+    width = std::max(width / 2, size_t(1));
+    height = std::max(height / 2, size_t(1));
+  }
+
+  return result;
+}
+
+} // namespace CesiumGltfReader
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <gsl/span>
+
+#include <cstddef>
+
+namespace CesiumGltfReader {
+struct ImageReaderResult;
+struct Ktx2TranscodeTargets;
+
+/**
+ * @brief Determines whether a buffer starts with the KTX2 file identifier.
+ */
+bool isKtx2(const gsl::span<const std::byte>& data) noexcept;
+
+/**
+ * @brief Reads a KTX2 image, including all of its mip levels.
+ *
+ * Block-compressed images are kept in their format if the renderer supports
+ * it, and decoded to 8-bit RGBA otherwise, if possible. Basis Universal
+ * images are transcoded to the best format that the renderer supports.
+ */
+ImageReaderResult readKtx2(
+    const gsl::span<const std::byte>& data,
+    const Ktx2TranscodeTargets& ktx2TranscodeTargets);
+} // namespace CesiumGltfReader
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <CesiumAsync/ITaskProcessor.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A task processor that runs each task in its own detached thread.
+ */
+class ThreadTaskProcessor : public CesiumAsync::ITaskProcessor {
+public:
+  virtual void startTask(std::function<void()> f) override {
+    std::thread(f).detach();
+  }
+};
+
+/**
+ * @brief Appends a little-endian 32-bit value to the data.
+ */
+inline void appendUint32(std::vector<std::byte>& data, uint32_t value) {
+  const size_t offset = data.size();
+  data.resize(offset + sizeof(value));
+  std::memcpy(data.data() + offset, &value, sizeof(value));
+}
+
+/**
+ * @brief Appends a little-endian 64-bit value to the data.
+ */
+inline void appendUint64(std::vector<std::byte>& data, uint64_t value) {
+  const size_t offset = data.size();
+  data.resize(offset + sizeof(value));
+  std::memcpy(data.data() + offset, &value, sizeof(value));
+}
+
+/**
+ * @brief Creates a GLB with the given JSON chunk and binary chunk.
+ *
+ * Both chunks are padded to a multiple of four bytes.
+ */
+inline std::vector<std::byte>
+createGlb(std::string json, const std::vector<std::byte>& binary) {
+  while (json.size() % 4 != 0) {
+    json += ' ';
+  }
+
+  const size_t binaryLength = (binary.size() + 3) & ~size_t(3);
+  const size_t length = 12 + 8 + json.size() + 8 + binaryLength;
+
+  std::vector<std::byte> glb;
+  glb.reserve(length);
+  appendUint32(glb, 0x46546C67);
+  appendUint32(glb, 2);
+  appendUint32(glb, static_cast<uint32_t>(length));
+
+  appendUint32(glb, static_cast<uint32_t>(json.size()));
+  appendUint32(glb, 0x4E4F534A);
+  for (char c : json) {
+    glb.push_back(std::byte(c));
+  }
+
+  appendUint32(glb, static_cast<uint32_t>(binaryLength));
+  appendUint32(glb, 0x004E4942);
+  glb.insert(glb.end(), binary.begin(), binary.end());
+  glb.resize(length);
+
+  return glb;
+}
@@ -0,0 +1,241 @@
+#include "CesiumGltfReader/GltfReader.h"
+#include "GltfReaderTestHelpers.h"
+
+#include <CesiumGltf/AccessorView.h>
+
+#include <catch2/catch.hpp>
+#include <glm/vec3.hpp>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4127 4018 4804)
+#endif
+
+#include <draco/compression/encode.h>
+#include <draco/mesh/triangle_soup_mesh_builder.h>
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace CesiumGltf;
+using namespace CesiumGltfReader;
+
+namespace {
+
+std::vector<std::byte> readFile(const std::filesystem::path& fileName) {
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  REQUIRE(file);
+
+  std::streamsize size = file.tellg();
+  file.seekg(0, std::ios::beg);
+
+  std::vector<std::byte> buffer(static_cast<size_t>(size));
+  file.read(reinterpret_cast<char*>(buffer.data()), size);
+
+  return buffer;
+}
+
+// Creates a GLB with a grid of triangles, compressed with Draco, that is used
+// by two primitives.
+std::vector<std::byte>
+createDracoGlb(uint32_t gridSize, std::vector<glm::vec3>& expectedPositions) {
+  const uint32_t faceCount = gridSize * gridSize * 2;
+
+  draco::TriangleSoupMeshBuilder builder;
+  builder.Start(static_cast<int>(faceCount));
+  const int positionId = builder.AddAttribute(
+      draco::GeometryAttribute::POSITION,
+      3,
+      draco::DT_FLOAT32);
+
+  expectedPositions.clear();
+  uint32_t face = 0;
+  for (uint32_t y = 0; y < gridSize; ++y) {
+    for (uint32_t x = 0; x < gridSize; ++x) {
+      const glm::vec3 p00(float(x), float(y), 0.0f);
+      const glm::vec3 p10(float(x + 1), float(y), 0.0f);
+      const glm::vec3 p01(float(x), float(y + 1), 0.0f);
+      const glm::vec3 p11(float(x + 1), float(y + 1), 1.0f);
+
+      builder.SetAttributeValuesForFace(
+          positionId,
+          draco::FaceIndex(face++),
+          &p00,
+          &p10,
+          &p11);
+      builder.SetAttributeValuesForFace(
+          positionId,
+          draco::FaceIndex(face++),
+          &p00,
+          &p11,
+          &p01);
+      expectedPositions.insert(
+          expectedPositions.end(),
+          {p00, p10, p11, p00, p11, p01});
+    }
+  }
+
+  std::unique_ptr<draco::Mesh> pMesh = builder.Finalize();
+  REQUIRE(pMesh);
+
+  // Sequential encoding without quantization keeps the faces in order and the
+  // positions exact.
+  draco::Encoder encoder;
+  encoder.SetEncodingMethod(draco::MESH_SEQUENTIAL_ENCODING);
+  draco::EncoderBuffer encoded;
+  REQUIRE(encoder.EncodeMeshToBuffer(*pMesh, &encoded).ok());
+
+  std::vector<std::byte> binary(encoded.size());
+  std::memcpy(binary.data(), encoded.data(), encoded.size());
+
+  const std::string uniqueId =
+      std::to_string(pMesh->attribute(positionId)->unique_id());
+  const std::string primitive = R"(
+    {
+      "attributes": { "POSITION": 1 },
+      "indices": 0,
+      "extensions": {
+        "KHR_draco_mesh_compression": {
+          "bufferView": 0,
+          "attributes": { "POSITION": )" + uniqueId +
+                                R"( }
+        }
+      }
+    })";
+
+  const std::string json = R"(
+    {
+      "asset": { "version": "2.0" },
+      "extensionsUsed": [ "KHR_draco_mesh_compression" ],
+      "extensionsRequired": [ "KHR_draco_mesh_compression" ],
+      "buffers": [ { "byteLength": )" +
+                           std::to_string(binary.size()) + R"( } ],
+      "bufferViews": [
+        { "buffer": 0, "byteOffset": 0, "byteLength": )" +
+                           std::to_string(binary.size()) + R"( }
+      ],
+      "accessors": [
+        { "componentType": 5125, "count": )" +
+                           std::to_string(faceCount * 3) + R"(, "type": "SCALAR" },
+        { "componentType": 5126, "count": )" +
+                           std::to_string(pMesh->num_points()) +
+                           R"(, "type": "VEC3" }
+      ],
+      "meshes": [ { "primitives": [ )" +
+                           primitive + "," + primitive + R"( ] } ]
+    })";
+
+  return createGlb(json, binary);
+}
+
+void checkDecodedModel(
+    const ModelReaderResult& result,
+    const std::vector<glm::vec3>& expectedPositions) {
+  CHECK(result.errors.empty());
+  CHECK(result.warnings.empty());
+  REQUIRE(result.model);
+
+  const Model& model = *result.model;
+  REQUIRE(model.meshes.size() == 1);
+  REQUIRE(model.meshes[0].primitives.size() == 2);
+
+  // Both primitives share the accessors, so the decoded data is written to a
+  // single new buffer only once.
+  REQUIRE(model.buffers.size() == 2);
+  REQUIRE(model.bufferViews.size() == 3);
+  CHECK(model.bufferViews[1].buffer == 1);
+  CHECK(model.bufferViews[2].buffer == 1);
+  CHECK(model.bufferViews[1].byteOffset % 4 == 0);
+  CHECK(model.bufferViews[2].byteOffset % 4 == 0);
+
+  for (const MeshPrimitive& primitive : model.meshes[0].primitives) {
+    AccessorView<uint32_t> indices(model, primitive.indices);
+    AccessorView<glm::vec3> positions(
+        model,
+        primitive.attributes.at("POSITION"));
+    REQUIRE(indices.status() == AccessorViewStatus::Valid);
+    REQUIRE(positions.status() == AccessorViewStatus::Valid);
+    REQUIRE(indices.size() == int64_t(expectedPositions.size()));
+
+    for (int64_t i = 0; i < indices.size(); ++i) {
+      const uint32_t index = indices[i];
+      REQUIRE(int64_t(index) < positions.size());
+      CHECK(positions[int64_t(index)] == expectedPositions[size_t(i)]);
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("Decodes KHR_draco_mesh_compression primitives") {
+  std::vector<glm::vec3> expectedPositions;
+  const std::vector<std::byte> glb = createDracoGlb(100, expectedPositions);
+
+  GltfReader reader;
+
+  SECTION("on the calling thread") {
+    ModelReaderResult result = reader.readModel(glb);
+    checkDecodedModel(result, expectedPositions);
+  }
+
+  SECTION("with worker threads") {
+    ReadModelOptions options;
+    options.asyncSystem =
+        AsyncSystem(std::make_shared<ThreadTaskProcessor>());
+    ModelReaderResult result = reader.readModel(glb, options);
+    checkDecodedModel(result, expectedPositions);
+  }
+}
+
+// Run with `cesium-native-tests "[.benchmark]"` after pointing the
+// CESIUM_NATIVE_DRACO_BENCHMARK_DIR environment variable at a directory of
+// Draco-compressed GLB files.
+TEST_CASE("Benchmark Draco decoding", "[.benchmark]") {
+  const char* pDirectory = std::getenv("CESIUM_NATIVE_DRACO_BENCHMARK_DIR");
+  if (!pDirectory) {
+    WARN("CESIUM_NATIVE_DRACO_BENCHMARK_DIR is not set.");
+    return;
+  }
+
+  std::vector<std::vector<std::byte>> files;
+  for (const std::filesystem::directory_entry& entry :
+       std::filesystem::directory_iterator(pDirectory)) {
+    if (entry.path().extension() == ".glb") {
+      files.emplace_back(readFile(entry.path()));
+    }
+  }
+  REQUIRE(!files.empty());
+
+  GltfReader reader;
+
+  ReadModelOptions serialOptions;
+
+  ReadModelOptions parallelOptions;
+  parallelOptions.asyncSystem =
+      AsyncSystem(std::make_shared<ThreadTaskProcessor>());
+
+  BENCHMARK("serial") {
+    size_t count = 0;
+    for (const std::vector<std::byte>& file : files) {
+      count += reader.readModel(file, serialOptions).model ? 1 : 0;
+    }
+    return count;
+  };
+
+  BENCHMARK("parallel") {
+    size_t count = 0;
+    for (const std::vector<std::byte>& file : files) {
+      count += reader.readModel(file, parallelOptions).model ? 1 : 0;
+    }
+    return count;
+  };
+}
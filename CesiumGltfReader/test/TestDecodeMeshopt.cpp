@@ -0,0 +1,594 @@
+#include "CesiumGltfReader/GltfReader.h"
+#include "GltfReaderTestHelpers.h"
+
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/ExtensionBufferExtMeshoptCompression.h>
+#include <CesiumGltf/ExtensionBufferViewExtMeshoptCompression.h>
+
+#include <catch2/catch.hpp>
+#include <glm/geometric.hpp>
+#include <glm/vec3.hpp>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4127 4018 4804)
+#endif
+
+#include <draco/compression/encode.h>
+#include <draco/mesh/triangle_soup_mesh_builder.h>
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace CesiumGltf;
+using namespace CesiumGltfReader;
+
+namespace {
+
+template <typename T> std::vector<std::byte> toBytes(const std::vector<T>& v) {
+  std::vector<std::byte> result(v.size() * sizeof(T));
+  std::memcpy(result.data(), v.data(), result.size());
+  return result;
+}
+
+uint32_t zigzag(uint32_t v) {
+  return (v << 1) ^ static_cast<uint32_t>(static_cast<int32_t>(v) >> 31);
+}
+
+void appendVByte(std::vector<std::byte>& data, uint32_t v) {
+  while (v >= 128) {
+    data.push_back(std::byte((v & 127) | 128));
+    v >>= 7;
+  }
+  data.push_back(std::byte(v));
+}
+
+// Encodes vertices the way the EXT_meshopt_compression specification
+// describes, choosing the smallest encoding for each group of 16 bytes.
+std::vector<std::byte>
+encodeVertexBuffer(const std::vector<std::byte>& vertices, size_t stride) {
+  const size_t count = vertices.size() / stride;
+  const size_t blockSize =
+      std::min((8192 / stride) & ~size_t(15), size_t(256));
+
+  std::vector<std::byte> data{std::byte(0xA0)};
+  std::vector<std::byte> last(stride);
+  std::copy(vertices.begin(), vertices.begin() + int64_t(stride), last.begin());
+
+  for (size_t offset = 0; offset < count; offset += blockSize) {
+    const size_t blockCount = std::min(blockSize, count - offset);
+    const size_t alignedCount = (blockCount + 15) & ~size_t(15);
+
+    for (size_t k = 0; k < stride; ++k) {
+      std::vector<uint8_t> deltas(alignedCount);
+      for (size_t i = 0; i < blockCount; ++i) {
+        const std::byte value = vertices[(offset + i) * stride + k];
+        const uint8_t delta = uint8_t(uint8_t(value) - uint8_t(last[k]));
+        deltas[i] = uint8_t((delta << 1) ^ (int8_t(delta) >> 7));
+        last[k] = value;
+      }
+
+      const size_t headerOffset = data.size();
+      data.resize(data.size() + (alignedCount / 16 + 3) / 4);
+
+      for (size_t group = 0; group < alignedCount / 16; ++group) {
+        const uint8_t* pGroup = deltas.data() + group * 16;
+        const auto countAtLeast = [pGroup](uint8_t min) {
+          return size_t(std::count_if(pGroup, pGroup + 16, [min](uint8_t d) {
+            return d >= min;
+          }));
+        };
+
+        const size_t sizes[4] = {
+            countAtLeast(1) == 0 ? 0 : SIZE_MAX,
+            4 + countAtLeast(3),
+            8 + countAtLeast(15),
+            16};
+        const uint32_t bitsLog2 =
+            uint32_t(std::min_element(sizes, sizes + 4) - sizes);
+        data[headerOffset + group / 4] |=
+            std::byte(bitsLog2 << ((group % 4) * 2));
+
+        if (bitsLog2 == 1 || bitsLog2 == 2) {
+          const uint32_t bits = 1U << bitsLog2;
+          const uint32_t escape = (1U << bits) - 1;
+          const size_t valuesPerByte = 8 / bits;
+          std::vector<std::byte> packed(16 / valuesPerByte);
+          std::vector<std::byte> escaped;
+          for (size_t i = 0; i < 16; ++i) {
+            const uint32_t value = std::min(uint32_t(pGroup[i]), escape);
+            const uint32_t shift = 8 - bits * (uint32_t(i % valuesPerByte) + 1);
+            packed[i / valuesPerByte] |= std::byte(value << shift);
+            if (value == escape) {
+              escaped.push_back(std::byte(pGroup[i]));
+            }
+          }
+          data.insert(data.end(), packed.begin(), packed.end());
+          data.insert(data.end(), escaped.begin(), escaped.end());
+        } else if (bitsLog2 == 3) {
+          for (size_t i = 0; i < 16; ++i) {
+            data.push_back(std::byte(pGroup[i]));
+          }
+        }
+      }
+    }
+  }
+
+  // The tail holds the first vertex, which is the baseline for the deltas.
+  data.resize(data.size() + std::max(stride, size_t(32)) - stride);
+  data.insert(
+      data.end(),
+      vertices.begin(),
+      vertices.begin() + int64_t(stride));
+  return data;
+}
+
+// Encodes every triangle with explicit indices. That is the least compact
+// encoding, but it is valid and simple.
+std::vector<std::byte> encodeIndexBuffer(const std::vector<uint32_t>& indices) {
+  std::vector<std::byte> data{std::byte(0xE1)};
+  data.resize(1 + indices.size() / 3, std::byte(0xFF));
+
+  uint32_t last = 0;
+  for (size_t i = 0; i < indices.size(); i += 3) {
+    data.push_back(std::byte(0xFF));
+    for (size_t j = i; j < i + 3; ++j) {
+      appendVByte(data, zigzag(indices[j] - last));
+      last = indices[j];
+    }
+  }
+
+  data.resize(data.size() + 16);
+  return data;
+}
+
+std::vector<std::byte>
+encodeIndexSequence(const std::vector<uint32_t>& indices) {
+  std::vector<std::byte> data{std::byte(0xD1)};
+
+  uint32_t last = 0;
+  for (uint32_t index : indices) {
+    appendVByte(data, zigzag(index - last) << 1);
+    last = index;
+  }
+
+  data.resize(data.size() + 4);
+  return data;
+}
+
+struct CompressedBufferView {
+  std::vector<std::byte> data;
+  size_t count;
+  size_t stride;
+  std::string mode;
+  std::string filter = ExtensionBufferViewExtMeshoptCompression::Filter::NONE;
+};
+
+// Creates a GLB whose binary chunk holds the compressed buffer views, which
+// are decoded into a second, fallback buffer that has no data of its own.
+std::vector<std::byte> createMeshoptGlb(
+    const std::vector<CompressedBufferView>& views,
+    const std::string& extraJson = "") {
+  std::vector<std::byte> binary;
+  size_t fallbackLength = 0;
+  std::string bufferViews;
+
+  for (const CompressedBufferView& view : views) {
+    const size_t byteLength = view.count * view.stride;
+    if (!bufferViews.empty()) {
+      bufferViews += ",";
+    }
+    bufferViews += "{\"buffer\": 1";
+    bufferViews += ", \"byteOffset\": " + std::to_string(fallbackLength);
+    bufferViews += ", \"byteLength\": " + std::to_string(byteLength);
+    bufferViews += ", \"extensions\": {\"EXT_meshopt_compression\": {";
+    bufferViews += "\"buffer\": 0";
+    bufferViews += ", \"byteOffset\": " + std::to_string(binary.size());
+    bufferViews += ", \"byteLength\": " + std::to_string(view.data.size());
+    bufferViews += ", \"byteStride\": " + std::to_string(view.stride);
+    bufferViews += ", \"count\": " + std::to_string(view.count);
+    bufferViews += ", \"mode\": \"" + view.mode + "\"";
+    bufferViews += ", \"filter\": \"" + view.filter + "\"}}}";
+
+    binary.insert(binary.end(), view.data.begin(), view.data.end());
+    binary.resize((binary.size() + 3) & ~size_t(3));
+    fallbackLength = (fallbackLength + byteLength + 3) & ~size_t(3);
+  }
+
+  const std::string json = R"(
+    {
+      "asset": { "version": "2.0" },
+      "extensionsUsed": [ "EXT_meshopt_compression" ],
+      "extensionsRequired": [ "EXT_meshopt_compression" ],
+      "buffers": [
+        { "byteLength": )" + std::to_string(binary.size()) +
+                           R"( },
+        {
+          "byteLength": )" + std::to_string(fallbackLength) +
+                           R"(,
+          "extensions": { "EXT_meshopt_compression": { "fallback": true } }
+        }
+      ],
+      "bufferViews": [ )" + bufferViews +
+                           " ]" + extraJson + R"(
+    })";
+
+  return createGlb(json, binary);
+}
+
+std::vector<std::byte>
+getDecodedData(const ModelReaderResult& result, size_t bufferViewIndex) {
+  REQUIRE(result.model);
+  const Model& model = *result.model;
+  REQUIRE(bufferViewIndex < model.bufferViews.size());
+  const BufferView& bufferView = model.bufferViews[bufferViewIndex];
+  CHECK(!bufferView.getExtension<ExtensionBufferViewExtMeshoptCompression>());
+
+  const std::vector<std::byte>& data =
+      model.buffers[size_t(bufferView.buffer)].cesium.data;
+  REQUIRE(
+      bufferView.byteOffset + bufferView.byteLength <= int64_t(data.size()));
+  return std::vector<std::byte>(
+      data.begin() + bufferView.byteOffset,
+      data.begin() + bufferView.byteOffset + bufferView.byteLength);
+}
+
+// Creates a grid of two triangles per cell, with vertices shared between the
+// triangles.
+void createGrid(
+    uint32_t gridSize,
+    std::vector<glm::vec3>& positions,
+    std::vector<uint32_t>& indices) {
+  positions.clear();
+  indices.clear();
+
+  for (uint32_t y = 0; y <= gridSize; ++y) {
+    for (uint32_t x = 0; x <= gridSize; ++x) {
+      positions.emplace_back(float(x), float(y), float((x * 7 + y * 3) % 5));
+    }
+  }
+
+  for (uint32_t y = 0; y < gridSize; ++y) {
+    for (uint32_t x = 0; x < gridSize; ++x) {
+      const uint32_t i00 = y * (gridSize + 1) + x;
+      const uint32_t i10 = i00 + 1;
+      const uint32_t i01 = i00 + gridSize + 1;
+      const uint32_t i11 = i01 + 1;
+      indices.insert(indices.end(), {i00, i10, i11, i00, i11, i01});
+    }
+  }
+}
+
+const std::string gridJson = R"(,
+      "accessors": [
+        { "bufferView": 0, "componentType": 5126, "count": %POSITIONS%,
+          "type": "VEC3" },
+        { "bufferView": 1, "componentType": 5125, "count": %INDICES%,
+          "type": "SCALAR" }
+      ],
+      "meshes": [
+        { "primitives": [ { "attributes": { "POSITION": 0 }, "indices": 1 } ] }
+      ])";
+
+std::string createGridJson(size_t positionCount, size_t indexCount) {
+  std::string json = gridJson;
+  json.replace(json.find("%POSITIONS%"), 11, std::to_string(positionCount));
+  json.replace(json.find("%INDICES%"), 9, std::to_string(indexCount));
+  return json;
+}
+
+std::vector<std::byte> createMeshoptGridGlb(
+    const std::vector<glm::vec3>& positions,
+    const std::vector<uint32_t>& indices) {
+  return createMeshoptGlb(
+      {{encodeVertexBuffer(toBytes(positions), sizeof(glm::vec3)),
+        positions.size(),
+        sizeof(glm::vec3),
+        ExtensionBufferViewExtMeshoptCompression::Mode::ATTRIBUTES},
+       {encodeIndexBuffer(indices),
+        indices.size(),
+        sizeof(uint32_t),
+        ExtensionBufferViewExtMeshoptCompression::Mode::TRIANGLES}},
+      createGridJson(positions.size(), indices.size()));
+}
+
+std::vector<std::byte> createDracoGridGlb(
+    const std::vector<glm::vec3>& positions,
+    const std::vector<uint32_t>& indices) {
+  const size_t faceCount = indices.size() / 3;
+
+  draco::TriangleSoupMeshBuilder builder;
+  builder.Start(static_cast<int>(faceCount));
+  const int positionId = builder.AddAttribute(
+      draco::GeometryAttribute::POSITION,
+      3,
+      draco::DT_FLOAT32);
+  for (size_t i = 0; i < faceCount; ++i) {
+    builder.SetAttributeValuesForFace(
+        positionId,
+        draco::FaceIndex(static_cast<uint32_t>(i)),
+        &positions[indices[i * 3]],
+        &positions[indices[i * 3 + 1]],
+        &positions[indices[i * 3 + 2]]);
+  }
+
+  std::unique_ptr<draco::Mesh> pMesh = builder.Finalize();
+  REQUIRE(pMesh);
+
+  draco::Encoder encoder;
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+  draco::EncoderBuffer encoded;
+  REQUIRE(encoder.EncodeMeshToBuffer(*pMesh, &encoded).ok());
+
+  std::vector<std::byte> binary(encoded.size());
+  std::memcpy(binary.data(), encoded.data(), encoded.size());
+
+  const std::string json = R"(
+    {
+      "asset": { "version": "2.0" },
+      "extensionsUsed": [ "KHR_draco_mesh_compression" ],
+      "extensionsRequired": [ "KHR_draco_mesh_compression" ],
+      "buffers": [ { "byteLength": )" +
+                           std::to_string(binary.size()) + R"( } ],
+      "bufferViews": [
+        { "buffer": 0, "byteOffset": 0, "byteLength": )" +
+                           std::to_string(binary.size()) + R"( }
+      ],
+      "accessors": [
+        { "componentType": 5125, "count": )" +
+                           std::to_string(indices.size()) +
+                           R"(, "type": "SCALAR" },
+        { "componentType": 5126, "count": )" +
+                           std::to_string(pMesh->num_points()) +
+                           R"(, "type": "VEC3" }
+      ],
+      "meshes": [
+        {
+          "primitives": [
+            {
+              "attributes": { "POSITION": 1 },
+              "indices": 0,
+              "extensions": {
+                "KHR_draco_mesh_compression": {
+                  "bufferView": 0,
+                  "attributes": { "POSITION": )" +
+                           std::to_string(
+                               pMesh->attribute(positionId)->unique_id()) +
+                           R"( }
+                }
+              }
+            }
+          ]
+        }
+      ]
+    })";
+
+  return createGlb(json, binary);
+}
+
+void checkDecodedGrid(
+    const ModelReaderResult& result,
+    const std::vector<glm::vec3>& expectedPositions,
+    const std::vector<uint32_t>& expectedIndices) {
+  CHECK(result.errors.empty());
+  CHECK(result.warnings.empty());
+  REQUIRE(result.model);
+
+  const Model& model = *result.model;
+  REQUIRE(model.buffers.size() == 2);
+  CHECK(!model.buffers[1].uri);
+  CHECK(!model.buffers[1].getExtension<ExtensionBufferExtMeshoptCompression>());
+  for (const BufferView& bufferView : model.bufferViews) {
+    CHECK(!bufferView.getExtension<ExtensionBufferViewExtMeshoptCompression>());
+  }
+
+  AccessorView<glm::vec3> positions(model, 0);
+  AccessorView<uint32_t> indices(model, 1);
+  REQUIRE(positions.status() == AccessorViewStatus::Valid);
+  REQUIRE(indices.status() == AccessorViewStatus::Valid);
+  REQUIRE(positions.size() == int64_t(expectedPositions.size()));
+  REQUIRE(indices.size() == int64_t(expectedIndices.size()));
+
+  for (int64_t i = 0; i < positions.size(); ++i) {
+    CHECK(positions[i] == expectedPositions[size_t(i)]);
+  }
+  for (int64_t i = 0; i < indices.size(); ++i) {
+    CHECK(indices[i] == expectedIndices[size_t(i)]);
+  }
+}
+
+} // namespace
+
+TEST_CASE("Decodes EXT_meshopt_compression buffer views") {
+  std::vector<glm::vec3> positions;
+  std::vector<uint32_t> indices;
+  createGrid(100, positions, indices);
+  const std::vector<std::byte> glb = createMeshoptGridGlb(positions, indices);
+
+  GltfReader reader;
+
+  SECTION("on the calling thread") {
+    ModelReaderResult result = reader.readModel(glb);
+    checkDecodedGrid(result, positions, indices);
+  }
+
+  SECTION("with worker threads") {
+    ReadModelOptions options;
+    options.asyncSystem =
+        AsyncSystem(std::make_shared<ThreadTaskProcessor>());
+    ModelReaderResult result = reader.readModel(glb, options);
+    checkDecodedGrid(result, positions, indices);
+  }
+
+  SECTION("unless decoding is disabled") {
+    ReadModelOptions options;
+    options.decodeMeshopt = false;
+    ModelReaderResult result = reader.readModel(glb, options);
+    REQUIRE(result.model);
+    CHECK(result.model->buffers[1].cesium.data.empty());
+    CHECK(result.model->bufferViews[0]
+              .getExtension<ExtensionBufferViewExtMeshoptCompression>());
+  }
+}
+
+TEST_CASE("Decodes EXT_meshopt_compression index modes") {
+  using Mode = ExtensionBufferViewExtMeshoptCompression::Mode;
+
+  // Triangles from the reference encoder, which use the edge and vertex
+  // FIFOs as well as explicit indices.
+  const std::vector<std::byte> referenceTriangles =
+      toBytes(std::vector<uint8_t>{0xe1, 0xf0, 0x10, 0xfe, 0xff, 0xf0, 0x0c,
+                                   0xff, 0x02, 0x02, 0x02, 0x00, 0x76, 0x87,
+                                   0x56, 0x67, 0x78, 0xa9, 0x86, 0x65, 0x89,
+                                   0x68, 0x98, 0x01, 0x69, 0x00, 0x00});
+  const std::vector<uint32_t> referenceIndices =
+      {0, 1, 2, 2, 1, 3, 4, 6, 5, 7, 8, 9};
+  const std::vector<uint16_t> referenceIndices16(
+      referenceIndices.begin(),
+      referenceIndices.end());
+
+  const std::vector<uint32_t> sequence = {7, 3, 70000, 4, 4, 0, 129};
+
+  GltfReader reader;
+  ModelReaderResult result = reader.readModel(createMeshoptGlb(
+      {{referenceTriangles, 12, sizeof(uint32_t), Mode::TRIANGLES},
+       {referenceTriangles, 12, sizeof(uint16_t), Mode::TRIANGLES},
+       {encodeIndexSequence(sequence), 7, sizeof(uint32_t), Mode::INDICES}}));
+  CHECK(result.warnings.empty());
+
+  CHECK(getDecodedData(result, 0) == toBytes(referenceIndices));
+  CHECK(getDecodedData(result, 1) == toBytes(referenceIndices16));
+  CHECK(getDecodedData(result, 2) == toBytes(sequence));
+}
+
+TEST_CASE("Decodes EXT_meshopt_compression filters") {
+  using Filter = ExtensionBufferViewExtMeshoptCompression::Filter;
+  using Mode = ExtensionBufferViewExtMeshoptCompression::Mode;
+
+  const std::vector<int8_t> octahedral = {0, 0, 127, 5, 64, 0, 127, 0};
+  const std::vector<int16_t> quaternions =
+      {0, 0, 0, 4095, 0, 0, 0, 4092, 2896, 0, 0, 4095};
+  const std::vector<uint32_t> exponential =
+      {0xFE000006, 0x00FFFFFF, 0x01000003};
+
+  GltfReader reader;
+  ModelReaderResult result = reader.readModel(createMeshoptGlb(
+      {{encodeVertexBuffer(toBytes(octahedral), 4),
+        2,
+        4,
+        Mode::ATTRIBUTES,
+        Filter::OCTAHEDRAL},
+       {encodeVertexBuffer(toBytes(quaternions), 8),
+        3,
+        8,
+        Mode::ATTRIBUTES,
+        Filter::QUATERNION},
+       {encodeVertexBuffer(toBytes(exponential), 4),
+        3,
+        4,
+        Mode::ATTRIBUTES,
+        Filter::EXPONENTIAL}}));
+  CHECK(result.warnings.empty());
+
+  SECTION("octahedral") {
+    const std::vector<std::byte> data = getDecodedData(result, 0);
+    REQUIRE(data.size() == 8);
+    const int8_t* pNormals = reinterpret_cast<const int8_t*>(data.data());
+
+    CHECK(pNormals[0] == 0);
+    CHECK(pNormals[1] == 0);
+    CHECK(pNormals[2] == 127);
+    CHECK(pNormals[3] == 5);
+
+    // (64, 0, 63) normalized to a length of 127.
+    const glm::vec3 normal(pNormals[4], pNormals[5], pNormals[6]);
+    CHECK(glm::length(normal) == Approx(127.0f).margin(1.0f));
+    CHECK(normal.x == Approx(64.0f * 127.0f / 89.8f).margin(1.0f));
+    CHECK(normal.y == 0.0f);
+    CHECK(normal.z == Approx(63.0f * 127.0f / 89.8f).margin(1.0f));
+  }
+
+  SECTION("quaternion") {
+    const std::vector<std::byte> data = getDecodedData(result, 1);
+    REQUIRE(data.size() == 24);
+    std::vector<int16_t> decoded(12);
+    std::memcpy(decoded.data(), data.data(), data.size());
+
+    // The component that was dropped is the largest one, at the index that
+    // the two lowest bits of the fourth value encode.
+    CHECK(decoded[0] == 0);
+    CHECK(decoded[1] == 0);
+    CHECK(decoded[2] == 0);
+    CHECK(decoded[3] == 32767);
+    CHECK(decoded[4] == 32767);
+    CHECK(decoded[5] == 0);
+    CHECK(decoded[6] == 0);
+    CHECK(decoded[7] == 0);
+    CHECK(decoded[8] == Approx(16384).margin(8));
+    CHECK(decoded[9] == 0);
+    CHECK(decoded[10] == 0);
+    CHECK(decoded[11] == Approx(28377).margin(8));
+  }
+
+  SECTION("exponential") {
+    const std::vector<std::byte> data = getDecodedData(result, 2);
+    REQUIRE(data.size() == 12);
+    std::vector<float> decoded(3);
+    std::memcpy(decoded.data(), data.data(), data.size());
+
+    CHECK(decoded[0] == 1.5f);
+    CHECK(decoded[1] == -1.0f);
+    CHECK(decoded[2] == 6.0f);
+  }
+}
+
+TEST_CASE("Reports EXT_meshopt_compression data that can't be decoded") {
+  using Mode = ExtensionBufferViewExtMeshoptCompression::Mode;
+
+  std::vector<std::byte> truncated =
+      encodeVertexBuffer(toBytes(std::vector<float>(64, 1.0f)), 8);
+  truncated.resize(truncated.size() - 1);
+
+  GltfReader reader;
+  ModelReaderResult result = reader.readModel(
+      createMeshoptGlb({{truncated, 32, 8, Mode::ATTRIBUTES}}));
+  CHECK(result.errors.empty());
+  CHECK(result.warnings.size() == 1);
+  REQUIRE(result.model);
+
+  // The fallback buffer is left to be loaded from its URI, if it has one.
+  CHECK(result.model->buffers[1].cesium.data.empty());
+  CHECK(result.model->bufferViews[0]
+            .getExtension<ExtensionBufferViewExtMeshoptCompression>());
+}
+
+// Run with `cesium-native-tests "[.benchmark]"`.
+TEST_CASE("Benchmark meshopt and Draco decoding", "[.benchmark]") {
+  std::vector<glm::vec3> positions;
+  std::vector<uint32_t> indices;
+  createGrid(300, positions, indices);
+
+  const std::vector<std::byte> meshoptGlb =
+      createMeshoptGridGlb(positions, indices);
+  const std::vector<std::byte> dracoGlb =
+      createDracoGridGlb(positions, indices);
+  WARN(
+      "meshopt GLB size: " << meshoptGlb.size()
+                           << ", Draco GLB size: " << dracoGlb.size());
+
+  GltfReader reader;
+
+  BENCHMARK("meshopt") {
+    return reader.readModel(meshoptGlb).model.has_value();
+  };
+
+  BENCHMARK("Draco") { return reader.readModel(dracoGlb).model.has_value(); };
+}
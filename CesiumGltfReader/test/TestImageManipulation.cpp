@@ -3,8 +3,11 @@
 #include <CesiumGltf/ImageCesium.h>
 
 #include <catch2/catch.hpp>
+#include <stb_image_resize.h>
 
 #include <algorithm>
+#include <cmath>
+#include <random>
 
 using namespace CesiumGltf;
 using namespace CesiumGltfReader;
@@ -333,3 +336,337 @@ TEST_CASE("ImageManipulation::blitImage") {
     verifyTargetUnchanged();
   }
 }
+
+namespace {
+
+std::vector<std::byte> createRandomPixels(size_t width, size_t height) {
+  std::mt19937 random(12345);
+  std::uniform_int_distribution<int> distribution(0, 255);
+  std::vector<std::byte> pixels(width * height * 4);
+  for (std::byte& b : pixels) {
+    b = std::byte(distribution(random));
+  }
+  return pixels;
+}
+
+uint32_t getChannel(
+    const std::vector<std::byte>& pixels,
+    size_t width,
+    size_t x,
+    size_t y,
+    size_t channel) {
+  return uint32_t(pixels[(y * width + x) * 4 + channel]);
+}
+
+} // namespace
+
+TEST_CASE("ImageManipulation::unsafeDownsampleRgba8") {
+  // Odd and even sizes, with widths that need both the SIMD and the scalar
+  // code paths.
+  const size_t width = GENERATE(as<size_t>(), 1, 2, 7, 33, 64);
+  const size_t height = GENERATE(as<size_t>(), 1, 4, 5);
+
+  const std::vector<std::byte> source = createRandomPixels(width, height);
+  const size_t targetWidth = std::max(width / 2, size_t(1));
+  const size_t targetHeight = std::max(height / 2, size_t(1));
+  std::vector<std::byte> target(targetWidth * targetHeight * 4);
+
+  ImageManipulation::unsafeDownsampleRgba8(
+      target.data(),
+      targetWidth * 4,
+      source.data(),
+      width * 4,
+      width,
+      height);
+
+  for (size_t y = 0; y < targetHeight; ++y) {
+    const size_t y0 = 2 * y;
+    const size_t y1 = std::min(y0 + 1, height - 1);
+    for (size_t x = 0; x < targetWidth; ++x) {
+      const size_t x0 = 2 * x;
+      const size_t x1 = std::min(x0 + 1, width - 1);
+      for (size_t c = 0; c < 4; ++c) {
+        const uint32_t sum = getChannel(source, width, x0, y0, c) +
+                             getChannel(source, width, x1, y0, c) +
+                             getChannel(source, width, x0, y1, c) +
+                             getChannel(source, width, x1, y1, c);
+        CHECK(getChannel(target, targetWidth, x, y, c) == (sum + 2) / 4);
+      }
+    }
+  }
+}
+
+TEST_CASE("ImageManipulation::unsafeResampleRgba8") {
+  const size_t width = 37;
+  const size_t height = 11;
+  const std::vector<std::byte> source = createRandomPixels(width, height);
+
+  SECTION("copies an image of the same size") {
+    std::vector<std::byte> target(source.size());
+    ImageManipulation::unsafeResampleRgba8(
+        target.data(),
+        width * 4,
+        width,
+        height,
+        source.data(),
+        width * 4,
+        width,
+        height);
+    CHECK(target == source);
+  }
+
+  SECTION("interpolates between the nearest source pixels") {
+    const size_t targetWidth = 70;
+    const size_t targetHeight = 19;
+    std::vector<std::byte> target(targetWidth * targetHeight * 4);
+    ImageManipulation::unsafeResampleRgba8(
+        target.data(),
+        targetWidth * 4,
+        targetWidth,
+        targetHeight,
+        source.data(),
+        width * 4,
+        width,
+        height);
+
+    for (size_t y = 0; y < targetHeight; ++y) {
+      const double sourceY = std::clamp(
+          (double(y) + 0.5) * double(height) / double(targetHeight) - 0.5,
+          0.0,
+          double(height - 1));
+      for (size_t x = 0; x < targetWidth; ++x) {
+        const double sourceX = std::clamp(
+            (double(x) + 0.5) * double(width) / double(targetWidth) - 0.5,
+            0.0,
+            double(width - 1));
+        const size_t x0 = size_t(sourceX);
+        const size_t y0 = size_t(sourceY);
+        const size_t x1 = std::min(x0 + 1, width - 1);
+        const size_t y1 = std::min(y0 + 1, height - 1);
+        const double fx = sourceX - double(x0);
+        const double fy = sourceY - double(y0);
+
+        for (size_t c = 0; c < 4; ++c) {
+          const double expected =
+              (1.0 - fy) * ((1.0 - fx) * getChannel(source, width, x0, y0, c) +
+                            fx * getChannel(source, width, x1, y0, c)) +
+              fy * ((1.0 - fx) * getChannel(source, width, x0, y1, c) +
+                    fx * getChannel(source, width, x1, y1, c));
+          // Allow for the fixed-point weights and intermediate rounding.
+          CHECK(
+              std::abs(
+                  double(getChannel(target, targetWidth, x, y, c)) -
+                  expected) <= 1.5);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("ImageManipulation::unsafeGenerateMipChainRgba8") {
+  CHECK(ImageManipulation::computeMipChainByteSize(0, 4, 4) == 0);
+  CHECK(ImageManipulation::computeMipChainByteSize(1, 1, 4) == 4);
+  // 5x3, 2x1, 1x1
+  CHECK(ImageManipulation::computeMipChainByteSize(5, 3, 4) == 72);
+
+  const size_t width = 8;
+  const size_t height = 2;
+  std::vector<std::byte> pixels(
+      ImageManipulation::computeMipChainByteSize(width, height, 4));
+  const std::vector<std::byte> image = createRandomPixels(width, height);
+  std::copy(image.begin(), image.end(), pixels.begin());
+
+  ImageManipulation::unsafeGenerateMipChainRgba8(pixels.data(), width, height);
+
+  // The levels are 8x2, 4x1, 2x1, and 1x1, and each one is the downsampled
+  // previous one.
+  const std::byte* pLevel = pixels.data();
+  size_t levelWidth = width;
+  size_t levelHeight = height;
+  while (levelWidth > 1 || levelHeight > 1) {
+    const size_t nextWidth = std::max(levelWidth / 2, size_t(1));
+    const size_t nextHeight = std::max(levelHeight / 2, size_t(1));
+    std::vector<std::byte> expected(nextWidth * nextHeight * 4);
+    ImageManipulation::unsafeDownsampleRgba8(
+        expected.data(),
+        nextWidth * 4,
+        pLevel,
+        levelWidth * 4,
+        levelWidth,
+        levelHeight);
+
+    pLevel += levelWidth * levelHeight * 4;
+    CHECK(std::equal(expected.begin(), expected.end(), pLevel));
+
+    levelWidth = nextWidth;
+    levelHeight = nextHeight;
+  }
+
+  CHECK(pLevel + 4 == pixels.data() + pixels.size());
+}
+
+// Run with `cesium-native-tests "[.benchmark]"`.
+TEST_CASE("Benchmark ImageManipulation resampling", "[.benchmark]") {
+  const size_t width = 512;
+  const size_t height = 512;
+  const std::vector<std::byte> source = createRandomPixels(width, height);
+  std::vector<std::byte> half(width * height);
+  std::vector<std::byte> enlarged(width * height * 4 * 4);
+
+  const unsigned char* pSource =
+      reinterpret_cast<const unsigned char*>(source.data());
+
+  BENCHMARK("stb downsample 2x") {
+    return stbir_resize_uint8(
+        pSource,
+        int(width),
+        int(height),
+        int(width * 4),
+        reinterpret_cast<unsigned char*>(half.data()),
+        int(width / 2),
+        int(height / 2),
+        int(width / 2 * 4),
+        4);
+  };
+
+  BENCHMARK("unsafeDownsampleRgba8") {
+    ImageManipulation::unsafeDownsampleRgba8(
+        half.data(),
+        width / 2 * 4,
+        source.data(),
+        width * 4,
+        width,
+        height);
+    return half[0];
+  };
+
+  BENCHMARK("stb upsample 2x") {
+    return stbir_resize_uint8(
+        pSource,
+        int(width),
+        int(height),
+        int(width * 4),
+        reinterpret_cast<unsigned char*>(enlarged.data()),
+        int(width * 2),
+        int(height * 2),
+        int(width * 2 * 4),
+        4);
+  };
+
+  BENCHMARK("unsafeResampleRgba8 upsample 2x") {
+    ImageManipulation::unsafeResampleRgba8(
+        enlarged.data(),
+        width * 2 * 4,
+        width * 2,
+        height * 2,
+        source.data(),
+        width * 4,
+        width,
+        height);
+    return enlarged[0];
+  };
+
+  std::vector<std::byte> mipChain(
+      ImageManipulation::computeMipChainByteSize(width, height, 4));
+
+  BENCHMARK("unsafeGenerateMipChainRgba8") {
+    std::copy(source.begin(), source.end(), mipChain.begin());
+    ImageManipulation::unsafeGenerateMipChainRgba8(
+        mipChain.data(),
+        width,
+        height);
+    return mipChain.back();
+  };
+}
+
+TEST_CASE("ImageManipulation::generateMipMaps") {
+  ImageCesium image;
+  image.width = 5;
+  image.height = 3;
+  image.pixelData = createRandomPixels(5, 3);
+  const std::vector<std::byte> original = image.pixelData;
+
+  SECTION("stores the mip levels after the image") {
+    REQUIRE(ImageManipulation::generateMipMaps(image));
+
+    // 5x3, 2x1, 1x1
+    REQUIRE(image.mipPositions.size() == 3);
+    CHECK(image.mipPositions[0].byteOffset == 0);
+    CHECK(image.mipPositions[0].byteSize == 60);
+    CHECK(image.mipPositions[1].byteOffset == 60);
+    CHECK(image.mipPositions[1].byteSize == 8);
+    CHECK(image.mipPositions[2].byteOffset == 68);
+    CHECK(image.mipPositions[2].byteSize == 4);
+    REQUIRE(image.pixelData.size() == 72);
+    CHECK(std::equal(
+        original.begin(),
+        original.end(),
+        image.pixelData.begin()));
+
+    SECTION("only once") {
+      CHECK(!ImageManipulation::generateMipMaps(image));
+      CHECK(image.mipPositions.size() == 3);
+    }
+  }
+
+  SECTION("rejects unsupported formats") {
+    image.channels = 3;
+    CHECK(!ImageManipulation::generateMipMaps(image));
+    CHECK(image.mipPositions.empty());
+    CHECK(image.pixelData == original);
+  }
+}
+
+TEST_CASE("ImageManipulation::compressBlocks") {
+  ImageCesium image;
+  image.width = 5;
+  image.height = 3;
+  image.pixelData = createRandomPixels(5, 3);
+  const std::vector<std::byte> original = image.pixelData;
+
+  SECTION("compresses the image to whole blocks") {
+    REQUIRE(ImageManipulation::compressBlocks(
+        image,
+        GpuCompressedPixelFormat::Bc3Rgba));
+    CHECK(image.compressedPixelFormat == GpuCompressedPixelFormat::Bc3Rgba);
+    CHECK(image.pixelData.size() == 2 * 16);
+    CHECK(image.mipPositions.empty());
+
+    SECTION("only once") {
+      CHECK(!ImageManipulation::compressBlocks(
+          image,
+          GpuCompressedPixelFormat::Bc1Rgb));
+      CHECK(!ImageManipulation::generateMipMaps(image));
+      CHECK(image.pixelData.size() == 2 * 16);
+    }
+  }
+
+  SECTION("compresses each mip level") {
+    REQUIRE(ImageManipulation::generateMipMaps(image));
+    REQUIRE(ImageManipulation::compressBlocks(
+        image,
+        GpuCompressedPixelFormat::Bc1Rgb));
+
+    // 5x3, 2x1, 1x1
+    REQUIRE(image.mipPositions.size() == 3);
+    CHECK(image.mipPositions[0].byteOffset == 0);
+    CHECK(image.mipPositions[0].byteSize == 16);
+    CHECK(image.mipPositions[1].byteOffset == 16);
+    CHECK(image.mipPositions[1].byteSize == 8);
+    CHECK(image.mipPositions[2].byteOffset == 24);
+    CHECK(image.mipPositions[2].byteSize == 8);
+    CHECK(image.pixelData.size() == 32);
+  }
+
+  SECTION("rejects unsupported formats") {
+    CHECK(!ImageManipulation::compressBlocks(
+        image,
+        GpuCompressedPixelFormat::Bc7Rgba));
+    image.channels = 3;
+    CHECK(!ImageManipulation::compressBlocks(
+        image,
+        GpuCompressedPixelFormat::Bc1Rgb));
+    CHECK(image.compressedPixelFormat == GpuCompressedPixelFormat::None);
+    CHECK(image.pixelData == original);
+  }
+}
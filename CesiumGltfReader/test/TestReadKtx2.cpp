@@ -0,0 +1,525 @@
+#include "CesiumGltfReader/GltfReader.h"
+#include "CesiumGltfReader/ImageManipulation.h"
+#include "GltfReaderTestHelpers.h"
+
+#include <CesiumGltf/ExtensionKhrTextureBasisu.h>
+
+#include <catch2/catch.hpp>
+#include <gsl/span>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace CesiumGltf;
+using namespace CesiumGltfReader;
+
+namespace {
+
+constexpr uint32_t vkFormatR8G8B8A8Unorm = 37;
+constexpr uint32_t vkFormatBc1RgbUnorm = 131;
+constexpr uint32_t vkFormatBc7Unorm = 145;
+
+// Creates a KTX2 file. The data format descriptor is optional, because only
+// the Basis Universal transcoder needs it. The levels are stored smallest
+// first, as in real files. Supercompressed levels need their uncompressed
+// byte lengths.
+std::vector<std::byte> createKtx2(
+    uint32_t vkFormat,
+    uint32_t width,
+    uint32_t height,
+    const std::vector<std::vector<std::byte>>& levels,
+    uint32_t supercompressionScheme = 0,
+    const std::vector<std::byte>& dfd = {},
+    const std::vector<size_t>& uncompressedByteLengths = {}) {
+  const std::string identifier = "\xABKTX 20\xBB\r\n\x1A\n";
+
+  std::vector<std::byte> ktx2;
+  for (char c : identifier) {
+    ktx2.push_back(std::byte(c));
+  }
+  appendUint32(ktx2, vkFormat);
+  appendUint32(ktx2, 1);
+  appendUint32(ktx2, width);
+  appendUint32(ktx2, height);
+  appendUint32(ktx2, 0);
+  appendUint32(ktx2, 0);
+  appendUint32(ktx2, 1);
+  appendUint32(ktx2, static_cast<uint32_t>(levels.size()));
+  appendUint32(ktx2, supercompressionScheme);
+
+  // The data format descriptor follows the level index.
+  const size_t dfdOffset =
+      ktx2.size() + 4 * sizeof(uint32_t) + 2 * sizeof(uint64_t) +
+      levels.size() * 3 * sizeof(uint64_t);
+  appendUint32(ktx2, dfd.empty() ? 0 : static_cast<uint32_t>(dfdOffset));
+  appendUint32(ktx2, static_cast<uint32_t>(dfd.size()));
+  appendUint32(ktx2, 0);
+  appendUint32(ktx2, 0);
+  appendUint64(ktx2, 0);
+  appendUint64(ktx2, 0);
+
+  size_t offset = dfdOffset + dfd.size();
+  std::vector<size_t> offsets(levels.size());
+  for (size_t i = levels.size(); i > 0; --i) {
+    offsets[i - 1] = offset;
+    offset += levels[i - 1].size();
+  }
+
+  for (size_t i = 0; i < levels.size(); ++i) {
+    appendUint64(ktx2, offsets[i]);
+    appendUint64(ktx2, levels[i].size());
+    appendUint64(
+        ktx2,
+        i < uncompressedByteLengths.size() ? uncompressedByteLengths[i]
+                                           : levels[i].size());
+  }
+
+  ktx2.insert(ktx2.end(), dfd.begin(), dfd.end());
+  for (size_t i = levels.size(); i > 0; --i) {
+    ktx2.insert(ktx2.end(), levels[i - 1].begin(), levels[i - 1].end());
+  }
+
+  return ktx2;
+}
+
+// A BC1 block in which every pixel has the given RGB565 color.
+std::vector<std::byte> createSolidBc1Block(uint16_t color) {
+  const uint8_t low = static_cast<uint8_t>(color & 0xFF);
+  const uint8_t high = static_cast<uint8_t>(color >> 8);
+  return std::vector<std::byte>{
+      std::byte(low),
+      std::byte(high),
+      std::byte(low),
+      std::byte(high),
+      std::byte(0),
+      std::byte(0),
+      std::byte(0),
+      std::byte(0)};
+}
+
+constexpr uint32_t supercompressionZstd = 2;
+
+// A data format descriptor for UASTC, with a single sample that covers the
+// whole 128-bit block.
+std::vector<std::byte> createUastcDfd(bool hasAlpha) {
+  constexpr uint32_t colorModelUastc = 166;
+  constexpr uint32_t channelRgb = 0;
+  constexpr uint32_t channelRgba = 3;
+
+  std::vector<std::byte> dfd;
+  appendUint32(dfd, 44);
+  // The vendor and descriptor type, then the version and the block size.
+  appendUint32(dfd, 0);
+  appendUint32(dfd, 2 | (40 << 16));
+  // The color model, with BT.709 primaries and a linear transfer function.
+  appendUint32(dfd, colorModelUastc | (1 << 8) | (1 << 16));
+  // 4x4 texel blocks of 16 bytes each.
+  appendUint32(dfd, 3 | (3 << 8));
+  appendUint32(dfd, 16);
+  appendUint32(dfd, 0);
+  // The sample's bit length minus one, and its channel.
+  appendUint32(
+      dfd,
+      (127 << 16) | ((hasAlpha ? channelRgba : channelRgb) << 24));
+  appendUint32(dfd, 0);
+  appendUint32(dfd, 0);
+  appendUint32(dfd, 0xFFFFFFFF);
+  return dfd;
+}
+
+// A UASTC block in the solid color mode, mode 8, in which every pixel has the
+// given color. The bits are read from the least significant bit of the first
+// byte: the 5-bit code of the mode, then the 8-bit components. The ETC1 hints
+// after them are left at zero.
+std::vector<std::byte>
+createSolidUastcBlock(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+  const uint64_t bits = 0x17 | (uint64_t(r) << 5) | (uint64_t(g) << 13) |
+                        (uint64_t(b) << 21) | (uint64_t(a) << 29);
+  std::vector<std::byte> block(16);
+  for (size_t i = 0; i < sizeof(bits); ++i) {
+    block[i] = std::byte(static_cast<uint8_t>(bits >> (i * 8)));
+  }
+  return block;
+}
+
+// Wraps data in a Zstandard frame with a single uncompressed block.
+std::vector<std::byte> createZstdFrame(const std::vector<std::byte>& data) {
+  REQUIRE(data.size() < 256);
+
+  std::vector<std::byte> frame;
+  appendUint32(frame, 0xFD2FB528);
+  // A single segment, so the content size that follows takes one byte.
+  frame.push_back(std::byte(0x20));
+  frame.push_back(std::byte(static_cast<uint8_t>(data.size())));
+  // The header of the last block, which is stored raw.
+  const uint32_t blockHeader = 1 | static_cast<uint32_t>(data.size() << 3);
+  for (size_t i = 0; i < 3; ++i) {
+    frame.push_back(std::byte(static_cast<uint8_t>(blockHeader >> (i * 8))));
+  }
+  frame.insert(frame.end(), data.begin(), data.end());
+  return frame;
+}
+
+// Creates a 6x5 UASTC image with the given block everywhere. It needs 2x2
+// blocks, then 1x1 blocks for the 3x2 and 1x1 levels.
+std::vector<std::byte> createUastcKtx2(
+    const std::vector<std::byte>& block,
+    bool hasAlpha,
+    bool zstd) {
+  std::vector<std::byte> level0;
+  for (size_t i = 0; i < 4; ++i) {
+    level0.insert(level0.end(), block.begin(), block.end());
+  }
+  std::vector<std::vector<std::byte>> levels{level0, block, block};
+
+  std::vector<size_t> uncompressedByteLengths;
+  if (zstd) {
+    for (std::vector<std::byte>& level : levels) {
+      uncompressedByteLengths.push_back(level.size());
+      level = createZstdFrame(level);
+    }
+  }
+
+  return createKtx2(
+      0,
+      6,
+      5,
+      levels,
+      zstd ? supercompressionZstd : 0,
+      createUastcDfd(hasAlpha),
+      uncompressedByteLengths);
+}
+
+void checkTranscodedLevels(
+    const ImageReaderResult& result,
+    GpuCompressedPixelFormat format,
+    size_t bytesPerBlock) {
+  CHECK(result.errors.empty());
+  REQUIRE(result.image);
+  const ImageCesium& image = *result.image;
+  CHECK(image.width == 6);
+  CHECK(image.height == 5);
+  CHECK(image.compressedPixelFormat == format);
+  REQUIRE(image.mipPositions.size() == 3);
+  CHECK(image.mipPositions[0].byteOffset == 0);
+  CHECK(image.mipPositions[0].byteSize == 4 * bytesPerBlock);
+  CHECK(image.mipPositions[1].byteOffset == 4 * bytesPerBlock);
+  CHECK(image.mipPositions[1].byteSize == bytesPerBlock);
+  CHECK(image.mipPositions[2].byteOffset == 5 * bytesPerBlock);
+  CHECK(image.mipPositions[2].byteSize == bytesPerBlock);
+  CHECK(image.pixelData.size() == 6 * bytesPerBlock);
+}
+
+} // namespace
+
+TEST_CASE("GltfReader::readImage reads KTX2 images") {
+  SECTION("8-bit RGBA pixels are read as they are") {
+    std::vector<std::byte> pixels(2 * 2 * 4);
+    for (size_t i = 0; i < pixels.size(); ++i) {
+      pixels[i] = std::byte(i);
+    }
+    const std::vector<std::byte> ktx2 =
+        createKtx2(vkFormatR8G8B8A8Unorm, 2, 2, {pixels});
+
+    ImageReaderResult result = GltfReader::readImage(ktx2);
+    CHECK(result.errors.empty());
+    REQUIRE(result.image);
+    CHECK(result.image->width == 2);
+    CHECK(result.image->height == 2);
+    CHECK(
+        result.image->compressedPixelFormat == GpuCompressedPixelFormat::None);
+    CHECK(result.image->pixelData == pixels);
+    CHECK(result.image->mipPositions.empty());
+  }
+
+  // A 6x5 image needs 2x2 blocks, then 1x1 blocks for the 3x2 and 1x1 levels.
+  const std::vector<std::byte> red = createSolidBc1Block(0xF800);
+  const std::vector<std::byte> green = createSolidBc1Block(0x07E0);
+  std::vector<std::byte> level0;
+  for (size_t i = 0; i < 4; ++i) {
+    level0.insert(level0.end(), red.begin(), red.end());
+  }
+  const std::vector<std::byte> ktx2 =
+      createKtx2(vkFormatBc1RgbUnorm, 6, 5, {level0, green, red});
+
+  SECTION("block-compressed pixels are kept if the renderer supports them") {
+    Ktx2TranscodeTargets targets;
+    targets.bc1Rgb = true;
+
+    ImageReaderResult result = GltfReader::readImage(ktx2, targets);
+    CHECK(result.errors.empty());
+    REQUIRE(result.image);
+    const ImageCesium& image = *result.image;
+    CHECK(image.width == 6);
+    CHECK(image.height == 5);
+    CHECK(image.compressedPixelFormat == GpuCompressedPixelFormat::Bc1Rgb);
+    CHECK(image.pixelData.size() == 48);
+    REQUIRE(image.mipPositions.size() == 3);
+    CHECK(image.mipPositions[0].byteOffset == 0);
+    CHECK(image.mipPositions[0].byteSize == 32);
+    CHECK(image.mipPositions[1].byteOffset == 32);
+    CHECK(image.mipPositions[1].byteSize == 8);
+    CHECK(image.mipPositions[2].byteOffset == 40);
+    CHECK(image.mipPositions[2].byteSize == 8);
+    CHECK(std::equal(green.begin(), green.end(), image.pixelData.begin() + 32));
+  }
+
+  SECTION("block-compressed pixels are decoded if the renderer doesn't "
+          "support them") {
+    ImageReaderResult result = GltfReader::readImage(ktx2);
+    CHECK(result.errors.empty());
+    REQUIRE(result.image);
+    const ImageCesium& image = *result.image;
+    CHECK(image.compressedPixelFormat == GpuCompressedPixelFormat::None);
+    REQUIRE(image.mipPositions.size() == 3);
+    CHECK(image.mipPositions[0].byteSize == 6 * 5 * 4);
+    CHECK(image.mipPositions[1].byteSize == 3 * 2 * 4);
+    CHECK(image.mipPositions[2].byteSize == 1 * 1 * 4);
+    REQUIRE(image.pixelData.size() == (30 + 6 + 1) * 4);
+
+    for (size_t i = 0; i < image.pixelData.size() / 4; ++i) {
+      const bool isGreen = i >= 30 && i < 36;
+      const std::byte* pPixel = image.pixelData.data() + i * 4;
+      CHECK(pPixel[0] == std::byte(isGreen ? 0 : 255));
+      CHECK(pPixel[1] == std::byte(isGreen ? 255 : 0));
+      CHECK(pPixel[2] == std::byte(0));
+      CHECK(pPixel[3] == std::byte(255));
+    }
+  }
+
+  SECTION("formats that can't be decoded fail if the renderer doesn't support "
+          "them") {
+    const std::vector<std::byte> bc7 = createKtx2(
+        vkFormatBc7Unorm,
+        4,
+        4,
+        {std::vector<std::byte>(16)});
+    ImageReaderResult result = GltfReader::readImage(bc7);
+    CHECK(!result.image);
+    CHECK(!result.errors.empty());
+
+    Ktx2TranscodeTargets targets;
+    targets.bc7Rgba = true;
+    result = GltfReader::readImage(bc7, targets);
+    REQUIRE(result.image);
+    CHECK(
+        result.image->compressedPixelFormat ==
+        GpuCompressedPixelFormat::Bc7Rgba);
+  }
+
+  SECTION("Basis Universal images that can't be transcoded fail") {
+    // This has no supercompression global data, which BasisLZ requires.
+    const std::vector<std::byte> basis =
+        createKtx2(0, 4, 4, {std::vector<std::byte>(16)}, 1);
+    ImageReaderResult result = GltfReader::readImage(basis);
+    CHECK(!result.image);
+    CHECK(!result.errors.empty());
+  }
+
+  SECTION("images that are too large are rejected") {
+    // The size of the first level would overflow to 0 bytes.
+    const std::vector<std::byte> huge = createKtx2(
+        vkFormatR8G8B8A8Unorm,
+        0x80000000,
+        0x80000000,
+        {std::vector<std::byte>()});
+    ImageReaderResult result = GltfReader::readImage(huge);
+    CHECK(!result.image);
+    CHECK(!result.errors.empty());
+
+    const std::vector<std::byte> wide = createKtx2(
+        vkFormatBc1RgbUnorm,
+        40000,
+        4,
+        {std::vector<std::byte>(10000 * 8)});
+    result = GltfReader::readImage(wide);
+    CHECK(!result.image);
+    CHECK(!result.errors.empty());
+  }
+
+  SECTION("levels with the wrong size are rejected") {
+    const std::vector<std::byte> truncated =
+        createKtx2(vkFormatBc1RgbUnorm, 8, 8, {red});
+    ImageReaderResult result = GltfReader::readImage(truncated);
+    CHECK(!result.image);
+    CHECK(!result.errors.empty());
+  }
+}
+
+TEST_CASE("GltfReader::readImage transcodes UASTC KTX2 images") {
+  const bool zstd = GENERATE(false, true);
+  const std::vector<std::byte> opaque = createUastcKtx2(
+      createSolidUastcBlock(255, 0, 0, 255),
+      false,
+      zstd);
+  const std::vector<std::byte> translucent = createUastcKtx2(
+      createSolidUastcBlock(0, 255, 0, 128),
+      true,
+      zstd);
+
+  SECTION("to ASTC 4x4 first") {
+    Ktx2TranscodeTargets targets;
+    targets.astc4x4Rgba = true;
+    targets.bc7Rgba = true;
+    targets.etc2Rgb = true;
+    targets.etc2Rgba = true;
+    targets.bc1Rgb = true;
+    targets.bc3Rgba = true;
+    checkTranscodedLevels(
+        GltfReader::readImage(opaque, targets),
+        GpuCompressedPixelFormat::Astc4x4Rgba,
+        16);
+    checkTranscodedLevels(
+        GltfReader::readImage(translucent, targets),
+        GpuCompressedPixelFormat::Astc4x4Rgba,
+        16);
+  }
+
+  SECTION("to BC7") {
+    Ktx2TranscodeTargets targets;
+    targets.bc7Rgba = true;
+    targets.etc2Rgb = true;
+    targets.bc1Rgb = true;
+    checkTranscodedLevels(
+        GltfReader::readImage(opaque, targets),
+        GpuCompressedPixelFormat::Bc7Rgba,
+        16);
+  }
+
+  SECTION("to ETC2") {
+    Ktx2TranscodeTargets targets;
+    targets.etc2Rgb = true;
+    targets.etc2Rgba = true;
+    targets.bc1Rgb = true;
+    targets.bc3Rgba = true;
+    checkTranscodedLevels(
+        GltfReader::readImage(opaque, targets),
+        GpuCompressedPixelFormat::Etc2Rgb,
+        8);
+    checkTranscodedLevels(
+        GltfReader::readImage(translucent, targets),
+        GpuCompressedPixelFormat::Etc2Rgba,
+        16);
+  }
+
+  SECTION("to BC1 and BC3") {
+    Ktx2TranscodeTargets targets;
+    targets.bc1Rgb = true;
+    targets.bc3Rgba = true;
+    checkTranscodedLevels(
+        GltfReader::readImage(opaque, targets),
+        GpuCompressedPixelFormat::Bc1Rgb,
+        8);
+    checkTranscodedLevels(
+        GltfReader::readImage(translucent, targets),
+        GpuCompressedPixelFormat::Bc3Rgba,
+        16);
+  }
+
+  SECTION("to 8-bit RGBA if the renderer supports none of the candidates") {
+    // BC4 and BC5 hold too few channels to be transcoding targets.
+    Ktx2TranscodeTargets targets;
+    targets.bc4R = true;
+    targets.bc5Rg = true;
+
+    ImageReaderResult result = GltfReader::readImage(translucent, targets);
+    CHECK(result.errors.empty());
+    REQUIRE(result.image);
+    const ImageCesium& image = *result.image;
+    CHECK(image.compressedPixelFormat == GpuCompressedPixelFormat::None);
+    CHECK(image.channels == 4);
+    CHECK(image.bytesPerChannel == 1);
+    REQUIRE(image.mipPositions.size() == 3);
+    CHECK(image.mipPositions[0].byteSize == 6 * 5 * 4);
+    CHECK(image.mipPositions[1].byteSize == 3 * 2 * 4);
+    CHECK(image.mipPositions[2].byteSize == 1 * 1 * 4);
+    REQUIRE(image.pixelData.size() == (30 + 6 + 1) * 4);
+
+    for (size_t i = 0; i < image.pixelData.size(); i += 4) {
+      CHECK(image.pixelData[i] == std::byte(0));
+      CHECK(image.pixelData[i + 1] == std::byte(255));
+      CHECK(image.pixelData[i + 2] == std::byte(0));
+      CHECK(image.pixelData[i + 3] == std::byte(128));
+    }
+  }
+
+  SECTION("unless their levels are truncated") {
+    std::vector<std::byte> truncated = opaque;
+    truncated.resize(truncated.size() - 8);
+    ImageReaderResult result = GltfReader::readImage(truncated);
+    CHECK(!result.image);
+    CHECK(!result.errors.empty());
+  }
+}
+
+TEST_CASE("Compressed images can be read back from KTX2") {
+  ImageCesium image;
+  image.width = 8;
+  image.height = 4;
+  image.pixelData.resize(8 * 4 * 4);
+  for (size_t i = 0; i < image.pixelData.size(); i += 4) {
+    image.pixelData[i] = std::byte(0);
+    image.pixelData[i + 1] = std::byte(0);
+    image.pixelData[i + 2] = std::byte(255);
+    image.pixelData[i + 3] = std::byte(255);
+  }
+
+  REQUIRE(ImageManipulation::generateMipMaps(image));
+  REQUIRE(ImageManipulation::compressBlocks(
+      image,
+      GpuCompressedPixelFormat::Bc1Rgb));
+
+  std::vector<std::vector<std::byte>> levels;
+  for (const ImageCesiumMipPosition& position : image.mipPositions) {
+    levels.emplace_back(
+        image.pixelData.begin() + int64_t(position.byteOffset),
+        image.pixelData.begin() +
+            int64_t(position.byteOffset + position.byteSize));
+  }
+
+  ImageReaderResult result =
+      GltfReader::readImage(createKtx2(vkFormatBc1RgbUnorm, 8, 4, levels));
+  CHECK(result.errors.empty());
+  REQUIRE(result.image);
+  REQUIRE(result.image->mipPositions.size() == 4);
+
+  for (size_t i = 0; i < result.image->pixelData.size(); i += 4) {
+    const uint8_t* pPixel =
+        reinterpret_cast<const uint8_t*>(result.image->pixelData.data() + i);
+    CHECK(pPixel[0] <= 8);
+    CHECK(pPixel[1] <= 8);
+    CHECK(pPixel[2] >= 247);
+    CHECK(pPixel[3] == 255);
+  }
+}
+
+TEST_CASE("Can deserialize KHR_texture_basisu") {
+  const std::string s = R"(
+    {
+      "asset": { "version": "2.0" },
+      "extensionsUsed": [ "KHR_texture_basisu" ],
+      "images": [ { "uri": "fallback.png" }, { "uri": "texture.ktx2" } ],
+      "textures": [
+        {
+          "source": 0,
+          "extensions": { "KHR_texture_basisu": { "source": 1 } }
+        }
+      ]
+    }
+  )";
+
+  GltfReader reader;
+  ModelReaderResult result = reader.readModel(
+      gsl::span(reinterpret_cast<const std::byte*>(s.c_str()), s.size()));
+  CHECK(result.errors.empty());
+  REQUIRE(result.model);
+  REQUIRE(result.model->textures.size() == 1);
+
+  const ExtensionKhrTextureBasisu* pBasisu =
+      result.model->textures[0].getExtension<ExtensionKhrTextureBasisu>();
+  REQUIRE(pBasisu);
+  CHECK(pBasisu->source == 1);
+}
@@ -360,3 +360,126 @@ TEST_CASE("Unknown MIME types are handled") {
   // because no images could be read.
   REQUIRE(modelResult.model.has_value());
 }
+
+TEST_CASE("Embedded images can be decoded lazily") {
+  // A 2x1 BMP image with a red and a green pixel.
+  const std::string s = R"(
+    {
+        "asset" : {
+            "version" : "2.0"
+        },
+        "buffers": [
+            {
+              "byteLength": 62,
+              "uri": "data:application/octet-stream;base64,Qk0+AAAAAAAAADYAAAAoAAAAAgAAAAEAAAABABgAAAAAAAgAAAATCwAAEwsAAAAAAAAAAAAAAAD/AP8AAAA="
+            }
+        ],
+        "bufferViews": [
+            { "buffer": 0, "byteOffset": 0, "byteLength": 62 }
+        ],
+        "images": [
+            { "bufferView": 0, "mimeType": "image/bmp" }
+        ]
+    }
+  )";
+
+  const std::vector<std::byte> expectedPixels{
+      std::byte(255),
+      std::byte(0),
+      std::byte(0),
+      std::byte(255),
+      std::byte(0),
+      std::byte(255),
+      std::byte(0),
+      std::byte(255)};
+
+  GltfReader reader;
+  ReadModelOptions options;
+  options.decodeEmbeddedImages = false;
+  ModelReaderResult result = reader.readModel(
+      gsl::span(reinterpret_cast<const std::byte*>(s.c_str()), s.size()),
+      options);
+  REQUIRE(result.errors.empty());
+  REQUIRE(result.model);
+  REQUIRE(result.model->images.size() == 1);
+  CHECK(result.model->images[0].cesium.pixelData.empty());
+
+  SECTION("readEmbeddedImage decodes without modifying the model") {
+    ImageReaderResult imageResult =
+        GltfReader::readEmbeddedImage(*result.model, result.model->images[0]);
+    REQUIRE(imageResult.image);
+    CHECK(imageResult.image->width == 2);
+    CHECK(imageResult.image->height == 1);
+    CHECK(imageResult.image->pixelData == expectedPixels);
+    CHECK(result.model->images[0].cesium.pixelData.empty());
+  }
+
+  SECTION("decodeEmbeddedImages decodes the images of the model") {
+    GltfReader::decodeEmbeddedImages(result);
+    CHECK(result.errors.empty());
+    const ImageCesium& image = result.model->images[0].cesium;
+    CHECK(image.width == 2);
+    CHECK(image.height == 1);
+    CHECK(image.pixelData == expectedPixels);
+  }
+}
+
+TEST_CASE("Mip levels can be generated for decoded images") {
+  // A 2x1 BMP image with a red and a green pixel.
+  const std::string s = R"(
+    {
+        "asset" : {
+            "version" : "2.0"
+        },
+        "buffers": [
+            {
+              "byteLength": 62,
+              "uri": "data:application/octet-stream;base64,Qk0+AAAAAAAAADYAAAAoAAAAAgAAAAEAAAABABgAAAAAAAgAAAATCwAAEwsAAAAAAAAAAAAAAAD/AP8AAAA="
+            }
+        ],
+        "bufferViews": [
+            { "buffer": 0, "byteOffset": 0, "byteLength": 62 }
+        ],
+        "images": [
+            { "bufferView": 0, "mimeType": "image/bmp" }
+        ]
+    }
+  )";
+
+  GltfReader reader;
+  ReadModelOptions options;
+  options.generateMipMaps = true;
+  ModelReaderResult result = reader.readModel(
+      gsl::span(reinterpret_cast<const std::byte*>(s.c_str()), s.size()),
+      options);
+  REQUIRE(result.errors.empty());
+  REQUIRE(result.model);
+  REQUIRE(result.model->images.size() == 1);
+
+  const ImageCesium& image = result.model->images[0].cesium;
+  CHECK(image.width == 2);
+  CHECK(image.height == 1);
+
+  // The full-size image is followed by a single pixel that averages the red
+  // and green pixels.
+  const std::vector<std::byte> expectedPixels{
+      std::byte(255),
+      std::byte(0),
+      std::byte(0),
+      std::byte(255),
+      std::byte(0),
+      std::byte(255),
+      std::byte(0),
+      std::byte(255),
+      std::byte(128),
+      std::byte(128),
+      std::byte(0),
+      std::byte(255)};
+  CHECK(image.pixelData == expectedPixels);
+
+  REQUIRE(image.mipPositions.size() == 2);
+  CHECK(image.mipPositions[0].byteOffset == 0);
+  CHECK(image.mipPositions[0].byteSize == 8);
+  CHECK(image.mipPositions[1].byteOffset == 8);
+  CHECK(image.mipPositions[1].byteSize == 4);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Library.h"
+
+#include <cstddef>
+
+namespace CesiumGltfWriter {
+
+/**
+ * @brief The sizes and offsets of the parts of a GLB, which can be computed
+ * from the lengths of its JSON and binary data before any of it is written.
+ *
+ * Both chunks are padded to a multiple of 4 bytes, the JSON chunk with spaces
+ * and the binary chunk with zeros. A GLB without binary data has no binary
+ * chunk.
+ */
+struct CESIUMGLTFWRITER_API GlbLayout {
+  /**
+   * @brief The byte offset of the JSON chunk's data.
+   */
+  size_t jsonOffset = 0;
+
+  /**
+   * @brief The length of the JSON, without padding.
+   */
+  size_t jsonLength = 0;
+
+  /**
+   * @brief The length of the JSON chunk's data, including padding.
+   */
+  size_t jsonChunkLength = 0;
+
+  /**
+   * @brief The byte offset of the binary chunk's data, or 0 if there is no
+   * binary chunk.
+   */
+  size_t binaryOffset = 0;
+
+  /**
+   * @brief The length of the binary data, without padding.
+   */
+  size_t binaryLength = 0;
+
+  /**
+   * @brief The length of the binary chunk's data, including padding.
+   */
+  size_t binaryChunkLength = 0;
+
+  /**
+   * @brief The length of the whole GLB.
+   */
+  size_t totalLength = 0;
+
+  /**
+   * @brief Whether the GLB is small enough for the 32-bit lengths of its
+   * header and chunk headers.
+   */
+  bool fitsInGlb() const noexcept;
+};
+
+/**
+ * @brief Computes the layout of a GLB with the given lengths of JSON and
+ * binary data.
+ *
+ * @param jsonLength The length of the JSON, without padding.
+ * @param binaryLength The length of the binary data, without padding, or 0
+ * if the GLB has no binary chunk.
+ */
+CESIUMGLTFWRITER_API GlbLayout
+computeGlbLayout(size_t jsonLength, size_t binaryLength) noexcept;
+
+} // namespace CesiumGltfWriter
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Library.h"
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <functional>
+
+namespace CesiumGltfWriter {
+
+/**
+ * @brief Callback that receives a streamed glTF or GLB, one consecutive piece
+ * after another.
+ *
+ * The data is only valid for the duration of the call, and may point straight
+ * into the model that is being written. The callback returns false if the
+ * data could not be written, which stops the stream.
+ */
+using WriteStreamCallback =
+    std::function<bool(const gsl::span<const std::byte>& data)>;
+
+/**
+ * @brief Creates a {@link WriteStreamCallback} that writes to a file
+ * descriptor, such as an open file or a socket.
+ *
+ * The file descriptor is not closed by the callback.
+ *
+ * @param fileDescriptor The file descriptor to write to.
+ */
+CESIUMGLTFWRITER_API WriteStreamCallback
+createFileDescriptorStream(int fileDescriptor);
+
+} // namespace CesiumGltfWriter
@@ -1,9 +1,11 @@
 #pragma once
 
+#include "GlbLayout.h"
 #include "Library.h"
 #include "WriteGLTFCallback.h"
 #include "WriteModelOptions.h"
 #include "WriteModelResult.h"
+#include "WriteStreamCallback.h"
 
 #include <CesiumGltf/Model.h>
 
@@ -82,4 +84,33 @@ CESIUMGLTFWRITER_API WriteModelResult writeModelAndExternalFiles(
     const WriteModelOptions& options,
     std::string_view filename,
     const WriteGLTFCallback& writeGLTFCallback);
+
+/**
+ * @brief Write a glTF or glb asset to a stream, piece by piece, without
+ * assembling it in memory first.
+ *
+ * @returns A {@link CesiumGltfWriter::WriteModelResult} containing a list of
+ * errors and warnings. Its `gltfAssetBytes` is always empty.
+ *
+ * @param model Final assembled glTF asset, ready for serialization.
+ * @param options Options to use for exporting the asset.
+ * @param stream Callback that receives the glTF or GLB. For a GLB, the layout
+ * is computed up front with {@link computeGlbLayout}, so the header, the JSON
+ * chunk and the binary chunk are written in a single pass, and the binary
+ * chunk is handed to the stream straight from `model.buffers[0].cesium.data`.
+ * @param writeGLTFCallback Callback that receives the external images and
+ * buffers, as in {@link CesiumGltfWriter::writeModelAndExternalFiles}. It is
+ * not called for the glTF or GLB itself.
+ * @details Serializes the model the same way as
+ * {@link CesiumGltfWriter::writeModelAsEmbeddedBytes}. Nothing is written to
+ * the stream if serializing the JSON reports an error. If the GLB would not
+ * fit the 32-bit lengths of the format, a GlbTooLarge error is returned, and
+ * if the stream rejects any of the data, a StreamWriteFailed error is
+ * returned.
+ */
+CESIUMGLTFWRITER_API WriteModelResult writeModelToStream(
+    const CesiumGltf::Model& model,
+    const WriteModelOptions& options,
+    const WriteStreamCallback& stream,
+    const WriteGLTFCallback& writeGLTFCallback = noopGltfWriter);
 } // namespace CesiumGltfWriter
@@ -7,12 +7,15 @@
 #include <CesiumGltf/AccessorSparseValues.h>
 #include <CesiumJsonWriter/JsonObjectWriter.h>
 #include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
 #include <stdexcept>
 
+template <typename TJsonWriter>
 void writeAccessorSparseIndices(
     const CesiumGltf::AccessorSparseIndices& indices,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   auto& j = jsonWriter;
   j.Key("indices");
   j.StartObject();
@@ -35,9 +38,10 @@ void writeAccessorSparseIndices(
   }
 }
 
+template <typename TJsonWriter>
 void writeAccessorSparseValues(
     const CesiumGltf::AccessorSparseValues& values,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   auto& j = jsonWriter;
   j.Key("values");
   j.StartObject();
@@ -58,9 +62,10 @@ void writeAccessorSparseValues(
   }
 }
 
+template <typename TJsonWriter>
 void CesiumGltfWriter::writeAccessorSparse(
     const CesiumGltf::AccessorSparse& accessorSparse,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   auto& j = jsonWriter;
   j.Key("sparse");
   j.StartObject();
@@ -80,3 +85,19 @@ void CesiumGltfWriter::writeAccessorSparse(
 
   j.EndObject();
 }
+
+template void CesiumGltfWriter::writeAccessorSparse(
+    const CesiumGltf::AccessorSparse& accessorSparse,
+    CesiumJsonWriter::JsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeAccessorSparse(
+    const CesiumGltf::AccessorSparse& accessorSparse,
+    CesiumJsonWriter::PrettyJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeAccessorSparse(
+    const CesiumGltf::AccessorSparse& accessorSparse,
+    CesiumJsonWriter::CompactStaticJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeAccessorSparse(
+    const CesiumGltf::AccessorSparse& accessorSparse,
+    CesiumJsonWriter::PrettyStaticJsonWriter& jsonWriter);
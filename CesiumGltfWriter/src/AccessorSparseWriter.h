@@ -1,10 +1,11 @@
 #pragma once
 
 #include <CesiumGltf/AccessorSparse.h>
-#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
 namespace CesiumGltfWriter {
+template <typename TJsonWriter>
 void writeAccessorSparse(
     const CesiumGltf::AccessorSparse& accessorSparse,
-    CesiumJsonWriter::JsonWriter& jsonWriter);
+    TJsonWriter& jsonWriter);
 }
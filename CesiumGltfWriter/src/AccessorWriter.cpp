@@ -4,13 +4,16 @@
 #include "ExtensionWriter.h"
 
 #include <CesiumJsonWriter/JsonObjectWriter.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
 
 #include <stdexcept>
 #include <type_traits>
 
+template <typename TJsonWriter>
 void CesiumGltfWriter::writeAccessor(
     const std::vector<CesiumGltf::Accessor>& accessors,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
 
   if (accessors.empty()) {
     return;
@@ -86,3 +89,19 @@ void CesiumGltfWriter::writeAccessor(
   }
   j.EndArray();
 }
+
+template void CesiumGltfWriter::writeAccessor(
+    const std::vector<CesiumGltf::Accessor>& accessors,
+    CesiumJsonWriter::JsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeAccessor(
+    const std::vector<CesiumGltf::Accessor>& accessors,
+    CesiumJsonWriter::PrettyJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeAccessor(
+    const std::vector<CesiumGltf::Accessor>& accessors,
+    CesiumJsonWriter::CompactStaticJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeAccessor(
+    const std::vector<CesiumGltf::Accessor>& accessors,
+    CesiumJsonWriter::PrettyStaticJsonWriter& jsonWriter);
@@ -2,10 +2,11 @@
 
 #include <CesiumGltf/Accessor.h>
 #include <CesiumGltf/AccessorSpec.h>
-#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
 namespace CesiumGltfWriter {
+template <typename TJsonWriter>
 void writeAccessor(
     const std::vector<CesiumGltf::Accessor>& accessors,
-    CesiumJsonWriter::JsonWriter& jsonWriter);
+    TJsonWriter& jsonWriter);
 }
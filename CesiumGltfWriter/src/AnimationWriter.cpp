@@ -5,13 +5,16 @@
 #include <CesiumGltf/AnimationChannel.h>
 #include <CesiumGltf/AnimationChannelTarget.h>
 #include <CesiumJsonWriter/JsonObjectWriter.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
 
 #include <stdexcept>
 #include <type_traits>
 
+template <typename TJsonWriter>
 void writeAnimationChannel(
     const CesiumGltf::AnimationChannel& animationChannel,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   auto& j = jsonWriter;
   j.StartObject();
   j.Key("sampler");
@@ -36,9 +39,10 @@ void writeAnimationChannel(
   j.EndObject();
 }
 
+template <typename TJsonWriter>
 void writeAnimationSampler(
     const CesiumGltf::AnimationSampler& animationSampler,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   auto& j = jsonWriter;
 
   j.StartObject();
@@ -58,10 +62,11 @@ void writeAnimationSampler(
   j.EndObject();
 }
 
+template <typename TJsonWriter>
 void CesiumGltfWriter::writeAnimation(
     CesiumGltfWriter::WriteModelResult& result,
     const std::vector<CesiumGltf::Animation>& animations,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
 
   if (animations.empty()) {
     return;
@@ -110,3 +115,23 @@ void CesiumGltfWriter::writeAnimation(
   }
   j.EndArray();
 }
+
+template void CesiumGltfWriter::writeAnimation(
+    CesiumGltfWriter::WriteModelResult& result,
+    const std::vector<CesiumGltf::Animation>& animations,
+    CesiumJsonWriter::JsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeAnimation(
+    CesiumGltfWriter::WriteModelResult& result,
+    const std::vector<CesiumGltf::Animation>& animations,
+    CesiumJsonWriter::PrettyJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeAnimation(
+    CesiumGltfWriter::WriteModelResult& result,
+    const std::vector<CesiumGltf::Animation>& animations,
+    CesiumJsonWriter::CompactStaticJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeAnimation(
+    CesiumGltfWriter::WriteModelResult& result,
+    const std::vector<CesiumGltf::Animation>& animations,
+    CesiumJsonWriter::PrettyStaticJsonWriter& jsonWriter);
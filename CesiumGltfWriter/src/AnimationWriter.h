@@ -2,13 +2,14 @@
 
 #include <CesiumGltf/Animation.h>
 #include <CesiumGltfWriter/WriteModelResult.h>
-#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
 #include <vector>
 
 namespace CesiumGltfWriter {
+template <typename TJsonWriter>
 void writeAnimation(
     CesiumGltfWriter::WriteModelResult& result,
     const std::vector<CesiumGltf::Animation>& animations,
-    CesiumJsonWriter::JsonWriter& jsonWriter);
+    TJsonWriter& jsonWriter);
 }
@@ -4,10 +4,13 @@
 
 #include <CesiumGltf/Asset.h>
 #include <CesiumJsonWriter/JsonObjectWriter.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
 
+template <typename TJsonWriter>
 void CesiumGltfWriter::writeAsset(
     const CesiumGltf::Asset& asset,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   auto& j = jsonWriter;
   j.Key("asset");
   j.StartObject();
@@ -37,3 +40,19 @@ void CesiumGltfWriter::writeAsset(
 
   j.EndObject();
 }
+
+template void CesiumGltfWriter::writeAsset(
+    const CesiumGltf::Asset& asset,
+    CesiumJsonWriter::JsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeAsset(
+    const CesiumGltf::Asset& asset,
+    CesiumJsonWriter::PrettyJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeAsset(
+    const CesiumGltf::Asset& asset,
+    CesiumJsonWriter::CompactStaticJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeAsset(
+    const CesiumGltf::Asset& asset,
+    CesiumJsonWriter::PrettyStaticJsonWriter& jsonWriter);
@@ -1,10 +1,11 @@
 #pragma once
 
 #include <CesiumGltf/Asset.h>
-#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
 namespace CesiumGltfWriter {
+template <typename TJsonWriter>
 void writeAsset(
     const CesiumGltf::Asset& asset,
-    CesiumJsonWriter::JsonWriter& jsonWriter);
+    TJsonWriter& jsonWriter);
 }
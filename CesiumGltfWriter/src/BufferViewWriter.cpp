@@ -3,13 +3,16 @@
 #include "ExtensionWriter.h"
 
 #include <CesiumJsonWriter/JsonObjectWriter.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
 
 #include <stdexcept>
 #include <type_traits>
 
+template <typename TJsonWriter>
 void CesiumGltfWriter::writeBufferView(
     const std::vector<CesiumGltf::BufferView>& bufferViews,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
 
   if (bufferViews.empty()) {
     return;
@@ -60,3 +63,19 @@ void CesiumGltfWriter::writeBufferView(
   }
   j.EndArray();
 }
+
+template void CesiumGltfWriter::writeBufferView(
+    const std::vector<CesiumGltf::BufferView>& bufferViews,
+    CesiumJsonWriter::JsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeBufferView(
+    const std::vector<CesiumGltf::BufferView>& bufferViews,
+    CesiumJsonWriter::PrettyJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeBufferView(
+    const std::vector<CesiumGltf::BufferView>& bufferViews,
+    CesiumJsonWriter::CompactStaticJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeBufferView(
+    const std::vector<CesiumGltf::BufferView>& bufferViews,
+    CesiumJsonWriter::PrettyStaticJsonWriter& jsonWriter);
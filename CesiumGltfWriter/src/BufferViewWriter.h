@@ -1,12 +1,13 @@
 #pragma once
 
 #include <CesiumGltf/BufferView.h>
-#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
 #include <vector>
 
 namespace CesiumGltfWriter {
+template <typename TJsonWriter>
 void writeBufferView(
     const std::vector<CesiumGltf::BufferView>& animations,
-    CesiumJsonWriter::JsonWriter& jsonWriter);
+    TJsonWriter& jsonWriter);
 }
@@ -6,13 +6,16 @@
 
 #include <CesiumGltfWriter/WriteModelOptions.h>
 #include <CesiumJsonWriter/JsonObjectWriter.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
 
 #include <string_view>
 
+template <typename TJsonWriter>
 void CesiumGltfWriter::writeBuffer(
     WriteModelResult& result,
     const std::vector<CesiumGltf::Buffer>& buffers,
-    CesiumJsonWriter::JsonWriter& jsonWriter,
+    TJsonWriter& jsonWriter,
     const WriteModelOptions& options,
     WriteGLTFCallback writeGLTFCallback) {
   auto& j = jsonWriter;
@@ -130,3 +133,31 @@ void CesiumGltfWriter::writeBuffer(
 
   j.EndArray();
 }
+
+template void CesiumGltfWriter::writeBuffer(
+    WriteModelResult& result,
+    const std::vector<CesiumGltf::Buffer>& buffers,
+    CesiumJsonWriter::JsonWriter& jsonWriter,
+    const WriteModelOptions& options,
+    WriteGLTFCallback writeGLTFCallback);
+
+template void CesiumGltfWriter::writeBuffer(
+    WriteModelResult& result,
+    const std::vector<CesiumGltf::Buffer>& buffers,
+    CesiumJsonWriter::PrettyJsonWriter& jsonWriter,
+    const WriteModelOptions& options,
+    WriteGLTFCallback writeGLTFCallback);
+
+template void CesiumGltfWriter::writeBuffer(
+    WriteModelResult& result,
+    const std::vector<CesiumGltf::Buffer>& buffers,
+    CesiumJsonWriter::CompactStaticJsonWriter& jsonWriter,
+    const WriteModelOptions& options,
+    WriteGLTFCallback writeGLTFCallback);
+
+template void CesiumGltfWriter::writeBuffer(
+    WriteModelResult& result,
+    const std::vector<CesiumGltf::Buffer>& buffers,
+    CesiumJsonWriter::PrettyStaticJsonWriter& jsonWriter,
+    const WriteModelOptions& options,
+    WriteGLTFCallback writeGLTFCallback);
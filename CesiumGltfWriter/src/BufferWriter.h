@@ -4,17 +4,18 @@
 #include <CesiumGltfWriter/WriteGLTFCallback.h>
 #include <CesiumGltfWriter/WriteModelOptions.h>
 #include <CesiumGltfWriter/WriteModelResult.h>
-#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
 #include <cstdint>
 #include <utility>
 #include <vector>
 
 namespace CesiumGltfWriter {
+template <typename TJsonWriter>
 void writeBuffer(
     WriteModelResult& result,
     const std::vector<CesiumGltf::Buffer>& buffers,
-    CesiumJsonWriter::JsonWriter& jsonWriter,
+    TJsonWriter& jsonWriter,
     const WriteModelOptions& options,
     WriteGLTFCallback writeGLTFCallback = noopGltfWriter);
 }
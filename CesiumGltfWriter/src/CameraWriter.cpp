@@ -7,14 +7,17 @@
 #include <CesiumGltf/CameraPerspective.h>
 #include <CesiumJsonWriter/JsonObjectWriter.h>
 #include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
 #include <cstdint>
 #include <utility>
 #include <vector>
 
+template <typename TJsonWriter>
 void writeOrthographicCamera(
     const CesiumGltf::CameraOrthographic& cameraOrthographic,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   auto& j = jsonWriter;
   j.Key("orthographic");
   j.StartObject();
@@ -39,9 +42,10 @@ void writeOrthographicCamera(
   j.EndObject();
 }
 
+template <typename TJsonWriter>
 void writePerspectiveCamera(
     const CesiumGltf::CameraPerspective& cameraPerspective,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   auto& j = jsonWriter;
   j.Key("perspective");
   j.StartObject();
@@ -69,9 +73,10 @@ void writePerspectiveCamera(
   j.EndObject();
 }
 
+template <typename TJsonWriter>
 void CesiumGltfWriter::writeCamera(
     const std::vector<CesiumGltf::Camera>& cameras,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   if (cameras.empty()) {
     return;
   }
@@ -112,3 +117,19 @@ void CesiumGltfWriter::writeCamera(
   }
   j.EndArray();
 }
+
+template void CesiumGltfWriter::writeCamera(
+    const std::vector<CesiumGltf::Camera>& cameras,
+    CesiumJsonWriter::JsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeCamera(
+    const std::vector<CesiumGltf::Camera>& cameras,
+    CesiumJsonWriter::PrettyJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeCamera(
+    const std::vector<CesiumGltf::Camera>& cameras,
+    CesiumJsonWriter::CompactStaticJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeCamera(
+    const std::vector<CesiumGltf::Camera>& cameras,
+    CesiumJsonWriter::PrettyStaticJsonWriter& jsonWriter);
@@ -1,10 +1,11 @@
 #pragma once
 
 #include <CesiumGltf/Camera.h>
-#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
 namespace CesiumGltfWriter {
+template <typename TJsonWriter>
 void writeCamera(
     const std::vector<CesiumGltf::Camera>& cameras,
-    CesiumJsonWriter::JsonWriter& jsonWriter);
+    TJsonWriter& jsonWriter);
 }
@@ -1,13 +1,488 @@
 #include "ExtensionWriter.h"
 
+#include <CesiumGltf/ExtensionBufferExtMeshoptCompression.h>
+#include <CesiumGltf/ExtensionBufferViewExtMeshoptCompression.h>
+#include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
+#include <CesiumGltf/ExtensionKhrTextureBasisu.h>
+#include <CesiumGltf/ExtensionMeshPrimitiveExtFeatureMetadata.h>
+#include <CesiumGltf/ExtensionModelExtFeatureMetadata.h>
 #include <CesiumJsonWriter/JsonObjectWriter.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
 #include <CesiumUtility/JsonValue.h>
 
+#include <optional>
+#include <string>
+#include <typeinfo>
+
+using namespace CesiumGltf;
 using namespace CesiumUtility;
 
+namespace {
+
+// Writes the extensions and extras that every glTF object may have. The
+// caller has already started the object.
+template <typename TJsonWriter>
+void writeExtensibleObject(const ExtensibleObject& object, TJsonWriter& j) {
+  CesiumGltfWriter::writeExtensions(object.extensions, j);
+
+  if (!object.extras.empty()) {
+    j.Key("extras");
+    CesiumJsonWriter::writeJsonValue(object.extras, j);
+  }
+}
+
+template <typename TJsonWriter>
+void writeOptionalString(
+    std::string_view key,
+    const std::optional<std::string>& value,
+    TJsonWriter& j) {
+  if (value) {
+    j.KeyPrimitive(key, *value);
+  }
+}
+
+template <typename TJsonWriter>
+void writeOptionalJsonValue(
+    std::string_view key,
+    const JsonValue& value,
+    TJsonWriter& j) {
+  if (!value.isNull()) {
+    j.Key(key);
+    CesiumJsonWriter::writeJsonValue(value, j);
+  }
+}
+
+template <typename TJsonWriter>
+void writeBool(std::string_view key, bool value, TJsonWriter& j) {
+  j.Key(key);
+  j.Bool(value);
+}
+
+template <typename TJsonWriter, typename T, typename TWriteValue>
+void writeMap(
+    std::string_view key,
+    const std::unordered_map<std::string, T>& map,
+    TJsonWriter& j,
+    TWriteValue&& writeValue) {
+  if (map.empty()) {
+    return;
+  }
+
+  j.KeyObject(key, [&]() {
+    for (const auto& [name, value] : map) {
+      j.Key(name);
+      writeValue(value, j);
+    }
+  });
+}
+
+template <typename TJsonWriter>
+void writeDraco(
+    const ExtensionKhrDracoMeshCompression& draco,
+    TJsonWriter& j) {
+  j.StartObject();
+  j.KeyPrimitive("bufferView", draco.bufferView);
+  j.KeyObject("attributes", [&]() {
+    for (const auto& [name, id] : draco.attributes) {
+      j.KeyPrimitive(name, id);
+    }
+  });
+  writeExtensibleObject(draco, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeBasisu(const ExtensionKhrTextureBasisu& basisu, TJsonWriter& j) {
+  j.StartObject();
+  if (basisu.source >= 0) {
+    j.KeyPrimitive("source", basisu.source);
+  }
+  writeExtensibleObject(basisu, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeMeshoptBuffer(
+    const ExtensionBufferExtMeshoptCompression& meshopt,
+    TJsonWriter& j) {
+  j.StartObject();
+  if (meshopt.fallback) {
+    writeBool("fallback", meshopt.fallback, j);
+  }
+  writeExtensibleObject(meshopt, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeMeshoptBufferView(
+    const ExtensionBufferViewExtMeshoptCompression& meshopt,
+    TJsonWriter& j) {
+  j.StartObject();
+  j.KeyPrimitive("buffer", meshopt.buffer);
+  if (meshopt.byteOffset != 0) {
+    j.KeyPrimitive("byteOffset", meshopt.byteOffset);
+  }
+  j.KeyPrimitive("byteLength", meshopt.byteLength);
+  j.KeyPrimitive("byteStride", meshopt.byteStride);
+  j.KeyPrimitive("count", meshopt.count);
+  j.KeyPrimitive("mode", meshopt.mode);
+  if (meshopt.filter !=
+      ExtensionBufferViewExtMeshoptCompression::Filter::NONE) {
+    j.KeyPrimitive("filter", meshopt.filter);
+  }
+  writeExtensibleObject(meshopt, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeTextureInfo(const TextureInfo& textureInfo, TJsonWriter& j) {
+  j.StartObject();
+  j.KeyPrimitive("index", textureInfo.index);
+  if (textureInfo.texCoord != 0) {
+    j.KeyPrimitive("texCoord", textureInfo.texCoord);
+  }
+  writeExtensibleObject(textureInfo, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeTextureAccessor(const TextureAccessor& accessor, TJsonWriter& j) {
+  j.StartObject();
+  j.KeyPrimitive("channels", accessor.channels);
+  j.Key("texture");
+  writeTextureInfo(accessor.texture, j);
+  writeExtensibleObject(accessor, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeFeatureIDs(const FeatureIDs& featureIDs, TJsonWriter& j) {
+  j.StartObject();
+  writeOptionalString("attribute", featureIDs.attribute, j);
+  if (featureIDs.constant != 0) {
+    j.KeyPrimitive("constant", featureIDs.constant);
+  }
+  if (featureIDs.divisor != 0) {
+    j.KeyPrimitive("divisor", featureIDs.divisor);
+  }
+  writeExtensibleObject(featureIDs, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeFeatureIDAttribute(
+    const FeatureIDAttribute& attribute,
+    TJsonWriter& j) {
+  j.StartObject();
+  j.KeyPrimitive("featureTable", attribute.featureTable);
+  j.Key("featureIds");
+  writeFeatureIDs(attribute.featureIds, j);
+  writeExtensibleObject(attribute, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeFeatureIDTexture(const FeatureIDTexture& texture, TJsonWriter& j) {
+  j.StartObject();
+  j.KeyPrimitive("featureTable", texture.featureTable);
+  j.Key("featureIds");
+  writeTextureAccessor(texture.featureIds, j);
+  writeExtensibleObject(texture, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeClassProperty(const ClassProperty& property, TJsonWriter& j) {
+  j.StartObject();
+  writeOptionalString("name", property.name, j);
+  writeOptionalString("description", property.description, j);
+  j.KeyPrimitive("type", property.type);
+  writeOptionalString("enumType", property.enumType, j);
+  writeOptionalString("componentType", property.componentType, j);
+  if (property.componentCount) {
+    j.KeyPrimitive("componentCount", *property.componentCount);
+  }
+  if (property.normalized) {
+    writeBool("normalized", property.normalized, j);
+  }
+  writeOptionalJsonValue("max", property.max, j);
+  writeOptionalJsonValue("min", property.min, j);
+  writeOptionalJsonValue("default", property.defaultProperty, j);
+  if (property.optional) {
+    writeBool("optional", property.optional, j);
+  }
+  writeOptionalString("semantic", property.semantic, j);
+  writeExtensibleObject(property, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeClass(const Class& classDefinition, TJsonWriter& j) {
+  j.StartObject();
+  writeOptionalString("name", classDefinition.name, j);
+  writeOptionalString("description", classDefinition.description, j);
+  writeMap(
+      "properties",
+      classDefinition.properties,
+      j,
+      writeClassProperty<TJsonWriter>);
+  writeExtensibleObject(classDefinition, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeEnum(const Enum& enumDefinition, TJsonWriter& j) {
+  j.StartObject();
+  writeOptionalString("name", enumDefinition.name, j);
+  writeOptionalString("description", enumDefinition.description, j);
+  j.KeyPrimitive("valueType", enumDefinition.valueType);
+  j.KeyArray("values", [&]() {
+    for (const EnumValue& value : enumDefinition.values) {
+      j.StartObject();
+      j.KeyPrimitive("name", value.name);
+      writeOptionalString("description", value.description, j);
+      j.KeyPrimitive("value", value.value);
+      writeExtensibleObject(value, j);
+      j.EndObject();
+    }
+  });
+  writeExtensibleObject(enumDefinition, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeSchema(const Schema& schema, TJsonWriter& j) {
+  j.StartObject();
+  writeOptionalString("name", schema.name, j);
+  writeOptionalString("description", schema.description, j);
+  writeOptionalString("version", schema.version, j);
+  writeMap("classes", schema.classes, j, writeClass<TJsonWriter>);
+  writeMap("enums", schema.enums, j, writeEnum<TJsonWriter>);
+  writeExtensibleObject(schema, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writePropertyStatistics(
+    const PropertyStatistics& statistics,
+    TJsonWriter& j) {
+  j.StartObject();
+  writeOptionalJsonValue("min", statistics.min, j);
+  writeOptionalJsonValue("max", statistics.max, j);
+  writeOptionalJsonValue("mean", statistics.mean, j);
+  writeOptionalJsonValue("median", statistics.median, j);
+  writeOptionalJsonValue(
+      "standardDeviation",
+      statistics.standardDeviation,
+      j);
+  writeOptionalJsonValue("variance", statistics.variance, j);
+  writeOptionalJsonValue("sum", statistics.sum, j);
+  writeMap(
+      "occurrences",
+      statistics.occurrences,
+      j,
+      [](const JsonValue& value, TJsonWriter& writer) {
+        CesiumJsonWriter::writeJsonValue(value, writer);
+      });
+  writeExtensibleObject(statistics, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeClassStatistics(const ClassStatistics& statistics, TJsonWriter& j) {
+  j.StartObject();
+  if (statistics.count) {
+    j.KeyPrimitive("count", *statistics.count);
+  }
+  writeMap(
+      "properties",
+      statistics.properties,
+      j,
+      writePropertyStatistics<TJsonWriter>);
+  writeExtensibleObject(statistics, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeStatistics(const Statistics& statistics, TJsonWriter& j) {
+  j.StartObject();
+  writeMap(
+      "classes",
+      statistics.classes,
+      j,
+      writeClassStatistics<TJsonWriter>);
+  writeExtensibleObject(statistics, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeFeatureTableProperty(
+    const FeatureTableProperty& property,
+    TJsonWriter& j) {
+  j.StartObject();
+  j.KeyPrimitive("bufferView", property.bufferView);
+  if (property.offsetType != FeatureTableProperty::OffsetType::UINT32) {
+    j.KeyPrimitive("offsetType", property.offsetType);
+  }
+  if (property.arrayOffsetBufferView >= 0) {
+    j.KeyPrimitive("arrayOffsetBufferView", property.arrayOffsetBufferView);
+  }
+  if (property.stringOffsetBufferView >= 0) {
+    j.KeyPrimitive("stringOffsetBufferView", property.stringOffsetBufferView);
+  }
+  writeExtensibleObject(property, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeFeatureTable(const FeatureTable& featureTable, TJsonWriter& j) {
+  j.StartObject();
+  writeOptionalString("class", featureTable.classProperty, j);
+  j.KeyPrimitive("count", featureTable.count);
+  writeMap(
+      "properties",
+      featureTable.properties,
+      j,
+      writeFeatureTableProperty<TJsonWriter>);
+  writeExtensibleObject(featureTable, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeFeatureTexture(const FeatureTexture& featureTexture, TJsonWriter& j) {
+  j.StartObject();
+  j.KeyPrimitive("class", featureTexture.classProperty);
+  writeMap(
+      "properties",
+      featureTexture.properties,
+      j,
+      writeTextureAccessor<TJsonWriter>);
+  writeExtensibleObject(featureTexture, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writeModelFeatureMetadata(
+    const ExtensionModelExtFeatureMetadata& metadata,
+    TJsonWriter& j) {
+  j.StartObject();
+  if (metadata.schema) {
+    j.Key("schema");
+    writeSchema(*metadata.schema, j);
+  }
+  writeOptionalString("schemaUri", metadata.schemaUri, j);
+  if (metadata.statistics) {
+    j.Key("statistics");
+    writeStatistics(*metadata.statistics, j);
+  }
+  writeMap(
+      "featureTables",
+      metadata.featureTables,
+      j,
+      writeFeatureTable<TJsonWriter>);
+  writeMap(
+      "featureTextures",
+      metadata.featureTextures,
+      j,
+      writeFeatureTexture<TJsonWriter>);
+  writeExtensibleObject(metadata, j);
+  j.EndObject();
+}
+
+template <typename TJsonWriter>
+void writePrimitiveFeatureMetadata(
+    const ExtensionMeshPrimitiveExtFeatureMetadata& metadata,
+    TJsonWriter& j) {
+  j.StartObject();
+  if (!metadata.featureIdAttributes.empty()) {
+    j.KeyArray("featureIdAttributes", [&]() {
+      for (const FeatureIDAttribute& attribute : metadata.featureIdAttributes) {
+        writeFeatureIDAttribute(attribute, j);
+      }
+    });
+  }
+  if (!metadata.featureIdTextures.empty()) {
+    j.KeyArray("featureIdTextures", [&]() {
+      for (const FeatureIDTexture& texture : metadata.featureIdTextures) {
+        writeFeatureIDTexture(texture, j);
+      }
+    });
+  }
+  if (!metadata.featureTextures.empty()) {
+    j.KeyArray("featureTextures", [&]() {
+      for (const std::string& featureTexture : metadata.featureTextures) {
+        j.String(featureTexture);
+      }
+    });
+  }
+  writeExtensibleObject(metadata, j);
+  j.EndObject();
+}
+
+// Checks that writeExtension knows how to write a type.
+bool isWritableExtension(const std::any& extension) noexcept {
+  const std::type_info& type = extension.type();
+  return type == typeid(JsonValue::Object) ||
+         type == typeid(JsonValue::Array) || type == typeid(JsonValue) ||
+         type == typeid(ExtensionKhrDracoMeshCompression) ||
+         type == typeid(ExtensionKhrTextureBasisu) ||
+         type == typeid(ExtensionBufferExtMeshoptCompression) ||
+         type == typeid(ExtensionBufferViewExtMeshoptCompression) ||
+         type == typeid(ExtensionModelExtFeatureMetadata) ||
+         type == typeid(ExtensionMeshPrimitiveExtFeatureMetadata);
+}
+
+// Writes an extension of one of the types that the reader creates.
+template <typename TJsonWriter>
+void writeExtension(const std::any& extension, TJsonWriter& j) {
+  const std::type_info& type = extension.type();
+
+  if (type == typeid(JsonValue::Object)) {
+    CesiumJsonWriter::writeJsonValue(
+        std::any_cast<const JsonValue::Object&>(extension),
+        j);
+  } else if (type == typeid(JsonValue::Array)) {
+    CesiumJsonWriter::writeJsonValue(
+        std::any_cast<const JsonValue::Array&>(extension),
+        j);
+  } else if (type == typeid(JsonValue)) {
+    CesiumJsonWriter::writeJsonValue(
+        std::any_cast<const JsonValue&>(extension),
+        j);
+  } else if (type == typeid(ExtensionKhrDracoMeshCompression)) {
+    writeDraco(
+        std::any_cast<const ExtensionKhrDracoMeshCompression&>(extension),
+        j);
+  } else if (type == typeid(ExtensionKhrTextureBasisu)) {
+    writeBasisu(std::any_cast<const ExtensionKhrTextureBasisu&>(extension), j);
+  } else if (type == typeid(ExtensionBufferExtMeshoptCompression)) {
+    writeMeshoptBuffer(
+        std::any_cast<const ExtensionBufferExtMeshoptCompression&>(extension),
+        j);
+  } else if (type == typeid(ExtensionBufferViewExtMeshoptCompression)) {
+    writeMeshoptBufferView(
+        std::any_cast<const ExtensionBufferViewExtMeshoptCompression&>(
+            extension),
+        j);
+  } else if (type == typeid(ExtensionModelExtFeatureMetadata)) {
+    writeModelFeatureMetadata(
+        std::any_cast<const ExtensionModelExtFeatureMetadata&>(extension),
+        j);
+  } else if (type == typeid(ExtensionMeshPrimitiveExtFeatureMetadata)) {
+    writePrimitiveFeatureMetadata(
+        std::any_cast<const ExtensionMeshPrimitiveExtFeatureMetadata&>(
+            extension),
+        j);
+  }
+}
+
+} // namespace
+
+template <typename TJsonWriter>
 void CesiumGltfWriter::writeExtensions(
     const std::unordered_map<std::string, std::any>& extensions,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   if (extensions.empty()) {
     return;
   }
@@ -16,30 +491,32 @@ void CesiumGltfWriter::writeExtensions(
   j.Key("extensions");
   j.StartObject();
 
+  // Always assume we're inside of an object, ExtensibleObject::extensions
+  // forces extensions to be in a key / value setup. Extensions of unknown
+  // types are skipped, because writing their key without a value would make
+  // the JSON invalid.
   for (const auto& extension : extensions) {
-    const auto isObject = extension.second.type() == typeid(JsonValue::Object);
-    const auto isArray = extension.second.type() == typeid(JsonValue::Array);
-    const auto isPrimitive = extension.second.type() == typeid(JsonValue);
-
-    // Always assume we're inside of an object, ExtensibleObject::extensions
-    // forces extensions to be in a key / value setup.
-    j.Key(extension.first);
-
-    if (isObject) {
-      const auto& object = std::any_cast<JsonValue::Object>(extension.second);
-      writeJsonValue(object, jsonWriter);
-    }
-
-    else if (isArray) {
-      const auto& array = std::any_cast<JsonValue::Array>(extension.second);
-      writeJsonValue(array, jsonWriter);
-    }
-
-    else if (isPrimitive) {
-      const auto& primitive = std::any_cast<JsonValue>(extension.second);
-      writeJsonValue(primitive, jsonWriter);
+    if (isWritableExtension(extension.second)) {
+      j.Key(extension.first);
+      writeExtension(extension.second, j);
     }
   }
 
   j.EndObject();
 }
+
+template void CesiumGltfWriter::writeExtensions(
+    const std::unordered_map<std::string, std::any>& extensions,
+    CesiumJsonWriter::JsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeExtensions(
+    const std::unordered_map<std::string, std::any>& extensions,
+    CesiumJsonWriter::PrettyJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeExtensions(
+    const std::unordered_map<std::string, std::any>& extensions,
+    CesiumJsonWriter::CompactStaticJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeExtensions(
+    const std::unordered_map<std::string, std::any>& extensions,
+    CesiumJsonWriter::PrettyStaticJsonWriter& jsonWriter);
@@ -1,12 +1,13 @@
 #pragma once
 
-#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
 #include <any>
 #include <unordered_map>
 
 namespace CesiumGltfWriter {
+template <typename TJsonWriter>
 void writeExtensions(
     const std::unordered_map<std::string, std::any>& extensions,
-    CesiumJsonWriter::JsonWriter& jsonWriter);
+    TJsonWriter& jsonWriter);
 }
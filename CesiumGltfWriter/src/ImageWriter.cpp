@@ -7,6 +7,8 @@
 #include <CesiumGltf/Image.h>
 #include <CesiumGltfWriter/WriteGLTFCallback.h>
 #include <CesiumJsonWriter/JsonObjectWriter.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
 
 #include <algorithm>
 #include <cstdint>
@@ -27,10 +29,11 @@ mimeTypeToExtensionString(const std::string& mimeType) noexcept {
   return "";
 }
 
+template <typename TJsonWriter>
 void CesiumGltfWriter::writeImage(
     WriteModelResult& result,
     const std::vector<CesiumGltf::Image>& images,
-    CesiumJsonWriter::JsonWriter& jsonWriter,
+    TJsonWriter& jsonWriter,
     const WriteModelOptions& options,
     WriteGLTFCallback writeGLTFCallback) {
   if (images.empty()) {
@@ -122,3 +125,31 @@ void CesiumGltfWriter::writeImage(
 
   j.EndArray();
 }
+
+template void CesiumGltfWriter::writeImage(
+    WriteModelResult& result,
+    const std::vector<CesiumGltf::Image>& images,
+    CesiumJsonWriter::JsonWriter& jsonWriter,
+    const WriteModelOptions& options,
+    WriteGLTFCallback writeGLTFCallback);
+
+template void CesiumGltfWriter::writeImage(
+    WriteModelResult& result,
+    const std::vector<CesiumGltf::Image>& images,
+    CesiumJsonWriter::PrettyJsonWriter& jsonWriter,
+    const WriteModelOptions& options,
+    WriteGLTFCallback writeGLTFCallback);
+
+template void CesiumGltfWriter::writeImage(
+    WriteModelResult& result,
+    const std::vector<CesiumGltf::Image>& images,
+    CesiumJsonWriter::CompactStaticJsonWriter& jsonWriter,
+    const WriteModelOptions& options,
+    WriteGLTFCallback writeGLTFCallback);
+
+template void CesiumGltfWriter::writeImage(
+    WriteModelResult& result,
+    const std::vector<CesiumGltf::Image>& images,
+    CesiumJsonWriter::PrettyStaticJsonWriter& jsonWriter,
+    const WriteModelOptions& options,
+    WriteGLTFCallback writeGLTFCallback);
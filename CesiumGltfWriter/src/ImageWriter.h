@@ -4,15 +4,16 @@
 #include <CesiumGltfWriter/WriteGLTFCallback.h>
 #include <CesiumGltfWriter/WriteModelOptions.h>
 #include <CesiumGltfWriter/WriteModelResult.h>
-#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
 #include <vector>
 
 namespace CesiumGltfWriter {
+template <typename TJsonWriter>
 void writeImage(
     WriteModelResult& result,
     const std::vector<CesiumGltf::Image>& images,
-    CesiumJsonWriter::JsonWriter& jsonWriter,
+    TJsonWriter& jsonWriter,
     const WriteModelOptions& flags,
     WriteGLTFCallback writeGLTFCallback = noopGltfWriter);
 }
@@ -8,13 +8,16 @@
 #include <CesiumGltf/MaterialPBRMetallicRoughness.h>
 #include <CesiumGltf/Texture.h>
 #include <CesiumJsonWriter/JsonObjectWriter.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
 
 #include <cassert>
 #include <vector>
 
+template <typename TJsonWriter>
 void writePbrMetallicRoughness(
     const CesiumGltf::MaterialPBRMetallicRoughness& pbr,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   auto& j = jsonWriter;
   j.Key("pbrMetallicRoughness");
   j.StartObject();
@@ -65,9 +68,10 @@ void writePbrMetallicRoughness(
   j.EndObject();
 }
 
+template <typename TJsonWriter>
 void writeNormalTexture(
     const CesiumGltf::MaterialNormalTextureInfo& normalTexture,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   auto& j = jsonWriter;
   j.Key("normalTexture");
   j.StartObject();
@@ -95,9 +99,10 @@ void writeNormalTexture(
   j.EndObject();
 }
 
+template <typename TJsonWriter>
 void writeOcclusionTexture(
     const CesiumGltf::MaterialOcclusionTextureInfo& occlusionTexture,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   auto& j = jsonWriter;
   j.Key("occlusionTexture");
   j.StartObject();
@@ -127,9 +132,10 @@ void writeOcclusionTexture(
   j.EndObject();
 }
 
+template <typename TJsonWriter>
 void writeEmissiveTexture(
     const CesiumGltf::TextureInfo& emissiveTexture,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   auto& j = jsonWriter;
   j.Key("emissiveTexture");
   j.StartObject();
@@ -151,9 +157,10 @@ void writeEmissiveTexture(
   j.EndObject();
 }
 
+template <typename TJsonWriter>
 void CesiumGltfWriter::writeMaterial(
     const std::vector<CesiumGltf::Material>& materials,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   if (materials.empty()) {
     return;
   }
@@ -221,3 +228,19 @@ void CesiumGltfWriter::writeMaterial(
   }
   j.EndArray();
 }
+
+template void CesiumGltfWriter::writeMaterial(
+    const std::vector<CesiumGltf::Material>& materials,
+    CesiumJsonWriter::JsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeMaterial(
+    const std::vector<CesiumGltf::Material>& materials,
+    CesiumJsonWriter::PrettyJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeMaterial(
+    const std::vector<CesiumGltf::Material>& materials,
+    CesiumJsonWriter::CompactStaticJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeMaterial(
+    const std::vector<CesiumGltf::Material>& materials,
+    CesiumJsonWriter::PrettyStaticJsonWriter& jsonWriter);
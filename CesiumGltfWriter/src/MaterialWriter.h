@@ -1,12 +1,13 @@
 #pragma once
 
 #include <CesiumGltf/Material.h>
-#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
 #include <vector>
 
 namespace CesiumGltfWriter {
+template <typename TJsonWriter>
 void writeMaterial(
     const std::vector<CesiumGltf::Material>& materials,
-    CesiumJsonWriter::JsonWriter& jsonWriter);
+    TJsonWriter& jsonWriter);
 }
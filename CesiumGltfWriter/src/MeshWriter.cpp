@@ -6,12 +6,16 @@
 #include <CesiumGltf/MeshPrimitive.h>
 #include <CesiumJsonWriter/JsonObjectWriter.h>
 #include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
+#include <cassert>
 #include <vector>
 
+template <typename TJsonWriter>
 void writePrimitive(
     const CesiumGltf::MeshPrimitive& primitive,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   auto& j = jsonWriter;
   j.StartObject();
 
@@ -53,7 +57,6 @@ void writePrimitive(
   }
 
   if (!primitive.extensions.empty()) {
-    j.Key("extensions");
     CesiumGltfWriter::writeExtensions(primitive.extensions, j);
   }
 
@@ -64,9 +67,10 @@ void writePrimitive(
   j.EndObject();
 }
 
+template <typename TJsonWriter>
 void CesiumGltfWriter::writeMesh(
     const std::vector<CesiumGltf::Mesh>& meshes,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
 
   if (meshes.empty()) {
     return;
@@ -114,3 +118,19 @@ void CesiumGltfWriter::writeMesh(
 
   j.EndArray();
 }
+
+template void CesiumGltfWriter::writeMesh(
+    const std::vector<CesiumGltf::Mesh>& meshes,
+    CesiumJsonWriter::JsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeMesh(
+    const std::vector<CesiumGltf::Mesh>& meshes,
+    CesiumJsonWriter::PrettyJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeMesh(
+    const std::vector<CesiumGltf::Mesh>& meshes,
+    CesiumJsonWriter::CompactStaticJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeMesh(
+    const std::vector<CesiumGltf::Mesh>& meshes,
+    CesiumJsonWriter::PrettyStaticJsonWriter& jsonWriter);
@@ -1,12 +1,13 @@
 #pragma once
 
 #include <CesiumGltf/Mesh.h>
-#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
 #include <vector>
 
 namespace CesiumGltfWriter {
+template <typename TJsonWriter>
 void writeMesh(
     const std::vector<CesiumGltf::Mesh>& meshes,
-    CesiumJsonWriter::JsonWriter& jsonWriter);
+    TJsonWriter& jsonWriter);
 }
@@ -5,7 +5,10 @@
 #include <CesiumGltf/Image.h>
 #include <CesiumJsonWriter/JsonObjectWriter.h>
 #include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
+#include <cassert>
 #include <vector>
 
 const std::vector<double>
@@ -14,9 +17,10 @@ const std::vector<double> DEFAULT_ROTATION{0, 0, 0, 1};
 const std::vector<double> DEFAULT_SCALE{1, 1, 1};
 const std::vector<double> DEFAULT_TRANSLATION{0, 0, 0};
 
+template <typename TJsonWriter>
 void CesiumGltfWriter::writeNode(
     const std::vector<CesiumGltf::Node>& nodes,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   if (nodes.empty()) {
     return;
   }
@@ -117,3 +121,19 @@ void CesiumGltfWriter::writeNode(
   }
   j.EndArray();
 }
+
+template void CesiumGltfWriter::writeNode(
+    const std::vector<CesiumGltf::Node>& nodes,
+    CesiumJsonWriter::JsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeNode(
+    const std::vector<CesiumGltf::Node>& nodes,
+    CesiumJsonWriter::PrettyJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeNode(
+    const std::vector<CesiumGltf::Node>& nodes,
+    CesiumJsonWriter::CompactStaticJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeNode(
+    const std::vector<CesiumGltf::Node>& nodes,
+    CesiumJsonWriter::PrettyStaticJsonWriter& jsonWriter);
@@ -3,10 +3,13 @@
 #include "ExtensionWriter.h"
 
 #include <CesiumJsonWriter/JsonObjectWriter.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
 
+template <typename TJsonWriter>
 void CesiumGltfWriter::writeSampler(
     const std::vector<CesiumGltf::Sampler>& samplers,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   if (samplers.empty()) {
     return;
   }
@@ -55,3 +58,19 @@ void CesiumGltfWriter::writeSampler(
   }
   j.EndArray();
 }
+
+template void CesiumGltfWriter::writeSampler(
+    const std::vector<CesiumGltf::Sampler>& samplers,
+    CesiumJsonWriter::JsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeSampler(
+    const std::vector<CesiumGltf::Sampler>& samplers,
+    CesiumJsonWriter::PrettyJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeSampler(
+    const std::vector<CesiumGltf::Sampler>& samplers,
+    CesiumJsonWriter::CompactStaticJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeSampler(
+    const std::vector<CesiumGltf::Sampler>& samplers,
+    CesiumJsonWriter::PrettyStaticJsonWriter& jsonWriter);
@@ -1,12 +1,13 @@
 #pragma once
 
 #include <CesiumGltf/Sampler.h>
-#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
 #include <vector>
 
 namespace CesiumGltfWriter {
+template <typename TJsonWriter>
 void writeSampler(
     const std::vector<CesiumGltf::Sampler>& samplers,
-    CesiumJsonWriter::JsonWriter& jsonWriter);
+    TJsonWriter& jsonWriter);
 }
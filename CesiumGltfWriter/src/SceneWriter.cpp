@@ -3,10 +3,13 @@
 #include "ExtensionWriter.h"
 
 #include <CesiumJsonWriter/JsonObjectWriter.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
 
+template <typename TJsonWriter>
 void CesiumGltfWriter::writeScene(
     const std::vector<CesiumGltf::Scene>& scenes,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
 
   if (scenes.empty()) {
     return;
@@ -46,3 +49,19 @@ void CesiumGltfWriter::writeScene(
 
   j.EndArray();
 }
+
+template void CesiumGltfWriter::writeScene(
+    const std::vector<CesiumGltf::Scene>& scenes,
+    CesiumJsonWriter::JsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeScene(
+    const std::vector<CesiumGltf::Scene>& scenes,
+    CesiumJsonWriter::PrettyJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeScene(
+    const std::vector<CesiumGltf::Scene>& scenes,
+    CesiumJsonWriter::CompactStaticJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeScene(
+    const std::vector<CesiumGltf::Scene>& scenes,
+    CesiumJsonWriter::PrettyStaticJsonWriter& jsonWriter);
@@ -1,12 +1,13 @@
 #pragma once
 
 #include <CesiumGltf/Scene.h>
-#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
 #include <vector>
 
 namespace CesiumGltfWriter {
+template <typename TJsonWriter>
 void writeScene(
     const std::vector<CesiumGltf::Scene>& scenes,
-    CesiumJsonWriter::JsonWriter& jsonWriter);
+    TJsonWriter& jsonWriter);
 }
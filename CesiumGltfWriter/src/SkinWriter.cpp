@@ -3,10 +3,15 @@
 #include "ExtensionWriter.h"
 
 #include <CesiumJsonWriter/JsonObjectWriter.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
 
+#include <cassert>
+
+template <typename TJsonWriter>
 void CesiumGltfWriter::writeSkin(
     const std::vector<CesiumGltf::Skin>& skins,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
 
   if (skins.empty()) {
     return;
@@ -55,3 +60,19 @@ void CesiumGltfWriter::writeSkin(
 
   j.EndArray();
 }
+
+template void CesiumGltfWriter::writeSkin(
+    const std::vector<CesiumGltf::Skin>& skins,
+    CesiumJsonWriter::JsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeSkin(
+    const std::vector<CesiumGltf::Skin>& skins,
+    CesiumJsonWriter::PrettyJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeSkin(
+    const std::vector<CesiumGltf::Skin>& skins,
+    CesiumJsonWriter::CompactStaticJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeSkin(
+    const std::vector<CesiumGltf::Skin>& skins,
+    CesiumJsonWriter::PrettyStaticJsonWriter& jsonWriter);
@@ -1,12 +1,13 @@
 #pragma once
 
 #include <CesiumGltf/Skin.h>
-#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
 #include <vector>
 
 namespace CesiumGltfWriter {
+template <typename TJsonWriter>
 void writeSkin(
     const std::vector<CesiumGltf::Skin>& skins,
-    CesiumJsonWriter::JsonWriter& jsonWriter);
+    TJsonWriter& jsonWriter);
 }
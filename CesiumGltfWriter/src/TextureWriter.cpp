@@ -3,10 +3,13 @@
 #include "ExtensionWriter.h"
 
 #include <CesiumJsonWriter/JsonObjectWriter.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
 
+template <typename TJsonWriter>
 void CesiumGltfWriter::writeTexture(
     const std::vector<CesiumGltf::Texture>& textures,
-    CesiumJsonWriter::JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
   if (textures.empty()) {
     return;
   }
@@ -46,3 +49,19 @@ void CesiumGltfWriter::writeTexture(
   }
   j.EndArray();
 }
+
+template void CesiumGltfWriter::writeTexture(
+    const std::vector<CesiumGltf::Texture>& textures,
+    CesiumJsonWriter::JsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeTexture(
+    const std::vector<CesiumGltf::Texture>& textures,
+    CesiumJsonWriter::PrettyJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeTexture(
+    const std::vector<CesiumGltf::Texture>& textures,
+    CesiumJsonWriter::CompactStaticJsonWriter& jsonWriter);
+
+template void CesiumGltfWriter::writeTexture(
+    const std::vector<CesiumGltf::Texture>& textures,
+    CesiumJsonWriter::PrettyStaticJsonWriter& jsonWriter);
@@ -1,12 +1,13 @@
 #pragma once
 
 #include <CesiumGltf/Texture.h>
-#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 
 #include <vector>
 
 namespace CesiumGltfWriter {
+template <typename TJsonWriter>
 void writeTexture(
     const std::vector<CesiumGltf::Texture>& textures,
-    CesiumJsonWriter::JsonWriter& jsonWriter);
+    TJsonWriter& jsonWriter);
 }
@@ -1,98 +1,130 @@
 #include "WriteBinaryGLB.h"
 
-#include <algorithm>
+#include <array>
+#include <limits>
 
 const std::size_t BYTE_HEADER_SIZE = 12;
 const std::size_t CHUNK_HEADER_MINIMUM_SIZE = 8;
 const std::uint32_t GLB_CONTAINER_VERSION = 2;
-const std::byte PADDING_CHAR = std::byte(0x20);
+const std::byte JSON_PADDING_CHAR = std::byte(0x20);
+const std::byte BINARY_PADDING_CHAR = std::byte(0x00);
 
 [[nodiscard]] inline std::size_t nextMultipleOfFour(std::size_t n) noexcept {
-  return (n + 3) & ~0x03ul;
+  return (n + 3) & ~std::size_t(3);
 }
 
-void writeGLTFHeader(std::vector<std::byte>& glbBuffer) noexcept {
-  glbBuffer[0] = std::byte('g');
-  glbBuffer[1] = std::byte('l');
-  glbBuffer[2] = std::byte('T');
-  glbBuffer[3] = std::byte('F');
-
-  glbBuffer[4] = std::byte(GLB_CONTAINER_VERSION & 0xff);
-  glbBuffer[5] = std::byte((GLB_CONTAINER_VERSION >> 8) & 0xff);
-  glbBuffer[6] = std::byte((GLB_CONTAINER_VERSION >> 16) & 0xff);
-  glbBuffer[7] = std::byte((GLB_CONTAINER_VERSION >> 24) & 0xff);
+void writeUint32(std::byte* pOutput, std::size_t value) noexcept {
+  pOutput[0] = std::byte(value & 0xff);
+  pOutput[1] = std::byte((value >> 8) & 0xff);
+  pOutput[2] = std::byte((value >> 16) & 0xff);
+  pOutput[3] = std::byte((value >> 24) & 0xff);
 }
 
-void writeGLBSize(std::vector<std::byte>& glbBuffer) noexcept {
-  const auto totalGLBLength = glbBuffer.size();
-  glbBuffer[8] = std::byte(totalGLBLength & 0xff);
-  glbBuffer[9] = std::byte((totalGLBLength >> 8) & 0xff);
-  glbBuffer[10] = std::byte((totalGLBLength >> 16) & 0xff);
-  glbBuffer[11] = std::byte((totalGLBLength >> 24) & 0xff);
-}
+bool writeGLBChunk(
+    const CesiumGltfWriter::WriteStreamCallback& stream,
+    GLBChunkType chunkType,
+    const gsl::span<const std::byte>& data,
+    std::size_t chunkLength,
+    std::byte paddingChar) {
+  std::array<std::byte, CHUNK_HEADER_MINIMUM_SIZE> chunkHeader;
+  writeUint32(chunkHeader.data(), chunkLength);
+  writeUint32(chunkHeader.data() + 4, chunkType);
+  if (!stream(chunkHeader)) {
+    return false;
+  }
 
-void writeGLBJsonChunk(
-    std::vector<std::byte>& glbBuffer,
-    const std::string_view& gltfJson) {
-  const auto jsonLength = gltfJson.size();
-  const auto paddingLength = nextMultipleOfFour(jsonLength) - jsonLength;
-  const auto chunkLength = jsonLength + paddingLength;
-
-  glbBuffer[12] = std::byte(chunkLength & 0xff);
-  glbBuffer[13] = std::byte((chunkLength >> 8) & 0xff);
-  glbBuffer[14] = std::byte((chunkLength >> 16) & 0xff);
-  glbBuffer[15] = std::byte((chunkLength >> 24) & 0xff);
-
-  glbBuffer[16] = std::byte(GLBChunkType::JSON & 0xff);
-  glbBuffer[17] = std::byte((GLBChunkType::JSON >> 8) & 0xff);
-  glbBuffer[18] = std::byte((GLBChunkType::JSON >> 16) & 0xff);
-  glbBuffer[19] = std::byte((GLBChunkType::JSON >> 24) & 0xff);
-
-  for (const auto c : gltfJson) {
-    glbBuffer.emplace_back(std::byte(c));
+  if (!data.empty() && !stream(data)) {
+    return false;
   }
 
-  glbBuffer.insert(glbBuffer.end(), paddingLength, PADDING_CHAR);
+  const std::size_t paddingLength = chunkLength - data.size();
+  if (paddingLength == 0) {
+    return true;
+  }
+
+  std::array<std::byte, 3> padding;
+  padding.fill(paddingChar);
+  return stream(gsl::span<const std::byte>(padding.data(), paddingLength));
 }
 
-void writeGLBBinaryChunk(
-    std::vector<std::byte>& glbBuffer,
-    const std::vector<std::byte>& binaryChunk,
-    std::size_t byteOffset) {
+bool CesiumGltfWriter::GlbLayout::fitsInGlb() const noexcept {
+  return this->totalLength <= std::numeric_limits<std::uint32_t>::max();
+}
+
+CesiumGltfWriter::GlbLayout CesiumGltfWriter::computeGlbLayout(
+    std::size_t jsonLength,
+    std::size_t binaryLength) noexcept {
+  GlbLayout layout;
+  layout.jsonOffset = BYTE_HEADER_SIZE + CHUNK_HEADER_MINIMUM_SIZE;
+  layout.jsonLength = jsonLength;
+  layout.jsonChunkLength = nextMultipleOfFour(jsonLength);
+  layout.totalLength = layout.jsonOffset + layout.jsonChunkLength;
+
+  if (binaryLength > 0) {
+    layout.binaryOffset = layout.totalLength + CHUNK_HEADER_MINIMUM_SIZE;
+    layout.binaryLength = binaryLength;
+    layout.binaryChunkLength = nextMultipleOfFour(binaryLength);
+    layout.totalLength = layout.binaryOffset + layout.binaryChunkLength;
+  }
 
-  const auto bufferLength = binaryChunk.size();
-  const auto paddingLength = nextMultipleOfFour(bufferLength) - bufferLength;
-  const auto chunkLength = bufferLength + paddingLength;
+  return layout;
+}
 
-  glbBuffer.resize(glbBuffer.size() + CHUNK_HEADER_MINIMUM_SIZE);
+bool CesiumGltfWriter::writeBinaryGLB(
+    const GlbLayout& layout,
+    const gsl::span<const std::byte>& binaryChunk,
+    const std::string_view& gltfJson,
+    const WriteStreamCallback& stream) {
+  std::array<std::byte, BYTE_HEADER_SIZE> header;
+  header[0] = std::byte('g');
+  header[1] = std::byte('l');
+  header[2] = std::byte('T');
+  header[3] = std::byte('F');
+  writeUint32(header.data() + 4, GLB_CONTAINER_VERSION);
+  writeUint32(header.data() + 8, layout.totalLength);
+  if (!stream(header)) {
+    return false;
+  }
 
-  glbBuffer[byteOffset + 0] = std::byte(chunkLength & 0xff);
-  glbBuffer[byteOffset + 1] = std::byte((chunkLength >> 8) & 0xff);
-  glbBuffer[byteOffset + 2] = std::byte((chunkLength >> 16) & 0xff);
-  glbBuffer[byteOffset + 3] = std::byte((chunkLength >> 24) & 0xff);
+  const gsl::span<const std::byte> jsonChunk(
+      reinterpret_cast<const std::byte*>(gltfJson.data()),
+      gltfJson.size());
+  if (!writeGLBChunk(
+          stream,
+          GLBChunkType::JSON,
+          jsonChunk,
+          layout.jsonChunkLength,
+          JSON_PADDING_CHAR)) {
+    return false;
+  }
 
-  glbBuffer[byteOffset + 4] = std::byte(GLBChunkType::BIN & 0xff);
-  glbBuffer[byteOffset + 5] = std::byte((GLBChunkType::BIN >> 8) & 0xff);
-  glbBuffer[byteOffset + 6] = std::byte((GLBChunkType::BIN >> 16) & 0xff);
-  glbBuffer[byteOffset + 7] = std::byte((GLBChunkType::BIN >> 24) & 0xff);
+  if (layout.binaryChunkLength == 0) {
+    return true;
+  }
 
-  glbBuffer.insert(glbBuffer.end(), binaryChunk.begin(), binaryChunk.end());
-  glbBuffer.insert(glbBuffer.end(), paddingLength, PADDING_CHAR);
+  return writeGLBChunk(
+      stream,
+      GLBChunkType::BIN,
+      binaryChunk,
+      layout.binaryChunkLength,
+      BINARY_PADDING_CHAR);
 }
 
 [[nodiscard]] std::vector<std::byte> CesiumGltfWriter::writeBinaryGLB(
     const std::vector<std::byte>& binaryChunk,
     const std::string_view& gltfJson) {
-
-  std::vector<std::byte> glbBuffer(
-      BYTE_HEADER_SIZE + CHUNK_HEADER_MINIMUM_SIZE);
-  writeGLTFHeader(glbBuffer);
-  writeGLBJsonChunk(glbBuffer, gltfJson);
-
-  if (!binaryChunk.empty()) {
-    writeGLBBinaryChunk(glbBuffer, binaryChunk, glbBuffer.size());
-  }
-
-  writeGLBSize(glbBuffer);
+  const GlbLayout layout =
+      computeGlbLayout(gltfJson.size(), binaryChunk.size());
+
+  std::vector<std::byte> glbBuffer;
+  glbBuffer.reserve(layout.totalLength);
+  writeBinaryGLB(
+      layout,
+      binaryChunk,
+      gltfJson,
+      [&glbBuffer](const gsl::span<const std::byte>& data) {
+        glbBuffer.insert(glbBuffer.end(), data.begin(), data.end());
+        return true;
+      });
   return glbBuffer;
 }
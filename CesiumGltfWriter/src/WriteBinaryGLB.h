@@ -1,6 +1,10 @@
 #pragma once
 
 #include <CesiumGltf/Model.h>
+#include <CesiumGltfWriter/GlbLayout.h>
+#include <CesiumGltfWriter/WriteStreamCallback.h>
+
+#include <gsl/span>
 
 #include <cstdint>
 #include <string_view>
@@ -12,4 +16,17 @@ namespace CesiumGltfWriter {
 std::vector<std::byte> writeBinaryGLB(
     const std::vector<std::byte>& binaryChunk,
     const std::string_view& gltfJson);
-}
+
+/**
+ * @brief Streams a GLB with the given layout: the header, the JSON chunk and
+ * the binary chunk, each straight from where its data is, followed by its
+ * padding.
+ *
+ * @returns false if the stream did not accept all of the data.
+ */
+bool writeBinaryGLB(
+    const GlbLayout& layout,
+    const gsl::span<const std::byte>& binaryChunk,
+    const std::string_view& gltfJson,
+    const WriteStreamCallback& stream);
+} // namespace CesiumGltfWriter
@@ -0,0 +1,54 @@
+#include "CesiumGltfWriter/WriteStreamCallback.h"
+
+#include <cerrno>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+// Writes at most this many bytes per call, which keeps the length within the
+// range that every platform's write function accepts.
+const std::size_t MAXIMUM_WRITE_SIZE = 1 << 30;
+
+long long writeToFileDescriptor(
+    int fileDescriptor,
+    const std::byte* pData,
+    std::size_t size) noexcept {
+#ifdef _WIN32
+  return ::_write(fileDescriptor, pData, static_cast<unsigned int>(size));
+#else
+  return ::write(fileDescriptor, pData, size);
+#endif
+}
+} // namespace
+
+CesiumGltfWriter::WriteStreamCallback
+CesiumGltfWriter::createFileDescriptorStream(int fileDescriptor) {
+  return [fileDescriptor](const gsl::span<const std::byte>& data) {
+    const std::byte* pData = data.data();
+    std::size_t remaining = data.size();
+    while (remaining > 0) {
+      const std::size_t size =
+          remaining < MAXIMUM_WRITE_SIZE ? remaining : MAXIMUM_WRITE_SIZE;
+      const long long written =
+          writeToFileDescriptor(fileDescriptor, pData, size);
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      if (written == 0) {
+        return false;
+      }
+
+      pData += written;
+      remaining -= static_cast<std::size_t>(written);
+    }
+
+    return true;
+  };
+}
@@ -19,16 +19,17 @@
 
 #include <CesiumGltfWriter/WriteGLTFCallback.h>
 #include <CesiumGltfWriter/WriteModelOptions.h>
+#include <CesiumGltfWriter/WriteStreamCallback.h>
 #include <CesiumGltfWriter/Writer.h>
 #include <CesiumJsonWriter/JsonObjectWriter.h>
-#include <CesiumJsonWriter/JsonWriter.h>
-#include <CesiumJsonWriter/PrettyJsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
 #include <CesiumUtility/JsonValue.h>
 
 #include <array>
 #include <cstdio>
 #include <optional>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 
 using namespace CesiumGltf;
@@ -41,6 +42,21 @@ CesiumGltfWriter::WriteModelResult writeModel(
     const CesiumGltfWriter::WriteGLTFCallback& writeGLTFCallback =
         CesiumGltfWriter::noopGltfWriter);
 
+void writeModelJson(
+    const Model& model,
+    const CesiumGltfWriter::WriteModelOptions& options,
+    CesiumGltfWriter::WriteModelResult& result,
+    const CesiumGltfWriter::WriteGLTFCallback& writeGLTFCallback,
+    std::vector<std::byte>& output);
+
+template <typename TJsonWriter>
+void writeModelJson(
+    const Model& model,
+    const CesiumGltfWriter::WriteModelOptions& options,
+    CesiumGltfWriter::WriteModelResult& result,
+    const CesiumGltfWriter::WriteGLTFCallback& writeGLTFCallback,
+    TJsonWriter& writer);
+
 CesiumGltfWriter::WriteModelResult CesiumGltfWriter::writeModelAsEmbeddedBytes(
     const Model& model,
     const WriteModelOptions& options) {
@@ -55,6 +71,52 @@ CesiumGltfWriter::WriteModelResult CesiumGltfWriter::writeModelAndExternalFiles(
   return writeModel(model, options, filename, writeGLTFCallback);
 }
 
+CesiumGltfWriter::WriteModelResult CesiumGltfWriter::writeModelToStream(
+    const Model& model,
+    const WriteModelOptions& options,
+    const WriteStreamCallback& stream,
+    const WriteGLTFCallback& writeGLTFCallback) {
+  WriteModelResult result;
+  std::vector<std::byte> json;
+  writeModelJson(model, options, result, writeGLTFCallback, json);
+  if (!result.errors.empty()) {
+    return result;
+  }
+
+  const std::string_view gltfJson(
+      reinterpret_cast<const char*>(json.data()),
+      json.size());
+  bool written;
+
+  if (options.exportType == GltfExportType::GLB) {
+    gsl::span<const std::byte> binaryChunk;
+    if (!model.buffers.empty()) {
+      binaryChunk = model.buffers.front().cesium.data;
+    }
+
+    const GlbLayout layout =
+        computeGlbLayout(gltfJson.size(), binaryChunk.size());
+    if (!layout.fitsInGlb()) {
+      result.errors.emplace_back(
+          "GlbTooLarge: The GLB would be " +
+          std::to_string(layout.totalLength) +
+          " bytes long, but it cannot be longer than 4GB.");
+      return result;
+    }
+
+    written = writeBinaryGLB(layout, binaryChunk, gltfJson, stream);
+  } else {
+    written = stream(json);
+  }
+
+  if (!written) {
+    result.errors.emplace_back(
+        "StreamWriteFailed: The stream did not accept all of the glTF.");
+  }
+
+  return result;
+}
+
 CesiumGltfWriter::WriteModelResult writeModel(
     const Model& model,
     const CesiumGltfWriter::WriteModelOptions& options,
@@ -62,80 +124,108 @@ CesiumGltfWriter::WriteModelResult writeModel(
     const CesiumGltfWriter::WriteGLTFCallback& writeGLTFCallback) {
 
   CesiumGltfWriter::WriteModelResult result;
-  std::unique_ptr<CesiumJsonWriter::JsonWriter> writer;
 
+  if (options.exportType == CesiumGltfWriter::GltfExportType::GLB) {
+    std::vector<std::byte> json;
+    writeModelJson(model, options, result, writeGLTFCallback, json);
+    const std::string_view gltfJson(
+        reinterpret_cast<const char*>(json.data()),
+        json.size());
+
+    if (model.buffers.empty()) {
+      result.gltfAssetBytes = CesiumGltfWriter::writeBinaryGLB(
+          std::vector<std::byte>{},
+          gltfJson);
+    }
+
+    else {
+      result.gltfAssetBytes = CesiumGltfWriter::writeBinaryGLB(
+          model.buffers.at(0).cesium.data,
+          gltfJson);
+    }
+  } else {
+    writeModelJson(
+        model,
+        options,
+        result,
+        writeGLTFCallback,
+        result.gltfAssetBytes);
+  }
+
+  writeGLTFCallback(filename, result.gltfAssetBytes);
+  return result;
+}
+
+void writeModelJson(
+    const Model& model,
+    const CesiumGltfWriter::WriteModelOptions& options,
+    CesiumGltfWriter::WriteModelResult& result,
+    const CesiumGltfWriter::WriteGLTFCallback& writeGLTFCallback,
+    std::vector<std::byte>& output) {
   if (options.prettyPrint) {
-    writer = std::make_unique<CesiumJsonWriter::PrettyJsonWriter>();
+    CesiumJsonWriter::PrettyStaticJsonWriter writer(output);
+    writeModelJson(model, options, result, writeGLTFCallback, writer);
   } else {
-    writer = std::make_unique<CesiumJsonWriter::JsonWriter>();
+    CesiumJsonWriter::CompactStaticJsonWriter writer(output);
+    writeModelJson(model, options, result, writeGLTFCallback, writer);
   }
+}
 
-  writer->StartObject();
+template <typename TJsonWriter>
+void writeModelJson(
+    const Model& model,
+    const CesiumGltfWriter::WriteModelOptions& options,
+    CesiumGltfWriter::WriteModelResult& result,
+    const CesiumGltfWriter::WriteGLTFCallback& writeGLTFCallback,
+    TJsonWriter& writer) {
+  writer.StartObject();
 
   if (!model.extensionsUsed.empty()) {
-    writer->KeyArray("extensionsUsed", [&]() {
+    writer.KeyArray("extensionsUsed", [&]() {
       for (const auto& extensionUsed : model.extensionsUsed) {
-        writer->String(extensionUsed);
+        writer.String(extensionUsed);
       }
     });
   }
 
   if (!model.extensionsRequired.empty()) {
-    writer->KeyArray("extensionsRequired", [&]() {
+    writer.KeyArray("extensionsRequired", [&]() {
       for (const auto& extensionRequired : model.extensionsRequired) {
-        writer->String(extensionRequired);
+        writer.String(extensionRequired);
       }
     });
   }
 
-  CesiumGltfWriter::writeAccessor(model.accessors, *writer);
-  CesiumGltfWriter::writeAnimation(result, model.animations, *writer);
-  CesiumGltfWriter::writeAsset(model.asset, *writer);
+  CesiumGltfWriter::writeAccessor(model.accessors, writer);
+  CesiumGltfWriter::writeAnimation(result, model.animations, writer);
+  CesiumGltfWriter::writeAsset(model.asset, writer);
   CesiumGltfWriter::writeBuffer(
       result,
       model.buffers,
-      *writer,
+      writer,
       options,
       writeGLTFCallback);
-  CesiumGltfWriter::writeBufferView(model.bufferViews, *writer);
-  CesiumGltfWriter::writeCamera(model.cameras, *writer);
+  CesiumGltfWriter::writeBufferView(model.bufferViews, writer);
+  CesiumGltfWriter::writeCamera(model.cameras, writer);
   CesiumGltfWriter::writeImage(
       result,
       model.images,
-      *writer,
+      writer,
       options,
       writeGLTFCallback);
-  CesiumGltfWriter::writeMaterial(model.materials, *writer);
-  CesiumGltfWriter::writeMesh(model.meshes, *writer);
-  CesiumGltfWriter::writeNode(model.nodes, *writer);
-  CesiumGltfWriter::writeSampler(model.samplers, *writer);
-  CesiumGltfWriter::writeScene(model.scenes, *writer);
-  CesiumGltfWriter::writeSkin(model.skins, *writer);
-  CesiumGltfWriter::writeTexture(model.textures, *writer);
-  CesiumGltfWriter::writeExtensions(model.extensions, *writer);
+  CesiumGltfWriter::writeMaterial(model.materials, writer);
+  CesiumGltfWriter::writeMesh(model.meshes, writer);
+  CesiumGltfWriter::writeNode(model.nodes, writer);
+  CesiumGltfWriter::writeSampler(model.samplers, writer);
+  CesiumGltfWriter::writeScene(model.scenes, writer);
+  CesiumGltfWriter::writeSkin(model.skins, writer);
+  CesiumGltfWriter::writeTexture(model.textures, writer);
+  CesiumGltfWriter::writeExtensions(model.extensions, writer);
 
   if (!model.extras.empty()) {
-    CesiumJsonWriter::writeJsonValue(model.extras, *writer);
+    writer.Key("extras");
+    CesiumJsonWriter::writeJsonValue(model.extras, writer);
   }
 
-  writer->EndObject();
-
-  if (options.exportType == CesiumGltfWriter::GltfExportType::GLB) {
-    if (model.buffers.empty()) {
-      result.gltfAssetBytes = CesiumGltfWriter::writeBinaryGLB(
-          std::vector<std::byte>{},
-          writer->toStringView());
-    }
-
-    else {
-      result.gltfAssetBytes = CesiumGltfWriter::writeBinaryGLB(
-          model.buffers.at(0).cesium.data,
-          writer->toStringView());
-    }
-  } else {
-    result.gltfAssetBytes = writer->toBytes();
-  }
-
-  writeGLTFCallback(filename, result.gltfAssetBytes);
-  return result;
+  writer.EndObject();
 }
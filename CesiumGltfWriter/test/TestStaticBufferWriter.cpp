@@ -0,0 +1,118 @@
+#include "BufferWriter.h"
+#include "CesiumGltfWriter/WriteModelOptions.h"
+#include "CesiumGltfWriter/WriteModelResult.h"
+
+#include <CesiumGltf/Buffer.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
+#include <CesiumUtility/JsonValue.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<CesiumGltf::Buffer> createBuffers() {
+  CesiumGltf::Buffer embedded;
+  embedded.cesium.data = {std::byte('H'), std::byte('i'), std::byte('!')};
+
+  CesiumGltf::Buffer dataUri;
+  dataUri.uri = "data:application/octet-stream;base64,SGkh";
+  dataUri.byteLength = 3;
+  dataUri.name = "DataUri";
+  dataUri.extras = CesiumUtility::JsonValue::Object{
+      {"some", CesiumUtility::JsonValue("extra")}};
+  dataUri.extensions.emplace("key", CesiumUtility::JsonValue("value"));
+
+  return {embedded, dataUri};
+}
+
+CesiumGltfWriter::WriteModelOptions createOptions() {
+  CesiumGltfWriter::WriteModelOptions options;
+  options.exportType = CesiumGltfWriter::GltfExportType::GLTF;
+  options.autoConvertDataToBase64 = true;
+  return options;
+}
+
+template <typename TJsonWriter>
+CesiumGltfWriter::WriteModelResult writeBuffers(TJsonWriter& writer) {
+  CesiumGltfWriter::WriteModelResult result;
+  writer.StartObject();
+  CesiumGltfWriter::writeBuffer(
+      result,
+      createBuffers(),
+      writer,
+      createOptions());
+  writer.EndObject();
+  return result;
+}
+
+} // namespace
+
+TEST_CASE(
+    "BufferWriter writes the same JSON with the static and virtual writers",
+    "[GltfWriter]") {
+  SECTION("compact") {
+    CesiumJsonWriter::JsonWriter writer;
+    REQUIRE(writeBuffers(writer).errors.empty());
+
+    std::vector<std::byte> json;
+    CesiumJsonWriter::CompactStaticJsonWriter staticWriter(json);
+    REQUIRE(writeBuffers(staticWriter).errors.empty());
+
+    CHECK(staticWriter.toString() == writer.toString());
+    CHECK(
+        writer.toString() ==
+        R"({"buffers":[)"
+        R"({"uri":"data:application/octet-stream;base64,SGkh","byteLength":3},)"
+        R"({"uri":"data:application/octet-stream;base64,SGkh","byteLength":3,)"
+        R"("name":"DataUri","extras":{"some":"extra"},)"
+        R"("extensions":{"key":"value"}}]})");
+  }
+
+  SECTION("pretty") {
+    CesiumJsonWriter::PrettyJsonWriter writer;
+    REQUIRE(writeBuffers(writer).errors.empty());
+
+    std::vector<std::byte> json;
+    CesiumJsonWriter::PrettyStaticJsonWriter staticWriter(json);
+    REQUIRE(writeBuffers(staticWriter).errors.empty());
+
+    CHECK(staticWriter.toString() == writer.toString());
+  }
+}
+
+TEST_CASE(
+    "Static writers append the glTF JSON to the caller's vector",
+    "[GltfWriter]") {
+  std::vector<std::byte> json;
+  CesiumJsonWriter::CompactStaticJsonWriter writer(json);
+
+  CesiumGltf::Buffer buffer;
+  buffer.cesium.data = {std::byte('H'), std::byte('i'), std::byte('!')};
+
+  CesiumGltfWriter::WriteModelOptions options;
+  options.exportType = CesiumGltfWriter::GltfExportType::GLB;
+
+  CesiumGltfWriter::WriteModelResult result;
+  writer.StartObject();
+  CesiumGltfWriter::writeBuffer(
+      result,
+      std::vector<CesiumGltf::Buffer>{buffer},
+      writer,
+      options);
+  writer.EndObject();
+
+  REQUIRE(result.errors.empty());
+  REQUIRE(result.warnings.empty());
+
+  const std::string expected = R"({"buffers":[{"byteLength":3}]})";
+  REQUIRE(json.size() == expected.size());
+  CHECK(
+      std::string(reinterpret_cast<const char*>(json.data()), json.size()) ==
+      expected);
+}
@@ -5,6 +5,9 @@
 #include <CesiumGltf/AccessorSparseIndices.h>
 #include <CesiumGltf/Buffer.h>
 #include <CesiumGltf/BufferView.h>
+#include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
+#include <CesiumGltf/ExtensionMeshPrimitiveExtFeatureMetadata.h>
+#include <CesiumGltf/ExtensionModelExtFeatureMetadata.h>
 #include <CesiumGltf/Mesh.h>
 #include <CesiumGltf/MeshPrimitive.h>
 #include <CesiumGltf/Node.h>
@@ -15,6 +18,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
 using namespace CesiumGltf;
@@ -274,3 +278,160 @@ TEST_CASE("Basic triangle is serialized to embedded glTF 2.0", "[GltfWriter]") {
   REQUIRE(writeResultGlb.warnings.empty());
   validateStructure(writeResultGlb.gltfAssetBytes);
 }
+
+TEST_CASE("Computes the layout of a glb", "[GltfWriter]") {
+  const CesiumGltfWriter::GlbLayout jsonOnly =
+      CesiumGltfWriter::computeGlbLayout(27, 0);
+  REQUIRE(jsonOnly.jsonOffset == 20);
+  REQUIRE(jsonOnly.jsonChunkLength == 28);
+  REQUIRE(jsonOnly.binaryChunkLength == 0);
+  REQUIRE(jsonOnly.totalLength == 48);
+  REQUIRE(jsonOnly.fitsInGlb());
+
+  const CesiumGltfWriter::GlbLayout withBinary =
+      CesiumGltfWriter::computeGlbLayout(28, 45);
+  REQUIRE(withBinary.binaryOffset == 56);
+  REQUIRE(withBinary.binaryLength == 45);
+  REQUIRE(withBinary.binaryChunkLength == 48);
+  REQUIRE(withBinary.totalLength == 104);
+
+  if constexpr (sizeof(size_t) > sizeof(std::uint32_t)) {
+    REQUIRE(!CesiumGltfWriter::computeGlbLayout(28, size_t(1) << 32)
+                 .fitsInGlb());
+  }
+}
+
+TEST_CASE(
+    "Streams the same glTF and glb as writeModelAsEmbeddedBytes",
+    "[GltfWriter]") {
+  const auto model = generateTriangleModel();
+
+  CesiumGltfWriter::WriteModelOptions options;
+  options.exportType = GENERATE(
+      CesiumGltfWriter::GltfExportType::GLB,
+      CesiumGltfWriter::GltfExportType::GLTF);
+  options.autoConvertDataToBase64 =
+      options.exportType == CesiumGltfWriter::GltfExportType::GLTF;
+
+  const auto expected =
+      CesiumGltfWriter::writeModelAsEmbeddedBytes(model, options);
+  REQUIRE(expected.errors.empty());
+
+  std::vector<std::byte> streamed;
+  bool binaryChunkWasCopied = true;
+  const auto writeResult = CesiumGltfWriter::writeModelToStream(
+      model,
+      options,
+      [&](const gsl::span<const std::byte>& data) {
+        if (data.data() == model.buffers[0].cesium.data.data()) {
+          binaryChunkWasCopied = false;
+        }
+        streamed.insert(streamed.end(), data.begin(), data.end());
+        return true;
+      });
+
+  REQUIRE(writeResult.errors.empty());
+  REQUIRE(writeResult.warnings.empty());
+  REQUIRE(writeResult.gltfAssetBytes.empty());
+  REQUIRE(streamed == expected.gltfAssetBytes);
+  if (options.exportType == CesiumGltfWriter::GltfExportType::GLB) {
+    REQUIRE(!binaryChunkWasCopied);
+  }
+}
+
+TEST_CASE("Reports an error when the stream fails", "[GltfWriter]") {
+  const auto model = generateTriangleModel();
+
+  CesiumGltfWriter::WriteModelOptions options;
+  options.exportType = CesiumGltfWriter::GltfExportType::GLB;
+
+  size_t calls = 0;
+  const auto writeResult = CesiumGltfWriter::writeModelToStream(
+      model,
+      options,
+      [&calls](const gsl::span<const std::byte>&) { return ++calls < 2; });
+
+  REQUIRE(calls == 2);
+  REQUIRE(writeResult.errors.size() == 1);
+  REQUIRE(writeResult.errors[0].rfind("StreamWriteFailed", 0) == 0);
+}
+
+TEST_CASE(
+    "Extensions created by the reader survive a round trip",
+    "[GltfWriter]") {
+  Model model = generateTriangleModel();
+  model.extras["gltfUpAxis"] = std::int64_t(1);
+
+  ExtensionKhrDracoMeshCompression& draco =
+      model.meshes[0]
+          .primitives[0]
+          .addExtension<ExtensionKhrDracoMeshCompression>();
+  draco.bufferView = 1;
+  draco.attributes["POSITION"] = 0;
+
+  ExtensionMeshPrimitiveExtFeatureMetadata& primitiveMetadata =
+      model.meshes[0]
+          .primitives[0]
+          .addExtension<ExtensionMeshPrimitiveExtFeatureMetadata>();
+  FeatureIDAttribute& featureIDs =
+      primitiveMetadata.featureIdAttributes.emplace_back();
+  featureIDs.featureTable = "features";
+  featureIDs.featureIds.constant = 0;
+  featureIDs.featureIds.divisor = 1;
+
+  ExtensionModelExtFeatureMetadata& modelMetadata =
+      model.addExtension<ExtensionModelExtFeatureMetadata>();
+  ClassProperty& classProperty =
+      modelMetadata.schema.emplace().classes["feature"].properties["height"];
+  classProperty.type = ClassProperty::Type::FLOAT32;
+  classProperty.max = 10.0;
+  FeatureTable& featureTable = modelMetadata.featureTables["features"];
+  featureTable.classProperty = "feature";
+  featureTable.count = 3;
+  featureTable.properties["height"].bufferView = 1;
+
+  CesiumGltfWriter::WriteModelOptions options;
+  options.exportType = CesiumGltfWriter::GltfExportType::GLB;
+  const auto writeResult =
+      CesiumGltfWriter::writeModelAsEmbeddedBytes(model, options);
+  REQUIRE(writeResult.errors.empty());
+
+  CesiumGltfReader::ReadModelOptions readOptions;
+  readOptions.decodeDraco = false;
+  CesiumGltfReader::GltfReader reader;
+  auto readResult = reader.readModel(writeResult.gltfAssetBytes, readOptions);
+  REQUIRE(readResult.errors.empty());
+  REQUIRE(readResult.model);
+
+  CHECK(
+      readResult.model->extras["gltfUpAxis"].getSafeNumberOrDefault<int64_t>(
+          0) == 1);
+
+  const MeshPrimitive& primitive = readResult.model->meshes[0].primitives[0];
+  const ExtensionKhrDracoMeshCompression* pDraco =
+      primitive.getExtension<ExtensionKhrDracoMeshCompression>();
+  REQUIRE(pDraco);
+  CHECK(pDraco->bufferView == 1);
+  CHECK(pDraco->attributes.at("POSITION") == 0);
+
+  const ExtensionMeshPrimitiveExtFeatureMetadata* pPrimitiveMetadata =
+      primitive.getExtension<ExtensionMeshPrimitiveExtFeatureMetadata>();
+  REQUIRE(pPrimitiveMetadata);
+  REQUIRE(pPrimitiveMetadata->featureIdAttributes.size() == 1);
+  CHECK(
+      pPrimitiveMetadata->featureIdAttributes[0].featureTable == "features");
+  CHECK(pPrimitiveMetadata->featureIdAttributes[0].featureIds.divisor == 1);
+
+  const ExtensionModelExtFeatureMetadata* pModelMetadata =
+      readResult.model->getExtension<ExtensionModelExtFeatureMetadata>();
+  REQUIRE(pModelMetadata);
+  REQUIRE(pModelMetadata->schema);
+  const ClassProperty& readProperty =
+      pModelMetadata->schema->classes.at("feature").properties.at("height");
+  CHECK(readProperty.type == ClassProperty::Type::FLOAT32);
+  CHECK(readProperty.max.getSafeNumberOrDefault<double>(0.0) == 10.0);
+  const FeatureTable& readTable = pModelMetadata->featureTables.at("features");
+  CHECK(readTable.classProperty == "feature");
+  CHECK(readTable.count == 3);
+  CHECK(readTable.properties.at("height").bufferView == 1);
+}
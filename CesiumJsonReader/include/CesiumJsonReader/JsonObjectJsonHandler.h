@@ -3,6 +3,7 @@
 #include "JsonHandler.h"
 #include "Library.h"
 
+#include <CesiumUtility/FlatJsonValue.h>
 #include <CesiumUtility/JsonValue.h>
 
 namespace CesiumJsonReader {
@@ -13,6 +14,16 @@ public:
 
   void reset(IJsonHandler* pParent, CesiumUtility::JsonValue* pValue);
 
+  /**
+   * @brief Resets the handler to read the next value into a
+   * {@link CesiumUtility::FlatJsonDocument} instead of a
+   * {@link CesiumUtility::JsonValue}.
+   *
+   * Any previous contents of the document are discarded.
+   */
+  void
+  reset(IJsonHandler* pParent, CesiumUtility::FlatJsonDocument* pDocument);
+
   virtual IJsonHandler* readNull() override;
   virtual IJsonHandler* readBool(bool b) override;
   virtual IJsonHandler* readInt32(int32_t i) override;
@@ -29,9 +40,13 @@ public:
 
 private:
   IJsonHandler* doneElement();
+  IJsonHandler* doneFlatElement();
 
   std::vector<CesiumUtility::JsonValue*> _stack;
   std::string_view _currentKey;
+
+  CesiumUtility::FlatJsonDocument* _pDocument = nullptr;
+  int32_t _depth = 0;
 };
 
 } // namespace CesiumJsonReader
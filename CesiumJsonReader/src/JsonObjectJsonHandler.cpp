@@ -24,49 +24,107 @@ void JsonObjectJsonHandler::reset(
   JsonHandler::reset(pParent);
   this->_stack.clear();
   this->_stack.push_back(pValue);
+  this->_pDocument = nullptr;
+  this->_depth = 0;
+}
+
+void JsonObjectJsonHandler::reset(
+    IJsonHandler* pParent,
+    CesiumUtility::FlatJsonDocument* pDocument) {
+  JsonHandler::reset(pParent);
+  this->_stack.clear();
+  this->_pDocument = pDocument;
+  this->_depth = 0;
+  *pDocument = CesiumUtility::FlatJsonDocument();
 }
 
 IJsonHandler* JsonObjectJsonHandler::readNull() {
+  if (this->_pDocument) {
+    this->_pDocument->addNull();
+    return this->doneFlatElement();
+  }
+
   addOrReplace(*this->_stack.back(), CesiumUtility::JsonValue::Null());
   return this->doneElement();
 }
 
 IJsonHandler* JsonObjectJsonHandler::readBool(bool b) {
+  if (this->_pDocument) {
+    this->_pDocument->addBool(b);
+    return this->doneFlatElement();
+  }
+
   addOrReplace(*this->_stack.back(), b);
   return this->doneElement();
 }
 
 IJsonHandler* JsonObjectJsonHandler::readInt32(int32_t i) {
+  if (this->_pDocument) {
+    this->_pDocument->addInt64(i);
+    return this->doneFlatElement();
+  }
+
   addOrReplace(*this->_stack.back(), std::int64_t(i));
   return this->doneElement();
 }
 
 IJsonHandler* JsonObjectJsonHandler::readUint32(uint32_t i) {
+  if (this->_pDocument) {
+    this->_pDocument->addUint64(i);
+    return this->doneFlatElement();
+  }
+
   addOrReplace(*this->_stack.back(), std::uint64_t(i));
   return this->doneElement();
 }
 
 IJsonHandler* JsonObjectJsonHandler::readInt64(int64_t i) {
+  if (this->_pDocument) {
+    this->_pDocument->addInt64(i);
+    return this->doneFlatElement();
+  }
+
   addOrReplace(*this->_stack.back(), i);
   return this->doneElement();
 }
 
 IJsonHandler* JsonObjectJsonHandler::readUint64(uint64_t i) {
+  if (this->_pDocument) {
+    this->_pDocument->addUint64(i);
+    return this->doneFlatElement();
+  }
+
   addOrReplace(*this->_stack.back(), i);
   return this->doneElement();
 }
 
 IJsonHandler* JsonObjectJsonHandler::readDouble(double d) {
+  if (this->_pDocument) {
+    this->_pDocument->addDouble(d);
+    return this->doneFlatElement();
+  }
+
   addOrReplace(*this->_stack.back(), d);
   return this->doneElement();
 }
 
 IJsonHandler* JsonObjectJsonHandler::readString(const std::string_view& str) {
-  *this->_stack.back() = std::string(str);
+  if (this->_pDocument) {
+    this->_pDocument->addString(str);
+    return this->doneFlatElement();
+  }
+
+  addOrReplace(*this->_stack.back(), std::string(str));
   return this->doneElement();
 }
 
 IJsonHandler* JsonObjectJsonHandler::readObjectStart() {
+  if (this->_pDocument) {
+    this->_pDocument->startObject();
+    ++this->_depth;
+    return this;
+  }
+
   CesiumUtility::JsonValue& current = *this->_stack.back();
   CesiumUtility::JsonValue::Array* pArray =
       std::get_if<CesiumUtility::JsonValue::Array>(&current.value);
@@ -83,6 +141,11 @@ IJsonHandler* JsonObjectJsonHandler::readObjectStart() {
 
 IJsonHandler*
 JsonObjectJsonHandler::readObjectKey(const std::string_view& str) {
+  if (this->_pDocument) {
+    this->_pDocument->addKey(str);
+    return this;
+  }
+
   CesiumUtility::JsonValue& json = *this->_stack.back();
   CesiumUtility::JsonValue::Object* pObject =
       std::get_if<CesiumUtility::JsonValue::Object>(&json.value);
@@ -94,10 +157,22 @@ JsonObjectJsonHandler::readObjectKey(const std::string_view& str) {
 }
 
 IJsonHandler* JsonObjectJsonHandler::readObjectEnd() {
+  if (this->_pDocument) {
+    this->_pDocument->endObject();
+    --this->_depth;
+    return this->doneFlatElement();
+  }
+
   return this->doneElement();
 }
 
 IJsonHandler* JsonObjectJsonHandler::readArrayStart() {
+  if (this->_pDocument) {
+    this->_pDocument->startArray();
+    ++this->_depth;
+    return this;
+  }
+
   CesiumUtility::JsonValue& current = *this->_stack.back();
   CesiumUtility::JsonValue::Array* pArray =
       std::get_if<CesiumUtility::JsonValue::Array>(&current.value);
@@ -113,6 +188,12 @@ IJsonHandler* JsonObjectJsonHandler::readArrayStart() {
 }
 
 IJsonHandler* JsonObjectJsonHandler::readArrayEnd() {
+  if (this->_pDocument) {
+    this->_pDocument->endArray();
+    --this->_depth;
+    return this->doneFlatElement();
+  }
+
   this->_stack.pop_back();
   return this->_stack.empty() ? this->parent() : this;
 }
@@ -127,4 +208,9 @@ IJsonHandler* JsonObjectJsonHandler::doneElement() {
   }
   return this;
 }
+
+IJsonHandler* JsonObjectJsonHandler::doneFlatElement() {
+  // A complete value at depth zero is the whole document.
+  return this->_depth == 0 ? this->parent() : this;
+}
 } // namespace CesiumJsonReader
@@ -0,0 +1,207 @@
+#include "CesiumJsonReader/IntegerJsonHandler.h"
+#include "CesiumJsonReader/JsonObjectJsonHandler.h"
+#include "CesiumJsonReader/JsonReader.h"
+#include "CesiumJsonReader/ObjectJsonHandler.h"
+
+#include <CesiumUtility/FlatJsonValue.h>
+#include <CesiumUtility/JsonValue.h>
+
+#include <catch2/catch.hpp>
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+using namespace CesiumJsonReader;
+using namespace CesiumUtility;
+
+namespace {
+// Reads the root of the JSON, into a JsonValue or a FlatJsonDocument.
+template <typename T> class RootJsonHandler : public JsonObjectJsonHandler {
+public:
+  using ValueType = T;
+};
+
+struct Record {
+  FlatJsonDocument flat;
+  JsonValue value;
+  int64_t count = 0;
+};
+
+class RecordJsonHandler : public ObjectJsonHandler {
+public:
+  using ValueType = Record;
+
+  void reset(IJsonHandler* pParent, Record* pRecord) {
+    ObjectJsonHandler::reset(pParent);
+    this->_pRecord = pRecord;
+  }
+
+  virtual IJsonHandler* readObjectKey(const std::string_view& str) override {
+    if (str == "flat") {
+      return this->property("flat", this->_flat, this->_pRecord->flat);
+    }
+    if (str == "value") {
+      return this->property("value", this->_value, this->_pRecord->value);
+    }
+    if (str == "count") {
+      return this->property("count", this->_count, this->_pRecord->count);
+    }
+    return this->ignoreAndContinue();
+  }
+
+private:
+  Record* _pRecord = nullptr;
+  JsonObjectJsonHandler _flat;
+  JsonObjectJsonHandler _value;
+  IntegerJsonHandler<int64_t> _count;
+};
+
+gsl::span<const std::byte> asBytes(const std::string& json) {
+  return gsl::span<const std::byte>(
+      reinterpret_cast<const std::byte*>(json.data()),
+      json.size());
+}
+
+bool isSame(const JsonValue& a, const JsonValue& b) {
+  if (a.value.index() != b.value.index()) {
+    return false;
+  }
+
+  if (a.isObject()) {
+    const JsonValue::Object& objectA = a.getObject();
+    const JsonValue::Object& objectB = b.getObject();
+    if (objectA.size() != objectB.size()) {
+      return false;
+    }
+    for (const auto& member : objectA) {
+      auto it = objectB.find(member.first);
+      if (it == objectB.end() || !isSame(member.second, it->second)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  if (a.isArray()) {
+    const JsonValue::Array& arrayA = a.getArray();
+    const JsonValue::Array& arrayB = b.getArray();
+    if (arrayA.size() != arrayB.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < arrayA.size(); ++i) {
+      if (!isSame(arrayA[i], arrayB[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  if (a.isString()) {
+    return a.getString() == b.getString();
+  }
+  if (a.isBool()) {
+    return a.getBool() == b.getBool();
+  }
+  if (a.isDouble()) {
+    return a.getDouble() == b.getDouble();
+  }
+  if (a.isUint64()) {
+    return std::get<std::uint64_t>(a.value) == std::get<std::uint64_t>(b.value);
+  }
+  if (a.isInt64()) {
+    return std::get<std::int64_t>(a.value) == std::get<std::int64_t>(b.value);
+  }
+  return true;
+}
+
+// Reads the JSON into a FlatJsonDocument and into a JsonValue, and checks that
+// both hold the same value.
+FlatJsonDocument readFlatAndCompare(const std::string& json) {
+  RootJsonHandler<FlatJsonDocument> flatHandler;
+  ReadJsonResult<FlatJsonDocument> flat =
+      JsonReader::readJson(asBytes(json), flatHandler);
+  REQUIRE(flat.errors.empty());
+  REQUIRE(flat.value);
+
+  RootJsonHandler<JsonValue> valueHandler;
+  ReadJsonResult<JsonValue> value =
+      JsonReader::readJson(asBytes(json), valueHandler);
+  REQUIRE(value.errors.empty());
+  REQUIRE(value.value);
+
+  CHECK(isSame(flat.value->getRoot().toJsonValue(), *value.value));
+  return std::move(*flat.value);
+}
+} // namespace
+
+TEST_CASE("JsonObjectJsonHandler reads into a FlatJsonDocument") {
+  SECTION("nested objects and arrays") {
+    const std::string json = R"({
+      "name": "tree",
+      "height": 12.5,
+      "count": 3,
+      "offset": -4,
+      "big": 18446744073709551615,
+      "visible": true,
+      "missing": null,
+      "tags": ["a", {"nested": [1, [2, "b"], {}]}, [], "c"],
+      "empty": {},
+      "last": {"x": {"y": [false]}}
+    })";
+
+    const FlatJsonDocument document = readFlatAndCompare(json);
+    const FlatJsonValue root = document.getRoot();
+    REQUIRE(root.isObject());
+    CHECK(root.size() == 10);
+    CHECK(root.getValueForKey("name")->getString() == "tree");
+    CHECK(root.getValueForKey("big")->getUint64() == 18446744073709551615U);
+    CHECK(root.getValueForKey("offset")->getInt64() == -4);
+
+    const std::optional<FlatJsonValue> tags = root.getValueForKey("tags");
+    REQUIRE(tags);
+    CHECK(tags->size() == 4);
+
+    const std::optional<FlatJsonValue> last = root.getValueForKey("last");
+    REQUIRE(last);
+    CHECK(last->getValueForKey("x")->getValueForKey("y")->size() == 1);
+  }
+
+  SECTION("a root that is not an object") {
+    const std::string json = GENERATE(
+        std::string(R"([1, "a", [true, null], {"b": -2}, []])"),
+        std::string(R"("text")"),
+        std::string("42"));
+
+    readFlatAndCompare(json);
+  }
+
+  SECTION("a value nested in another object") {
+    const std::string flatJson = GENERATE(
+        std::string(R"({"a": [1, {"b": "c"}], "d": {"e": {}}})"),
+        std::string(R"([1, ["x", [2]], {}])"),
+        std::string(R"("text")"),
+        std::string("2.5"));
+
+    // The handler of the document returns to its parent once the value is
+    // complete, so the members after it are read by the parent again.
+    const std::string json = R"({"flat": )" + flatJson +
+                             R"(, "count": 7, "value": )" + flatJson + "}";
+
+    RecordJsonHandler handler;
+    ReadJsonResult<Record> result =
+        JsonReader::readJson(asBytes(json), handler);
+    REQUIRE(result.errors.empty());
+    REQUIRE(result.value);
+
+    CHECK(result.value->count == 7);
+    CHECK(isSame(
+        result.value->flat.getRoot().toJsonValue(),
+        result.value->value));
+  }
+}
@@ -3,7 +3,10 @@
 // forward declarations
 namespace CesiumJsonWriter {
 class JsonWriter;
-}
+template <typename TFormat> class StaticJsonWriter;
+struct CompactJsonFormat;
+struct PrettyJsonFormat;
+} // namespace CesiumJsonWriter
 
 // forward declarations
 namespace CesiumUtility {
@@ -12,4 +15,10 @@ class JsonValue;
 
 namespace CesiumJsonWriter {
 void writeJsonValue(const CesiumUtility::JsonValue& value, JsonWriter& writer);
-}
+void writeJsonValue(
+    const CesiumUtility::JsonValue& value,
+    StaticJsonWriter<CompactJsonFormat>& writer);
+void writeJsonValue(
+    const CesiumUtility::JsonValue& value,
+    StaticJsonWriter<PrettyJsonFormat>& writer);
+} // namespace CesiumJsonWriter
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/writer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace CesiumJsonWriter {
+
+/**
+ * @brief A rapidjson output stream that appends to a caller-supplied byte
+ * vector.
+ */
+class JsonOutputStream {
+public:
+  using Ch = char;
+
+  /**
+   * @brief Creates a stream that appends to the given vector.
+   */
+  explicit JsonOutputStream(std::vector<std::byte>& output) noexcept
+      : _pOutput(&output) {}
+
+  /**
+   * @brief Appends a character to the output.
+   */
+  void Put(char c) { this->_pOutput->push_back(std::byte(c)); }
+
+  /**
+   * @brief Does nothing, because the output is always up to date.
+   */
+  void Flush() noexcept {}
+
+  /**
+   * @brief Gets the vector the stream appends to.
+   */
+  std::vector<std::byte>& getOutput() const noexcept { return *_pOutput; }
+
+private:
+  std::vector<std::byte>* _pOutput;
+};
+
+/**
+ * @brief A format for {@link StaticJsonWriter} that writes JSON without any
+ * whitespace, like {@link JsonWriter}.
+ */
+struct CompactJsonFormat {
+  /**
+   * @brief The rapidjson writer used for this format.
+   */
+  template <typename TOutputStream>
+  using Writer = rapidjson::Writer<TOutputStream>;
+
+  /**
+   * @brief Configures a newly-created rapidjson writer for this format.
+   */
+  template <typename TOutputStream>
+  static void configure(Writer<TOutputStream>& /* writer */) noexcept {}
+};
+
+/**
+ * @brief A format for {@link StaticJsonWriter} that writes indented JSON with
+ * arrays on a single line, like {@link PrettyJsonWriter}.
+ */
+struct PrettyJsonFormat {
+  /**
+   * @brief The rapidjson writer used for this format.
+   */
+  template <typename TOutputStream>
+  using Writer = rapidjson::PrettyWriter<TOutputStream>;
+
+  /**
+   * @brief Configures a newly-created rapidjson writer for this format.
+   */
+  template <typename TOutputStream>
+  static void configure(Writer<TOutputStream>& writer) noexcept {
+    writer.SetFormatOptions(
+        rapidjson::PrettyFormatOptions::kFormatSingleLineArray);
+  }
+};
+
+/**
+ * @brief Writes JSON straight into a caller-supplied byte vector, with the
+ * format chosen at compile time.
+ *
+ * This has the same methods as {@link JsonWriter}, but none of them are
+ * virtual, so calls to them can be inlined. The JSON is appended to the
+ * output vector as it is written, so no copy is needed at the end. Any data
+ * already in the vector is left alone.
+ *
+ * @tparam TFormat The format of the JSON, either {@link CompactJsonFormat} or
+ * {@link PrettyJsonFormat}.
+ */
+template <typename TFormat> class StaticJsonWriter {
+public:
+  /**
+   * @brief Creates a writer that appends to the given vector.
+   *
+   * The vector must outlive the writer.
+   */
+  explicit StaticJsonWriter(std::vector<std::byte>& output)
+      : _stream(output), _writer(_stream), _startOffset(output.size()) {
+    TFormat::configure(this->_writer);
+  }
+
+  StaticJsonWriter(const StaticJsonWriter&) = delete;
+  StaticJsonWriter& operator=(const StaticJsonWriter&) = delete;
+
+  // rapidjson methods
+  bool Null() { return this->_writer.Null(); }
+  bool Bool(bool b) { return this->_writer.Bool(b); }
+  bool Int(int i) { return this->_writer.Int(i); }
+  bool Uint(unsigned int i) { return this->_writer.Uint(i); }
+  bool Uint64(std::uint64_t i) { return this->_writer.Uint64(i); }
+  bool Int64(std::int64_t i) { return this->_writer.Int64(i); }
+  bool Double(double d) { return this->_writer.Double(d); }
+
+  bool RawNumber(const char* str, unsigned int length, bool copy) {
+    return this->_writer.RawNumber(str, length, copy);
+  }
+
+  bool Key(std::string_view string) {
+    return this->_writer.Key(
+        string.data(),
+        static_cast<unsigned int>(string.size()));
+  }
+
+  bool String(std::string_view string) {
+    return this->_writer.String(
+        string.data(),
+        static_cast<unsigned int>(string.size()));
+  }
+
+  bool StartObject() { return this->_writer.StartObject(); }
+  bool EndObject() { return this->_writer.EndObject(); }
+  bool StartArray() { return this->_writer.StartArray(); }
+  bool EndArray() { return this->_writer.EndArray(); }
+
+  // Primitive overloads
+  void Primitive(std::int32_t value) { this->_writer.Int(value); }
+  void Primitive(std::uint32_t value) { this->_writer.Uint(value); }
+  void Primitive(std::int64_t value) { this->_writer.Int64(value); }
+  void Primitive(std::uint64_t value) { this->_writer.Uint64(value); }
+
+  void Primitive(float value) {
+    this->_writer.Double(static_cast<double>(value));
+  }
+
+  void Primitive(double value) { this->_writer.Double(value); }
+  void Primitive(std::nullptr_t) { this->_writer.Null(); }
+  void Primitive(std::string_view string) { this->String(string); }
+
+  // Integral
+  void KeyPrimitive(std::string_view keyName, std::int32_t value) {
+    this->Key(keyName);
+    this->Primitive(value);
+  }
+
+  void KeyPrimitive(std::string_view keyName, std::uint32_t value) {
+    this->Key(keyName);
+    this->Primitive(value);
+  }
+
+  void KeyPrimitive(std::string_view keyName, std::int64_t value) {
+    this->Key(keyName);
+    this->Primitive(value);
+  }
+
+  void KeyPrimitive(std::string_view keyName, std::uint64_t value) {
+    this->Key(keyName);
+    this->Primitive(value);
+  }
+
+  // String
+  void KeyPrimitive(std::string_view keyName, std::string_view value) {
+    this->Key(keyName);
+    this->Primitive(value);
+  }
+
+  // Floating Point
+  void KeyPrimitive(std::string_view keyName, float value) {
+    this->Key(keyName);
+    this->Primitive(value);
+  }
+
+  void KeyPrimitive(std::string_view keyName, double value) {
+    this->Key(keyName);
+    this->Primitive(value);
+  }
+
+  // Null
+  void KeyPrimitive(std::string_view keyName, std::nullptr_t value) {
+    this->Key(keyName);
+    this->Primitive(value);
+  }
+
+  // Array / Objects
+
+  /**
+   * @brief Writes a key followed by an array, whose elements are written by
+   * the given function.
+   */
+  template <typename TFunction>
+  void KeyArray(std::string_view keyName, TFunction&& insideArray) {
+    this->Key(keyName);
+    this->_writer.StartArray();
+    std::forward<TFunction>(insideArray)();
+    this->_writer.EndArray();
+  }
+
+  /**
+   * @brief Writes a key followed by an object, whose members are written by
+   * the given function.
+   */
+  template <typename TFunction>
+  void KeyObject(std::string_view keyName, TFunction&& insideObject) {
+    this->Key(keyName);
+    this->_writer.StartObject();
+    std::forward<TFunction>(insideObject)();
+    this->_writer.EndObject();
+  }
+
+  /**
+   * @brief Gets the JSON written by this writer so far, which is the end of
+   * the output vector.
+   *
+   * The view is invalidated by any further writes.
+   */
+  std::string_view toStringView() const noexcept {
+    const std::vector<std::byte>& output = this->_stream.getOutput();
+    return std::string_view(
+        reinterpret_cast<const char*>(output.data() + this->_startOffset),
+        output.size() - this->_startOffset);
+  }
+
+  /**
+   * @brief Gets a copy of the JSON written by this writer so far.
+   */
+  std::string toString() const { return std::string(this->toStringView()); }
+
+private:
+  JsonOutputStream _stream;
+  typename TFormat::template Writer<JsonOutputStream> _writer;
+  size_t _startOffset;
+};
+
+/**
+ * @brief A {@link StaticJsonWriter} that writes compact JSON.
+ */
+using CompactStaticJsonWriter = StaticJsonWriter<CompactJsonFormat>;
+
+/**
+ * @brief A {@link StaticJsonWriter} that writes indented JSON.
+ */
+using PrettyStaticJsonWriter = StaticJsonWriter<PrettyJsonFormat>;
+
+} // namespace CesiumJsonWriter
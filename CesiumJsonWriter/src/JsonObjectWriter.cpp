@@ -1,6 +1,7 @@
 #include "CesiumJsonWriter/JsonObjectWriter.h"
 
 #include "CesiumJsonWriter/JsonWriter.h"
+#include "CesiumJsonWriter/StaticJsonWriter.h"
 
 #include <CesiumUtility/JsonValue.h>
 
@@ -10,15 +11,19 @@
 
 namespace CesiumJsonWriter {
 namespace {
-void primitiveWriter(const CesiumUtility::JsonValue& item, JsonWriter& j);
+template <typename TJsonWriter>
+void primitiveWriter(const CesiumUtility::JsonValue& item, TJsonWriter& j);
+template <typename TJsonWriter>
 void recursiveArrayWriter(
     const CesiumUtility::JsonValue::Array& array,
-    JsonWriter& j);
+    TJsonWriter& j);
+template <typename TJsonWriter>
 void recursiveObjectWriter(
     const CesiumUtility::JsonValue::Object& object,
-    JsonWriter& j);
+    TJsonWriter& j);
 
-void primitiveWriter(const CesiumUtility::JsonValue& item, JsonWriter& j) {
+template <typename TJsonWriter>
+void primitiveWriter(const CesiumUtility::JsonValue& item, TJsonWriter& j) {
   if (item.isBool()) {
     j.Bool(item.getBool());
   }
@@ -44,9 +49,10 @@ void primitiveWriter(const CesiumUtility::JsonValue& item, JsonWriter& j) {
   }
 }
 
+template <typename TJsonWriter>
 void recursiveArrayWriter(
     const CesiumUtility::JsonValue::Array& array,
-    JsonWriter& j) {
+    TJsonWriter& j) {
   j.StartArray();
   for (const auto& item : array) {
     if (item.isArray()) {
@@ -64,9 +70,10 @@ void recursiveArrayWriter(
   j.EndArray();
 }
 
+template <typename TJsonWriter>
 void recursiveObjectWriter(
     const CesiumUtility::JsonValue::Object& object,
-    JsonWriter& j) {
+    TJsonWriter& j) {
 
   j.StartObject();
 
@@ -91,11 +98,11 @@ void recursiveObjectWriter(
 
   j.EndObject();
 }
-} // namespace
 
-void writeJsonValue(
+template <typename TJsonWriter>
+void writeJsonValueImpl(
     const CesiumUtility::JsonValue& value,
-    JsonWriter& jsonWriter) {
+    TJsonWriter& jsonWriter) {
 
   if (value.isArray()) {
     recursiveArrayWriter(
@@ -109,4 +116,23 @@ void writeJsonValue(
     primitiveWriter(value, jsonWriter);
   }
 }
+} // namespace
+
+void writeJsonValue(
+    const CesiumUtility::JsonValue& value,
+    JsonWriter& jsonWriter) {
+  writeJsonValueImpl(value, jsonWriter);
+}
+
+void writeJsonValue(
+    const CesiumUtility::JsonValue& value,
+    CompactStaticJsonWriter& jsonWriter) {
+  writeJsonValueImpl(value, jsonWriter);
+}
+
+void writeJsonValue(
+    const CesiumUtility::JsonValue& value,
+    PrettyStaticJsonWriter& jsonWriter) {
+  writeJsonValueImpl(value, jsonWriter);
+}
 } // namespace CesiumJsonWriter
@@ -0,0 +1,150 @@
+#include <CesiumJsonWriter/JsonObjectWriter.h>
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
+#include <CesiumUtility/JsonValue.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace CesiumJsonWriter;
+using namespace CesiumUtility;
+
+namespace {
+// Writes something shaped like the accessors of a large glTF.
+template <typename TJsonWriter>
+void writeAccessors(TJsonWriter& writer, size_t count) {
+  writer.StartObject();
+  writer.Key("accessors");
+  writer.StartArray();
+  for (size_t i = 0; i < count; ++i) {
+    writer.StartObject();
+    writer.KeyPrimitive("bufferView", static_cast<std::int32_t>(i));
+    writer.KeyPrimitive("byteOffset", static_cast<std::int64_t>(i * 12));
+    writer.KeyPrimitive("componentType", std::int32_t(5126));
+    writer.KeyPrimitive("count", std::uint64_t(1024));
+    writer.KeyPrimitive("type", std::string_view("VEC3"));
+    writer.KeyArray("min", [&writer]() {
+      writer.Double(-1.5);
+      writer.Double(-2.25);
+      writer.Double(-0.125);
+    });
+    writer.KeyArray("max", [&writer]() {
+      writer.Double(1.5);
+      writer.Double(2.25);
+      writer.Double(0.125);
+    });
+    writer.KeyObject("extras", [&writer]() {
+      writer.KeyPrimitive("name", std::string_view("accessor \"quoted\""));
+      writer.KeyPrimitive("empty", nullptr);
+      writer.Key("flag");
+      writer.Bool(true);
+    });
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+}
+
+std::string_view asStringView(const std::vector<std::byte>& bytes) {
+  return std::string_view(
+      reinterpret_cast<const char*>(bytes.data()),
+      bytes.size());
+}
+} // namespace
+
+TEST_CASE("StaticJsonWriter writes the same JSON as JsonWriter") {
+  SECTION("compact") {
+    JsonWriter expected;
+    writeAccessors(expected, 3);
+
+    std::vector<std::byte> output;
+    CompactStaticJsonWriter writer(output);
+    writeAccessors(writer, 3);
+
+    REQUIRE(writer.toStringView() == expected.toStringView());
+    REQUIRE(asStringView(output) == expected.toStringView());
+  }
+
+  SECTION("pretty") {
+    PrettyJsonWriter expected;
+    writeAccessors(expected, 3);
+
+    std::vector<std::byte> output;
+    PrettyStaticJsonWriter writer(output);
+    writeAccessors(writer, 3);
+
+    REQUIRE(writer.toString() == expected.toString());
+  }
+}
+
+TEST_CASE("StaticJsonWriter appends to the output") {
+  std::vector<std::byte> output{std::byte('>')};
+  CompactStaticJsonWriter writer(output);
+  writer.StartArray();
+  writer.Primitive(std::int32_t(1));
+  writer.Primitive(2.5);
+  writer.Primitive(std::string_view("three"));
+  writer.EndArray();
+
+  REQUIRE(writer.toStringView() == R"([1,2.5,"three"])");
+  REQUIRE(asStringView(output) == R"(>[1,2.5,"three"])");
+}
+
+TEST_CASE("writeJsonValue writes to a StaticJsonWriter") {
+  const JsonValue value = JsonValue::Object{
+      {"extras",
+       JsonValue::Array{
+           JsonValue::Object{},
+           std::int64_t(-1),
+           std::uint64_t(2),
+           3.5,
+           "four",
+           true,
+           JsonValue::Null()}}};
+
+  JsonWriter expected;
+  writeJsonValue(value, expected);
+
+  std::vector<std::byte> output;
+  CompactStaticJsonWriter writer(output);
+  writeJsonValue(value, writer);
+
+  REQUIRE(writer.toStringView() == expected.toStringView());
+}
+
+// Run with `cesium-native-tests "[.benchmark]"`.
+TEST_CASE("Benchmark JsonWriter and StaticJsonWriter", "[.benchmark]") {
+  const size_t accessorCount = 10000;
+
+  BENCHMARK("JsonWriter") {
+    JsonWriter writer;
+    writeAccessors(writer, accessorCount);
+    return writer.toBytes().size();
+  };
+
+  BENCHMARK("CompactStaticJsonWriter") {
+    std::vector<std::byte> output;
+    CompactStaticJsonWriter writer(output);
+    writeAccessors(writer, accessorCount);
+    return output.size();
+  };
+
+  BENCHMARK("PrettyJsonWriter") {
+    PrettyJsonWriter writer;
+    writeAccessors(writer, accessorCount);
+    return writer.toBytes().size();
+  };
+
+  BENCHMARK("PrettyStaticJsonWriter") {
+    std::vector<std::byte> output;
+    PrettyStaticJsonWriter writer(output);
+    writeAccessors(writer, accessorCount);
+    return output.size();
+  };
+}
@@ -0,0 +1,111 @@
+#include "CameraPath.h"
+
+#include <CesiumUtility/JsonHelpers.h>
+
+#include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
+
+#include <cmath>
+
+using namespace CesiumUtility;
+
+namespace CesiumNativeBenchmarks {
+
+namespace {
+std::optional<glm::dvec3> getVector3(
+    const rapidjson::Value& json,
+    const std::string& key,
+    size_t frameIndex,
+    std::vector<std::string>& errors) {
+  const std::optional<std::vector<double>> values =
+      JsonHelpers::getDoubles(json, 3, key);
+  if (!values) {
+    errors.emplace_back(
+        "Frame " + std::to_string(frameIndex) + " has no valid \"" + key +
+        "\", which must be an array of three numbers.");
+    return std::nullopt;
+  }
+  return glm::dvec3((*values)[0], (*values)[1], (*values)[2]);
+}
+} // namespace
+
+Cesium3DTilesSelection::ViewState
+CameraPath::createViewState(const CameraFrame& frame) const {
+  const double aspectRatio = this->viewportSize.y / this->viewportSize.x;
+  const double halfWidth = std::tan(this->horizontalFieldOfView * 0.5);
+  const double verticalFieldOfView =
+      2.0 * std::atan(halfWidth * aspectRatio);
+  return Cesium3DTilesSelection::ViewState::create(
+      frame.position,
+      frame.direction,
+      frame.up,
+      this->viewportSize,
+      this->horizontalFieldOfView,
+      verticalFieldOfView);
+}
+
+/*static*/ std::optional<CameraPath>
+CameraPath::parse(const std::string& json, std::vector<std::string>& errors) {
+  rapidjson::Document document;
+  document.Parse(json.data(), json.size());
+  if (document.HasParseError()) {
+    errors.emplace_back(
+        std::string("Camera path is not valid JSON: ") +
+        rapidjson::GetParseError_En(document.GetParseError()));
+    return std::nullopt;
+  }
+
+  if (!document.IsObject()) {
+    errors.emplace_back("Camera path must be a JSON object.");
+    return std::nullopt;
+  }
+
+  CameraPath path;
+
+  const std::optional<std::vector<double>> viewportSize =
+      JsonHelpers::getDoubles(document, 2, "viewportSize");
+  if (viewportSize) {
+    path.viewportSize = glm::dvec2((*viewportSize)[0], (*viewportSize)[1]);
+  }
+  if (!(path.viewportSize.x > 0.0 && path.viewportSize.y > 0.0)) {
+    errors.emplace_back("\"viewportSize\" must be two positive numbers.");
+    return std::nullopt;
+  }
+
+  path.horizontalFieldOfView = JsonHelpers::getDoubleOrDefault(
+      document,
+      "horizontalFieldOfView",
+      path.horizontalFieldOfView);
+
+  const auto framesIt = document.FindMember("frames");
+  if (framesIt == document.MemberEnd() || !framesIt->value.IsArray() ||
+      framesIt->value.Empty()) {
+    errors.emplace_back("\"frames\" must be a non-empty array.");
+    return std::nullopt;
+  }
+
+  const rapidjson::Value& frames = framesIt->value;
+  path.frames.reserve(frames.Size());
+  for (rapidjson::SizeType i = 0; i < frames.Size(); ++i) {
+    const rapidjson::Value& frame = frames[i];
+    if (!frame.IsObject()) {
+      errors.emplace_back("Frame " + std::to_string(i) + " is not an object.");
+      return std::nullopt;
+    }
+
+    const std::optional<glm::dvec3> position =
+        getVector3(frame, "position", i, errors);
+    const std::optional<glm::dvec3> direction =
+        getVector3(frame, "direction", i, errors);
+    const std::optional<glm::dvec3> up = getVector3(frame, "up", i, errors);
+    if (!position || !direction || !up) {
+      return std::nullopt;
+    }
+
+    path.frames.push_back(CameraFrame{*position, *direction, *up});
+  }
+
+  return path;
+}
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/ViewState.h>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief The camera in one frame of a {@link CameraPath}, in Earth-centered,
+ * Earth-fixed coordinates.
+ */
+struct CameraFrame {
+  glm::dvec3 position;
+  glm::dvec3 direction;
+  glm::dvec3 up;
+};
+
+/**
+ * @brief A recorded sequence of camera positions to replay, one per frame.
+ *
+ * A path is stored as JSON:
+ *
+ * ```
+ * {
+ *   "viewportSize": [1920, 1080],
+ *   "horizontalFieldOfView": 1.0471975511965976,
+ *   "frames": [
+ *     {
+ *       "position": [x, y, z],
+ *       "direction": [x, y, z],
+ *       "up": [x, y, z]
+ *     }
+ *   ]
+ * }
+ * ```
+ *
+ * The field of view is in radians. The vertical field of view follows from
+ * the aspect ratio of the viewport.
+ */
+struct CameraPath {
+  glm::dvec2 viewportSize{1920.0, 1080.0};
+  double horizontalFieldOfView = 1.0471975511965976;
+  std::vector<CameraFrame> frames;
+
+  /**
+   * @brief Creates the view of the camera in a frame.
+   */
+  Cesium3DTilesSelection::ViewState
+  createViewState(const CameraFrame& frame) const;
+
+  /**
+   * @brief Parses a camera path from JSON.
+   *
+   * @param json The JSON text.
+   * @param errors Receives a message for each problem with the JSON.
+   * @return The path, or `std::nullopt` if the JSON is not a valid path.
+   */
+  static std::optional<CameraPath>
+  parse(const std::string& json, std::vector<std::string>& errors);
+};
+
+} // namespace CesiumNativeBenchmarks
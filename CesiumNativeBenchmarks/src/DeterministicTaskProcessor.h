@@ -0,0 +1,53 @@
+#pragma once
+
+#include <CesiumAsync/ITaskProcessor.h>
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <utility>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief A task processor that queues worker thread tasks and runs them on
+ * the calling thread, in the order they were started, when {@link runAll} is
+ * called.
+ *
+ * Running everything on one thread in a fixed order makes the result of a
+ * replay independent of thread scheduling, so two runs load the same tiles in
+ * the same frames.
+ */
+class DeterministicTaskProcessor : public CesiumAsync::ITaskProcessor {
+public:
+  virtual void startTask(std::function<void()> f) override {
+    this->_tasks.emplace_back(std::move(f));
+  }
+
+  /**
+   * @brief Runs queued tasks, including tasks queued by the tasks that run,
+   * until the queue is empty.
+   *
+   * @return The number of tasks that ran.
+   */
+  size_t runAll() {
+    size_t count = 0;
+    while (!this->_tasks.empty()) {
+      std::function<void()> task = std::move(this->_tasks.front());
+      this->_tasks.pop_front();
+      task();
+      ++count;
+    }
+    return count;
+  }
+
+  /**
+   * @brief Determines if no tasks are waiting to run.
+   */
+  bool isIdle() const noexcept { return this->_tasks.empty(); }
+
+private:
+  std::deque<std::function<void()>> _tasks;
+};
+
+} // namespace CesiumNativeBenchmarks
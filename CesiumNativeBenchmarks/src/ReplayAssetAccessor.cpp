@@ -0,0 +1,258 @@
+#include "ReplayAssetAccessor.h"
+
+#include "DeterministicTaskProcessor.h"
+
+#include <CesiumAsync/IAssetResponse.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <optional>
+
+using namespace CesiumAsync;
+
+namespace CesiumNativeBenchmarks {
+
+namespace {
+class ReplayAssetResponse : public IAssetResponse {
+public:
+  ReplayAssetResponse(
+      uint16_t statusCode,
+      std::string contentType,
+      std::vector<std::byte>&& data)
+      : _statusCode(statusCode),
+        _contentType(std::move(contentType)),
+        _headers{{"Content-Type", this->_contentType}},
+        _data(std::move(data)) {}
+
+  virtual uint16_t statusCode() const override { return this->_statusCode; }
+
+  virtual std::string contentType() const override {
+    return this->_contentType;
+  }
+
+  virtual const HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return gsl::span<const std::byte>(this->_data.data(), this->_data.size());
+  }
+
+private:
+  uint16_t _statusCode;
+  std::string _contentType;
+  HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+class ReplayAssetRequest : public IAssetRequest {
+public:
+  ReplayAssetRequest(
+      std::string url,
+      const std::vector<IAssetAccessor::THeader>& headers,
+      std::unique_ptr<ReplayAssetResponse>&& pResponse)
+      : _method("GET"),
+        _url(std::move(url)),
+        _headers(headers.begin(), headers.end()),
+        _pResponse(std::move(pResponse)) {}
+
+  virtual const std::string& method() const override { return this->_method; }
+
+  virtual const std::string& url() const override { return this->_url; }
+
+  virtual const HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual const IAssetResponse* response() const override {
+    return this->_pResponse.get();
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  HttpHeaders _headers;
+  std::unique_ptr<ReplayAssetResponse> _pResponse;
+};
+
+std::string percentDecode(const std::string& s) {
+  std::string result;
+  result.reserve(s.size());
+  for (size_t i = 0; i < s.size(); ++i) {
+    if (s[i] == '%' && i + 2 < s.size() &&
+        std::isxdigit(static_cast<unsigned char>(s[i + 1])) &&
+        std::isxdigit(static_cast<unsigned char>(s[i + 2]))) {
+      result += static_cast<char>(std::stoi(s.substr(i + 1, 2), nullptr, 16));
+      i += 2;
+    } else {
+      result += s[i];
+    }
+  }
+  return result;
+}
+
+std::string getContentType(const std::string& path) {
+  const size_t dot = path.rfind('.');
+  const std::string extension =
+      dot == std::string::npos ? std::string() : path.substr(dot + 1);
+
+  if (extension == "json") {
+    return "application/json";
+  }
+  if (extension == "terrain") {
+    return "application/vnd.quantized-mesh";
+  }
+  if (extension == "glb") {
+    return "model/gltf-binary";
+  }
+  return "application/octet-stream";
+}
+
+std::optional<std::vector<std::byte>> readFile(const std::string& path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return std::nullopt;
+  }
+
+  const std::streamsize size = file.tellg();
+  file.seekg(0, std::ios::beg);
+
+  std::vector<std::byte> buffer(static_cast<size_t>(size));
+  file.read(reinterpret_cast<char*>(buffer.data()), size);
+  if (!file) {
+    return std::nullopt;
+  }
+  return buffer;
+}
+} // namespace
+
+ReplayAssetAccessor::ReplayAssetAccessor(
+    const std::string& baseUrl,
+    const std::string& directory,
+    const ReplayNetworkOptions& options,
+    const std::shared_ptr<DeterministicTaskProcessor>& pTaskProcessor)
+    : _baseUrl(baseUrl),
+      _directory(directory),
+      _options(options),
+      _pTaskProcessor(pTaskProcessor),
+      _now(0.0),
+      _linkAvailableTime(0.0),
+      _finishAll(false),
+      _pending(),
+      _requestCount(0),
+      _failedRequestCount(0),
+      _bytesFetched(0) {
+  if (!this->_directory.empty() && this->_directory.back() != '/') {
+    this->_directory += '/';
+  }
+}
+
+ReplayAssetAccessor::~ReplayAssetAccessor() noexcept = default;
+
+Future<std::shared_ptr<IAssetRequest>> ReplayAssetAccessor::requestAsset(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  const uint64_t sequence = this->_requestCount++;
+
+  std::optional<std::vector<std::byte>> maybeData;
+  if (url.compare(0, this->_baseUrl.size(), this->_baseUrl) == 0) {
+    std::string relative = url.substr(this->_baseUrl.size());
+    relative = relative.substr(0, relative.find_first_of("?#"));
+    maybeData = readFile(this->_directory + percentDecode(relative));
+  }
+
+  std::unique_ptr<ReplayAssetResponse> pResponse;
+  if (maybeData) {
+    pResponse = std::make_unique<ReplayAssetResponse>(
+        static_cast<uint16_t>(200),
+        getContentType(url.substr(0, url.find_first_of("?#"))),
+        std::move(*maybeData));
+  } else {
+    ++this->_failedRequestCount;
+    pResponse = std::make_unique<ReplayAssetResponse>(
+        static_cast<uint16_t>(404),
+        "text/plain",
+        std::vector<std::byte>());
+  }
+
+  // The response starts to arrive after the latency, once the link has
+  // finished transferring the responses before it.
+  const double size = static_cast<double>(pResponse->data().size());
+  const double transferTime =
+      this->_options.bandwidth > 0.0 ? size / this->_options.bandwidth : 0.0;
+  const double transferStart =
+      std::max(this->_now + this->_options.latency, this->_linkAvailableTime);
+  const double arrivalTime = transferStart + transferTime;
+  this->_linkAvailableTime = arrivalTime;
+
+  auto promise = asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>();
+  Future<std::shared_ptr<IAssetRequest>> future = promise.getFuture();
+
+  PendingRequest pending{
+      arrivalTime,
+      sequence,
+      std::make_shared<ReplayAssetRequest>(url, headers, std::move(pResponse)),
+      std::move(promise)};
+  auto it = std::upper_bound(
+      this->_pending.begin(),
+      this->_pending.end(),
+      pending,
+      [](const PendingRequest& lhs, const PendingRequest& rhs) {
+        return lhs.arrivalTime < rhs.arrivalTime ||
+               (lhs.arrivalTime == rhs.arrivalTime &&
+                lhs.sequence < rhs.sequence);
+      });
+  this->_pending.insert(it, std::move(pending));
+
+  return future;
+}
+
+Future<std::shared_ptr<IAssetRequest>> ReplayAssetAccessor::post(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& /*contentPayload*/) {
+  return this->requestAsset(asyncSystem, url, headers);
+}
+
+void ReplayAssetAccessor::tick() noexcept {
+  // Completing a request or running a task may start new requests, which
+  // may already have arrived if there is no latency, so repeat until
+  // nothing more happens.
+  bool progressed = true;
+  while (progressed) {
+    progressed = this->_pTaskProcessor->runAll() > 0;
+
+    auto firstPending = std::find_if(
+        this->_pending.begin(),
+        this->_pending.end(),
+        [this](const PendingRequest& pending) {
+          return !this->_finishAll && pending.arrivalTime > this->_now;
+        });
+    if (firstPending == this->_pending.begin()) {
+      continue;
+    }
+
+    // Take the arrived requests out before resolving them, because their
+    // continuations may add new ones.
+    std::vector<PendingRequest> arrived(
+        std::make_move_iterator(this->_pending.begin()),
+        std::make_move_iterator(firstPending));
+    this->_pending.erase(this->_pending.begin(), firstPending);
+
+    for (PendingRequest& pending : arrived) {
+      this->_bytesFetched += pending.pRequest->response()->data().size();
+      pending.promise.resolve(std::move(pending.pRequest));
+    }
+    progressed = true;
+  }
+}
+
+bool ReplayAssetAccessor::isIdle() const noexcept {
+  return this->_pending.empty() && this->_pTaskProcessor->isIdle();
+}
+
+} // namespace CesiumNativeBenchmarks
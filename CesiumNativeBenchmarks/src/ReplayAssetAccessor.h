@@ -0,0 +1,155 @@
+#pragma once
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/Promise.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CesiumNativeBenchmarks {
+
+class DeterministicTaskProcessor;
+
+/**
+ * @brief Options for a {@link ReplayAssetAccessor}.
+ */
+struct ReplayNetworkOptions {
+  /**
+   * @brief The time from sending a request until the first byte of its
+   * response arrives, in seconds.
+   */
+  double latency = 0.05;
+
+  /**
+   * @brief The number of bytes per second that responses are transferred at.
+   *
+   * All requests share one link, so a response only starts to transfer once
+   * the previous one has finished. If this is zero or less, transfers are
+   * instant.
+   */
+  double bandwidth = 12.5e6;
+};
+
+/**
+ * @brief An {@link CesiumAsync::IAssetAccessor} that serves files from a
+ * local directory over a simulated network.
+ *
+ * URLs under the base URL given to the constructor map to files under the
+ * directory. Time does not pass by itself: the replay advances a virtual
+ * clock with {@link advanceTime}, and {@link tick} completes the requests
+ * whose responses have fully arrived by then, in the order they arrive, and
+ * then runs the worker thread tasks of the {@link DeterministicTaskProcessor}.
+ * The same sequence of requests therefore always completes in the same
+ * frames, however fast the machine is.
+ */
+class ReplayAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  /**
+   * @brief Creates a new accessor.
+   *
+   * @param baseUrl The URL that the directory is served at, ending in a
+   * slash.
+   * @param directory The directory to serve files from.
+   * @param options The simulated network.
+   * @param pTaskProcessor The task processor to run in {@link tick}.
+   */
+  ReplayAssetAccessor(
+      const std::string& baseUrl,
+      const std::string& directory,
+      const ReplayNetworkOptions& options,
+      const std::shared_ptr<DeterministicTaskProcessor>& pTaskProcessor);
+
+  virtual ~ReplayAssetAccessor() noexcept override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  requestAsset(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers = {}) override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  post(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  /**
+   * @brief Completes the requests that have arrived by the current time, and
+   * runs all queued worker thread tasks.
+   *
+   * After {@link finishAll} is called, all outstanding requests are
+   * completed regardless of the time.
+   */
+  virtual void tick() noexcept override;
+
+  /**
+   * @brief Advances the virtual clock.
+   */
+  void advanceTime(double seconds) noexcept { this->_now += seconds; }
+
+  /**
+   * @brief Gets the virtual time, in seconds since the accessor was created.
+   */
+  double getTime() const noexcept { return this->_now; }
+
+  /**
+   * @brief Makes every later {@link tick} complete all outstanding requests,
+   * so the tileset can be destroyed without advancing the clock.
+   */
+  void finishAll() noexcept { this->_finishAll = true; }
+
+  /**
+   * @brief Determines if there are no outstanding requests and no queued
+   * worker thread tasks.
+   */
+  bool isIdle() const noexcept;
+
+  /**
+   * @brief Gets the number of requests made so far.
+   */
+  uint64_t getRequestCount() const noexcept { return this->_requestCount; }
+
+  /**
+   * @brief Gets the number of requests for files that do not exist.
+   */
+  uint64_t getFailedRequestCount() const noexcept {
+    return this->_failedRequestCount;
+  }
+
+  /**
+   * @brief Gets the number of response bytes that have arrived so far.
+   */
+  uint64_t getBytesFetched() const noexcept { return this->_bytesFetched; }
+
+private:
+  struct PendingRequest {
+    double arrivalTime;
+    uint64_t sequence;
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRequest;
+    CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> promise;
+  };
+
+  std::string _baseUrl;
+  std::string _directory;
+  ReplayNetworkOptions _options;
+  std::shared_ptr<DeterministicTaskProcessor> _pTaskProcessor;
+
+  double _now;
+  double _linkAvailableTime;
+  bool _finishAll;
+
+  // Ordered by arrival time, then by the order of the requests.
+  std::vector<PendingRequest> _pending;
+
+  uint64_t _requestCount;
+  uint64_t _failedRequestCount;
+  uint64_t _bytesFetched;
+};
+
+} // namespace CesiumNativeBenchmarks
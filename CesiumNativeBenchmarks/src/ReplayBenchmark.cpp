@@ -0,0 +1,358 @@
+#include "ReplayBenchmark.h"
+
+#include "DeterministicTaskProcessor.h"
+
+#include <Cesium3DTilesSelection/CreditSystem.h>
+#include <Cesium3DTilesSelection/IPrepareRendererResources.h>
+#include <Cesium3DTilesSelection/Tileset.h>
+#include <Cesium3DTilesSelection/TilesetExternals.h>
+#include <Cesium3DTilesSelection/ViewUpdateResult.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumJsonWriter/StaticJsonWriter.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+// windows.h must come first
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumAsync;
+using namespace CesiumUtility;
+
+namespace CesiumNativeBenchmarks {
+
+namespace {
+// The URL that the tileset directory is served at. It is not a file URL so
+// that content types are not guessed from the scheme.
+const std::string baseUrl = "https://replay.invalid/";
+
+/**
+ * @brief Renderer resources that only count how many tiles are loaded and
+ * unloaded.
+ */
+class CountingPrepareRendererResources : public IPrepareRendererResources {
+public:
+  virtual void* prepareInLoadThread(
+      const CesiumGltf::Model& /*model*/,
+      const glm::dmat4& /*transform*/) override {
+    return nullptr;
+  }
+
+  virtual void*
+  prepareInMainThread(Tile& /*tile*/, void* /*pLoadThreadResult*/) override {
+    ++this->tilesLoaded;
+    return nullptr;
+  }
+
+  virtual void free(
+      Tile& /*tile*/,
+      void* /*pLoadThreadResult*/,
+      void* /*pMainThreadResult*/) noexcept override {
+    ++this->tilesUnloaded;
+  }
+
+  virtual void*
+  prepareRasterInLoadThread(const CesiumGltf::ImageCesium& /*image*/) override {
+    return nullptr;
+  }
+
+  virtual void* prepareRasterInMainThread(
+      const RasterOverlayTile& /*rasterTile*/,
+      void* /*pLoadThreadResult*/) override {
+    return nullptr;
+  }
+
+  virtual void freeRaster(
+      const RasterOverlayTile& /*rasterTile*/,
+      void* /*pLoadThreadResult*/,
+      void* /*pMainThreadResult*/) noexcept override {}
+
+  virtual void attachRasterInMainThread(
+      const Tile& /*tile*/,
+      int32_t /*overlayTextureCoordinateID*/,
+      const RasterOverlayTile& /*rasterTile*/,
+      void* /*pMainThreadRendererResources*/,
+      const glm::dvec2& /*translation*/,
+      const glm::dvec2& /*scale*/) override {}
+
+  virtual void detachRasterInMainThread(
+      const Tile& /*tile*/,
+      int32_t /*overlayTextureCoordinateID*/,
+      const RasterOverlayTile& /*rasterTile*/,
+      void* /*pMainThreadRendererResources*/) noexcept override {}
+
+  uint64_t tilesLoaded = 0;
+  uint64_t tilesUnloaded = 0;
+};
+
+std::optional<uint64_t> getPeakResidentSetBytes() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return static_cast<uint64_t>(counters.PeakWorkingSetSize);
+  }
+  return std::nullopt;
+#else
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return std::nullopt;
+  }
+#ifdef __APPLE__
+  // macOS reports bytes, other systems kilobytes.
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+  return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+double getQuantile(const std::vector<double>& sorted, double quantile) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  const size_t index = static_cast<size_t>(
+      quantile * static_cast<double>(sorted.size() - 1) + 0.5);
+  return sorted[std::min(index, sorted.size() - 1)];
+}
+
+template <typename TWriter>
+void writeLabels(TWriter& writer, const MetricLabels& labels) {
+  writer.KeyObject("labels", [&]() {
+    for (const auto& label : labels) {
+      writer.KeyPrimitive(label.first, label.second);
+    }
+  });
+}
+} // namespace
+
+ReplayBenchmarkResult runReplayBenchmark(
+    const CameraPath& path,
+    const ReplayBenchmarkOptions& options) {
+  auto pTaskProcessor = std::make_shared<DeterministicTaskProcessor>();
+  auto pAssetAccessor = std::make_shared<ReplayAssetAccessor>(
+      baseUrl,
+      options.directory,
+      options.network,
+      pTaskProcessor);
+  auto pRendererResources =
+      std::make_shared<CountingPrepareRendererResources>();
+  auto pMetrics = std::make_shared<MetricsRegistry>();
+
+  TilesetExternals externals{
+      pAssetAccessor,
+      pRendererResources,
+      AsyncSystem(pTaskProcessor),
+      std::make_shared<CreditSystem>()};
+  externals.pMetrics = pMetrics;
+
+  ReplayBenchmarkResult result;
+  result.pathFrameCount = static_cast<uint32_t>(path.frames.size());
+  if (path.frames.empty()) {
+    return result;
+  }
+
+  {
+    Tileset tileset(
+        externals,
+        baseUrl + options.tilesetFile,
+        options.tilesetOptions);
+
+    const auto runFrame = [&](const CameraFrame& frame) {
+      pAssetAccessor->tick();
+
+      const std::vector<ViewState> frustums{path.createViewState(frame)};
+      const auto start = std::chrono::steady_clock::now();
+      const ViewUpdateResult& updateResult = tileset.updateView(frustums);
+      const std::chrono::duration<double> selectionTime =
+          std::chrono::steady_clock::now() - start;
+
+      ReplayFrameResult frameResult{
+          pAssetAccessor->getTime(),
+          selectionTime.count(),
+          static_cast<uint32_t>(updateResult.tilesToRenderThisFrame.size()),
+          updateResult.tilesVisited,
+          updateResult.tilesLoadingLowPriority +
+              updateResult.tilesLoadingMediumPriority +
+              updateResult.tilesLoadingHighPriority,
+          tileset.getTotalDataBytes(),
+          pAssetAccessor->getBytesFetched()};
+      result.peakTileDataBytes =
+          std::max(result.peakTileDataBytes, frameResult.totalDataBytes);
+      result.frames.push_back(frameResult);
+
+      pAssetAccessor->advanceTime(options.frameDuration);
+      return frameResult.tilesLoading == 0 && pAssetAccessor->isIdle();
+    };
+
+    for (const CameraFrame& frame : path.frames) {
+      runFrame(frame);
+    }
+
+    // Hold the last view until everything it needs is loaded.
+    const CameraFrame& lastFrame = path.frames.back();
+    while (result.framesToConverge < options.maximumConvergenceFrames) {
+      ++result.framesToConverge;
+      if (runFrame(lastFrame)) {
+        result.converged = true;
+        break;
+      }
+    }
+    result.timeToConverge = result.frames.back().time;
+
+    result.metrics = pMetrics->snapshot();
+    result.tilesLoaded = pRendererResources->tilesLoaded;
+    result.tilesUnloaded = pRendererResources->tilesUnloaded;
+
+    // Let the tileset wait for its outstanding loads without advancing time.
+    pAssetAccessor->finishAll();
+  }
+
+  result.requests = pAssetAccessor->getRequestCount();
+  result.failedRequests = pAssetAccessor->getFailedRequestCount();
+  result.bytesFetched = pAssetAccessor->getBytesFetched();
+  result.peakResidentSetBytes = getPeakResidentSetBytes();
+
+  return result;
+}
+
+std::string formatReplayBenchmarkResult(
+    const ReplayBenchmarkOptions& options,
+    const ReplayBenchmarkResult& result) {
+  std::vector<double> selectionTimes;
+  selectionTimes.reserve(result.frames.size());
+  for (const ReplayFrameResult& frame : result.frames) {
+    selectionTimes.push_back(frame.selectionTime);
+  }
+  const double totalSelectionTime =
+      std::accumulate(selectionTimes.begin(), selectionTimes.end(), 0.0);
+  std::sort(selectionTimes.begin(), selectionTimes.end());
+
+  std::vector<std::byte> output;
+  CesiumJsonWriter::StaticJsonWriter<CesiumJsonWriter::PrettyJsonFormat>
+      writer(output);
+
+  writer.StartObject();
+
+  writer.KeyObject("configuration", [&]() {
+    writer.KeyPrimitive("directory", options.directory);
+    writer.KeyPrimitive("tilesetFile", options.tilesetFile);
+    writer.KeyPrimitive("latencySeconds", options.network.latency);
+    writer.KeyPrimitive(
+        "bandwidthBytesPerSecond",
+        options.network.bandwidth);
+    writer.KeyPrimitive("frameDurationSeconds", options.frameDuration);
+    writer.KeyPrimitive(
+        "maximumSimultaneousTileLoads",
+        options.tilesetOptions.maximumSimultaneousTileLoads);
+    writer.KeyPrimitive(
+        "maximumCachedBytes",
+        options.tilesetOptions.maximumCachedBytes);
+    writer.KeyPrimitive(
+        "maximumScreenSpaceError",
+        options.tilesetOptions.maximumScreenSpaceError);
+  });
+
+  writer.KeyObject("summary", [&]() {
+    writer.KeyPrimitive("pathFrames", result.pathFrameCount);
+    writer.KeyPrimitive(
+        "frames",
+        static_cast<uint64_t>(result.frames.size()));
+    writer.KeyObject("selectionSeconds", [&]() {
+      const double frameCount = static_cast<double>(selectionTimes.size());
+      writer.KeyPrimitive(
+          "mean",
+          selectionTimes.empty() ? 0.0 : totalSelectionTime / frameCount);
+      writer.KeyPrimitive("p50", getQuantile(selectionTimes, 0.5));
+      writer.KeyPrimitive("p90", getQuantile(selectionTimes, 0.9));
+      writer.KeyPrimitive("p99", getQuantile(selectionTimes, 0.99));
+      writer.KeyPrimitive(
+          "max",
+          selectionTimes.empty() ? 0.0 : selectionTimes.back());
+    });
+    writer.Key("converged");
+    writer.Bool(result.converged);
+    writer.KeyPrimitive("framesToConverge", result.framesToConverge);
+    writer.KeyPrimitive("timeToConvergeSeconds", result.timeToConverge);
+    writer.KeyPrimitive("tilesLoaded", result.tilesLoaded);
+    writer.KeyPrimitive("tilesUnloaded", result.tilesUnloaded);
+    writer.KeyPrimitive("requests", result.requests);
+    writer.KeyPrimitive("failedRequests", result.failedRequests);
+    writer.KeyPrimitive("bytesFetched", result.bytesFetched);
+    writer.KeyPrimitive("peakTileDataBytes", result.peakTileDataBytes);
+    if (result.peakResidentSetBytes) {
+      writer.KeyPrimitive(
+          "peakResidentSetBytes",
+          *result.peakResidentSetBytes);
+    } else {
+      writer.KeyPrimitive("peakResidentSetBytes", nullptr);
+    }
+  });
+
+  writer.KeyObject("metrics", [&]() {
+    writer.KeyArray("counters", [&]() {
+      for (const MetricsSnapshot::Counter& counter : result.metrics.counters) {
+        writer.StartObject();
+        writer.KeyPrimitive("name", counter.name);
+        writeLabels(writer, counter.labels);
+        writer.KeyPrimitive("value", counter.value);
+        writer.EndObject();
+      }
+    });
+    writer.KeyArray("gauges", [&]() {
+      for (const MetricsSnapshot::Gauge& gauge : result.metrics.gauges) {
+        writer.StartObject();
+        writer.KeyPrimitive("name", gauge.name);
+        writeLabels(writer, gauge.labels);
+        writer.KeyPrimitive("value", gauge.value);
+        writer.EndObject();
+      }
+    });
+    writer.KeyArray("histograms", [&]() {
+      for (const MetricsSnapshot::Histogram& histogram :
+           result.metrics.histograms) {
+        writer.StartObject();
+        writer.KeyPrimitive("name", histogram.name);
+        writeLabels(writer, histogram.labels);
+        writer.KeyPrimitive("count", histogram.count);
+        writer.KeyPrimitive("sumMicroseconds", histogram.sum);
+        writer.KeyPrimitive("p50Microseconds", histogram.p50);
+        writer.KeyPrimitive("p90Microseconds", histogram.p90);
+        writer.KeyPrimitive("p99Microseconds", histogram.p99);
+        writer.KeyPrimitive("maxMicroseconds", histogram.maximum);
+        writer.EndObject();
+      }
+    });
+  });
+
+  writer.KeyArray("frames", [&]() {
+    for (const ReplayFrameResult& frame : result.frames) {
+      writer.StartObject();
+      writer.KeyPrimitive("timeSeconds", frame.time);
+      writer.KeyPrimitive("selectionSeconds", frame.selectionTime);
+      writer.KeyPrimitive("tilesRendered", frame.tilesRendered);
+      writer.KeyPrimitive("tilesVisited", frame.tilesVisited);
+      writer.KeyPrimitive("tilesLoading", frame.tilesLoading);
+      writer.KeyPrimitive("totalDataBytes", frame.totalDataBytes);
+      writer.KeyPrimitive("bytesFetched", frame.bytesFetched);
+      writer.EndObject();
+    }
+  });
+
+  writer.EndObject();
+
+  return writer.toString();
+}
+
+} // namespace CesiumNativeBenchmarks
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "CameraPath.h"
+#include "ReplayAssetAccessor.h"
+
+#include <Cesium3DTilesSelection/TilesetOptions.h>
+#include <CesiumUtility/Metrics.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace CesiumNativeBenchmarks {
+
+/**
+ * @brief Options for {@link runReplayBenchmark}.
+ */
+struct ReplayBenchmarkOptions {
+  /**
+   * @brief The directory that holds the tileset.
+   */
+  std::string directory;
+
+  /**
+   * @brief The path of the tileset's root JSON, relative to the
+   * {@link directory}.
+   */
+  std::string tilesetFile = "tileset.json";
+
+  /**
+   * @brief The simulated network that the tileset is loaded over.
+   */
+  ReplayNetworkOptions network;
+
+  /**
+   * @brief The simulated time between two frames, in seconds.
+   */
+  double frameDuration = 1.0 / 60.0;
+
+  /**
+   * @brief The maximum number of frames to wait, after the last frame of
+   * the camera path, for the tileset to finish loading.
+   */
+  uint32_t maximumConvergenceFrames = 36000;
+
+  /**
+   * @brief The options of the tileset.
+   */
+  Cesium3DTilesSelection::TilesetOptions tilesetOptions;
+};
+
+/**
+ * @brief What happened in one frame of a replay.
+ */
+struct ReplayFrameResult {
+  /** @brief The simulated time at the start of the frame, in seconds. */
+  double time;
+  /** @brief The real time that `Tileset::updateView` took, in seconds. */
+  double selectionTime;
+  /** @brief The number of tiles selected for rendering. */
+  uint32_t tilesRendered;
+  /** @brief The number of tiles visited by the selection. */
+  uint32_t tilesVisited;
+  /** @brief The number of tiles waiting to be loaded, at any priority. */
+  uint32_t tilesLoading;
+  /** @brief `Tileset::getTotalDataBytes` after the frame. */
+  int64_t totalDataBytes;
+  /** @brief The number of response bytes received so far. */
+  uint64_t bytesFetched;
+};
+
+/**
+ * @brief The result of {@link runReplayBenchmark}.
+ */
+struct ReplayBenchmarkResult {
+  /**
+   * @brief Every frame of the replay: first one per camera path frame, then
+   * the frames spent waiting for the tileset to finish loading.
+   */
+  std::vector<ReplayFrameResult> frames;
+
+  /** @brief The number of frames in the camera path. */
+  uint32_t pathFrameCount = 0;
+
+  /**
+   * @brief Whether the tileset finished loading within
+   * {@link ReplayBenchmarkOptions::maximumConvergenceFrames}.
+   */
+  bool converged = false;
+
+  /**
+   * @brief The number of frames after the end of the camera path until the
+   * tileset finished loading.
+   */
+  uint32_t framesToConverge = 0;
+
+  /**
+   * @brief The simulated time from the start of the replay until the
+   * tileset finished loading at the end of the camera path, in seconds.
+   */
+  double timeToConverge = 0.0;
+
+  /** @brief The number of tiles whose content finished loading. */
+  uint64_t tilesLoaded = 0;
+
+  /** @brief The number of tiles whose content was unloaded. */
+  uint64_t tilesUnloaded = 0;
+
+  /** @brief The number of requests made. */
+  uint64_t requests = 0;
+
+  /** @brief The number of requests for files that do not exist. */
+  uint64_t failedRequests = 0;
+
+  /** @brief The number of response bytes received. */
+  uint64_t bytesFetched = 0;
+
+  /** @brief The largest `Tileset::getTotalDataBytes` after any frame. */
+  int64_t peakTileDataBytes = 0;
+
+  /**
+   * @brief The peak resident memory of the process, in bytes, if the
+   * platform reports it.
+   */
+  std::optional<uint64_t> peakResidentSetBytes;
+
+  /** @brief The metrics recorded by the tileset. */
+  CesiumUtility::MetricsSnapshot metrics;
+};
+
+/**
+ * @brief Loads a tileset from a directory over a simulated network and
+ * replays a camera path over it, one `Tileset::updateView` per frame.
+ *
+ * Everything except the measured selection times is deterministic: the same
+ * inputs load the same tiles in the same frames on any machine.
+ */
+ReplayBenchmarkResult runReplayBenchmark(
+    const CameraPath& path,
+    const ReplayBenchmarkOptions& options);
+
+/**
+ * @brief Formats the options and result of a replay as JSON.
+ */
+std::string formatReplayBenchmarkResult(
+    const ReplayBenchmarkOptions& options,
+    const ReplayBenchmarkResult& result);
+
+} // namespace CesiumNativeBenchmarks
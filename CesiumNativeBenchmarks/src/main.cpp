@@ -0,0 +1,185 @@
+#include "CameraPath.h"
+#include "ReplayBenchmark.h"
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace CesiumNativeBenchmarks;
+
+namespace {
+const int64_t maximumUint32 =
+    static_cast<int64_t>(std::numeric_limits<uint32_t>::max());
+
+void printUsage(const char* program) {
+  std::cerr
+      << "Usage: " << program
+      << " --tileset <directory> --camera-path <file> [options]\n"
+         "\n"
+         "Replays a camera path over a tileset loaded from a directory over a\n"
+         "simulated network, and writes a JSON report.\n"
+         "\n"
+         "Options:\n"
+         "  --tileset-file <path>            Root tileset JSON, relative to\n"
+         "                                   the directory (tileset.json).\n"
+         "  --latency-ms <ms>                Request latency (50).\n"
+         "  --bandwidth-mbps <Mbit/s>        Link bandwidth, 0 for\n"
+         "                                   unlimited (100).\n"
+         "  --frame-ms <ms>                  Simulated frame time (16.667).\n"
+         "  --max-convergence-frames <n>     Frames to wait for loading\n"
+         "                                   after the path ends (36000).\n"
+         "  --maximum-simultaneous-tile-loads <n>\n"
+         "  --maximum-cached-bytes <bytes>\n"
+         "  --output <file>                  Write the report to a file\n"
+         "                                   instead of standard output.\n"
+         "\n"
+         "Exits with 2 if the tileset did not finish loading.\n";
+}
+
+std::optional<std::string> readTextFile(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return std::nullopt;
+  }
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+std::optional<double> parseDouble(const std::string& text) {
+  try {
+    size_t end = 0;
+    const double value = std::stod(text, &end);
+    if (end != text.size()) {
+      return std::nullopt;
+    }
+    return value;
+  } catch (const std::exception&) {
+    return std::nullopt;
+  }
+}
+
+std::optional<int64_t> parseInteger(const std::string& text) {
+  try {
+    size_t end = 0;
+    const long long value = std::stoll(text, &end);
+    if (end != text.size() || value < 0) {
+      return std::nullopt;
+    }
+    return static_cast<int64_t>(value);
+  } catch (const std::exception&) {
+    return std::nullopt;
+  }
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  ReplayBenchmarkOptions options;
+  std::string cameraPathFile;
+  std::string outputFile;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string argument = argv[i];
+    if (argument == "--help" || argument == "-h") {
+      printUsage(argv[0]);
+      return 0;
+    }
+
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << argument << ".\n";
+      printUsage(argv[0]);
+      return 1;
+    }
+    const std::string value = argv[++i];
+
+    bool valid = true;
+    if (argument == "--tileset") {
+      options.directory = value;
+    } else if (argument == "--tileset-file") {
+      options.tilesetFile = value;
+    } else if (argument == "--camera-path") {
+      cameraPathFile = value;
+    } else if (argument == "--output") {
+      outputFile = value;
+    } else if (argument == "--latency-ms") {
+      const std::optional<double> latency = parseDouble(value);
+      valid = latency && *latency >= 0.0;
+      options.network.latency = valid ? *latency / 1000.0 : 0.0;
+    } else if (argument == "--bandwidth-mbps") {
+      const std::optional<double> bandwidth = parseDouble(value);
+      valid = bandwidth && *bandwidth >= 0.0;
+      options.network.bandwidth = valid ? *bandwidth * 1.0e6 / 8.0 : 0.0;
+    } else if (argument == "--frame-ms") {
+      const std::optional<double> frameTime = parseDouble(value);
+      valid = frameTime && *frameTime > 0.0;
+      options.frameDuration = valid ? *frameTime / 1000.0 : 0.0;
+    } else if (argument == "--max-convergence-frames") {
+      const std::optional<int64_t> frames = parseInteger(value);
+      valid = frames && *frames <= maximumUint32;
+      options.maximumConvergenceFrames =
+          valid ? static_cast<uint32_t>(*frames) : 0;
+    } else if (argument == "--maximum-simultaneous-tile-loads") {
+      const std::optional<int64_t> loads = parseInteger(value);
+      valid = loads && *loads > 0 && *loads <= maximumUint32;
+      options.tilesetOptions.maximumSimultaneousTileLoads =
+          valid ? static_cast<uint32_t>(*loads) : 0;
+    } else if (argument == "--maximum-cached-bytes") {
+      const std::optional<int64_t> bytes = parseInteger(value);
+      valid = bytes.has_value();
+      options.tilesetOptions.maximumCachedBytes = valid ? *bytes : 0;
+    } else {
+      std::cerr << "Unknown option " << argument << ".\n";
+      printUsage(argv[0]);
+      return 1;
+    }
+
+    if (!valid) {
+      std::cerr << "Invalid value \"" << value << "\" for " << argument
+                << ".\n";
+      return 1;
+    }
+  }
+
+  if (options.directory.empty() || cameraPathFile.empty()) {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  const std::optional<std::string> cameraPathJson =
+      readTextFile(cameraPathFile);
+  if (!cameraPathJson) {
+    std::cerr << "Could not read " << cameraPathFile << ".\n";
+    return 1;
+  }
+
+  std::vector<std::string> errors;
+  const std::optional<CameraPath> path =
+      CameraPath::parse(*cameraPathJson, errors);
+  for (const std::string& error : errors) {
+    std::cerr << cameraPathFile << ": " << error << "\n";
+  }
+  if (!path) {
+    return 1;
+  }
+
+  const ReplayBenchmarkResult result = runReplayBenchmark(*path, options);
+  const std::string report = formatReplayBenchmarkResult(options, result);
+
+  if (outputFile.empty()) {
+    std::cout << report << std::endl;
+  } else {
+    std::ofstream output(outputFile, std::ios::binary);
+    output << report << '\n';
+    if (!output) {
+      std::cerr << "Could not write " << outputFile << ".\n";
+      return 1;
+    }
+  }
+
+  return result.converged ? 0 : 2;
+}
@@ -0,0 +1,487 @@
+#pragma once
+
+#include "JsonValue.h"
+#include "Library.h"
+
+#include <gsl/narrow>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace CesiumUtility {
+
+class FlatJsonDocument;
+
+/**
+ * @brief The type of a value in a {@link FlatJsonDocument}.
+ */
+enum class FlatJsonType : uint8_t {
+  Null,
+  Bool,
+  Double,
+  Uint64,
+  Int64,
+  String,
+  Object,
+  Array
+};
+
+/**
+ * @brief A read-only view of a value in a {@link FlatJsonDocument}.
+ *
+ * It has the same accessors as {@link JsonValue}, except that strings are
+ * returned as views into the document, and object values are looked up with
+ * {@link getValueForKey} instead of as pointers. Like {@link JsonValue}, the
+ * accessors throw `std::bad_variant_access` if the value does not have the
+ * requested type.
+ *
+ * A view is only valid while its document exists and is not modified.
+ */
+class CESIUMUTILITY_API FlatJsonValue final {
+public:
+  /**
+   * @brief Gets the type of the value.
+   */
+  [[nodiscard]] FlatJsonType getType() const noexcept;
+
+  /**
+   * @brief Returns whether this value is a `null` value.
+   */
+  [[nodiscard]] bool isNull() const noexcept {
+    return this->getType() == FlatJsonType::Null;
+  }
+
+  /**
+   * @brief Returns whether this value is a `double`, `std::uint64_t` or
+   * `std::int64_t`.
+   */
+  [[nodiscard]] bool isNumber() const noexcept {
+    return this->isDouble() || this->isUint64() || this->isInt64();
+  }
+
+  /**
+   * @brief Returns whether this value is a `Bool` value.
+   */
+  [[nodiscard]] bool isBool() const noexcept {
+    return this->getType() == FlatJsonType::Bool;
+  }
+
+  /**
+   * @brief Returns whether this value is a `String` value.
+   */
+  [[nodiscard]] bool isString() const noexcept {
+    return this->getType() == FlatJsonType::String;
+  }
+
+  /**
+   * @brief Returns whether this value is an `Object` value.
+   */
+  [[nodiscard]] bool isObject() const noexcept {
+    return this->getType() == FlatJsonType::Object;
+  }
+
+  /**
+   * @brief Returns whether this value is an `Array` value.
+   */
+  [[nodiscard]] bool isArray() const noexcept {
+    return this->getType() == FlatJsonType::Array;
+  }
+
+  /**
+   * @brief Returns whether this value is a `double` value.
+   */
+  [[nodiscard]] bool isDouble() const noexcept {
+    return this->getType() == FlatJsonType::Double;
+  }
+
+  /**
+   * @brief Returns whether this value is a `std::uint64_t` value.
+   */
+  [[nodiscard]] bool isUint64() const noexcept {
+    return this->getType() == FlatJsonType::Uint64;
+  }
+
+  /**
+   * @brief Returns whether this value is a `std::int64_t` value.
+   */
+  [[nodiscard]] bool isInt64() const noexcept {
+    return this->getType() == FlatJsonType::Int64;
+  }
+
+  /**
+   * @brief Gets the bool from the value.
+   * @throws std::bad_variant_access if the value is not a bool.
+   */
+  [[nodiscard]] bool getBool() const;
+
+  /**
+   * @brief Gets the double from the value.
+   * @throws std::bad_variant_access if the value is not a double.
+   */
+  [[nodiscard]] double getDouble() const;
+
+  /**
+   * @brief Gets the std::uint64_t from the value.
+   * @throws std::bad_variant_access if the value is not a std::uint64_t.
+   */
+  [[nodiscard]] std::uint64_t getUint64() const;
+
+  /**
+   * @brief Gets the std::int64_t from the value.
+   * @throws std::bad_variant_access if the value is not a std::int64_t.
+   */
+  [[nodiscard]] std::int64_t getInt64() const;
+
+  /**
+   * @brief Gets the string from the value.
+   * @throws std::bad_variant_access if the value is not a string.
+   */
+  [[nodiscard]] std::string_view getString() const;
+
+  /**
+   * @brief Gets the bool from the value or returns defaultValue.
+   */
+  [[nodiscard]] bool getBoolOrDefault(bool defaultValue) const noexcept {
+    return this->isBool() ? this->getBool() : defaultValue;
+  }
+
+  /**
+   * @brief Gets the double from the value or returns defaultValue.
+   */
+  [[nodiscard]] double getDoubleOrDefault(double defaultValue) const noexcept {
+    return this->isDouble() ? this->getDouble() : defaultValue;
+  }
+
+  /**
+   * @brief Gets the std::uint64_t from the value or returns defaultValue.
+   */
+  [[nodiscard]] std::uint64_t
+  getUint64OrDefault(std::uint64_t defaultValue) const noexcept {
+    return this->isUint64() ? this->getUint64() : defaultValue;
+  }
+
+  /**
+   * @brief Gets the std::int64_t from the value or returns defaultValue.
+   */
+  [[nodiscard]] std::int64_t
+  getInt64OrDefault(std::int64_t defaultValue) const noexcept {
+    return this->isInt64() ? this->getInt64() : defaultValue;
+  }
+
+  /**
+   * @brief Gets the string from the value or returns defaultValue.
+   */
+  [[nodiscard]] std::string_view
+  getStringOrDefault(std::string_view defaultValue) const noexcept {
+    return this->isString() ? this->getString() : defaultValue;
+  }
+
+  /**
+   * @brief Gets the numerical quantity from the value casted to the `To`
+   * type.
+   *
+   * @returns The converted type if it can be cast without precision loss.
+   * @throws If the underlying value is not a numerical type or it cannot be
+   *         converted without precision loss.
+   */
+  template <
+      typename To,
+      typename std::enable_if<
+          std::is_integral<To>::value ||
+          std::is_floating_point<To>::value>::type* = nullptr>
+  [[nodiscard]] To getSafeNumber() const {
+    switch (this->getType()) {
+    case FlatJsonType::Uint64:
+      return gsl::narrow<To>(this->getUint64());
+    case FlatJsonType::Int64:
+      return gsl::narrow<To>(this->getInt64());
+    case FlatJsonType::Double:
+      return gsl::narrow<To>(this->getDouble());
+    default:
+      throw JsonValueNotRealValue();
+    }
+  }
+
+  /**
+   * @brief Gets the numerical quantity from the value casted to the `To`
+   * type or returns defaultValue if unable to do so.
+   */
+  template <
+      typename To,
+      typename std::enable_if<
+          std::is_integral<To>::value ||
+          std::is_floating_point<To>::value>::type* = nullptr>
+  [[nodiscard]] To getSafeNumberOrDefault(To defaultValue) const noexcept {
+    switch (this->getType()) {
+    case FlatJsonType::Uint64:
+      return losslessNarrowOrDefault<To>(this->getUint64(), defaultValue);
+    case FlatJsonType::Int64:
+      return losslessNarrowOrDefault<To>(this->getInt64(), defaultValue);
+    case FlatJsonType::Double:
+      return losslessNarrowOrDefault<To>(this->getDouble(), defaultValue);
+    default:
+      return defaultValue;
+    }
+  }
+
+  /**
+   * @brief Gets the value corresponding to the given key in the object
+   * represented by this instance.
+   *
+   * If the object has the key more than once, the last value is returned, in
+   * the same way that {@link JsonValue} keeps the last value.
+   *
+   * @param key The key.
+   * @return The value, or `std::nullopt` if this instance is not an object or
+   * does not contain the key.
+   */
+  [[nodiscard]] std::optional<FlatJsonValue>
+  getValueForKey(std::string_view key) const noexcept;
+
+  /**
+   * @brief Determines if this value is an Object and has the given key.
+   */
+  [[nodiscard]] bool hasKey(std::string_view key) const noexcept {
+    return this->getValueForKey(key).has_value();
+  }
+
+  /**
+   * @brief Converts the numerical value corresponding to the given key
+   * to the provided numerical template type.
+   *
+   * @throws std::bad_variant_access if this instance is not an object,
+   * `JsonValueMissingKey` if the key does not exist in this object, and the
+   * exceptions of {@link getSafeNumber} if the value cannot be converted.
+   */
+  template <
+      typename To,
+      typename std::enable_if<
+          std::is_integral<To>::value ||
+          std::is_floating_point<To>::value>::type* = nullptr>
+  [[nodiscard]] To getSafeNumericalValueForKey(std::string_view key) const {
+    if (!this->isObject()) {
+      throw std::bad_variant_access();
+    }
+    const std::optional<FlatJsonValue> value = this->getValueForKey(key);
+    if (!value) {
+      throw JsonValueMissingKey(std::string(key));
+    }
+    return value->getSafeNumber<To>();
+  }
+
+  /**
+   * @brief Converts the numerical value corresponding to the given key
+   * to the provided numerical template type, or returns the default value if
+   * this is not possible.
+   */
+  template <
+      typename To,
+      typename std::enable_if<
+          std::is_integral<To>::value ||
+          std::is_floating_point<To>::value>::type* = nullptr>
+  [[nodiscard]] To getSafeNumericalValueOrDefaultForKey(
+      std::string_view key,
+      To defaultValue) const noexcept {
+    const std::optional<FlatJsonValue> value = this->getValueForKey(key);
+    if (!value) {
+      return defaultValue;
+    }
+    return value->getSafeNumberOrDefault<To>(defaultValue);
+  }
+
+  /**
+   * @brief Gets the number of elements of an array, or of members of an
+   * object, or 0 for any other value.
+   */
+  [[nodiscard]] size_t size() const noexcept;
+
+  /**
+   * @brief Calls a callback with each element of an array, in order.
+   *
+   * Nothing is called if this value is not an array.
+   *
+   * @param callback The callback, taking a `FlatJsonValue`.
+   */
+  template <typename Callback> void forEachElement(Callback&& callback) const {
+    if (!this->isArray()) {
+      return;
+    }
+    size_t index = this->_index + 1;
+    for (size_t i = 0; i < this->size(); ++i) {
+      const FlatJsonValue element(this->_pDocument, index);
+      callback(element);
+      index = element.getEnd();
+    }
+  }
+
+  /**
+   * @brief Calls a callback with the key and value of each member of an
+   * object, in order.
+   *
+   * Nothing is called if this value is not an object.
+   *
+   * @param callback The callback, taking a `std::string_view` key and a
+   * `FlatJsonValue`.
+   */
+  template <typename Callback> void forEachMember(Callback&& callback) const {
+    if (!this->isObject()) {
+      return;
+    }
+    size_t index = this->_index + 1;
+    for (size_t i = 0; i < this->size(); ++i) {
+      const FlatJsonValue key(this->_pDocument, index);
+      const FlatJsonValue value(this->_pDocument, index + 1);
+      callback(key.getString(), value);
+      index = value.getEnd();
+    }
+  }
+
+  /**
+   * @brief Copies this value to a {@link JsonValue}.
+   */
+  [[nodiscard]] JsonValue toJsonValue() const;
+
+private:
+  FlatJsonValue(const FlatJsonDocument* pDocument, size_t index) noexcept
+      : _pDocument(pDocument), _index(index) {}
+
+  // The index of the node after this value and all of its descendants.
+  size_t getEnd() const noexcept;
+
+  const FlatJsonDocument* _pDocument;
+  size_t _index;
+
+  friend class FlatJsonDocument;
+};
+
+/**
+ * @brief A compact representation of a JSON value, as an alternative to
+ * {@link JsonValue} for large `extras` and extensions.
+ *
+ * A {@link JsonValue} allocates a node on the heap for every object member,
+ * and a vector for every array. A `FlatJsonDocument` stores all values in a
+ * single array, in the order they appear in the JSON, and the characters of
+ * all strings and keys in a single buffer. Each array and object knows where
+ * its descendants end, so they can be skipped without being visited.
+ *
+ * A document is built once, either by appending values in document order,
+ * as {@link CesiumJsonReader::JsonObjectJsonHandler} does, or by copying a
+ * {@link JsonValue}, and is then read with {@link getRoot}. Looking up a key
+ * visits the members of the object in order, which is fast for the small
+ * objects that are typical of `extras`.
+ */
+class CESIUMUTILITY_API FlatJsonDocument final {
+public:
+  /**
+   * @brief Creates an empty document, whose root is `null`.
+   */
+  FlatJsonDocument() noexcept = default;
+
+  /**
+   * @brief Creates a document with a copy of a {@link JsonValue}.
+   */
+  explicit FlatJsonDocument(const JsonValue& value);
+
+  /**
+   * @brief Gets the root value of the document.
+   */
+  [[nodiscard]] FlatJsonValue getRoot() const noexcept {
+    return FlatJsonValue(this, 0);
+  }
+
+  /**
+   * @brief Gets the number of bytes of memory used by this document.
+   */
+  [[nodiscard]] int64_t getSizeBytes() const noexcept;
+
+  /**
+   * @brief Appends a `null` value.
+   */
+  void addNull();
+
+  /**
+   * @brief Appends a `Bool` value.
+   */
+  void addBool(bool value);
+
+  /**
+   * @brief Appends a `double` value.
+   *
+   * NaN and ±Infinity are represented as `null`, like in {@link JsonValue}.
+   */
+  void addDouble(double value);
+
+  /**
+   * @brief Appends a `std::uint64_t` value.
+   */
+  void addUint64(std::uint64_t value);
+
+  /**
+   * @brief Appends a `std::int64_t` value.
+   */
+  void addInt64(std::int64_t value);
+
+  /**
+   * @brief Appends a `String` value.
+   */
+  void addString(std::string_view value);
+
+  /**
+   * @brief Starts an `Object` value. Each of its members is appended as a key
+   * followed by a value, until {@link endObject} is called.
+   */
+  void startObject();
+
+  /**
+   * @brief Appends the key of the next member of the current object.
+   */
+  void addKey(std::string_view key);
+
+  /**
+   * @brief Ends the current object.
+   */
+  void endObject();
+
+  /**
+   * @brief Starts an `Array` value. Its elements are appended until
+   * {@link endArray} is called.
+   */
+  void startArray();
+
+  /**
+   * @brief Ends the current array.
+   */
+  void endArray();
+
+private:
+  struct Node {
+    FlatJsonType type;
+
+    // The length of a string, or the number of elements or members of an
+    // array or object.
+    uint32_t count;
+
+    // The bits of a number or bool, the offset of the characters of a string,
+    // or the index of the node after the last descendant of an array or
+    // object.
+    uint64_t payload;
+  };
+
+  Node& addNode(FlatJsonType type, uint64_t payload);
+  void endContainer(FlatJsonType type);
+  void addValue(const JsonValue& value);
+
+  std::vector<Node> _nodes;
+  std::string _characters;
+  std::vector<size_t> _openContainers;
+
+  friend class FlatJsonValue;
+};
+
+} // namespace CesiumUtility
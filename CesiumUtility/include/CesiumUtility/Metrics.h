@@ -0,0 +1,343 @@
+#pragma once
+
+#include "Library.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace CesiumUtility {
+
+/**
+ * @brief The labels of a metric, as name-value pairs.
+ *
+ * Metrics with the same name but different labels are separate time series,
+ * such as the request latency of cache hits and cache misses.
+ */
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief A count of events that only ever increases.
+ *
+ * All methods are thread-safe and lock-free.
+ */
+class CESIUMUTILITY_API MetricsCounter final {
+public:
+  MetricsCounter() noexcept : _value(0) {}
+
+  /**
+   * @brief Adds to the count.
+   */
+  void increment(uint64_t amount = 1) noexcept {
+    this->_value.fetch_add(amount, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Gets the count.
+   */
+  uint64_t getValue() const noexcept {
+    return this->_value.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<uint64_t> _value;
+};
+
+/**
+ * @brief A value that may go up and down, such as a number of bytes in use.
+ *
+ * All methods are thread-safe and lock-free.
+ */
+class CESIUMUTILITY_API MetricsGauge final {
+public:
+  MetricsGauge() noexcept : _value(0) {}
+
+  /**
+   * @brief Adds to the value. The amount may be negative.
+   *
+   * When several sources share a gauge, each of them should only add the
+   * changes it makes, rather than {@link set} the value.
+   */
+  void add(int64_t amount) noexcept {
+    this->_value.fetch_add(amount, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Sets the value.
+   */
+  void set(int64_t value) noexcept {
+    this->_value.store(value, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Gets the value.
+   */
+  int64_t getValue() const noexcept {
+    return this->_value.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<int64_t> _value;
+};
+
+/**
+ * @brief A distribution of durations, recorded with a fixed relative
+ * precision.
+ *
+ * Durations are recorded in whole microseconds into log-linear buckets, in
+ * the manner of an HDR histogram: each power of two is divided into
+ * {@link SubBucketCount} equal buckets, so a quantile is reported within
+ * 12.5% of the true value no matter how large it is. Recording is a few
+ * relaxed atomic increments and never allocates or takes a lock, so it is
+ * cheap enough for every request and every tile.
+ */
+class CESIUMUTILITY_API LatencyHistogram final {
+public:
+  /**
+   * @brief The number of buckets each power of two is divided into.
+   */
+  static constexpr uint64_t SubBucketCount = 8;
+
+  /**
+   * @brief The total number of buckets, which covers every `uint64_t`.
+   */
+  static constexpr size_t BucketCount = 496;
+
+  LatencyHistogram() noexcept;
+
+  /**
+   * @brief Records a duration.
+   *
+   * Negative durations are recorded as zero.
+   */
+  void record(std::chrono::steady_clock::duration duration) noexcept;
+
+  /**
+   * @brief Records a duration in microseconds.
+   */
+  void recordMicroseconds(uint64_t microseconds) noexcept;
+
+  /**
+   * @brief Gets the number of durations recorded.
+   */
+  uint64_t getCount() const noexcept {
+    return this->_count.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Gets the sum of the durations recorded, in microseconds.
+   */
+  uint64_t getSumMicroseconds() const noexcept {
+    return this->_sum.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Gets the longest duration recorded, in microseconds.
+   */
+  uint64_t getMaximumMicroseconds() const noexcept {
+    return this->_maximum.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Estimates the duration, in microseconds, below which the given
+   * fraction of the recorded durations fall.
+   *
+   * The estimate is the upper end of the bucket holding the quantile, limited
+   * to the longest duration recorded, so it is never less than the true value.
+   *
+   * @param quantile The quantile, from 0.0 to 1.0.
+   * @return The estimate, or 0 if nothing has been recorded.
+   */
+  uint64_t getQuantileMicroseconds(double quantile) const noexcept;
+
+  /**
+   * @brief Gets the index of the bucket that a duration in microseconds is
+   * recorded in.
+   */
+  static size_t getBucketIndex(uint64_t microseconds) noexcept;
+
+  /**
+   * @brief Gets the largest duration in microseconds that is recorded in a
+   * bucket.
+   */
+  static uint64_t getBucketUpperBound(size_t index) noexcept;
+
+private:
+  std::array<std::atomic<uint64_t>, BucketCount> _buckets;
+  std::atomic<uint64_t> _count;
+  std::atomic<uint64_t> _sum;
+  std::atomic<uint64_t> _maximum;
+};
+
+/**
+ * @brief The values of all the metrics in a {@link MetricsRegistry} at one
+ * point in time.
+ *
+ * Within each kind of metric, the samples are sorted by name and then by
+ * labels.
+ */
+struct CESIUMUTILITY_API MetricsSnapshot {
+  /**
+   * @brief The value of a {@link MetricsCounter}.
+   */
+  struct Counter {
+    /** @brief The name of the metric. */
+    std::string name;
+    /** @brief The description of the metric. */
+    std::string help;
+    /** @brief The labels of the metric. */
+    MetricLabels labels;
+    /** @brief The count. */
+    uint64_t value;
+  };
+
+  /**
+   * @brief The value of a {@link MetricsGauge}.
+   */
+  struct Gauge {
+    /** @brief The name of the metric. */
+    std::string name;
+    /** @brief The description of the metric. */
+    std::string help;
+    /** @brief The labels of the metric. */
+    MetricLabels labels;
+    /** @brief The value. */
+    int64_t value;
+  };
+
+  /**
+   * @brief A summary of a {@link LatencyHistogram}. All durations are in
+   * microseconds.
+   */
+  struct Histogram {
+    /** @brief The name of the metric. */
+    std::string name;
+    /** @brief The description of the metric. */
+    std::string help;
+    /** @brief The labels of the metric. */
+    MetricLabels labels;
+    /** @brief The number of durations recorded. */
+    uint64_t count;
+    /** @brief The sum of the durations recorded. */
+    uint64_t sum;
+    /** @brief The longest duration recorded. */
+    uint64_t maximum;
+    /** @brief The median duration. */
+    uint64_t p50;
+    /** @brief The 90th percentile duration. */
+    uint64_t p90;
+    /** @brief The 99th percentile duration. */
+    uint64_t p99;
+  };
+
+  /** @brief The values of the counters. */
+  std::vector<Counter> counters;
+
+  /** @brief The values of the gauges. */
+  std::vector<Gauge> gauges;
+
+  /** @brief The summaries of the histograms. */
+  std::vector<Histogram> histograms;
+
+  /**
+   * @brief Formats the snapshot in the Prometheus text exposition format.
+   *
+   * Counters and gauges are written as such, and histograms are written as
+   * summaries with 0.5, 0.9 and 0.99 quantiles, converted to seconds.
+   */
+  std::string toPrometheusText() const;
+};
+
+/**
+ * @brief A thread-safe collection of named metrics.
+ *
+ * Metrics are created the first time they are requested and live as long as
+ * the registry, so callers may keep the returned references and update them
+ * without looking them up again. Looking up a metric takes a lock; updating
+ * one does not.
+ *
+ * By convention, names use the Prometheus style, such as
+ * `cesium_tiles_evicted_total`, and a name is only used for one kind of
+ * metric.
+ */
+class CESIUMUTILITY_API MetricsRegistry final {
+public:
+  MetricsRegistry();
+  ~MetricsRegistry() noexcept;
+
+  MetricsRegistry(const MetricsRegistry&) = delete;
+  MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+  /**
+   * @brief Gets a counter, creating it if it does not exist yet.
+   *
+   * @param name The name of the metric.
+   * @param help A description of the metric. Only the description given when
+   * the metric is created is kept.
+   * @param labels The labels of the metric.
+   */
+  MetricsCounter& getCounter(
+      const std::string& name,
+      const std::string& help,
+      const MetricLabels& labels = {});
+
+  /**
+   * @brief Gets a gauge, creating it if it does not exist yet.
+   *
+   * @copydetails getCounter
+   */
+  MetricsGauge& getGauge(
+      const std::string& name,
+      const std::string& help,
+      const MetricLabels& labels = {});
+
+  /**
+   * @brief Gets a histogram, creating it if it does not exist yet.
+   *
+   * @copydetails getCounter
+   */
+  LatencyHistogram& getHistogram(
+      const std::string& name,
+      const std::string& help,
+      const MetricLabels& labels = {});
+
+  /**
+   * @brief Reads the current value of every metric.
+   *
+   * Each value is read atomically, but the snapshot as a whole is not, so
+   * metrics that are updated while it is taken may be slightly inconsistent
+   * with each other.
+   */
+  MetricsSnapshot snapshot() const;
+
+private:
+  template <typename T> struct Entry {
+    std::string help;
+    std::unique_ptr<T> pMetric;
+  };
+
+  template <typename T>
+  using EntryMap = std::map<std::pair<std::string, MetricLabels>, Entry<T>>;
+
+  template <typename T>
+  T& getOrCreate(
+      EntryMap<T>& entries,
+      const std::string& name,
+      const std::string& help,
+      const MetricLabels& labels);
+
+  mutable std::mutex _mutex;
+  EntryMap<MetricsCounter> _counters;
+  EntryMap<MetricsGauge> _gauges;
+  EntryMap<LatencyHistogram> _histograms;
+};
+
+} // namespace CesiumUtility
@@ -9,7 +9,9 @@
 #if !CESIUM_TRACING_ENABLED
 
 #define CESIUM_TRACE_INIT(filename)
+#define CESIUM_TRACE_INIT_BINARY(filename)
 #define CESIUM_TRACE_SHUTDOWN()
+#define CESIUM_TRACE_SET_ENABLED(enabled)
 #define CESIUM_TRACE(name)
 #define CESIUM_TRACE_BEGIN(name)
 #define CESIUM_TRACE_END(name)
@@ -24,11 +26,17 @@
 
 #include <atomic>
 #include <cassert>
-#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <fstream>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 // helper macros to avoid shadowing variables
@@ -39,17 +47,47 @@
  * @brief Initializes the tracing framework and begins recording to a given JSON
  * filename.
  *
+ * Events are recorded into a buffer for each thread without taking a lock,
+ * and a background thread writes them to the file in the Chrome trace event
+ * format.
+ *
  * @param filename The path and named of the file in which to record traces.
  */
 #define CESIUM_TRACE_INIT(filename)                                            \
   CesiumUtility::Impl::Tracer::instance().startTracing(filename)
 
 /**
- * @brief Shuts down tracing and closes the JSON tracing file.
+ * @brief Initializes the tracing framework and begins recording to a given
+ * file in a compact binary format.
+ *
+ * See {@link CesiumUtility::Impl::TraceFormat::Binary} for the layout of the
+ * file.
+ *
+ * @param filename The path and named of the file in which to record traces.
+ */
+#define CESIUM_TRACE_INIT_BINARY(filename)                                     \
+  CesiumUtility::Impl::Tracer::instance().startTracing(                        \
+      filename,                                                                \
+      CesiumUtility::Impl::TraceFormat::Binary)
+
+/**
+ * @brief Shuts down tracing, writes any remaining events and closes the
+ * tracing file.
  */
 #define CESIUM_TRACE_SHUTDOWN()                                                \
   CesiumUtility::Impl::Tracer::instance().endTracing()
 
+/**
+ * @brief Pauses or resumes recording while tracing.
+ *
+ * While recording is paused, each tracing macro costs a single branch and its
+ * name argument is not evaluated.
+ *
+ * @param enabled Whether to record events.
+ */
+#define CESIUM_TRACE_SET_ENABLED(enabled)                                      \
+  CesiumUtility::Impl::Tracer::setEnabled(enabled)
+
 /**
  * @brief Measures and records the time spent in the current scope.
  *
@@ -61,7 +99,10 @@
  * @param name The name of the measured operation.
  */
 #define CESIUM_TRACE(name)                                                     \
-  CesiumUtility::Impl::ScopedTrace TRACE_NAME_AUX2(cesiumTrace, __LINE__)(name)
+  CesiumUtility::Impl::ScopedTrace TRACE_NAME_AUX2(cesiumTrace, __LINE__)(     \
+      CesiumUtility::Impl::Tracer::isEnabled()                                 \
+          ? CesiumUtility::Impl::Tracer::instance().internName(name)           \
+          : CesiumUtility::Impl::ScopedTrace::DISABLED)
 
 /**
  * @brief Begins measuring an operation which may span scope but not threads.
@@ -95,7 +136,9 @@
  * @param name The name of the measured operation.
  */
 #define CESIUM_TRACE_BEGIN(name)                                               \
-  CesiumUtility::Impl::Tracer::instance().writeAsyncEventBegin(name)
+  (CesiumUtility::Impl::Tracer::isEnabled()                                    \
+       ? CesiumUtility::Impl::Tracer::instance().writeAsyncEventBegin(name)    \
+       : void())
 
 /**
  * @brief Ends measuring an operation which may span scopes but not threads.
@@ -107,7 +150,9 @@
  * @param name The name of the measured operation.
  */
 #define CESIUM_TRACE_END(name)                                                 \
-  CesiumUtility::Impl::Tracer::instance().writeAsyncEventEnd(name)
+  (CesiumUtility::Impl::Tracer::isEnabled()                                    \
+       ? CesiumUtility::Impl::Tracer::instance().writeAsyncEventEnd(name)      \
+       : void())
 
 /**
  * @brief Begins measuring an operation that may span both scopes and threads.
@@ -120,8 +165,9 @@
  * @param name The name of the measured operation.
  */
 #define CESIUM_TRACE_BEGIN_IN_TRACK(name)                                      \
-  if (CesiumUtility::Impl::TrackReference::current() != nullptr) {             \
-    CESIUM_TRACE_BEGIN(name);                                                  \
+  if (CesiumUtility::Impl::Tracer::isEnabled() &&                              \
+      CesiumUtility::Impl::TrackReference::current() != nullptr) {             \
+    CesiumUtility::Impl::Tracer::instance().writeAsyncEventBegin(name);        \
   }
 
 /**
@@ -135,8 +181,9 @@
  * @param name The name of the measured operation.
  */
 #define CESIUM_TRACE_END_IN_TRACK(name)                                        \
-  if (CesiumUtility::Impl::TrackReference::current() != nullptr) {             \
-    CESIUM_TRACE_END(name);                                                    \
+  if (CesiumUtility::Impl::Tracer::isEnabled() &&                              \
+      CesiumUtility::Impl::TrackReference::current() != nullptr) {             \
+    CesiumUtility::Impl::Tracer::instance().writeAsyncEventEnd(name);          \
   }
 
 /**
@@ -200,25 +247,75 @@ namespace Impl {
 // The following are internal classes used by the tracing framework, do not use
 // directly.
 
-struct Trace {
-  std::string name;
-  int64_t start;
-  int64_t duration;
-  std::thread::id threadID;
-};
-
+struct TraceEvent;
+class TraceRingBuffer;
 class TrackReference;
 
+/**
+ * @brief The format of a trace file.
+ */
+enum class TraceFormat {
+  /**
+   * @brief The JSON Object Format of the Chrome trace event format, which can
+   * be opened in `chrome://tracing` or Perfetto.
+   */
+  ChromeJson,
+
+  /**
+   * @brief A compact binary format.
+   *
+   * The file starts with the 12 bytes `CESIUMTRACE1`, followed by records
+   * that each start with a one-byte tag. Integers are in the byte order of the
+   * machine that wrote the file.
+   *
+   *   * `N`: a name, followed by its `uint32_t` ID, its `uint32_t` length in
+   *     bytes and its characters. Each name is written before the first event
+   *     that uses it.
+   *   * `X`, `B`, `E`, `b` or `e`: an event with that Chrome trace event
+   *     phase, followed by the `uint32_t` index of the thread, the `uint32_t`
+   *     ID of its name, its `int64_t` timestamp in microseconds and an
+   *     `int64_t` that is the duration of an `X` event or the track ID of a
+   *     `b` or `e` event.
+   *   * `D`: the end of the file, followed by the `uint64_t` number of events
+   *     that were dropped because a thread's buffer was full.
+   */
+  Binary
+};
+
 class Tracer {
 public:
+  /**
+   * @brief The maximum number of distinct names that are interned.
+   *
+   * Once this many names are interned, events with any other name are
+   * recorded under a single shared name, so that names built from per-tile
+   * data cannot grow the name tables without bound.
+   */
+  static constexpr uint32_t MAX_NAMES = 4096;
+
+  /**
+   * @brief The name of events whose own name did not fit in the table.
+   */
+  static constexpr const char* OVERFLOW_NAME = "(other)";
+
   static Tracer& instance();
 
+  static bool isEnabled() noexcept {
+    return Tracer::_enabled.load(std::memory_order_relaxed);
+  }
+
+  static void setEnabled(bool enabled) noexcept;
+
   ~Tracer();
 
-  void startTracing(const std::string& filePath = "trace.json");
+  void startTracing(
+      const std::string& filePath = "trace.json",
+      TraceFormat format = TraceFormat::ChromeJson);
   void endTracing();
 
-  void writeCompleteEvent(const Trace& trace);
+  uint32_t internName(std::string_view name);
+
+  void writeCompleteEvent(uint32_t nameID, int64_t start, int64_t duration);
   void writeAsyncEventBegin(const char* name, int64_t id);
   void writeAsyncEventBegin(const char* name);
   void writeAsyncEventEnd(const char* name, int64_t id);
@@ -230,21 +327,47 @@ private:
   Tracer();
 
   int64_t getCurrentThreadTrackID() const;
-  void writeAsyncEvent(
-      const char* category,
-      const char* name,
-      char type,
-      int64_t id);
+  void writeAsyncEvent(uint32_t nameID, char type, int64_t id);
+  void record(const TraceEvent& event);
+  TraceRingBuffer& getCurrentThreadBuffer();
+  void runFlusher();
+  void flush();
 
+  static std::atomic<bool> _enabled;
+
+  // Interned names, at most MAX_NAMES of them. The first is OVERFLOW_NAME.
+  // The deque does not move its strings, so the map's keys stay valid.
+  std::mutex _namesLock;
+  std::deque<std::string> _names;
+  std::unordered_map<std::string_view, uint32_t> _nameIDs;
+
+  std::mutex _buffersLock;
+  std::vector<std::shared_ptr<TraceRingBuffer>> _buffers;
+  uint32_t _nextThreadIndex;
+
+  // Only used by the flushing thread, or while it is not running.
   std::ofstream _output;
-  uint32_t _numTraces;
-  std::mutex _lock;
+  TraceFormat _format;
+  uint64_t _numTraces;
+  uint64_t _droppedEvents;
+  std::vector<std::string> _flushedNames;
+  std::string _flushBuffer;
+
+  std::thread _flusher;
+  std::mutex _flusherLock;
+  std::condition_variable _flusherCondition;
+  bool _stopFlusher;
+
   std::atomic<int64_t> _lastAllocatedID;
+
+  friend class ScopedTrace;
 };
 
 class ScopedTrace {
 public:
-  explicit ScopedTrace(const std::string& message);
+  static constexpr uint32_t DISABLED = std::numeric_limits<uint32_t>::max();
+
+  explicit ScopedTrace(uint32_t nameID);
   ~ScopedTrace();
 
   void reset();
@@ -255,10 +378,8 @@ public:
   ScopedTrace& operator=(ScopedTrace&& rhs) = delete;
 
 private:
-  std::string _name;
-  std::chrono::steady_clock::time_point _startTime;
-  std::thread::id _threadId;
-  bool _reset;
+  uint32_t _nameID;
+  int64_t _startTime;
 };
 
 class TrackSet {
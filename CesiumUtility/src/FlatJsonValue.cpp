@@ -0,0 +1,249 @@
+#include "CesiumUtility/FlatJsonValue.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace CesiumUtility {
+
+FlatJsonType FlatJsonValue::getType() const noexcept {
+  if (this->_index >= this->_pDocument->_nodes.size()) {
+    return FlatJsonType::Null;
+  }
+  return this->_pDocument->_nodes[this->_index].type;
+}
+
+bool FlatJsonValue::getBool() const {
+  if (!this->isBool()) {
+    throw std::bad_variant_access();
+  }
+  return this->_pDocument->_nodes[this->_index].payload != 0;
+}
+
+double FlatJsonValue::getDouble() const {
+  if (!this->isDouble()) {
+    throw std::bad_variant_access();
+  }
+  double value;
+  std::memcpy(
+      &value,
+      &this->_pDocument->_nodes[this->_index].payload,
+      sizeof(double));
+  return value;
+}
+
+std::uint64_t FlatJsonValue::getUint64() const {
+  if (!this->isUint64()) {
+    throw std::bad_variant_access();
+  }
+  return this->_pDocument->_nodes[this->_index].payload;
+}
+
+std::int64_t FlatJsonValue::getInt64() const {
+  if (!this->isInt64()) {
+    throw std::bad_variant_access();
+  }
+  return static_cast<std::int64_t>(
+      this->_pDocument->_nodes[this->_index].payload);
+}
+
+std::string_view FlatJsonValue::getString() const {
+  if (!this->isString()) {
+    throw std::bad_variant_access();
+  }
+  const FlatJsonDocument::Node& node = this->_pDocument->_nodes[this->_index];
+  return std::string_view(
+      this->_pDocument->_characters.data() + node.payload,
+      node.count);
+}
+
+std::optional<FlatJsonValue>
+FlatJsonValue::getValueForKey(std::string_view key) const noexcept {
+  std::optional<FlatJsonValue> result;
+  this->forEachMember(
+      [&result, key](std::string_view memberKey, const FlatJsonValue& value) {
+        if (memberKey == key) {
+          result = value;
+        }
+      });
+  return result;
+}
+
+size_t FlatJsonValue::size() const noexcept {
+  switch (this->getType()) {
+  case FlatJsonType::Object:
+  case FlatJsonType::Array:
+    return this->_pDocument->_nodes[this->_index].count;
+  default:
+    return 0;
+  }
+}
+
+JsonValue FlatJsonValue::toJsonValue() const {
+  switch (this->getType()) {
+  case FlatJsonType::Bool:
+    return JsonValue(this->getBool());
+  case FlatJsonType::Double:
+    return JsonValue(this->getDouble());
+  case FlatJsonType::Uint64:
+    return JsonValue(this->getUint64());
+  case FlatJsonType::Int64:
+    return JsonValue(this->getInt64());
+  case FlatJsonType::String:
+    return JsonValue(std::string(this->getString()));
+  case FlatJsonType::Object: {
+    JsonValue::Object object;
+    this->forEachMember(
+        [&object](std::string_view key, const FlatJsonValue& value) {
+          object.insert_or_assign(std::string(key), value.toJsonValue());
+        });
+    return JsonValue(std::move(object));
+  }
+  case FlatJsonType::Array: {
+    JsonValue::Array array;
+    array.reserve(this->size());
+    this->forEachElement([&array](const FlatJsonValue& element) {
+      array.emplace_back(element.toJsonValue());
+    });
+    return JsonValue(std::move(array));
+  }
+  default:
+    return JsonValue(nullptr);
+  }
+}
+
+size_t FlatJsonValue::getEnd() const noexcept {
+  switch (this->getType()) {
+  case FlatJsonType::Object:
+  case FlatJsonType::Array:
+    return static_cast<size_t>(
+        this->_pDocument->_nodes[this->_index].payload);
+  default:
+    return this->_index + 1;
+  }
+}
+
+FlatJsonDocument::FlatJsonDocument(const JsonValue& value) {
+  this->addValue(value);
+}
+
+int64_t FlatJsonDocument::getSizeBytes() const noexcept {
+  return static_cast<int64_t>(
+      sizeof(FlatJsonDocument) + this->_nodes.capacity() * sizeof(Node) +
+      this->_characters.capacity() +
+      this->_openContainers.capacity() * sizeof(size_t));
+}
+
+void FlatJsonDocument::addNull() { this->addNode(FlatJsonType::Null, 0); }
+
+void FlatJsonDocument::addBool(bool value) {
+  this->addNode(FlatJsonType::Bool, value ? 1 : 0);
+}
+
+void FlatJsonDocument::addDouble(double value) {
+  if (std::isnan(value) || std::isinf(value)) {
+    this->addNull();
+    return;
+  }
+
+  uint64_t payload;
+  std::memcpy(&payload, &value, sizeof(double));
+  this->addNode(FlatJsonType::Double, payload);
+}
+
+void FlatJsonDocument::addUint64(std::uint64_t value) {
+  this->addNode(FlatJsonType::Uint64, value);
+}
+
+void FlatJsonDocument::addInt64(std::int64_t value) {
+  this->addNode(FlatJsonType::Int64, static_cast<uint64_t>(value));
+}
+
+void FlatJsonDocument::addString(std::string_view value) {
+  assert(value.size() <= std::numeric_limits<uint32_t>::max());
+  Node& node = this->addNode(FlatJsonType::String, this->_characters.size());
+  node.count = static_cast<uint32_t>(value.size());
+  this->_characters.append(value);
+}
+
+void FlatJsonDocument::startObject() {
+  this->addNode(FlatJsonType::Object, 0);
+  this->_openContainers.push_back(this->_nodes.size() - 1);
+}
+
+void FlatJsonDocument::addKey(std::string_view key) {
+  assert(!this->_openContainers.empty());
+  Node& object = this->_nodes[this->_openContainers.back()];
+  assert(object.type == FlatJsonType::Object);
+  ++object.count;
+
+  // Keys are stored as strings in front of their values. Keys are not
+  // counted as elements, because the current container is an object.
+  this->addString(key);
+}
+
+void FlatJsonDocument::endObject() { this->endContainer(FlatJsonType::Object); }
+
+void FlatJsonDocument::startArray() {
+  this->addNode(FlatJsonType::Array, 0);
+  this->_openContainers.push_back(this->_nodes.size() - 1);
+}
+
+void FlatJsonDocument::endArray() { this->endContainer(FlatJsonType::Array); }
+
+FlatJsonDocument::Node&
+FlatJsonDocument::addNode(FlatJsonType type, uint64_t payload) {
+  assert(
+      (!this->_openContainers.empty() || this->_nodes.empty()) &&
+      "A document has a single root value");
+
+  if (!this->_openContainers.empty()) {
+    Node& container = this->_nodes[this->_openContainers.back()];
+    if (container.type == FlatJsonType::Array) {
+      ++container.count;
+    }
+  }
+
+  return this->_nodes.emplace_back(Node{type, 0, payload});
+}
+
+void FlatJsonDocument::endContainer([[maybe_unused]] FlatJsonType type) {
+  assert(!this->_openContainers.empty());
+  Node& container = this->_nodes[this->_openContainers.back()];
+  assert(container.type == type);
+  container.payload = this->_nodes.size();
+  this->_openContainers.pop_back();
+}
+
+void FlatJsonDocument::addValue(const JsonValue& value) {
+  struct Visitor {
+    FlatJsonDocument& document;
+
+    void operator()(JsonValue::Null) { document.addNull(); }
+    void operator()(double v) { document.addDouble(v); }
+    void operator()(std::uint64_t v) { document.addUint64(v); }
+    void operator()(std::int64_t v) { document.addInt64(v); }
+    void operator()(JsonValue::Bool v) { document.addBool(v); }
+    void operator()(const JsonValue::String& v) { document.addString(v); }
+    void operator()(const JsonValue::Object& v) {
+      document.startObject();
+      for (const auto& [key, member] : v) {
+        document.addKey(key);
+        document.addValue(member);
+      }
+      document.endObject();
+    }
+    void operator()(const JsonValue::Array& v) {
+      document.startArray();
+      for (const JsonValue& element : v) {
+        document.addValue(element);
+      }
+      document.endArray();
+    }
+  };
+
+  std::visit(Visitor{*this}, value.value);
+}
+
+} // namespace CesiumUtility
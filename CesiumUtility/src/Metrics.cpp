@@ -0,0 +1,321 @@
+#include "CesiumUtility/Metrics.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace CesiumUtility {
+
+namespace {
+// The number of bits of a value that select its sub-bucket, log2 of
+// LatencyHistogram::SubBucketCount.
+constexpr uint32_t subBucketBits = 3;
+
+uint32_t floorLog2(uint64_t value) noexcept {
+  uint32_t result = 0;
+  for (uint32_t shift = 32; shift > 0; shift /= 2) {
+    if (value >> shift) {
+      value >>= shift;
+      result += shift;
+    }
+  }
+  return result;
+}
+
+void appendEscaped(std::string& out, const std::string& value, bool quoted) {
+  for (const char c : value) {
+    if (c == '\\') {
+      out += "\\\\";
+    } else if (c == '\n') {
+      out += "\\n";
+    } else if (c == '"' && quoted) {
+      out += "\\\"";
+    } else {
+      out += c;
+    }
+  }
+}
+
+void appendSeries(
+    std::string& out,
+    const std::string& name,
+    const MetricLabels& labels,
+    const std::pair<std::string, std::string>* pExtraLabel = nullptr) {
+  out += name;
+  if (labels.empty() && !pExtraLabel) {
+    return;
+  }
+
+  const auto appendLabel =
+      [&out](const std::pair<std::string, std::string>& label) {
+        out += label.first;
+        out += "=\"";
+        appendEscaped(out, label.second, true);
+        out += '"';
+      };
+
+  out += '{';
+  for (size_t i = 0; i < labels.size(); ++i) {
+    if (i > 0) {
+      out += ',';
+    }
+    appendLabel(labels[i]);
+  }
+  if (pExtraLabel) {
+    if (!labels.empty()) {
+      out += ',';
+    }
+    appendLabel(*pExtraLabel);
+  }
+  out += '}';
+}
+
+void appendHeader(
+    std::string& out,
+    const std::string*& pLastName,
+    const std::string& name,
+    const std::string& help,
+    const char* type) {
+  if (pLastName && *pLastName == name) {
+    return;
+  }
+  pLastName = &name;
+
+  out += "# HELP ";
+  out += name;
+  out += ' ';
+  appendEscaped(out, help, false);
+  out += "\n# TYPE ";
+  out += name;
+  out += ' ';
+  out += type;
+  out += '\n';
+}
+
+// Formats microseconds as seconds without going through floating point, so
+// the output is exact and does not depend on the locale.
+std::string microsecondsToSeconds(uint64_t microseconds) {
+  std::string fraction = std::to_string(microseconds % 1000000);
+  return std::to_string(microseconds / 1000000) + "." +
+         std::string(6 - fraction.size(), '0') + fraction;
+}
+} // namespace
+
+LatencyHistogram::LatencyHistogram() noexcept
+    : _buckets(), _count(0), _sum(0), _maximum(0) {
+  for (std::atomic<uint64_t>& bucket : this->_buckets) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+void LatencyHistogram::record(
+    std::chrono::steady_clock::duration duration) noexcept {
+  const int64_t microseconds =
+      std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+  this->recordMicroseconds(
+      microseconds > 0 ? static_cast<uint64_t>(microseconds) : 0);
+}
+
+void LatencyHistogram::recordMicroseconds(uint64_t microseconds) noexcept {
+  this->_buckets[getBucketIndex(microseconds)].fetch_add(
+      1,
+      std::memory_order_relaxed);
+  this->_count.fetch_add(1, std::memory_order_relaxed);
+  this->_sum.fetch_add(microseconds, std::memory_order_relaxed);
+
+  uint64_t maximum = this->_maximum.load(std::memory_order_relaxed);
+  while (microseconds > maximum && !this->_maximum.compare_exchange_weak(
+                                       maximum,
+                                       microseconds,
+                                       std::memory_order_relaxed)) {
+  }
+}
+
+uint64_t
+LatencyHistogram::getQuantileMicroseconds(double quantile) const noexcept {
+  const uint64_t count = this->getCount();
+  const uint64_t maximum = this->getMaximumMicroseconds();
+  if (count == 0) {
+    return 0;
+  }
+
+  const double clamped = std::clamp(quantile, 0.0, 1.0);
+  const uint64_t rank = std::max(
+      uint64_t(1),
+      static_cast<uint64_t>(std::ceil(clamped * static_cast<double>(count))));
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < BucketCount; ++i) {
+    seen += this->_buckets[i].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      return std::min(getBucketUpperBound(i), maximum);
+    }
+  }
+
+  // Values recorded while the buckets were read may not be counted yet.
+  return maximum;
+}
+
+/*static*/ size_t
+LatencyHistogram::getBucketIndex(uint64_t microseconds) noexcept {
+  if (microseconds < SubBucketCount) {
+    return static_cast<size_t>(microseconds);
+  }
+
+  const uint32_t shift = floorLog2(microseconds) - subBucketBits;
+  const uint64_t subBucket = (microseconds >> shift) - SubBucketCount;
+  return static_cast<size_t>(
+      SubBucketCount + uint64_t(shift) * SubBucketCount + subBucket);
+}
+
+/*static*/ uint64_t
+LatencyHistogram::getBucketUpperBound(size_t index) noexcept {
+  if (index < SubBucketCount) {
+    return index;
+  }
+
+  const uint64_t shift = (index - SubBucketCount) / SubBucketCount;
+  const uint64_t subBucket = (index - SubBucketCount) % SubBucketCount;
+  const uint64_t lowerBound = (SubBucketCount + subBucket) << shift;
+  return lowerBound + ((uint64_t(1) << shift) - 1);
+}
+
+std::string MetricsSnapshot::toPrometheusText() const {
+  std::string out;
+  const std::string* pLastName = nullptr;
+
+  for (const Counter& counter : this->counters) {
+    appendHeader(out, pLastName, counter.name, counter.help, "counter");
+    appendSeries(out, counter.name, counter.labels);
+    out += ' ';
+    out += std::to_string(counter.value);
+    out += '\n';
+  }
+
+  pLastName = nullptr;
+  for (const Gauge& gauge : this->gauges) {
+    appendHeader(out, pLastName, gauge.name, gauge.help, "gauge");
+    appendSeries(out, gauge.name, gauge.labels);
+    out += ' ';
+    out += std::to_string(gauge.value);
+    out += '\n';
+  }
+
+  pLastName = nullptr;
+  for (const Histogram& histogram : this->histograms) {
+    appendHeader(out, pLastName, histogram.name, histogram.help, "summary");
+
+    const std::pair<const char*, uint64_t> quantiles[] = {
+        {"0.5", histogram.p50},
+        {"0.9", histogram.p90},
+        {"0.99", histogram.p99}};
+    for (const auto& quantile : quantiles) {
+      const std::pair<std::string, std::string> label{
+          "quantile",
+          quantile.first};
+      appendSeries(out, histogram.name, histogram.labels, &label);
+      out += ' ';
+      out += microsecondsToSeconds(quantile.second);
+      out += '\n';
+    }
+
+    appendSeries(out, histogram.name + "_sum", histogram.labels);
+    out += ' ';
+    out += microsecondsToSeconds(histogram.sum);
+    out += '\n';
+
+    appendSeries(out, histogram.name + "_count", histogram.labels);
+    out += ' ';
+    out += std::to_string(histogram.count);
+    out += '\n';
+  }
+
+  return out;
+}
+
+MetricsRegistry::MetricsRegistry()
+    : _mutex(), _counters(), _gauges(), _histograms() {}
+
+MetricsRegistry::~MetricsRegistry() noexcept = default;
+
+MetricsCounter& MetricsRegistry::getCounter(
+    const std::string& name,
+    const std::string& help,
+    const MetricLabels& labels) {
+  return this->getOrCreate(this->_counters, name, help, labels);
+}
+
+MetricsGauge& MetricsRegistry::getGauge(
+    const std::string& name,
+    const std::string& help,
+    const MetricLabels& labels) {
+  return this->getOrCreate(this->_gauges, name, help, labels);
+}
+
+LatencyHistogram& MetricsRegistry::getHistogram(
+    const std::string& name,
+    const std::string& help,
+    const MetricLabels& labels) {
+  return this->getOrCreate(this->_histograms, name, help, labels);
+}
+
+MetricsSnapshot MetricsRegistry::snapshot() const {
+  MetricsSnapshot result;
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+
+  result.counters.reserve(this->_counters.size());
+  for (const auto& [key, entry] : this->_counters) {
+    result.counters.push_back(MetricsSnapshot::Counter{
+        key.first,
+        entry.help,
+        key.second,
+        entry.pMetric->getValue()});
+  }
+
+  result.gauges.reserve(this->_gauges.size());
+  for (const auto& [key, entry] : this->_gauges) {
+    result.gauges.push_back(MetricsSnapshot::Gauge{
+        key.first,
+        entry.help,
+        key.second,
+        entry.pMetric->getValue()});
+  }
+
+  result.histograms.reserve(this->_histograms.size());
+  for (const auto& [key, entry] : this->_histograms) {
+    const LatencyHistogram& histogram = *entry.pMetric;
+    result.histograms.push_back(MetricsSnapshot::Histogram{
+        key.first,
+        entry.help,
+        key.second,
+        histogram.getCount(),
+        histogram.getSumMicroseconds(),
+        histogram.getMaximumMicroseconds(),
+        histogram.getQuantileMicroseconds(0.5),
+        histogram.getQuantileMicroseconds(0.9),
+        histogram.getQuantileMicroseconds(0.99)});
+  }
+
+  return result;
+}
+
+template <typename T>
+T& MetricsRegistry::getOrCreate(
+    EntryMap<T>& entries,
+    const std::string& name,
+    const std::string& help,
+    const MetricLabels& labels) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+
+  auto it = entries.find(std::make_pair(name, labels));
+  if (it == entries.end()) {
+    it = entries
+             .emplace(
+                 std::make_pair(name, labels),
+                 Entry<T>{help, std::make_unique<T>()})
+             .first;
+  }
+  return *it->second.pMetric;
+}
+
+} // namespace CesiumUtility
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace CesiumUtility {
+namespace Impl {
+
+/**
+ * @brief A fixed-size binary record of something that happened while tracing.
+ */
+struct TraceEvent {
+  /**
+   * @brief The time of the event, in microseconds since the epoch of
+   * `std::chrono::steady_clock`.
+   */
+  int64_t timestamp;
+
+  /**
+   * @brief The duration in microseconds of a complete ('X') event, or the
+   * track ID of an async ('b' or 'e') event.
+   */
+  int64_t value;
+
+  /**
+   * @brief The ID of the event's interned name.
+   */
+  uint32_t nameID;
+
+  /**
+   * @brief The Chrome trace event phase: 'X', 'B', 'E', 'b' or 'e'.
+   */
+  char type;
+};
+
+#ifdef _MSC_VER
+// The counters are deliberately padded to separate cache lines.
+#pragma warning(push)
+#pragma warning(disable : 4324)
+#endif
+
+/**
+ * @brief A lock-free queue of {@link TraceEvent} with a single producer, the
+ * thread being traced, and a single consumer, the thread writing the trace.
+ *
+ * Neither side ever waits for the other. When the buffer is full, new events
+ * are dropped and counted instead of overwriting events that the consumer has
+ * not read yet.
+ */
+class TraceRingBuffer {
+public:
+  /**
+   * @brief Creates a buffer.
+   *
+   * @param threadIndex The index of the thread that produces the events.
+   * @param capacity The number of events the buffer holds, which must be a
+   * power of two.
+   */
+  TraceRingBuffer(uint32_t threadIndex, size_t capacity)
+      : _threadIndex(threadIndex),
+        _mask(capacity - 1),
+        _events(capacity),
+        _head(0),
+        _tail(0),
+        _dropped(0) {
+    assert(capacity > 0 && (capacity & (capacity - 1)) == 0);
+  }
+
+  /**
+   * @brief Gets the index of the thread that produces the events.
+   */
+  uint32_t getThreadIndex() const noexcept { return this->_threadIndex; }
+
+  /**
+   * @brief Adds an event. May only be called by the producer.
+   *
+   * @return `false` if the buffer is full and the event was dropped.
+   */
+  bool push(const TraceEvent& event) noexcept {
+    const uint64_t head = this->_head.load(std::memory_order_relaxed);
+    const uint64_t tail = this->_tail.load(std::memory_order_acquire);
+    if (head - tail > this->_mask) {
+      this->_dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    this->_events[static_cast<size_t>(head & this->_mask)] = event;
+    this->_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Removes all the events added so far, and calls a function with
+   * each of them in the order they were added. May only be called by the
+   * consumer.
+   *
+   * @return The number of events removed.
+   */
+  template <typename Function> size_t drain(Function&& f) {
+    const uint64_t head = this->_head.load(std::memory_order_acquire);
+    const uint64_t tail = this->_tail.load(std::memory_order_relaxed);
+    for (uint64_t i = tail; i != head; ++i) {
+      f(static_cast<const TraceEvent&>(
+          this->_events[static_cast<size_t>(i & this->_mask)]));
+    }
+    this->_tail.store(head, std::memory_order_release);
+    return static_cast<size_t>(head - tail);
+  }
+
+  /**
+   * @brief Removes all the events added so far without reading them. May only
+   * be called by the consumer.
+   */
+  void discard() noexcept {
+    this->_tail.store(
+        this->_head.load(std::memory_order_acquire),
+        std::memory_order_release);
+  }
+
+  /**
+   * @brief Gets the number of events dropped since the last call, and resets
+   * it to zero.
+   */
+  uint64_t takeDroppedCount() noexcept {
+    return this->_dropped.exchange(0, std::memory_order_relaxed);
+  }
+
+private:
+  uint32_t _threadIndex;
+  uint64_t _mask;
+  std::vector<TraceEvent> _events;
+
+  // The producer writes the head and the consumer writes the tail, so keep
+  // them on separate cache lines.
+  alignas(64) std::atomic<uint64_t> _head;
+  alignas(64) std::atomic<uint64_t> _tail;
+  alignas(64) std::atomic<uint64_t> _dropped;
+};
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+} // namespace Impl
+} // namespace CesiumUtility
@@ -1,54 +1,176 @@
 #include "CesiumUtility/Tracing.h"
 
+#include "TraceRingBuffer.h"
+
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 
 #if CESIUM_TRACING_ENABLED
 
 namespace CesiumUtility {
 namespace Impl {
 
+namespace {
+// Each thread holds 24 bytes per event, so 384KiB.
+const size_t THREAD_BUFFER_CAPACITY = 16384;
+
+const std::chrono::milliseconds FLUSH_INTERVAL(100);
+
+const char BINARY_MAGIC[] = "CESIUMTRACE1";
+
+int64_t getMicroseconds(std::chrono::steady_clock::time_point time) {
+  return std::chrono::time_point_cast<std::chrono::microseconds>(time)
+      .time_since_epoch()
+      .count();
+}
+
+int64_t getCurrentMicroseconds() {
+  return getMicroseconds(std::chrono::steady_clock::now());
+}
+
+// The names this thread has interned already, so that it only takes the lock
+// the first time it uses a name.
+thread_local std::unordered_map<std::string_view, uint32_t> threadNameIDs;
+
+// This thread's events. The tracer holds a reference as well, so events
+// recorded just before the thread exits are still written.
+thread_local std::shared_ptr<TraceRingBuffer> pThreadBuffer;
+
+template <typename T> void appendBinary(std::string& output, T value) {
+  output.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void appendJsonString(std::string& output, const std::string& value) {
+  output += '"';
+  for (const char c : value) {
+    if (c == '"' || c == '\\') {
+      output += '\\';
+      output += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      output += ' ';
+    } else {
+      output += c;
+    }
+  }
+  output += '"';
+}
+} // namespace
+
+/*static*/ std::atomic<bool> Tracer::_enabled{false};
+
 Tracer& Tracer::instance() {
   static Tracer instance;
   return instance;
 }
 
+/*static*/ void Tracer::setEnabled(bool enabled) noexcept {
+  Tracer::_enabled.store(enabled, std::memory_order_relaxed);
+}
+
 Tracer::~Tracer() { endTracing(); }
 
-void Tracer::startTracing(const std::string& filePath) {
-  this->_output.open(filePath);
-  this->_output << "{\"otherData\": {},\"traceEvents\":[";
+void Tracer::startTracing(const std::string& filePath, TraceFormat format) {
+  this->endTracing();
+
+  this->_output.open(filePath, std::ios::out | std::ios::binary);
+  if (!this->_output) {
+    return;
+  }
+
+  // Drop anything recorded since the last trace ended.
+  {
+    std::lock_guard<std::mutex> lock(this->_buffersLock);
+    for (const std::shared_ptr<TraceRingBuffer>& pBuffer : this->_buffers) {
+      pBuffer->discard();
+      pBuffer->takeDroppedCount();
+    }
+  }
+
+  this->_format = format;
+  this->_numTraces = 0;
+  this->_droppedEvents = 0;
+  this->_flushedNames.clear();
+
+  if (format == TraceFormat::Binary) {
+    this->_output.write(BINARY_MAGIC, sizeof(BINARY_MAGIC) - 1);
+  } else {
+    this->_output << "{\"traceEvents\":[";
+  }
+
+  this->_stopFlusher = false;
+  this->_flusher = std::thread([this]() { this->runFlusher(); });
+
+  Tracer::setEnabled(true);
 }
 
 void Tracer::endTracing() {
-  this->_output << "]}";
+  Tracer::setEnabled(false);
+
+  if (this->_flusher.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(this->_flusherLock);
+      this->_stopFlusher = true;
+    }
+    this->_flusherCondition.notify_one();
+    this->_flusher.join();
+  }
+
+  if (!this->_output.is_open()) {
+    return;
+  }
+
+  this->flush();
+
+  if (this->_format == TraceFormat::Binary) {
+    std::string footer;
+    footer += 'D';
+    appendBinary(footer, this->_droppedEvents);
+    this->_output.write(footer.data(), std::streamsize(footer.size()));
+  } else {
+    this->_output << "],\"otherData\":{\"droppedEvents\":"
+                  << this->_droppedEvents << "}}";
+  }
   this->_output.close();
 }
 
-void Tracer::writeCompleteEvent(const Trace& trace) {
-  std::lock_guard<std::mutex> lock(_lock);
-  if (!this->_output) {
-    return;
+uint32_t Tracer::internName(std::string_view name) {
+  auto threadIt = threadNameIDs.find(name);
+  if (threadIt != threadNameIDs.end()) {
+    return threadIt->second;
   }
 
-  // Chrome tracing wants the text like this
-  if (this->_numTraces++ > 0) {
-    this->_output << ",";
+  std::lock_guard<std::mutex> lock(this->_namesLock);
+
+  auto it = this->_nameIDs.find(name);
+  if (it == this->_nameIDs.end()) {
+    if (this->_names.size() >= MAX_NAMES) {
+      // Don't remember the name in this thread's table either, so that it
+      // stays bounded too.
+      return 0;
+    }
+
+    const uint32_t id = static_cast<uint32_t>(this->_names.size());
+    const std::string& storedName = this->_names.emplace_back(name);
+    it = this->_nameIDs.emplace(storedName, id).first;
   }
 
-  this->_output << "{";
-  this->_output << "\"cat\":\"cesium\",";
-  this->_output << "\"dur\":" << trace.duration << ',';
-  this->_output << "\"name\":\"" << trace.name << "\",";
-  this->_output << "\"ph\":\"X\",";
-  this->_output << "\"pid\":0,";
-  this->_output << "\"tid\":" << trace.threadID << ",";
-  this->_output << "\"ts\":" << trace.start;
-  this->_output << "}";
+  threadNameIDs.emplace(it->first, it->second);
+  return it->second;
+}
+
+void Tracer::writeCompleteEvent(
+    uint32_t nameID,
+    int64_t start,
+    int64_t duration) {
+  this->record(TraceEvent{start, duration, nameID, 'X'});
 }
 
 void Tracer::writeAsyncEventBegin(const char* name, int64_t id) {
-  this->writeAsyncEvent("cesium", name, 'b', id);
+  if (!Tracer::isEnabled()) {
+    return;
+  }
+  this->writeAsyncEvent(this->internName(name), 'b', id);
 }
 
 void Tracer::writeAsyncEventBegin(const char* name) {
@@ -56,7 +178,10 @@ void Tracer::writeAsyncEventBegin(const char* name) {
 }
 
 void Tracer::writeAsyncEventEnd(const char* name, int64_t id) {
-  this->writeAsyncEvent("cesium", name, 'e', id);
+  if (!Tracer::isEnabled()) {
+    return;
+  }
+  this->writeAsyncEvent(this->internName(name), 'e', id);
 }
 
 void Tracer::writeAsyncEventEnd(const char* name) {
@@ -65,23 +190,35 @@ void Tracer::writeAsyncEventEnd(const char* name) {
 
 int64_t Tracer::allocateTrackID() { return ++this->_lastAllocatedID; }
 
-Tracer::Tracer() : _output{}, _numTraces{0}, _lock{}, _lastAllocatedID(0) {}
+Tracer::Tracer()
+    : _namesLock{},
+      _names{},
+      _nameIDs{},
+      _buffersLock{},
+      _buffers{},
+      _nextThreadIndex{0},
+      _output{},
+      _format{TraceFormat::ChromeJson},
+      _numTraces{0},
+      _droppedEvents{0},
+      _flushedNames{},
+      _flushBuffer{},
+      _flusher{},
+      _flusherLock{},
+      _flusherCondition{},
+      _stopFlusher{false},
+      _lastAllocatedID(0) {
+  this->_nameIDs.emplace(this->_names.emplace_back(OVERFLOW_NAME), 0U);
+}
 
 int64_t Tracer::getCurrentThreadTrackID() const {
   const TrackReference* pTrack = TrackReference::current();
-  return pTrack->getTracingID();
+  return pTrack ? pTrack->getTracingID() : -1;
 }
 
-void Tracer::writeAsyncEvent(
-    const char* category,
-    const char* name,
-    char type,
-    int64_t id) {
-
-  bool isAsync = true;
+void Tracer::writeAsyncEvent(uint32_t nameID, char type, int64_t id) {
   if (id < 0) {
     // Use a standard Duration event for slices without an async ID.
-    isAsync = false;
     if (type == 'b') {
       type = 'B';
     } else if (type == 'e') {
@@ -89,67 +226,165 @@ void Tracer::writeAsyncEvent(
     }
   }
 
-  std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
-  int64_t microseconds =
-      std::chrono::time_point_cast<std::chrono::microseconds>(time)
-          .time_since_epoch()
-          .count();
+  this->record(TraceEvent{getCurrentMicroseconds(), id, nameID, type});
+}
 
-  std::lock_guard<std::mutex> lock(_lock);
-  if (!this->_output) {
-    return;
+void Tracer::record(const TraceEvent& event) {
+  this->getCurrentThreadBuffer().push(event);
+}
+
+TraceRingBuffer& Tracer::getCurrentThreadBuffer() {
+  if (!pThreadBuffer) {
+    std::lock_guard<std::mutex> lock(this->_buffersLock);
+    pThreadBuffer = std::make_shared<TraceRingBuffer>(
+        this->_nextThreadIndex++,
+        THREAD_BUFFER_CAPACITY);
+    this->_buffers.emplace_back(pThreadBuffer);
+  }
+  return *pThreadBuffer;
+}
+
+void Tracer::runFlusher() {
+  std::unique_lock<std::mutex> lock(this->_flusherLock);
+  while (!this->_stopFlusher) {
+    this->_flusherCondition.wait_for(lock, FLUSH_INTERVAL, [this]() {
+      return this->_stopFlusher;
+    });
+
+    lock.unlock();
+    this->flush();
+    lock.lock();
+  }
+}
+
+void Tracer::flush() {
+  struct ThreadEvent {
+    uint32_t threadIndex;
+    TraceEvent event;
+  };
+  std::vector<ThreadEvent> events;
+
+  {
+    std::lock_guard<std::mutex> lock(this->_buffersLock);
+    for (const std::shared_ptr<TraceRingBuffer>& pBuffer : this->_buffers) {
+      const uint32_t threadIndex = pBuffer->getThreadIndex();
+      pBuffer->drain([&events, threadIndex](const TraceEvent& event) {
+        events.push_back({threadIndex, event});
+      });
+      this->_droppedEvents += pBuffer->takeDroppedCount();
+    }
+
+    // Forget the buffers of threads that have exited, now that they are
+    // empty.
+    this->_buffers.erase(
+        std::remove_if(
+            this->_buffers.begin(),
+            this->_buffers.end(),
+            [](const std::shared_ptr<TraceRingBuffer>& pBuffer) {
+              return pBuffer.use_count() == 1;
+            }),
+        this->_buffers.end());
   }
 
-  // Chrome tracing wants the text like this
-  if (this->_numTraces++ > 0) {
-    this->_output << ",";
+  // Every name used by the drained events was interned before the event was
+  // recorded.
+  const size_t firstNewName = this->_flushedNames.size();
+  {
+    std::lock_guard<std::mutex> lock(this->_namesLock);
+    for (size_t i = firstNewName; i < this->_names.size(); ++i) {
+      this->_flushedNames.emplace_back(this->_names[i]);
+    }
   }
-  this->_output << "{";
-  this->_output << "\"cat\":\"" << category << "\",";
-  if (isAsync) {
-    this->_output << "\"id\":" << id << ",";
+
+  std::string& output = this->_flushBuffer;
+  output.clear();
+
+  if (this->_format == TraceFormat::Binary) {
+    for (size_t i = firstNewName; i < this->_flushedNames.size(); ++i) {
+      const std::string& name = this->_flushedNames[i];
+      output += 'N';
+      appendBinary(output, static_cast<uint32_t>(i));
+      appendBinary(output, static_cast<uint32_t>(name.size()));
+      output += name;
+    }
+
+    for (const ThreadEvent& threadEvent : events) {
+      const TraceEvent& event = threadEvent.event;
+      output += event.type;
+      appendBinary(output, threadEvent.threadIndex);
+      appendBinary(output, event.nameID);
+      appendBinary(output, event.timestamp);
+      appendBinary(output, event.value);
+    }
   } else {
-    this->_output << "\"tid\":" << std::this_thread::get_id() << ",";
+    for (const ThreadEvent& threadEvent : events) {
+      const TraceEvent& event = threadEvent.event;
+
+      // Chrome tracing wants the text like this
+      if (this->_numTraces++ > 0) {
+        output += ',';
+      }
+
+      output += "{\"cat\":\"cesium\",";
+      if (event.type == 'X') {
+        output += "\"dur\":" + std::to_string(event.value) + ",";
+      }
+      if (event.type == 'b' || event.type == 'e') {
+        output += "\"id\":" + std::to_string(event.value) + ",";
+      } else {
+        output += "\"tid\":" + std::to_string(threadEvent.threadIndex) + ",";
+      }
+      output += "\"name\":";
+      appendJsonString(output, this->_flushedNames[event.nameID]);
+      output += ",\"ph\":\"";
+      output += event.type;
+      output += "\",\"pid\":0,\"ts\":" + std::to_string(event.timestamp) + "}";
+    }
   }
-  this->_output << "\"name\":\"" << name << "\",";
-  this->_output << "\"ph\":\"" << type << "\",";
-  this->_output << "\"pid\":0,";
-  this->_output << "\"ts\":" << microseconds;
-  this->_output << "}";
-}
 
-ScopedTrace::ScopedTrace(const std::string& message)
-    : _name{message},
-      _startTime{std::chrono::steady_clock::now()},
-      _threadId{std::this_thread::get_id()},
-      _reset{false} {
-  CESIUM_TRACE_BEGIN_IN_TRACK(_name.c_str());
+  this->_output.write(output.data(), std::streamsize(output.size()));
+  this->_output.flush();
 }
 
-ScopedTrace::~ScopedTrace() {
-  if (!this->_reset) {
-    this->reset();
+ScopedTrace::ScopedTrace(uint32_t nameID)
+    : _nameID(nameID), _startTime(0) {
+  if (this->_nameID == DISABLED) {
+    return;
+  }
+
+  this->_startTime = getCurrentMicroseconds();
+
+  const TrackReference* pTrack = TrackReference::current();
+  if (pTrack != nullptr) {
+    Tracer::instance().writeAsyncEvent(
+        this->_nameID,
+        'b',
+        pTrack->getTracingID());
   }
 }
 
+ScopedTrace::~ScopedTrace() { this->reset(); }
+
 void ScopedTrace::reset() {
-  this->_reset = true;
+  if (this->_nameID == DISABLED) {
+    return;
+  }
 
-  if (TrackReference::current() != nullptr) {
-    CESIUM_TRACE_END(_name.c_str());
+  const TrackReference* pTrack = TrackReference::current();
+  if (pTrack != nullptr) {
+    Tracer::instance().writeAsyncEvent(
+        this->_nameID,
+        'e',
+        pTrack->getTracingID());
   } else {
-    auto endTimePoint = std::chrono::steady_clock::now();
-    int64_t start = std::chrono::time_point_cast<std::chrono::microseconds>(
-                        this->_startTime)
-                        .time_since_epoch()
-                        .count();
-    int64_t end =
-        std::chrono::time_point_cast<std::chrono::microseconds>(endTimePoint)
-            .time_since_epoch()
-            .count();
+    const int64_t end = getCurrentMicroseconds();
     Tracer::instance().writeCompleteEvent(
-        {this->_name, start, end - start, this->_threadId});
+        this->_nameID,
+        this->_startTime,
+        end - this->_startTime);
   }
+
+  this->_nameID = DISABLED;
 }
 
 TrackSet::TrackSet(const char* name_) : name(name_) {}
@@ -0,0 +1,193 @@
+#include "CesiumUtility/FlatJsonValue.h"
+
+#include <catch2/catch.hpp>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace CesiumUtility;
+
+TEST_CASE("FlatJsonDocument") {
+  SECTION("an empty document has a null root") {
+    FlatJsonDocument document;
+    CHECK(document.getRoot().isNull());
+    CHECK(document.getRoot().size() == 0);
+  }
+
+  SECTION("builds values in document order") {
+    FlatJsonDocument document;
+    document.startObject();
+    document.addKey("name");
+    document.addString("tree");
+    document.addKey("height");
+    document.addDouble(12.5);
+    document.addKey("count");
+    document.addUint64(3);
+    document.addKey("offset");
+    document.addInt64(-4);
+    document.addKey("visible");
+    document.addBool(true);
+    document.addKey("tags");
+    document.startArray();
+    document.addString("a");
+    document.startObject();
+    document.addKey("nested");
+    document.addNull();
+    document.endObject();
+    document.addString("b");
+    document.endArray();
+    document.addKey("last");
+    document.addUint64(7);
+    document.endObject();
+
+    const FlatJsonValue root = document.getRoot();
+    REQUIRE(root.isObject());
+    CHECK(root.size() == 7);
+
+    CHECK(root.getValueForKey("name")->getString() == "tree");
+    CHECK(root.getValueForKey("height")->getDouble() == 12.5);
+    CHECK(root.getValueForKey("count")->getUint64() == 3);
+    CHECK(root.getValueForKey("offset")->getInt64() == -4);
+    CHECK(root.getValueForKey("visible")->getBool());
+    CHECK(root.getValueForKey("last")->getUint64() == 7);
+    CHECK(!root.getValueForKey("missing"));
+    CHECK(root.hasKey("tags"));
+    CHECK(!root.hasKey("nested"));
+
+    const FlatJsonValue tags = *root.getValueForKey("tags");
+    REQUIRE(tags.isArray());
+    CHECK(tags.size() == 3);
+
+    std::vector<FlatJsonType> types;
+    tags.forEachElement(
+        [&types](const FlatJsonValue& element) {
+          types.push_back(element.getType());
+        });
+    CHECK(
+        types == std::vector<FlatJsonType>{
+                     FlatJsonType::String,
+                     FlatJsonType::Object,
+                     FlatJsonType::String});
+
+    std::vector<std::string> keys;
+    root.forEachMember(
+        [&keys](std::string_view key, const FlatJsonValue&) {
+          keys.emplace_back(key);
+        });
+    CHECK(
+        keys == std::vector<std::string>{
+                    "name",
+                    "height",
+                    "count",
+                    "offset",
+                    "visible",
+                    "tags",
+                    "last"});
+  }
+
+  SECTION("the last duplicate key wins") {
+    FlatJsonDocument document;
+    document.startObject();
+    document.addKey("a");
+    document.addUint64(1);
+    document.addKey("a");
+    document.addUint64(2);
+    document.endObject();
+
+    CHECK(document.getRoot().getValueForKey("a")->getUint64() == 2);
+
+    const JsonValue copy = document.getRoot().toJsonValue();
+    CHECK(copy.getSafeNumericalValueForKey<uint64_t>("a") == 2);
+  }
+
+  SECTION("NaN and infinity are stored as null") {
+    FlatJsonDocument document;
+    document.startArray();
+    document.addDouble(std::numeric_limits<double>::quiet_NaN());
+    document.addDouble(std::numeric_limits<double>::infinity());
+    document.endArray();
+
+    document.getRoot().forEachElement(
+        [](const FlatJsonValue& element) { CHECK(element.isNull()); });
+  }
+
+  SECTION("accessors throw for the wrong type") {
+    FlatJsonDocument document;
+    document.addString("text");
+
+    const FlatJsonValue root = document.getRoot();
+    CHECK_THROWS_AS(root.getDouble(), std::bad_variant_access);
+    CHECK_THROWS_AS(root.getSafeNumber<int32_t>(), JsonValueNotRealValue);
+    CHECK_THROWS_AS(
+        root.getSafeNumericalValueForKey<int32_t>("x"),
+        std::bad_variant_access);
+    CHECK(root.getDoubleOrDefault(1.0) == 1.0);
+    CHECK(root.getSafeNumberOrDefault<int32_t>(5) == 5);
+    CHECK(root.getStringOrDefault("default") == "text");
+    CHECK(!root.getValueForKey("x"));
+  }
+
+  SECTION("converts numbers safely") {
+    FlatJsonDocument document;
+    document.startObject();
+    document.addKey("small");
+    document.addInt64(-12);
+    document.addKey("large");
+    document.addUint64(1000);
+    document.endObject();
+
+    const FlatJsonValue root = document.getRoot();
+    CHECK(root.getSafeNumericalValueForKey<int8_t>("small") == -12);
+    CHECK(root.getSafeNumericalValueForKey<double>("large") == 1000.0);
+    CHECK_THROWS_AS(
+        root.getSafeNumericalValueForKey<int32_t>("missing"),
+        JsonValueMissingKey);
+    CHECK(root.getSafeNumericalValueOrDefaultForKey<uint8_t>("large", 1) == 1);
+    CHECK(
+        root.getSafeNumericalValueOrDefaultForKey<uint8_t>("missing", 2) == 2);
+  }
+
+  SECTION("round-trips a JsonValue") {
+    const JsonValue value = JsonValue::Object{
+        {"empty", JsonValue::Object{}},
+        {"list", JsonValue::Array{1.5, std::int64_t(-2), true, nullptr}},
+        {"nested",
+         JsonValue::Object{
+             {"text", "hello"},
+             {"values", JsonValue::Array{JsonValue::Array{}, "x"}}}},
+        {"number", std::uint64_t(42)}};
+
+    const FlatJsonDocument document(value);
+    const FlatJsonValue root = document.getRoot();
+    CHECK(root.size() == 4);
+    CHECK(root.getValueForKey("empty")->size() == 0);
+    CHECK(root.getValueForKey("number")->getUint64() == 42);
+    CHECK(
+        root.getValueForKey("nested")->getValueForKey("text")->getString() ==
+        "hello");
+
+    const JsonValue copy = root.toJsonValue();
+    const JsonValue::Object& object = copy.getObject();
+    CHECK(object.size() == 4);
+    CHECK(object.at("empty").getObject().empty());
+    CHECK(object.at("number").getUint64() == 42);
+
+    const JsonValue::Array& list = object.at("list").getArray();
+    REQUIRE(list.size() == 4);
+    CHECK(list[0].getDouble() == 1.5);
+    CHECK(list[1].getInt64() == -2);
+    CHECK(list[2].getBool());
+    CHECK(list[3].isNull());
+
+    const JsonValue& nested = object.at("nested");
+    CHECK(*nested.getValuePtrForKey<std::string>("text") == "hello");
+    const JsonValue::Array& values =
+        nested.getValuePtrForKey("values")->getArray();
+    REQUIRE(values.size() == 2);
+    CHECK(values[0].getArray().empty());
+    CHECK(values[1].getString() == "x");
+
+    CHECK(document.getSizeBytes() > 0);
+  }
+}
@@ -0,0 +1,171 @@
+#include "CesiumUtility/Metrics.h"
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace CesiumUtility;
+
+TEST_CASE("LatencyHistogram") {
+  SECTION("bucket bounds are within an eighth of the value") {
+    for (uint64_t value : std::vector<uint64_t>{
+             0,
+             1,
+             7,
+             8,
+             9,
+             15,
+             16,
+             17,
+             1000,
+             123456,
+             uint64_t(1) << 40,
+             UINT64_MAX}) {
+      const size_t index = LatencyHistogram::getBucketIndex(value);
+      REQUIRE(index < LatencyHistogram::BucketCount);
+
+      const uint64_t upperBound = LatencyHistogram::getBucketUpperBound(index);
+      CHECK(upperBound >= value);
+      CHECK(upperBound - value <= value / 8);
+      if (index > 0) {
+        CHECK(LatencyHistogram::getBucketUpperBound(index - 1) < value);
+      }
+    }
+
+    CHECK(
+        LatencyHistogram::getBucketIndex(UINT64_MAX) ==
+        LatencyHistogram::BucketCount - 1);
+  }
+
+  SECTION("reports the count, sum, maximum and quantiles") {
+    LatencyHistogram histogram;
+    CHECK(histogram.getQuantileMicroseconds(0.5) == 0);
+
+    for (uint64_t i = 1; i <= 100; ++i) {
+      histogram.recordMicroseconds(i * 1000);
+    }
+
+    CHECK(histogram.getCount() == 100);
+    CHECK(histogram.getSumMicroseconds() == 5050000);
+    CHECK(histogram.getMaximumMicroseconds() == 100000);
+
+    const uint64_t p50 = histogram.getQuantileMicroseconds(0.5);
+    CHECK(p50 >= 50000);
+    CHECK(p50 <= 50000 + 50000 / 8);
+
+    const uint64_t p99 = histogram.getQuantileMicroseconds(0.99);
+    CHECK(p99 >= 99000);
+    CHECK(p99 <= 100000);
+
+    CHECK(histogram.getQuantileMicroseconds(1.0) == 100000);
+  }
+
+  SECTION("records durations") {
+    LatencyHistogram histogram;
+    histogram.record(std::chrono::milliseconds(3));
+    histogram.record(std::chrono::milliseconds(-3));
+    CHECK(histogram.getCount() == 2);
+    CHECK(histogram.getSumMicroseconds() == 3000);
+  }
+
+  SECTION("may be recorded from many threads") {
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (uint64_t t = 0; t < 4; ++t) {
+      threads.emplace_back([&histogram, t]() {
+        for (uint64_t i = 0; i < 10000; ++i) {
+          histogram.recordMicroseconds(t * 10000 + i);
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+
+    CHECK(histogram.getCount() == 40000);
+    CHECK(histogram.getMaximumMicroseconds() == 39999);
+  }
+}
+
+TEST_CASE("MetricsRegistry") {
+  SECTION("returns the same metric for the same name and labels") {
+    MetricsRegistry registry;
+
+    MetricsCounter& hits =
+        registry.getCounter("requests_total", "Requests.", {{"cache", "hit"}});
+    MetricsCounter& misses =
+        registry.getCounter("requests_total", "Requests.", {{"cache", "miss"}});
+    CHECK(&hits != &misses);
+    CHECK(
+        &registry.getCounter("requests_total", "", {{"cache", "hit"}}) ==
+        &hits);
+
+    hits.increment();
+    hits.increment(2);
+    CHECK(hits.getValue() == 3);
+    CHECK(misses.getValue() == 0);
+  }
+
+  SECTION("takes snapshots sorted by name and labels") {
+    MetricsRegistry registry;
+    registry.getCounter("b_total", "B.").increment(5);
+    registry.getCounter("a_total", "A.", {{"kind", "y"}}).increment(2);
+    registry.getCounter("a_total", "A.", {{"kind", "x"}}).increment(1);
+
+    MetricsGauge& gauge = registry.getGauge("bytes", "Bytes.");
+    gauge.add(100);
+    gauge.add(-40);
+
+    registry.getHistogram("latency_seconds", "Latency.").recordMicroseconds(7);
+
+    const MetricsSnapshot snapshot = registry.snapshot();
+    REQUIRE(snapshot.counters.size() == 3);
+    CHECK(snapshot.counters[0].name == "a_total");
+    CHECK(snapshot.counters[0].labels[0].second == "x");
+    CHECK(snapshot.counters[0].value == 1);
+    CHECK(snapshot.counters[1].labels[0].second == "y");
+    CHECK(snapshot.counters[2].name == "b_total");
+    CHECK(snapshot.counters[2].help == "B.");
+    CHECK(snapshot.counters[2].value == 5);
+
+    REQUIRE(snapshot.gauges.size() == 1);
+    CHECK(snapshot.gauges[0].value == 60);
+
+    REQUIRE(snapshot.histograms.size() == 1);
+    CHECK(snapshot.histograms[0].count == 1);
+    CHECK(snapshot.histograms[0].sum == 7);
+    CHECK(snapshot.histograms[0].p50 == 7);
+  }
+
+  SECTION("formats snapshots as Prometheus text") {
+    MetricsRegistry registry;
+    registry.getCounter("requests_total", "Requests.", {{"cache", "hit"}})
+        .increment(3);
+    registry.getCounter("requests_total", "Requests.", {{"cache", "miss"}})
+        .increment(1);
+    registry.getGauge("bytes", "Bytes\nin use.", {{"path", "a\"b"}}).set(-2);
+    registry.getHistogram("latency_seconds", "Latency.")
+        .recordMicroseconds(1500000);
+
+    const std::string expected =
+        "# HELP requests_total Requests.\n"
+        "# TYPE requests_total counter\n"
+        "requests_total{cache=\"hit\"} 3\n"
+        "requests_total{cache=\"miss\"} 1\n"
+        "# HELP bytes Bytes\\nin use.\n"
+        "# TYPE bytes gauge\n"
+        "bytes{path=\"a\\\"b\"} -2\n"
+        "# HELP latency_seconds Latency.\n"
+        "# TYPE latency_seconds summary\n"
+        "latency_seconds{quantile=\"0.5\"} 1.500000\n"
+        "latency_seconds{quantile=\"0.9\"} 1.500000\n"
+        "latency_seconds{quantile=\"0.99\"} 1.500000\n"
+        "latency_seconds_sum 1.500000\n"
+        "latency_seconds_count 1\n";
+    CHECK(registry.snapshot().toPrometheusText() == expected);
+  }
+}
@@ -0,0 +1,91 @@
+#include "TraceRingBuffer.h"
+
+#include <catch2/catch.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace CesiumUtility::Impl;
+
+namespace {
+TraceEvent makeEvent(int64_t timestamp) {
+  return TraceEvent{timestamp, 0, 0, 'X'};
+}
+
+std::vector<int64_t> drainTimestamps(TraceRingBuffer& buffer) {
+  std::vector<int64_t> timestamps;
+  buffer.drain([&timestamps](const TraceEvent& event) {
+    timestamps.push_back(event.timestamp);
+  });
+  return timestamps;
+}
+} // namespace
+
+TEST_CASE("TraceRingBuffer") {
+  SECTION("drains events in the order they were pushed") {
+    TraceRingBuffer buffer(3, 8);
+    CHECK(buffer.getThreadIndex() == 3);
+
+    for (int64_t i = 0; i < 5; ++i) {
+      REQUIRE(buffer.push(makeEvent(i)));
+    }
+    CHECK(drainTimestamps(buffer) == std::vector<int64_t>{0, 1, 2, 3, 4});
+    CHECK(drainTimestamps(buffer).empty());
+
+    // Wrap around the end of the buffer.
+    for (int64_t i = 5; i < 12; ++i) {
+      REQUIRE(buffer.push(makeEvent(i)));
+    }
+    CHECK(
+        drainTimestamps(buffer) ==
+        std::vector<int64_t>{5, 6, 7, 8, 9, 10, 11});
+  }
+
+  SECTION("drops and counts events when full") {
+    TraceRingBuffer buffer(0, 4);
+    for (int64_t i = 0; i < 4; ++i) {
+      REQUIRE(buffer.push(makeEvent(i)));
+    }
+    CHECK(!buffer.push(makeEvent(4)));
+    CHECK(!buffer.push(makeEvent(5)));
+    CHECK(buffer.takeDroppedCount() == 2);
+    CHECK(buffer.takeDroppedCount() == 0);
+
+    CHECK(drainTimestamps(buffer) == std::vector<int64_t>{0, 1, 2, 3});
+    CHECK(buffer.push(makeEvent(6)));
+  }
+
+  SECTION("discards events") {
+    TraceRingBuffer buffer(0, 4);
+    buffer.push(makeEvent(0));
+    buffer.push(makeEvent(1));
+    buffer.discard();
+    CHECK(drainTimestamps(buffer).empty());
+  }
+
+  SECTION("a consumer thread receives every event that is not dropped") {
+    TraceRingBuffer buffer(0, 64);
+    const int64_t count = 100000;
+
+    std::thread producer([&buffer, count]() {
+      for (int64_t i = 0; i < count; ++i) {
+        while (!buffer.push(makeEvent(i))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    int64_t expected = 0;
+    bool inOrder = true;
+    while (expected < count) {
+      buffer.drain([&expected, &inOrder](const TraceEvent& event) {
+        inOrder = inOrder && event.timestamp == expected;
+        ++expected;
+      });
+    }
+    producer.join();
+
+    CHECK(inOrder);
+    CHECK(expected == count);
+  }
+}
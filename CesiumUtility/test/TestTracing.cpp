@@ -0,0 +1,91 @@
+#include "CesiumUtility/Tracing.h"
+
+#if CESIUM_TRACING_ENABLED
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace CesiumUtility::Impl;
+
+namespace {
+struct BinaryTrace {
+  std::map<uint32_t, std::string> names;
+  std::vector<uint32_t> eventNameIDs;
+};
+
+template <typename T> T readBinary(const std::string& data, size_t& offset) {
+  T value;
+  REQUIRE(offset + sizeof(T) <= data.size());
+  std::memcpy(&value, data.data() + offset, sizeof(T));
+  offset += sizeof(T);
+  return value;
+}
+
+void readBinaryTrace(const std::string& filename, BinaryTrace& trace) {
+  std::ifstream file(filename, std::ios::binary);
+  const std::string data{
+      std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>()};
+
+  REQUIRE(data.compare(0, 12, "CESIUMTRACE1") == 0);
+
+  size_t offset = 12;
+  bool ended = false;
+  while (offset < data.size() && !ended) {
+    const char tag = data[offset++];
+    if (tag == 'N') {
+      const uint32_t id = readBinary<uint32_t>(data, offset);
+      const uint32_t length = readBinary<uint32_t>(data, offset);
+      REQUIRE(offset + length <= data.size());
+      trace.names.emplace(id, data.substr(offset, length));
+      offset += length;
+    } else if (tag == 'D') {
+      CHECK(readBinary<uint64_t>(data, offset) == 0);
+      ended = true;
+    } else {
+      readBinary<uint32_t>(data, offset);
+      trace.eventNameIDs.emplace_back(readBinary<uint32_t>(data, offset));
+      readBinary<int64_t>(data, offset);
+      readBinary<int64_t>(data, offset);
+    }
+  }
+
+  CHECK(ended);
+  CHECK(offset == data.size());
+}
+} // namespace
+
+TEST_CASE("Tracing many distinct names keeps the name table bounded") {
+  const std::string filename = "test-tracing-names.trace";
+  const uint32_t numberOfNames = 3 * Tracer::MAX_NAMES;
+
+  CESIUM_TRACE_INIT_BINARY(filename);
+  for (uint32_t i = 0; i < numberOfNames; ++i) {
+    CESIUM_TRACE("Name " + std::to_string(i));
+  }
+  CESIUM_TRACE_SHUTDOWN();
+
+  BinaryTrace trace;
+  readBinaryTrace(filename, trace);
+  std::remove(filename.c_str());
+
+  CHECK(trace.names.size() <= Tracer::MAX_NAMES);
+  REQUIRE(trace.eventNameIDs.size() == numberOfNames);
+  for (const uint32_t nameID : trace.eventNameIDs) {
+    REQUIRE(trace.names.find(nameID) != trace.names.end());
+  }
+
+  // The names that arrived after the table filled up share one name.
+  CHECK(trace.names[trace.eventNameIDs.front()] == "Name 0");
+  CHECK(trace.names[trace.eventNameIDs.back()] == Tracer::OVERFLOW_NAME);
+}
+
+#endif // CESIUM_TRACING_ENABLED